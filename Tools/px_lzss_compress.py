@@ -0,0 +1,153 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (C) 2015 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+
+"""
+px_lzss_compress.py:
+Compress a ROMFS file with the LZSS scheme decoded on the FMU by
+systemlib/lzss.c: an 8-byte header ('PXLZ' magic plus the little-endian
+uncompressed size) followed by flag-byte groups of eight items, where a
+set bit is a literal byte and a clear bit a 2-byte reference with an
+11-bit distance and a 5-bit length (3..34 bytes). The window is 2 KB so
+the decompressor fits comfortably in FMU RAM. Files that do not shrink
+are left untouched.
+"""
+
+from __future__ import print_function
+import argparse
+import os
+import struct
+
+WINDOW_SIZE = 2048
+MIN_MATCH = 3
+MAX_MATCH = MIN_MATCH + 31
+
+
+def find_match(data, pos):
+        """find the longest match for data[pos:] in the preceding window"""
+        end = len(data)
+        best_len = 0
+        best_dist = 0
+        start = max(0, pos - WINDOW_SIZE)
+
+        limit = min(MAX_MATCH, end - pos)
+        if limit < MIN_MATCH:
+                return 0, 0
+
+        i = pos - 1
+        while i >= start:
+                if data[i] == data[pos]:
+                        length = 1
+                        # references may overlap the current position; the
+                        # decoder copies byte by byte, so comparing against
+                        # the source directly is correct
+                        while length < limit and data[i + length] == data[pos + length]:
+                                length += 1
+                        if length > best_len:
+                                best_len = length
+                                best_dist = pos - i
+                                if best_len == limit:
+                                        break
+                i -= 1
+
+        return best_len, best_dist
+
+
+def compress(data):
+        out = bytearray()
+        out += struct.pack("<4sI", b"PXLZ", len(data))
+
+        pos = 0
+        items = []
+        flags = 0
+        nflags = 0
+
+        while pos < len(data):
+                length, dist = find_match(data, pos)
+
+                if length >= MIN_MATCH:
+                        token = ((dist - 1) << 5) | (length - MIN_MATCH)
+                        items.append(bytearray([(token >> 8) & 0xff, token & 0xff]))
+                        pos += length
+                else:
+                        flags |= 1 << nflags
+                        items.append(bytearray([data[pos]]))
+                        pos += 1
+
+                nflags += 1
+                if nflags == 8:
+                        out.append(flags)
+                        for item in items:
+                                out += item
+                        items = []
+                        flags = 0
+                        nflags = 0
+
+        if nflags > 0:
+                out.append(flags)
+                for item in items:
+                        out += item
+
+        return bytes(out)
+
+
+def main():
+
+        # Parse commandline arguments
+        parser = argparse.ArgumentParser(description="ROMFS LZSS compressor.")
+        parser.add_argument('src', help='file to compress')
+        parser.add_argument('dst', help='output file (may equal src)')
+        args = parser.parse_args()
+
+        with open(args.src, 'rb') as f:
+                data = bytearray(f.read())
+
+        compressed = compress(data)
+
+        if len(compressed) >= len(data):
+                # not worth it, keep the file as it is
+                if os.path.abspath(args.src) != os.path.abspath(args.dst):
+                        with open(args.dst, 'wb') as f:
+                                f.write(bytes(data))
+                return
+
+        with open(args.dst, 'wb') as f:
+                f.write(compressed)
+
+        print("LZSS:    %s %u -> %u bytes" % (os.path.basename(args.dst),
+                                              len(data), len(compressed)))
+
+
+if __name__ == "__main__":
+        main()
@@ -0,0 +1,175 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (C) 2015 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+
+"""
+px_mixer_compile.py:
+Compile mixer text files (.mix) into the binary mixer image format (.mixb)
+loaded by MixerGroup::load_from_binary, so no text parsing happens on the
+flight controller at boot. The binary image is stored next to the text
+file with a 'b' appended to the name; the text file is kept as a fallback
+for devices that forward mixer definitions to a coprocessor.
+"""
+
+from __future__ import print_function
+import argparse
+import os
+import struct
+
+MAGIC = b"PXMB"
+VERSION = 1
+
+# keep in sync with MultirotorMixer::from_text and the table order
+# generated by multi_tables.py
+GEOMETRIES = {
+    "4x": 0,   # QUAD_X
+    "4+": 1,   # QUAD_PLUS
+    "4v": 2,   # QUAD_V
+    "4w": 3,   # QUAD_WIDE
+    "4dc": 4,  # QUAD_DEADCAT
+    "6x": 5,   # HEX_X
+    "6+": 6,   # HEX_PLUS
+    "6c": 7,   # HEX_COX
+    "8x": 8,   # OCTA_X
+    "8+": 9,   # OCTA_PLUS
+    "8c": 10,  # OCTA_COX
+    "2-": 11,  # TWIN_ENGINE
+    "3y": 12,  # TRI_Y
+}
+
+
+def mixer_lines(path):
+    """Return the mixer definition lines of a text file, pruned the same
+    way load_mixer_file prunes them at runtime."""
+    lines = []
+    with open(path, "r") as f:
+        for line in f:
+            if len(line) >= 2 and line[0].isupper() and line[1] == ':':
+                lines.append(line.strip())
+    return lines
+
+
+def pack_scaler(values):
+    """Pack five scaler values given in the text 1/10000 fixed point form."""
+    return struct.pack("<5f", *[v / 10000.0 for v in values])
+
+
+def compile_mixers(lines):
+    """Compile the definition lines into a list of binary mixer records.
+    Raises ValueError on anything the runtime text parsers would reject."""
+    records = []
+    i = 0
+    while i < len(lines):
+        fields = lines[i].split()
+        tag = fields[0]
+        i += 1
+
+        if tag == "Z:":
+            records.append(struct.pack("<B", ord('Z')))
+
+        elif tag == "R:":
+            if len(fields) != 6:
+                raise ValueError("bad multirotor line: %s" % " ".join(fields))
+            if fields[1] not in GEOMETRIES:
+                raise ValueError("unknown geometry: %s" % fields[1])
+            scales = [int(v) / 10000.0 for v in fields[2:6]]
+            records.append(struct.pack("<BB4f", ord('R'),
+                                       GEOMETRIES[fields[1]], *scales))
+
+        elif tag == "M:":
+            if len(fields) != 2:
+                raise ValueError("bad simple mixer line: %s" % " ".join(fields))
+            control_count = int(fields[1])
+
+            out_fields = lines[i].split()
+            i += 1
+            if out_fields[0] != "O:" or len(out_fields) != 6:
+                raise ValueError("bad output scaler line: %s" % " ".join(out_fields))
+            record = struct.pack("<BB", ord('M'), control_count)
+            record += pack_scaler([int(v) for v in out_fields[1:6]])
+
+            for _ in range(control_count):
+                ctl_fields = lines[i].split()
+                i += 1
+                if ctl_fields[0] != "S:" or len(ctl_fields) != 8:
+                    raise ValueError("bad control scaler line: %s" % " ".join(ctl_fields))
+                record += struct.pack("<BB", int(ctl_fields[1]), int(ctl_fields[2]))
+                record += pack_scaler([int(v) for v in ctl_fields[3:8]])
+
+            records.append(record)
+
+        else:
+            raise ValueError("unknown mixer tag: %s" % tag)
+
+    return records
+
+
+def main():
+
+    # Parse commandline arguments
+    parser = argparse.ArgumentParser(description="Mixer compiler.")
+    parser.add_argument('--folder', action="store", help="folder containing .mix files.")
+    args = parser.parse_args()
+
+    if not args.folder or not os.path.isdir(args.folder):
+        return
+
+    print("Compiling mixer files.")
+
+    for (root, dirs, files) in os.walk(args.folder):
+        for file in files:
+            if not file.endswith(".mix"):
+                continue
+
+            file_path = os.path.join(root, file)
+
+            try:
+                records = compile_mixers(mixer_lines(file_path))
+            except (ValueError, IndexError) as e:
+                # leave the text file as the only representation
+                print("mixer compile skipped %s: %s" % (file, e))
+                continue
+
+            if len(records) == 0 or len(records) > 255:
+                print("mixer compile skipped %s: bad mixer count" % file)
+                continue
+
+            with open(file_path + "b", "wb") as f:
+                f.write(MAGIC + struct.pack("<BB", VERSION, len(records)))
+                for record in records:
+                    f.write(record)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,168 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (C) 2015 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+
+"""
+px_param_compile.py:
+Compile runs of 'param set' lines in the startup scripts into binary BSON
+parameter files applied with a single 'param import'. On a fresh board
+the airframe default scripts set dozens of parameters, each spawning the
+param command and going through text parsing; importing one precompiled
+image instead makes factory-reset boots as fast as normal boots.
+
+Parameter types are taken from the PARAM_DEFINE_* declarations in the
+source tree; runs containing unknown parameters or values that do not
+match the declared type are left as script text.
+"""
+
+from __future__ import print_function
+import argparse
+import os
+import re
+import struct
+
+# only replace runs long enough to be worth an extra ROMFS file
+MIN_RUN_LENGTH = 4
+
+PARAM_DEFINE_RE = re.compile(r"PARAM_DEFINE_(INT32|FLOAT)\(\s*(\w+)")
+PARAM_SET_RE = re.compile(r"^param set (\w+) (\S+)$")
+
+BSON_DOUBLE = 1
+BSON_INT32 = 16
+
+
+def scan_param_types(src):
+    """Build a parameter name to type map from the PARAM_DEFINE_*
+    declarations in the source tree."""
+    types = {}
+    for (root, dirs, files) in os.walk(src):
+        for file in files:
+            if not file.endswith((".c", ".cpp", ".h")):
+                continue
+            with open(os.path.join(root, file), "r") as f:
+                for match in PARAM_DEFINE_RE.finditer(f.read()):
+                    types[match.group(2)] = match.group(1)
+    return types
+
+
+def encode_params(run, types):
+    """Encode a run of (name, value) pairs as a BSON document in the
+    format written by param_export. Raises ValueError if any parameter
+    is unknown or its value does not match the declared type."""
+    body = b""
+    for (name, value) in run:
+        ptype = types.get(name)
+        cname = name.encode("ascii") + b"\0"
+
+        if ptype == "INT32" and re.match(r"^-?\d+$", value):
+            body += struct.pack("<B", BSON_INT32) + cname + struct.pack("<i", int(value))
+        elif ptype == "FLOAT":
+            body += struct.pack("<B", BSON_DOUBLE) + cname + struct.pack("<d", float(value))
+        else:
+            raise ValueError("%s: type %s does not take '%s'" % (name, ptype, value))
+
+    # document length is discarded by the tinybson file decoder
+    return struct.pack("<i", 0) + body + b"\0"
+
+
+def compile_script(file_path, types):
+    """Replace qualifying 'param set' runs in one script with 'param
+    import' of a precompiled image stored next to the script."""
+    with open(file_path, "r") as f:
+        lines = f.read().splitlines()
+
+    out_lines = []
+    run = []
+    images = 0
+
+    def flush_run():
+        if len(run) < MIN_RUN_LENGTH:
+            out_lines.extend("param set %s %s" % pair for pair in run)
+            return 0
+
+        try:
+            image = encode_params(run, types)
+        except ValueError as e:
+            print("param compile skipped run in %s: %s" % (os.path.basename(file_path), e))
+            out_lines.extend("param set %s %s" % pair for pair in run)
+            return 0
+
+        suffix = ".params" if images == 0 else (".params%u" % images)
+        image_name = os.path.basename(file_path) + suffix
+        with open(os.path.join(os.path.dirname(file_path), image_name), "wb") as f:
+            f.write(image)
+        out_lines.append("param import /etc/init.d/" + image_name)
+        return 1
+
+    for line in lines:
+        match = PARAM_SET_RE.match(line)
+        if match:
+            run.append((match.group(1), match.group(2)))
+            continue
+        images += flush_run()
+        run = []
+        out_lines.append(line)
+    images += flush_run()
+
+    with open(file_path, "w") as f:
+        f.write("\n".join(out_lines) + "\n")
+
+
+def main():
+
+    # Parse commandline arguments
+    parser = argparse.ArgumentParser(description="Startup parameter compiler.")
+    parser.add_argument('--folder', action="store", help="folder containing startup scripts.")
+    parser.add_argument('--src', action="store", help="source tree with PARAM_DEFINE declarations.")
+    args = parser.parse_args()
+
+    if not args.folder or not os.path.isdir(args.folder):
+        return
+    if not args.src or not os.path.isdir(args.src):
+        return
+
+    print("Compiling startup parameters.")
+
+    types = scan_param_types(args.src)
+
+    for (root, dirs, files) in os.walk(args.folder):
+        for file in files:
+            if file.endswith((".params", ".mix", ".mixb")) or ".params" in file:
+                continue
+
+            compile_script(os.path.join(root, file), types)
+
+
+if __name__ == '__main__':
+    main()
@@ -73,7 +73,9 @@ def main():
                                                         pruned_content += line
                                         else:
                                                 if not line.isspace() and not line.strip().startswith("#"):
-                                                        pruned_content += line
+                                                        # indentation is for readability only,
+                                                        # drop it so nsh parses fewer bytes at boot
+                                                        pruned_content += line.strip() + "\n"
 
                         # overwrite old scratch file
                         with open(file_path, "w") as f:
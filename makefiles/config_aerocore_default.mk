@@ -31,6 +31,11 @@ MODULES		+= systemcmds/ver
 MODULES		+= systemcmds/mixer
 MODULES		+= systemcmds/param
 MODULES		+= systemcmds/perf
+MODULES		+= systemcmds/heapinfo
+MODULES		+= systemcmds/wdog
+MODULES		+= systemcmds/governor
+MODULES		+= systemcmds/load_mon
+MODULES		+= systemcmds/trace
 MODULES		+= systemcmds/pwm
 MODULES		+= systemcmds/esc_calib
 MODULES		+= systemcmds/reboot
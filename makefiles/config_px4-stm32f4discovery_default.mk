@@ -24,6 +24,11 @@ MODULES		+= systemcmds/bl_update
 MODULES		+= systemcmds/mixer
 MODULES		+= systemcmds/param
 MODULES		+= systemcmds/perf
+MODULES		+= systemcmds/heapinfo
+MODULES		+= systemcmds/wdog
+MODULES		+= systemcmds/governor
+MODULES		+= systemcmds/load_mon
+MODULES		+= systemcmds/trace
 MODULES		+= systemcmds/reboot
 MODULES		+= systemcmds/top
 MODULES		+= systemcmds/tests
@@ -45,6 +45,11 @@ MODULES		+= systemcmds/mtd
 MODULES		+= systemcmds/mixer
 MODULES		+= systemcmds/param
 MODULES		+= systemcmds/perf
+MODULES		+= systemcmds/heapinfo
+MODULES		+= systemcmds/wdog
+MODULES		+= systemcmds/governor
+MODULES		+= systemcmds/load_mon
+MODULES		+= systemcmds/trace
 MODULES		+= systemcmds/pwm
 MODULES		+= systemcmds/esc_calib
 MODULES		+= systemcmds/reboot
@@ -53,6 +58,7 @@ MODULES		+= systemcmds/config
 MODULES		+= systemcmds/nshterm
 MODULES		+= systemcmds/dumpfile
 MODULES		+= systemcmds/ver
+MODULES		+= systemcmds/waitfordev
 
 #
 # General system control
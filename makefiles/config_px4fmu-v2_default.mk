@@ -53,6 +53,12 @@ MODULES		+= systemcmds/bl_update
 MODULES		+= systemcmds/mixer
 MODULES		+= systemcmds/param
 MODULES		+= systemcmds/perf
+MODULES		+= systemcmds/heapinfo
+MODULES		+= systemcmds/wdog
+MODULES		+= systemcmds/governor
+MODULES		+= systemcmds/load_mon
+MODULES		+= systemcmds/bench
+MODULES		+= systemcmds/trace
 MODULES		+= systemcmds/pwm
 MODULES		+= systemcmds/esc_calib
 MODULES		+= systemcmds/reboot
@@ -62,6 +68,7 @@ MODULES		+= systemcmds/nshterm
 MODULES		+= systemcmds/mtd
 MODULES		+= systemcmds/dumpfile
 MODULES		+= systemcmds/ver
+MODULES		+= systemcmds/waitfordev
 
 #
 # General system control
@@ -79,6 +86,7 @@ MODULES 	+= modules/land_detector
 MODULES		+= modules/attitude_estimator_ekf
 MODULES		+= modules/ekf_att_pos_estimator
 MODULES		+= modules/position_estimator_inav
+MODULES		+= modules/terrain_estimator
 
 #
 # Vehicle Control
@@ -102,6 +110,7 @@ MODULES		+= modules/systemlib
 MODULES		+= modules/systemlib/mixer
 MODULES		+= modules/controllib
 MODULES		+= modules/uORB
+MODULES		+= modules/uorb_bench
 MODULES		+= modules/dataman
 
 #
@@ -51,6 +51,11 @@ MODULES		+= systemcmds/bl_update
 MODULES		+= systemcmds/mixer
 MODULES		+= systemcmds/param
 MODULES		+= systemcmds/perf
+MODULES		+= systemcmds/heapinfo
+MODULES		+= systemcmds/wdog
+MODULES		+= systemcmds/governor
+MODULES		+= systemcmds/load_mon
+MODULES		+= systemcmds/trace
 MODULES		+= systemcmds/pwm
 MODULES		+= systemcmds/esc_calib
 MODULES		+= systemcmds/reboot
@@ -60,6 +65,7 @@ MODULES		+= systemcmds/nshterm
 MODULES		+= systemcmds/mtd
 MODULES		+= systemcmds/dumpfile
 MODULES		+= systemcmds/ver
+MODULES		+= systemcmds/waitfordev
 
 #
 # General system control
@@ -353,6 +353,16 @@ LINK_DEPS		+= $(ROMFS_OBJ)
 # Remove all comments from startup and mixer files
 ROMFS_PRUNER	 = $(PX4_BASE)/Tools/px_romfs_pruner.py
 
+# Compile mixer files into the binary image format loaded without parsing
+MIXER_COMPILER	 = $(PX4_BASE)/Tools/px_mixer_compile.py
+
+# Compile 'param set' runs in startup scripts into binary parameter images
+PARAM_COMPILER	 = $(PX4_BASE)/Tools/px_param_compile.py
+
+# Compress the IO firmware images in /extras; the px4io uploader
+# decompresses them on the fly (see systemlib/lzss.c)
+LZSS_COMPRESSOR	 = $(PX4_BASE)/Tools/px_lzss_compress.py
+
 # Turn the ROMFS image into an object file
 $(ROMFS_OBJ): $(ROMFS_IMG) $(GLOBAL_DEPS)
 	$(call BIN_TO_OBJ,$<,$@,romfs_img)
@@ -371,8 +381,12 @@ $(ROMFS_SCRATCH): $(ROMFS_DEPS) $(GLOBAL_DEPS)
 ifneq ($(ROMFS_EXTRA_FILES),)
 	$(Q) $(MKDIR) -p $(ROMFS_SCRATCH)/extras
 	$(Q) $(COPY) $(ROMFS_EXTRA_FILES) $(ROMFS_SCRATCH)/extras
+	$(Q) for f in $(ROMFS_SCRATCH)/extras/*; do \
+		$(PYTHON) -u $(LZSS_COMPRESSOR) $$f $$f; done
 endif
 	$(Q) $(PYTHON) -u $(ROMFS_PRUNER) --folder $(ROMFS_SCRATCH)
+	$(Q) $(PYTHON) -u $(PARAM_COMPILER) --folder $(ROMFS_SCRATCH)/init.d --src $(PX4_BASE)/src
+	$(Q) $(PYTHON) -u $(MIXER_COMPILER) --folder $(ROMFS_SCRATCH)/mixers
 
 EXTRA_CLEANS		+= $(ROMGS_OBJ) $(ROMFS_IMG)
 
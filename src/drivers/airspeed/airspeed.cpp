@@ -65,6 +65,7 @@
 #include <systemlib/err.h>
 #include <systemlib/param/param.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/px4_work.h>
 
 #include <drivers/drv_airspeed.h>
 #include <drivers/drv_hrt.h>
@@ -346,13 +347,13 @@ Airspeed::start()
 	_reports->flush();
 
 	/* schedule a cycle to start things */
-	work_queue(HPWORK, &_work, (worker_t)&Airspeed::cycle_trampoline, this, 1);
+	px4_work_queue(PX4_WORK_SENSOR, &_work, (worker_t)&Airspeed::cycle_trampoline, this, 1);
 }
 
 void
 Airspeed::stop()
 {
-	work_cancel(HPWORK, &_work);
+	px4_work_cancel(PX4_WORK_SENSOR, &_work);
 }
 
 void
@@ -377,6 +378,23 @@ Airspeed::update_status()
 	}
 }
 
+unsigned
+Airspeed::phase_aligned_delay(unsigned interval_ticks)
+{
+	uint64_t interval = TICK2USEC((uint64_t)interval_ticks);
+
+	if (interval == 0) {
+		return interval_ticks;
+	}
+
+	/* wait until the next multiple of the interval on the hrt epoch */
+	uint64_t gap = interval - (hrt_absolute_time() % interval);
+
+	unsigned delay_ticks = USEC2TICK(gap);
+
+	return (delay_ticks > 0) ? delay_ticks : 1;
+}
+
 void
 Airspeed::cycle_trampoline(void *arg)
 {
@@ -127,6 +127,14 @@ protected:
 	 */
 	void update_status();
 
+	/**
+	 * Delay in ticks until the next multiple of the given interval on
+	 * the hrt epoch, so all airspeed sensors start their measurements
+	 * on the same time grid as the IMU drivers instead of free-running
+	 * at an arbitrary phase.
+	 */
+	unsigned	phase_aligned_delay(unsigned interval_ticks);
+
 	work_s			_work;
 	float			_max_differential_pressure_pa;
 	bool			_sensor_ok;
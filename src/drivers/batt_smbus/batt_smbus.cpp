@@ -161,6 +161,17 @@ private:
 	 */
 	void			cycle();
 
+	/**
+	 * static function that is called by the async I2C engine when the
+	 * telemetry burst has completed
+	 */
+	static void		transaction_complete(void *arg, int result);
+
+	/**
+	 * decode and publish the telemetry registers read by the burst
+	 */
+	void			handle_transaction(int result);
+
 	/**
 	 * Read a word from specified register
 	 */
@@ -187,6 +198,12 @@ private:
 	orb_id_t		_batt_orb_id;	///< uORB battery topic ID
 	uint64_t		_start_time;	///< system time we first attempt to communicate with battery
 	uint16_t		_batt_capacity;	///< battery's design capacity in mAh (0 means unknown)
+	device::i2c_transaction_s _trans;	///< async transaction for the per-cycle telemetry burst
+	struct i2c_msg_s	_msgv[6];	///< telemetry burst: one write/read pair per register
+	uint8_t			_cmds[3];	///< register commands referenced by _msgv
+	uint8_t			_volt_buf[3];	///< voltage word plus PEC
+	uint8_t			_curr_buf[6];	///< current block: length, 4 data bytes, PEC
+	uint8_t			_rem_buf[3];	///< remaining capacity word plus PEC
 };
 
 namespace
@@ -206,13 +223,42 @@ BATT_SMBUS::BATT_SMBUS(int bus, uint16_t batt_smbus_addr) :
 	_batt_topic(-1),
 	_batt_orb_id(nullptr),
 	_start_time(0),
-	_batt_capacity(0)
+	_batt_capacity(0),
+	_trans{},
+	_msgv{},
+	_cmds{},
+	_volt_buf{},
+	_curr_buf{},
+	_rem_buf{}
 {
 	// work_cancel in the dtor will explode if we don't do this...
 	memset(&_work, 0, sizeof(_work));
 
 	// capture startup time
 	_start_time = hrt_absolute_time();
+
+	// describe the per-cycle telemetry burst: one write/read pair per
+	// register, chained with repeated starts into a single bus transaction
+	_cmds[0] = BATT_SMBUS_VOLTAGE;
+	_cmds[1] = BATT_SMBUS_CURRENT;
+	_cmds[2] = BATT_SMBUS_REMAINING_CAPACITY;
+
+	uint8_t *bufs[3] = {_volt_buf, _curr_buf, _rem_buf};
+	const uint8_t lens[3] = {sizeof(_volt_buf), sizeof(_curr_buf), sizeof(_rem_buf)};
+
+	for (unsigned i = 0; i < 3; i++) {
+		_msgv[2 * i].flags = 0;
+		_msgv[2 * i].buffer = &_cmds[i];
+		_msgv[2 * i].length = 1;
+		_msgv[2 * i + 1].flags = I2C_M_READ;
+		_msgv[2 * i + 1].buffer = bufs[i];
+		_msgv[2 * i + 1].length = lens[i];
+	}
+
+	_trans.msgv = _msgv;
+	_trans.msgs = 6;
+	_trans.callback = &BATT_SMBUS::transaction_complete;
+	_trans.arg = this;
 }
 
 BATT_SMBUS::~BATT_SMBUS()
@@ -386,74 +432,97 @@ BATT_SMBUS::cycle()
 		return;
 	}
 
-	// read data from sensor
+	// fetch all telemetry registers in a single bus transaction; the
+	// completion callback decodes and publishes the report.  If the
+	// previous burst is still in flight the battery is stalling the bus,
+	// so skip this measurement rather than queueing up behind it.
+	(void)transfer_async(&_trans);
+
+	// schedule a fresh cycle call when the measurement is done
+	work_queue(HPWORK, &_work, (worker_t)&BATT_SMBUS::cycle_trampoline, this,
+		   USEC2TICK(BATT_SMBUS_MEASUREMENT_INTERVAL_MS));
+}
+
+void
+BATT_SMBUS::transaction_complete(void *arg, int result)
+{
+	BATT_SMBUS *dev = (BATT_SMBUS *)arg;
+
+	dev->handle_transaction(result);
+}
+
+void
+BATT_SMBUS::handle_transaction(int result)
+{
+	// nothing to report if the burst failed
+	if (result != OK) {
+		return;
+	}
+
+	// check the voltage word; a corrupt reading invalidates the report
+	if (get_PEC(BATT_SMBUS_VOLTAGE, true, _volt_buf, 2) != _volt_buf[2]) {
+		return;
+	}
+
+	// initialise new_report
 	struct battery_status_s new_report;
+	memset(&new_report, 0, sizeof(new_report));
 
 	// set time of reading
-	new_report.timestamp = now;
-
-	// read voltage
-	uint16_t tmp;
+	new_report.timestamp = hrt_absolute_time();
 
-	if (read_reg(BATT_SMBUS_VOLTAGE, tmp) == OK) {
-		// initialise new_report
-		memset(&new_report, 0, sizeof(new_report));
+	// convert millivolts to volts
+	new_report.voltage_v = ((float)((uint16_t)_volt_buf[1] << 8 | (uint16_t)_volt_buf[0])) / 1000.0f;
 
-		// convert millivolts to volts
-		new_report.voltage_v = ((float)tmp) / 1000.0f;
+	// decode the current block: length byte, 4 data bytes, PEC
+	if ((_curr_buf[0] == 4) &&
+	    (get_PEC(BATT_SMBUS_CURRENT, true, _curr_buf, 5) == _curr_buf[5])) {
+		new_report.current_a = -(float)((int32_t)((uint32_t)_curr_buf[4] << 24 | (uint32_t)_curr_buf[3] << 16 |
+						(uint32_t)_curr_buf[2] << 8 | (uint32_t)_curr_buf[1])) / 1000.0f;
+	}
 
-		// read current
-		uint8_t buff[4];
+	// read battery design capacity; only needed until the value is cached
+	uint16_t tmp;
 
-		if (read_block(BATT_SMBUS_CURRENT, buff, 4, false) == 4) {
-			new_report.current_a = -(float)((int32_t)((uint32_t)buff[3] << 24 | (uint32_t)buff[2] << 16 | (uint32_t)buff[1] << 8 |
-							(uint32_t)buff[0])) / 1000.0f;
+	if (_batt_capacity == 0) {
+		if (read_reg(BATT_SMBUS_FULL_CHARGE_CAPACITY, tmp) == OK) {
+			_batt_capacity = tmp;
 		}
+	}
 
-		// read battery design capacity
-		if (_batt_capacity == 0) {
-			if (read_reg(BATT_SMBUS_FULL_CHARGE_CAPACITY, tmp) == OK) {
-				_batt_capacity = tmp;
-			}
-		}
+	// decode remaining capacity
+	if ((_batt_capacity > 0) &&
+	    (get_PEC(BATT_SMBUS_REMAINING_CAPACITY, true, _rem_buf, 2) == _rem_buf[2])) {
+		tmp = (uint16_t)_rem_buf[1] << 8 | (uint16_t)_rem_buf[0];
 
-		// read remaining capacity
-		if (_batt_capacity > 0) {
-			if (read_reg(BATT_SMBUS_REMAINING_CAPACITY, tmp) == OK) {
-				if (tmp < _batt_capacity) {
-					new_report.discharged_mah = _batt_capacity - tmp;
-				}
-			}
+		if (tmp < _batt_capacity) {
+			new_report.discharged_mah = _batt_capacity - tmp;
 		}
+	}
 
-		// publish to orb
-		if (_batt_topic != -1) {
-			orb_publish(_batt_orb_id, _batt_topic, &new_report);
+	// publish to orb
+	if (_batt_topic != -1) {
+		orb_publish(_batt_orb_id, _batt_topic, &new_report);
 
-		} else {
-			_batt_topic = orb_advertise(_batt_orb_id, &new_report);
+	} else {
+		_batt_topic = orb_advertise(_batt_orb_id, &new_report);
 
-			if (_batt_topic < 0) {
-				errx(1, "ADVERT FAIL");
-			}
+		if (_batt_topic < 0) {
+			errx(1, "ADVERT FAIL");
 		}
+	}
 
-		// copy report for test()
-		_last_report = new_report;
-
-		// post a report to the ring
-		_reports->force(&new_report);
+	// copy report for test()
+	_last_report = new_report;
 
-		// notify anyone waiting for data
-		poll_notify(POLLIN);
+	// post a report to the ring
+	_reports->force(&new_report);
 
-		// record we are working
-		_enabled = true;
-	}
+	// notify anyone waiting for data
+	poll_notify(POLLIN);
 
-	// schedule a fresh cycle call when the measurement is done
-	work_queue(HPWORK, &_work, (worker_t)&BATT_SMBUS::cycle_trampoline, this,
-		   USEC2TICK(BATT_SMBUS_MEASUREMENT_INTERVAL_MS));
+	// record we are working
+	_enabled = true;
 }
 
 int
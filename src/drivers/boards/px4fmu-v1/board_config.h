@@ -182,6 +182,7 @@ __BEGIN_DECLS
 #define HRT_TIMER		1	/* use timer1 for the HRT */
 #define HRT_TIMER_CHANNEL	1	/* use capture/compare channel */
 #define HRT_PPM_CHANNEL		3	/* use capture/compare channel 3 */
+#define HRT_PPM_DMAMAP		DMAMAP_TIM1_CH3	/* capture PPM edges in batches via DMA */
 #define GPIO_PPM_IN		(GPIO_ALT|GPIO_AF1|GPIO_PULLUP|GPIO_PORTA|GPIO_PIN10)
 
 /****************************************************************************************************
@@ -254,4 +254,77 @@ I2C::transfer(i2c_msg_s *msgv, unsigned msgs)
 	return ret;
 }
 
+int
+I2C::transfer_multi(i2c_msg_s *msgv, unsigned msgs)
+{
+	int ret;
+	unsigned retry_count = 0;
+
+	do {
+		ret = I2C_TRANSFER(_dev, msgv, msgs);
+
+		/* success */
+		if (ret == OK)
+			break;
+
+		/* if we have already retried once, or we are going to give up, then reset the bus */
+		if ((retry_count >= 1) || (retry_count >= _retries))
+			up_i2creset(_dev);
+
+	} while (retry_count++ < _retries);
+
+	return ret;
+}
+
+int
+I2C::transfer_async(struct i2c_transaction_s *trans)
+{
+	int ret;
+
+	/* the descriptor is single-use until its callback has run */
+	if (trans->busy)
+		return -EBUSY;
+
+	trans->dev = this;
+	trans->busy = true;
+
+	/*
+	 * Run the transaction from the low-priority work queue; the
+	 * underlying NuttX driver is interrupt-driven with its own bus
+	 * timeout, so only other asynchronous transactions wait behind a
+	 * slow or stuck slave.
+	 */
+	ret = work_queue(LPWORK, &trans->work, (worker_t)&I2C::_async_trampoline, trans, 0);
+
+	if (ret != OK) {
+		trans->busy = false;
+		return ret;
+	}
+
+	return OK;
+}
+
+void
+I2C::_async_trampoline(void *arg)
+{
+	struct i2c_transaction_s *trans = reinterpret_cast<struct i2c_transaction_s *>(arg);
+	int result;
+
+	/* drop transactions that have queued past their deadline */
+	if ((trans->deadline != 0) && (hrt_absolute_time() > trans->deadline)) {
+		result = -ETIMEDOUT;
+
+	} else if (trans->msgv != nullptr) {
+		result = trans->dev->transfer(trans->msgv, trans->msgs);
+
+	} else {
+		result = trans->dev->transfer(trans->send, trans->send_len, trans->recv, trans->recv_len);
+	}
+
+	trans->busy = false;
+
+	if (trans->callback != nullptr)
+		trans->callback(trans->arg, result);
+}
+
 } // namespace device
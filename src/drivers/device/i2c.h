@@ -43,10 +43,50 @@
 #include "device.h"
 
 #include <nuttx/i2c.h>
+#include <nuttx/wqueue.h>
+
+#include <drivers/drv_hrt.h>
 
 namespace device __EXPORT
 {
 
+class I2C;
+
+/**
+ * Completion callback for an asynchronous I2C transaction.
+ *
+ * Invoked from the low-priority work queue once the transaction has
+ * completed, failed or timed out.
+ *
+ * @param arg		The argument stored in the transaction.
+ * @param result	OK if the transfer was successful, -errno otherwise.
+ */
+typedef void	(*i2c_complete_t)(void *arg, int result);
+
+/**
+ * Descriptor for an asynchronous I2C transaction.
+ *
+ * The descriptor and the buffers it points to must remain valid until
+ * the completion callback has been invoked.
+ */
+struct i2c_transaction_s {
+	struct work_s	work;		/**< work queue entry (internal) */
+	I2C		*dev;		/**< device performing the transaction (internal) */
+	const uint8_t	*send;		/**< bytes to send, or nullptr */
+	unsigned	send_len;	/**< number of bytes to send */
+	uint8_t		*recv;		/**< buffer for received bytes, or nullptr */
+	unsigned	recv_len;	/**< number of bytes to receive */
+	struct i2c_msg_s *msgv;		/**< multi-part message vector, used instead of
+					     send/recv when non-null; slave addresses
+					     are forced to the device address */
+	unsigned	msgs;		/**< number of entries in msgv */
+	hrt_abstime	deadline;	/**< if nonzero, abandon the transaction with
+					     -ETIMEDOUT if it has not started by this time */
+	i2c_complete_t	callback;	/**< completion callback, or nullptr */
+	void		*arg;		/**< argument passed to the callback */
+	volatile bool	busy;		/**< set while the transaction is queued or in progress */
+};
+
 /**
  * Abstract class for character device on I2C
  */
@@ -126,6 +166,35 @@ protected:
 	 */
 	int		transfer(i2c_msg_s *msgv, unsigned msgs);
 
+	/**
+	 * Perform a multi-part I2C transaction with per-message addresses.
+	 *
+	 * Unlike transfer(), the addr fields of the message vector are used
+	 * as given, so several slaves can be updated in one bus burst
+	 * instead of scattering individual transactions across the cycle.
+	 *
+	 * @param msgv		An I2C message vector with addresses filled in.
+	 * @param msgs		The number of entries in the message vector.
+	 * @return		OK if the transfer was successful, -errno
+	 *			otherwise.
+	 */
+	int		transfer_multi(i2c_msg_s *msgv, unsigned msgs);
+
+	/**
+	 * Start an asynchronous I2C transaction to the device.
+	 *
+	 * The transaction runs from the low-priority work queue, so the
+	 * caller's work queue slot is not occupied for the duration of the
+	 * bus transaction and a stuck slave cannot stall the high-priority
+	 * queue that the sensor state machines share.
+	 *
+	 * @param trans		Transaction descriptor; must remain valid
+	 *			until the completion callback has run.
+	 * @return		OK if the transaction was queued, -EBUSY if
+	 *			it is still in progress, -errno otherwise.
+	 */
+	int		transfer_async(struct i2c_transaction_s *trans);
+
 	/**
 	 * Change the bus address.
 	 *
@@ -144,6 +213,13 @@ private:
 	uint32_t		_frequency;
 	struct i2c_dev_s	*_dev;
 
+	/**
+	 * Execute a queued asynchronous transaction from the work queue.
+	 *
+	 * @param arg		The transaction descriptor being executed.
+	 */
+	static void	_async_trampoline(void *arg);
+
 	I2C(const device::I2C &);
 	I2C operator=(const device::I2C &);
 };
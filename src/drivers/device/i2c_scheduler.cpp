@@ -0,0 +1,198 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file i2c_scheduler.cpp
+ *
+ * Shared per-bus scheduler for polled I2C drivers.
+ */
+
+#include "i2c_scheduler.h"
+
+#include <sys/types.h>
+
+#include <nuttx/arch.h>
+
+#include <systemlib/px4_work.h>
+
+#include <errno.h>
+#include <stddef.h>
+
+namespace device
+{
+
+I2CScheduler::bus_s I2CScheduler::_buses[I2CScheduler::_max_buses];
+
+int
+I2CScheduler::schedule(int bus, worker_t worker, void *arg, uint32_t delay)
+{
+	int index = bus - 1;
+
+	if (index < 0 || index >= static_cast<int>(_max_buses)) {
+		return -EINVAL;
+	}
+
+	if (worker == nullptr) {
+		return -EINVAL;
+	}
+
+	bus_s *b = &_buses[index];
+	client_s *client = nullptr;
+
+	irqstate_t flags = irqsave();
+
+	/* look for the client's existing entry first, then for a free slot */
+	for (unsigned i = 0; i < _max_clients; i++) {
+		if (b->clients[i].active && (b->clients[i].worker == worker) && (b->clients[i].arg == arg)) {
+			client = &b->clients[i];
+			break;
+		}
+	}
+
+	if (client == nullptr) {
+		for (unsigned i = 0; i < _max_clients; i++) {
+			if (!b->clients[i].active) {
+				client = &b->clients[i];
+				break;
+			}
+		}
+	}
+
+	if (client == nullptr) {
+		irqrestore(flags);
+		return -ENOSPC;
+	}
+
+	clock_t due = clock_systimer() + delay;
+
+	/*
+	 * Stagger clients that fall due on the same tick; the bus is serial
+	 * anyway, and spreading the transactions keeps any one work queue
+	 * slot short.
+	 */
+	bool collision;
+
+	do {
+		collision = false;
+
+		for (unsigned i = 0; i < _max_clients; i++) {
+			client_s *other = &b->clients[i];
+
+			if (other->active && (other != client) && (other->due == due)) {
+				due++;
+				collision = true;
+			}
+		}
+	} while (collision);
+
+	client->worker = worker;
+	client->arg = arg;
+	client->due = due;
+	client->active = true;
+
+	_rearm(b);
+
+	irqrestore(flags);
+
+	return OK;
+}
+
+void
+I2CScheduler::cancel(worker_t worker, void *arg)
+{
+	irqstate_t flags = irqsave();
+
+	for (unsigned i = 0; i < _max_buses; i++) {
+		for (unsigned j = 0; j < _max_clients; j++) {
+			client_s *client = &_buses[i].clients[j];
+
+			if (client->active && (client->worker == worker) && (client->arg == arg)) {
+				client->active = false;
+			}
+		}
+	}
+
+	irqrestore(flags);
+}
+
+void
+I2CScheduler::_tick(void *arg)
+{
+	bus_s *b = reinterpret_cast<bus_s *>(arg);
+	clock_t now = clock_systimer();
+
+	for (unsigned i = 0; i < _max_clients; i++) {
+		client_s *client = &b->clients[i];
+
+		if (client->active && ((int32_t)(client->due - now) <= 0)) {
+			/* deactivate first - the worker usually reschedules itself */
+			client->active = false;
+			client->worker(client->arg);
+		}
+	}
+
+	irqstate_t flags = irqsave();
+	_rearm(b);
+	irqrestore(flags);
+}
+
+void
+I2CScheduler::_rearm(bus_s *b)
+{
+	clock_t now = clock_systimer();
+	int32_t soonest = -1;
+
+	for (unsigned i = 0; i < _max_clients; i++) {
+		client_s *client = &b->clients[i];
+
+		if (client->active) {
+			int32_t ticks = (int32_t)(client->due - now);
+
+			if (ticks < 0) {
+				ticks = 0;
+			}
+
+			if ((soonest < 0) || (ticks < soonest)) {
+				soonest = ticks;
+			}
+		}
+	}
+
+	if (soonest >= 0) {
+		/* the entry may already be armed for a different time */
+		px4_work_cancel(PX4_WORK_SENSOR, &b->work);
+		px4_work_queue(PX4_WORK_SENSOR, &b->work, (worker_t)&I2CScheduler::_tick, b, soonest);
+	}
+}
+
+} // namespace device
@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file i2c_scheduler.h
+ *
+ * Shared per-bus scheduler for polled I2C drivers.
+ *
+ * Drivers that poll their sensors from the high-priority work queue can
+ * schedule their cycle functions here instead of calling work_queue()
+ * directly. The scheduler keeps one work queue entry per I2C bus and
+ * staggers clients that fall due on the same tick, so the measure and
+ * collect phases of drivers sharing a bus are interleaved rather than
+ * piling up in a single work queue slot.
+ */
+
+#ifndef _DEVICE_I2C_SCHEDULER_H
+#define _DEVICE_I2C_SCHEDULER_H
+
+#include <nuttx/config.h>
+#include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
+
+#include <stdint.h>
+
+namespace device __EXPORT
+{
+
+/**
+ * Cooperative scheduler for drivers sharing an I2C bus.
+ */
+class __EXPORT I2CScheduler
+{
+public:
+	/**
+	 * Schedule a callback for a device on the given bus.
+	 *
+	 * Semantics follow work_queue(): scheduling a callback that is
+	 * already pending just moves its due time. A callback falling due
+	 * on the same tick as another client of the bus is deferred tick
+	 * by tick until it has a slot of its own.
+	 *
+	 * @param bus		The I2C bus the client's device is on.
+	 * @param worker	Function to call, in work queue context.
+	 * @param arg		Argument passed to the worker.
+	 * @param delay		Delay before the call, in system ticks.
+	 * @return		OK if the callback was scheduled, -errno
+	 *			otherwise.
+	 */
+	static int	schedule(int bus, worker_t worker, void *arg, uint32_t delay);
+
+	/**
+	 * Cancel a previously scheduled callback.
+	 *
+	 * @param worker	Function passed to schedule().
+	 * @param arg		Argument passed to schedule().
+	 */
+	static void	cancel(worker_t worker, void *arg);
+
+private:
+	static const unsigned	_max_buses = 3;
+	static const unsigned	_max_clients = 8;
+
+	struct client_s {
+		worker_t	worker;		/**< client callback */
+		void		*arg;		/**< callback argument */
+		clock_t		due;		/**< absolute tick the client should run at */
+		bool		active;		/**< entry is scheduled */
+	};
+
+	struct bus_s {
+		struct work_s	work;		/**< work queue entry driving this bus */
+		client_s	clients[_max_clients];
+	};
+
+	static bus_s	_buses[_max_buses];
+
+	/**
+	 * Run all due clients of a bus and re-arm the work queue entry.
+	 *
+	 * @param arg		The bus being ticked.
+	 */
+	static void	_tick(void *arg);
+
+	/**
+	 * Arm the bus work queue entry for the earliest due client.
+	 *
+	 * Must be called with interrupts disabled.
+	 *
+	 * @param bus		The bus to re-arm.
+	 */
+	static void	_rearm(bus_s *bus);
+};
+
+} // namespace device
+
+#endif /* _DEVICE_I2C_SCHEDULER_H */
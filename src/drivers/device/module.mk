@@ -38,5 +38,6 @@
 SRCS		= cdev.cpp \
 		  device.cpp \
 		  i2c.cpp \
+		  i2c_scheduler.cpp \
 		  pio.cpp \
 		  spi.cpp
@@ -90,6 +90,19 @@ public:
 	 */
 	bool			get(void *val, size_t val_size = 0);
 
+	/**
+	 * Get a batch of items from the buffer.
+	 *
+	 * Items are copied out oldest-first with a single atomic update of
+	 * the removal index, so a producer forcing items in from interrupt
+	 * context never sees a half-finished drain.
+	 *
+	 * @param vals		Storage for up to num_items items
+	 * @param num_items	Maximum number of items to get
+	 * @return		The number of items that were got.
+	 */
+	unsigned		get_bulk(void *vals, unsigned num_items);
+
 	bool			get(int8_t &val);
 	bool			get(uint8_t &val);
 	bool			get(int16_t &val);
@@ -392,6 +405,30 @@ RingBuffer::get(void *val, size_t val_size)
 	}
 }
 
+unsigned
+RingBuffer::get_bulk(void *vals, unsigned num_items)
+{
+	char *dst = (char *)vals;
+	unsigned tail, next;
+	unsigned n;
+
+	do {
+		n = 0;
+		next = tail = _tail;
+
+		/* copy out items until the request is satisfied or the buffer drains */
+		while ((n < num_items) && (next != _head)) {
+			memcpy(dst + n * _item_size, &_buf[next * _item_size], _item_size);
+			next = _next(next);
+			n++;
+		}
+
+		/* if the tail moved while we copied, the oldest items were overwritten - try again */
+	} while (!__sync_bool_compare_and_swap(&_tail, tail, next));
+
+	return n;
+}
+
 bool
 RingBuffer::get(int8_t &val)
 {
@@ -108,6 +108,20 @@ struct mixer_simple_s {
  */
 #define MIXERIOCLOADBUF		_MIXERIOC(5)
 
+/** precompiled binary mixer image passed to MIXERIOCLOADBUFBIN */
+struct mixer_binary_buf_s {
+	const uint8_t	*buf;		/**< binary mixer image */
+	unsigned	buflen;		/**< image length in bytes */
+};
+
+/**
+ * Add mixer(s) from the precompiled binary image in (struct mixer_binary_buf_s *)arg.
+ *
+ * Drivers that forward mixer text to a coprocessor (px4io) do not
+ * support this operation; callers should fall back to MIXERIOCLOADBUF.
+ */
+#define MIXERIOCLOADBUFBIN	_MIXERIOC(6)
+
 /*
  * XXX Thoughts for additional operations:
  *
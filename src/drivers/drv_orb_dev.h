@@ -89,4 +89,13 @@
 /** Get the priority for the topic */
 #define ORBIOCGPRIORITY		_ORBIOC(14)
 
+/** Acquire a zero-copy read reference, sets *(const void **)arg */
+#define ORBIOCACQUIRE		_ORBIOC(15)
+
+/** Release a zero-copy read reference taken with ORBIOCACQUIRE */
+#define ORBIOCRELEASE		_ORBIOC(16)
+
+/** Get the address of the node's generation counter, sets *(volatile unsigned **)arg */
+#define ORBIOCGGENCOUNTER	_ORBIOC(17)
+
 #endif /* _DRV_UORB_H */
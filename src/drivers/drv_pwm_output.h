@@ -246,6 +246,9 @@ ORB_DECLARE(output_pwm);
 /** setup OVERRIDE_IMMEDIATE behaviour on FMU fail */
 #define PWM_SERVO_SET_OVERRIDE_IMMEDIATE	_IOC(_PWM_SERVO_BASE, 30)
 
+/** force the IO board to apply the failsafe values as soon as RC input is lost */
+#define PWM_SERVO_SET_RC_LOSS_FAILSAFE		_IOC(_PWM_SERVO_BASE, 31)
+
 /*
  *
  *
@@ -265,6 +268,13 @@ ORB_DECLARE(output_pwm);
  */
 #define PWM_SERVO_GET_RATEGROUP(_n) _IOC(_PWM_SERVO_BASE, 0x60 + _n)
 
+/** switch all outputs between periodic PWM and OneShot125 single pulse
+ * per control update; (unsigned)arg nonzero enables */
+#define PWM_SERVO_SET_ONESHOT	_IOC(_PWM_SERVO_BASE, 0x80)
+
+/** get the OneShot mode flag in *(uint32_t *)arg */
+#define PWM_SERVO_GET_ONESHOT	_IOC(_PWM_SERVO_BASE, 0x81)
+
 /*
  * Low-level PWM output interface.
  *
@@ -334,6 +344,39 @@ __EXPORT extern int	up_pwm_servo_set_rate_group_update(unsigned group, unsigned
  */
 __EXPORT extern int	up_pwm_servo_set(unsigned channel, servo_position_t value);
 
+/**
+ * Set the current output value for a group of channels in one operation.
+ *
+ * All affected timers hold off their update events while the compare
+ * registers are written, so every channel takes up the new value at the
+ * same update event and the outputs cannot skew against each other.
+ *
+ * @param values	The output pulse widths in microseconds, one per
+ *			channel starting from channel 0.
+ * @param count		The number of channels to set.
+ */
+__EXPORT extern int	up_pwm_servo_set_multi(const servo_position_t *values, unsigned count);
+
+/**
+ * Switch all outputs between periodic PWM and OneShot operation.
+ *
+ * In OneShot mode the timers count in 1/8 microsecond steps and only
+ * emit a pulse when up_pwm_servo_trigger() is called, so the usual
+ * 1000..2000 output values produce OneShot125-class 125..250 us pulses
+ * synchronized to the control update instead of the next PWM frame.
+ *
+ * @param enable	true to select OneShot, false for periodic PWM.
+ * @return		OK on success.
+ */
+__EXPORT extern int	up_pwm_servo_set_oneshot_mode(bool enable);
+
+/**
+ * Emit one pulse with the last set values on all OneShot timers.
+ *
+ * A no-op while OneShot mode is not enabled.
+ */
+__EXPORT extern void	up_pwm_servo_trigger(void);
+
 /**
  * Get the current output value for a channel.
  *
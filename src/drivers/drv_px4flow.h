@@ -61,5 +61,11 @@ ORB_DECLARE(optical_flow);
 #define _PX4FLOWIOCBASE			(0x7700)
 #define __PX4FLOWIOC(_n)		(_IOC(_PX4FLOWIOCBASE, _n))
 
+/** set the flow integration window (publication interval) in microseconds; zero publishes every frame */
+#define PX4FLOWIOCSINTWINDOW	__PX4FLOWIOC(0)
+
+/** get the flow integration window in microseconds */
+#define PX4FLOWIOCGINTWINDOW	__PX4FLOWIOC(1)
+
 
 #endif /* _DRV_PX4FLOW_H */
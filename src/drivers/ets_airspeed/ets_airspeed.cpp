@@ -65,6 +65,7 @@
 #include <systemlib/err.h>
 #include <systemlib/param/param.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/px4_work.h>
 
 #include <drivers/drv_airspeed.h>
 #include <drivers/drv_hrt.h>
@@ -226,12 +227,13 @@ ETSAirspeed::cycle()
 		 */
 		if (_measure_ticks > USEC2TICK(CONVERSION_INTERVAL)) {
 
-			/* schedule a fresh cycle call when we are ready to measure again */
-			work_queue(HPWORK,
+			/* schedule the next measurement on the hrt epoch grid, so the
+			 * samples stay in phase with the IMU instead of free-running */
+			px4_work_queue(PX4_WORK_SENSOR,
 				   &_work,
 				   (worker_t)&Airspeed::cycle_trampoline,
 				   this,
-				   _measure_ticks - USEC2TICK(CONVERSION_INTERVAL));
+				   phase_aligned_delay(_measure_ticks));
 
 			return;
 		}
@@ -249,7 +251,7 @@ ETSAirspeed::cycle()
 	_collect_phase = true;
 
 	/* schedule a fresh cycle call when the measurement is done */
-	work_queue(HPWORK,
+	px4_work_queue(PX4_WORK_SENSOR,
 		   &_work,
 		   (worker_t)&Airspeed::cycle_trampoline,
 		   this,
@@ -44,6 +44,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdbool.h>
 #include <string.h>
 #include <arch/math.h>
 #include <geo/geo.h>
@@ -106,59 +107,74 @@ void frsky_init()
 	vehicle_status_sub = orb_subscribe(ORB_ID(vehicle_status));
 }
 
-/**
- * Sends a 0x5E start/stop byte.
- */
-static void frsky_send_startstop(int uart)
-{
-	static const uint8_t c = 0x5E;
-	write(uart, &c, sizeof(c));
-}
+/* cached encoded frame images, re-encoded only when their source topics update */
+static uint8_t frame1_buf[8 * FRSKY_DATA_MAX + 1];
+static unsigned frame1_len = 0;
+static uint8_t frame2_buf[14 * FRSKY_DATA_MAX + 1];
+static unsigned frame2_len = 0;
+static uint8_t frame3_buf[4 * FRSKY_DATA_MAX + 1];
+static unsigned frame3_len = 0;
 
 /**
- * Sends one byte, performing byte-stuffing if necessary.
+ * Appends one byte to the frame buffer, performing byte-stuffing if
+ * necessary; returns the new buffer position.
  */
-static void frsky_send_byte(int uart, uint8_t value)
+static unsigned frsky_pack_byte(uint8_t *buf, unsigned pos, uint8_t value)
 {
-	const uint8_t x5E[] = { 0x5D, 0x3E };
-	const uint8_t x5D[] = { 0x5D, 0x3D };
-
 	switch (value) {
 	case 0x5E:
-		write(uart, x5E, sizeof(x5E));
+		buf[pos++] = 0x5D;
+		buf[pos++] = 0x3E;
 		break;
 
 	case 0x5D:
-		write(uart, x5D, sizeof(x5D));
+		buf[pos++] = 0x5D;
+		buf[pos++] = 0x3D;
 		break;
 
 	default:
-		write(uart, &value, sizeof(value));
+		buf[pos++] = value;
 		break;
 	}
+
+	return pos;
 }
 
 /**
- * Sends one data id/value pair.
+ * Appends one data id/value pair to the frame buffer; returns the new
+ * buffer position.
  */
-static void frsky_send_data(int uart, uint8_t id, int16_t data)
+static unsigned frsky_pack_data(uint8_t *buf, unsigned pos, uint8_t id, int16_t data)
 {
 	/* Cast data to unsigned, because signed shift might behave incorrectly */
 	uint16_t udata = data;
 
-	frsky_send_startstop(uart);
+	buf[pos++] = 0x5E;	/* start/stop byte */
+
+	pos = frsky_pack_byte(buf, pos, id);
+	pos = frsky_pack_byte(buf, pos, udata);      /* LSB */
+	pos = frsky_pack_byte(buf, pos, udata >> 8); /* MSB */
 
-	frsky_send_byte(uart, id);
-	frsky_send_byte(uart, udata);      /* LSB */
-	frsky_send_byte(uart, udata >> 8); /* MSB */
+	return pos;
 }
 
 /**
- * Sends frame 1 (every 200ms):
+ * Refreshes the cached frame 1 image:
  *   acceleration values, barometer altitude, temperature, battery voltage & current
  */
-void frsky_send_frame1(int uart)
+static void frsky_update_frame1(void)
 {
+	bool sensors_updated = false;
+	bool battery_updated = false;
+
+	orb_check(sensor_sub, &sensors_updated);
+	orb_check(battery_sub, &battery_updated);
+
+	if (!(sensors_updated || battery_updated) && frame1_len > 0) {
+		/* nothing changed, keep the cached image */
+		return;
+	}
+
 	/* get a local copy of the current sensor values */
 	struct sensor_combined_s raw;
 	memset(&raw, 0, sizeof(raw));
@@ -169,28 +185,33 @@ void frsky_send_frame1(int uart)
 	memset(&battery, 0, sizeof(battery));
 	orb_copy(ORB_ID(battery_status), battery_sub, &battery);
 
-	/* send formatted frame */
-	frsky_send_data(uart, FRSKY_ID_ACCEL_X,
+	/* pack the formatted frame */
+	uint8_t *buf = frame1_buf;
+	unsigned pos = 0;
+
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_ACCEL_X,
 			roundf(raw.accelerometer_m_s2[0] * 1000.0f));
-	frsky_send_data(uart, FRSKY_ID_ACCEL_Y,
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_ACCEL_Y,
 			roundf(raw.accelerometer_m_s2[1] * 1000.0f));
-	frsky_send_data(uart, FRSKY_ID_ACCEL_Z,
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_ACCEL_Z,
 			roundf(raw.accelerometer_m_s2[2] * 1000.0f));
 
-	frsky_send_data(uart, FRSKY_ID_BARO_ALT_BP,
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_BARO_ALT_BP,
 			raw.baro_alt_meter);
-	frsky_send_data(uart, FRSKY_ID_BARO_ALT_AP,
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_BARO_ALT_AP,
 			roundf(frac(raw.baro_alt_meter) * 100.0f));
 
-	frsky_send_data(uart, FRSKY_ID_TEMP1,
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_TEMP1,
 			roundf(raw.baro_temp_celcius));
 
-	frsky_send_data(uart, FRSKY_ID_VFAS,
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_VFAS,
 			roundf(battery.voltage_v * 10.0f));
-	frsky_send_data(uart, FRSKY_ID_CURRENT,
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_CURRENT,
 			(battery.current_a < 0) ? 0 : roundf(battery.current_a * 10.0f));
 
-	frsky_send_startstop(uart);
+	buf[pos++] = 0x5E;	/* closing start/stop byte */
+
+	frame1_len = pos;
 }
 
 /**
@@ -203,11 +224,22 @@ static float frsky_format_gps(float dec)
 }
 
 /**
- * Sends frame 2 (every 1000ms):
+ * Refreshes the cached frame 2 image:
  *   GPS course, latitude, longitude, ground speed, GPS altitude, remaining battery level
  */
-void frsky_send_frame2(int uart)
+static void frsky_update_frame2(void)
 {
+	bool pos_updated = false;
+	bool status_updated = false;
+
+	orb_check(global_position_sub, &pos_updated);
+	orb_check(vehicle_status_sub, &status_updated);
+
+	if (!(pos_updated || status_updated) && frame2_len > 0) {
+		/* nothing changed, keep the cached image */
+		return;
+	}
+
 	/* get a local copy of the global position data */
 	struct vehicle_global_position_s global_pos;
 	memset(&global_pos, 0, sizeof(global_pos));
@@ -238,50 +270,99 @@ void frsky_send_frame2(int uart)
 		sec    = tm_gps->tm_sec;
 	}
 
-	frsky_send_data(uart, FRSKY_ID_GPS_COURS_BP, course);
-	frsky_send_data(uart, FRSKY_ID_GPS_COURS_AP, frac(course) * 1000.0f);
+	/* pack the formatted frame */
+	uint8_t *buf = frame2_buf;
+	unsigned pos = 0;
 
-	frsky_send_data(uart, FRSKY_ID_GPS_LAT_BP, lat);
-	frsky_send_data(uart, FRSKY_ID_GPS_LAT_AP, frac(lat) * 10000.0f);
-	frsky_send_data(uart, FRSKY_ID_GPS_LAT_NS, lat_ns);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_COURS_BP, course);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_COURS_AP, frac(course) * 1000.0f);
 
-	frsky_send_data(uart, FRSKY_ID_GPS_LONG_BP, lon);
-	frsky_send_data(uart, FRSKY_ID_GPS_LONG_AP, frac(lon) * 10000.0f);
-	frsky_send_data(uart, FRSKY_ID_GPS_LONG_EW, lon_ew);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_LAT_BP, lat);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_LAT_AP, frac(lat) * 10000.0f);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_LAT_NS, lat_ns);
 
-	frsky_send_data(uart, FRSKY_ID_GPS_SPEED_BP, speed);
-	frsky_send_data(uart, FRSKY_ID_GPS_SPEED_AP, frac(speed) * 100.0f);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_LONG_BP, lon);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_LONG_AP, frac(lon) * 10000.0f);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_LONG_EW, lon_ew);
 
-	frsky_send_data(uart, FRSKY_ID_GPS_ALT_BP, alt);
-	frsky_send_data(uart, FRSKY_ID_GPS_ALT_AP, frac(alt) * 100.0f);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_SPEED_BP, speed);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_SPEED_AP, frac(speed) * 100.0f);
 
-	frsky_send_data(uart, FRSKY_ID_FUEL,
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_ALT_BP, alt);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_ALT_AP, frac(alt) * 100.0f);
+
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_FUEL,
 			roundf(vehicle_status.battery_remaining * 100.0f));
 
-	frsky_send_data(uart, FRSKY_ID_GPS_SEC, sec);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_SEC, sec);
+
+	buf[pos++] = 0x5E;	/* closing start/stop byte */
 
-	frsky_send_startstop(uart);
+	frame2_len = pos;
 }
 
 /**
- * Sends frame 3 (every 5000ms):
+ * Refreshes the cached frame 3 image:
  *   GPS date & time
+ *
+ * Always re-encoded when scheduled since the time advances without the
+ * position topic necessarily updating.
  */
-void frsky_send_frame3(int uart)
+static void frsky_update_frame3(void)
 {
-	/* get a local copy of the battery data */
+	/* get a local copy of the global position data */
 	struct vehicle_global_position_s global_pos;
 	memset(&global_pos, 0, sizeof(global_pos));
 	orb_copy(ORB_ID(vehicle_global_position), global_position_sub, &global_pos);
 
-	/* send formatted frame */
+	/* format the time */
 	time_t time_gps = global_pos.time_utc_usec / 1000000ULL;
 	struct tm *tm_gps = gmtime(&time_gps);
 	uint16_t hour_min = (tm_gps->tm_min << 8) | (tm_gps->tm_hour & 0xff);
-	frsky_send_data(uart, FRSKY_ID_GPS_DAY_MONTH, tm_gps->tm_mday);
-	frsky_send_data(uart, FRSKY_ID_GPS_YEAR, tm_gps->tm_year);
-	frsky_send_data(uart, FRSKY_ID_GPS_HOUR_MIN, hour_min);
-	frsky_send_data(uart, FRSKY_ID_GPS_SEC, tm_gps->tm_sec);
 
-	frsky_send_startstop(uart);
+	/* pack the formatted frame */
+	uint8_t *buf = frame3_buf;
+	unsigned pos = 0;
+
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_DAY_MONTH, tm_gps->tm_mday);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_YEAR, tm_gps->tm_year);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_HOUR_MIN, hour_min);
+	pos = frsky_pack_data(buf, pos, FRSKY_ID_GPS_SEC, tm_gps->tm_sec);
+
+	buf[pos++] = 0x5E;	/* closing start/stop byte */
+
+	frame3_len = pos;
+}
+
+unsigned frsky_build_ring(uint8_t *buf, unsigned second)
+{
+	/* refresh the frame images that are due this second */
+	frsky_update_frame1();
+	frsky_update_frame2();
+
+	if (second == 0) {
+		frsky_update_frame3();
+	}
+
+	/* assemble the ring: five frame1 images pace the stream at the
+	 * traditional 200ms spacing once the UART clocks them out at 9600
+	 * baud, followed by one frame2 and - every fifth second - frame3.
+	 * The sensor hub protocol is a self-delimiting byte stream, so the
+	 * receiver parses the id/value pairs regardless of burst boundaries. */
+	unsigned pos = 0;
+
+	for (unsigned i = 0; i < 5; i++) {
+		memcpy(&buf[pos], frame1_buf, frame1_len);
+		pos += frame1_len;
+	}
+
+	memcpy(&buf[pos], frame2_buf, frame2_len);
+	pos += frame2_len;
+
+	if (second == 0) {
+		memcpy(&buf[pos], frame3_buf, frame3_len);
+		pos += frame3_len;
+	}
+
+	return pos;
 }
@@ -42,10 +42,27 @@
 #ifndef _FRSKY_DATA_H
 #define _FRSKY_DATA_H
 
+#include <stdint.h>
+
+/* worst case encoded size of one id/value pair: start byte plus fully stuffed id and payload */
+#define FRSKY_DATA_MAX		7
+
+/* worst case size of one second of telemetry: five frame1 images plus one
+ * frame2 and one frame3 image */
+#define FRSKY_RING_MAX		(5 * (8 * FRSKY_DATA_MAX + 1) + \
+				 (14 * FRSKY_DATA_MAX + 1) + \
+				 (4 * FRSKY_DATA_MAX + 1))
+
 // Public functions
 void frsky_init(void);
-void frsky_send_frame1(int uart);
-void frsky_send_frame2(int uart);
-void frsky_send_frame3(int uart);
+
+/**
+ * Assembles one second worth of telemetry frames into buf and returns the
+ * number of bytes written.  Frame images are cached and only re-encoded when
+ * their source topics have updated.
+ *
+ * @param second	Counts 0..4 to schedule the slow frames.
+ */
+unsigned frsky_build_ring(uint8_t *buf, unsigned second);
 
 #endif /* _FRSKY_TELEMETRY_H */
@@ -163,31 +163,27 @@ static int frsky_telemetry_thread_main(int argc, char *argv[])
 
 	thread_running = true;
 
-	/* Main thread loop */
-	unsigned int iteration = 0;
-	while (!thread_should_exit) {
+	/* Main thread loop: one wakeup per second. The ring holding the coming
+	 * second of telemetry is assembled up front from cached frame images and
+	 * handed to the UART in a single write; the interrupt-driven TX buffer
+	 * streams the bytes out at line rate while we sleep. */
+	static uint8_t ring[FRSKY_RING_MAX];
+	unsigned int second = 0;
 
-		/* Sleep 200 ms */
-		usleep(200000);
+	while (!thread_should_exit) {
 
-		/* Send frame 1 (every 200ms): acceleration values, altitude (vario), temperatures, current & voltages, RPM */
-		frsky_send_frame1(uart);
+		unsigned len = frsky_build_ring(ring, second);
 
-		/* Send frame 2 (every 1000ms): course, latitude, longitude, speed, altitude (GPS), fuel level */
-		if (iteration % 5 == 0)
-		{
-			frsky_send_frame2(uart);
-		}
+		write(uart, ring, len);
 
-		/* Send frame 3 (every 5000ms): date, time */
-		if (iteration % 25 == 0)
-		{
-			frsky_send_frame3(uart);
+		second++;
 
-			iteration = 0;
+		if (second == 5) {
+			second = 0;
 		}
 
-		iteration++;
+		/* Sleep until the next second of telemetry is due */
+		usleep(1000000);
 	}
 
 	/* Reset the UART flags to original state */
@@ -93,6 +93,9 @@ static const int ERROR = -1;
 
 #define GIMBAL_UPDATE_INTERVAL (5 * 1000)
 
+/* smallest output change worth republishing; 0.002 of the -1..1 range is ~0.36 deg */
+#define GIMBAL_OUTPUT_DEADBAND	0.002f
+
 #define GIMBALIOCATTCOMPENSATE		1
 
 class Gimbal : public device::CDev
@@ -136,6 +139,10 @@ private:
 
 	struct vehicle_command_s _control_cmd;
 	struct vehicle_command_s _config_cmd;
+	struct vehicle_attitude_s _att;
+
+	float				_last_control[3];
+	bool				_last_control_valid;
 
 	/**
 	* Initialise the automatic measurement state machine and start it.
@@ -183,13 +190,16 @@ Gimbal::Gimbal() :
 	_actuator_controls_2_topic(-1),
 	_sample_perf(perf_alloc(PC_ELAPSED, "gimbal_read")),
 	_comms_errors(perf_alloc(PC_COUNT, "gimbal_comms_errors")),
-	_buffer_overflows(perf_alloc(PC_COUNT, "gimbal_buffer_overflows"))
+	_buffer_overflows(perf_alloc(PC_COUNT, "gimbal_buffer_overflows")),
+	_last_control_valid(false)
 {
 	// disable debug() calls
 	_debug_enabled = false;
 
 	// work_cancel in the dtor will explode if we don't do this...
 	memset(&_work, 0, sizeof(_work));
+	memset(&_att, 0, sizeof(_att));
+	memset(&_last_control, 0, sizeof(_last_control));
 }
 
 Gimbal::~Gimbal()
@@ -275,6 +285,9 @@ Gimbal::cycle()
 		/* get a subscription handle on the vehicle command topic */
 		_vehicle_command_sub = orb_subscribe(ORB_ID(vehicle_command));
 
+		/* get a subscription handle on the attitude topic */
+		_att_sub = orb_subscribe(ORB_ID(vehicle_attitude));
+
 		/* get a publication handle on actuator output topic */
 		struct actuator_controls_s zero_report;
 		memset(&zero_report, 0, sizeof(zero_report));
@@ -288,6 +301,24 @@ Gimbal::cycle()
 		_initialized = true;
 	}
 
+	/* only run the control path when one of the inputs has actually
+	 * published; in steady state the cycle costs two orb_check calls */
+	bool att_updated;
+	bool cmd_updated;
+
+	orb_check(_att_sub, &att_updated);
+	orb_check(_vehicle_command_sub, &cmd_updated);
+
+	if (!att_updated && !cmd_updated) {
+		/* schedule a fresh cycle call to re-check */
+		work_queue(LPWORK,
+			   &_work,
+			   (worker_t)&Gimbal::cycle_trampoline,
+			   this,
+			   USEC2TICK(GIMBAL_UPDATE_INTERVAL));
+		return;
+	}
+
 	bool	updated = false;
 
 	perf_begin(_sample_perf);
@@ -296,37 +327,28 @@ Gimbal::cycle()
 	float pitch = 0.0f;
 	float yaw = 0.0f;
 
-
-	if (_att_sub < 0) {
-		_att_sub = orb_subscribe(ORB_ID(vehicle_attitude));
+	if (att_updated) {
+		orb_copy(ORB_ID(vehicle_attitude), _att_sub, &_att);
 	}
 
-	vehicle_attitude_s att;
-
-	orb_copy(ORB_ID(vehicle_attitude), _att_sub, &att);
-
 	if (_attitude_compensation_roll) {
-		roll = -att.roll;
+		roll = -_att.roll;
 		updated = true;
 	}
 
 	if (_attitude_compensation_pitch) {
-		pitch = -att.pitch;
+		pitch = -_att.pitch;
 		updated = true;
 	}
 
 	if (_attitude_compensation_yaw) {
-		yaw = att.yaw;
+		yaw = _att.yaw;
 		updated = true;
 	}
 
 
 	struct vehicle_command_s cmd;
 
-	bool cmd_updated;
-
-	orb_check(_vehicle_command_sub, &cmd_updated);
-
 	if (cmd_updated) {
 
 		orb_copy(ORB_ID(vehicle_command), _vehicle_command_sub, &cmd);
@@ -383,6 +405,15 @@ Gimbal::cycle()
 
 	}
 
+	/* suppress publications that would not move the gimbal; sensor noise
+	 * in a steady hover otherwise republishes the same output forever */
+	if (updated && _last_control_valid &&
+	    fabsf(roll - _last_control[0]) < GIMBAL_OUTPUT_DEADBAND &&
+	    fabsf(pitch - _last_control[1]) < GIMBAL_OUTPUT_DEADBAND &&
+	    fabsf(yaw - _last_control[2]) < GIMBAL_OUTPUT_DEADBAND) {
+		updated = false;
+	}
+
 	if (updated) {
 
 		struct actuator_controls_s controls;
@@ -398,10 +429,14 @@ Gimbal::cycle()
 		/* publish it */
 		orb_publish(ORB_ID(actuator_controls_2), _actuator_controls_2_topic, &controls);
 
-	}
+		_last_control[0] = roll;
+		_last_control[1] = pitch;
+		_last_control[2] = yaw;
+		_last_control_valid = true;
 
-	/* notify anyone waiting for data */
-	poll_notify(POLLIN);
+		/* notify anyone waiting for data */
+		poll_notify(POLLIN);
+	}
 
 	perf_end(_sample_perf);
 
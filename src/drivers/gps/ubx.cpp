@@ -333,8 +333,8 @@ UBX::receive(const unsigned timeout)
 				count = read(_fd, buf, sizeof(buf));
 
 				/* pass received bytes to the packet decoder */
-				for (int i = 0; i < count; i++) {
-					handled |= parse_char(buf[i]);
+				if (count > 0) {
+					handled |= parse_buf(buf, count);
 				}
 			}
 		}
@@ -346,6 +346,51 @@ UBX::receive(const unsigned timeout)
 	}
 }
 
+int	// 0 = decoding, 1 = message handled, 2 = sat info message handled
+UBX::parse_buf(const uint8_t *buf, const unsigned len)
+{
+	int ret = 0;
+	unsigned i = 0;
+
+	while (i < len) {
+		/*
+		 * Fast path for the payload body: all messages except the
+		 * variable-length specials accumulate verbatim in _buf, so the
+		 * span can be consumed in place - checksum over the span and a
+		 * single memcpy - instead of cycling the state machine per byte.
+		 * payload_rx_init() has already validated the length against
+		 * the message format, so the copy cannot overrun the buffer.
+		 */
+		if ((_decode_state == UBX_DECODE_PAYLOAD)
+		    && (_rx_msg != UBX_MSG_NAV_SVINFO)
+		    && (_rx_msg != UBX_MSG_MON_VER)) {
+
+			unsigned span = _rx_payload_length - _rx_payload_index;
+
+			if (span > len - i) {
+				span = len - i;
+			}
+
+			add_span_to_checksum(&buf[i], span);
+			memcpy(&_buf.raw[_rx_payload_index], &buf[i], span);
+			_rx_payload_index += span;
+			i += span;
+
+			if (_rx_payload_index >= _rx_payload_length) {
+				/* payload complete, expecting checksum */
+				_decode_state = UBX_DECODE_CHKSUM1;
+			}
+
+			continue;
+		}
+
+		ret |= parse_char(buf[i]);
+		i++;
+	}
+
+	return ret;
+}
+
 int	// 0 = decoding, 1 = message handled, 2 = sat info message handled
 UBX::parse_char(const uint8_t b)
 {
@@ -968,6 +1013,15 @@ UBX::add_byte_to_checksum(const uint8_t b)
 	_rx_ck_b = _rx_ck_b + _rx_ck_a;
 }
 
+void
+UBX::add_span_to_checksum(const uint8_t *buf, const unsigned len)
+{
+	for (unsigned i = 0; i < len; i++) {
+		_rx_ck_a = _rx_ck_a + buf[i];
+		_rx_ck_b = _rx_ck_b + _rx_ck_a;
+	}
+}
+
 void
 UBX::calc_checksum(const uint8_t *buffer, const uint16_t length, ubx_checksum_t *checksum)
 {
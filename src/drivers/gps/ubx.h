@@ -482,6 +482,15 @@ private:
 	 */
 	int			parse_char(const uint8_t b);
 
+	/**
+	 * Parse a span of received bytes
+	 *
+	 * Payload bodies are consumed in place (checksum over the span, one
+	 * memcpy into the rx buffer); everything else falls back to the
+	 * per-byte state machine.
+	 */
+	int			parse_buf(const uint8_t *buf, const unsigned len);
+
 	/**
 	 * Start payload rx
 	 */
@@ -509,6 +518,11 @@ private:
 	 */
 	void			add_byte_to_checksum(const uint8_t);
 
+	/**
+	 * Add a span of payload bytes to the checksum
+	 */
+	void			add_span_to_checksum(const uint8_t *buf, const unsigned len);
+
 	/**
 	 * Send a message
 	 */
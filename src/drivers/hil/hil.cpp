@@ -374,10 +374,14 @@ HIL::task_main()
 
 		/* handle update rate changes */
 		if (_current_update_rate != _update_rate) {
-			int update_rate_in_ms = int(1000 / _update_rate);
-			if (update_rate_in_ms < 2)
-				update_rate_in_ms = 2;
-			orb_set_interval(_t_actuators, update_rate_in_ms);
+			/*
+			 * There is no hardware to pace here; the subscription
+			 * interval throttles against wall-clock time, which
+			 * caps faster-than-real-time simulation at the PWM
+			 * rate.  Consume every mixer tick instead and publish
+			 * the batch in the same pass.
+			 */
+			orb_set_interval(_t_actuators, 0);
 			// up_pwm_servo_set_rate(_update_rate);
 			_current_update_rate = _update_rate;
 		}
@@ -401,20 +405,22 @@ HIL::task_main()
 			/* can we mix? */
 			if (_mixers != nullptr) {
 
-				/* do mixing */
+				/* do mixing for the full set in one pass */
 				outputs.noutputs = _mixers->mix(&outputs.output[0], num_outputs, NULL);
 				outputs.timestamp = hrt_absolute_time();
 
-				/* iterate actuators */
+				/*
+				 * Scale the whole batch; the common case (finite,
+				 * in-band) reduces to one multiply-add per channel.
+				 */
 				for (unsigned i = 0; i < num_outputs; i++) {
 
+					float v = (i < outputs.noutputs) ? outputs.output[i] : -1.0f;
+
 					/* last resort: catch NaN, INF and out-of-band errors */
-					if (i < outputs.noutputs &&
-						isfinite(outputs.output[i]) &&
-						outputs.output[i] >= -1.0f &&
-						outputs.output[i] <= 1.0f) {
+					if (isfinite(v) && v >= -1.0f && v <= 1.0f) {
 						/* scale for PWM output 900 - 2100us */
-						outputs.output[i] = 1500 + (600 * outputs.output[i]);
+						outputs.output[i] = 1500 + (600 * v);
 					} else {
 						/*
 						 * Value is NaN, INF or out of band - set to the minimum value.
@@ -425,7 +431,7 @@ HIL::task_main()
 					}
 				}
 
-				/* and publish for anyone that cares to see */
+				/* publish the batch in the same pass as the mixer tick */
 				orb_publish(ORB_ID(actuator_outputs), _t_outputs, &outputs);
 			}
 		}
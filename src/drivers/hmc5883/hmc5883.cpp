@@ -62,6 +62,7 @@
 
 #include <systemlib/perf_counter.h>
 #include <systemlib/err.h>
+#include <systemlib/px4_work.h>
 
 #include <drivers/drv_mag.h>
 #include <drivers/drv_hrt.h>
@@ -154,6 +155,7 @@ protected:
 
 private:
 	work_s			_work;
+	work_s			_check_work;
 	unsigned		_measure_ticks;
 
 	RingBuffer		*_reports;
@@ -255,6 +257,21 @@ private:
 	 */
 	void 			check_conf(void);
 
+	/**
+	 * Verify the range and configuration registers.
+	 *
+	 * Runs from the housekeeping work queue so that the verification
+	 * transfers do not add bus time to the high-rate measurement cycle.
+	 */
+	void			check_registers(void);
+
+	/**
+	 * Static trampoline for the register verification work item.
+	 *
+	 * @param arg		Instance pointer for the driver.
+	 */
+	static void		check_trampoline(void *arg);
+
 	/**
 	 * Perform a poll cycle; collect from the previous measurement
 	 * and start a new one.
@@ -352,6 +369,7 @@ HMC5883::HMC5883(device::Device *interface, const char *path, enum Rotation rota
 	CDev("HMC5883", path),
 	_interface(interface),
 	_work{},
+	_check_work{},
 	_measure_ticks(0),
 	_reports(nullptr),
 	_scale{},
@@ -390,6 +408,7 @@ HMC5883::HMC5883(device::Device *interface, const char *path, enum Rotation rota
 
 	// work_cancel in the dtor will explode if we don't do this...
 	memset(&_work, 0, sizeof(_work));
+	memset(&_check_work, 0, sizeof(_check_work));
 }
 
 HMC5883::~HMC5883()
@@ -547,6 +566,21 @@ void HMC5883::check_conf(void)
 	}
 }
 
+void
+HMC5883::check_registers(void)
+{
+	check_range();
+	check_conf();
+}
+
+void
+HMC5883::check_trampoline(void *arg)
+{
+	HMC5883 *dev = (HMC5883 *)arg;
+
+	dev->check_registers();
+}
+
 ssize_t
 HMC5883::read(struct file *filp, char *buffer, size_t buflen)
 {
@@ -757,13 +791,14 @@ HMC5883::start()
 	_reports->flush();
 
 	/* schedule a cycle to start things */
-	work_queue(HPWORK, &_work, (worker_t)&HMC5883::cycle_trampoline, this, 1);
+	px4_work_queue(PX4_WORK_SENSOR, &_work, (worker_t)&HMC5883::cycle_trampoline, this, 1);
 }
 
 void
 HMC5883::stop()
 {
-	work_cancel(HPWORK, &_work);
+	px4_work_cancel(PX4_WORK_SENSOR, &_work);
+	px4_work_cancel(PX4_WORK_HOUSEKEEPING, &_check_work);
 }
 
 int
@@ -804,7 +839,7 @@ HMC5883::cycle()
 		if (_measure_ticks > USEC2TICK(HMC5883_CONVERSION_INTERVAL)) {
 
 			/* schedule a fresh cycle call when we are ready to measure again */
-			work_queue(HPWORK,
+			px4_work_queue(PX4_WORK_SENSOR,
 				   &_work,
 				   (worker_t)&HMC5883::cycle_trampoline,
 				   this,
@@ -822,7 +857,7 @@ HMC5883::cycle()
 	_collect_phase = true;
 
 	/* schedule a fresh cycle call when the measurement is done */
-	work_queue(HPWORK,
+	px4_work_queue(PX4_WORK_SENSOR,
 		   &_work,
 		   (worker_t)&HMC5883::cycle_trampoline,
 		   this,
@@ -1013,14 +1048,17 @@ HMC5883::collect()
 	  registers. With a bad I2C cable it is possible for the
 	  registers to become corrupt, leading to bad readings. It
 	  doesn't happen often, but given the poor cables some
-	  vehicles have it is worth checking for.
+	  vehicles have it is worth checking for. The verification
+	  transfers run from the housekeeping work queue so they do
+	  not add bus time to the measurement cycle.
 	 */
 	check_counter = perf_event_count(_sample_perf) % 256;
 	if (check_counter == 0) {
-		check_range();
-	}
-	if (check_counter == 128) {
-		check_conf();
+		px4_work_queue(PX4_WORK_HOUSEKEEPING,
+			   &_check_work,
+			   (worker_t)&HMC5883::check_trampoline,
+			   this,
+			   0);
 	}
 
 	ret = OK;
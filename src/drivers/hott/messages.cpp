@@ -69,7 +69,29 @@ static bool _home_position_set = false;
 static double _home_lat = 0.0d;
 static double _home_lon = 0.0d;
 
-void 
+/* Cached topic data, refreshed only when the topics report an update. */
+static struct sensor_combined_s _sensor_data;
+static struct battery_status_s _battery_data;
+static struct airspeed_s _airspeed_data;
+static struct esc_status_s _esc_data;
+static struct vehicle_gps_position_s _gps_data;
+
+/* Shadow images of the telemetry messages. A message is rebuilt from the
+ * cached topic data only when one of its source topics has changed; the
+ * receiver's poll is then served straight from the prebuilt image, which
+ * keeps the response well inside the protocol's timing margin.
+ */
+static struct eam_module_msg _eam_msg;
+static struct gam_module_msg _gam_msg;
+static struct gps_module_msg _gps_msg;
+
+static bool _eam_dirty = true;
+static bool _gam_dirty = true;
+static bool _gps_dirty = true;
+
+static void update_topics(void);
+
+void
 init_sub_messages(void)
 {
 	_battery_sub = orb_subscribe(ORB_ID(battery_status));
@@ -127,128 +149,178 @@ publish_gam_message(const uint8_t *buffer)
 	}
 }
 
-void 
+/**
+ * Refresh the cached topic data and mark the messages built from any
+ * changed topic for a rebuild. All builders go through this one helper so
+ * that topics feeding several messages are only consumed once per poll.
+ */
+static void
+update_topics(void)
+{
+	bool updated;
+
+	orb_check(_sensor_sub, &updated);
+	if (updated) {
+		orb_copy(ORB_ID(sensor_combined), _sensor_sub, &_sensor_data);
+		_eam_dirty = true;
+	}
+
+	orb_check(_battery_sub, &updated);
+	if (updated) {
+		orb_copy(ORB_ID(battery_status), _battery_sub, &_battery_data);
+		_eam_dirty = true;
+	}
+
+	orb_check(_airspeed_sub, &updated);
+	if (updated) {
+		orb_copy(ORB_ID(airspeed), _airspeed_sub, &_airspeed_data);
+		_eam_dirty = true;
+	}
+
+	orb_check(_esc_sub, &updated);
+	if (updated) {
+		orb_copy(ORB_ID(esc_status), _esc_sub, &_esc_data);
+		_gam_dirty = true;
+	}
+
+	orb_check(_gps_sub, &updated);
+	if (updated) {
+		orb_copy(ORB_ID(vehicle_gps_position), _gps_sub, &_gps_data);
+		_gps_dirty = true;
+	}
+
+	orb_check(_home_sub, &updated);
+	if (updated) {
+		/* get a local copy of the home position data */
+		struct home_position_s home;
+		memset(&home, 0, sizeof(home));
+		orb_copy(ORB_ID(home_position), _home_sub, &home);
+
+		_home_lat = home.lat;
+		_home_lon = home.lon;
+		_home_position_set = true;
+		_gps_dirty = true;
+	}
+}
+
+void
 build_eam_response(uint8_t *buffer, size_t *size)
 {
-	/* get a local copy of the current sensor values */
-	struct sensor_combined_s raw;
-	memset(&raw, 0, sizeof(raw));
-	orb_copy(ORB_ID(sensor_combined), _sensor_sub, &raw);
+	update_topics();
 
-	/* get a local copy of the battery data */
-	struct battery_status_s battery;
-	memset(&battery, 0, sizeof(battery));
-	orb_copy(ORB_ID(battery_status), _battery_sub, &battery);
+	*size = sizeof(_eam_msg);
 
-	struct eam_module_msg msg;
-	*size = sizeof(msg);
-	memset(&msg, 0, *size);
+	if (!_eam_dirty) {
+		/* serve the poll from the prebuilt image */
+		memcpy(buffer, &_eam_msg, *size);
+		return;
+	}
 
-	msg.start = START_BYTE;
-	msg.eam_sensor_id = EAM_SENSOR_ID;
-	msg.sensor_text_id = EAM_SENSOR_TEXT_ID;
-	
-	msg.temperature1 = (uint8_t)(raw.baro_temp_celcius + 20);
-	msg.temperature2 = msg.temperature1 - BOARD_TEMP_OFFSET_DEG;
+	memset(&_eam_msg, 0, *size);
 
-	msg.main_voltage_L = (uint8_t)(battery.voltage_v * 10);
+	_eam_msg.start = START_BYTE;
+	_eam_msg.eam_sensor_id = EAM_SENSOR_ID;
+	_eam_msg.sensor_text_id = EAM_SENSOR_TEXT_ID;
 
-	uint16_t alt = (uint16_t)(raw.baro_alt_meter + 500);
-	msg.altitude_L = (uint8_t)alt & 0xff;
-	msg.altitude_H = (uint8_t)(alt >> 8) & 0xff;
+	_eam_msg.temperature1 = (uint8_t)(_sensor_data.baro_temp_celcius + 20);
+	_eam_msg.temperature2 = _eam_msg.temperature1 - BOARD_TEMP_OFFSET_DEG;
 
-	/* get a local copy of the airspeed data */
-	struct airspeed_s airspeed;
-	memset(&airspeed, 0, sizeof(airspeed));
-	orb_copy(ORB_ID(airspeed), _airspeed_sub, &airspeed);
+	_eam_msg.main_voltage_L = (uint8_t)(_battery_data.voltage_v * 10);
 
-	uint16_t speed = (uint16_t)(airspeed.indicated_airspeed_m_s * 3.6f);
-	msg.speed_L = (uint8_t)speed & 0xff;
-	msg.speed_H = (uint8_t)(speed >> 8) & 0xff;
+	uint16_t alt = (uint16_t)(_sensor_data.baro_alt_meter + 500);
+	_eam_msg.altitude_L = (uint8_t)alt & 0xff;
+	_eam_msg.altitude_H = (uint8_t)(alt >> 8) & 0xff;
 
-	msg.stop = STOP_BYTE;
-	memcpy(buffer, &msg, *size);
+	uint16_t speed = (uint16_t)(_airspeed_data.indicated_airspeed_m_s * 3.6f);
+	_eam_msg.speed_L = (uint8_t)speed & 0xff;
+	_eam_msg.speed_H = (uint8_t)(speed >> 8) & 0xff;
+
+	_eam_msg.stop = STOP_BYTE;
+	_eam_dirty = false;
+
+	memcpy(buffer, &_eam_msg, *size);
 }
 
-void 
+void
 build_gam_response(uint8_t *buffer, size_t *size)
 {
-	/* get a local copy of the ESC Status values */
-	struct esc_status_s esc;
-	memset(&esc, 0, sizeof(esc));
-	orb_copy(ORB_ID(esc_status), _esc_sub, &esc);
+	update_topics();
 
-	struct gam_module_msg msg;
-	*size = sizeof(msg);
-	memset(&msg, 0, *size);
+	*size = sizeof(_gam_msg);
 
-	msg.start = START_BYTE;
-	msg.gam_sensor_id = GAM_SENSOR_ID;
-	msg.sensor_text_id = GAM_SENSOR_TEXT_ID;
-	
-	msg.temperature1 = (uint8_t)(esc.esc[0].esc_temperature + 20.0F);
-	msg.temperature2 = 20;  // 0 deg. C.
+	if (!_gam_dirty) {
+		memcpy(buffer, &_gam_msg, *size);
+		return;
+	}
 
-	const uint16_t voltage = (uint16_t)(esc.esc[0].esc_voltage * 10.0F);
-	msg.main_voltage_L = (uint8_t)voltage & 0xff;
-	msg.main_voltage_H = (uint8_t)(voltage >> 8) & 0xff;
+	memset(&_gam_msg, 0, *size);
 
-	const uint16_t current = (uint16_t)(esc.esc[0].esc_current * 10.0F);
-	msg.current_L = (uint8_t)current & 0xff;
-	msg.current_H = (uint8_t)(current >> 8) & 0xff;
+	_gam_msg.start = START_BYTE;
+	_gam_msg.gam_sensor_id = GAM_SENSOR_ID;
+	_gam_msg.sensor_text_id = GAM_SENSOR_TEXT_ID;
 
-	const uint16_t rpm = (uint16_t)(esc.esc[0].esc_rpm * 0.1f);
-	msg.rpm_L = (uint8_t)rpm & 0xff;
-	msg.rpm_H = (uint8_t)(rpm >> 8) & 0xff;
+	_gam_msg.temperature1 = (uint8_t)(_esc_data.esc[0].esc_temperature + 20.0F);
+	_gam_msg.temperature2 = 20;  // 0 deg. C.
 
-	msg.stop = STOP_BYTE;
-	memcpy(buffer, &msg, *size);
+	const uint16_t voltage = (uint16_t)(_esc_data.esc[0].esc_voltage * 10.0F);
+	_gam_msg.main_voltage_L = (uint8_t)voltage & 0xff;
+	_gam_msg.main_voltage_H = (uint8_t)(voltage >> 8) & 0xff;
+
+	const uint16_t current = (uint16_t)(_esc_data.esc[0].esc_current * 10.0F);
+	_gam_msg.current_L = (uint8_t)current & 0xff;
+	_gam_msg.current_H = (uint8_t)(current >> 8) & 0xff;
+
+	const uint16_t rpm = (uint16_t)(_esc_data.esc[0].esc_rpm * 0.1f);
+	_gam_msg.rpm_L = (uint8_t)rpm & 0xff;
+	_gam_msg.rpm_H = (uint8_t)(rpm >> 8) & 0xff;
+
+	_gam_msg.stop = STOP_BYTE;
+	_gam_dirty = false;
+
+	memcpy(buffer, &_gam_msg, *size);
 }
 
-void 
+void
 build_gps_response(uint8_t *buffer, size_t *size)
 {
-	/* get a local copy of the current sensor values */
-	struct sensor_combined_s raw;
-	memset(&raw, 0, sizeof(raw));
-	orb_copy(ORB_ID(sensor_combined), _sensor_sub, &raw);
+	update_topics();
 
- 	/* get a local copy of the battery data */
-	struct vehicle_gps_position_s gps;
-	memset(&gps, 0, sizeof(gps));
-	orb_copy(ORB_ID(vehicle_gps_position), _gps_sub, &gps);
+	*size = sizeof(_gps_msg);
 
-	struct gps_module_msg msg;
-	*size = sizeof(msg);
-	memset(&msg, 0, *size);
+	if (!_gps_dirty) {
+		memcpy(buffer, &_gps_msg, *size);
+		return;
+	}
 
-	msg.start = START_BYTE;
-	msg.sensor_id = GPS_SENSOR_ID;
-	msg.sensor_text_id = GPS_SENSOR_TEXT_ID;
+	memset(&_gps_msg, 0, *size);
 
-	msg.gps_num_sat = gps.satellites_used;
+	_gps_msg.start = START_BYTE;
+	_gps_msg.sensor_id = GPS_SENSOR_ID;
+	_gps_msg.sensor_text_id = GPS_SENSOR_TEXT_ID;
+
+	_gps_msg.gps_num_sat = _gps_data.satellites_used;
 
 	/* The GPS fix type: 0 = none, 2 = 2D, 3 = 3D */
-	msg.gps_fix_char = (uint8_t)(gps.fix_type + 48);
-	msg.gps_fix = (uint8_t)(gps.fix_type + 48);
+	_gps_msg.gps_fix_char = (uint8_t)(_gps_data.fix_type + 48);
+	_gps_msg.gps_fix = (uint8_t)(_gps_data.fix_type + 48);
 
 	/* No point collecting more data if we don't have a 3D fix yet */
-	if (gps.fix_type > 2) {
+	if (_gps_data.fix_type > 2) {
 		/* Current flight direction */
-		msg.flight_direction = (uint8_t)(gps.cog_rad * M_RAD_TO_DEG_F);
+		_gps_msg.flight_direction = (uint8_t)(_gps_data.cog_rad * M_RAD_TO_DEG_F);
 
 		/* GPS speed */
-		uint16_t speed = (uint16_t)(gps.vel_m_s * 3.6f);
-		msg.gps_speed_L = (uint8_t)speed & 0xff;
-		msg.gps_speed_H = (uint8_t)(speed >> 8) & 0xff;
-		
+		uint16_t speed = (uint16_t)(_gps_data.vel_m_s * 3.6f);
+		_gps_msg.gps_speed_L = (uint8_t)speed & 0xff;
+		_gps_msg.gps_speed_H = (uint8_t)(speed >> 8) & 0xff;
+
 		/* Get latitude in degrees, minutes and seconds */
-		double lat = ((double)(gps.lat))*1e-7d;
+		double lat = ((double)(_gps_data.lat))*1e-7d;
 
-		/* Set the N or S specifier */		
-		msg.latitude_ns = 0;
+		/* Set the N or S specifier */
+		_gps_msg.latitude_ns = 0;
 		if (lat < 0) {
-			msg.latitude_ns = 1;
+			_gps_msg.latitude_ns = 1;
 			lat = abs(lat);
 		}
 
@@ -258,65 +330,53 @@ build_gps_response(uint8_t *buffer, size_t *size)
 		convert_to_degrees_minutes_seconds(lat, &deg, &min, &sec);
 
 		uint16_t lat_min = (uint16_t)(deg * 100 + min);
-		msg.latitude_min_L = (uint8_t)lat_min & 0xff;
-		msg.latitude_min_H = (uint8_t)(lat_min >> 8) & 0xff;
+		_gps_msg.latitude_min_L = (uint8_t)lat_min & 0xff;
+		_gps_msg.latitude_min_H = (uint8_t)(lat_min >> 8) & 0xff;
 		uint16_t lat_sec = (uint16_t)(sec);
-		msg.latitude_sec_L = (uint8_t)lat_sec & 0xff;
-		msg.latitude_sec_H = (uint8_t)(lat_sec >> 8) & 0xff;
+		_gps_msg.latitude_sec_L = (uint8_t)lat_sec & 0xff;
+		_gps_msg.latitude_sec_H = (uint8_t)(lat_sec >> 8) & 0xff;
 
 		/* Get longitude in degrees, minutes and seconds */
-		double lon = ((double)(gps.lon))*1e-7d;
+		double lon = ((double)(_gps_data.lon))*1e-7d;
 
 		/* Set the E or W specifier */
-		msg.longitude_ew = 0;
+		_gps_msg.longitude_ew = 0;
 		if (lon < 0) {
-			msg.longitude_ew = 1;
+			_gps_msg.longitude_ew = 1;
 			lon = abs(lon);
 		}
 
 		convert_to_degrees_minutes_seconds(lon, &deg, &min, &sec);
-		
+
 		uint16_t lon_min = (uint16_t)(deg * 100 + min);
-		msg.longitude_min_L = (uint8_t)lon_min & 0xff;
-		msg.longitude_min_H = (uint8_t)(lon_min >> 8) & 0xff;
+		_gps_msg.longitude_min_L = (uint8_t)lon_min & 0xff;
+		_gps_msg.longitude_min_H = (uint8_t)(lon_min >> 8) & 0xff;
 		uint16_t lon_sec = (uint16_t)(sec);
-		msg.longitude_sec_L = (uint8_t)lon_sec & 0xff;
-		msg.longitude_sec_H = (uint8_t)(lon_sec >> 8) & 0xff;
-		
+		_gps_msg.longitude_sec_L = (uint8_t)lon_sec & 0xff;
+		_gps_msg.longitude_sec_H = (uint8_t)(lon_sec >> 8) & 0xff;
+
 		/* Altitude */
-		uint16_t alt = (uint16_t)(gps.alt*1e-3f + 500.0f);
-		msg.altitude_L = (uint8_t)alt & 0xff;
-		msg.altitude_H = (uint8_t)(alt >> 8) & 0xff;
-
-		/* Get any (and probably only ever one) _home_sub postion report */
-		bool updated;
-		orb_check(_home_sub, &updated);
-		if (updated) {
-			/* get a local copy of the home position data */
-			struct home_position_s home;
-			memset(&home, 0, sizeof(home));
-			orb_copy(ORB_ID(home_position), _home_sub, &home);
-
-			_home_lat = home.lat;
-			_home_lon = home.lon;
-			_home_position_set = true;
-		}
+		uint16_t alt = (uint16_t)(_gps_data.alt*1e-3f + 500.0f);
+		_gps_msg.altitude_L = (uint8_t)alt & 0xff;
+		_gps_msg.altitude_H = (uint8_t)(alt >> 8) & 0xff;
 
 		/* Distance from home */
 		if (_home_position_set) {
 			uint16_t dist = (uint16_t)get_distance_to_next_waypoint(_home_lat, _home_lon, lat, lon);
 
-			msg.distance_L = (uint8_t)dist & 0xff;
-			msg.distance_H = (uint8_t)(dist >> 8) & 0xff;
+			_gps_msg.distance_L = (uint8_t)dist & 0xff;
+			_gps_msg.distance_H = (uint8_t)(dist >> 8) & 0xff;
 
 			/* Direction back to home */
 			uint16_t bearing = (uint16_t)(get_bearing_to_next_waypoint(_home_lat, _home_lon, lat, lon) * M_RAD_TO_DEG_F);
-			msg.home_direction = (uint8_t)bearing >> 1;
+			_gps_msg.home_direction = (uint8_t)bearing >> 1;
 		}
 	}
 
-	msg.stop = STOP_BYTE;
-	memcpy(buffer, &msg, *size);
+	_gps_msg.stop = STOP_BYTE;
+	_gps_dirty = false;
+
+	memcpy(buffer, &_gps_msg, *size);
 }
 
 void
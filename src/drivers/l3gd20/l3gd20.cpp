@@ -173,8 +173,22 @@ static const int ERROR = -1;
 #define FIFO_CTRL_STREAM_TO_FIFO_MODE		(3<<5)
 #define FIFO_CTRL_BYPASS_TO_STREAM_MODE		(1<<7)
 
+#define FIFO_SRC_WTM				(1<<7)
+#define FIFO_SRC_OVRN				(1<<6)
+#define FIFO_SRC_EMPTY				(1<<5)
+#define FIFO_SRC_FSS_MASK			0x1F
+
 #define L3GD20_DEFAULT_RATE			760
 #define L3G4200D_DEFAULT_RATE			800
+
+/*
+  the gyro queues samples in its 32-slot FIFO; the hrt callback visits
+  at the sample rate divided by the batch size and drains whatever has
+  queued, so the anti-aliasing filter still sees every sample while the
+  interrupt and bus-transaction cost drops by the batch factor
+ */
+#define L3GD20_FIFO_SLOTS			32
+#define L3GD20_FIFO_BATCH			8
 #define L3GD20_DEFAULT_RANGE_DPS		2000
 #define L3GD20_DEFAULT_FILTER_FREQ		30
 #define L3GD20_TEMP_OFFSET_CELSIUS		40
@@ -242,9 +256,7 @@ private:
 
 	uint8_t			_register_wait;
 
-	math::LowPassFilter2p	_gyro_filter_x;
-	math::LowPassFilter2p	_gyro_filter_y;
-	math::LowPassFilter2p	_gyro_filter_z;
+	math::LowPassFilter2pVector3f	_gyro_filter;
 
 	/* true if an L3G4200D is detected */
 	bool	_is_l3g4200d;
@@ -414,9 +426,7 @@ L3GD20::L3GD20(int bus, const char* path, spi_dev_e device, enum Rotation rotati
 	_errors(perf_alloc(PC_COUNT, "l3gd20_errors")),
 	_bad_registers(perf_alloc(PC_COUNT, "l3gd20_bad_registers")),
 	_register_wait(0),
-	_gyro_filter_x(L3GD20_DEFAULT_RATE, L3GD20_DEFAULT_FILTER_FREQ),
-	_gyro_filter_y(L3GD20_DEFAULT_RATE, L3GD20_DEFAULT_FILTER_FREQ),
-	_gyro_filter_z(L3GD20_DEFAULT_RATE, L3GD20_DEFAULT_FILTER_FREQ),
+	_gyro_filter(L3GD20_DEFAULT_RATE, L3GD20_DEFAULT_FILTER_FREQ),
 	_is_l3g4200d(false),
 	_rotation(rotation),
 	_checked_next(0)
@@ -424,6 +434,9 @@ L3GD20::L3GD20(int bus, const char* path, spi_dev_e device, enum Rotation rotati
 	// enable debug() calls
 	_debug_enabled = true;
 
+	// sample timing runs at full rate in interrupt context, use the cheap time source
+	perf_use_cycle_counter(_sample_perf);
+
 	_device_id.devid_s.devtype = DRV_GYR_DEVTYPE_L3GD20;
 
 	// default scale factors
@@ -473,6 +486,9 @@ L3GD20::init()
 
 	reset();
 
+	/* give the chip time to queue a first sample into the FIFO */
+	usleep(1000000 / _current_rate + 1000);
+
 	measure();
 
 	/* advertise sensor topic, measure manually to initialize valid report */
@@ -608,10 +624,13 @@ L3GD20::ioctl(struct file *filp, int cmd, unsigned long arg)
 
 					/* update interval for next measurement */
 					/* XXX this is a bit shady, but no other way to adjust... */
-					_call.period = _call_interval = ticks;
+					_call_interval = ticks;
+
+					/* the FIFO accumulates a batch of samples between visits */
+					_call.period = _call_interval * L3GD20_FIFO_BATCH;
 
 					/* adjust filters */
-					float cutoff_freq_hz = _gyro_filter_x.get_cutoff_freq();
+					float cutoff_freq_hz = _gyro_filter.get_cutoff_freq();
 					float sample_rate = 1.0e6f/ticks;
 					set_driver_lowpass_filter(sample_rate, cutoff_freq_hz);
 
@@ -667,7 +686,7 @@ L3GD20::ioctl(struct file *filp, int cmd, unsigned long arg)
 	}
 
 	case GYROIOCGLOWPASS:
-		return static_cast<int>(_gyro_filter_x.get_cutoff_freq());
+		return static_cast<int>(_gyro_filter.get_cutoff_freq());
 
 	case GYROIOCSSCALE:
 		/* copy scale in */
@@ -819,9 +838,7 @@ L3GD20::set_samplerate(unsigned frequency)
 void
 L3GD20::set_driver_lowpass_filter(float samplerate, float bandwidth)
 {
-	_gyro_filter_x.set_cutoff_frequency(samplerate, bandwidth);
-	_gyro_filter_y.set_cutoff_frequency(samplerate, bandwidth);
-	_gyro_filter_z.set_cutoff_frequency(samplerate, bandwidth);
+	_gyro_filter.set_cutoff_frequency(samplerate, bandwidth);
 }
 
 void
@@ -833,8 +850,8 @@ L3GD20::start()
 	/* reset the report ring */
 	_reports->flush();
 
-	/* start polling at the specified rate */
-	hrt_call_every(&_call, 1000, _call_interval, (hrt_callout)&L3GD20::measure_trampoline, this);
+	/* start polling; the FIFO accumulates a batch of samples between visits */
+	hrt_call_every(&_call, 1000, _call_interval * L3GD20_FIFO_BATCH, (hrt_callout)&L3GD20::measure_trampoline, this);
 }
 
 void
@@ -878,10 +895,10 @@ L3GD20::reset()
 	write_checked_reg(ADDR_CTRL_REG5, 0);
 	write_checked_reg(ADDR_CTRL_REG5, REG5_FIFO_ENABLE);		/* disable wake-on-interrupt */
 
-	/* disable FIFO. This makes things simpler and ensures we
-	 * aren't getting stale data. It means we must run the hrt
-	 * callback fast enough to not miss data. */
-	write_checked_reg(ADDR_FIFO_CTRL_REG, FIFO_CTRL_BYPASS_MODE);
+	/* run the FIFO in stream mode. The oldest sample is dropped on
+	 * overrun, and the hrt callback drains every sample that has
+	 * queued since its last visit. */
+	write_checked_reg(ADDR_FIFO_CTRL_REG, FIFO_CTRL_STREAM_MODE);
 
 	set_samplerate(0); // 760Hz or 800Hz
 	set_range(L3GD20_DEFAULT_RANGE_DPS);
@@ -899,12 +916,6 @@ L3GD20::measure_trampoline(void *arg)
 	dev->measure();
 }
 
-#ifdef GPIO_EXTI_GYRO_DRDY
-# define L3GD20_USE_DRDY 1
-#else
-# define L3GD20_USE_DRDY 0
-#endif
-
 void
 L3GD20::check_registers(void)
 {
@@ -935,16 +946,24 @@ L3GD20::check_registers(void)
 void
 L3GD20::measure()
 {
-	/* status register and data as read back from the device */
+	/* temperature and status as read back from the device */
 #pragma pack(push, 1)
 	struct {
 		uint8_t		cmd;
 		int8_t		temp;
 		uint8_t		status;
+	} raw_status;
+
+	struct sample_s {
 		int16_t		x;
 		int16_t		y;
 		int16_t		z;
-	} raw_report;
+	};
+
+	struct {
+		uint8_t		cmd;
+		struct sample_s	samples[L3GD20_FIFO_SLOTS];
+	} raw_fifo;
 #pragma pack(pop)
 
 	gyro_report report;
@@ -954,33 +973,38 @@ L3GD20::measure()
 
         check_registers();
 
-#if L3GD20_USE_DRDY
-	// if the gyro doesn't have any data ready then re-schedule
-	// for 100 microseconds later. This ensures we don't double
-	// read a value and then miss the next value
-	if (_bus == PX4_SPI_BUS_SENSORS && stm32_gpioread(GPIO_EXTI_GYRO_DRDY) == 0) {
+	/* see how many samples have queued since the last drain */
+	uint8_t fifo_src = read_reg(ADDR_FIFO_SRC_REG);
+	unsigned count = fifo_src & FIFO_SRC_FSS_MASK;
+
+	if (fifo_src & FIFO_SRC_OVRN) {
+		/* stream mode dropped the oldest slots; all are valid */
+		perf_count(_errors);
+		count = L3GD20_FIFO_SLOTS;
+	}
+
+	if ((fifo_src & FIFO_SRC_EMPTY) || (count == 0)) {
+		// no sample has queued yet - look again in 100
+		// microseconds rather than waiting out a whole batch
 		perf_count(_reschedules);
 		hrt_call_delay(&_call, 100);
-                perf_end(_sample_perf);
+		perf_end(_sample_perf);
 		return;
 	}
-#endif
 
-	/* fetch data from the sensor */
-	memset(&raw_report, 0, sizeof(raw_report));
-	raw_report.cmd = ADDR_OUT_TEMP | DIR_READ | ADDR_INCREMENT;
-	transfer((uint8_t *)&raw_report, (uint8_t *)&raw_report, sizeof(raw_report));
-
-#if L3GD20_USE_DRDY
-        if (_bus == PX4_SPI_BUS_SENSORS && (raw_report.status & 0xF) != 0xF) {
-            /*
-              we waited for DRDY, but did not see DRDY on all axes
-              when we captured. That means a transfer error of some sort
-             */
-            perf_count(_errors);
-            return;
-        }
-#endif
+	if (count > L3GD20_FIFO_SLOTS)
+		count = L3GD20_FIFO_SLOTS;
+
+	/* fetch the temperature and status; these are not part of the FIFO stream */
+	memset(&raw_status, 0, sizeof(raw_status));
+	raw_status.cmd = ADDR_OUT_TEMP | DIR_READ | ADDR_INCREMENT;
+	transfer((uint8_t *)&raw_status, (uint8_t *)&raw_status, sizeof(raw_status));
+
+	/* drain all queued samples in one burst; with the FIFO enabled the
+	 * register address rolls back to OUT_X_L after each sample */
+	raw_fifo.cmd = ADDR_OUT_X_L | DIR_READ | ADDR_INCREMENT;
+	transfer((uint8_t *)&raw_fifo, (uint8_t *)&raw_fifo, 1 + count * sizeof(struct sample_s));
+
 	/*
 	 * 1) Scale raw value to SI units using scaling from datasheet.
 	 * 2) Subtract static offset (in SI units)
@@ -995,72 +1019,78 @@ L3GD20::measure()
 	 *	 	  the offset is 74 from the origin and subtracting
 	 *		  74 from all measurements centers them around zero.
 	 */
-	report.timestamp = hrt_absolute_time();
-        report.error_count = perf_event_count(_bad_registers);
-
-	switch (_orientation) {
-
-		case SENSOR_BOARD_ROTATION_000_DEG:
-			/* keep axes in place */
-			report.x_raw = raw_report.x;
-			report.y_raw = raw_report.y;
-			break;
-
-		case SENSOR_BOARD_ROTATION_090_DEG:
-			/* swap x and y */
-			report.x_raw = raw_report.y;
-			report.y_raw = raw_report.x;
-			break;
-
-		case SENSOR_BOARD_ROTATION_180_DEG:
-			/* swap x and y and negate both */
-			report.x_raw = ((raw_report.x == -32768) ? 32767 : -raw_report.x);
-			report.y_raw = ((raw_report.y == -32768) ? 32767 : -raw_report.y);
-			break;
-
-		case SENSOR_BOARD_ROTATION_270_DEG:
-			/* swap x and y and negate y */
-			report.x_raw = raw_report.y;
-			report.y_raw = ((raw_report.x == -32768) ? 32767 : -raw_report.x);
-			break;
-	}
+	for (unsigned i = 0; i < count; i++) {
+		const struct sample_s &sample = raw_fifo.samples[i];
+
+		/* back-date samples that waited in the FIFO by the sample interval */
+		report.timestamp = hrt_absolute_time() - ((count - 1 - i) * (1000000 / _current_rate));
+	        report.error_count = perf_event_count(_bad_registers);
+
+		switch (_orientation) {
+
+			case SENSOR_BOARD_ROTATION_000_DEG:
+				/* keep axes in place */
+				report.x_raw = sample.x;
+				report.y_raw = sample.y;
+				break;
+
+			case SENSOR_BOARD_ROTATION_090_DEG:
+				/* swap x and y */
+				report.x_raw = sample.y;
+				report.y_raw = sample.x;
+				break;
+
+			case SENSOR_BOARD_ROTATION_180_DEG:
+				/* swap x and y and negate both */
+				report.x_raw = ((sample.x == -32768) ? 32767 : -sample.x);
+				report.y_raw = ((sample.y == -32768) ? 32767 : -sample.y);
+				break;
+
+			case SENSOR_BOARD_ROTATION_270_DEG:
+				/* swap x and y and negate y */
+				report.x_raw = sample.y;
+				report.y_raw = ((sample.x == -32768) ? 32767 : -sample.x);
+				break;
+		}
 
-	report.z_raw = raw_report.z;
+		report.z_raw = sample.z;
 
-	report.temperature_raw = raw_report.temp;
+		report.temperature_raw = raw_status.temp;
 
-	float xraw_f = report.x_raw;
-	float yraw_f = report.y_raw;
-	float zraw_f = report.z_raw;
+		float xraw_f = report.x_raw;
+		float yraw_f = report.y_raw;
+		float zraw_f = report.z_raw;
 
-	// apply user specified rotation
-	rotate_3f(_rotation, xraw_f, yraw_f, zraw_f);
+		// apply user specified rotation
+		rotate_3f(_rotation, xraw_f, yraw_f, zraw_f);
 
-	report.x = ((xraw_f * _gyro_range_scale) - _gyro_scale.x_offset) * _gyro_scale.x_scale;
-	report.y = ((yraw_f * _gyro_range_scale) - _gyro_scale.y_offset) * _gyro_scale.y_scale;
-	report.z = ((zraw_f * _gyro_range_scale) - _gyro_scale.z_offset) * _gyro_scale.z_scale;
+		report.x = ((xraw_f * _gyro_range_scale) - _gyro_scale.x_offset) * _gyro_scale.x_scale;
+		report.y = ((yraw_f * _gyro_range_scale) - _gyro_scale.y_offset) * _gyro_scale.y_scale;
+		report.z = ((zraw_f * _gyro_range_scale) - _gyro_scale.z_offset) * _gyro_scale.z_scale;
 
-	report.x = _gyro_filter_x.apply(report.x);
-	report.y = _gyro_filter_y.apply(report.y);
-	report.z = _gyro_filter_z.apply(report.z);
+		math::Vector<3> gval_filt = _gyro_filter.apply(math::Vector<3>(report.x, report.y, report.z));
+		report.x = gval_filt(0);
+		report.y = gval_filt(1);
+		report.z = gval_filt(2);
 
-	report.temperature = L3GD20_TEMP_OFFSET_CELSIUS - raw_report.temp;
+		report.temperature = L3GD20_TEMP_OFFSET_CELSIUS - raw_status.temp;
 
-	report.scaling = _gyro_range_scale;
-	report.range_rad_s = _gyro_range_rad_s;
+		report.scaling = _gyro_range_scale;
+		report.range_rad_s = _gyro_range_rad_s;
 
-	_reports->force(&report);
+		_reports->force(&report);
+	}
 
 	/* notify anyone waiting for data */
 	poll_notify(POLLIN);
 
-	/* publish for subscribers */
+	/* publish the newest sample for subscribers */
 	if (!(_pub_blocked)) {
 		/* publish it */
 		orb_publish(ORB_ID(sensor_gyro), _gyro_topic, &report);
 	}
 
-	_read++;
+	_read += count;
 
 	/* stop the perf counter */
 	perf_end(_sample_perf);
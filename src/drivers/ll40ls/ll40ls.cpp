@@ -64,6 +64,7 @@
 
 #include <drivers/drv_hrt.h>
 #include <drivers/drv_range_finder.h>
+#include <drivers/device/i2c_scheduler.h>
 #include <drivers/device/ringbuffer.h>
 
 #include <uORB/uORB.h>
@@ -137,7 +138,6 @@ protected:
 private:
 	float				_min_distance;
 	float				_max_distance;
-	work_s				_work;
 	RingBuffer			*_reports;
 	bool				_sensor_ok;
 	unsigned			_measure_ticks;
@@ -241,8 +241,6 @@ LL40LS::LL40LS(int bus, const char *path, int address) :
 	// enable debug() calls
 	_debug_enabled = false;
 
-	// work_cancel in the dtor will explode if we don't do this...
-	memset(&_work, 0, sizeof(_work));
 }
 
 LL40LS::~LL40LS()
@@ -727,7 +725,7 @@ LL40LS::start()
 	_reports->flush();
 
 	/* schedule a cycle to start things */
-	work_queue(HPWORK, &_work, (worker_t)&LL40LS::cycle_trampoline, this, 1);
+	device::I2CScheduler::schedule(_bus, (worker_t)&LL40LS::cycle_trampoline, this, 1);
 
 	/* notify about state change */
 	struct subsystem_info_s info = {
@@ -749,7 +747,7 @@ LL40LS::start()
 void
 LL40LS::stop()
 {
-	work_cancel(HPWORK, &_work);
+	device::I2CScheduler::cancel((worker_t)&LL40LS::cycle_trampoline, this);
 }
 
 void
@@ -784,8 +782,7 @@ LL40LS::cycle()
 			if (_measure_ticks > USEC2TICK(LL40LS_CONVERSION_INTERVAL)) {
 				
 				/* schedule a fresh cycle call when we are ready to measure again */
-				work_queue(HPWORK,
-					   &_work,
+				device::I2CScheduler::schedule(_bus,
 					   (worker_t)&LL40LS::cycle_trampoline,
 					   this,
 					   _measure_ticks - USEC2TICK(LL40LS_CONVERSION_INTERVAL));
@@ -808,8 +805,7 @@ LL40LS::cycle()
 	}
 
 	/* schedule a fresh cycle call when the measurement is done */
-	work_queue(HPWORK,
-		   &_work,
+	device::I2CScheduler::schedule(_bus,
 		   (worker_t)&LL40LS::cycle_trampoline,
 		   this,
 		   USEC2TICK(LL40LS_CONVERSION_INTERVAL));
@@ -196,10 +196,30 @@ static const int ERROR = -1;
 
 #define REG7_CONT_MODE_M		((0<<1) | (0<<0))
 
+#define REG0_FIFO_ENABLE		(1<<6)
+
+#define FIFO_CTRL_BYPASS_MODE		(0<<5)
+#define FIFO_CTRL_STREAM_MODE		(2<<5)
+
+#define FIFO_SRC_OVRN			(1<<6)
+#define FIFO_SRC_EMPTY			(1<<5)
+#define FIFO_SRC_FSS_MASK		0x1F
+
 
 #define INT_CTRL_M              0x12
 #define INT_SRC_M               0x13
 
+/*
+  the accel queues samples in its 32-slot FIFO; the hrt callback visits
+  at the sample rate divided by the batch size and drains whatever has
+  queued, so the driver filter still sees every sample while the
+  interrupt and bus-transaction cost drops by the batch factor. The mag
+  is read from the same drain pass on its own decimated schedule, so
+  this driver only owns a single timer.
+ */
+#define LSM303D_FIFO_SLOTS		32
+#define LSM303D_FIFO_BATCH		8
+
 /* default values for this device */
 #define LSM303D_ACCEL_DEFAULT_RANGE_G			8
 #define LSM303D_ACCEL_DEFAULT_RATE			800
@@ -261,10 +281,10 @@ private:
 	LSM303D_mag		*_mag;
 
 	struct hrt_call		_accel_call;
-	struct hrt_call		_mag_call;
 
 	unsigned		_call_accel_interval;
 	unsigned		_call_mag_interval;
+	hrt_abstime		_mag_last_measure;
 
 	RingBuffer		*_accel_reports;
 	RingBuffer		*_mag_reports;
@@ -290,6 +310,7 @@ private:
 	perf_counter_t		_accel_sample_perf;
 	perf_counter_t		_mag_sample_perf;
 	perf_counter_t		_accel_reschedules;
+	perf_counter_t		_accel_overruns;
 	perf_counter_t		_bad_registers;
 	perf_counter_t		_bad_values;
 
@@ -311,7 +332,7 @@ private:
 	// this is used to support runtime checking of key
 	// configuration registers to detect SPI bus errors and sensor
 	// reset
-#define LSM303D_NUM_CHECKED_REGISTERS 8
+#define LSM303D_NUM_CHECKED_REGISTERS 10
 	static const uint8_t	_checked_registers[LSM303D_NUM_CHECKED_REGISTERS];
 	uint8_t			_checked_values[LSM303D_NUM_CHECKED_REGISTERS];
 	uint8_t			_checked_next;
@@ -493,13 +514,15 @@ private:
   that ADDR_WHO_AM_I must be first in the list.
  */
 const uint8_t LSM303D::_checked_registers[LSM303D_NUM_CHECKED_REGISTERS] = { ADDR_WHO_AM_I,
+									     ADDR_CTRL_REG0,
 									     ADDR_CTRL_REG1,
 									     ADDR_CTRL_REG2,
 									     ADDR_CTRL_REG3,
 									     ADDR_CTRL_REG4,
 									     ADDR_CTRL_REG5,
 									     ADDR_CTRL_REG6,
-                                                                             ADDR_CTRL_REG7 };
+                                                                             ADDR_CTRL_REG7,
+                                                                             ADDR_FIFO_CTRL };
 
 /**
  * Helper class implementing the mag driver node.
@@ -540,9 +563,9 @@ LSM303D::LSM303D(int bus, const char* path, spi_dev_e device, enum Rotation rota
 	SPI("LSM303D", path, bus, device, SPIDEV_MODE3, 11*1000*1000 /* will be rounded to 10.4 MHz, within safety margins for LSM303D */),
 	_mag(new LSM303D_mag(this)),
 	_accel_call{},
-	_mag_call{},
 	_call_accel_interval(0),
 	_call_mag_interval(0),
+	_mag_last_measure(0),
 	_accel_reports(nullptr),
 	_mag_reports(nullptr),
 	_accel_scale{},
@@ -562,6 +585,7 @@ LSM303D::LSM303D(int bus, const char* path, spi_dev_e device, enum Rotation rota
 	_accel_sample_perf(perf_alloc(PC_ELAPSED, "lsm303d_accel_read")),
 	_mag_sample_perf(perf_alloc(PC_ELAPSED, "lsm303d_mag_read")),
 	_accel_reschedules(perf_alloc(PC_COUNT, "lsm303d_accel_resched")),
+	_accel_overruns(perf_alloc(PC_COUNT, "lsm303d_accel_overruns")),
 	_bad_registers(perf_alloc(PC_COUNT, "lsm303d_bad_registers")),
 	_bad_values(perf_alloc(PC_COUNT, "lsm303d_bad_values")),
 	_register_wait(0),
@@ -578,6 +602,10 @@ LSM303D::LSM303D(int bus, const char* path, spi_dev_e device, enum Rotation rota
 	// enable debug() calls
 	_debug_enabled = true;
 
+	// sample timing runs at full rate in interrupt context, use the cheap time source
+	perf_use_cycle_counter(_accel_sample_perf);
+	perf_use_cycle_counter(_mag_sample_perf);
+
 	_device_id.devid_s.devtype = DRV_ACC_DEVTYPE_LSM303D;
 	
 	/* Prime _mag with parents devid. */
@@ -623,6 +651,7 @@ LSM303D::~LSM303D()
 	perf_free(_bad_registers);
 	perf_free(_bad_values);
 	perf_free(_accel_reschedules);
+	perf_free(_accel_overruns);
 }
 
 int
@@ -649,6 +678,9 @@ LSM303D::init()
 
 	reset();
 
+	/* give the chip time to queue a first sample into the FIFO */
+	usleep(1000000 / LSM303D_ACCEL_DEFAULT_RATE + 1000);
+
 	/* do CDev init for the mag device node */
 	ret = _mag->init();
 	if (ret != OK) {
@@ -713,6 +745,12 @@ LSM303D::reset()
 	write_checked_reg(ADDR_CTRL_REG1,
 			  REG1_X_ENABLE_A | REG1_Y_ENABLE_A | REG1_Z_ENABLE_A | REG1_BDU_UPDATE | REG1_RATE_800HZ_A);
 
+	/* run the accel FIFO in stream mode. The oldest sample is dropped
+	 * on overrun, and the hrt callback drains every sample that has
+	 * queued since its last visit. */
+	write_checked_reg(ADDR_CTRL_REG0, REG0_FIFO_ENABLE);
+	write_checked_reg(ADDR_FIFO_CTRL, FIFO_CTRL_STREAM_MODE);
+
 	/* enable mag */
 	write_checked_reg(ADDR_CTRL_REG7, REG7_CONT_MODE_M);
 	write_checked_reg(ADDR_CTRL_REG5, REG5_RES_HIGH_M | REG5_ENABLE_T);
@@ -767,14 +805,10 @@ LSM303D::read(struct file *filp, char *buffer, size_t buflen)
 	/* if automatic measurement is enabled */
 	if (_call_accel_interval > 0) {
 		/*
-		 * While there is space in the caller's buffer, and reports, copy them.
+		 * Copy as many reports as the caller's buffer has space for
+		 * in one batch.
 		 */
-		while (count--) {
-			if (_accel_reports->get(arb)) {
-				ret += sizeof(*arb);
-				arb++;
-			}
-		}
+		ret = _accel_reports->get_bulk(arb, count) * sizeof(*arb);
 
 		/* if there was no data, warn the caller */
 		return ret ? ret : -EAGAIN;
@@ -805,14 +839,10 @@ LSM303D::mag_read(struct file *filp, char *buffer, size_t buflen)
 	if (_call_mag_interval > 0) {
 
 		/*
-		 * While there is space in the caller's buffer, and reports, copy them.
+		 * Copy as many reports as the caller's buffer has space for
+		 * in one batch.
 		 */
-		while (count--) {
-			if (_mag_reports->get(mrb)) {
-				ret += sizeof(*mrb);
-				mrb++;
-			}
-		}
+		ret = _mag_reports->get_bulk(mrb, count) * sizeof(*mrb);
 
 		/* if there was no data, warn the caller */
 		return ret ? ret : -EAGAIN;
@@ -874,7 +904,10 @@ LSM303D::ioctl(struct file *filp, int cmd, unsigned long arg)
 
 				/* update interval for next measurement */
 				/* XXX this is a bit shady, but no other way to adjust... */
-				_accel_call.period = _call_accel_interval = ticks;
+				_call_accel_interval = ticks;
+
+				/* the FIFO accumulates a batch of samples between visits */
+				_accel_call.period = _call_accel_interval * LSM303D_FIFO_BATCH;
 
 				/* if we need to start the poll state machine, do it */
 				if (want_start)
@@ -999,9 +1032,10 @@ LSM303D::mag_ioctl(struct file *filp, int cmd, unsigned long arg)
 					if (ticks < 1000)
 						return -EINVAL;
 
-					/* update interval for next measurement */
-					/* XXX this is a bit shady, but no other way to adjust... */
-					_mag_call.period = _call_mag_interval = ticks;
+					/* update interval for next measurement; the mag
+					 * is read from the accel drain pass on this
+					 * schedule */
+					_call_mag_interval = ticks;
 
 					/* if we need to start the poll state machine, do it */
 					if (want_start)
@@ -1387,16 +1421,17 @@ LSM303D::start()
 	_accel_reports->flush();
 	_mag_reports->flush();
 
-	/* start polling at the specified rate */
-	hrt_call_every(&_accel_call, 1000, _call_accel_interval, (hrt_callout)&LSM303D::measure_trampoline, this);
-	hrt_call_every(&_mag_call, 1000, _call_mag_interval, (hrt_callout)&LSM303D::mag_measure_trampoline, this);
+	/* start polling; the FIFO accumulates a batch of samples between
+	 * visits, and the mag is read from the same pass on its own
+	 * decimated schedule */
+	hrt_call_every(&_accel_call, 1000, _call_accel_interval * LSM303D_FIFO_BATCH,
+		       (hrt_callout)&LSM303D::measure_trampoline, this);
 }
 
 void
 LSM303D::stop()
 {
 	hrt_cancel(&_accel_call);
-	hrt_cancel(&_mag_call);
 }
 
 void
@@ -1447,16 +1482,19 @@ LSM303D::check_registers(void)
 void
 LSM303D::measure()
 {
-	/* status register and data as read back from the device */
+	/* samples as read back from the device */
 
 #pragma pack(push, 1)
-	struct {
-		uint8_t		cmd;
-		uint8_t		status;
+	struct sample_s {
 		int16_t		x;
 		int16_t		y;
 		int16_t		z;
-	} raw_accel_report;
+	};
+
+	struct {
+		uint8_t		cmd;
+		struct sample_s	samples[LSM303D_FIFO_SLOTS];
+	} raw_fifo;
 #pragma pack(pop)
 
 	accel_report accel_report;
@@ -1466,20 +1504,6 @@ LSM303D::measure()
 
 	check_registers();
 
-	// if the accel doesn't have any data ready then re-schedule
-	// for 100 microseconds later. This ensures we don't double
-	// read a value and then miss the next value.
-	// Note that DRDY is not available when the lsm303d is
-	// connected on the external bus
-#ifdef GPIO_EXTI_ACCEL_DRDY
-	if (_bus == PX4_SPI_BUS_SENSORS && stm32_gpioread(GPIO_EXTI_ACCEL_DRDY) == 0) {
-		perf_count(_accel_reschedules);
-		hrt_call_delay(&_accel_call, 100);
-                perf_end(_accel_sample_perf);
-		return;
-	}
-#endif
-
 	if (_register_wait != 0) {
 		// we are waiting for some good transfers before using
 		// the sensor again.
@@ -1488,10 +1512,32 @@ LSM303D::measure()
 		return;
 	}
 
-	/* fetch data from the sensor */
-	memset(&raw_accel_report, 0, sizeof(raw_accel_report));
-	raw_accel_report.cmd = ADDR_STATUS_A | DIR_READ | ADDR_INCREMENT;
-	transfer((uint8_t *)&raw_accel_report, (uint8_t *)&raw_accel_report, sizeof(raw_accel_report));
+	/* see how many samples have queued since the last drain */
+	uint8_t fifo_src = read_reg(ADDR_FIFO_SRC);
+	unsigned count = fifo_src & FIFO_SRC_FSS_MASK;
+
+	if (fifo_src & FIFO_SRC_OVRN) {
+		/* stream mode dropped the oldest slots; all are valid */
+		perf_count(_accel_overruns);
+		count = LSM303D_FIFO_SLOTS;
+	}
+
+	if ((fifo_src & FIFO_SRC_EMPTY) || (count == 0)) {
+		// no sample has queued yet - look again in 100
+		// microseconds rather than waiting out a whole batch
+		perf_count(_accel_reschedules);
+		hrt_call_delay(&_accel_call, 100);
+		perf_end(_accel_sample_perf);
+		return;
+	}
+
+	if (count > LSM303D_FIFO_SLOTS)
+		count = LSM303D_FIFO_SLOTS;
+
+	/* drain all queued samples in one burst; with the FIFO enabled the
+	 * register address rolls back to OUT_X_L_A after each sample */
+	raw_fifo.cmd = ADDR_OUT_X_L_A | DIR_READ | ADDR_INCREMENT;
+	transfer((uint8_t *)&raw_fifo, (uint8_t *)&raw_fifo, 1 + count * sizeof(struct sample_s));
 
 	/*
 	 * 1) Scale raw value to SI units using scaling from datasheet.
@@ -1508,84 +1554,94 @@ LSM303D::measure()
 	 *		  74 from all measurements centers them around zero.
 	 */
 
+	for (unsigned i = 0; i < count; i++) {
+		const struct sample_s &sample = raw_fifo.samples[i];
 
-	accel_report.timestamp = hrt_absolute_time();
+		/* back-date samples that waited in the FIFO by the sample interval */
+		accel_report.timestamp = hrt_absolute_time() - ((count - 1 - i) * (1000000 / _accel_samplerate));
 
-	// use the temperature from the last mag reading
-	accel_report.temperature = _last_temperature;
+		// use the temperature from the last mag reading
+		accel_report.temperature = _last_temperature;
 
-	// report the error count as the sum of the number of bad
-	// register reads and bad values. This allows the higher level
-	// code to decide if it should use this sensor based on
-	// whether it has had failures
-        accel_report.error_count = perf_event_count(_bad_registers) + perf_event_count(_bad_values);
+		// report the error count as the sum of the number of bad
+		// register reads and bad values. This allows the higher level
+		// code to decide if it should use this sensor based on
+		// whether it has had failures
+	        accel_report.error_count = perf_event_count(_bad_registers) + perf_event_count(_bad_values);
 
-	accel_report.x_raw = raw_accel_report.x;
-	accel_report.y_raw = raw_accel_report.y;
-	accel_report.z_raw = raw_accel_report.z;
+		accel_report.x_raw = sample.x;
+		accel_report.y_raw = sample.y;
+		accel_report.z_raw = sample.z;
 
-	float xraw_f = raw_accel_report.x;
-	float yraw_f = raw_accel_report.y;
-	float zraw_f = raw_accel_report.z;
+		float xraw_f = sample.x;
+		float yraw_f = sample.y;
+		float zraw_f = sample.z;
 
-	// apply user specified rotation
-	rotate_3f(_rotation, xraw_f, yraw_f, zraw_f);
+		// apply user specified rotation
+		rotate_3f(_rotation, xraw_f, yraw_f, zraw_f);
 
-	float x_in_new = ((xraw_f * _accel_range_scale) - _accel_scale.x_offset) * _accel_scale.x_scale;
-	float y_in_new = ((yraw_f * _accel_range_scale) - _accel_scale.y_offset) * _accel_scale.y_scale;
-	float z_in_new = ((zraw_f * _accel_range_scale) - _accel_scale.z_offset) * _accel_scale.z_scale;
+		float x_in_new = ((xraw_f * _accel_range_scale) - _accel_scale.x_offset) * _accel_scale.x_scale;
+		float y_in_new = ((yraw_f * _accel_range_scale) - _accel_scale.y_offset) * _accel_scale.y_scale;
+		float z_in_new = ((zraw_f * _accel_range_scale) - _accel_scale.z_offset) * _accel_scale.z_scale;
 
-	/*
-	  we have logs where the accelerometers get stuck at a fixed
-	  large value. We want to detect this and mark the sensor as
-	  being faulty
-	 */
-	if (fabsf(_last_accel[0] - x_in_new) < 0.001f &&
-	    fabsf(_last_accel[1] - y_in_new) < 0.001f &&
-	    fabsf(_last_accel[2] - z_in_new) < 0.001f &&
-	    fabsf(x_in_new) > 20 &&
-	    fabsf(y_in_new) > 20 &&
-	    fabsf(z_in_new) > 20) {
-		_constant_accel_count += 1;
-	} else {
-		_constant_accel_count = 0;
-	}
-	if (_constant_accel_count > 100) {
-		// we've had 100 constant accel readings with large
-		// values. The sensor is almost certainly dead. We
-		// will raise the error_count so that the top level
-		// flight code will know to avoid this sensor, but
-		// we'll still give the data so that it can be logged
-		// and viewed
-		perf_count(_bad_values);
-		_constant_accel_count = 0;
-	}
+		/*
+		  we have logs where the accelerometers get stuck at a fixed
+		  large value. We want to detect this and mark the sensor as
+		  being faulty
+		 */
+		if (fabsf(_last_accel[0] - x_in_new) < 0.001f &&
+		    fabsf(_last_accel[1] - y_in_new) < 0.001f &&
+		    fabsf(_last_accel[2] - z_in_new) < 0.001f &&
+		    fabsf(x_in_new) > 20 &&
+		    fabsf(y_in_new) > 20 &&
+		    fabsf(z_in_new) > 20) {
+			_constant_accel_count += 1;
+		} else {
+			_constant_accel_count = 0;
+		}
+		if (_constant_accel_count > 100) {
+			// we've had 100 constant accel readings with large
+			// values. The sensor is almost certainly dead. We
+			// will raise the error_count so that the top level
+			// flight code will know to avoid this sensor, but
+			// we'll still give the data so that it can be logged
+			// and viewed
+			perf_count(_bad_values);
+			_constant_accel_count = 0;
+		}
 
-	_last_accel[0] = x_in_new;
-	_last_accel[1] = y_in_new;
-	_last_accel[2] = z_in_new;
+		_last_accel[0] = x_in_new;
+		_last_accel[1] = y_in_new;
+		_last_accel[2] = z_in_new;
 
-	accel_report.x = _accel_filter_x.apply(x_in_new);
-	accel_report.y = _accel_filter_y.apply(y_in_new);
-	accel_report.z = _accel_filter_z.apply(z_in_new);
+		accel_report.x = _accel_filter_x.apply(x_in_new);
+		accel_report.y = _accel_filter_y.apply(y_in_new);
+		accel_report.z = _accel_filter_z.apply(z_in_new);
 
-	accel_report.scaling = _accel_range_scale;
-	accel_report.range_m_s2 = _accel_range_m_s2;
+		accel_report.scaling = _accel_range_scale;
+		accel_report.range_m_s2 = _accel_range_m_s2;
 
-	_accel_reports->force(&accel_report);
+		_accel_reports->force(&accel_report);
+	}
 
 	/* notify anyone waiting for data */
 	poll_notify(POLLIN);
 
 	if (!(_pub_blocked)) {
-		/* publish it */
+		/* publish the newest sample for subscribers */
 		orb_publish(ORB_ID(sensor_accel), _accel_topic, &accel_report);
 	}
 
-	_accel_read++;
+	_accel_read += count;
 
 	/* stop the perf counter */
 	perf_end(_accel_sample_perf);
+
+	/* fold the mag readout into the same bus pass on its decimated schedule */
+	if ((_call_mag_interval > 0) &&
+	    (hrt_elapsed_time(&_mag_last_measure) >= _call_mag_interval)) {
+		mag_measure();
+	}
 }
 
 void
@@ -1631,6 +1687,7 @@ LSM303D::mag_measure()
 
 
 	mag_report.timestamp = hrt_absolute_time();
+	_mag_last_measure = mag_report.timestamp;
 
 	mag_report.x_raw = raw_mag_report.x;
 	mag_report.y_raw = raw_mag_report.y;
@@ -1682,6 +1739,7 @@ LSM303D::print_info()
 	perf_print_counter(_bad_registers);
 	perf_print_counter(_bad_values);
 	perf_print_counter(_accel_reschedules);
+	perf_print_counter(_accel_overruns);
 	_accel_reports->print_info("accel reports");
 	_mag_reports->print_info("mag reports");
         ::printf("checked_next: %u\n", _checked_next);
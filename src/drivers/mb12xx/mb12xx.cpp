@@ -66,6 +66,7 @@
 
 #include <drivers/drv_hrt.h>
 #include <drivers/drv_range_finder.h>
+#include <drivers/device/i2c_scheduler.h>
 #include <drivers/device/ringbuffer.h>
 
 #include <uORB/uORB.h>
@@ -124,7 +125,6 @@ protected:
 private:
 	float				_min_distance;
 	float				_max_distance;
-	work_s				_work;
 	RingBuffer		*_reports;
 	bool				_sensor_ok;
 	int					_measure_ticks;
@@ -220,8 +220,6 @@ MB12XX::MB12XX(int bus, int address) :
 	/* enable debug() calls */
 	_debug_enabled = false;
 
-	/* work_cancel in the dtor will explode if we don't do this... */
-	memset(&_work, 0, sizeof(_work));
 }
 
 MB12XX::~MB12XX()
@@ -640,7 +638,7 @@ MB12XX::start()
 	_reports->flush();
 
 	/* schedule a cycle to start things */
-	work_queue(HPWORK, &_work, (worker_t)&MB12XX::cycle_trampoline, this, 5);
+	device::I2CScheduler::schedule(_bus, (worker_t)&MB12XX::cycle_trampoline, this, 5);
 
 	/* notify about state change */
 	struct subsystem_info_s info = {
@@ -664,7 +662,7 @@ MB12XX::start()
 void
 MB12XX::stop()
 {
-	work_cancel(HPWORK, &_work);
+	device::I2CScheduler::cancel((worker_t)&MB12XX::cycle_trampoline, this);
 }
 
 void
@@ -708,8 +706,7 @@ MB12XX::cycle()
 		if (_measure_ticks > USEC2TICK(_cycling_rate)) {
 
 			/* schedule a fresh cycle call when we are ready to measure again */
-			work_queue(HPWORK,
-				   &_work,
+			device::I2CScheduler::schedule(_bus,
 				   (worker_t)&MB12XX::cycle_trampoline,
 				   this,
 				   _measure_ticks - USEC2TICK(_cycling_rate));
@@ -732,8 +729,7 @@ MB12XX::cycle()
 	_collect_phase = true;
 
 	/* schedule a fresh cycle call when the measurement is done */
-	work_queue(HPWORK,
-		   &_work,
+	device::I2CScheduler::schedule(_bus,
 		   (worker_t)&MB12XX::cycle_trampoline,
 		   this,
 		   USEC2TICK(_cycling_rate));
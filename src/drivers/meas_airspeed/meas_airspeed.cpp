@@ -78,6 +78,7 @@
 #include <systemlib/err.h>
 #include <systemlib/param/param.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/px4_work.h>
 
 #include <mathlib/math/filter/LowPassFilter2p.hpp>
 
@@ -128,8 +129,16 @@ protected:
 	 */
 	void voltage_correction(float &diff_pres_pa, float &temperature);
 
+	/**
+	 * Handle completion of an asynchronous measurement command.
+	 */
+	static void	measure_complete(void *arg, int result);
+
 	int _t_system_power;
 	struct system_power_s system_power;
+
+	device::i2c_transaction_s	_measure_trans;
+	uint8_t				_measure_cmd;
 };
 
 /*
@@ -141,7 +150,9 @@ MEASAirspeed::MEASAirspeed(int bus, int address, const char *path) : Airspeed(bu
 	CONVERSION_INTERVAL, path),
 	_filter(MEAS_RATE, MEAS_DRIVER_FILTER_FREQ),
 	_t_system_power(-1),
-	system_power{}
+	system_power{},
+	_measure_trans{},
+	_measure_cmd(ADDR_READ_MR)
 {
 }
 
@@ -151,10 +162,20 @@ MEASAirspeed::measure()
 	int ret;
 
 	/*
-	 * Send the command to begin a measurement.
+	 * Send the command to begin a measurement. The command goes out
+	 * asynchronously, so our high-priority work queue slot is not held
+	 * for the duration of the bus transaction.
 	 */
-	uint8_t cmd = 0;
-	ret = transfer(&cmd, 1, nullptr, 0);
+	_measure_trans.send = &_measure_cmd;
+	_measure_trans.send_len = 1;
+	_measure_trans.recv = nullptr;
+	_measure_trans.recv_len = 0;
+	/* a command still queued at collection time would start a conversion we never pick up */
+	_measure_trans.deadline = hrt_absolute_time() + CONVERSION_INTERVAL / 2;
+	_measure_trans.callback = &MEASAirspeed::measure_complete;
+	_measure_trans.arg = this;
+
+	ret = transfer_async(&_measure_trans);
 
 	if (OK != ret) {
 		perf_count(_comms_errors);
@@ -163,6 +184,16 @@ MEASAirspeed::measure()
 	return ret;
 }
 
+void
+MEASAirspeed::measure_complete(void *arg, int result)
+{
+	MEASAirspeed *dev = reinterpret_cast<MEASAirspeed *>(arg);
+
+	if (OK != result) {
+		perf_count(dev->_comms_errors);
+	}
+}
+
 int
 MEASAirspeed::collect()
 {
@@ -291,12 +322,13 @@ MEASAirspeed::cycle()
 		 */
 		if (_measure_ticks > USEC2TICK(CONVERSION_INTERVAL)) {
 
-			/* schedule a fresh cycle call when we are ready to measure again */
-			work_queue(HPWORK,
+			/* schedule the next measurement on the hrt epoch grid, so the
+			 * samples stay in phase with the IMU instead of free-running */
+			px4_work_queue(PX4_WORK_SENSOR,
 				   &_work,
 				   (worker_t)&Airspeed::cycle_trampoline,
 				   this,
-				   _measure_ticks - USEC2TICK(CONVERSION_INTERVAL));
+				   phase_aligned_delay(_measure_ticks));
 
 			return;
 		}
@@ -314,7 +346,7 @@ MEASAirspeed::cycle()
 	_collect_phase = true;
 
 	/* schedule a fresh cycle call when the measurement is done */
-	work_queue(HPWORK,
+	px4_work_queue(PX4_WORK_SENSOR,
 		   &_work,
 		   (worker_t)&Airspeed::cycle_trampoline,
 		   this,
@@ -86,6 +86,7 @@
 #define UPDATE_RATE						200
 #define MAX_MOTORS 						8
 #define BLCTRL_BASE_ADDR 				0x29
+#define BLCTRL_BROADCAST_ADDR			0x00
 #define BLCTRL_OLD 						0
 #define BLCTRL_NEW 						1
 #define BLCTRL_MIN_VALUE				-0.920F
@@ -146,6 +147,7 @@ public:
 	unsigned int		mk_check_for_blctrl(unsigned int count, bool showOutput, bool initI2C);
 	void		set_rc_min_value(unsigned value);
 	void		set_rc_max_value(unsigned value);
+	void		set_sync_updates(bool sync);
 
 private:
 	static const unsigned	_max_actuators = MAX_MOTORS;
@@ -165,6 +167,7 @@ private:
 	bool					_primary_pwm_device;
 	bool     				_motortest;
 	bool 					_overrideSecurityChecks;
+	bool					_sync_updates;
 	volatile bool			_task_should_exit;
 	bool					_armed;
 	unsigned long			debugCounter;
@@ -187,6 +190,8 @@ private:
 	int						pwm_ioctl(file *filp, int cmd, unsigned long arg);
 	int						mk_servo_arm(bool status);
 	int 					mk_servo_set(unsigned int chan, short val);
+	void 					mk_servo_prepare(unsigned int chan, short val);
+	int 					mk_servo_set_all();
 	int 					mk_servo_test(unsigned int chan);
 	int 					mk_servo_locate();
 	short					scaling(float val, float inMin, float inMax, float outMin, float outMax);
@@ -231,6 +236,7 @@ MK::MK(int bus, const char *_device_path) :
 	_primary_pwm_device(false),
 	_motortest(false),
 	_overrideSecurityChecks(false),
+	_sync_updates(false),
 	_task_should_exit(false),
 	_armed(false),
 	_mixers(nullptr),
@@ -350,6 +356,16 @@ MK::set_rc_max_value(unsigned value)
 	fprintf(stderr, "[mkblctrl] rc_max = %i\n", _rc_max_value);
 }
 
+void
+MK::set_sync_updates(bool sync)
+{
+	_sync_updates = sync;
+
+	if (sync) {
+		fprintf(stderr, "[mkblctrl] broadcast sync enabled\n");
+	}
+}
+
 int
 MK::set_motor_count(unsigned count)
 {
@@ -575,9 +591,14 @@ MK::task_main()
 						/* output to BLCtrl's */
 						if (_motortest != true && _indicate_esc != true) {
 							Motor[i].SetPoint_PX4 = outputs.output[i];
-							mk_servo_set(i, scaling(outputs.output[i], -1.0f, 1.0f, 0, 2047));	// scale the output to 0 - 2047 and sent to output routine
+							mk_servo_prepare(i, scaling(outputs.output[i], -1.0f, 1.0f, 0, 2047));	// scale the output to 0 - 2047
 						}
 					}
+
+					/* send all setpoints back-to-back in one bus burst */
+					if (_motortest != true && _indicate_esc != true) {
+						mk_servo_set_all();
+					}
 				}
 			}
 		}
@@ -734,16 +755,10 @@ MK::mk_check_for_blctrl(unsigned int count, bool showOutput, bool initI2C)
 	return foundMotorCount;
 }
 
-int
-MK::mk_servo_set(unsigned int chan, short val)
+void
+MK::mk_servo_prepare(unsigned int chan, short val)
 {
-	short tmpVal = 0;
-	_retries = 0;
-	uint8_t result[3] = { 0, 0, 0 };
-	uint8_t msg[2] = { 0, 0 };
-	uint8_t bytesToSendBL2 = 2;
-
-	tmpVal = val;
+	short tmpVal = val;
 
 	if (tmpVal > 2047) {
 		tmpVal = 2047;
@@ -759,6 +774,102 @@ MK::mk_servo_set(unsigned int chan, short val)
 		Motor[chan].SetPoint = 0;
 		Motor[chan].SetPointLowerBits = 0;
 	}
+}
+
+int
+MK::mk_servo_set_all()
+{
+	struct i2c_msg_s msgv[2 * MAX_MOTORS + 1];
+	uint8_t out[MAX_MOTORS][2];
+	uint8_t in[MAX_MOTORS][3];
+	bool readStatus[MAX_MOTORS];
+	uint8_t sync = 0;
+	unsigned msgs = 0;
+
+	_retries = 0;
+
+	/* queue one addressed setpoint write per motor, with the status
+	 * readout appended on each motor's 16th cycle */
+	for (unsigned int i = 0; i < _num_outputs; i++) {
+		out[i][0] = Motor[i].SetPoint;
+		out[i][1] = Motor[i].SetPointLowerBits;
+
+		msgv[msgs].addr = BLCTRL_BASE_ADDR + (i + addrTranslator[i]);
+		msgv[msgs].flags = 0;
+		msgv[msgs].buffer = &out[i][0];
+
+		if (Motor[i].Version == BLCTRL_OLD) {
+			msgv[msgs].length = 1;
+
+		} else {
+			/* if setpoint lower bits are zero, we send only the higher bits - this saves time */
+			msgv[msgs].length = (Motor[i].SetPointLowerBits == 0) ? 1 : 2;
+		}
+
+		msgs++;
+
+		readStatus[i] = (Motor[i].RoundCount >= 16);
+
+		if (readStatus[i]) {
+			// on each 16th cyle we read out the status messages from the blctrl
+			msgv[msgs].addr = BLCTRL_BASE_ADDR + (i + addrTranslator[i]);
+			msgv[msgs].flags = I2C_M_READ;
+			msgv[msgs].buffer = &in[i][0];
+			msgv[msgs].length = (Motor[i].Version == BLCTRL_OLD) ? 2 : 3;
+			msgs++;
+		}
+	}
+
+	if (msgs == 0) {
+		return OK;
+	}
+
+	/* optionally close the burst with the broadcast sync; the BL-Ctrls
+	 * latch the queued setpoints simultaneously on the general call */
+	if (_sync_updates) {
+		msgv[msgs].addr = BLCTRL_BROADCAST_ADDR;
+		msgv[msgs].flags = 0;
+		msgv[msgs].buffer = &sync;
+		msgv[msgs].length = 1;
+		msgs++;
+	}
+
+	if (OK == transfer_multi(&msgv[0], msgs)) {
+		for (unsigned int i = 0; i < _num_outputs; i++) {
+			if (readStatus[i]) {
+				Motor[i].Current = in[i][0];
+				Motor[i].MaxPWM = in[i][1];
+				Motor[i].Temperature = (Motor[i].Version == BLCTRL_OLD) ? 255 : in[i][2];
+				Motor[i].RoundCount = 0;
+			}
+
+			Motor[i].RoundCount++;
+		}
+
+		return OK;
+	}
+
+	/* the whole burst failed - charge the error against every motor */
+	for (unsigned int i = 0; i < _num_outputs; i++) {
+		if ((Motor[i].State & MOTOR_STATE_ERROR_MASK) < MOTOR_STATE_ERROR_MASK) {
+			Motor[i].State++;	// error
+		}
+
+		Motor[i].RoundCount++;
+	}
+
+	return -EIO;
+}
+
+int
+MK::mk_servo_set(unsigned int chan, short val)
+{
+	_retries = 0;
+	uint8_t result[3] = { 0, 0, 0 };
+	uint8_t msg[2] = { 0, 0 };
+	uint8_t bytesToSendBL2 = 2;
+
+	mk_servo_prepare(chan, val);
 
 	//if(Motor[chan].State & MOTOR_STATE_PRESENT_MASK) {
 	set_address(BLCTRL_BASE_ADDR + (chan + addrTranslator[chan]));
@@ -1147,9 +1258,12 @@ MK::write(file *filp, const char *buffer, size_t len)
 
 	for (uint8_t i = 0; i < count; i++) {
 		Motor[i].RawPwmValue = (unsigned short)values[i];
-		mk_servo_set(i, scaling(values[i], _rc_min_value, _rc_max_value, 0, 2047));
+		mk_servo_prepare(i, scaling(values[i], _rc_min_value, _rc_max_value, 0, 2047));
 	}
 
+	/* send all setpoints back-to-back in one bus burst */
+	mk_servo_set_all();
+
 	return count * 2;
 }
 
@@ -1169,7 +1283,7 @@ enum FrameType {
 
 
 int
-mk_new_mode(int motorcount, bool motortest, int px4mode, int frametype, bool overrideSecurityChecks, unsigned rcmin, unsigned rcmax)
+mk_new_mode(int motorcount, bool motortest, int px4mode, int frametype, bool overrideSecurityChecks, unsigned rcmin, unsigned rcmax, bool syncUpdates)
 {
 	int shouldStop = 0;
 
@@ -1191,6 +1305,9 @@ mk_new_mode(int motorcount, bool motortest, int px4mode, int frametype, bool ove
 	/* ovveride security checks if enabled */
 	g_mk->set_overrideSecurityChecks(overrideSecurityChecks);
 
+	/* broadcast sync after each update burst if enabled */
+	g_mk->set_sync_updates(syncUpdates);
+
 	/* count used motors */
 	do {
 		if (g_mk->mk_check_for_blctrl(8, false, false) != 0) {
@@ -1270,6 +1387,7 @@ mkblctrl_main(int argc, char *argv[])
 	const char *devicepath = "";
 	unsigned rc_min_value = RC_MIN_VALUE;
 	unsigned rc_max_value = RC_MAX_VALUE;
+	bool syncUpdates = false;
 	char *ep;
 
 	/*
@@ -1301,6 +1419,11 @@ mkblctrl_main(int argc, char *argv[])
 			}
 		}
 
+		/* look for the optional broadcast sync parameter */
+		if (strcmp(argv[i], "-sync") == 0 || strcmp(argv[i], "--sync") == 0) {
+			syncUpdates = true;
+		}
+
 		/* look for the optional test parameter */
 		if (strcmp(argv[i], "-t") == 0) {
 			motortest = true;
@@ -1369,6 +1492,7 @@ mkblctrl_main(int argc, char *argv[])
 		fprintf(stderr, "\t --override-security-checks \t\t Disable all security checks (arming and number of ESCs). Used to test single Motors etc. (DANGER !!!)\n");
 		fprintf(stderr, "\t -rcmin {pwn-value}\t\t Set RC_MIN Value.\n");
 		fprintf(stderr, "\t -rcmax {pwn-value}\t\t Set RC_MAX Value.\n");
+		fprintf(stderr, "\t -sync \t\t Close each update burst with the broadcast sync (BL-Ctrl >= 2.0).\n");
 		fprintf(stderr, "\n");
 		fprintf(stderr, "Motortest:\n");
 		fprintf(stderr, "First you have to start mkblctrl, the you can enter Motortest Mode with:\n");
@@ -1387,7 +1511,7 @@ mkblctrl_main(int argc, char *argv[])
 			/* parameter set ? */
 			if (newMode) {
 				/* switch parameter */
-				return mk_new_mode(motorcount, motortest, px4mode, frametype, overrideSecurityChecks, rc_min_value, rc_max_value);
+				return mk_new_mode(motorcount, motortest, px4mode, frametype, overrideSecurityChecks, rc_min_value, rc_max_value, syncUpdates);
 			}
 
 			exit(0);
@@ -60,6 +60,7 @@
 #include <systemlib/perf_counter.h>
 #include <systemlib/err.h>
 #include <systemlib/conversions.h>
+#include <systemlib/obj_pool.h>
 
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
@@ -145,7 +146,14 @@
 #define BIT_INT_ANYRD_2CLEAR		0x10
 #define BIT_RAW_RDY_EN			0x01
 #define BIT_I2C_IF_DIS			0x10
+#define BIT_FIFO_ENABLE			0x40
+#define BIT_FIFO_RESET			0x04
 #define BIT_INT_STATUS_DATA		0x01
+#define BIT_TEMP_FIFO_EN		0x80
+#define BIT_XG_FIFO_EN			0x40
+#define BIT_YG_FIFO_EN			0x20
+#define BIT_ZG_FIFO_EN			0x10
+#define BIT_ACCEL_FIFO_EN		0x08
 
 // Product ID Description for MPU6000
 // high 4 bits 	low 4 bits
@@ -175,6 +183,14 @@
 
 #define MPU6000_ONE_G					9.80665f
 
+/*
+  the MPU6000 queues accel, temperature and gyro samples in register
+  order in its on-chip FIFO; draining the FIFO in bursts moves several
+  samples per bus transaction instead of one
+ */
+#define MPU6000_FIFO_SIZE				1024
+#define MPU6000_FIFO_MAX_RECORDS			8
+
 #ifdef PX4_SPI_BUS_EXT
 #define EXTERNAL_BUS PX4_SPI_BUS_EXT
 #else
@@ -219,6 +235,13 @@ public:
 	// deliberately cause a sensor error
 	void 			test_error();
 
+	/**
+	 * Driver instances are recycled from a boot-time pool so that
+	 * repeated start/stop cycles do not fragment the heap.
+	 */
+	void			*operator new(size_t size) throw();
+	void			operator delete(void *ptr);
+
 protected:
 	virtual int		probe();
 
@@ -250,6 +273,7 @@ private:
 	float			_gyro_range_rad_s;
 
 	unsigned		_sample_rate;
+	unsigned		_dlpf_freq;
 	perf_counter_t		_accel_reads;
 	perf_counter_t		_gyro_reads;
 	perf_counter_t		_sample_perf;
@@ -257,25 +281,22 @@ private:
 	perf_counter_t		_bad_registers;
 	perf_counter_t		_good_transfers;
 	perf_counter_t		_reset_retries;
+	perf_counter_t		_fifo_resets;
 	perf_counter_t		_system_latency_perf;
 	perf_counter_t		_controller_latency_perf;
 
 	uint8_t			_register_wait;
 	uint64_t		_reset_wait;
 
-	math::LowPassFilter2p	_accel_filter_x;
-	math::LowPassFilter2p	_accel_filter_y;
-	math::LowPassFilter2p	_accel_filter_z;
-	math::LowPassFilter2p	_gyro_filter_x;
-	math::LowPassFilter2p	_gyro_filter_y;
-	math::LowPassFilter2p	_gyro_filter_z;
+	math::LowPassFilter2pVector3f	_accel_filter;
+	math::LowPassFilter2pVector3f	_gyro_filter;
 
 	enum Rotation		_rotation;
 
 	// this is used to support runtime checking of key
 	// configuration registers to detect SPI bus errors and sensor
 	// reset
-#define MPU6000_NUM_CHECKED_REGISTERS 9
+#define MPU6000_NUM_CHECKED_REGISTERS 10
 	static const uint8_t	_checked_registers[MPU6000_NUM_CHECKED_REGISTERS];
 	uint8_t			_checked_values[MPU6000_NUM_CHECKED_REGISTERS];
 	uint8_t			_checked_next;
@@ -304,6 +325,13 @@ private:
 	 */
 	int			reset();
 
+	/**
+	 * Discard the FIFO contents and restart collection.
+	 *
+	 * Required after an overflow, as the record alignment is lost.
+	 */
+	void			fifo_reset();
+
 	/**
 	 * Static trampoline from the hrt_call context; because we don't have a
 	 * generic hrt wrapper yet.
@@ -432,6 +460,28 @@ private:
 		uint8_t		gyro_y[2];
 		uint8_t		gyro_z[2];
 	};
+
+	/**
+	 * One FIFO record; the same sensor registers in the same order,
+	 * but without the command/status preamble.
+	 */
+	struct MPUFifoRecord {
+		uint8_t		accel_x[2];
+		uint8_t		accel_y[2];
+		uint8_t		accel_z[2];
+		uint8_t		temp[2];
+		uint8_t		gyro_x[2];
+		uint8_t		gyro_y[2];
+		uint8_t		gyro_z[2];
+	};
+
+	/**
+	 * FIFO burst transfer, including command byte.
+	 */
+	struct MPUFifoReport {
+		uint8_t		cmd;
+		struct MPUFifoRecord records[MPU6000_FIFO_MAX_RECORDS];
+	};
 #pragma pack(pop)
 };
 
@@ -442,6 +492,7 @@ private:
 const uint8_t MPU6000::_checked_registers[MPU6000_NUM_CHECKED_REGISTERS] = { MPUREG_PRODUCT_ID,
 									     MPUREG_PWR_MGMT_1,
 									     MPUREG_USER_CTRL,
+									     MPUREG_FIFO_EN,
 									     MPUREG_SMPLRT_DIV,
                                                                              MPUREG_CONFIG,
 									     MPUREG_GYRO_CONFIG,
@@ -484,6 +535,33 @@ private:
 /** driver 'main' command */
 extern "C" { __EXPORT int mpu6000_main(int argc, char *argv[]); }
 
+/* boot-time storage for the two possible instances (internal and external bus) */
+static uint8_t instance_storage[2][sizeof(MPU6000)] __attribute__((aligned(8)));
+static struct obj_pool_s instance_pool;
+static bool instance_pool_initialized = false;
+
+void *
+MPU6000::operator new(size_t size) throw()
+{
+	if (!instance_pool_initialized) {
+		obj_pool_init(&instance_pool, "mpu6000", instance_storage,
+			      sizeof(instance_storage[0]), 2);
+		instance_pool_initialized = true;
+	}
+
+	if (size > sizeof(instance_storage[0])) {
+		return nullptr;
+	}
+
+	return obj_pool_alloc(&instance_pool);
+}
+
+void
+MPU6000::operator delete(void *ptr)
+{
+	obj_pool_free(&instance_pool, ptr);
+}
+
 MPU6000::MPU6000(int bus, const char *path_accel, const char *path_gyro, spi_dev_e device, enum Rotation rotation) :
 	SPI("MPU6000", path_accel, bus, device, SPIDEV_MODE3, MPU6000_LOW_BUS_SPEED),
 	_gyro(new MPU6000_gyro(this, path_gyro)),
@@ -502,6 +580,7 @@ MPU6000::MPU6000(int bus, const char *path_accel, const char *path_gyro, spi_dev
 	_gyro_range_scale(0.0f),
 	_gyro_range_rad_s(0.0f),
 	_sample_rate(1000),
+	_dlpf_freq(MPU6000_DEFAULT_ONCHIP_FILTER_FREQ),
 	_accel_reads(perf_alloc(PC_COUNT, "mpu6000_accel_read")),
 	_gyro_reads(perf_alloc(PC_COUNT, "mpu6000_gyro_read")),
 	_sample_perf(perf_alloc(PC_ELAPSED, "mpu6000_read")),
@@ -509,16 +588,13 @@ MPU6000::MPU6000(int bus, const char *path_accel, const char *path_gyro, spi_dev
 	_bad_registers(perf_alloc(PC_COUNT, "mpu6000_bad_registers")),
 	_good_transfers(perf_alloc(PC_COUNT, "mpu6000_good_transfers")),
 	_reset_retries(perf_alloc(PC_COUNT, "mpu6000_reset_retries")),
+	_fifo_resets(perf_alloc(PC_COUNT, "mpu6000_fifo_resets")),
 	_system_latency_perf(perf_alloc_once(PC_ELAPSED, "sys_latency")),
 	_controller_latency_perf(perf_alloc_once(PC_ELAPSED, "ctrl_latency")),
 	_register_wait(0),
 	_reset_wait(0),
-	_accel_filter_x(MPU6000_ACCEL_DEFAULT_RATE, MPU6000_ACCEL_DEFAULT_DRIVER_FILTER_FREQ),
-	_accel_filter_y(MPU6000_ACCEL_DEFAULT_RATE, MPU6000_ACCEL_DEFAULT_DRIVER_FILTER_FREQ),
-	_accel_filter_z(MPU6000_ACCEL_DEFAULT_RATE, MPU6000_ACCEL_DEFAULT_DRIVER_FILTER_FREQ),
-	_gyro_filter_x(MPU6000_GYRO_DEFAULT_RATE, MPU6000_GYRO_DEFAULT_DRIVER_FILTER_FREQ),
-	_gyro_filter_y(MPU6000_GYRO_DEFAULT_RATE, MPU6000_GYRO_DEFAULT_DRIVER_FILTER_FREQ),
-	_gyro_filter_z(MPU6000_GYRO_DEFAULT_RATE, MPU6000_GYRO_DEFAULT_DRIVER_FILTER_FREQ),
+	_accel_filter(MPU6000_ACCEL_DEFAULT_RATE, MPU6000_ACCEL_DEFAULT_DRIVER_FILTER_FREQ),
+	_gyro_filter(MPU6000_GYRO_DEFAULT_RATE, MPU6000_GYRO_DEFAULT_DRIVER_FILTER_FREQ),
 	_rotation(rotation),
 	_checked_next(0),
 	_in_factory_test(false),
@@ -527,6 +603,9 @@ MPU6000::MPU6000(int bus, const char *path_accel, const char *path_gyro, spi_dev
 	// disable debug() calls
 	_debug_enabled = false;
 
+	// sample timing runs at full rate in interrupt context, use the cheap time source
+	perf_use_cycle_counter(_sample_perf);
+
 	_device_id.devid_s.devtype = DRV_ACC_DEVTYPE_MPU6000;
 
 	/* Prime _gyro with parents devid. */
@@ -576,6 +655,7 @@ MPU6000::~MPU6000()
 	perf_free(_bad_transfers);
 	perf_free(_bad_registers);
 	perf_free(_good_transfers);
+	perf_free(_fifo_resets);
 }
 
 int
@@ -630,6 +710,9 @@ MPU6000::init()
 
 	_accel_class_instance = register_class_devname(ACCEL_BASE_DEVICE_PATH);
 
+	/* give the chip time to queue a first sample into the FIFO */
+	usleep(1000000 / _sample_rate + 1000);
+
 	measure();
 
 	/* advertise sensor topic, measure manually to initialize valid report */
@@ -727,6 +810,15 @@ int MPU6000::reset()
 	write_checked_reg(MPUREG_INT_PIN_CFG, BIT_INT_ANYRD_2CLEAR); // INT: Clear on any read
 	usleep(1000);
 
+	// FIFO: queue accel, temperature and gyro data so that several
+	// samples can be fetched in one bus transaction
+	write_checked_reg(MPUREG_FIFO_EN, BIT_TEMP_FIFO_EN | BIT_XG_FIFO_EN |
+			  BIT_YG_FIFO_EN | BIT_ZG_FIFO_EN | BIT_ACCEL_FIFO_EN);
+	usleep(1000);
+
+	fifo_reset();
+	usleep(1000);
+
 	// Oscillator set
 	// write_reg(MPUREG_PWR_MGMT_1,MPU_CLK_SEL_PLLGYROZ);
 	usleep(1000);
@@ -734,6 +826,13 @@ int MPU6000::reset()
 	return OK;
 }
 
+void
+MPU6000::fifo_reset()
+{
+	write_reg(MPUREG_USER_CTRL, BIT_I2C_IF_DIS | BIT_FIFO_RESET);
+	write_checked_reg(MPUREG_USER_CTRL, BIT_I2C_IF_DIS | BIT_FIFO_ENABLE);
+}
+
 int
 MPU6000::probe()
 {
@@ -776,11 +875,14 @@ MPU6000::_set_sample_rate(unsigned desired_sample_rate_hz)
 		desired_sample_rate_hz = MPU6000_GYRO_DEFAULT_RATE;
 	}
 
-	uint8_t div = 1000 / desired_sample_rate_hz;
+	/* the divider counts off the 8kHz internal rate when the on-chip filter is disabled */
+	unsigned base_rate = (_dlpf_freq == 0) ? 8000 : 1000;
+
+	uint8_t div = base_rate / desired_sample_rate_hz;
 	if(div>200) div=200;
 	if(div<1) div=1;
 	write_checked_reg(MPUREG_SMPLRT_DIV, div-1);
-	_sample_rate = 1000 / div;
+	_sample_rate = base_rate / div;
 }
 
 /*
@@ -814,6 +916,10 @@ MPU6000::_set_dlpf_filter(uint16_t frequency_hz)
 		filter = BITS_DLPF_CFG_2100HZ_NOLPF;
 	}
 	write_checked_reg(MPUREG_CONFIG, filter);
+
+	/* the sample rate divider counts off a different base rate with the filter off */
+	_dlpf_freq = frequency_hz;
+	_set_sample_rate(_sample_rate);
 }
 
 ssize_t
@@ -837,15 +943,8 @@ MPU6000::read(struct file *filp, char *buffer, size_t buflen)
 
 	perf_count(_accel_reads);
 
-	/* copy reports out of our buffer to the caller */
-	accel_report *arp = reinterpret_cast<accel_report *>(buffer);
-	int transferred = 0;
-	while (count--) {
-		if (!_accel_reports->get(arp))
-			break;
-		transferred++;
-		arp++;
-	}
+	/* copy reports out of our buffer to the caller in one batch */
+	int transferred = _accel_reports->get_bulk(buffer, count);
 
 	/* return the number of bytes transferred */
 	return (transferred * sizeof(accel_report));
@@ -1124,15 +1223,8 @@ MPU6000::gyro_read(struct file *filp, char *buffer, size_t buflen)
 
 	perf_count(_gyro_reads);
 
-	/* copy reports out of our buffer to the caller */
-	gyro_report *grp = reinterpret_cast<gyro_report *>(buffer);
-	int transferred = 0;
-	while (count--) {
-		if (!_gyro_reports->get(grp))
-			break;
-		transferred++;
-		grp++;
-	}
+	/* copy reports out of our buffer to the caller in one batch */
+	int transferred = _gyro_reports->get_bulk(buffer, count);
 
 	/* return the number of bytes transferred */
 	return (transferred * sizeof(gyro_report));
@@ -1181,20 +1273,16 @@ MPU6000::ioctl(struct file *filp, int cmd, unsigned long arg)
 					if (ticks < 1000)
 						return -EINVAL;
 
-					// adjust filters
-					float cutoff_freq_hz = _accel_filter_x.get_cutoff_freq();
-					float sample_rate = 1.0e6f/ticks;
+					// adjust filters; they run at the chip sample
+					// rate, which the FIFO delivers in full
+					float cutoff_freq_hz = _accel_filter.get_cutoff_freq();
+					float sample_rate = _sample_rate;
 					_set_dlpf_filter(cutoff_freq_hz);
-					_accel_filter_x.set_cutoff_frequency(sample_rate, cutoff_freq_hz);
-					_accel_filter_y.set_cutoff_frequency(sample_rate, cutoff_freq_hz);
-					_accel_filter_z.set_cutoff_frequency(sample_rate, cutoff_freq_hz);
+					_accel_filter.set_cutoff_frequency(sample_rate, cutoff_freq_hz);
 
-
-					float cutoff_freq_hz_gyro = _gyro_filter_x.get_cutoff_freq();
+					float cutoff_freq_hz_gyro = _gyro_filter.get_cutoff_freq();
 					_set_dlpf_filter(cutoff_freq_hz_gyro);
-					_gyro_filter_x.set_cutoff_frequency(sample_rate, cutoff_freq_hz_gyro);
-					_gyro_filter_y.set_cutoff_frequency(sample_rate, cutoff_freq_hz_gyro);
-					_gyro_filter_z.set_cutoff_frequency(sample_rate, cutoff_freq_hz_gyro);
+					_gyro_filter.set_cutoff_frequency(sample_rate, cutoff_freq_hz_gyro);
 
 					/* update interval for next measurement */
 					/* XXX this is a bit shady, but no other way to adjust... */
@@ -1241,15 +1329,13 @@ MPU6000::ioctl(struct file *filp, int cmd, unsigned long arg)
 		return OK;
 
 	case ACCELIOCGLOWPASS:
-		return _accel_filter_x.get_cutoff_freq();
+		return _accel_filter.get_cutoff_freq();
 
 	case ACCELIOCSLOWPASS:
 		// set hardware filtering
 		_set_dlpf_filter(arg);
 		// set software filtering
-		_accel_filter_x.set_cutoff_frequency(1.0e6f / _call_interval, arg);
-		_accel_filter_y.set_cutoff_frequency(1.0e6f / _call_interval, arg);
-		_accel_filter_z.set_cutoff_frequency(1.0e6f / _call_interval, arg);
+		_accel_filter.set_cutoff_frequency(_sample_rate, arg);
 		return OK;
 
 	case ACCELIOCSSCALE:
@@ -1322,13 +1408,11 @@ MPU6000::gyro_ioctl(struct file *filp, int cmd, unsigned long arg)
 		return OK;
 
 	case GYROIOCGLOWPASS:
-		return _gyro_filter_x.get_cutoff_freq();
+		return _gyro_filter.get_cutoff_freq();
 	case GYROIOCSLOWPASS:
 		// set hardware filtering
 		_set_dlpf_filter(arg);
-		_gyro_filter_x.set_cutoff_frequency(1.0e6f / _call_interval, arg);
-		_gyro_filter_y.set_cutoff_frequency(1.0e6f / _call_interval, arg);
-		_gyro_filter_z.set_cutoff_frequency(1.0e6f / _call_interval, arg);
+		_gyro_filter.set_cutoff_frequency(_sample_rate, arg);
 		return OK;
 
 	case GYROIOCSSCALE:
@@ -1559,7 +1643,7 @@ MPU6000::measure()
 		return;
 	}
 
-	struct MPUReport mpu_report;
+	struct MPUFifoReport mpu_fifo;
 	struct Report {
 		int16_t		accel_x;
 		int16_t		accel_y;
@@ -1573,183 +1657,226 @@ MPU6000::measure()
 	/* start measuring */
 	perf_begin(_sample_perf);
 
-	/*
-	 * Fetch the full set of measurements from the MPU6000 in one pass.
-	 */
-	mpu_report.cmd = DIR_READ | MPUREG_INT_STATUS;
-
 	check_registers();
 
         // sensor transfer at high clock speed
         set_frequency(MPU6000_HIGH_BUS_SPEED);
 
-	if (OK != transfer((uint8_t *)&mpu_report, ((uint8_t *)&mpu_report), sizeof(mpu_report)))
-		return;
-
 	/*
-	 * Convert from big to little endian
+	 * See how much data is waiting in the FIFO.
 	 */
+	uint8_t cmd[3] = { DIR_READ | MPUREG_FIFO_COUNTH, 0, 0 };
 
-	report.accel_x = int16_t_from_bytes(mpu_report.accel_x);
-	report.accel_y = int16_t_from_bytes(mpu_report.accel_y);
-	report.accel_z = int16_t_from_bytes(mpu_report.accel_z);
-
-	report.temp = int16_t_from_bytes(mpu_report.temp);
-
-	report.gyro_x = int16_t_from_bytes(mpu_report.gyro_x);
-	report.gyro_y = int16_t_from_bytes(mpu_report.gyro_y);
-	report.gyro_z = int16_t_from_bytes(mpu_report.gyro_z);
-
-	if (report.accel_x == 0 &&
-	    report.accel_y == 0 &&
-	    report.accel_z == 0 &&
-	    report.temp == 0 &&
-	    report.gyro_x == 0 &&
-	    report.gyro_y == 0 &&
-	    report.gyro_z == 0) {
-		// all zero data - probably a SPI bus error
-		perf_count(_bad_transfers);
+	if (OK != transfer(cmd, cmd, sizeof(cmd))) {
 		perf_end(_sample_perf);
-                // note that we don't call reset() here as a reset()
-                // costs 20ms with interrupts disabled. That means if
-                // the mpu6k does go bad it would cause a FMU failure,
-                // regardless of whether another sensor is available,
 		return;
 	}
 
-	perf_count(_good_transfers);
+	unsigned fifo_count = (cmd[1] << 8) | cmd[2];
+	unsigned records = fifo_count / sizeof(struct MPUFifoRecord);
 
-	if (_register_wait != 0) {
-		// we are waiting for some good transfers before using
-		// the sensor again. We still increment
-		// _good_transfers, but don't return any data yet
-		_register_wait--;
+	if (fifo_count > MPU6000_FIFO_SIZE - sizeof(struct MPUFifoRecord)) {
+		/* the FIFO has overflowed and record alignment is lost - start over */
+		perf_count(_fifo_resets);
+		fifo_reset();
+		perf_end(_sample_perf);
 		return;
 	}
 
+	if (records == 0) {
+		/* no complete record queued yet */
+		perf_end(_sample_perf);
+		return;
+	}
 
-	/*
-	 * Swap axes and negate y
-	 */
-	int16_t accel_xt = report.accel_y;
-	int16_t accel_yt = ((report.accel_x == -32768) ? 32767 : -report.accel_x);
-
-	int16_t gyro_xt = report.gyro_y;
-	int16_t gyro_yt = ((report.gyro_x == -32768) ? 32767 : -report.gyro_x);
+	/* anything we cannot carry stays queued for the next drain */
+	if (records > MPU6000_FIFO_MAX_RECORDS)
+		records = MPU6000_FIFO_MAX_RECORDS;
 
 	/*
-	 * Apply the swap
+	 * Fetch all complete records from the MPU6000 in one pass.
 	 */
-	report.accel_x = accel_xt;
-	report.accel_y = accel_yt;
-	report.gyro_x = gyro_xt;
-	report.gyro_y = gyro_yt;
+	mpu_fifo.cmd = DIR_READ | MPUREG_FIFO_R_W;
+
+	if (OK != transfer((uint8_t *)&mpu_fifo, ((uint8_t *)&mpu_fifo), 1 + records * sizeof(struct MPUFifoRecord))) {
+		perf_end(_sample_perf);
+		return;
+	}
 
 	/*
 	 * Report buffers.
 	 */
 	accel_report		arb;
 	gyro_report		grb;
+	bool			got_data = false;
 
-	/*
-	 * Adjust and scale results to m/s^2.
-	 */
-	grb.timestamp = arb.timestamp = hrt_absolute_time();
+	for (unsigned r = 0; r < records; r++) {
+		const struct MPUFifoRecord &rec = mpu_fifo.records[r];
 
-	// report the error count as the sum of the number of bad
-	// transfers and bad register reads. This allows the higher
-	// level code to decide if it should use this sensor based on
-	// whether it has had failures
-        grb.error_count = arb.error_count = perf_event_count(_bad_transfers) + perf_event_count(_bad_registers);
+		/*
+		 * Convert from big to little endian
+		 */
 
-	/*
-	 * 1) Scale raw value to SI units using scaling from datasheet.
-	 * 2) Subtract static offset (in SI units)
-	 * 3) Scale the statically calibrated values with a linear
-	 *    dynamically obtained factor
-	 *
-	 * Note: the static sensor offset is the number the sensor outputs
-	 * 	 at a nominally 'zero' input. Therefore the offset has to
-	 * 	 be subtracted.
-	 *
-	 *	 Example: A gyro outputs a value of 74 at zero angular rate
-	 *	 	  the offset is 74 from the origin and subtracting
-	 *		  74 from all measurements centers them around zero.
-	 */
+		report.accel_x = int16_t_from_bytes(rec.accel_x);
+		report.accel_y = int16_t_from_bytes(rec.accel_y);
+		report.accel_z = int16_t_from_bytes(rec.accel_z);
+
+		report.temp = int16_t_from_bytes(rec.temp);
+
+		report.gyro_x = int16_t_from_bytes(rec.gyro_x);
+		report.gyro_y = int16_t_from_bytes(rec.gyro_y);
+		report.gyro_z = int16_t_from_bytes(rec.gyro_z);
+
+		if (report.accel_x == 0 &&
+		    report.accel_y == 0 &&
+		    report.accel_z == 0 &&
+		    report.temp == 0 &&
+		    report.gyro_x == 0 &&
+		    report.gyro_y == 0 &&
+		    report.gyro_z == 0) {
+			// all zero data - probably a SPI bus error
+			perf_count(_bad_transfers);
+	                // note that we don't call reset() here as a reset()
+	                // costs 20ms with interrupts disabled. That means if
+	                // the mpu6k does go bad it would cause a FMU failure,
+	                // regardless of whether another sensor is available,
+			continue;
+		}
 
+		perf_count(_good_transfers);
 
-	/* NOTE: Axes have been swapped to match the board a few lines above. */
+		if (_register_wait != 0) {
+			// we are waiting for some good transfers before using
+			// the sensor again. We still increment
+			// _good_transfers, but don't return any data yet
+			_register_wait--;
+			continue;
+		}
 
-	arb.x_raw = report.accel_x;
-	arb.y_raw = report.accel_y;
-	arb.z_raw = report.accel_z;
+		/*
+		 * Swap axes and negate y
+		 */
+		int16_t accel_xt = report.accel_y;
+		int16_t accel_yt = ((report.accel_x == -32768) ? 32767 : -report.accel_x);
 
-	float xraw_f = report.accel_x;
-	float yraw_f = report.accel_y;
-	float zraw_f = report.accel_z;
+		int16_t gyro_xt = report.gyro_y;
+		int16_t gyro_yt = ((report.gyro_x == -32768) ? 32767 : -report.gyro_x);
 
-	// apply user specified rotation
-	rotate_3f(_rotation, xraw_f, yraw_f, zraw_f);
+		/*
+		 * Apply the swap
+		 */
+		report.accel_x = accel_xt;
+		report.accel_y = accel_yt;
+		report.gyro_x = gyro_xt;
+		report.gyro_y = gyro_yt;
 
-	float x_in_new = ((xraw_f * _accel_range_scale) - _accel_scale.x_offset) * _accel_scale.x_scale;
-	float y_in_new = ((yraw_f * _accel_range_scale) - _accel_scale.y_offset) * _accel_scale.y_scale;
-	float z_in_new = ((zraw_f * _accel_range_scale) - _accel_scale.z_offset) * _accel_scale.z_scale;
+		/*
+		 * Adjust and scale results to m/s^2; samples that have been
+		 * waiting in the FIFO are back-dated by the sample interval.
+		 */
+		grb.timestamp = arb.timestamp = hrt_absolute_time() -
+			((records - 1 - r) * (1000000 / _sample_rate));
 
-	arb.x = _accel_filter_x.apply(x_in_new);
-	arb.y = _accel_filter_y.apply(y_in_new);
-	arb.z = _accel_filter_z.apply(z_in_new);
+		// report the error count as the sum of the number of bad
+		// transfers and bad register reads. This allows the higher
+		// level code to decide if it should use this sensor based on
+		// whether it has had failures
+	        grb.error_count = arb.error_count = perf_event_count(_bad_transfers) + perf_event_count(_bad_registers);
 
-	arb.scaling = _accel_range_scale;
-	arb.range_m_s2 = _accel_range_m_s2;
+		/*
+		 * 1) Scale raw value to SI units using scaling from datasheet.
+		 * 2) Subtract static offset (in SI units)
+		 * 3) Scale the statically calibrated values with a linear
+		 *    dynamically obtained factor
+		 *
+		 * Note: the static sensor offset is the number the sensor outputs
+		 * 	 at a nominally 'zero' input. Therefore the offset has to
+		 * 	 be subtracted.
+		 *
+		 *	 Example: A gyro outputs a value of 74 at zero angular rate
+		 *	 	  the offset is 74 from the origin and subtracting
+		 *		  74 from all measurements centers them around zero.
+		 */
 
-	_last_temperature = (report.temp) / 361.0f + 35.0f;
 
-	arb.temperature_raw = report.temp;
-	arb.temperature = _last_temperature;
+		/* NOTE: Axes have been swapped to match the board a few lines above. */
 
-	grb.x_raw = report.gyro_x;
-	grb.y_raw = report.gyro_y;
-	grb.z_raw = report.gyro_z;
+		arb.x_raw = report.accel_x;
+		arb.y_raw = report.accel_y;
+		arb.z_raw = report.accel_z;
 
-	xraw_f = report.gyro_x;
-	yraw_f = report.gyro_y;
-	zraw_f = report.gyro_z;
+		float xraw_f = report.accel_x;
+		float yraw_f = report.accel_y;
+		float zraw_f = report.accel_z;
 
-	// apply user specified rotation
-	rotate_3f(_rotation, xraw_f, yraw_f, zraw_f);
+		// apply user specified rotation
+		rotate_3f(_rotation, xraw_f, yraw_f, zraw_f);
 
-	float x_gyro_in_new = ((xraw_f * _gyro_range_scale) - _gyro_scale.x_offset) * _gyro_scale.x_scale;
-	float y_gyro_in_new = ((yraw_f * _gyro_range_scale) - _gyro_scale.y_offset) * _gyro_scale.y_scale;
-	float z_gyro_in_new = ((zraw_f * _gyro_range_scale) - _gyro_scale.z_offset) * _gyro_scale.z_scale;
+		float x_in_new = ((xraw_f * _accel_range_scale) - _accel_scale.x_offset) * _accel_scale.x_scale;
+		float y_in_new = ((yraw_f * _accel_range_scale) - _accel_scale.y_offset) * _accel_scale.y_scale;
+		float z_in_new = ((zraw_f * _accel_range_scale) - _accel_scale.z_offset) * _accel_scale.z_scale;
 
-	grb.x = _gyro_filter_x.apply(x_gyro_in_new);
-	grb.y = _gyro_filter_y.apply(y_gyro_in_new);
-	grb.z = _gyro_filter_z.apply(z_gyro_in_new);
+		math::Vector<3> aval_filt = _accel_filter.apply(math::Vector<3>(x_in_new, y_in_new, z_in_new));
+		arb.x = aval_filt(0);
+		arb.y = aval_filt(1);
+		arb.z = aval_filt(2);
 
-	grb.scaling = _gyro_range_scale;
-	grb.range_rad_s = _gyro_range_rad_s;
+		arb.scaling = _accel_range_scale;
+		arb.range_m_s2 = _accel_range_m_s2;
 
-	grb.temperature_raw = report.temp;
-	grb.temperature = _last_temperature;
+		_last_temperature = (report.temp) / 361.0f + 35.0f;
 
-	_accel_reports->force(&arb);
-	_gyro_reports->force(&grb);
+		arb.temperature_raw = report.temp;
+		arb.temperature = _last_temperature;
 
-	/* notify anyone waiting for data */
-	poll_notify(POLLIN);
-	_gyro->parent_poll_notify();
-
-	if (!(_pub_blocked)) {
-		/* log the time of this report */
-		perf_begin(_controller_latency_perf);
-		perf_begin(_system_latency_perf);
-		/* publish it */
-		orb_publish(ORB_ID(sensor_accel), _accel_topic, &arb);
+		grb.x_raw = report.gyro_x;
+		grb.y_raw = report.gyro_y;
+		grb.z_raw = report.gyro_z;
+
+		xraw_f = report.gyro_x;
+		yraw_f = report.gyro_y;
+		zraw_f = report.gyro_z;
+
+		// apply user specified rotation
+		rotate_3f(_rotation, xraw_f, yraw_f, zraw_f);
+
+		float x_gyro_in_new = ((xraw_f * _gyro_range_scale) - _gyro_scale.x_offset) * _gyro_scale.x_scale;
+		float y_gyro_in_new = ((yraw_f * _gyro_range_scale) - _gyro_scale.y_offset) * _gyro_scale.y_scale;
+		float z_gyro_in_new = ((zraw_f * _gyro_range_scale) - _gyro_scale.z_offset) * _gyro_scale.z_scale;
+
+		math::Vector<3> gval_filt = _gyro_filter.apply(math::Vector<3>(x_gyro_in_new, y_gyro_in_new, z_gyro_in_new));
+		grb.x = gval_filt(0);
+		grb.y = gval_filt(1);
+		grb.z = gval_filt(2);
+
+		grb.scaling = _gyro_range_scale;
+		grb.range_rad_s = _gyro_range_rad_s;
+
+		grb.temperature_raw = report.temp;
+		grb.temperature = _last_temperature;
+
+		_accel_reports->force(&arb);
+		_gyro_reports->force(&grb);
+		got_data = true;
 	}
 
-	if (!(_pub_blocked)) {
-		/* publish it */
-		orb_publish(ORB_ID(sensor_gyro), _gyro->_gyro_topic, &grb);
+	/* notify anyone waiting for data and publish the newest sample */
+	if (got_data) {
+		poll_notify(POLLIN);
+		_gyro->parent_poll_notify();
+
+		if (!(_pub_blocked)) {
+			/* log the time of this report */
+			perf_begin(_controller_latency_perf);
+			perf_begin(_system_latency_perf);
+			/* publish it */
+			orb_publish(ORB_ID(sensor_accel), _accel_topic, &arb);
+		}
+
+		if (!(_pub_blocked)) {
+			/* publish it */
+			orb_publish(ORB_ID(sensor_gyro), _gyro->_gyro_topic, &grb);
+		}
 	}
 
 	/* stop measuring */
@@ -1766,6 +1893,7 @@ MPU6000::print_info()
 	perf_print_counter(_bad_registers);
 	perf_print_counter(_good_transfers);
 	perf_print_counter(_reset_retries);
+	perf_print_counter(_fifo_resets);
 	_accel_reports->print_info("accel queue");
 	_gyro_reports->print_info("gyro queue");
         ::printf("checked_next: %u\n", _checked_next);
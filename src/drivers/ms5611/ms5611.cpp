@@ -66,6 +66,7 @@
 
 #include <systemlib/perf_counter.h>
 #include <systemlib/err.h>
+#include <systemlib/px4_work.h>
 
 #include "ms5611.h"
 
@@ -99,7 +100,14 @@ static const int ERROR = -1;
 
 /* internal conversion time: 9.17 ms, so should not be read at rates higher than 100 Hz */
 #define MS5611_CONVERSION_INTERVAL	10000	/* microseconds */
-#define MS5611_MEASUREMENT_RATIO	3	/* pressure measurements per temperature measurement */
+
+/*
+ * Pressure measurements per temperature measurement. The die temperature
+ * moves on a time constant of seconds, so refreshing the compensation
+ * values at ~6 Hz is ample and leaves nearly every conversion slot free
+ * for pressure.
+ */
+#define MS5611_MEASUREMENT_RATIO	15
 #define MS5611_BARO_DEVICE_PATH_EXT	"/dev/ms5611_ext"
 #define MS5611_BARO_DEVICE_PATH_INT	"/dev/ms5611_int"
 
@@ -203,8 +211,12 @@ protected:
 
 	/**
 	 * Collect the result of the most recent measurement.
+	 *
+	 * @param start_next	If true, the next conversion is started as soon
+	 *			as the ADC result has been read back, so the
+	 *			sensor converts while we crunch the numbers.
 	 */
-	virtual int		collect();
+	virtual int		collect(bool start_next);
 };
 
 /*
@@ -295,7 +307,7 @@ MS5611::init()
 
 		usleep(MS5611_CONVERSION_INTERVAL);
 
-		if (OK != collect()) {
+		if (OK != collect(false)) {
 			ret = -EIO;
 			break;
 		}
@@ -308,7 +320,7 @@ MS5611::init()
 
 		usleep(MS5611_CONVERSION_INTERVAL);
 
-		if (OK != collect()) {
+		if (OK != collect(false)) {
 			ret = -EIO;
 			break;
 		}
@@ -347,16 +359,12 @@ MS5611::read(struct file *filp, char *buffer, size_t buflen)
 	if (_measure_ticks > 0) {
 
 		/*
-		 * While there is space in the caller's buffer, and reports, copy them.
-		 * Note that we may be pre-empted by the workq thread while we are doing this;
-		 * we are careful to avoid racing with them.
+		 * Copy as many reports as the caller's buffer has space for
+		 * in one batch. Note that we may be pre-empted by the workq
+		 * thread while we are doing this; the bulk get is careful to
+		 * avoid racing with it.
 		 */
-		while (count--) {
-			if (_reports->get(brp)) {
-				ret += sizeof(*brp);
-				brp++;
-			}
-		}
+		ret = _reports->get_bulk(brp, count) * sizeof(*brp);
 
 		/* if there was no data, warn the caller */
 		return ret ? ret : -EAGAIN;
@@ -375,7 +383,7 @@ MS5611::read(struct file *filp, char *buffer, size_t buflen)
 
 		usleep(MS5611_CONVERSION_INTERVAL);
 
-		if (OK != collect()) {
+		if (OK != collect(false)) {
 			ret = -EIO;
 			break;
 		}
@@ -388,7 +396,7 @@ MS5611::read(struct file *filp, char *buffer, size_t buflen)
 
 		usleep(MS5611_CONVERSION_INTERVAL);
 
-		if (OK != collect()) {
+		if (OK != collect(false)) {
 			ret = -EIO;
 			break;
 		}
@@ -524,13 +532,13 @@ MS5611::start_cycle()
 	_reports->flush();
 
 	/* schedule a cycle to start things */
-	work_queue(HPWORK, &_work, (worker_t)&MS5611::cycle_trampoline, this, 1);
+	px4_work_queue(PX4_WORK_SENSOR, &_work, (worker_t)&MS5611::cycle_trampoline, this, 1);
 }
 
 void
 MS5611::stop_cycle()
 {
-	work_cancel(HPWORK, &_work);
+	px4_work_cancel(PX4_WORK_SENSOR, &_work);
 }
 
 void
@@ -550,8 +558,21 @@ MS5611::cycle()
 	/* collection phase? */
 	if (_collect_phase) {
 
-		/* perform collection */
-		ret = collect();
+		/*
+		 * Is there a collect->measure gap?
+		 * Don't inject one ahead of temperature measurements, so we can keep
+		 * doing pressure measurements at something close to the desired rate.
+		 */
+		unsigned next_phase = (_measure_phase >= MS5611_MEASUREMENT_RATIO) ? 0 : _measure_phase + 1;
+		bool gap = (next_phase != 0) &&
+			   (_measure_ticks > USEC2TICK(MS5611_CONVERSION_INTERVAL));
+
+		/*
+		 * Perform collection; unless a gap is wanted, this also starts
+		 * the next conversion before the number crunching so the sensor
+		 * is never left idle.
+		 */
+		ret = collect(!gap);
 		if (ret != OK) {
 			if (ret == -6) {
 				/*
@@ -569,19 +590,12 @@ MS5611::cycle()
 			return;
 		}
 
-		/* next phase is measurement */
-		_collect_phase = false;
-
-		/*
-		 * Is there a collect->measure gap?
-		 * Don't inject one after temperature measurements, so we can keep
-		 * doing pressure measurements at something close to the desired rate.
-		 */
-		if ((_measure_phase != 0) &&
-		    (_measure_ticks > USEC2TICK(MS5611_CONVERSION_INTERVAL))) {
+		if (gap) {
+			/* next phase is measurement */
+			_collect_phase = false;
 
 			/* schedule a fresh cycle call when we are ready to measure again */
-			work_queue(HPWORK,
+			px4_work_queue(PX4_WORK_SENSOR,
 				   &_work,
 				   (worker_t)&MS5611::cycle_trampoline,
 				   this,
@@ -589,6 +603,15 @@ MS5611::cycle()
 
 			return;
 		}
+
+		/* the next conversion is already running; collect it when it is done */
+		px4_work_queue(PX4_WORK_SENSOR,
+			   &_work,
+			   (worker_t)&MS5611::cycle_trampoline,
+			   this,
+			   USEC2TICK(MS5611_CONVERSION_INTERVAL));
+
+		return;
 	}
 
 	/* measurement phase */
@@ -606,7 +629,7 @@ MS5611::cycle()
 	_collect_phase = true;
 
 	/* schedule a fresh cycle call when the measurement is done */
-	work_queue(HPWORK,
+	px4_work_queue(PX4_WORK_SENSOR,
 		   &_work,
 		   (worker_t)&MS5611::cycle_trampoline,
 		   this,
@@ -638,7 +661,7 @@ MS5611::measure()
 }
 
 int
-MS5611::collect()
+MS5611::collect(bool start_next)
 {
 	int ret;
 	uint32_t raw;
@@ -658,8 +681,25 @@ MS5611::collect()
 		return ret;
 	}
 
+	/* remember which phase this result belongs to and advance the state machine */
+	unsigned phase = _measure_phase;
+	INCREMENT(_measure_phase, MS5611_MEASUREMENT_RATIO + 1);
+
+	/*
+	 * Kick off the next conversion before crunching the numbers, so the
+	 * sensor converts while we compute and the conversion dead time is
+	 * hidden behind the floating point work below.
+	 */
+	if (start_next) {
+		ret = measure();
+		if (ret != OK) {
+			perf_end(_sample_perf);
+			return ret;
+		}
+	}
+
 	/* handle a measurement */
-	if (_measure_phase == 0) {
+	if (phase == 0) {
 
 		/* temperature offset (in ADC units) */
 		int32_t dT = (int32_t)raw - ((int32_t)_prom.c5_reference_temp << 8);
@@ -753,9 +793,6 @@ MS5611::collect()
 		poll_notify(POLLIN);
 	}
 
-	/* update the measurement state machine */
-	INCREMENT(_measure_phase, MS5611_MEASUREMENT_RATIO + 1);
-
 	perf_end(_sample_perf);
 
 	return OK;
@@ -67,6 +67,7 @@
 #include <drivers/drv_hrt.h>
 #include <drivers/drv_px4flow.h>
 #include <drivers/device/ringbuffer.h>
+#include <drivers/device/i2c_scheduler.h>
 
 #include <uORB/uORB.h>
 #include <uORB/topics/subsystem_info.h>
@@ -83,6 +84,8 @@
 #define PX4FLOW_CONVERSION_INTERVAL	100000	///< in microseconds! 20000 = 50 Hz 100000 = 10Hz
 #define PX4FLOW_I2C_MAX_BUS_SPEED	400000	///< 400 KHz maximum speed
 
+#define PX4FLOW_INTEGRATION_WINDOW	100000	///< default publication interval, matches the 10 Hz estimator consumption
+
 /* oddly, ERROR is not defined for c++ */
 #ifdef ERROR
 # undef ERROR
@@ -119,7 +122,6 @@ protected:
 
 private:
 
-	work_s				_work;
 	RingBuffer			*_reports;
 	bool				_sensor_ok;
 	int					_measure_ticks;
@@ -132,6 +134,26 @@ private:
 	
 	enum Rotation				_sensor_rotation;
 
+	/* integration window for decimated publication; the driver keeps
+	 * accumulating frames at the collect rate and publishes the sums
+	 * once per window */
+	uint64_t			_publish_interval;
+	hrt_abstime			_last_publish;
+	float				_accum_flow_x;
+	float				_accum_flow_y;
+	float				_accum_gyro_x;
+	float				_accum_gyro_y;
+	float				_accum_gyro_z;
+	uint32_t			_accum_timespan;
+	uint16_t			_accum_frame_count;
+	uint32_t			_accum_quality;
+	unsigned			_accum_samples;
+
+	/**
+	 * Reset the integration window accumulators.
+	 */
+	void				reset_accumulation();
+
 	/**
 	 * Test whether the device supported by the driver is present at a
 	 * specific address.
@@ -186,13 +208,22 @@ PX4FLOW::PX4FLOW(int bus, int address, enum Rotation rotation) :
 	_sample_perf(perf_alloc(PC_ELAPSED, "px4flow_read")),
 	_comms_errors(perf_alloc(PC_COUNT, "px4flow_comms_errors")),
 	_buffer_overflows(perf_alloc(PC_COUNT, "px4flow_buffer_overflows")),
-	_sensor_rotation(rotation)
+	_sensor_rotation(rotation),
+	_publish_interval(PX4FLOW_INTEGRATION_WINDOW),
+	_last_publish(0),
+	_accum_flow_x(0.0f),
+	_accum_flow_y(0.0f),
+	_accum_gyro_x(0.0f),
+	_accum_gyro_y(0.0f),
+	_accum_gyro_z(0.0f),
+	_accum_timespan(0),
+	_accum_frame_count(0),
+	_accum_quality(0),
+	_accum_samples(0)
 {
 	// enable debug() calls
 	_debug_enabled = false;
 
-	// work_cancel in the dtor will explode if we don't do this...
-	memset(&_work, 0, sizeof(_work));
 }
 
 PX4FLOW::~PX4FLOW()
@@ -346,6 +377,15 @@ PX4FLOW::ioctl(struct file *filp, int cmd, unsigned long arg)
 	case SENSORIOCGROTATION:
 		return _sensor_rotation;
 
+	case PX4FLOWIOCSINTWINDOW:
+		/* zero publishes every collected frame */
+		_publish_interval = arg;
+		reset_accumulation();
+		return OK;
+
+	case PX4FLOWIOCGINTWINDOW:
+		return _publish_interval;
+
 	case SENSORIOCRESET:
 		/* XXX implement this */
 		return -EINVAL;
@@ -489,30 +529,82 @@ PX4FLOW::collect()
 	
 	/* rotate measurements according to parameter */
 	float zeroval = 0.0f;
-	rotate_3f(_sensor_rotation, report.pixel_flow_x_integral, report.pixel_flow_y_integral, zeroval); 
+	rotate_3f(_sensor_rotation, report.pixel_flow_x_integral, report.pixel_flow_y_integral, zeroval);
+
+	/* accumulate the integration window; the sensor integrates between
+	 * readouts, so successive frames sum to the window integral */
+	_accum_flow_x += report.pixel_flow_x_integral;
+	_accum_flow_y += report.pixel_flow_y_integral;
+	_accum_gyro_x += report.gyro_x_rate_integral;
+	_accum_gyro_y += report.gyro_y_rate_integral;
+	_accum_gyro_z += report.gyro_z_rate_integral;
+	_accum_timespan += f_integral.integration_timespan;
+	_accum_frame_count += f_integral.frame_count_since_last_readout;
+	_accum_quality += f_integral.qual;
+	_accum_samples++;
+
+	/* publish once per window; compare with half a collect cycle of slack
+	 * so that scheduling jitter cannot stretch the window by a full cycle */
+	uint64_t half_cycle = TICK2USEC((uint64_t)_measure_ticks) / 2;
+
+	if ((_publish_interval == 0) ||
+	    (hrt_elapsed_time(&_last_publish) + half_cycle >= _publish_interval)) {
+
+		/* replace the single-frame integrals with the window sums;
+		 * scalar state (ground distance, sonar age, temperature) is
+		 * already the latest frame's */
+		report.pixel_flow_x_integral = _accum_flow_x;
+		report.pixel_flow_y_integral = _accum_flow_y;
+		report.gyro_x_rate_integral = _accum_gyro_x;
+		report.gyro_y_rate_integral = _accum_gyro_y;
+		report.gyro_z_rate_integral = _accum_gyro_z;
+		report.integration_timespan = _accum_timespan;
+		report.frame_count_since_last_readout = _accum_frame_count;
+		report.quality = _accum_quality / _accum_samples;
+
+		if (_px4flow_topic < 0) {
+			/* lock-free: we are the only publisher, we publish at a high
+			 * rate, and the double-buffered node lets subscribers read
+			 * the sample in place via orb_acquire() */
+			_px4flow_topic = orb_advertise_lockfree(ORB_ID(optical_flow), &report);
+
+		} else {
+			/* publish it */
+			orb_publish(ORB_ID(optical_flow), _px4flow_topic, &report);
+		}
 
-	if (_px4flow_topic < 0) {
-		_px4flow_topic = orb_advertise(ORB_ID(optical_flow), &report);
+		/* post a report to the ring */
+		if (_reports->force(&report)) {
+			perf_count(_buffer_overflows);
+		}
 
-	} else {
-		/* publish it */
-		orb_publish(ORB_ID(optical_flow), _px4flow_topic, &report);
-	}
+		/* notify anyone waiting for data */
+		poll_notify(POLLIN);
 
-	/* post a report to the ring */
-	if (_reports->force(&report)) {
-		perf_count(_buffer_overflows);
+		_last_publish = report.timestamp;
+		reset_accumulation();
 	}
 
-	/* notify anyone waiting for data */
-	poll_notify(POLLIN);
-
 	ret = OK;
 
 	perf_end(_sample_perf);
 	return ret;
 }
 
+void
+PX4FLOW::reset_accumulation()
+{
+	_accum_flow_x = 0.0f;
+	_accum_flow_y = 0.0f;
+	_accum_gyro_x = 0.0f;
+	_accum_gyro_y = 0.0f;
+	_accum_gyro_z = 0.0f;
+	_accum_timespan = 0;
+	_accum_frame_count = 0;
+	_accum_quality = 0;
+	_accum_samples = 0;
+}
+
 void
 PX4FLOW::start()
 {
@@ -520,8 +612,12 @@ PX4FLOW::start()
 	_collect_phase = false;
 	_reports->flush();
 
+	/* restart the integration window; the first frame publishes immediately */
+	_last_publish = 0;
+	reset_accumulation();
+
 	/* schedule a cycle to start things */
-	work_queue(HPWORK, &_work, (worker_t)&PX4FLOW::cycle_trampoline, this, 1);
+	device::I2CScheduler::schedule(_bus, (worker_t)&PX4FLOW::cycle_trampoline, this, 1);
 
 	/* notify about state change */
 	struct subsystem_info_s info = {
@@ -543,7 +639,7 @@ PX4FLOW::start()
 void
 PX4FLOW::stop()
 {
-	work_cancel(HPWORK, &_work);
+	device::I2CScheduler::cancel((worker_t)&PX4FLOW::cycle_trampoline, this);
 }
 
 void
@@ -569,8 +665,7 @@ PX4FLOW::cycle()
 		return;
 	}
 
-	work_queue(HPWORK, &_work, (worker_t)&PX4FLOW::cycle_trampoline, this,
-		   _measure_ticks);
+	device::I2CScheduler::schedule(_bus, (worker_t)&PX4FLOW::cycle_trampoline, this, _measure_ticks);
 
 }
 
@@ -581,6 +676,7 @@ PX4FLOW::print_info()
 	perf_print_counter(_comms_errors);
 	perf_print_counter(_buffer_overflows);
 	printf("poll interval:  %u ticks\n", _measure_ticks);
+	printf("integration window: %u us\n", (unsigned)_publish_interval);
 	_reports->print_info("report queue");
 }
 
@@ -67,6 +67,7 @@
 #include <systemlib/mixer/mixer.h>
 #include <systemlib/pwm_limit/pwm_limit.h>
 #include <systemlib/board_serial.h>
+#include <systemlib/trace.h>
 #include <drivers/drv_mixer.h>
 #include <drivers/drv_rc_input.h>
 
@@ -129,6 +130,7 @@ private:
 	unsigned	_pwm_default_rate;
 	unsigned	_pwm_alt_rate;
 	uint32_t	_pwm_alt_rate_channels;
+	bool		_oneshot_mode;
 	unsigned	_current_update_rate;
 	int		_task;
 	int		_armed_sub;
@@ -250,6 +252,7 @@ PX4FMU::PX4FMU() :
 	_pwm_default_rate(50),
 	_pwm_alt_rate(50),
 	_pwm_alt_rate_channels(0),
+	_oneshot_mode(false),
 	_current_update_rate(0),
 	_task(-1),
 	_armed_sub(-1),
@@ -586,6 +589,12 @@ PX4FMU::task_main()
 		 */
 		unsigned max_rate = (_pwm_default_rate > _pwm_alt_rate) ? _pwm_default_rate : _pwm_alt_rate;
 
+		if (_oneshot_mode) {
+			/* one pulse per control update, follow the control
+			 * rate all the way to the 500 Hz cap below */
+			max_rate = 500;
+		}
+
 		if (_current_update_rate != max_rate) {
 			_current_update_rate = max_rate;
 			int update_rate_in_ms = int(1000 / _current_update_rate);
@@ -686,11 +695,17 @@ PX4FMU::task_main()
 				/* the PWM limit call takes care of out of band errors and constrains */
 				pwm_limit_calc(_servo_armed, num_outputs, _disarmed_pwm, _min_pwm, _max_pwm, outputs.output, pwm_limited, &_pwm_limit);
 
-				/* output to the servos */
-				for (unsigned i = 0; i < num_outputs; i++) {
-					up_pwm_servo_set(i, pwm_limited[i]);
+				/* output to the servos, latching all channels in one update event */
+				up_pwm_servo_set_multi(pwm_limited, num_outputs);
+
+				/* in OneShot mode fire the pulses now, synchronized to
+				 * mixer completion, instead of at the next PWM frame */
+				if (_oneshot_mode) {
+					up_pwm_servo_trigger();
 				}
 
+				TRACE(TRACE_EV_MIXER_OUT, pwm_limited[0]);
+
 				/* publish mixed control outputs */
 				if (_outputs_pub < 0) {
 					_outputs_pub = orb_advertise_multi(ORB_ID(actuator_outputs), &outputs, &_actuator_output_topic_instance, ORB_PRIO_DEFAULT);
@@ -873,6 +888,21 @@ PX4FMU::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 		*(uint32_t *)arg = _pwm_alt_rate_channels;
 		break;
 
+	case PWM_SERVO_SET_ONESHOT:
+		ret = up_pwm_servo_set_oneshot_mode(arg != 0);
+
+		if (ret == OK) {
+			_oneshot_mode = (arg != 0);
+			/* force the actuator update interval to be re-evaluated */
+			_current_update_rate = 0;
+		}
+
+		break;
+
+	case PWM_SERVO_GET_ONESHOT:
+		*(uint32_t *)arg = _oneshot_mode;
+		break;
+
 	case PWM_SERVO_SET_FAILSAFE_PWM: {
 			struct pwm_output_values *pwm = (struct pwm_output_values *)arg;
 
@@ -1253,6 +1283,35 @@ PX4FMU::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 			break;
 		}
 
+	case MIXERIOCLOADBUFBIN: {
+			const struct mixer_binary_buf_s *bbuf = (const struct mixer_binary_buf_s *)arg;
+
+			if (_mixers == nullptr)
+				_mixers = new MixerGroup(control_callback, (uintptr_t)_controls);
+
+			if (_mixers == nullptr) {
+				_groups_required = 0;
+				ret = -ENOMEM;
+
+			} else {
+
+				ret = _mixers->load_from_binary(bbuf->buf, bbuf->buflen);
+
+				if (ret != 0) {
+					debug("binary mixer load failed with %d", ret);
+					delete _mixers;
+					_mixers = nullptr;
+					_groups_required = 0;
+					ret = -EINVAL;
+				} else {
+
+					_mixers->groups_required(_groups_required);
+				}
+			}
+
+			break;
+		}
+
 	default:
 		ret = -ENOTTY;
 		break;
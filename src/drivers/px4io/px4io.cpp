@@ -273,6 +273,12 @@ private:
 	uint16_t		_status;		///< Various IO status flags
 	uint16_t		_alarms;		///< Various IO alarms
 
+	/* register shadow, refreshed by one bulk transfer per poll cycle */
+	uint16_t		_snapshot_regs[PX4IO_P_SNAPSHOT_RC_BASE + PX4IO_P_RAW_RC_BASE + PX4IO_SNAPSHOT_RC_CHANNELS];
+	bool			_snapshot_valid;	///< shadow holds data from the current cycle
+	bool			_snapshot_supported;	///< IO firmware serves the snapshot page
+	bool			_snapshot_checked;	///< snapshot support has been probed
+
 	/* subscribed topics */
 	int			_t_actuator_controls_0;	///< actuator controls group 0 topic
 	int			_t_actuator_controls_1;	///< actuator controls group 1 topic
@@ -296,6 +302,7 @@ private:
 
 	bool			_primary_pwm_device;	///< true if we are the default PWM output
 	bool			_lockdown_override;	///< allow to override the safety lockdown
+	bool			_rc_loss_failsafe;	///< let IO apply the failsafe values autonomously on RC loss
 
 	float			_battery_amp_per_volt;	///< current sensor amps/volt
 	float			_battery_amp_bias;	///< current sensor bias
@@ -341,6 +348,15 @@ private:
 	 */
 	int			io_set_rc_config();
 
+	/**
+	 * Refresh the register shadow with one bulk transfer.
+	 *
+	 * Status, alarms and raw R/C input are then served from RAM for the
+	 * rest of the poll cycle. Falls back gracefully when the IO
+	 * firmware does not serve the snapshot page.
+	 */
+	int			io_get_snapshot();
+
 	/**
 	 * Fetch status and alarms from IO
 	 *
@@ -506,6 +522,10 @@ PX4IO::PX4IO(device::Device *interface) :
 	_perf_sample_latency(perf_alloc(PC_ELAPSED, "io latency")),
 	_status(0),
 	_alarms(0),
+	_snapshot_regs{},
+	_snapshot_valid(false),
+	_snapshot_supported(true),
+	_snapshot_checked(false),
 	_t_actuator_controls_0(-1),
 	_t_actuator_controls_1(-1),
 	_t_actuator_controls_2(-1),
@@ -524,6 +544,7 @@ PX4IO::PX4IO(device::Device *interface) :
 	_servorail_status{},
 	_primary_pwm_device(false),
 	_lockdown_override(false),
+	_rc_loss_failsafe(false),
 	_battery_amp_per_volt(90.0f / 5.0f), // this matches the 3DR current sensor
 	_battery_amp_bias(0),
 	_battery_mamphour_total(0),
@@ -675,6 +696,11 @@ PX4IO::init()
 	param_get(param_find("RC_RSSI_PWM_MAX"), &_rssi_pwm_max);
 	param_get(param_find("RC_RSSI_PWM_MIN"), &_rssi_pwm_min);
 
+	/* autonomous RC loss reaction on IO */
+	int32_t rc_fails_io = 0;
+	param_get(param_find("RC_FAILS_IO"), &rc_fails_io);
+	_rc_loss_failsafe = (rc_fails_io != 0);
+
 	/*
 	 * Check for IO flight state - if FMU was flagged to be in
 	 * armed state, FMU is recovering from an in-air reset.
@@ -960,6 +986,9 @@ PX4IO::task_main()
 			/* run at 50Hz */
 			poll_last = now;
 
+			/* refresh the register shadow with one bulk transfer */
+			io_get_snapshot();
+
 			/* pull status and alarms from IO */
 			io_get_status();
 
@@ -1084,6 +1113,12 @@ PX4IO::task_main()
 				param_get(param_find("RC_RSSI_PWM_MAX"), &_rssi_pwm_max);
 				param_get(param_find("RC_RSSI_PWM_MIN"), &_rssi_pwm_min);
 
+				/* re-read the autonomous RC loss reaction enable; the
+				 * arming state update applies it to the IO register */
+				int32_t rc_fails_io = 0;
+				param_get(param_find("RC_FAILS_IO"), &rc_fails_io);
+				_rc_loss_failsafe = (rc_fails_io != 0);
+
 			}
 
 		}
@@ -1236,6 +1271,25 @@ PX4IO::io_set_arming_state()
 		}
 	}
 
+	if ((have_armed == OK) && (have_control_mode == OK)) {
+		/*
+		 * The autonomous RC loss reaction on IO bridges the latency of the
+		 * FMU failsafe chain while the pilot is flying manually. Once the
+		 * FMU has taken over - its RC loss handling switched the vehicle
+		 * to an autonomous mode or to termination - clear the bit again so
+		 * IO follows the FMU controls instead of holding the failsafe
+		 * values.
+		 */
+		if (_rc_loss_failsafe && armed.armed &&
+		    control_mode.flag_control_manual_enabled &&
+		    !control_mode.flag_control_termination_enabled) {
+			set |= PX4IO_P_SETUP_ARMING_RC_LOSS_FAILSAFE;
+
+		} else {
+			clear |= PX4IO_P_SETUP_ARMING_RC_LOSS_FAILSAFE;
+		}
+	}
+
 	return io_reg_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING, clear, set);
 }
 
@@ -1552,20 +1606,55 @@ PX4IO::io_handle_vservo(uint16_t vservo, uint16_t vrssi)
 	}
 }
 
+int
+PX4IO::io_get_snapshot()
+{
+	int ret;
+
+	/* IO firmware predating the snapshot page cannot serve it - stay on the per-page reads */
+	if (!_snapshot_supported) {
+		return -ENOTSUP;
+	}
+
+	ret = io_reg_get(PX4IO_PAGE_POLL_SNAPSHOT, 0, &_snapshot_regs[0],
+			 sizeof(_snapshot_regs) / sizeof(_snapshot_regs[0]));
+
+	_snapshot_valid = (ret == OK);
+
+	if (!_snapshot_checked) {
+		_snapshot_checked = true;
+
+		/* probe once: a failure on the very first attempt means old IO firmware */
+		if (ret != OK) {
+			_snapshot_supported = false;
+		}
+	}
+
+	return ret;
+}
+
 int
 PX4IO::io_get_status()
 {
 	uint16_t	regs[6];
 	int		ret;
 
-	/* get
-	 * STATUS_FLAGS, STATUS_ALARMS, STATUS_VBATT, STATUS_IBATT,
-	 * STATUS_VSERVO, STATUS_VRSSI, STATUS_PRSSI
-	 * in that order */
-	ret = io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, &regs[0], sizeof(regs) / sizeof(regs[0]));
+	if (_snapshot_valid) {
+		/* served from the register shadow - no extra bus transaction */
+		memcpy(regs, &_snapshot_regs[PX4IO_P_SNAPSHOT_STATUS_BASE], sizeof(regs));
 
-	if (ret != OK)
-		return ret;
+	} else {
+		/* get
+		 * STATUS_FLAGS, STATUS_ALARMS, STATUS_VBATT, STATUS_IBATT,
+		 * STATUS_VSERVO, STATUS_VRSSI, STATUS_PRSSI
+		 * in that order */
+		ret = io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, &regs[0], sizeof(regs) / sizeof(regs[0]));
+
+		if (ret != OK)
+			return ret;
+	}
+
+	ret = OK;
 
 	io_handle_status(regs[0]);
 	io_handle_alarms(regs[1]);
@@ -1593,15 +1682,22 @@ PX4IO::io_get_raw_rc_input(rc_input_values &input_rc)
 	const unsigned prolog = (PX4IO_P_RAW_RC_BASE - PX4IO_P_RAW_RC_COUNT);
 	uint16_t regs[RC_INPUT_MAX_CHANNELS + prolog];
 
-	/*
-	 * Read the channel count and the first 9 channels.
-	 *
-	 * This should be the common case (9 channel R/C control being a reasonable upper bound).
-	 */
-	ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, &regs[0], prolog + 9);
+	if (_snapshot_valid) {
+		/* the snapshot carries the full R/C page - serve it from the register shadow */
+		memcpy(regs, &_snapshot_regs[PX4IO_P_SNAPSHOT_RC_BASE], sizeof(regs));
+		ret = OK;
 
-	if (ret != OK)
-		return ret;
+	} else {
+		/*
+		 * Read the channel count and the first 9 channels.
+		 *
+		 * This should be the common case (9 channel R/C control being a reasonable upper bound).
+		 */
+		ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, &regs[0], prolog + 9);
+
+		if (ret != OK)
+			return ret;
+	}
 
 	/*
 	 * Get the channel count any any extra channels. This is no more expensive than reading the
@@ -1636,7 +1732,7 @@ PX4IO::io_get_raw_rc_input(rc_input_values &input_rc)
 	/* FIELDS NOT SET HERE */
 	/* input_rc.input_source is set after this call XXX we might want to mirror the flags in the RC struct */
 
-	if (channel_count > 9) {
+	if (!_snapshot_valid && (channel_count > 9)) {
 		ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_BASE + 9, &regs[prolog + 9], channel_count - 9);
 
 		if (ret != OK)
@@ -2130,7 +2226,7 @@ PX4IO::print_status(bool extended_status)
 		((features & PX4IO_P_SETUP_FEATURES_ADC_RSSI) ? " RSSI_ADC" : "")
 		);
 	uint16_t arming = io_reg_get(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING);
-	printf("arming 0x%04x%s%s%s%s%s%s%s%s%s%s\n",
+	printf("arming 0x%04x%s%s%s%s%s%s%s%s%s%s%s\n",
 	       arming,
 	       ((arming & PX4IO_P_SETUP_ARMING_FMU_ARMED)		? " FMU_ARMED" : " FMU_DISARMED"),
 	       ((arming & PX4IO_P_SETUP_ARMING_IO_ARM_OK)		? " IO_ARM_OK" : " IO_ARM_DENIED"),
@@ -2141,7 +2237,8 @@ PX4IO::print_status(bool extended_status)
 	       ((arming & PX4IO_P_SETUP_ARMING_LOCKDOWN)		? " LOCKDOWN" : ""),
 	       ((arming & PX4IO_P_SETUP_ARMING_FORCE_FAILSAFE)		? " FORCE_FAILSAFE" : ""),
 	       ((arming & PX4IO_P_SETUP_ARMING_TERMINATION_FAILSAFE) ? " TERM_FAILSAFE" : ""),
-	       ((arming & PX4IO_P_SETUP_ARMING_OVERRIDE_IMMEDIATE) ? " OVERRIDE_IMMEDIATE" : "")
+	       ((arming & PX4IO_P_SETUP_ARMING_OVERRIDE_IMMEDIATE) ? " OVERRIDE_IMMEDIATE" : ""),
+	       ((arming & PX4IO_P_SETUP_ARMING_RC_LOSS_FAILSAFE) ? " RC_LOSS_FAILSAFE" : "")
 	       );
 #ifdef CONFIG_ARCH_BOARD_PX4FMU_V1
 	printf("rates 0x%04x default %u alt %u relays 0x%04x\n",
@@ -2395,6 +2492,21 @@ PX4IO::ioctl(file * filep, int cmd, unsigned long arg)
 		}
 		break;
 
+	case PWM_SERVO_SET_RC_LOSS_FAILSAFE:
+		/* have IO apply the failsafe values as soon as RC input drops out;
+		 * remember the enable so the arming state updates keep the bit
+		 * consistent with the flight mode instead of undoing the ioctl */
+		_rc_loss_failsafe = (arg != 0);
+
+		if (arg == 0) {
+			/* clear RC loss failsafe flag */
+			ret = io_reg_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING, PX4IO_P_SETUP_ARMING_RC_LOSS_FAILSAFE, 0);
+		} else {
+			/* set RC loss failsafe flag */
+			ret = io_reg_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING, 0, PX4IO_P_SETUP_ARMING_RC_LOSS_FAILSAFE);
+		}
+		break;
+
 	case DSM_BIND_START:
 
 		/* only allow DSM2, DSM-X and DSM-X with more than 7 channels */
@@ -2547,6 +2659,12 @@ PX4IO::ioctl(file * filep, int cmd, unsigned long arg)
 			break;
 		}
 
+	case MIXERIOCLOADBUFBIN:
+		/* the IO firmware parses mixer text on its own side,
+		 * callers have to fall back to MIXERIOCLOADBUF */
+		ret = -EINVAL;
+		break;
+
 	case RC_INPUT_GET: {
 			uint16_t status;
 			rc_input_values *rc_val = (rc_input_values *)arg;
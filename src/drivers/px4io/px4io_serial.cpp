@@ -121,11 +121,32 @@ private:
 	/** client-waiting lock/signal */
 	sem_t			_completion_semaphore;
 
+	/** a posted write is in flight and its reply has not been collected */
+	bool			_posted_write_pending;
+
 	/**
 	 * Start the transaction with IO and wait for it to complete.
 	 */
 	int			_wait_complete();
 
+	/**
+	 * Start the transaction with IO but do not wait for the reply.
+	 */
+	void			_start_exchange();
+
+	/**
+	 * Wait for a previously started transaction to complete.
+	 */
+	int			_finish_exchange();
+
+	/**
+	 * Collect the reply of a posted write, if one is outstanding.
+	 *
+	 * Must be called with the bus semaphore held, before touching the
+	 * DMA buffer.
+	 */
+	void			_flush_posted_write();
+
 	/**
 	 * DMA completion handler.
 	 */
@@ -179,6 +200,7 @@ PX4IO_serial::PX4IO_serial() :
 	_rx_dma_status(_dma_status_inactive),
 	_bus_semaphore(SEM_INITIALIZER(0)),
 	_completion_semaphore(SEM_INITIALIZER(0)),
+	_posted_write_pending(false),
 	_pc_txns(perf_alloc(PC_ELAPSED, "io_txns     ")),
 	_pc_dmasetup(perf_alloc(PC_ELAPSED,	"io_dmasetup ")),
 	_pc_retries(perf_alloc(PC_COUNT,	"io_retries  ")),
@@ -358,15 +380,39 @@ PX4IO_serial::write(unsigned address, void *data, unsigned count)
 
 	sem_wait(&_bus_semaphore);
 
+	/* collect the reply of any write still in flight */
+	_flush_posted_write();
+
 	int result;
+
+	/*
+	 * Post the high-rate control writes: start the exchange and collect
+	 * the reply at the beginning of the next transaction, overlapping
+	 * the wire time of the reply with the caller's own work. Controls
+	 * are refreshed every cycle, so an error on one packet is
+	 * recoverable and still shows up in the performance counters.
+	 */
+	if (page == PX4IO_PAGE_CONTROLS) {
+
+		_dma_buffer.count_code = count | PKT_CODE_WRITE;
+		_dma_buffer.page = page;
+		_dma_buffer.offset = offset;
+		memcpy((void *)&_dma_buffer.regs[0], (void *)values, (2 * count));
+
+		_start_exchange();
+		_posted_write_pending = true;
+
+		sem_post(&_bus_semaphore);
+
+		return count;
+	}
+
 	for (unsigned retries = 0; retries < 3; retries++) {
 
 		_dma_buffer.count_code = count | PKT_CODE_WRITE;
 		_dma_buffer.page = page;
 		_dma_buffer.offset = offset;
 		memcpy((void *)&_dma_buffer.regs[0], (void *)values, (2 * count));
-		for (unsigned i = count; i < PKT_MAX_REGS; i++)
-			_dma_buffer.regs[i] = 0x55aa;
 
 		/* XXX implement check byte */
 
@@ -408,6 +454,9 @@ PX4IO_serial::read(unsigned address, void *data, unsigned count)
 
 	sem_wait(&_bus_semaphore);
 
+	/* collect the reply of any write still in flight */
+	_flush_posted_write();
+
 	int result;
 	for (unsigned retries = 0; retries < 3; retries++) {
 
@@ -456,6 +505,33 @@ PX4IO_serial::read(unsigned address, void *data, unsigned count)
 
 int
 PX4IO_serial::_wait_complete()
+{
+	_start_exchange();
+
+	return _finish_exchange();
+}
+
+void
+PX4IO_serial::_flush_posted_write()
+{
+	if (!_posted_write_pending) {
+		return;
+	}
+
+	_posted_write_pending = false;
+
+	/* the posted write cannot return its result - just count failures */
+	if (_finish_exchange() != OK) {
+		return;
+	}
+
+	if (PKT_CODE(_dma_buffer) == PKT_CODE_ERROR) {
+		perf_count(_pc_protoerrs);
+	}
+}
+
+void
+PX4IO_serial::_start_exchange()
 {
 	/* clear any lingering error status */
 	(void)rSR;
@@ -513,7 +589,11 @@ PX4IO_serial::_wait_complete()
 	rCR3 |= USART_CR3_DMAT;
 
 	perf_end(_pc_dmasetup);
+}
 
+int
+PX4IO_serial::_finish_exchange()
+{
 	/* compute the deadline for a 10ms timeout */
 	struct timespec abstime;
 	clock_gettime(CLOCK_REALTIME, &abstime);
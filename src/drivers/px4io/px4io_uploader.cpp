@@ -66,6 +66,8 @@
 PX4IO_Uploader::PX4IO_Uploader() :
 	_io_fd(-1),
 	_fw_fd(-1),
+	_fw_compressed(false),
+	_fw_lz(nullptr),
 	bl_rev(0)
 {
 }
@@ -152,6 +154,22 @@ PX4IO_Uploader::upload(const char *filenames[])
 	}
 	fw_size = st.st_size;
 
+	/* the image may be LZSS-compressed at build time; if so, read it
+	 * through the decompressor and use the uncompressed size */
+	if (_fw_lz == nullptr) {
+		_fw_lz = new lzss_file_s;
+	}
+
+	if ((_fw_lz != nullptr) && (lzss_fopen(_fw_lz, _fw_fd) == OK)) {
+		_fw_compressed = true;
+		fw_size = _fw_lz->out_size;
+		log("compressed image, %u bytes uncompressed", (unsigned)fw_size);
+
+	} else {
+		/* lzss_fopen rewinds the file when the magic is missing */
+		_fw_compressed = false;
+	}
+
 	if (_fw_fd == -1) {
 		tcsetattr(_io_fd, TCSANOW, &t_original);
 		close(_io_fd);
@@ -238,6 +256,14 @@ PX4IO_Uploader::upload(const char *filenames[])
 	close(_io_fd);
 	_io_fd = -1;
 
+	/* the decoder state is only needed while uploading */
+	if (_fw_lz != nullptr) {
+		delete _fw_lz;
+		_fw_lz = nullptr;
+	}
+
+	_fw_compressed = false;
+
 	// sleep for enough time for the IO chip to boot. This makes
 	// forceupdate more reliably startup IO again after update
 	up_udelay(100*1000);
@@ -406,6 +432,26 @@ static int read_with_retry(int fd, void *buf, size_t n)
 	return ret;
 }
 
+int
+PX4IO_Uploader::fw_rewind()
+{
+	if (_fw_compressed) {
+		return lzss_rewind(_fw_lz);
+	}
+
+	return lseek(_fw_fd, 0, SEEK_SET);
+}
+
+ssize_t
+PX4IO_Uploader::fw_read(void *buf, size_t n)
+{
+	if (_fw_compressed) {
+		return lzss_read(_fw_lz, (uint8_t *)buf, n);
+	}
+
+	return read_with_retry(_fw_fd, buf, n);
+}
+
 int
 PX4IO_Uploader::program(size_t fw_size)
 {
@@ -425,7 +471,7 @@ PX4IO_Uploader::program(size_t fw_size)
 
 	log("programming %u bytes...", (unsigned)fw_size);
 
-	ret = lseek(_fw_fd, 0, SEEK_SET);
+	ret = fw_rewind();
 
 	while (sent < fw_size) {
 		/* get more bytes to program */
@@ -433,10 +479,10 @@ PX4IO_Uploader::program(size_t fw_size)
 		if (n > PROG_MULTI_MAX) {
 			n = PROG_MULTI_MAX;
 		}
-		count = read_with_retry(_fw_fd, file_buf, n);
+		count = fw_read(file_buf, n);
 
 		if (count != (ssize_t)n) {
-			log("firmware read of %u bytes at %u failed -> %d errno %d", 
+			log("firmware read of %u bytes at %u failed -> %d errno %d",
 			    (unsigned)n,
 			    (unsigned)sent,
 			    (int)count,
@@ -472,7 +518,7 @@ PX4IO_Uploader::verify_rev2(size_t fw_size)
 	size_t sent = 0;
 
 	log("verify...");
-	lseek(_fw_fd, 0, SEEK_SET);
+	fw_rewind();
 
 	send(PROTO_CHIP_VERIFY);
 	send(PROTO_EOC);
@@ -487,10 +533,10 @@ PX4IO_Uploader::verify_rev2(size_t fw_size)
 		if (n > sizeof(file_buf)) {
 			n = sizeof(file_buf);
 		}
-		count = read_with_retry(_fw_fd, file_buf, n);
+		count = fw_read(file_buf, n);
 
 		if (count != (ssize_t)n) {
-			log("firmware read of %u bytes at %u failed -> %d errno %d", 
+			log("firmware read of %u bytes at %u failed -> %d errno %d",
 			    (unsigned)n,
 			    (unsigned)sent,
 			    (int)count,
@@ -551,7 +597,7 @@ PX4IO_Uploader::verify_rev3(size_t fw_size_local)
 	uint8_t fill_blank = 0xff;
 
 	log("verify...");
-	lseek(_fw_fd, 0, SEEK_SET);
+	fw_rewind();
 
 	ret = get_info(INFO_FLASH_SIZE, fw_size_remote);
 	send(PROTO_EOC);
@@ -567,10 +613,10 @@ PX4IO_Uploader::verify_rev3(size_t fw_size_local)
 		if (n > sizeof(file_buf)) {
 			n = sizeof(file_buf);
 		}
-		count = read_with_retry(_fw_fd, file_buf, n);
+		count = fw_read(file_buf, n);
 
 		if (count != (ssize_t)n) {
-			log("firmware read of %u bytes at %u failed -> %d errno %d", 
+			log("firmware read of %u bytes at %u failed -> %d errno %d",
 			    (unsigned)n,
 			    (unsigned)bytes_read,
 			    (int)count,
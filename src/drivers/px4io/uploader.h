@@ -42,6 +42,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include <systemlib/lzss.h>
+
 
 class PX4IO_Uploader
 {
@@ -80,11 +82,18 @@ private:
 
 	int			_io_fd;
 	int			_fw_fd;
+	bool			_fw_compressed;	/**< image carries the LZSS magic */
+	struct lzss_file_s	*_fw_lz;	/**< decoder state, allocated on demand */
 
 	uint32_t		bl_rev; /**< bootloader revision */
 
 	void			log(const char *fmt, ...);
 
+	/** restart reading the firmware image from the beginning */
+	int			fw_rewind();
+	/** read the next image bytes, decompressing if required */
+	ssize_t			fw_read(void *buf, size_t n);
+
 	int			recv_byte_with_timeout(uint8_t *c, unsigned timeout);
 	int			recv_bytes(uint8_t *p, unsigned count);
 	void			drain();
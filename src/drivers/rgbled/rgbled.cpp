@@ -106,6 +106,15 @@ private:
 	bool			_should_run;
 	int			_counter;
 
+	/* last register contents sent to the chip; pattern steps and the
+	 * quantized breathe ramp frequently program the same values again,
+	 * and skipping those keeps the sensor bus free of redundant LED
+	 * traffic */
+	uint8_t			_last_pwm[3];
+	uint8_t			_last_settings;
+	bool			_last_pwm_valid;
+	bool			_last_settings_valid;
+
 	void 			set_color(rgbled_color_t ledcolor);
 	void			set_mode(rgbled_mode_t mode);
 	void			set_pattern(rgbled_pattern_t *pattern);
@@ -138,10 +147,14 @@ RGBLED::RGBLED(int bus, int rgbled) :
 	_running(false),
 	_led_interval(0),
 	_should_run(false),
-	_counter(0)
+	_counter(0),
+	_last_settings(0),
+	_last_pwm_valid(false),
+	_last_settings_valid(false)
 {
 	memset(&_work, 0, sizeof(_work));
 	memset(&_pattern, 0, sizeof(_pattern));
+	memset(&_last_pwm, 0, sizeof(_last_pwm));
 }
 
 RGBLED::~RGBLED()
@@ -185,9 +198,21 @@ RGBLED::probe()
 	unsigned prevretries = _retries;
 	_retries = 4;
 
-	if ((ret=get(on, powersave, r, g, b)) != OK ||
-	    (ret=send_led_enable(false) != OK) ||
-	    (ret=send_led_enable(false) != OK)) {
+	ret = get(on, powersave, r, g, b);
+
+	/* the detection logic relies on the transfers actually happening,
+	 * so drop the register cache before each write */
+	if (ret == OK) {
+		_last_settings_valid = false;
+		ret = send_led_enable(false);
+	}
+
+	if (ret == OK) {
+		_last_settings_valid = false;
+		ret = send_led_enable(false);
+	}
+
+	if (ret != OK) {
 		return ret;
 	}
 
@@ -524,9 +549,25 @@ RGBLED::send_led_enable(bool enable)
 
 	settings_byte |= SETTING_NOT_POWERSAVE;
 
+	/* already programmed: no need to touch the bus */
+	if (_last_settings_valid && settings_byte == _last_settings) {
+		return OK;
+	}
+
 	const uint8_t msg[2] = { SUB_ADDR_SETTINGS, settings_byte};
 
-	return transfer(msg, sizeof(msg), nullptr, 0);
+	int ret = transfer(msg, sizeof(msg), nullptr, 0);
+
+	if (ret == OK) {
+		_last_settings = settings_byte;
+		_last_settings_valid = true;
+
+	} else {
+		/* chip state unknown, re-send next time */
+		_last_settings_valid = false;
+	}
+
+	return ret;
 }
 
 /**
@@ -536,12 +577,36 @@ int
 RGBLED::send_led_rgb()
 {
 	/* To scale from 0..255 -> 0..15 shift right by 4 bits */
+	const uint8_t pwm[3] = {
+		(uint8_t)((int)(_b * _brightness) >> 4),
+		(uint8_t)((int)(_g * _brightness) >> 4),
+		(uint8_t)((int)(_r * _brightness) >> 4)
+	};
+
+	/* the 4-bit PWM quantization makes repeated identical values common
+	 * (same-color pattern steps, breathe ramp plateaus): skip those */
+	if (_last_pwm_valid && memcmp(pwm, _last_pwm, sizeof(pwm)) == 0) {
+		return OK;
+	}
+
 	const uint8_t msg[6] = {
-		SUB_ADDR_PWM0, (uint8_t)((int)(_b * _brightness) >> 4),
-		SUB_ADDR_PWM1, (uint8_t)((int)(_g * _brightness) >> 4),
-		SUB_ADDR_PWM2, (uint8_t)((int)(_r * _brightness) >> 4)
+		SUB_ADDR_PWM0, pwm[0],
+		SUB_ADDR_PWM1, pwm[1],
+		SUB_ADDR_PWM2, pwm[2]
 	};
-	return transfer(msg, sizeof(msg), nullptr, 0);
+
+	int ret = transfer(msg, sizeof(msg), nullptr, 0);
+
+	if (ret == OK) {
+		memcpy(_last_pwm, pwm, sizeof(_last_pwm));
+		_last_pwm_valid = true;
+
+	} else {
+		/* chip state unknown, re-send next time */
+		_last_pwm_valid = false;
+	}
+
+	return ret;
 }
 
 int
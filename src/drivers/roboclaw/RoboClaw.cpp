@@ -72,7 +72,12 @@ RoboClaw::RoboClaw(const char *deviceName, uint16_t address,
 	_motor1Overflow(0),
 	_motor2Position(0),
 	_motor2Speed(0),
-	_motor2Overflow(0)
+	_motor2Overflow(0),
+	_streaming(false),
+	_streamState(STREAM_IDLE),
+	_streamSum(0),
+	_streamLen(0),
+	_streamRequestTime(0)
 {
 	// setup control polling
 	_controlPoll.fd = _actuators.getHandle();
@@ -124,6 +129,12 @@ int RoboClaw::readEncoder(e_motor motor)
 		//printf("%d\t", rbuf[i]);
 	//}
 	//printf("\n");
+	return _handleEncoderResponse(motor, rbuf, sum);
+}
+
+int RoboClaw::_handleEncoderResponse(e_motor motor, uint8_t * rbuf,
+		uint16_t cmd_sum)
+{
 	uint32_t count = 0;
 	uint8_t * countBytes = (uint8_t *)(&count);
 	countBytes[3] = rbuf[0];
@@ -132,7 +143,7 @@ int RoboClaw::readEncoder(e_motor motor)
 	countBytes[0] = rbuf[3];
 	uint8_t status = rbuf[4];
 	uint8_t checksum = rbuf[5];
-	uint8_t checksum_computed = (sum + _sumBytes(rbuf, 5)) &
+	uint8_t checksum_computed = (cmd_sum + _sumBytes(rbuf, 5)) &
 		checksum_mask;
 	// check if checksum is valid
 	if (checksum != checksum_computed) {
@@ -167,6 +178,80 @@ int RoboClaw::readEncoder(e_motor motor)
 	return 0;
 }
 
+void RoboClaw::setEncoderStreaming(bool enable)
+{
+	_streaming = enable;
+	_streamState = STREAM_IDLE;
+	_streamLen = 0;
+
+	// non-blocking reads while streaming so the parser never
+	// stalls the control loop on a partial response
+	int flags = fcntl(_uart, F_GETFL, 0);
+
+	if (enable) {
+		fcntl(_uart, F_SETFL, flags | O_NONBLOCK);
+		_requestEncoder(MOTOR_1);
+
+	} else {
+		fcntl(_uart, F_SETFL, flags & ~O_NONBLOCK);
+		tcflush(_uart, TCIFLUSH);
+	}
+}
+
+int RoboClaw::_requestEncoder(e_motor motor)
+{
+	_streamSum = 0;
+	_streamLen = 0;
+	int ret = -1;
+
+	if (motor == MOTOR_1) {
+		ret = _sendCommand(CMD_READ_ENCODER_1, nullptr, 0, _streamSum);
+		_streamState = STREAM_WAIT_ENC_1;
+	} else if (motor == MOTOR_2) {
+		ret = _sendCommand(CMD_READ_ENCODER_2, nullptr, 0, _streamSum);
+		_streamState = STREAM_WAIT_ENC_2;
+	}
+
+	_streamRequestTime = hrt_absolute_time();
+	return ret;
+}
+
+void RoboClaw::_parseSerial()
+{
+	// a complete encoder response is 6 bytes
+	while (_streamState != STREAM_IDLE && _streamLen < 6) {
+		int nread = read(_uart, &_streamBuf[_streamLen],
+				6 - _streamLen);
+
+		if (nread <= 0) {
+			break;
+		}
+
+		_streamLen += nread;
+	}
+
+	if (_streamState != STREAM_IDLE && _streamLen >= 6) {
+		e_motor motor = (_streamState == STREAM_WAIT_ENC_1) ?
+			MOTOR_1 : MOTOR_2;
+
+		if (_handleEncoderResponse(motor, _streamBuf, _streamSum) < 0) {
+			// lost sync, drop buffered input and start over
+			tcflush(_uart, TCIFLUSH);
+			_requestEncoder(MOTOR_1);
+			return;
+		}
+
+		// keep one request in flight at all times, alternating motors
+		_requestEncoder((motor == MOTOR_1) ? MOTOR_2 : MOTOR_1);
+
+	} else if (_streamState != STREAM_IDLE &&
+			hrt_absolute_time() - _streamRequestTime > 50000) {
+		// response lost (e.g. flushed by a command), re-request
+		_requestEncoder((_streamState == STREAM_WAIT_ENC_1) ?
+				MOTOR_1 : MOTOR_2);
+	}
+}
+
 void RoboClaw::printStatus(char *string, size_t n)
 {
 	snprintf(string, n,
@@ -252,11 +337,22 @@ int RoboClaw::resetEncoders()
 
 int RoboClaw::update()
 {
-	// wait for an actuator publication,
+	// wait for an actuator publication or serial data,
 	// check for exit condition every second
 	// note "::poll" is required to distinguish global
 	// poll from member function for driver
-	if (::poll(&_controlPoll, 1, 1000) < 0) return -1; // poll error
+	struct pollfd fds[2];
+	fds[0] = _controlPoll;
+	fds[1].fd = _uart;
+	fds[1].events = POLLIN;
+
+	if (::poll(fds, _streaming ? 2 : 1, 1000) < 0) return -1; // poll error
+
+	// parse any pending encoder responses before commanding the
+	// motors, so the controller sees the freshest shadow state
+	if (_streaming) {
+		_parseSerial();
+	}
 
 	// if new data, send to motors
 	if (_actuators.updated()) {
@@ -282,7 +378,10 @@ uint16_t RoboClaw::_sumBytes(uint8_t * buf, size_t n)
 int RoboClaw::_sendCommand(e_command cmd, uint8_t * data,
 		size_t n_data, uint16_t & prev_sum)
 {
-	tcflush(_uart, TCIOFLUSH); // flush  buffers
+	// flushing would discard the in-flight encoder response
+	if (!_streaming) {
+		tcflush(_uart, TCIOFLUSH); // flush  buffers
+	}
 	uint8_t buf[n_data + 3];
 	buf[0] = _address;
 	buf[1] = cmd;
@@ -117,8 +117,21 @@ public:
 	 */
 	int update();
 
+	/**
+	 * enable/disable continuous encoder streaming
+	 *
+	 * While enabled the driver keeps one encoder request in flight
+	 * at all times and parses the responses as they arrive in
+	 * update(), so getMotorPosition() always returns the latest
+	 * shadow state without a blocking serial round trip.
+	 */
+	void setEncoderStreaming(bool enable);
+
 	/**
 	 * read data from serial
+	 *
+	 * Blocking round trip; used for testing.  With streaming
+	 * enabled the shadow state is kept current by update() instead.
 	 */
 	int readEncoder(e_motor motor);
 
@@ -158,6 +171,13 @@ private:
 		CMD_SIGNED_DUTYCYCLE_2 = 33,
 	};
 
+	// streaming parser states
+	enum e_stream_state {
+		STREAM_IDLE = 0, /**< no encoder request in flight **/
+		STREAM_WAIT_ENC_1, /**< response for encoder 1 pending **/
+		STREAM_WAIT_ENC_2, /**< response for encoder 2 pending **/
+	};
+
 	static uint8_t checksum_mask;
 
 	uint16_t _address;
@@ -180,9 +200,26 @@ private:
 	float _motor2Speed;
 	int16_t _motor2Overflow;
 
+	// streaming parser state
+	bool _streaming;
+	e_stream_state _streamState;
+	uint16_t _streamSum;
+	uint8_t _streamBuf[8];
+	size_t _streamLen;
+	uint64_t _streamRequestTime;
+
 	// private methods
 	uint16_t _sumBytes(uint8_t * buf, size_t n);
 	int _sendCommand(e_command cmd, uint8_t * data, size_t n_data, uint16_t & prev_sum);
+
+	/** request the next encoder readout without blocking */
+	int _requestEncoder(e_motor motor);
+
+	/** drain the uart and parse pending encoder responses */
+	void _parseSerial();
+
+	/** apply a complete encoder response to the shadow state */
+	int _handleEncoderResponse(e_motor motor, uint8_t * rbuf, uint16_t cmd_sum);
 };
 
 // unit testing
@@ -180,6 +180,9 @@ int roboclaw_thread_main(int argc, char *argv[])
 	// start
 	RoboClaw roboclaw(deviceName, address, pulsesPerRev);
 
+	// stream encoder state so position reads don't block
+	roboclaw.setEncoderStreaming(true);
+
 	thread_running = true;
 
 	// loop
@@ -86,7 +86,8 @@ static const int ERROR = -1;
 # error This requires CONFIG_SCHED_WORKQUEUE.
 #endif
 
-#define SF0X_CONVERSION_INTERVAL	83334
+#define SF0X_CONVERSION_INTERVAL	83334	/* 12 Hz, the default reading rate */
+#define SF0X_MIN_INTERVAL		31250	/* 32 Hz, the limit of the faster SF02/F firmwares */
 #define SF0X_TAKE_RANGE_REG		'd'
 #define SF02F_MIN_DISTANCE		0.0f
 #define SF02F_MAX_DISTANCE		40.0f
@@ -340,13 +341,28 @@ SF0X::ioctl(struct file *filp, int cmd, unsigned long arg)
 			case 0:
 				return -EINVAL;
 
-			/* set default/max polling rate */
-			case SENSOR_POLLRATE_MAX:
+			/* set max polling rate */
+			case SENSOR_POLLRATE_MAX: {
+					/* do we need to start internal polling? */
+					bool want_start = (_measure_ticks == 0);
+
+					/* set interval for next measurement to the fastest supported rate */
+					_measure_ticks = USEC2TICK(SF0X_MIN_INTERVAL);
+
+					/* if we need to start the poll state machine, do it */
+					if (want_start) {
+						start();
+					}
+
+					return OK;
+				}
+
+			/* set default polling rate */
 			case SENSOR_POLLRATE_DEFAULT: {
 					/* do we need to start internal polling? */
 					bool want_start = (_measure_ticks == 0);
 
-					/* set interval for next measurement to minimum legal value */
+					/* set interval for next measurement to the default rate */
 					_measure_ticks = USEC2TICK(SF0X_CONVERSION_INTERVAL);
 
 					/* if we need to start the poll state machine, do it */
@@ -367,7 +383,7 @@ SF0X::ioctl(struct file *filp, int cmd, unsigned long arg)
 					unsigned ticks = USEC2TICK(1000000 / arg);
 
 					/* check against maximum rate */
-					if (ticks < USEC2TICK(SF0X_CONVERSION_INTERVAL)) {
+					if (ticks < USEC2TICK(SF0X_MIN_INTERVAL)) {
 						return -EINVAL;
 					}
 
@@ -526,9 +542,10 @@ SF0X::collect()
 	/* clear buffer if last read was too long ago */
 	uint64_t read_elapsed = hrt_elapsed_time(&_last_read);
 
-	/* the buffer for read chars is buflen minus null termination */
-	char readbuf[sizeof(_linebuf)];
-	unsigned readlen = sizeof(readbuf) - 1;
+	/* read a whole backlog of frames in one pass; a frame is at most
+	 * nine bytes so this covers several readings at the higher rates */
+	char readbuf[4 * sizeof(_linebuf)];
+	unsigned readlen = sizeof(readbuf);
 
 	/* read from the sensor (uart buffer) */
 	ret = ::read(_fd, &readbuf[0], readlen);
@@ -554,10 +571,8 @@ SF0X::collect()
 	float si_units;
 	bool valid = false;
 
-	for (int i = 0; i < ret; i++) {
-		if (OK == sf0x_parser(readbuf[i], _linebuf, &_linebuf_index, &_parse_state, &si_units)) {
-			valid = true;
-		}
+	if (OK == sf0x_parser_span(readbuf, ret, _linebuf, &_linebuf_index, &_parse_state, &si_units)) {
+		valid = true;
 	}
 
 	if (!valid) {
@@ -701,12 +716,20 @@ SF0X::cycle()
 	/* next phase is collection */
 	_collect_phase = true;
 
-	/* schedule a fresh cycle call when the measurement is done */
+	/* schedule a fresh cycle call when the measurement is due; at the
+	 * faster rates the sensor streams readings quicker than the default
+	 * conversion interval */
+	unsigned wait_ticks = USEC2TICK(SF0X_CONVERSION_INTERVAL);
+
+	if ((_measure_ticks > 0) && ((unsigned)_measure_ticks < wait_ticks)) {
+		wait_ticks = _measure_ticks;
+	}
+
 	work_queue(HPWORK,
 		   &_work,
 		   (worker_t)&SF0X::cycle_trampoline,
 		   this,
-		   USEC2TICK(SF0X_CONVERSION_INTERVAL));
+		   wait_ticks);
 }
 
 void
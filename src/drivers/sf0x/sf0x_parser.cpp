@@ -40,7 +40,6 @@
 
 #include "sf0x_parser.h"
 #include <string.h>
-#include <stdlib.h>
 
 //#define SF0X_DEBUG
 
@@ -58,10 +57,32 @@ const char *parser_state[] = {
 };
 #endif
 
+/*
+ * Convert a completed "xx.xx" reading. The frame format is fixed-point
+ * with exactly two decimals (enforced by the state machine), so integer
+ * accumulation and a single multiply replace strtod.
+ */
+static float sf0x_convert(const char *buf)
+{
+	int whole = 0;
+
+	while (*buf >= '0' && *buf <= '9') {
+		whole = whole * 10 + (*buf - '0');
+		buf++;
+	}
+
+	int frac = 0;
+
+	if (*buf == '.') {
+		frac = (buf[1] - '0') * 10 + (buf[2] - '0');
+	}
+
+	return whole + frac * 0.01f;
+}
+
 int sf0x_parser(char c, char *parserbuf, unsigned *parserbuf_index, enum SF0X_PARSE_STATE *state, float *dist)
 {
 	int ret = -1;
-	char *end;
 
 	switch (*state) {
 	case SF0X_PARSE_STATE0_UNSYNC:
@@ -135,7 +156,7 @@ int sf0x_parser(char c, char *parserbuf, unsigned *parserbuf_index, enum SF0X_PA
 	case SF0X_PARSE_STATE6_GOT_CARRIAGE_RETURN:
 		if (c == '\n') {
 			parserbuf[*parserbuf_index] = '\0';
-			*dist = strtod(parserbuf, &end);
+			*dist = sf0x_convert(parserbuf);
 			*state = SF0X_PARSE_STATE1_SYNC;
 			*parserbuf_index = 0;
 			ret = 0;
@@ -151,5 +172,22 @@ int sf0x_parser(char c, char *parserbuf, unsigned *parserbuf_index, enum SF0X_PA
 	printf("state: SF0X_PARSE_STATE%s\n", parser_state[*state]);
 #endif
 
+	return ret;
+}
+
+int sf0x_parser_span(const char *buf, unsigned len, char *parserbuf, unsigned *parserbuf_index,
+		     enum SF0X_PARSE_STATE *state, float *dist)
+{
+	int ret = -1;
+
+	/* run the whole span through the state machine, keeping the newest
+	 * completed reading; a frame straddling the span boundary carries
+	 * over to the next call */
+	for (unsigned i = 0; i < len; i++) {
+		if (sf0x_parser(buf[i], parserbuf, parserbuf_index, state, dist) == 0) {
+			ret = 0;
+		}
+	}
+
 	return ret;
 }
\ No newline at end of file
@@ -48,4 +48,15 @@ enum SF0X_PARSE_STATE {
 	SF0X_PARSE_STATE6_GOT_CARRIAGE_RETURN
 };
 
-int sf0x_parser(char c, char *parserbuf, unsigned *parserbuf_index, enum SF0X_PARSE_STATE *state, float *dist);
\ No newline at end of file
+int sf0x_parser(char c, char *parserbuf, unsigned *parserbuf_index, enum SF0X_PARSE_STATE *state, float *dist);
+
+/**
+ * Parse a whole span of received bytes in one call.
+ *
+ * Keeps the newest completed reading in dist; frames straddling the span
+ * boundary carry over to the next call via the parser state.
+ *
+ * @return		0 if at least one reading completed, -1 otherwise.
+ */
+int sf0x_parser_span(const char *buf, unsigned len, char *parserbuf, unsigned *parserbuf_index,
+		     enum SF0X_PARSE_STATE *state, float *dist);
\ No newline at end of file
@@ -98,6 +98,14 @@
 # define rCCR		REG(STM32_ADC_CCR_OFFSET)
 #endif
 
+/*
+ * On F4 we can run the whole channel sequence in hardware scan mode with
+ * a circular DMA into a buffer, making the periodic tick a memory read.
+ */
+#if defined(ADC_CR2_DDS) && defined(DMAMAP_ADC1_1)
+# define ADC_HAVE_DMA_SCAN
+#endif
+
 class ADC : public device::CDev
 {
 public:
@@ -124,6 +132,22 @@ private:
 
 	orb_advert_t		_to_system_power;
 
+#ifdef ADC_HAVE_DMA_SCAN
+	DMA_HANDLE		_dma;			/**< scan-mode DMA channel */
+	uint16_t		*_dma_buffer;		/**< scan-mode conversion target */
+	bool			_scan_mode;		/**< conversions run continuously in hardware */
+
+	/**
+	 * Program the full channel sequence and start continuous
+	 * scan-mode conversions with circular DMA.
+	 *
+	 * @return		OK, or -errno if no DMA channel or memory
+	 *			is available; the caller falls back to
+	 *			per-channel sampling.
+	 */
+	int			setup_scan_dma();
+#endif
+
 	/** work trampoline */
 	static void		_tick_trampoline(void *arg);
 
@@ -149,6 +173,11 @@ ADC::ADC(uint32_t channels) :
 	_channel_count(0),
 	_samples(nullptr),
 	_to_system_power(0)
+#ifdef ADC_HAVE_DMA_SCAN
+	, _dma(nullptr),
+	_dma_buffer(nullptr),
+	_scan_mode(false)
+#endif
 {
 	_debug_enabled = true;
 
@@ -178,6 +207,16 @@ ADC::ADC(uint32_t channels) :
 
 ADC::~ADC()
 {
+#ifdef ADC_HAVE_DMA_SCAN
+	if (_dma != nullptr) {
+		stm32_dmastop(_dma);
+		stm32_dmafree(_dma);
+	}
+
+	if (_dma_buffer != nullptr)
+		delete[] _dma_buffer;
+#endif
+
 	if (_samples != nullptr)
 		delete _samples;
 }
@@ -241,10 +280,87 @@ ADC::init()
 
 	debug("init done");
 
+#ifdef ADC_HAVE_DMA_SCAN
+	/* switch to continuous scan-mode conversions; the periodic tick
+	 * then only snapshots the DMA buffer */
+	if (setup_scan_dma() == OK) {
+		_scan_mode = true;
+		debug("scan mode with DMA");
+
+	} else {
+		debug("no DMA, using per-channel sampling");
+	}
+#endif
+
 	/* create the device node */
 	return CDev::init();
 }
 
+#ifdef ADC_HAVE_DMA_SCAN
+int
+ADC::setup_scan_dma()
+{
+	_dma = stm32_dmachannel(DMAMAP_ADC1_1);
+
+	if (_dma == nullptr) {
+		return -EBUSY;
+	}
+
+	_dma_buffer = new uint16_t[_channel_count];
+
+	if (_dma_buffer == nullptr) {
+		stm32_dmafree(_dma);
+		_dma = nullptr;
+		return -ENOMEM;
+	}
+
+	/* program the full channel sequence */
+	uint32_t sqr1 = (_channel_count - 1) << 20;
+	uint32_t sqr2 = 0;
+	uint32_t sqr3 = 0;
+
+	for (unsigned i = 0; i < _channel_count; i++) {
+		uint32_t chan = _samples[i].am_channel;
+
+		if (i < 6) {
+			sqr3 |= chan << (5 * i);
+
+		} else if (i < 12) {
+			sqr2 |= chan << (5 * (i - 6));
+
+		} else {
+			sqr1 |= chan << (5 * (i - 12));
+		}
+	}
+
+	rSQR1 = sqr1;
+	rSQR2 = sqr2;
+	rSQR3 = sqr3;
+
+	/* circular peripheral-to-memory transfer of the whole sequence */
+	stm32_dmasetup(_dma,
+		       STM32_ADC1_BASE + STM32_ADC_DR_OFFSET,
+		       reinterpret_cast<uint32_t>(_dma_buffer),
+		       _channel_count,
+		       DMA_SCR_CIRC		|
+		       DMA_SCR_DIR_P2M		|
+		       DMA_SCR_MINC		|
+		       DMA_SCR_PSIZE_16BITS	|
+		       DMA_SCR_MSIZE_16BITS	|
+		       DMA_SCR_PBURST_SINGLE	|
+		       DMA_SCR_MBURST_SINGLE);
+
+	stm32_dmastart(_dma, nullptr, nullptr, false);
+
+	/* convert the sequence continuously, feeding the DMA */
+	rCR1 |= ADC_CR1_SCAN;
+	rCR2 |= ADC_CR2_DMA | ADC_CR2_DDS | ADC_CR2_CONT;
+	rCR2 |= ADC_CR2_SWSTART;
+
+	return OK;
+}
+#endif
+
 int
 ADC::ioctl(file *filp, int cmd, unsigned long arg)
 {
@@ -295,6 +411,17 @@ ADC::_tick_trampoline(void *arg)
 void
 ADC::_tick()
 {
+#ifdef ADC_HAVE_DMA_SCAN
+	if (_scan_mode) {
+		/* conversions run continuously in hardware; just snapshot
+		 * the DMA buffer, channel order matches the sequence */
+		for (unsigned i = 0; i < _channel_count; i++)
+			_samples[i].am_data = _dma_buffer[i];
+		update_system_power();
+		return;
+	}
+#endif
+
 	/* scan the channel set and sample each */
 	for (unsigned i = 0; i < _channel_count; i++)
 		_samples[i].am_data = _sample(_samples[i].am_channel);
@@ -242,9 +242,21 @@
 #endif
 
 /*
- * Queue of callout entries.
+ * Timer wheel of callout entries.
+ *
+ * Entries are hashed over the wheel by deadline, each slot holding a short
+ * deadline-ordered list.  Scheduling a call therefore only walks one slot's
+ * list rather than the whole callout population, which bounds the time spent
+ * with interrupts disabled when several drivers reschedule around the same
+ * time.  The slot is a pure hash; entries more than one revolution out are
+ * simply left in place until their absolute deadline comes due.
  */
-static struct sq_queue_s	callout_queue;
+#define HRT_WHEEL_SHIFT		10	/* 1024us of deadline per slot */
+#define HRT_WHEEL_SLOTS		32	/* must be a power of two */
+
+#define HRT_WHEEL_SLOT(deadline)	(((deadline) >> HRT_WHEEL_SHIFT) & (HRT_WHEEL_SLOTS - 1))
+
+static struct sq_queue_s	callout_wheel[HRT_WHEEL_SLOTS];
 
 /* latency baseline (last compare value applied) */
 static uint16_t			latency_baseline;
@@ -271,6 +283,7 @@ static void		hrt_call_internal(struct hrt_call *entry,
 		hrt_callout callout,
 		void *arg);
 static void		hrt_call_enter(struct hrt_call *entry);
+static struct hrt_call	*hrt_wheel_earliest(void);
 static void		hrt_call_reschedule(void);
 static void		hrt_call_invoke(void);
 
@@ -298,6 +311,7 @@ static void		hrt_call_invoke(void);
 # if HRT_PPM_CHANNEL == 1
 #  define rCCR_PPM	rCCR1			/* capture register for PPM */
 #  define DIER_PPM	GTIM_DIER_CC1IE		/* capture interrupt (non-DMA mode) */
+#  define DIER_PPM_DMA	GTIM_DIER_CC1DE		/* capture DMA request (DMA mode) */
 #  define SR_INT_PPM	GTIM_SR_CC1IF		/* capture interrupt (non-DMA mode) */
 #  define SR_OVF_PPM	GTIM_SR_CC1OF		/* capture overflow (non-DMA mode) */
 #  define CCMR1_PPM	1			/* not on TI1/TI2 */
@@ -307,6 +321,7 @@ static void		hrt_call_invoke(void);
 # elif HRT_PPM_CHANNEL == 2
 #  define rCCR_PPM	rCCR2			/* capture register for PPM */
 #  define DIER_PPM	GTIM_DIER_CC2IE		/* capture interrupt (non-DMA mode) */
+#  define DIER_PPM_DMA	GTIM_DIER_CC2DE		/* capture DMA request (DMA mode) */
 #  define SR_INT_PPM	GTIM_SR_CC2IF		/* capture interrupt (non-DMA mode) */
 #  define SR_OVF_PPM	GTIM_SR_CC2OF		/* capture overflow (non-DMA mode) */
 #  define CCMR1_PPM	2			/* not on TI1/TI2 */
@@ -316,6 +331,7 @@ static void		hrt_call_invoke(void);
 # elif HRT_PPM_CHANNEL == 3
 #  define rCCR_PPM	rCCR3			/* capture register for PPM */
 #  define DIER_PPM	GTIM_DIER_CC3IE		/* capture interrupt (non-DMA mode) */
+#  define DIER_PPM_DMA	GTIM_DIER_CC3DE		/* capture DMA request (DMA mode) */
 #  define SR_INT_PPM	GTIM_SR_CC3IF		/* capture interrupt (non-DMA mode) */
 #  define SR_OVF_PPM	GTIM_SR_CC3OF		/* capture overflow (non-DMA mode) */
 #  define CCMR1_PPM	0			/* not on TI1/TI2 */
@@ -325,6 +341,7 @@ static void		hrt_call_invoke(void);
 # elif HRT_PPM_CHANNEL == 4
 #  define rCCR_PPM	rCCR4			/* capture register for PPM */
 #  define DIER_PPM	GTIM_DIER_CC4IE		/* capture interrupt (non-DMA mode) */
+#  define DIER_PPM_DMA	GTIM_DIER_CC4DE		/* capture DMA request (DMA mode) */
 #  define SR_INT_PPM	GTIM_SR_CC4IF		/* capture interrupt (non-DMA mode) */
 #  define SR_OVF_PPM	GTIM_SR_CC4OF		/* capture overflow (non-DMA mode) */
 #  define CCMR1_PPM	0			/* not on TI1/TI2 */
@@ -335,6 +352,19 @@ static void		hrt_call_invoke(void);
 #  error HRT_PPM_CHANNEL must be a value between 1 and 4
 # endif
 
+/*
+ * On boards defining HRT_PPM_DMAMAP, the capture channel feeds a circular
+ * DMA buffer instead of raising an interrupt per edge, and the buffered
+ * edges are decoded in a single pass from a periodic callout.  A PPM frame
+ * costs around twenty edge interrupts in interrupt mode; DMA mode replaces
+ * them with a handful of drain callouts riding on the existing HRT tick.
+ *
+ * This requires both-edge capture, which the F1 timers cannot do.
+ */
+# if defined(HRT_PPM_DMAMAP) && defined(PPM_EDGE_FLIP)
+#  error HRT_PPM_DMAMAP requires both-edge capture which this timer does not support
+# endif
+
 /*
  * PPM decoder tuning parameters
  */
@@ -384,8 +414,24 @@ struct {
 	} phase;
 } ppm;
 
+static void	hrt_ppm_decode_edge(uint16_t count);
 static void	hrt_ppm_decode(uint32_t status);
 
+# ifdef HRT_PPM_DMAMAP
+
+/* sized to hold comfortably more than one frame's edges per drain interval */
+#  define PPM_DMA_BUFFER_SIZE	32		/**< captured edge timestamps */
+#  define PPM_DMA_DRAIN_INTERVAL 5000		/**< drain callout interval in microseconds */
+
+static uint16_t		ppm_dma_buffer[PPM_DMA_BUFFER_SIZE];
+static DMA_HANDLE	ppm_dma;
+static unsigned		ppm_dma_index;		/**< next buffer entry to decode */
+static struct hrt_call	ppm_dma_call;
+
+static void	hrt_ppm_dma_init(void);
+static void	hrt_ppm_dma_drain(void *arg);
+# endif
+
 #else
 /* disable the PPM configuration */
 # define rCCR_PPM	0
@@ -443,21 +489,84 @@ hrt_tim_init(void)
 }
 
 #ifdef HRT_PPM_CHANNEL
+
+# ifdef HRT_PPM_DMAMAP
+/**
+ * Set up DMA-driven PPM capture and the periodic drain callout.
+ */
+static void
+hrt_ppm_dma_init(void)
+{
+	ppm_dma = stm32_dmachannel(HRT_PPM_DMAMAP);
+
+	if (ppm_dma == NULL) {
+		/* no channel available, stay with per-edge interrupts */
+		return;
+	}
+
+	stm32_dmasetup(
+		ppm_dma,
+		(uint32_t)&rCCR_PPM,
+		(uint32_t)ppm_dma_buffer,
+		PPM_DMA_BUFFER_SIZE,
+		DMA_SCR_CIRC		|
+		DMA_SCR_DIR_P2M		|
+		DMA_SCR_MINC		|
+		DMA_SCR_PSIZE_16BITS	|
+		DMA_SCR_MSIZE_16BITS);
+	stm32_dmastart(ppm_dma, NULL, NULL, false);
+
+	/* captures feed the DMA stream instead of raising interrupts */
+	rDIER = (rDIER & ~DIER_PPM) | DIER_PPM_DMA;
+
+	hrt_call_every(&ppm_dma_call, PPM_DMA_DRAIN_INTERVAL, PPM_DMA_DRAIN_INTERVAL, hrt_ppm_dma_drain, NULL);
+}
+
 /**
- * Handle the PPM decoder state machine.
+ * Decode the edges the DMA engine has captured since the last drain.
+ *
+ * Runs as an HRT callout; each buffered edge goes through the same state
+ * machine as in interrupt mode, just batched in one pass.  Should the
+ * buffer ever overrun, the decoder resynchronises on the next start gap.
+ */
+static void
+hrt_ppm_dma_drain(void *arg)
+{
+	unsigned index = PPM_DMA_BUFFER_SIZE - stm32_dmaresidual(ppm_dma);
+
+	while (ppm_dma_index != index) {
+		hrt_ppm_decode_edge(ppm_dma_buffer[ppm_dma_index]);
+		ppm_dma_index = (ppm_dma_index + 1) % PPM_DMA_BUFFER_SIZE;
+	}
+}
+# endif /* HRT_PPM_DMAMAP */
+
+/**
+ * Handle the PPM decoder state machine (interrupt mode).
  */
 static void
 hrt_ppm_decode(uint32_t status)
 {
-	uint16_t count = rCCR_PPM;
+	/* if we missed an edge, we have to give up */
+	if (status & SR_OVF_PPM) {
+		ppm.phase = UNSYNCH;
+		ppm_decoded_channels = 0;
+		return;
+	}
+
+	hrt_ppm_decode_edge(rCCR_PPM);
+}
+
+/**
+ * Run one captured edge through the PPM decoder state machine.
+ */
+static void
+hrt_ppm_decode_edge(uint16_t count)
+{
 	uint16_t width;
 	uint16_t interval;
 	unsigned i;
 
-	/* if we missed an edge, we have to give up */
-	if (status & SR_OVF_PPM)
-		goto error;
-
 	/* how long since the last edge? - this handles counter wrapping implicitely. */
 	width = count - ppm.last_edge;
 
@@ -743,12 +852,19 @@ hrt_store_absolute_time(volatile hrt_abstime *now)
 void
 hrt_init(void)
 {
-	sq_init(&callout_queue);
+	for (unsigned i = 0; i < HRT_WHEEL_SLOTS; i++)
+		sq_init(&callout_wheel[i]);
+
 	hrt_tim_init();
 
 #ifdef HRT_PPM_CHANNEL
 	/* configure the PPM input pin */
 	stm32_configgpio(GPIO_PPM_IN);
+
+# ifdef HRT_PPM_DMAMAP
+	/* switch PPM capture to DMA batch mode */
+	hrt_ppm_dma_init();
+# endif
 #endif
 }
 
@@ -801,7 +917,7 @@ hrt_call_internal(struct hrt_call *entry, hrt_abstime deadline, hrt_abstime inte
 	   anything actually unsafe.
 	*/
 	if (entry->deadline != 0)
-		sq_rem(&entry->link, &callout_queue);
+		sq_rem(&entry->link, &callout_wheel[HRT_WHEEL_SLOT(entry->deadline)]);
 
 	entry->deadline = deadline;
 	entry->period = interval;
@@ -832,7 +948,7 @@ hrt_cancel(struct hrt_call *entry)
 {
 	irqstate_t flags = irqsave();
 
-	sq_rem(&entry->link, &callout_queue);
+	sq_rem(&entry->link, &callout_wheel[HRT_WHEEL_SLOT(entry->deadline)]);
 	entry->deadline = 0;
 
 	/* if this is a periodic call being removed by the callout, prevent it from
@@ -846,15 +962,13 @@ hrt_cancel(struct hrt_call *entry)
 static void
 hrt_call_enter(struct hrt_call *entry)
 {
+	struct sq_queue_s *slot = &callout_wheel[HRT_WHEEL_SLOT(entry->deadline)];
 	struct hrt_call	*call, *next;
 
-	call = (struct hrt_call *)sq_peek(&callout_queue);
+	call = (struct hrt_call *)sq_peek(slot);
 
 	if ((call == NULL) || (entry->deadline < call->deadline)) {
-		sq_addfirst(&entry->link, &callout_queue);
-		//lldbg("call enter at head, reschedule\n");
-		/* we changed the next deadline, reschedule the timer event */
-		hrt_call_reschedule();
+		sq_addfirst(&entry->link, slot);
 
 	} else {
 		do {
@@ -862,15 +976,42 @@ hrt_call_enter(struct hrt_call *entry)
 
 			if ((next == NULL) || (entry->deadline < next->deadline)) {
 				//lldbg("call enter after head\n");
-				sq_addafter(&call->link, &entry->link, &callout_queue);
+				sq_addafter(&call->link, &entry->link, slot);
 				break;
 			}
 		} while ((call = next) != NULL);
 	}
 
+	/* if we changed the overall next deadline, reschedule the timer event */
+	if (hrt_wheel_earliest() == entry)
+		hrt_call_reschedule();
+
 	//lldbg("scheduled\n");
 }
 
+/**
+ * Find the queued call with the earliest deadline.
+ *
+ * Slot lists are deadline-ordered, so this only looks at the head of
+ * each slot.
+ *
+ * This routine must be called with interrupts disabled.
+ */
+static struct hrt_call *
+hrt_wheel_earliest(void)
+{
+	struct hrt_call	*earliest = NULL;
+
+	for (unsigned i = 0; i < HRT_WHEEL_SLOTS; i++) {
+		struct hrt_call *call = (struct hrt_call *)sq_peek(&callout_wheel[i]);
+
+		if ((call != NULL) && ((earliest == NULL) || (call->deadline < earliest->deadline)))
+			earliest = call;
+	}
+
+	return earliest;
+}
+
 static void
 hrt_call_invoke(void)
 {
@@ -881,7 +1022,7 @@ hrt_call_invoke(void)
 		/* get the current time */
 		hrt_abstime now = hrt_absolute_time();
 
-		call = (struct hrt_call *)sq_peek(&callout_queue);
+		call = hrt_wheel_earliest();
 
 		if (call == NULL)
 			break;
@@ -889,7 +1030,7 @@ hrt_call_invoke(void)
 		if (call->deadline > now)
 			break;
 
-		sq_rem(&call->link, &callout_queue);
+		sq_rem(&call->link, &callout_wheel[HRT_WHEEL_SLOT(call->deadline)]);
 		//lldbg("call pop\n");
 
 		/* save the intended deadline for periodic calls */
@@ -927,7 +1068,7 @@ static void
 hrt_call_reschedule()
 {
 	hrt_abstime	now = hrt_absolute_time();
-	struct hrt_call	*next = (struct hrt_call *)sq_peek(&callout_queue);
+	struct hrt_call	*next = hrt_wheel_earliest();
 	hrt_abstime	deadline = now + HRT_INTERVAL_MAX;
 
 	/*
@@ -94,6 +94,9 @@ static void		pwm_timer_init(unsigned timer);
 static void		pwm_timer_set_rate(unsigned timer, unsigned rate);
 static void		pwm_channel_init(unsigned channel);
 
+/** true while the timers run in OneShot (pulse per trigger) mode */
+static bool		pwm_oneshot_mode = false;
+
 static void
 pwm_timer_init(unsigned timer)
 {
@@ -212,6 +215,105 @@ up_pwm_servo_set(unsigned channel, servo_position_t value)
 	return 0;
 }
 
+int
+up_pwm_servo_set_multi(const servo_position_t *values, unsigned count)
+{
+	uint32_t timer_mask = 0;
+	int ret = OK;
+
+	if (count > PWM_SERVO_MAX_CHANNELS)
+		count = PWM_SERVO_MAX_CHANNELS;
+
+	/* work out which timers the channels live on */
+	for (unsigned i = 0; i < count; i++) {
+		unsigned timer = pwm_channels[i].timer_index;
+
+		if ((pwm_timers[timer].base != 0) && (pwm_channels[i].gpio != 0))
+			timer_mask |= (1 << timer);
+	}
+
+	/*
+	 * Write all compare registers with update events held off, so that
+	 * every channel latches its new value at the same (next) update event
+	 * per timer rather than skewing across periods as the individual
+	 * writes race the counters.
+	 */
+	irqstate_t flags = irqsave();
+
+	for (unsigned i = 0; i < PWM_SERVO_MAX_TIMERS; i++) {
+		if (timer_mask & (1 << i))
+			rCR1(i) |= GTIM_CR1_UDIS;
+	}
+
+	for (unsigned i = 0; i < count; i++) {
+		if (up_pwm_servo_set(i, values[i]) != OK)
+			ret = ERROR;
+	}
+
+	for (unsigned i = 0; i < PWM_SERVO_MAX_TIMERS; i++) {
+		if (timer_mask & (1 << i))
+			rCR1(i) &= ~GTIM_CR1_UDIS;
+	}
+
+	irqrestore(flags);
+
+	return ret;
+}
+
+int
+up_pwm_servo_set_oneshot_mode(bool enable)
+{
+	pwm_oneshot_mode = enable;
+
+	for (unsigned i = 0; i < PWM_SERVO_MAX_TIMERS; i++) {
+		if (pwm_timers[i].base == 0)
+			continue;
+
+		if (enable) {
+			/* count in 1/8 us steps so the usual 1000..2000
+			 * values come out as 125..250 us OneShot125 pulses */
+			rPSC(i) = (pwm_timers[i].clock_freq / 8000000) - 1;
+
+			/* free-run the full 16 bit range; the pulse starts
+			 * when the trigger resets the counter. The 8.2 ms
+			 * natural wrap only matters when no trigger arrives
+			 * and then acts as a ~122 Hz keep-alive repeating
+			 * the last values, like periodic PWM would */
+			rARR(i) = 0xffff;
+
+		} else {
+			/* back to the 1MHz base the rate setters expect */
+			rPSC(i) = (pwm_timers[i].clock_freq / 1000000) - 1;
+			pwm_timer_set_rate(i, 50);
+		}
+
+		rEGR(i) = GTIM_EGR_UG;
+	}
+
+	return OK;
+}
+
+void
+up_pwm_servo_trigger(void)
+{
+	if (!pwm_oneshot_mode)
+		return;
+
+	/*
+	 * Reset all counters back-to-back with interrupts held off: this
+	 * latches the preloaded compare values and starts one synchronized
+	 * pulse on every timer, right now rather than at the next frame.
+	 */
+	irqstate_t flags = irqsave();
+
+	for (unsigned i = 0; i < PWM_SERVO_MAX_TIMERS; i++) {
+		if (pwm_timers[i].base != 0)
+			rEGR(i) = GTIM_EGR_UG;
+	}
+
+	irqrestore(flags);
+}
+
 servo_position_t
 up_pwm_servo_get(unsigned channel)
 {
@@ -220,6 +220,24 @@
 #define rDCR     	REG(STM32_GTIM_DCR_OFFSET)
 #define rDMAR    	REG(STM32_GTIM_DMAR_OFFSET)
 
+/*
+ * One step of a precompiled tune; the timer program for the step and
+ * the time for which it is held.
+ */
+struct tune_step_s {
+	uint32_t	duration;	// microseconds to hold this step, zero terminates the tune
+	uint16_t	prescale;	// timer prescaler while the step plays
+	uint16_t	period;		// timer toggle period, zero keeps the output silent
+};
+
+/*
+ * A precompiled tune; a step array terminated by a zero-duration step.
+ */
+struct tune_program_s {
+	tune_step_s	*steps;
+	bool		repeat;		// if true, the tune restarts when it ends
+};
+
 class ToneAlarm : public device::CDev
 {
 public:
@@ -242,17 +260,19 @@ private:
 
 	unsigned		_default_tune_number; // number of currently playing default tune (0 for none)
 
-	const char		*_user_tune;
+	tune_program_s		_programs[TONE_NUMBER_OF_TUNES]; // default tunes, precompiled at init time
+	tune_program_s		_user_program;	// the user-supplied tune, precompiled when written
 
-	const char		*_tune;		// current tune string
-	const char		*_next;		// next note in the string
+	const tune_step_s	*_steps;	// program currently playing (nullptr for none)
+	unsigned		_step;		// next step in the program
+	bool			_repeat;	// if true, tune restarts at end
 
+	// parser state, only used while compiling a tune
+	const char		*_next;		// next character in the string
 	unsigned		_tempo;
 	unsigned		_note_length;
 	enum { MODE_NORMAL, MODE_LEGATO, MODE_STACCATO} _note_mode;
 	unsigned		_octave;
-	unsigned		_silence_length; // if nonzero, silence before next note
-	bool			_repeat;	// if true, tune restarts at end
 
 	hrt_call		_note_call;	// HRT callout for note completion
 
@@ -272,21 +292,31 @@ private:
 	//
 	unsigned		rest_duration(unsigned rest_length, unsigned dots);
 
-	// Start playing the note
+	// Program the timer to play a precompiled note
 	//
-	void			start_note(unsigned note);
+	void			start_note(uint16_t prescale, uint16_t period);
 
 	// Stop playing the current note and make the player 'safe'
 	//
 	void			stop_note();
 
-	// Start playing the tune
+	// Compile a tune string into a timer program
 	//
-	void			start_tune(const char *tune);
+	int			compile_tune(const char *tune, tune_program_s &prog);
 
-	// Parse the next note out of the string and play it
+	// Append a step to a program under construction, growing the
+	// step array as required
 	//
-	void			next_note();
+	int			emit_step(tune_step_s **steps, unsigned &avail, unsigned &count,
+					unsigned duration, unsigned prescale, unsigned period);
+
+	// Start playing a precompiled tune
+	//
+	void			start_program(const tune_program_s &prog);
+
+	// Play the next step of the current program
+	//
+	void			next_step();
 
 	// Find the next character in the string, discard any whitespace and
 	// return the canonical (uppercase) version.
@@ -301,7 +331,7 @@ private:
 	//
 	unsigned		next_dots();
 
-	// hrt_call trampoline for next_note
+	// hrt_call trampoline for next_step
 	//
 	static void		next_trampoline(void *arg);
 
@@ -319,12 +349,15 @@ extern "C" __EXPORT int tone_alarm_main(int argc, char *argv[]);
 ToneAlarm::ToneAlarm() :
 	CDev("tone_alarm", TONEALARM0_DEVICE_PATH),
 	_default_tune_number(0),
-	_user_tune(nullptr),
-	_tune(nullptr),
+	_user_program(),
+	_steps(nullptr),
+	_step(0),
+	_repeat(false),
 	_next(nullptr)
 {
 	// enable debug() calls
 	//_debug_enabled = true;
+	memset(_programs, 0, sizeof(_programs));
 	_default_tunes[TONE_STARTUP_TUNE] = "MFT240L8 O4aO5dc O4aO5dc O4aO5dc L16dcdcdcdc";		// startup tune
 	_default_tunes[TONE_ERROR_TUNE] = "MBT200a8a8a8PaaaP";						// ERROR tone
 	_default_tunes[TONE_NOTIFY_POSITIVE_TUNE] = "MFT200e8a8a";					// Notify Positive tone
@@ -358,6 +391,10 @@ ToneAlarm::ToneAlarm() :
 
 ToneAlarm::~ToneAlarm()
 {
+	for (unsigned i = 0; i < TONE_NUMBER_OF_TUNES; i++)
+		free(_programs[i].steps);
+
+	free(_user_program.steps);
 }
 
 int
@@ -396,6 +433,18 @@ ToneAlarm::init()
 	/* make sure the timer is running */
 	rCR1 = GTIM_CR1_CEN;
 
+	/*
+	 * Precompile the default tunes so that starting one from a hot path
+	 * costs a timer reprogram rather than string parsing in the HRT
+	 * callout.
+	 */
+	for (unsigned i = 1; i < TONE_NUMBER_OF_TUNES; i++) {
+		ret = compile_tune(_default_tunes[i], _programs[i]);
+
+		if (ret != OK)
+			return ret;
+	}
+
 	debug("ready");
 	return OK;
 }
@@ -466,18 +515,8 @@ ToneAlarm::rest_duration(unsigned rest_length, unsigned dots)
 }
 
 void
-ToneAlarm::start_note(unsigned note)
+ToneAlarm::start_note(uint16_t prescale, uint16_t period)
 {
-	// compute the divisor
-	unsigned divisor = note_to_divisor(note);
-
-	// pick the lowest prescaler value that we can use
-	// (note that the effective prescale value is 1 greater)
-	unsigned prescale = divisor / 65536;
-
-	// calculate the timer period for the selected prescaler value
-	unsigned period = (divisor / (prescale + 1)) - 1;
-
 	rPSC = prescale;	// load new prescaler
 	rARR = period;		// load new toggle period
 	rEGR = GTIM_EGR_UG;	// force a reload of the period
@@ -499,55 +538,54 @@ ToneAlarm::stop_note()
 	stm32_configgpio(GPIO_TONE_ALARM_IDLE);
 }
 
-void
-ToneAlarm::start_tune(const char *tune)
+int
+ToneAlarm::emit_step(tune_step_s **steps, unsigned &avail, unsigned &count,
+	unsigned duration, unsigned prescale, unsigned period)
 {
-	// kill any current playback
-	hrt_cancel(&_note_call);
+	if (count == avail) {
+		unsigned navail = avail + 16;
+		tune_step_s *nsteps = (tune_step_s *)realloc(*steps, navail * sizeof(tune_step_s));
 
-	// record the tune
-	_tune = tune;
-	_next = tune;
+		if (nsteps == nullptr)
+			return -ENOMEM;
 
-	// initialise player state
-	_tempo = 120;
-	_note_length = 4;
-	_note_mode = MODE_NORMAL;
-	_octave = 4;
-	_silence_length = 0;
-	_repeat = false;		// otherwise command-line tunes repeat forever...
+		*steps = nsteps;
+		avail = navail;
+	}
 
-	// schedule a callback to start playing
-	hrt_call_after(&_note_call, 0, (hrt_callout)next_trampoline, this);
+	(*steps)[count].duration = duration;
+	(*steps)[count].prescale = prescale;
+	(*steps)[count].period = period;
+	count++;
+
+	return OK;
 }
 
-void
-ToneAlarm::next_note()
+int
+ToneAlarm::compile_tune(const char *tune, tune_program_s &prog)
 {
-	// do we have an inter-note gap to wait for?
-	if (_silence_length > 0) {
-		stop_note();
-		hrt_call_after(&_note_call, (hrt_abstime)_silence_length, (hrt_callout)next_trampoline, this);
-		_silence_length = 0;
-		return;
-	}
+	tune_step_s *steps = nullptr;
+	unsigned avail = 0;
+	unsigned count = 0;
+	bool repeat = false;
+	int ret;
 
-	// make sure we still have a tune - may be removed by the write / ioctl handler
-	if ((_next == nullptr) || (_tune == nullptr)) {
-		stop_note();
-		return;
-	}
+	// initialise parser state
+	_next = tune;
+	_tempo = 120;
+	_note_length = 4;
+	_note_mode = MODE_NORMAL;
+	_octave = 4;
 
-	// parse characters out of the string until we have resolved a note
-	unsigned note = 0;
-	unsigned note_length = _note_length;
-	unsigned duration;
+	// parse the whole string, emitting one step per note or rest
+	for (;;) {
+		unsigned note = 0;
+		unsigned note_length = _note_length;
 
-	while (note == 0) {
 		// we always need at least one character from the string
 		int c = next_char();
 		if (c == 0)
-			goto tune_end;
+			break;
 		_next++;
 
 		switch (c) {
@@ -589,10 +627,10 @@ ToneAlarm::next_note()
 				_note_mode = MODE_STACCATO;
 				break;
 			case 'F':
-				_repeat = false;
+				repeat = false;
 				break;
 			case 'B':
-				_repeat = true;
+				repeat = true;
 				break;
 			default:
 				goto tune_error;
@@ -600,12 +638,11 @@ ToneAlarm::next_note()
 			break;
 
 		case 'P':	// pause for a note length
-			stop_note();
-			hrt_call_after(&_note_call, 
-				(hrt_abstime)rest_duration(next_number(), next_dots()),
-				(hrt_callout)next_trampoline, 
-				this);
-			return;
+			ret = emit_step(&steps, avail, count,
+				rest_duration(next_number(), next_dots()), 0, 0);
+			if (ret != OK)
+				goto alloc_error;
+			break;
 
 		case 'T': {	// change tempo
 			unsigned nt = next_number();
@@ -624,11 +661,10 @@ ToneAlarm::next_note()
 				goto tune_error;
 			if (note == 0) {
 				// this is a rest - pause for the current note length
-				hrt_call_after(&_note_call,
-					(hrt_abstime)rest_duration(_note_length, next_dots()),
-					(hrt_callout)next_trampoline, 
-					this);
-				return;				
+				ret = emit_step(&steps, avail, count,
+					rest_duration(_note_length, next_dots()), 0, 0);
+				if (ret != OK)
+					goto alloc_error;
 			}
 			break;
 
@@ -660,33 +696,104 @@ ToneAlarm::next_note()
 		default:
 			goto tune_error;
 		}
-	}
 
-	// compute the duration of the note and the following silence (if any)
-	duration = note_duration(_silence_length, note_length, next_dots());
+		if (note == 0)
+			continue;
+
+		// compute the duration of the note and the following silence (if any)
+		unsigned silence;
+		unsigned duration = note_duration(silence, note_length, next_dots());
 
-	// start playing the note
-	start_note(note);
+		// precompute the timer program for the note
+		// (note that the effective prescale value is 1 greater)
+		unsigned divisor = note_to_divisor(note);
+		unsigned prescale = divisor / 65536;
+		unsigned period = (divisor / (prescale + 1)) - 1;
 
-	// and arrange a callback when the note should stop
-	hrt_call_after(&_note_call, (hrt_abstime)duration, (hrt_callout)next_trampoline, this);
-	return;
+		ret = emit_step(&steps, avail, count, duration, prescale, period);
+		if (ret != OK)
+			goto alloc_error;
+
+		// the inter-note gap is a silent step of its own
+		if (silence > 0) {
+			ret = emit_step(&steps, avail, count, silence, 0, 0);
+			if (ret != OK)
+				goto alloc_error;
+		}
+	}
+	goto tune_end;
 
 	// tune looks bad (unexpected EOF, bad character, etc.)
 tune_error:
 	lowsyslog("tune error\n");
-	_repeat = false;		// don't loop on error
+	repeat = false;		// don't loop on error
 
-	// stop (and potentially restart) the tune
+	// terminate the program with what we have so far
 tune_end:
-	stop_note();
-	if (_repeat) {
-		start_tune(_tune);
+	ret = emit_step(&steps, avail, count, 0, 0, 0);
+	if (ret != OK)
+		goto alloc_error;
+
+	prog.steps = steps;
+	prog.repeat = repeat;
+	return OK;
+
+alloc_error:
+	free(steps);
+	prog.steps = nullptr;
+	prog.repeat = false;
+	return ret;
+}
+
+void
+ToneAlarm::start_program(const tune_program_s &prog)
+{
+	// kill any current playback
+	hrt_cancel(&_note_call);
+
+	// point the player at the program
+	_steps = prog.steps;
+	_step = 0;
+	_repeat = prog.repeat;
+
+	// schedule a callback to start playing
+	hrt_call_after(&_note_call, 0, (hrt_callout)next_trampoline, this);
+}
+
+void
+ToneAlarm::next_step()
+{
+	// make sure we still have a program - may be removed by the write / ioctl handler
+	if (_steps == nullptr) {
+		stop_note();
+		return;
+	}
+
+	const tune_step_s &step = _steps[_step];
+
+	// end of the program - stop, and restart if the tune repeats
+	if (step.duration == 0) {
+		stop_note();
+		if (_repeat) {
+			_step = 0;
+			hrt_call_after(&_note_call, 0, (hrt_callout)next_trampoline, this);
+		} else {
+			_steps = nullptr;
+			_default_tune_number = 0;
+		}
+		return;
+	}
+
+	// program the timer for the note, or silence the output for a rest
+	if (step.period > 0) {
+		start_note(step.prescale, step.period);
 	} else {
-		_tune = nullptr;
-		_default_tune_number = 0;
+		stop_note();
 	}
-	return;
+
+	// and arrange a callback when the step should end
+	_step++;
+	hrt_call_after(&_note_call, (hrt_abstime)step.duration, (hrt_callout)next_trampoline, this);
 }
 
 int
@@ -730,7 +837,7 @@ ToneAlarm::next_trampoline(void *arg)
 {
 	ToneAlarm *ta = (ToneAlarm *)arg;
 
-	ta->next_note();
+	ta->next_step();
 }
 
 
@@ -751,8 +858,7 @@ ToneAlarm::ioctl(file *filp, int cmd, unsigned long arg)
 		if (arg < TONE_NUMBER_OF_TUNES) {
 			if (arg == TONE_STOP_TUNE) {
 				// stop the tune
-				_tune = nullptr;
-				_next = nullptr;
+				_steps = nullptr;
 				_repeat = false;
 				_default_tune_number = 0;
 			} else {
@@ -760,7 +866,7 @@ ToneAlarm::ioctl(file *filp, int cmd, unsigned long arg)
 				if (!(_repeat && _default_tune_number == arg)) {
 					/* play the selected tune */
 					_default_tune_number = arg;
-					start_tune(_default_tunes[arg]);
+					start_program(_programs[arg]);
 				}
 			}
 		} else {
@@ -791,30 +897,38 @@ ToneAlarm::write(file *filp, const char *buffer, size_t len)
 		return -EFBIG;
 
 	// if we have an existing user tune, free it
-	if (_user_tune != nullptr) {
+	if (_user_program.steps != nullptr) {
 
 		// if we are playing the user tune, stop
-		if (_tune == _user_tune) {
-			_tune = nullptr;
-			_next = nullptr;
+		if (_steps == _user_program.steps) {
+			hrt_cancel(&_note_call);
+			stop_note();
+			_steps = nullptr;
 		}
 
-		// free the old user tune
-		free((void *)_user_tune);
-		_user_tune = nullptr;
+		// free the old user program
+		free(_user_program.steps);
+		_user_program.steps = nullptr;
 	}
 
 	// if the new tune is empty, we're done
 	if (buffer[0] == '\0')
 		return OK;
 
-	// allocate a copy of the new tune
-	_user_tune = strndup(buffer, len);
-	if (_user_tune == nullptr)
+	// compile the new tune from a bounded copy of the buffer
+	char *tune = strndup(buffer, len);
+	if (tune == nullptr)
 		return -ENOMEM;
 
+	int ret = compile_tune(tune, _user_program);
+	free(tune);
+
+	if (ret != OK)
+		return ret;
+
 	// and play it
-	start_tune(_user_tune);
+	_default_tune_number = 0;
+	start_program(_user_program);
 
 	return len;
 }
@@ -64,6 +64,7 @@
 
 #include <drivers/drv_hrt.h>
 #include <drivers/drv_range_finder.h>
+#include <drivers/device/i2c_scheduler.h>
 #include <drivers/device/ringbuffer.h>
 
 #include <uORB/uORB.h>
@@ -121,7 +122,6 @@ protected:
 private:
 	float				_min_distance;
 	float				_max_distance;
-	work_s				_work;
 	RingBuffer			*_reports;
 	bool				_sensor_ok;
 	int					_measure_ticks;
@@ -246,8 +246,6 @@ TRONE::TRONE(int bus, int address) :
 	// enable debug() calls
 	_debug_enabled = false;
 
-	// work_cancel in the dtor will explode if we don't do this...
-	memset(&_work, 0, sizeof(_work));
 }
 
 TRONE::~TRONE()
@@ -605,7 +603,7 @@ TRONE::start()
 	_reports->flush();
 
 	/* schedule a cycle to start things */
-	work_queue(HPWORK, &_work, (worker_t)&TRONE::cycle_trampoline, this, 1);
+	device::I2CScheduler::schedule(_bus, (worker_t)&TRONE::cycle_trampoline, this, 1);
 
 	/* notify about state change */
 	struct subsystem_info_s info = {
@@ -627,7 +625,7 @@ TRONE::start()
 void
 TRONE::stop()
 {
-	work_cancel(HPWORK, &_work);
+	device::I2CScheduler::cancel((worker_t)&TRONE::cycle_trampoline, this);
 }
 
 void
@@ -660,8 +658,7 @@ TRONE::cycle()
 		 */
 		if (_measure_ticks > USEC2TICK(TRONE_CONVERSION_INTERVAL)) {
 			/* schedule a fresh cycle call when we are ready to measure again */
-			work_queue(HPWORK,
-				&_work,
+			device::I2CScheduler::schedule(_bus,
 				(worker_t)&TRONE::cycle_trampoline,
 				this,
 				_measure_ticks - USEC2TICK(TRONE_CONVERSION_INTERVAL));
@@ -679,8 +676,7 @@ TRONE::cycle()
 	_collect_phase = true;
 
 	/* schedule a fresh cycle call when the measurement is done */
-	work_queue(HPWORK,
-		&_work,
+	device::I2CScheduler::schedule(_bus,
 		(worker_t)&TRONE::cycle_trampoline,
 		this,
 		USEC2TICK(TRONE_CONVERSION_INTERVAL));
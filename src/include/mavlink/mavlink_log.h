@@ -45,6 +45,7 @@
  * IOCTL interface for sending log messages.
  */
 #include <sys/ioctl.h>
+#include <stdint.h>
 
 /**
  * The mavlink log device node; must be opened before messages
@@ -59,11 +60,31 @@
 #define MAVLINK_IOC_SEND_TEXT_INFO		_IOC(0x1100, 1)
 #define MAVLINK_IOC_SEND_TEXT_CRITICAL		_IOC(0x1100, 2)
 #define MAVLINK_IOC_SEND_TEXT_EMERGENCY		_IOC(0x1100, 3)
+#define MAVLINK_IOC_SEND_TEXT_DEFERRED		_IOC(0x1100, 4)
+
+/**
+ * Argument slots carried by a deferred log message.
+ */
+#define MAVLINK_LOG_MAX_DEFERRED_ARGS		4
+
+/**
+ * Transfer struct for MAVLINK_IOC_SEND_TEXT_DEFERRED: the call site only
+ * records the format pointer and the raw argument words, formatting
+ * happens later in the mavlink task when the message is drained.
+ */
+struct mavlink_deferred_logmessage {
+	const char *fmt;				/**< format string, must be a persistent literal */
+	uintptr_t args[MAVLINK_LOG_MAX_DEFERRED_ARGS];	/**< integer/pointer arguments */
+	unsigned argc;					/**< number of valid entries in args[] */
+	int severity;					/**< one of the MAVLINK_IOC_SEND_TEXT_* ioctls */
+};
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 __EXPORT void mavlink_vasprintf(int _fd, int severity, const char *fmt, ...);
+__EXPORT void mavlink_log_deferred(int _fd, int severity, const char *fmt,
+				   const uintptr_t *args, unsigned argc);
 #ifdef __cplusplus
 }
 #endif
@@ -132,9 +153,65 @@ __EXPORT void mavlink_vasprintf(int _fd, int severity, const char *fmt, ...);
 									fprintf(stderr, _text, ##__VA_ARGS__); \
 									fprintf(stderr, "\n");
 
+/*
+ * Deferred-format variants: the call site stores the format pointer and the
+ * argument words and returns, the text is rendered in the mavlink task when
+ * the message is sent. Use these from hot loops where the vsnprintf of the
+ * plain variants is too expensive.
+ *
+ * Restrictions: _text must be a string literal (the pointer is kept, not the
+ * contents), at most MAVLINK_LOG_MAX_DEFERRED_ARGS arguments, and only
+ * integer and pointer arguments are supported - a float argument fails to
+ * compile, which is intentional.
+ */
+#define _mavlink_log_deferred(_fd, _severity, _text, ...)	do { \
+									const uintptr_t _args[] = { __VA_ARGS__ }; \
+									mavlink_log_deferred(_fd, _severity, _text, _args, \
+											     sizeof(_args) / sizeof(_args[0])); \
+								} while (0)
+
+/**
+ * Record a mavlink emergency message for deferred formatting.
+ *
+ * @param _fd		A file descriptor returned from open(MAVLINK_LOG_DEVICE, 0);
+ * @param _text		The format string literal; integer/pointer arguments only.
+ */
+#define mavlink_log_emergency_deferred(_fd, _text, ...)		_mavlink_log_deferred(_fd, MAVLINK_IOC_SEND_TEXT_EMERGENCY, _text, ##__VA_ARGS__)
+
+/**
+ * Record a mavlink critical message for deferred formatting.
+ *
+ * @param _fd		A file descriptor returned from open(MAVLINK_LOG_DEVICE, 0);
+ * @param _text		The format string literal; integer/pointer arguments only.
+ */
+#define mavlink_log_critical_deferred(_fd, _text, ...)		_mavlink_log_deferred(_fd, MAVLINK_IOC_SEND_TEXT_CRITICAL, _text, ##__VA_ARGS__)
+
+/**
+ * Record a mavlink info message for deferred formatting.
+ *
+ * @param _fd		A file descriptor returned from open(MAVLINK_LOG_DEVICE, 0);
+ * @param _text		The format string literal; integer/pointer arguments only.
+ */
+#define mavlink_log_info_deferred(_fd, _text, ...)		_mavlink_log_deferred(_fd, MAVLINK_IOC_SEND_TEXT_INFO, _text, ##__VA_ARGS__)
+
+/**
+ * Severity values follow the MAVLink convention: lower numeric value
+ * means more severe. Messages at or below this threshold are never
+ * dropped from a full buffer; a less severe entry is evicted instead.
+ */
+#define MAVLINK_LOG_SEVERITY_CRITICAL		2
+
+/**
+ * Duplicates of the last message arriving within this window (us) are
+ * folded into a repeat counter instead of occupying buffer slots.
+ */
+#define MAVLINK_LOG_FOLD_INTERVAL		1000000
+
 struct mavlink_logmessage {
 	char text[MAVLINK_LOG_MAXLEN + 1];
 	unsigned char severity;
+	const char *fmt;				/**< deferred format string, NULL if text[] is already formatted */
+	uintptr_t args[MAVLINK_LOG_MAX_DEFERRED_ARGS];	/**< arguments for a deferred entry */
 };
 
 struct mavlink_logbuffer {
@@ -142,6 +219,10 @@ struct mavlink_logbuffer {
 	unsigned int size;
 	int count;
 	struct mavlink_logmessage *elems;
+	unsigned int dropped;			/**< messages lost before reaching the link */
+	unsigned int last_repeats;		/**< folded duplicates of the last message */
+	uint64_t last_time;			/**< arrival time of the last message (us) */
+	struct mavlink_logmessage last;		/**< last message, for duplicate folding */
 };
 
 __BEGIN_DECLS
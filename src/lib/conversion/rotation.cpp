@@ -43,11 +43,25 @@
 __EXPORT void
 get_rot_matrix(enum Rotation rot, math::Matrix<3,3> *rot_matrix)
 {
-	float roll  = M_DEG_TO_RAD_F * (float)rot_lookup[rot].roll;
-	float pitch = M_DEG_TO_RAD_F * (float)rot_lookup[rot].pitch;
-	float yaw   = M_DEG_TO_RAD_F * (float)rot_lookup[rot].yaw;
+	/* derive the matrix columns by rotating the basis vectors with the
+	 * exact per-case implementation in rotate_3f(); unlike going through
+	 * from_euler() this yields exact 0 / +-1 / +-sqrt(2)/2 entries with
+	 * no runtime trigonometry */
+	float m[3][3];
 
-	rot_matrix->from_euler(roll, pitch, yaw);
+	for (unsigned column = 0; column < 3; column++) {
+		float x = (column == 0) ? 1.0f : 0.0f;
+		float y = (column == 1) ? 1.0f : 0.0f;
+		float z = (column == 2) ? 1.0f : 0.0f;
+
+		rotate_3f(rot, x, y, z);
+
+		m[0][column] = x;
+		m[1][column] = y;
+		m[2][column] = z;
+	}
+
+	rot_matrix->set(m);
 }
 
 #define HALF_SQRT_2 0.70710678118654757f
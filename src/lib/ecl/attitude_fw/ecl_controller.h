@@ -75,6 +75,8 @@ struct ECL_ControlData {
 	float airspeed_max;
 	float airspeed;
 	float scaler;
+	float scaler2;		/**< scaler squared, filled in once per cycle by the caller */
+	float inv_airspeed;	/**< 1 / validated airspeed, filled in once per cycle by the caller */
 	bool lock_integrator;
 };
 
@@ -94,11 +94,10 @@ float ECL_PitchController::control_attitude(const struct ECL_ControlData &ctl_da
 		}
 	}
 
-	/* input conditioning */
-	float airspeed = constrain_airspeed(ctl_data.airspeed, ctl_data.airspeed_min, ctl_data.airspeed_max);
-	/* calculate the offset in the rate resulting from rolling  */
+	/* calculate the offset in the rate resulting from rolling; the caller
+	 * validates the airspeed and precomputes its inverse once per cycle */
 	//xxx needs explanation and conversion to body angular rates or should be removed
-	float turn_offset = fabsf((CONSTANTS_ONE_G / airspeed) *
+	float turn_offset = fabsf((CONSTANTS_ONE_G * ctl_data.inv_airspeed) *
 				  tanf(roll) * sinf(roll)) * _roll_ff;
 
 	if (inverted) {
@@ -191,7 +190,7 @@ float ECL_PitchController::control_bodyrate(const struct ECL_ControlData &ctl_da
 
 	/* Apply PI rate controller and store non-limited output */
 	_last_output = _bodyrate_setpoint * _k_ff * ctl_data.scaler +
-		       _rate_error * _k_p * ctl_data.scaler * ctl_data.scaler
+		       _rate_error * _k_p * ctl_data.scaler2
 		       + integrator_constrained;  //scaler is proportional to 1/airspeed
 //	warnx("pitch: _integrator: %.4f, _integrator_max: %.4f, airspeed %.4f, _k_i %.4f, _k_p: %.4f", (double)_integrator, (double)_integrator_max, (double)airspeed, (double)_k_i, (double)_k_p);
 //	warnx("roll: _last_output %.4f", (double)_last_output);
@@ -95,8 +95,8 @@ void ECL_L1_Pos_Controller::navigate_waypoints(const math::Vector<2> &vector_A,
 	float xtrack_vel;
 	float ltrack_vel;
 
-	/* get the direction between the last (visited) and next waypoint */
-	_target_bearing = get_bearing_to_next_waypoint(vector_curr_position(0), vector_curr_position(1), vector_B(0), vector_B(1));
+	/* refresh the cached per-pair intermediates if the waypoints changed */
+	update_track_cache(vector_A, vector_B);
 
 	/* enforce a minimum ground speed of 0.1 m/s to avoid singularities */
 	float ground_speed = math::max(ground_speed_vector.length(), 0.1f);
@@ -104,21 +104,20 @@ void ECL_L1_Pos_Controller::navigate_waypoints(const math::Vector<2> &vector_A,
 	/* calculate the L1 length required for the desired period */
 	_L1_distance = _L1_ratio * ground_speed;
 
-	/* calculate vector from A to B */
-	math::Vector<2> vector_AB = get_local_planar_vector(vector_A, vector_B);
+	/* normalized vector from A to B, precomputed per waypoint pair */
+	math::Vector<2> vector_AB = _vector_AB;
 
 	/*
 	 * check if waypoints are on top of each other. If yes,
 	 * skip A and directly continue to B
 	 */
-	if (vector_AB.length() < 1.0e-6f) {
-		vector_AB = get_local_planar_vector(vector_curr_position, vector_B);
+	if (!_vector_AB_valid) {
+		vector_AB = get_local_planar_vector(vector_curr_position, vector_B, _cos_lat_B);
+		vector_AB.normalize();
 	}
 
-	vector_AB.normalize();
-
 	/* calculate the vector from waypoint A to the aircraft */
-	math::Vector<2> vector_A_to_airplane = get_local_planar_vector(vector_A, vector_curr_position);
+	math::Vector<2> vector_A_to_airplane = get_local_planar_vector(vector_A, vector_curr_position, _cos_lat_A);
 
 	/* calculate crosstrack error (output only) */
 	_crosstrack_error = vector_AB % vector_A_to_airplane;
@@ -132,8 +131,16 @@ void ECL_L1_Pos_Controller::navigate_waypoints(const math::Vector<2> &vector_A,
 	float alongTrackDist = vector_A_to_airplane * vector_AB;
 
 	/* estimate airplane position WRT to B */
-	math::Vector<2> vector_B_to_P_unit = get_local_planar_vector(vector_B, vector_curr_position).normalized();
-	
+	math::Vector<2> vector_B_to_P = get_local_planar_vector(vector_B, vector_curr_position, _cos_lat_B);
+	math::Vector<2> vector_B_to_P_unit = vector_B_to_P.normalized();
+
+	/*
+	 * get the direction between the current position and next waypoint,
+	 * from the planar vector - in the local tangent plane the bearing is
+	 * a plain atan2, no great-circle trig needed per cycle
+	 */
+	_target_bearing = atan2f(-vector_B_to_P(1), -vector_B_to_P(0));
+
 	/* calculate angle of airplane position vector relative to line) */
 
 	// XXX this could probably also be based solely on the dot product
@@ -221,8 +228,8 @@ void ECL_L1_Pos_Controller::navigate_loiter(const math::Vector<2> &vector_A, con
 	float K_crosstrack = omega * omega;
 	float K_velocity = 2.0f * _L1_damping * omega;
 
-	/* update bearing to next waypoint */
-	_target_bearing = get_bearing_to_next_waypoint(vector_curr_position(0), vector_curr_position(1), vector_A(0), vector_A(1));
+	/* refresh the cached intermediates if the loiter center changed */
+	update_track_cache(vector_A, vector_A);
 
 	/* ground speed, enforce minimum of 0.1 m/s to avoid singularities */
 	float ground_speed = math::max(ground_speed_vector.length() , 0.1f);
@@ -231,7 +238,10 @@ void ECL_L1_Pos_Controller::navigate_loiter(const math::Vector<2> &vector_A, con
 	_L1_distance = _L1_ratio * ground_speed;
 
 	/* calculate the vector from waypoint A to current position */
-	math::Vector<2> vector_A_to_airplane = get_local_planar_vector(vector_A, vector_curr_position);
+	math::Vector<2> vector_A_to_airplane = get_local_planar_vector(vector_A, vector_curr_position, _cos_lat_A);
+
+	/* update bearing to next waypoint from the planar vector */
+	_target_bearing = atan2f(-vector_A_to_airplane(1), -vector_A_to_airplane(0));
 
 	math::Vector<2> vector_A_to_airplane_unit;
 
@@ -362,11 +372,43 @@ void ECL_L1_Pos_Controller::navigate_level_flight(float current_heading)
 
 
 math::Vector<2> ECL_L1_Pos_Controller::get_local_planar_vector(const math::Vector<2> &origin, const math::Vector<2> &target) const
+{
+	return get_local_planar_vector(origin, target, cosf(math::radians(origin(0))));
+}
+
+math::Vector<2> ECL_L1_Pos_Controller::get_local_planar_vector(const math::Vector<2> &origin, const math::Vector<2> &target, float cos_lat_origin) const
 {
 	/* this is an approximation for small angles, proposed by [2] */
 
-	math::Vector<2> out(math::radians((target(0) - origin(0))), math::radians((target(1) - origin(1))*cosf(math::radians(origin(0)))));
+	math::Vector<2> out(math::radians((target(0) - origin(0))), math::radians((target(1) - origin(1))*cos_lat_origin));
 
 	return out * static_cast<float>(CONSTANTS_RADIUS_OF_EARTH);
 }
 
+void ECL_L1_Pos_Controller::update_track_cache(const math::Vector<2> &vector_A, const math::Vector<2> &vector_B)
+{
+	/* the intermediates only change when the waypoint pair changes */
+	if (_track_cache_valid &&
+	    fabsf(vector_A(0) - _cached_wp_A(0)) < FLT_EPSILON &&
+	    fabsf(vector_A(1) - _cached_wp_A(1)) < FLT_EPSILON &&
+	    fabsf(vector_B(0) - _cached_wp_B(0)) < FLT_EPSILON &&
+	    fabsf(vector_B(1) - _cached_wp_B(1)) < FLT_EPSILON) {
+		return;
+	}
+
+	_cached_wp_A = vector_A;
+	_cached_wp_B = vector_B;
+	_cos_lat_A = cosf(math::radians(vector_A(0)));
+	_cos_lat_B = cosf(math::radians(vector_B(0)));
+
+	/* calculate normalized vector from A to B */
+	_vector_AB = get_local_planar_vector(vector_A, vector_B, _cos_lat_A);
+	_vector_AB_valid = (_vector_AB.length() >= 1.0e-6f);
+
+	if (_vector_AB_valid) {
+		_vector_AB.normalize();
+	}
+
+	_track_cache_valid = true;
+}
+
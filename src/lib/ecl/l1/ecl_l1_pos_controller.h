@@ -73,6 +73,7 @@ public:
 	ECL_L1_Pos_Controller() {
 		_L1_period = 25;
 		_L1_damping = 0.75f;
+		_track_cache_valid = false;
 	}
 
 	/**
@@ -249,6 +250,24 @@ private:
 
 	float _roll_lim_rad;  ///<maximum roll angle
 
+	/* cached track intermediates, they only change when the waypoint pair changes */
+	math::Vector<2> _cached_wp_A;	///< waypoint A the cache was computed for
+	math::Vector<2> _cached_wp_B;	///< waypoint B the cache was computed for
+	math::Vector<2> _vector_AB;	///< unit vector along the track from A to B
+	float _cos_lat_A;		///< cosine of the latitude of waypoint A
+	float _cos_lat_B;		///< cosine of the latitude of waypoint B
+	bool _vector_AB_valid;		///< true if A and B are distinct and _vector_AB is usable
+	bool _track_cache_valid;	///< true if the cache matches _cached_wp_A/_cached_wp_B
+
+	/**
+	 * Update the cached track intermediates if the waypoint pair changed.
+	 *
+	 * The cosines of the waypoint latitudes and the normalized track
+	 * vector only depend on the waypoint pair, so they are computed once
+	 * per pair instead of on every update.
+	 */
+	void update_track_cache(const math::Vector<2> &vector_A, const math::Vector<2> &vector_B);
+
 	/**
 	 * Convert a 2D vector from WGS84 to planar coordinates.
 	 *
@@ -262,6 +281,15 @@ private:
 	 */
 	math::Vector<2> get_local_planar_vector(const math::Vector<2> &origin, const math::Vector<2> &target) const;
 
+	/**
+	 * Convert a 2D vector from WGS84 to planar coordinates, using a
+	 * precomputed cosine of the origin latitude.
+	 *
+	 * Same approximation as above, but avoids the per-call trig when the
+	 * origin is one of the cached waypoints.
+	 */
+	math::Vector<2> get_local_planar_vector(const math::Vector<2> &origin, const math::Vector<2> &target, float cos_lat_origin) const;
+
 };
 
 
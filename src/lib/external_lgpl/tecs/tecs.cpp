@@ -7,6 +7,14 @@
 
 using namespace math;
 
+/**
+ * Minimum interval between evaluations of the energy balance loop (microseconds).
+ * The throttle and pitch demands are shaped with the TECS time constants, which
+ * are several seconds, so recomputing them faster than 50 Hz buys no control
+ * performance. The complementary filters still run at the full call rate.
+ */
+#define TECS_MAIN_INTERVAL_US	20000ULL
+
 /**
  * @file tecs.cpp
  *
@@ -512,17 +520,25 @@ void TECS::update_pitch_throttle(const math::Matrix<3,3> &rotMat, float pitch, f
 				 float throttle_min, float throttle_max, float throttle_cruise,
 				 float pitch_limit_min, float pitch_limit_max)
 {
-	// Calculate time in seconds since last update
 	uint64_t now = ecl_absolute_time();
-	_DT = max((now - _update_pitch_throttle_last_usec), 0ULL) * 1.0e-6f;
-	_update_pitch_throttle_last_usec = now;
 
 	// printf("tecs in: dt:%10.6f pitch: %6.2f baro_alt: %6.2f alt sp: %6.2f\neas sp: %6.2f eas: %6.2f, eas2tas: %6.2f\n %s pitch min C0: %6.2f thr min: %6.2f, thr max: %6.2f thr cruis: %6.2f pt min: %6.2f, pt max: %6.2f\n",
 	// 	_DT, pitch, baro_altitude, hgt_dem, EAS_dem, indicated_airspeed, EAS2TAS, (climbOutDem) ? "climb" : "level", ptchMinCO, throttle_min, throttle_max, throttle_cruise, pitch_limit_min, pitch_limit_max);
 
 	// Update the speed estimate using a 2nd order complementary filter
+	// This runs at the full call rate so the filter sees every airspeed sample
 	_update_speed(EAS_dem, indicated_airspeed, _indicated_airspeed_min, _indicated_airspeed_max, EAS2TAS);
 
+	// Decimate the energy balance computation when the caller runs faster than
+	// the loop needs - the last throttle and pitch demands are held in between
+	if ((now - _update_pitch_throttle_last_usec) < TECS_MAIN_INTERVAL_US) {
+		return;
+	}
+
+	// Calculate time in seconds since last update
+	_DT = max((now - _update_pitch_throttle_last_usec), 0ULL) * 1.0e-6f;
+	_update_pitch_throttle_last_usec = now;
+
 	// Convert inputs
 	_THRmaxf  = throttle_max;
 	_THRminf  = throttle_min;
@@ -60,6 +60,13 @@
  * formulas according to: http://mathworld.wolfram.com/AzimuthalEquidistantProjection.html
  */
 
+/*
+ * Offsets below this arc (~1.1 km on the surface) take the linearized
+ * local-tangent-plane fast path; the deviation from the full azimuthal
+ * equidistant formulas stays below 0.25 m there, well under GPS accuracy.
+ */
+#define GEO_LINEAR_LIMIT_RAD	1.8e-4
+
 static struct map_projection_reference_s mp_ref = {0.0, 0.0, 0.0, 0.0, false, 0};
 static struct globallocal_converter_reference_s gl_ref = {0.0f, false};
 
@@ -143,6 +150,17 @@ __EXPORT int map_projection_project(const struct map_projection_reference_s *ref
 	double lat_rad = lat * M_DEG_TO_RAD;
 	double lon_rad = lon * M_DEG_TO_RAD;
 
+	double d_lat = lat_rad - ref->lat_rad;
+	double d_lon = lon_rad - ref->lon_rad;
+
+	/* typical in-flight offsets need no trig, just the cached reference terms */
+	if ((fabs(d_lat) < GEO_LINEAR_LIMIT_RAD) && (fabs(d_lon * ref->cos_lat) < GEO_LINEAR_LIMIT_RAD)) {
+		*x = d_lat * CONSTANTS_RADIUS_OF_EARTH;
+		*y = d_lon * ref->cos_lat * CONSTANTS_RADIUS_OF_EARTH;
+
+		return 0;
+	}
+
 	double sin_lat = sin(lat_rad);
 	double cos_lat = cos(lat_rad);
 	double cos_d_lon = cos(lon_rad - ref->lon_rad);
@@ -169,6 +187,16 @@ __EXPORT int map_projection_reproject(const struct map_projection_reference_s *r
 
 	double x_rad = x / CONSTANTS_RADIUS_OF_EARTH;
 	double y_rad = y / CONSTANTS_RADIUS_OF_EARTH;
+
+	/* linearized inverse for small offsets; degenerates near the poles */
+	if ((fabs(x_rad) < GEO_LINEAR_LIMIT_RAD) && (fabs(y_rad) < GEO_LINEAR_LIMIT_RAD) &&
+	    (ref->cos_lat > 0.01)) {
+		*lat = (ref->lat_rad + x_rad) * M_RAD_TO_DEG;
+		*lon = (ref->lon_rad + y_rad / ref->cos_lat) * M_RAD_TO_DEG;
+
+		return 0;
+	}
+
 	double c = sqrtf(x_rad * x_rad + y_rad * y_rad);
 	double sin_c = sin(c);
 	double cos_c = cos(c);
@@ -306,6 +334,71 @@ __EXPORT float get_bearing_to_next_waypoint(double lat_now, double lon_now, doub
 	return theta;
 }
 
+__EXPORT void waypoint_tracker_init(struct waypoint_tracker_s *tracker, double lat_next, double lon_next)
+{
+	tracker->lat_next_rad = lat_next * M_DEG_TO_RAD;
+	tracker->lon_next_rad = lon_next * M_DEG_TO_RAD;
+	tracker->sin_lat_next = sin(tracker->lat_next_rad);
+	tracker->cos_lat_next = cos(tracker->lat_next_rad);
+
+	/* NAN forces the first query to compute */
+	tracker->lat_now = NAN;
+	tracker->lon_now = NAN;
+	tracker->distance = 0.0f;
+	tracker->bearing = 0.0f;
+	tracker->init_done = true;
+}
+
+static void waypoint_tracker_update(struct waypoint_tracker_s *tracker, double lat_now, double lon_now)
+{
+	if ((fabs(lat_now - tracker->lat_now) < DBL_EPSILON) &&
+	    (fabs(lon_now - tracker->lon_now) < DBL_EPSILON)) {
+		/* same position as the last query, results are cached */
+		return;
+	}
+
+	double lat_now_rad = lat_now * M_DEG_TO_RAD;
+	double d_lon = tracker->lon_next_rad - lon_now * M_DEG_TO_RAD;
+
+	double sin_lat_now = sin(lat_now_rad);
+	double cos_lat_now = cos(lat_now_rad);
+	double sin_d_lon = sin(d_lon);
+	double cos_d_lon = cos(d_lon);
+
+	/* distance and bearing share the east/north components of the great circle */
+	double v_e = tracker->cos_lat_next * sin_d_lon;
+	double v_n = cos_lat_now * tracker->sin_lat_next - sin_lat_now * tracker->cos_lat_next * cos_d_lon;
+	double c = atan2(sqrt(v_e * v_e + v_n * v_n),
+			 sin_lat_now * tracker->sin_lat_next + cos_lat_now * tracker->cos_lat_next * cos_d_lon);
+
+	tracker->distance = CONSTANTS_RADIUS_OF_EARTH * c;
+	tracker->bearing = _wrap_pi(atan2f(v_e, v_n));
+	tracker->lat_now = lat_now;
+	tracker->lon_now = lon_now;
+}
+
+__EXPORT float waypoint_tracker_distance(struct waypoint_tracker_s *tracker, double lat_now, double lon_now)
+{
+	if (!tracker->init_done) {
+		return 0.0f;
+	}
+
+	waypoint_tracker_update(tracker, lat_now, lon_now);
+
+	return tracker->distance;
+}
+
+__EXPORT float waypoint_tracker_bearing(struct waypoint_tracker_s *tracker, double lat_now, double lon_now)
+{
+	if (!tracker->init_done) {
+		return 0.0f;
+	}
+
+	waypoint_tracker_update(tracker, lat_now, lon_now);
+
+	return tracker->bearing;
+}
+
 __EXPORT void get_vector_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next, float *v_n, float *v_e)
 {
 	double lat_now_rad = lat_now * M_DEG_TO_RAD;
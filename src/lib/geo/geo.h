@@ -79,6 +79,18 @@ struct globallocal_converter_reference_s {
 	bool init_done;
 };
 
+struct waypoint_tracker_s {
+	double lat_next_rad;
+	double lon_next_rad;
+	double sin_lat_next;
+	double cos_lat_next;
+	double lat_now;		/**< position of the last query, degrees */
+	double lon_now;
+	float distance;		/**< results cached for the last query position */
+	float bearing;
+	bool init_done;
+};
+
 /**
  * Checks if global projection was initialized
  * @return true if map was initialized before, false else
@@ -243,6 +255,40 @@ __EXPORT float get_distance_to_next_waypoint(double lat_now, double lon_now, dou
  */
 __EXPORT float get_bearing_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next);
 
+/**
+ * Initializes a waypoint tracker for the given target waypoint.
+ *
+ * The tracker caches the target trig terms, so repeated distance and
+ * bearing queries against the same waypoint share their intermediate
+ * results instead of re-running the full great-circle math.
+ *
+ * @param lat_next next waypoint position in degrees (47.1234567°, not 471234567°)
+ * @param lon_next next waypoint position in degrees (8.1234567°, not 81234567°)
+ */
+__EXPORT void waypoint_tracker_init(struct waypoint_tracker_s *tracker, double lat_next, double lon_next);
+
+/**
+ * Returns the distance to the tracked waypoint in meters.
+ *
+ * Equivalent to get_distance_to_next_waypoint(); distance and bearing
+ * for one query position are computed together and cached.
+ *
+ * @param lat_now current position in degrees (47.1234567°, not 471234567°)
+ * @param lon_now current position in degrees (8.1234567°, not 81234567°)
+ */
+__EXPORT float waypoint_tracker_distance(struct waypoint_tracker_s *tracker, double lat_now, double lon_now);
+
+/**
+ * Returns the bearing to the tracked waypoint in radians.
+ *
+ * Equivalent to get_bearing_to_next_waypoint(); distance and bearing
+ * for one query position are computed together and cached.
+ *
+ * @param lat_now current position in degrees (47.1234567°, not 471234567°)
+ * @param lon_now current position in degrees (8.1234567°, not 81234567°)
+ */
+__EXPORT float waypoint_tracker_bearing(struct waypoint_tracker_s *tracker, double lat_now, double lon_now);
+
 __EXPORT void get_vector_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next, float *v_n, float *v_e);
 
 __EXPORT void get_vector_to_next_waypoint_fast(double lat_now, double lon_now, double lat_next, double lon_next, float *v_n, float *v_e);
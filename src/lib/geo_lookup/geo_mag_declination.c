@@ -71,6 +71,19 @@ static const int8_t declination_table[13][37] = \
 
 static float get_lookup_table_val(unsigned lat, unsigned lon);
 
+/*
+ * Cache of the most recently used grid cell. Flights rarely cross a
+ * 10 degree cell boundary, so repeated queries reuse the corner values
+ * without touching the table.
+ */
+static bool cell_valid = false;
+static unsigned cell_lat_index;
+static unsigned cell_lon_index;
+static float cell_sw;
+static float cell_se;
+static float cell_ne;
+static float cell_nw;
+
 __EXPORT float get_mag_declination(float lat, float lon)
 {
 	/*
@@ -112,15 +125,21 @@ __EXPORT float get_mag_declination(float lat, float lon)
 	unsigned min_lat_index = (-(SAMPLING_MIN_LAT) + min_lat)  / SAMPLING_RES;
 	unsigned min_lon_index = (-(SAMPLING_MIN_LON) + min_lon) / SAMPLING_RES;
 
-	float declination_sw = get_lookup_table_val(min_lat_index, min_lon_index);
-	float declination_se = get_lookup_table_val(min_lat_index, min_lon_index + 1);
-	float declination_ne = get_lookup_table_val(min_lat_index + 1, min_lon_index + 1);
-	float declination_nw = get_lookup_table_val(min_lat_index + 1, min_lon_index);
+	/* fetch the cell corners, reusing the cached cell when possible */
+	if (!cell_valid || (min_lat_index != cell_lat_index) || (min_lon_index != cell_lon_index)) {
+		cell_sw = get_lookup_table_val(min_lat_index, min_lon_index);
+		cell_se = get_lookup_table_val(min_lat_index, min_lon_index + 1);
+		cell_ne = get_lookup_table_val(min_lat_index + 1, min_lon_index + 1);
+		cell_nw = get_lookup_table_val(min_lat_index + 1, min_lon_index);
+		cell_lat_index = min_lat_index;
+		cell_lon_index = min_lon_index;
+		cell_valid = true;
+	}
 
 	/* perform bilinear interpolation on the four grid corners */
 
-	float declination_min = ((lon - min_lon) / SAMPLING_RES) * (declination_se - declination_sw) + declination_sw;
-	float declination_max = ((lon - min_lon) / SAMPLING_RES) * (declination_ne - declination_nw) + declination_nw;
+	float declination_min = ((lon - min_lon) / SAMPLING_RES) * (cell_se - cell_sw) + cell_sw;
+	float declination_max = ((lon - min_lon) / SAMPLING_RES) * (cell_ne - cell_nw) + cell_nw;
 
 	return ((lat - min_lat) / SAMPLING_RES) * (declination_max - declination_min) + declination_min;
 }
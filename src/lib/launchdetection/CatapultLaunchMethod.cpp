@@ -63,29 +63,48 @@ CatapultLaunchMethod::~CatapultLaunchMethod() {
 }
 
 void CatapultLaunchMethod::update(float accel_x)
+{
+	update(&accel_x, 1);
+}
+
+void CatapultLaunchMethod::update(const float accel_x[], unsigned count)
 {
 	float dt = (float)hrt_elapsed_time(&last_timestamp) * 1e-6f;
 	last_timestamp = hrt_absolute_time();
 
+	if (count < 1) {
+		return;
+	}
+
+	/* Spread the elapsed time evenly over the queued samples so the integrated
+	 * acceleration test advances incrementally through every sample instead of
+	 * crediting the whole interval to the newest one */
+	float dt_sample = dt / count;
+
 	switch (state) {
 	case LAUNCHDETECTION_RES_NONE:
-		/* Detect a acceleration that is longer and stronger as the minimum given by the params */
-		if (accel_x > thresholdAccel.get()) {
-			integrator += dt;
-			if (integrator > thresholdTime.get()) {
-				if (motorDelay.get() > 0.0f) {
-					state = LAUNCHDETECTION_RES_DETECTED_ENABLECONTROL;
-					warnx("Launch detected: state: enablecontrol, waiting %.2fs until using full"
-							" throttle", (double)motorDelay.get());
-				} else {
-					/* No motor delay set: go directly to enablemotors state */
-					state = LAUNCHDETECTION_RES_DETECTED_ENABLEMOTORS;
-					warnx("Launch detected: state: enablemotors (delay not activated)");
+		for (unsigned i = 0; i < count; i++) {
+			/* Detect a acceleration that is longer and stronger as the minimum given by the params */
+			if (accel_x[i] > thresholdAccel.get()) {
+				integrator += dt_sample;
+				if (integrator > thresholdTime.get()) {
+					if (motorDelay.get() > 0.0f) {
+						state = LAUNCHDETECTION_RES_DETECTED_ENABLECONTROL;
+						warnx("Launch detected: state: enablecontrol, waiting %.2fs until using full"
+								" throttle", (double)motorDelay.get());
+					} else {
+						/* No motor delay set: go directly to enablemotors state */
+						state = LAUNCHDETECTION_RES_DETECTED_ENABLEMOTORS;
+						warnx("Launch detected: state: enablemotors (delay not activated)");
+					}
+
+					/* stop consuming samples once the launch has been detected */
+					break;
 				}
+			} else {
+				/* reset */
+				reset();
 			}
-		} else {
-			/* reset */
-			reset();
 		}
 		break;
 
@@ -57,6 +57,7 @@ public:
 	~CatapultLaunchMethod();
 
 	void update(float accel_x);
+	void update(const float accel_x[], unsigned count);
 	LaunchDetectionResult getLaunchDetected() const;
 	void reset();
 	float getPitchMax(float pitchMaxDefault);
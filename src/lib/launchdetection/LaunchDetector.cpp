@@ -85,6 +85,15 @@ void LaunchDetector::update(float accel_x)
 	}
 }
 
+void LaunchDetector::update(const float accel_x[], unsigned count)
+{
+	if (launchdetection_on.get() == 1) {
+		for (uint8_t i = 0; i < sizeof(launchMethods)/sizeof(LaunchMethod); i++) {
+			launchMethods[i]->update(accel_x, count);
+		}
+	}
+}
+
 LaunchDetectionResult LaunchDetector::getLaunchDetected()
 {
 	if (launchdetection_on.get() == 1) {
@@ -59,6 +59,10 @@ public:
 	void reset();
 
 	void update(float accel_x);
+
+	/* Batched variant: process all accelerometer samples queued since the last call */
+	void update(const float accel_x[], unsigned count);
+
 	LaunchDetectionResult getLaunchDetected();
 	bool launchDetectionEnabled() { return (bool)launchdetection_on.get(); };
 
@@ -59,6 +59,10 @@ class LaunchMethod
 {
 public:
 	virtual void update(float accel_x) = 0;
+
+	/* Batched variant: process all accelerometer samples queued since the last call */
+	virtual void update(const float accel_x[], unsigned count) = 0;
+
 	virtual LaunchDetectionResult getLaunchDetected() const = 0;
 	virtual void reset() = 0;
 
@@ -214,10 +214,15 @@ public:
 	Matrix<M, N> operator +(const Matrix<M, N> &m) const {
 		Matrix<M, N> res;
 
+#ifdef CONFIG_ARCH_ARM
+		arm_mat_add_f32(&arm_mat, &m.arm_mat, &res.arm_mat);
+#else
+
 		for (unsigned int i = 0; i < M; i++)
 			for (unsigned int j = 0; j < N; j++)
 				res.data[i][j] = data[i][j] + m.data[i][j];
 
+#endif
 		return res;
 	}
 
@@ -235,10 +240,15 @@ public:
 	Matrix<M, N> operator -(const Matrix<M, N> &m) const {
 		Matrix<M, N> res;
 
+#ifdef CONFIG_ARCH_ARM
+		arm_mat_sub_f32(&arm_mat, &m.arm_mat, &res.arm_mat);
+#else
+
 		for (unsigned int i = 0; i < M; i++)
 			for (unsigned int j = 0; j < N; j++)
 				res.data[i][j] = data[i][j] - m.data[i][j];
 
+#endif
 		return res;
 	}
 
@@ -256,10 +266,15 @@ public:
 	Matrix<M, N> operator *(const float num) const {
 		Matrix<M, N> res;
 
+#ifdef CONFIG_ARCH_ARM
+		arm_mat_scale_f32(&arm_mat, num, &res.arm_mat);
+#else
+
 		for (unsigned int i = 0; i < M; i++)
 			for (unsigned int j = 0; j < N; j++)
 				res.data[i][j] = data[i][j] * num;
 
+#endif
 		return res;
 	}
 
@@ -309,6 +324,85 @@ public:
 #endif
 	}
 
+	/**
+	 * multiplication by the transpose of another matrix, this * m^T
+	 *
+	 * Evaluates in a single loop nest without materializing the
+	 * transposed operand.
+	 */
+	template <unsigned int P>
+	Matrix<M, P> mult_transposed(const Matrix<P, N> &m) const {
+		Matrix<M, P> res;
+
+		for (unsigned int i = 0; i < M; i++)
+			for (unsigned int j = 0; j < P; j++) {
+				float s = 0.0f;
+
+				for (unsigned int k = 0; k < N; k++)
+					s += data[i][k] * m.data[j][k];
+
+				res.data[i][j] = s;
+			}
+
+		return res;
+	}
+
+	/**
+	 * multiplication of the transposed matrix by another matrix, this^T * m
+	 *
+	 * Evaluates in a single loop nest without materializing the
+	 * transpose.
+	 */
+	template <unsigned int P>
+	Matrix<N, P> transposed_mult(const Matrix<M, P> &m) const {
+		Matrix<N, P> res;
+
+		for (unsigned int i = 0; i < N; i++)
+			for (unsigned int j = 0; j < P; j++) {
+				float s = 0.0f;
+
+				for (unsigned int k = 0; k < M; k++)
+					s += data[k][i] * m.data[k][j];
+
+				res.data[i][j] = s;
+			}
+
+		return res;
+	}
+
+	/**
+	 * fused covariance propagation, this = f * this * f^T + q
+	 *
+	 * Only valid for square matrices. Uses a single scratch matrix
+	 * instead of the three temporaries the equivalent chained
+	 * expression materializes.
+	 */
+	void propagate(const Matrix<M, M> &f, const Matrix<M, M> &q) {
+		float t[M][N];
+
+		/* t = f * this */
+		for (unsigned int i = 0; i < M; i++)
+			for (unsigned int j = 0; j < N; j++) {
+				float s = 0.0f;
+
+				for (unsigned int k = 0; k < M; k++)
+					s += f.data[i][k] * data[k][j];
+
+				t[i][j] = s;
+			}
+
+		/* this = t * f^T + q */
+		for (unsigned int i = 0; i < M; i++)
+			for (unsigned int j = 0; j < N; j++) {
+				float s = q.data[i][j];
+
+				for (unsigned int k = 0; k < N; k++)
+					s += t[i][k] * f.data[j][k];
+
+				data[i][j] = s;
+			}
+	}
+
 	/**
 	 * transpose the matrix
 	 */
@@ -378,6 +472,7 @@ class __EXPORT Matrix : public MatrixBase<M, N>
 {
 public:
 	using MatrixBase<M, N>::operator *;
+	using MatrixBase<M, N>::transposed_mult;
 
 	Matrix() : MatrixBase<M, N>() {}
 
@@ -412,6 +507,27 @@ public:
 #endif
 		return res;
 	}
+
+	/**
+	 * multiplication of the transposed matrix by a vector, this^T * v
+	 *
+	 * Avoids materializing the transpose in expressions like
+	 * m.transposed() * v.
+	 */
+	Vector<N> transposed_mult(const Vector<M> &v) const {
+		Vector<N> res;
+
+		for (unsigned int i = 0; i < N; i++) {
+			float s = 0.0f;
+
+			for (unsigned int k = 0; k < M; k++)
+				s += this->data[k][i] * v.data[k];
+
+			res.data[i] = s;
+		}
+
+		return res;
+	}
 };
 
 template <>
@@ -419,6 +535,7 @@ class __EXPORT Matrix<3, 3> : public MatrixBase<3, 3>
 {
 public:
 	using MatrixBase<3, 3>::operator *;
+	using MatrixBase<3, 3>::transposed_mult;
 
 	Matrix() : MatrixBase<3, 3>() {}
 
@@ -446,6 +563,16 @@ public:
 		return res;
 	}
 
+	/**
+	 * multiplication of the transposed matrix by a vector, this^T * v
+	 */
+	Vector<3> transposed_mult(const Vector<3> &v) const {
+		Vector<3> res(data[0][0] * v.data[0] + data[1][0] * v.data[1] + data[2][0] * v.data[2],
+			      data[0][1] * v.data[0] + data[1][1] * v.data[1] + data[2][1] * v.data[2],
+			      data[0][2] * v.data[0] + data[1][2] * v.data[1] + data[2][2] * v.data[2]);
+		return res;
+	}
+
 	/**
 	 * create a rotation matrix from given euler angles
 	 * based on http://gentlenav.googlecode.com/files/EulerAngles.pdf
@@ -97,15 +97,53 @@ public:
 	 * derivative
 	 */
 	const Quaternion derivative(const Vector<3> &w) {
-		float dataQ[] = {
-			data[0], -data[1], -data[2], -data[3],
-			data[1],  data[0], -data[3],  data[2],
-			data[2],  data[3],  data[0], -data[1],
-			data[3], -data[2],  data[1],  data[0]
-		};
-		Matrix<4, 4> Q(dataQ);
-		Vector<4> v(0.0f, w.data[0], w.data[1], w.data[2]);
-		return Q * v * 0.5f;
+		return Quaternion(
+			       0.5f * (-data[1] * w.data[0] - data[2] * w.data[1] - data[3] * w.data[2]),
+			       0.5f * (data[0] * w.data[0] - data[3] * w.data[1] + data[2] * w.data[2]),
+			       0.5f * (data[3] * w.data[0] + data[0] * w.data[1] - data[1] * w.data[2]),
+			       0.5f * (-data[2] * w.data[0] + data[1] * w.data[1] + data[0] * w.data[2]));
+	}
+
+	/**
+	 * in-place derivative, this = 0.5 * this * (0, w)
+	 *
+	 * same result as derivative() without constructing a temporary
+	 */
+	void derivative_inplace(const Vector<3> &w) {
+		float a = data[0];
+		float b = data[1];
+		float c = data[2];
+		float d = data[3];
+
+		data[0] = 0.5f * (-b * w.data[0] - c * w.data[1] - d * w.data[2]);
+		data[1] = 0.5f * (a * w.data[0] - d * w.data[1] + c * w.data[2]);
+		data[2] = 0.5f * (d * w.data[0] + a * w.data[1] - b * w.data[2]);
+		data[3] = 0.5f * (-c * w.data[0] + b * w.data[1] + a * w.data[2]);
+	}
+
+	/**
+	 * in-place conjugation; equals the inverse for unit quaternions
+	 */
+	void conjugate_inplace(void) {
+		data[1] = -data[1];
+		data[2] = -data[2];
+		data[3] = -data[3];
+	}
+
+	/**
+	 * fast renormalization without sqrt or division
+	 *
+	 * Uses one Newton iteration of 1/sqrt(x) around x = 1, so it is
+	 * only valid when the norm is already close to unity, as it is
+	 * when a unit quaternion is propagated by one integration step.
+	 */
+	void normalize_fast(void) {
+		float s = (3.0f - length_squared()) * 0.5f;
+
+		data[0] *= s;
+		data[1] *= s;
+		data[2] *= s;
+		data[3] *= s;
 	}
 
 	/**
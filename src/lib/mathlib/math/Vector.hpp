@@ -280,6 +280,18 @@ public:
 		return res;
 	}
 
+	/**
+	 * fused scale-and-accumulate, this += v * num
+	 *
+	 * avoids the temporary materialized by the chained expression
+	 */
+	const Vector<N> &add_scaled(const Vector<N> &v, const float num) {
+		for (unsigned int i = 0; i < N; i++)
+			data[i] += v.data[i] * num;
+
+		return *static_cast<const Vector<N>*>(this);
+	}
+
 	/**
 	 * element by element multiplication
 	 */
@@ -89,5 +89,55 @@ float LowPassFilter2p::reset(float sample) {
     return apply(sample);
 }
 
+void LowPassFilter2pVector3f::set_cutoff_frequency(float sample_freq, float cutoff_freq)
+{
+    _cutoff_freq = cutoff_freq;
+    if (_cutoff_freq <= 0.0f) {
+        // no filtering
+        return;
+    }
+    float fr = sample_freq/_cutoff_freq;
+    float ohm = tanf(M_PI_F/fr);
+    float c = 1.0f+2.0f*cosf(M_PI_F/4.0f)*ohm + ohm*ohm;
+    _b0 = ohm*ohm/c;
+    _b1 = 2.0f*_b0;
+    _b2 = _b0;
+    _a1 = 2.0f*(ohm*ohm-1.0f)/c;
+    _a2 = (1.0f-2.0f*cosf(M_PI_F/4.0f)*ohm+ohm*ohm)/c;
+}
+
+Vector<3> LowPassFilter2pVector3f::apply(const Vector<3> &sample)
+{
+    if (_cutoff_freq <= 0.0f) {
+        // no filtering
+        return sample;
+    }
+
+    // do the filtering for all axes with one load of the coefficients
+    Vector<3> delay_element_0 = sample - _delay_element_1 * _a1 - _delay_element_2 * _a2;
+
+    for (unsigned i = 0; i < 3; i++) {
+        if (isnan(delay_element_0(i)) || isinf(delay_element_0(i))) {
+            // don't allow bad values to propagate via the filter
+            delay_element_0(i) = sample(i);
+        }
+    }
+
+    Vector<3> output = delay_element_0 * _b0 + _delay_element_1 * _b1 + _delay_element_2 * _b2;
+
+    _delay_element_2 = _delay_element_1;
+    _delay_element_1 = delay_element_0;
+
+    // return the value.  Should be no need to check limits
+    return output;
+}
+
+Vector<3> LowPassFilter2pVector3f::reset(const Vector<3> &sample) {
+    Vector<3> dval = sample / (_b0 + _b1 + _b2);
+    _delay_element_1 = dval;
+    _delay_element_2 = dval;
+    return apply(sample);
+}
+
 } // namespace math
 
@@ -40,6 +40,8 @@
 
 #pragma once
 
+#include "../Vector.hpp"
+
 namespace math
 {
 class __EXPORT LowPassFilter2p
@@ -95,4 +97,61 @@ private:
     float           _delay_element_2;        // buffered sample -2
 };
 
+/// @brief	Second order low pass filter for all three axes of a sensor.
+/// The same coefficients are applied to every axis in a single pass,
+/// which is cheaper than running three scalar filters in the driver
+/// interrupt paths.
+class __EXPORT LowPassFilter2pVector3f
+{
+public:
+    // constructor
+    LowPassFilter2pVector3f(float sample_freq, float cutoff_freq) :
+        _cutoff_freq(cutoff_freq),
+        _a1(0.0f),
+        _a2(0.0f),
+        _b0(0.0f),
+        _b1(0.0f),
+        _b2(0.0f),
+        _delay_element_1(),
+        _delay_element_2()
+    {
+        // set initial parameters
+        set_cutoff_frequency(sample_freq, cutoff_freq);
+    }
+
+    /**
+     * Change filter parameters
+     */
+    void set_cutoff_frequency(float sample_freq, float cutoff_freq);
+
+    /**
+     * Add a new raw value to the filter
+     *
+     * @return retrieve the filtered result
+     */
+    Vector<3> apply(const Vector<3> &sample);
+
+    /**
+     * Return the cutoff frequency
+     */
+    float get_cutoff_freq(void) const {
+        return _cutoff_freq;
+    }
+
+    /**
+     * Reset the filter state to this value
+     */
+    Vector<3> reset(const Vector<3> &sample);
+
+private:
+    float           _cutoff_freq;
+    float           _a1;
+    float           _a2;
+    float           _b0;
+    float           _b1;
+    float           _b2;
+    Vector<3>       _delay_element_1;        // buffered sample -1
+    Vector<3>       _delay_element_2;        // buffered sample -2
+};
+
 } // namespace math
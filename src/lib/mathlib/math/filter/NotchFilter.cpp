@@ -0,0 +1,183 @@
+// -*- tab-width: 4; Mode: C++; c-basic-offset: 4; indent-tabs-mode: nil -*-
+
+/****************************************************************************
+ *
+ *   Copyright (C) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/// @file	NotchFilter.cpp
+/// @brief	Biquad notch filters for narrow-band noise rejection
+
+#include "NotchFilter.hpp"
+#include "math.h"
+
+namespace math
+{
+
+namespace
+{
+
+/// compute normalized biquad notch coefficients at notch_freq with the
+/// given -3 dB bandwidth
+void notch_coefficients(float sample_freq, float notch_freq, float bandwidth,
+                        float &a1, float &a2, float &b0, float &b1, float &b2)
+{
+    float alpha = tanf(M_PI_F * bandwidth / sample_freq);
+    float beta = -cosf(2.0f * M_PI_F * notch_freq / sample_freq);
+    float c = 1.0f / (1.0f + alpha);
+
+    b0 = c;
+    b1 = 2.0f * beta * c;
+    b2 = c;
+    a1 = b1;
+    a2 = (1.0f - alpha) * c;
+}
+
+} // namespace
+
+void NotchFilter::set_notch_frequency(float sample_freq, float notch_freq, float bandwidth)
+{
+    // cheap no-op when the tuning did not move, so callers can push
+    // the current target every cycle
+    if (fabsf(notch_freq - _notch_freq) < 0.01f &&
+        fabsf(bandwidth - _bandwidth) < 0.01f) {
+        return;
+    }
+
+    _notch_freq = notch_freq;
+    _bandwidth = bandwidth;
+
+    if (_notch_freq <= 0.0f || _notch_freq >= sample_freq / 2.0f) {
+        // no filtering
+        _notch_freq = 0.0f;
+        return;
+    }
+
+    notch_coefficients(sample_freq, _notch_freq, _bandwidth, _a1, _a2, _b0, _b1, _b2);
+}
+
+float NotchFilter::reset(float sample) {
+    float dval = sample;
+
+    if (fabsf(_b0 + _b1 + _b2) > 1.0e-6f) {
+        dval = sample / (_b0 + _b1 + _b2);
+    }
+
+    _delay_element_1 = dval;
+    _delay_element_2 = dval;
+    return apply(sample);
+}
+
+void NotchFilterHarmonicVector3f::set_notch_frequency(float sample_freq, float notch_freq,
+        float bandwidth, unsigned num_harmonics)
+{
+    if (num_harmonics > MAX_HARMONICS) {
+        num_harmonics = MAX_HARMONICS;
+    }
+
+    // cheap no-op when the tuning did not move, so callers can push
+    // the current target every cycle
+    if (fabsf(notch_freq - _notch_freq) < 0.01f &&
+        fabsf(bandwidth - _bandwidth) < 0.01f &&
+        num_harmonics == _num_harmonics) {
+        return;
+    }
+
+    _notch_freq = notch_freq;
+    _bandwidth = bandwidth;
+    _num_harmonics = 0;
+
+    if (notch_freq <= 0.0f) {
+        // no filtering
+        _notch_freq = 0.0f;
+        return;
+    }
+
+    for (unsigned i = 0; i < num_harmonics; i++) {
+        float freq = notch_freq * (i + 1);
+
+        if (freq >= sample_freq / 2.0f) {
+            // harmonics at or above Nyquist cannot be notched
+            break;
+        }
+
+        notch_coefficients(sample_freq, freq, _bandwidth,
+                           _stages[i].a1, _stages[i].a2,
+                           _stages[i].b0, _stages[i].b1, _stages[i].b2);
+        _num_harmonics = i + 1;
+    }
+}
+
+Vector<3> NotchFilterHarmonicVector3f::apply(const Vector<3> &sample)
+{
+    Vector<3> output = sample;
+
+    // cascade the harmonics; one coefficient set per stage is shared
+    // by all three axes
+    for (unsigned i = 0; i < _num_harmonics; i++) {
+        struct stage_s &s = _stages[i];
+
+        Vector<3> delay_element_0 = output - s.delay_element_1 * s.a1 - s.delay_element_2 * s.a2;
+
+        for (unsigned j = 0; j < 3; j++) {
+            if (isnan(delay_element_0(j)) || isinf(delay_element_0(j))) {
+                // don't allow bad values to propagate via the filter
+                delay_element_0(j) = output(j);
+            }
+        }
+
+        output = delay_element_0 * s.b0 + s.delay_element_1 * s.b1 + s.delay_element_2 * s.b2;
+
+        s.delay_element_2 = s.delay_element_1;
+        s.delay_element_1 = delay_element_0;
+    }
+
+    return output;
+}
+
+Vector<3> NotchFilterHarmonicVector3f::reset(const Vector<3> &sample)
+{
+    for (unsigned i = 0; i < _num_harmonics; i++) {
+        float gain = _stages[i].b0 + _stages[i].b1 + _stages[i].b2;
+        Vector<3> dval = sample;
+
+        if (fabsf(gain) > 1.0e-6f) {
+            dval = sample / gain;
+        }
+
+        _stages[i].delay_element_1 = dval;
+        _stages[i].delay_element_2 = dval;
+    }
+
+    return apply(sample);
+}
+
+} // namespace math
@@ -0,0 +1,189 @@
+// -*- tab-width: 4; Mode: C++; c-basic-offset: 4; indent-tabs-mode: nil -*-
+
+/****************************************************************************
+ *
+ *   Copyright (C) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/// @file	NotchFilter.hpp
+/// @brief	Biquad notch filters for narrow-band noise rejection, designed
+///         for the gyro filter stage of the sensor drivers where
+///         LowPassFilter2p already runs. Coefficients are only recomputed
+///         when the notch frequency actually changes, so retuning the
+///         notch from a slow path (e.g. throttle or RPM feedback) is free
+///         for the fast path.
+
+#pragma once
+
+#include "../Vector.hpp"
+
+namespace math
+{
+
+/// @brief	Single biquad notch on a scalar signal.
+class __EXPORT NotchFilter
+{
+public:
+    // constructor
+    NotchFilter(float sample_freq, float notch_freq, float bandwidth) :
+        _notch_freq(0.0f),
+        _bandwidth(0.0f),
+        _a1(0.0f),
+        _a2(0.0f),
+        _b0(1.0f),
+        _b1(0.0f),
+        _b2(1.0f),
+        _delay_element_1(0.0f),
+        _delay_element_2(0.0f)
+    {
+        // set initial parameters
+        set_notch_frequency(sample_freq, notch_freq, bandwidth);
+    }
+
+    /**
+     * Change filter parameters
+     *
+     * Recomputes the coefficients only if notch_freq or bandwidth
+     * changed; a notch_freq of 0 disables the filter.
+     */
+    void set_notch_frequency(float sample_freq, float notch_freq, float bandwidth);
+
+    /**
+     * Add a new raw value to the filter
+     *
+     * @return retrieve the filtered result
+     */
+    float apply(float sample) {
+        if (!(_notch_freq > 0.0f)) {
+            return sample;
+        }
+
+        // direct form II, same structure as LowPassFilter2p
+        float delay_element_0 = sample - _delay_element_1 * _a1 - _delay_element_2 * _a2;
+        float output = delay_element_0 * _b0 + _delay_element_1 * _b1 + _delay_element_2 * _b2;
+
+        _delay_element_2 = _delay_element_1;
+        _delay_element_1 = delay_element_0;
+
+        return output;
+    }
+
+    /**
+     * Return the notch frequency
+     */
+    float get_notch_freq(void) const {
+        return _notch_freq;
+    }
+
+    /**
+     * Reset the filter state to this value
+     */
+    float reset(float sample);
+
+private:
+    float           _notch_freq;
+    float           _bandwidth;
+    float           _a1;
+    float           _a2;
+    float           _b0;
+    float           _b1;
+    float           _b2;
+    float           _delay_element_1;        // buffered sample -1
+    float           _delay_element_2;        // buffered sample -2
+};
+
+/// @brief	Cascade of biquad notches at a fundamental and its harmonics,
+/// applied to all three axes of a sensor in a single pass. One coefficient
+/// set is shared per harmonic across the axes, so a three-harmonic bank
+/// costs nine multiply-accumulates per axis and sample.
+class __EXPORT NotchFilterHarmonicVector3f
+{
+public:
+    static const unsigned MAX_HARMONICS = 3;
+
+    // constructor
+    NotchFilterHarmonicVector3f(float sample_freq, float notch_freq, float bandwidth,
+                                unsigned num_harmonics = MAX_HARMONICS) :
+        _notch_freq(0.0f),
+        _bandwidth(0.0f),
+        _num_harmonics(0)
+    {
+        // set initial parameters
+        set_notch_frequency(sample_freq, notch_freq, bandwidth, num_harmonics);
+    }
+
+    /**
+     * Change filter parameters
+     *
+     * Places notches at notch_freq, 2 * notch_freq, ... up to
+     * num_harmonics stages, skipping harmonics at or above Nyquist.
+     * Recomputes the coefficients only if the tuning actually changed;
+     * a notch_freq of 0 disables the bank.
+     */
+    void set_notch_frequency(float sample_freq, float notch_freq, float bandwidth,
+                             unsigned num_harmonics = MAX_HARMONICS);
+
+    /**
+     * Add a new raw value to the filter
+     *
+     * @return retrieve the filtered result
+     */
+    Vector<3> apply(const Vector<3> &sample);
+
+    /**
+     * Return the fundamental notch frequency
+     */
+    float get_notch_freq(void) const {
+        return _notch_freq;
+    }
+
+    /**
+     * Reset the filter state to this value
+     */
+    Vector<3> reset(const Vector<3> &sample);
+
+private:
+    float           _notch_freq;
+    float           _bandwidth;
+    unsigned        _num_harmonics;          // active cascade stages
+
+    struct stage_s {
+        float       a1;
+        float       a2;
+        float       b0;
+        float       b1;
+        float       b2;
+        Vector<3>   delay_element_1;         // buffered sample -1
+        Vector<3>   delay_element_2;         // buffered sample -2
+    }               _stages[MAX_HARMONICS];
+};
+
+} // namespace math
@@ -0,0 +1,402 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file AttitudeEKF.cpp
+ *
+ * Hand-written implementation of the 12-state attitude EKF described by
+ * AttitudeEKF.m, replacing the MATLAB-generated codegen/AttitudeEKF.c.
+ *
+ * The filter equations are unchanged. The implementation exploits the
+ * structure the generated code could not see:
+ *
+ *  - the state transition matrix is block sparse (identity plus dt-scaled
+ *    cross-product blocks), so the covariance propagation only touches the
+ *    non-zero blocks instead of multiplying full 12x12 matrices
+ *  - every measurement block (gyro, accel, mag) directly observes a
+ *    disjoint state triple with uncorrelated noise, so the blocks are
+ *    fused sequentially with 3x3 innovation inverses instead of the up to
+ *    9x9 matrix inversion of the batch update
+ *  - the filter state and scratch matrices live in static storage, so the
+ *    deep call-site stack frames of the generated code go away
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include <mathlib/mathlib.h>
+
+extern "C" {
+#include "codegen/AttitudeEKF.h"
+}
+
+using math::Vector;
+
+namespace
+{
+
+/* persistent filter state, mirrors the 'persistent' variables of AttitudeEKF.m */
+bool	initialized = false;
+float	x_apo[12];		/**< state: rates, angular acceleration, gravity, mag field */
+float	P_apo[12][12];		/**< state covariance */
+float	Q_diag[12];		/**< process noise diagonal, latched on first call */
+float	Ji[3][3];		/**< inverse inertia, latched on first call */
+
+/* scratch for the covariance propagation, static to keep the stack frame small */
+float	T[12][12];
+
+/**
+ * Invert a symmetric 3x3 matrix via the adjugate.
+ *
+ * @return false if the matrix is singular
+ */
+bool
+invert3(const float a[3][3], float inv[3][3])
+{
+	float det = a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+		    a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+		    a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+
+	if (fabsf(det) < 1.0e-12f) {
+		return false;
+	}
+
+	float detInv = 1.0f / det;
+
+	inv[0][0] = (a[1][1] * a[2][2] - a[1][2] * a[2][1]) * detInv;
+	inv[0][1] = (a[0][2] * a[2][1] - a[0][1] * a[2][2]) * detInv;
+	inv[0][2] = (a[0][1] * a[1][2] - a[0][2] * a[1][1]) * detInv;
+	inv[1][0] = (a[1][2] * a[2][0] - a[1][0] * a[2][2]) * detInv;
+	inv[1][1] = (a[0][0] * a[2][2] - a[0][2] * a[2][0]) * detInv;
+	inv[1][2] = (a[0][2] * a[1][0] - a[0][0] * a[1][2]) * detInv;
+	inv[2][0] = (a[1][0] * a[2][1] - a[1][1] * a[2][0]) * detInv;
+	inv[2][1] = (a[0][1] * a[2][0] - a[0][0] * a[2][1]) * detInv;
+	inv[2][2] = (a[0][0] * a[1][1] - a[0][1] * a[1][0]) * detInv;
+
+	return true;
+}
+
+/**
+ * Fuse one 3-vector measurement block that directly observes the state
+ * triple starting at index s.
+ *
+ * H is a selector matrix, so S = H*P*H' + R is the (s,s) 3x3 block of P
+ * plus the noise on the diagonal, K = P*H'*S^-1 is formed from columns
+ * s..s+2 of P and the covariance correction K*H*P only needs a saved copy
+ * of rows s..s+2 of P.
+ */
+void
+fuse_block(unsigned s, const float zb[3], float r)
+{
+	/* innovation */
+	float y[3];
+
+	for (unsigned k = 0; k < 3; k++) {
+		y[k] = zb[k] - x_apo[s + k];
+	}
+
+	/* innovation covariance and its inverse */
+	float S[3][3];
+	float S_inv[3][3];
+
+	for (unsigned rr = 0; rr < 3; rr++) {
+		for (unsigned cc = 0; cc < 3; cc++) {
+			S[rr][cc] = P_apo[s + rr][s + cc];
+		}
+
+		S[rr][rr] += r;
+	}
+
+	if (!invert3(S, S_inv)) {
+		/* badly conditioned - keep the apriori state and covariance */
+		return;
+	}
+
+	/* Kalman gain */
+	float K[12][3];
+
+	for (unsigned i = 0; i < 12; i++) {
+		for (unsigned k = 0; k < 3; k++) {
+			K[i][k] = P_apo[i][s] * S_inv[0][k] +
+				  P_apo[i][s + 1] * S_inv[1][k] +
+				  P_apo[i][s + 2] * S_inv[2][k];
+		}
+	}
+
+	/* state correction */
+	for (unsigned i = 0; i < 12; i++) {
+		x_apo[i] += K[i][0] * y[0] + K[i][1] * y[1] + K[i][2] * y[2];
+	}
+
+	/* covariance correction P = (I - K*H)*P applied in place using a
+	 * saved copy of the three rows of P selected by H */
+	float HP[3][12];
+
+	for (unsigned k = 0; k < 3; k++) {
+		for (unsigned j = 0; j < 12; j++) {
+			HP[k][j] = P_apo[s + k][j];
+		}
+	}
+
+	for (unsigned i = 0; i < 12; i++) {
+		for (unsigned j = 0; j < 12; j++) {
+			P_apo[i][j] -= K[i][0] * HP[0][j] + K[i][1] * HP[1][j] + K[i][2] * HP[2][j];
+		}
+	}
+}
+
+} /* namespace */
+
+void AttitudeEKF(unsigned char approx_prediction,
+		 unsigned char use_inertia_matrix,
+		 const unsigned char zFlag[3],
+		 float dt,
+		 const float z[9],
+		 float q_rotSpeed,
+		 float q_rotAcc,
+		 float q_acc,
+		 float q_mag,
+		 float r_gyro,
+		 float r_accel,
+		 float r_mag,
+		 const float J[9],
+		 float xa_apo[12],
+		 float Pa_apo[144],
+		 float Rot_matrix[9],
+		 float eulerAngles[3],
+		 float debugOutput[4])
+{
+	if (!initialized) {
+		/* state: zero rates and accelerations, gravity down, mag field north */
+		memset(x_apo, 0, sizeof(x_apo));
+		x_apo[8] = -9.81f;
+		x_apo[9] = 1.0f;
+
+		for (unsigned i = 0; i < 12; i++) {
+			for (unsigned j = 0; j < 12; j++) {
+				P_apo[i][j] = 200.0f;
+			}
+		}
+
+		/* latch the process noise and inverse inertia, like the
+		 * 'persistent' variables of the MATLAB implementation */
+		for (unsigned i = 0; i < 3; i++) {
+			Q_diag[i] = q_rotSpeed;
+			Q_diag[3 + i] = q_rotAcc;
+			Q_diag[6 + i] = q_acc;
+			Q_diag[9 + i] = q_mag;
+		}
+
+		/* J is stored column major by the generated interface */
+		float Jm[3][3];
+
+		for (unsigned rr = 0; rr < 3; rr++) {
+			for (unsigned cc = 0; cc < 3; cc++) {
+				Jm[rr][cc] = J[rr + 3 * cc];
+			}
+		}
+
+		if (!invert3(Jm, Ji)) {
+			/* singular inertia - disable the gyroscopic torque term */
+			memset(Ji, 0, sizeof(Ji));
+		}
+
+		initialized = true;
+	}
+
+	/* copy the states */
+	Vector<3> w(&x_apo[0]);		/* body angular rates */
+	Vector<3> wa(&x_apo[3]);	/* body angular accelerations */
+	Vector<3> ze(&x_apo[6]);	/* gravity vector */
+	Vector<3> mu(&x_apo[9]);	/* magnetic field vector */
+
+	/* prediction section */
+
+	/* body angular accelerations */
+	Vector<3> wak(wa);
+
+	if (use_inertia_matrix) {
+		/* wak = wa + Ji * (-wa x (J*wa)) * dt, J column major */
+		Vector<3> Jw;
+
+		for (unsigned rr = 0; rr < 3; rr++) {
+			Jw(rr) = J[rr] * wa(0) + J[rr + 3] * wa(1) + J[rr + 6] * wa(2);
+		}
+
+		Vector<3> torque = (Jw % wa);	/* -wa x Jw */
+
+		for (unsigned rr = 0; rr < 3; rr++) {
+			wak(rr) += (Ji[rr][0] * torque(0) + Ji[rr][1] * torque(1) + Ji[rr][2] * torque(2)) * dt;
+		}
+	}
+
+	/* body angular rates */
+	Vector<3> wk = w + wak * dt;
+
+	/* prediction of the gravity and magnetic field vectors; the
+	 * transposed rate skew matrix O satisfies O*v = v x w, so the
+	 * exponential map terms are cross products */
+	Vector<3> zde = ze % w;
+	Vector<3> zek = ze + zde * dt;
+
+	Vector<3> mde = mu % w;
+	Vector<3> muk = mu + mde * dt;
+
+	if (!approx_prediction) {
+		/* second order term of the exponential map */
+		zek += (zde % w) * (dt * dt / 2.0f);
+		muk += (mde % w) * (dt * dt / 2.0f);
+	}
+
+	/* covariance prediction P = A*P*A' + Q with
+	 * A = I + dt * [ 0  I  0  0 ]
+	 *              [ 0  0  0  0 ]
+	 *              [ EZ 0  O  0 ]
+	 *              [ MA 0  0  O ]
+	 * where EZ, MA and O are the (transposed) skew matrices of the
+	 * gravity, mag field and rate states; only the non-zero blocks
+	 * contribute to the products */
+	float O[3][3] = {
+		{ 0.0f,  w(2), -w(1)},
+		{-w(2),  0.0f,  w(0)},
+		{ w(1), -w(0),  0.0f}
+	};
+	float EZ[3][3] = {
+		{ 0.0f, -ze(2),  ze(1)},
+		{ ze(2),  0.0f, -ze(0)},
+		{-ze(1),  ze(0),  0.0f}
+	};
+	float MA[3][3] = {
+		{ 0.0f, -mu(2),  mu(1)},
+		{ mu(2),  0.0f, -mu(0)},
+		{-mu(1),  mu(0),  0.0f}
+	};
+
+	/* T = A*P */
+	for (unsigned j = 0; j < 12; j++) {
+		for (unsigned rr = 0; rr < 3; rr++) {
+			T[rr][j] = P_apo[rr][j] + dt * P_apo[3 + rr][j];
+			T[3 + rr][j] = P_apo[3 + rr][j];
+			T[6 + rr][j] = P_apo[6 + rr][j] + dt *
+				       (EZ[rr][0] * P_apo[0][j] + EZ[rr][1] * P_apo[1][j] + EZ[rr][2] * P_apo[2][j] +
+					O[rr][0] * P_apo[6][j] + O[rr][1] * P_apo[7][j] + O[rr][2] * P_apo[8][j]);
+			T[9 + rr][j] = P_apo[9 + rr][j] + dt *
+				       (MA[rr][0] * P_apo[0][j] + MA[rr][1] * P_apo[1][j] + MA[rr][2] * P_apo[2][j] +
+					O[rr][0] * P_apo[9][j] + O[rr][1] * P_apo[10][j] + O[rr][2] * P_apo[11][j]);
+		}
+	}
+
+	/* P = T*A' + Q */
+	for (unsigned i = 0; i < 12; i++) {
+		for (unsigned cc = 0; cc < 3; cc++) {
+			P_apo[i][cc] = T[i][cc] + dt * T[i][3 + cc];
+			P_apo[i][3 + cc] = T[i][3 + cc];
+			P_apo[i][6 + cc] = T[i][6 + cc] + dt *
+					   (T[i][0] * EZ[cc][0] + T[i][1] * EZ[cc][1] + T[i][2] * EZ[cc][2] +
+					    T[i][6] * O[cc][0] + T[i][7] * O[cc][1] + T[i][8] * O[cc][2]);
+			P_apo[i][9 + cc] = T[i][9 + cc] + dt *
+					   (T[i][0] * MA[cc][0] + T[i][1] * MA[cc][1] + T[i][2] * MA[cc][2] +
+					    T[i][9] * O[cc][0] + T[i][10] * O[cc][1] + T[i][11] * O[cc][2]);
+		}
+	}
+
+	for (unsigned i = 0; i < 12; i++) {
+		P_apo[i][i] += Q_diag[i];
+	}
+
+	/* store the apriori state; the covariance prediction above used the
+	 * previous aposteriori values held in the local vectors */
+	memcpy(&x_apo[0], wk.data, sizeof(wk.data));
+	memcpy(&x_apo[3], wak.data, sizeof(wak.data));
+	memcpy(&x_apo[6], zek.data, sizeof(zek.data));
+	memcpy(&x_apo[9], muk.data, sizeof(muk.data));
+
+	/* update section - fuse the available measurement blocks
+	 * sequentially; with a selector H per block and uncorrelated noise
+	 * this is equivalent to the batch update but only ever needs a 3x3
+	 * innovation inverse */
+	if (zFlag[0]) {
+		fuse_block(0, &z[0], r_gyro);
+
+		if (zFlag[1]) {
+			fuse_block(6, &z[3], r_accel);
+		}
+
+		if (zFlag[2]) {
+			fuse_block(9, &z[6], r_mag);
+		}
+	}
+
+	/* euler angle extraction */
+	Vector<3> ze_apo(&x_apo[6]);
+	Vector<3> mu_apo(&x_apo[9]);
+
+	Vector<3> z_n_b = -ze_apo.normalized();
+	Vector<3> m_n_b = mu_apo.normalized();
+
+	Vector<3> y_n_b = (z_n_b % m_n_b).normalized();
+	Vector<3> x_n_b = (y_n_b % z_n_b).normalized();
+
+	memcpy(xa_apo, x_apo, sizeof(x_apo));
+
+	/* column major, matching the generated interface */
+	for (unsigned cc = 0; cc < 12; cc++) {
+		for (unsigned rr = 0; rr < 12; rr++) {
+			Pa_apo[rr + 12 * cc] = P_apo[rr][cc];
+		}
+	}
+
+	/* rotation matrix from earth to body system, columns x/y/z,
+	 * column major like the generated interface */
+	for (unsigned rr = 0; rr < 3; rr++) {
+		Rot_matrix[rr] = x_n_b(rr);
+		Rot_matrix[3 + rr] = y_n_b(rr);
+		Rot_matrix[6 + rr] = z_n_b(rr);
+	}
+
+	eulerAngles[0] = atan2f(z_n_b(1), z_n_b(2));
+	eulerAngles[1] = -asinf(z_n_b(0));
+	eulerAngles[2] = atan2f(y_n_b(0), x_n_b(0));
+
+	memset(debugOutput, 0, sizeof(float) * 4);
+}
+
+void AttitudeEKF_initialize(void)
+{
+	initialized = false;
+}
+
+void AttitudeEKF_terminate(void)
+{
+	/* nothing to release */
+}
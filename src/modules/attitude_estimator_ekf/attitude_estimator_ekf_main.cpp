@@ -423,7 +423,7 @@ int attitude_estimator_ekf_thread_main(int argc, char *argv[])
 							if (last_vel_t != 0 && vel_t != last_vel_t) {
 								float vel_dt = (vel_t - last_vel_t) / 1000000.0f;
 								/* calculate acceleration in body frame */
-								acc = R.transposed() * ((vel - vel_prev) / vel_dt);
+								acc = R.transposed_mult((vel - vel_prev) / vel_dt);
 							}
 							last_vel_t = vel_t;
 							vel_prev = vel;
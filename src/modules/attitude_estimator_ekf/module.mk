@@ -39,7 +39,7 @@ MODULE_COMMAND	 = attitude_estimator_ekf
 
 SRCS		 = attitude_estimator_ekf_main.cpp \
 		   attitude_estimator_ekf_params.c \
-		   codegen/AttitudeEKF.c
+		   AttitudeEKF.cpp
 
 MODULE_STACKSIZE = 1200
 
@@ -87,6 +87,19 @@ extern "C" {
 
 extern "C" __EXPORT int attitude_estimator_so3_main(int argc, char *argv[]);
 
+/*
+ * Build-time fixed-timestep specialization.  The sensors app publishes
+ * at a fixed 200 Hz, so the timestep can be baked in: the per-step dt
+ * scaling of the integral gain folds into a pre-scaled constant and the
+ * quaternion renormalization reduces to one Newton iteration from
+ * unity, which is exact to first order since the norm drifts only
+ * slightly in one fixed step.  Enabled on FMUv1, where this estimator
+ * is the low-cost default.
+ */
+#ifdef CONFIG_ARCH_BOARD_PX4FMU_V1
+# define SO3_FIXED_DT		0.005f
+#endif
+
 static bool thread_should_exit = false;		/**< Deamon exit flag */
 static bool thread_running = false;		/**< Deamon status flag */
 static int attitude_estimator_so3_task;				/**< Handle of deamon task / thread */
@@ -322,9 +335,16 @@ void NonlinearSO3AHRSupdate(float gx, float gy, float gz, float ax, float ay, fl
 	if(halfex != 0.0f && halfey != 0.0f && halfez != 0.0f) {
 		// Compute and apply integral feedback if enabled
 		if(twoKi > 0.0f) {
+#ifdef SO3_FIXED_DT
+			// integral gain arrives pre-scaled with the fixed timestep
+			gyro_bias[0] += twoKi * halfex;
+			gyro_bias[1] += twoKi * halfey;
+			gyro_bias[2] += twoKi * halfez;
+#else
 			gyro_bias[0] += twoKi * halfex * dt;	// integral error scaled by Ki
 			gyro_bias[1] += twoKi * halfey * dt;
 			gyro_bias[2] += twoKi * halfez * dt;
+#endif
 			
 			// apply integral feedback
 			gx += gyro_bias[0];
@@ -353,18 +373,39 @@ void NonlinearSO3AHRSupdate(float gx, float gy, float gz, float ax, float ay, fl
 	// Time derivative of quaternion. q_dot = 0.5*q\otimes omega.
 	//! q_k = q_{k-1} + dt*\dot{q}
 	//! \dot{q} = 0.5*q \otimes P(\omega)
+#ifdef SO3_FIXED_DT
+	// pre-multiply the constant half-timestep into the rates
+	gx *= (0.5f * SO3_FIXED_DT);
+	gy *= (0.5f * SO3_FIXED_DT);
+	gz *= (0.5f * SO3_FIXED_DT);
+
+	dq0 = -q1 * gx - q2 * gy - q3 * gz;
+	dq1 = q0 * gx + q2 * gz - q3 * gy;
+	dq2 = q0 * gy - q1 * gz + q3 * gx;
+	dq3 = q0 * gz + q1 * gy - q2 * gx;
+
+	q0 += dq0;
+	q1 += dq1;
+	q2 += dq2;
+	q3 += dq3;
+
+	// Normalise quaternion; one Newton iteration from unity is exact
+	// to first order, since the norm drifts only slightly per step
+	recipNorm = 0.5f * (3.0f - (q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3));
+#else
 	dq0 = 0.5f*(-q1 * gx - q2 * gy - q3 * gz);
 	dq1 = 0.5f*(q0 * gx + q2 * gz - q3 * gy);
 	dq2 = 0.5f*(q0 * gy - q1 * gz + q3 * gx);
-	dq3 = 0.5f*(q0 * gz + q1 * gy - q2 * gx); 
+	dq3 = 0.5f*(q0 * gz + q1 * gy - q2 * gx);
 
 	q0 += dt*dq0;
 	q1 += dt*dq1;
 	q2 += dt*dq2;
 	q3 += dt*dq3;
-	
+
 	// Normalise quaternion
 	recipNorm = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+#endif
 	q0 *= recipNorm;
 	q1 *= recipNorm;
 	q2 *= recipNorm;
@@ -452,6 +493,11 @@ int attitude_estimator_so3_thread_main(int argc, char *argv[])
 	parameters_init(&so3_comp_param_handles);
 	parameters_update(&so3_comp_param_handles, &so3_comp_params);
 
+#ifdef SO3_FIXED_DT
+	/* integral gain pre-scaled with the fixed timestep */
+	float Ki_dt = so3_comp_params.Ki * SO3_FIXED_DT;
+#endif
+
 	uint64_t start_time = hrt_absolute_time();
 	bool initialized = false;
 	bool state_initialized = false;
@@ -490,6 +536,10 @@ int attitude_estimator_so3_thread_main(int argc, char *argv[])
 
 				/* update parameters */
 				parameters_update(&so3_comp_param_handles, &so3_comp_params);
+
+#ifdef SO3_FIXED_DT
+				Ki_dt = so3_comp_params.Ki * SO3_FIXED_DT;
+#endif
 			}
 
 			/* only run filter if sensor values changed */
@@ -561,12 +611,22 @@ int attitude_estimator_so3_thread_main(int argc, char *argv[])
 
 					// NOTE : Accelerometer is reversed.
 					// Because proper mount of PX4 will give you a reversed accelerometer readings.
+#ifdef SO3_FIXED_DT
+					/* fixed-timestep path with the integral gain pre-scaled on parameter updates */
+					NonlinearSO3AHRSupdate(gyro[0], gyro[1], gyro[2],
+										-acc[0], -acc[1], -acc[2],
+										mag[0], mag[1], mag[2],
+										so3_comp_params.Kp,
+										Ki_dt,
+										SO3_FIXED_DT);
+#else
 					NonlinearSO3AHRSupdate(gyro[0], gyro[1], gyro[2],
 										-acc[0], -acc[1], -acc[2],
 										mag[0], mag[1], mag[2],
 										so3_comp_params.Kp,
-										so3_comp_params.Ki, 
+										so3_comp_params.Ki,
 										dt);
+#endif
 
 					// Convert q->R, This R converts inertial frame to body frame.
 					Rot_matrix[0] = q0q0 + q1q1 - q2q2 - q3q3;// 11
@@ -394,6 +394,19 @@ BottleDrop::task_main()
 
 	unsigned counter = 0;
 
+	// Incremental ballistics prediction state. The drag integration advances a bounded
+	// number of steps per cycle so a single pass never blows the loop deadline, and the
+	// finished solution is cached against the inputs it was computed for.
+	bool prediction_running = false;			// an integration is in progress
+	bool prediction_cached = false;				// prediction_x holds a finished solution
+	float prediction_wind = 0.0f;				// windspeed the solution is being computed for [m/s]
+	float prediction_h0 = 0.0f;				// height over target the solution is being computed for [m]
+	float prediction_x = 0.0f;				// cached horizontal travel of the payload [m]
+
+	const unsigned prediction_steps_per_cycle = 64;		// upper bound on integration steps per cycle
+	const float prediction_wind_epsilon = 0.5f;		// wind change that invalidates a solution [m/s]
+	const float prediction_alt_epsilon = 5.0f;		// altitude change that invalidates a solution [m]
+
 	param_t param_gproperties = param_find("BD_GPROPERTIES");
 	param_t param_turn_radius = param_find("BD_TURNRADIUS");
 	param_t param_precision = param_find("BD_PRECISION");
@@ -534,45 +547,83 @@ BottleDrop::task_main()
 
 				case DROP_STATE_TARGET_VALID:
 				{
-
-					az = g;							// acceleration in z direction[m/s^2]
-					vz = 0; 						// velocity in z direction [m/s]
-					z = 0; 							// fallen distance [m]
 					h_0 = _global_pos.alt - _target_position.alt; 		// height over target at start[m]
-					h = h_0;						// height over target [m]
-					ax = 0;							// acceleration in x direction [m/s^2]
-					vx = groundspeed_body;// XXX project					// ground speed in x direction [m/s]
-					x = 0;							// traveled distance in x direction [m]
-					vw = 0;							// wind speed [m/s]
-					vrx = 0;						// relative velocity in x direction [m/s]
-					v = groundspeed_body;					// relative speed vector [m/s]
-					Fd = 0;							// Drag force [N]
-					Fdx = 0;						// Drag force in x direction [N]
-					Fdz = 0;						// Drag force in z direction [N]
-
-
-					// Compute the distance the bottle will travel after it is dropped in body frame coordinates --> x
-					while (h > 0.05f) {
-						// z-direction
-						vz = vz + az * dt_freefall_prediction;
-						z = z + vz * dt_freefall_prediction;
-						h = h_0 - z;
-
-						// x-direction
-						vw = windspeed_norm * logf(h / z_0) / logf(ground_distance / z_0);
-						vx = vx + ax * dt_freefall_prediction;
-						x = x + vx * dt_freefall_prediction;
-						vrx = vx + vw;
-
-						// drag force
-						v = sqrtf(vz * vz + vrx * vrx);
-						Fd = 0.5f * rho * A * cd * (v * v);
-						Fdx = Fd * vrx / v;
-						Fdz = Fd * vz / v;
-
-						// acceleration
-						az = g - Fdz / m;
-						ax = -Fdx / m;
+
+					// a running integration is restarted when its inputs have moved away from
+					// the snapshot it was started with
+					if (prediction_running &&
+					    (fabsf(windspeed_norm - prediction_wind) > prediction_wind_epsilon ||
+					     fabsf(h_0 - prediction_h0) > prediction_alt_epsilon)) {
+						prediction_running = false;
+					}
+
+					if (prediction_cached &&
+					    fabsf(windspeed_norm - prediction_wind) < prediction_wind_epsilon &&
+					    fabsf(h_0 - prediction_h0) < prediction_alt_epsilon) {
+						// wind and altitude are still close to the cached solution
+						x = prediction_x;
+
+					} else {
+						if (!prediction_running) {
+							az = g;							// acceleration in z direction[m/s^2]
+							vz = 0; 						// velocity in z direction [m/s]
+							z = 0; 							// fallen distance [m]
+							h = h_0;						// height over target [m]
+							ax = 0;							// acceleration in x direction [m/s^2]
+							vx = groundspeed_body;// XXX project					// ground speed in x direction [m/s]
+							x = 0;							// traveled distance in x direction [m]
+							vw = 0;							// wind speed [m/s]
+							vrx = 0;						// relative velocity in x direction [m/s]
+							v = groundspeed_body;					// relative speed vector [m/s]
+							Fd = 0;							// Drag force [N]
+							Fdx = 0;						// Drag force in x direction [N]
+							Fdz = 0;						// Drag force in z direction [N]
+
+							// snapshot the inputs so the integration stays self-consistent
+							// across cycles
+							prediction_wind = windspeed_norm;
+							prediction_h0 = h_0;
+							prediction_cached = false;
+							prediction_running = true;
+						}
+
+						// Compute the distance the bottle will travel after it is dropped in
+						// body frame coordinates --> x; only advance the integration a bounded
+						// number of steps per cycle so this loop stays within deadline
+						unsigned steps = 0;
+
+						while (h > 0.05f && steps < prediction_steps_per_cycle) {
+							// z-direction
+							vz = vz + az * dt_freefall_prediction;
+							z = z + vz * dt_freefall_prediction;
+							h = prediction_h0 - z;
+
+							// x-direction
+							vw = prediction_wind * logf(h / z_0) / logf(prediction_h0 / z_0);
+							vx = vx + ax * dt_freefall_prediction;
+							x = x + vx * dt_freefall_prediction;
+							vrx = vx + vw;
+
+							// drag force
+							v = sqrtf(vz * vz + vrx * vrx);
+							Fd = 0.5f * rho * A * cd * (v * v);
+							Fdx = Fd * vrx / v;
+							Fdz = Fd * vz / v;
+
+							// acceleration
+							az = g - Fdz / m;
+							ax = -Fdx / m;
+							steps++;
+						}
+
+						if (h > 0.05f) {
+							// not finished yet - pick the integration up again next cycle
+							break;
+						}
+
+						prediction_running = false;
+						prediction_cached = true;
+						prediction_x = x;
 					}
 
 					// compute drop vector
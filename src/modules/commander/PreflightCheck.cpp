@@ -112,7 +112,7 @@ out:
 	return success;
 }
 
-static bool accelerometerCheck(int mavlink_fd, unsigned instance, bool optional, bool dynamic)
+static bool accelerometerCheck(int mavlink_fd, unsigned instance, bool optional)
 {
 	bool success = true;
 
@@ -151,30 +151,43 @@ static bool accelerometerCheck(int mavlink_fd, unsigned instance, bool optional,
 		goto out;
 	}
 
-	if (dynamic) {
-		/* check measurement result range */
-		struct accel_report acc;
-		ret = read(fd, &acc, sizeof(acc));
+out:
+	close(fd);
+	return success;
+}
+
+static bool accelerometerMeasurementCheck(int mavlink_fd, unsigned instance)
+{
+	bool success = true;
 
-		if (ret == sizeof(acc)) {
-			/* evaluate values */
-			float accel_magnitude = sqrtf(acc.x * acc.x + acc.y * acc.y + acc.z * acc.z);
+	char s[30];
+	sprintf(s, "%s%u", ACCEL_BASE_DEVICE_PATH, instance);
+	int fd = open(s, O_RDONLY);
 
-			if (accel_magnitude < 4.0f || accel_magnitude > 15.0f /* m/s^2 */) {
-				mavlink_and_console_log_critical(mavlink_fd, "PREFLIGHT FAIL: ACCEL RANGE, hold still");
-				/* this is frickin' fatal */
-				success = false;
-				goto out;
-			}
-		} else {
-			mavlink_log_critical(mavlink_fd, "PREFLIGHT FAIL: ACCEL READ");
+	if (fd < 0) {
+		/* a missing sensor was already reported by the static check */
+		return false;
+	}
+
+	/* check measurement result range */
+	struct accel_report acc;
+	int ret = read(fd, &acc, sizeof(acc));
+
+	if (ret == sizeof(acc)) {
+		/* evaluate values */
+		float accel_magnitude = sqrtf(acc.x * acc.x + acc.y * acc.y + acc.z * acc.z);
+
+		if (accel_magnitude < 4.0f || accel_magnitude > 15.0f /* m/s^2 */) {
+			mavlink_and_console_log_critical(mavlink_fd, "PREFLIGHT FAIL: ACCEL RANGE, hold still");
 			/* this is frickin' fatal */
 			success = false;
-			goto out;
 		}
+	} else {
+		mavlink_log_critical(mavlink_fd, "PREFLIGHT FAIL: ACCEL READ");
+		/* this is frickin' fatal */
+		success = false;
 	}
 
-out:
 	close(fd);
 	return success;
 }
@@ -269,73 +282,115 @@ out:
 	return success;
 }
 
+/*
+ * The static checks (device presence, calibration IDs, self-tests, RC
+ * calibration) only change when sensors are recalibrated or replugged, but
+ * the self-test ioctls block for long enough to be felt at arming time.
+ * A passing verdict is therefore cached and reused until
+ * preflightCheckInvalidate() is called; failing verdicts are never cached so
+ * the failure messages are re-emitted on every attempt.
+ */
+static bool static_checks_passed = false;	/**< true if the cached static checks passed */
+static uint8_t static_checks_mask = 0;		/**< check selection the cached verdict was computed with */
+
+void preflightCheckInvalidate()
+{
+	static_checks_passed = false;
+}
+
 bool preflightCheck(int mavlink_fd, bool checkMag, bool checkAcc, bool checkGyro,
 		    bool checkBaro, bool checkAirspeed, bool checkRC, bool checkDynamic)
 {
 	bool failed = false;
 
-	/* ---- MAG ---- */
-	if (checkMag) {
-		/* check all sensors, but fail only for mandatory ones */
-		for (unsigned i = 0; i < max_optional_mag_count; i++) {
-			bool required = (i < max_mandatory_mag_count);
+	/* mask of the static checks requested this time */
+	const uint8_t request_mask = (checkMag ? (1 << 0) : 0) |
+				     (checkAcc ? (1 << 1) : 0) |
+				     (checkGyro ? (1 << 2) : 0) |
+				     (checkBaro ? (1 << 3) : 0) |
+				     (checkRC ? (1 << 4) : 0);
 
-			if (!magnometerCheck(mavlink_fd, i, !required) && required) {
-				failed = true;
+	if (!static_checks_passed || static_checks_mask != request_mask) {
+
+		/* ---- MAG ---- */
+		if (checkMag) {
+			/* check all sensors, but fail only for mandatory ones */
+			for (unsigned i = 0; i < max_optional_mag_count; i++) {
+				bool required = (i < max_mandatory_mag_count);
+
+				if (!magnometerCheck(mavlink_fd, i, !required) && required) {
+					failed = true;
+				}
 			}
 		}
-	}
 
-	/* ---- ACCEL ---- */
-	if (checkAcc) {
-		/* check all sensors, but fail only for mandatory ones */
-		for (unsigned i = 0; i < max_optional_accel_count; i++) {
-			bool required = (i < max_mandatory_accel_count);
+		/* ---- ACCEL ---- */
+		if (checkAcc) {
+			/* check all sensors, but fail only for mandatory ones */
+			for (unsigned i = 0; i < max_optional_accel_count; i++) {
+				bool required = (i < max_mandatory_accel_count);
 
-			if (!accelerometerCheck(mavlink_fd, i, !required, checkDynamic) && required) {
-				failed = true;
+				if (!accelerometerCheck(mavlink_fd, i, !required) && required) {
+					failed = true;
+				}
 			}
 		}
-	}
 
-	/* ---- GYRO ---- */
-	if (checkGyro) {
-		/* check all sensors, but fail only for mandatory ones */
-		for (unsigned i = 0; i < max_optional_gyro_count; i++) {
-			bool required = (i < max_mandatory_gyro_count);
+		/* ---- GYRO ---- */
+		if (checkGyro) {
+			/* check all sensors, but fail only for mandatory ones */
+			for (unsigned i = 0; i < max_optional_gyro_count; i++) {
+				bool required = (i < max_mandatory_gyro_count);
+
+				if (!gyroCheck(mavlink_fd, i, !required) && required) {
+					failed = true;
+				}
+			}
+		}
 
-			if (!gyroCheck(mavlink_fd, i, !required) && required) {
+		/* ---- BARO ---- */
+		if (checkBaro) {
+			/* check all sensors, but fail only for mandatory ones */
+			for (unsigned i = 0; i < max_optional_baro_count; i++) {
+				bool required = (i < max_mandatory_baro_count);
+
+				if (!baroCheck(mavlink_fd, i, !required) && required) {
+					failed = true;
+				}
+			}
+		}
+
+		/* ---- RC CALIBRATION ---- */
+		if (checkRC) {
+			if (rc_calibration_check(mavlink_fd) != OK) {
 				failed = true;
 			}
 		}
+
+		/* only a passing verdict is kept */
+		static_checks_passed = !failed;
+		static_checks_mask = request_mask;
 	}
 
-	/* ---- BARO ---- */
-	if (checkBaro) {
+	/* ---- ACCEL measurement sanity, must reflect the current motion state ---- */
+	if (checkAcc && checkDynamic) {
 		/* check all sensors, but fail only for mandatory ones */
-		for (unsigned i = 0; i < max_optional_baro_count; i++) {
-			bool required = (i < max_mandatory_baro_count);
+		for (unsigned i = 0; i < max_optional_accel_count; i++) {
+			bool required = (i < max_mandatory_accel_count);
 
-			if (!baroCheck(mavlink_fd, i, !required) && required) {
+			if (!accelerometerMeasurementCheck(mavlink_fd, i) && required) {
 				failed = true;
 			}
 		}
 	}
 
-	/* ---- AIRSPEED ---- */
+	/* ---- AIRSPEED, checks data freshness and is never cached ---- */
 	if (checkAirspeed) {
 		if (!airspeedCheck(mavlink_fd, true)) {
 			failed = true;
 		}
 	}
 
-	/* ---- RC CALIBRATION ---- */
-	if (checkRC) {
-		if (rc_calibration_check(mavlink_fd) != OK) {
-			failed = true;
-		}
-	}
-
 	/* Report status */
 	return !failed;
 }
@@ -65,6 +65,15 @@ namespace Commander
 bool preflightCheck(int mavlink_fd, bool checkMag, bool checkAcc,
 	bool checkGyro, bool checkBaro, bool checkAirspeed, bool checkRC, bool checkDynamic = false);
 
+/**
+* Invalidates the cached verdict of the static checks.
+*
+* Must be called whenever sensor calibration may have changed, e.g. on
+* parameter updates; the next preflightCheck() call then re-runs the
+* self-tests instead of reusing the cached result.
+**/
+void preflightCheckInvalidate();
+
 const unsigned max_mandatory_gyro_count = 1;
 const unsigned max_optional_gyro_count = 3;
 
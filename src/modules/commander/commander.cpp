@@ -83,10 +83,12 @@
 #include <uORB/topics/differential_pressure.h>
 #include <uORB/topics/safety.h>
 #include <uORB/topics/system_power.h>
+#include <uORB/topics/load_governor.h>
 #include <uORB/topics/mission.h>
 #include <uORB/topics/mission_result.h>
 #include <uORB/topics/geofence_result.h>
 #include <uORB/topics/telemetry_status.h>
+#include <uORB/topics/datalink_status.h>
 #include <uORB/topics/vtol_vehicle_status.h>
  #include <uORB/topics/vehicle_land_detected.h>
 
@@ -100,6 +102,7 @@
 #include <systemlib/err.h>
 #include <systemlib/cpuload.h>
 #include <systemlib/rc_check.h>
+#include <systemlib/watchdog.h>
 #include <geo/geo.h>
 #include <systemlib/state_table.h>
 #include <dataman/dataman.h>
@@ -114,6 +117,7 @@
 #include "baro_calibration.h"
 #include "rc_calibration.h"
 #include "airspeed_calibration.h"
+#include "datalink_monitor.h"
 #include "PreflightCheck.h"
 
 /* oddly, ERROR is not defined for c++ */
@@ -126,13 +130,9 @@ extern struct system_load_s system_load;
 
 /* Decouple update interval and hysteris counters, all depends on intervals */
 #define COMMANDER_MONITORING_INTERVAL 50000
-#define COMMANDER_MONITORING_LOOPSPERMSEC (1/(COMMANDER_MONITORING_INTERVAL/1000.0f))
-
-#define MAVLINK_OPEN_INTERVAL 50000
 
 #define STICK_ON_OFF_LIMIT 0.9f
 #define STICK_ON_OFF_HYSTERESIS_TIME_MS 1000
-#define STICK_ON_OFF_COUNTER_LIMIT (STICK_ON_OFF_HYSTERESIS_TIME_MS*COMMANDER_MONITORING_LOOPSPERMSEC)
 
 #define POSITION_TIMEOUT		(1 * 1000 * 1000)	/**< consider the local or global position estimate invalid after 1000ms */
 #define FAILSAFE_DEFAULT_TIMEOUT	(3 * 1000 * 1000)	/**< hysteresis time - the failsafe will trigger after 3 seconds in this state */
@@ -320,22 +320,35 @@ int commander_main(int argc, char *argv[])
 
 	if (!strcmp(argv[1], "calibrate")) {
 		if (argc > 2) {
-			int calib_ret = OK;
+			/* hand the job to the low priority worker instead of running
+			 * the sampling loop at shell priority; this also applies the
+			 * same arming checks as a GCS-commanded calibration */
+			struct vehicle_command_s vcmd;
+			memset(&vcmd, 0, sizeof(vcmd));
+			vcmd.command = VEHICLE_CMD_PREFLIGHT_CALIBRATION;
+
 			if (!strcmp(argv[2], "mag")) {
-				calib_ret = do_mag_calibration(mavlink_fd);
+				vcmd.param2 = 1;
 			} else if (!strcmp(argv[2], "accel")) {
-				calib_ret = do_accel_calibration(mavlink_fd);
+				vcmd.param5 = 1;
 			} else if (!strcmp(argv[2], "gyro")) {
-				calib_ret = do_gyro_calibration(mavlink_fd);
+				vcmd.param1 = 1;
 			} else {
-				warnx("argument %s unsupported.", argv[2]);
+				errx(1, "argument %s unsupported.", argv[2]);
 			}
 
-			if (calib_ret) {
-				errx(1, "calibration failed, exiting.");
-			} else {
-				exit(0);
+			vcmd.target_system = status.system_id;
+			vcmd.target_component = status.component_id;
+
+			int fd = orb_advertise(ORB_ID(vehicle_command), &vcmd);
+
+			if (fd < 0) {
+				errx(1, "calibration request failed.");
 			}
+
+			close(fd);
+			warnx("calibration started, progress is reported via MAVLink");
+			exit(0);
 		} else {
 			warnx("missing argument");
 		}
@@ -985,9 +998,8 @@ int commander_thread_main(int argc, char *argv[])
 	int ret;
 
 	/* Start monitoring loop */
-	unsigned counter = 0;
-	unsigned stick_off_counter = 0;
-	unsigned stick_on_counter = 0;
+	hrt_abstime stick_off_time = 0;	/**< time the disarm stick gesture was first seen, 0 if not active */
+	hrt_abstime stick_on_time = 0;	/**< time the arm stick gesture was first seen, 0 if not active */
 
 	bool low_battery_voltage_actions_done = false;
 	bool critical_battery_voltage_actions_done = false;
@@ -1029,16 +1041,20 @@ int commander_thread_main(int argc, char *argv[])
 	/* Subscribe to telemetry status topics */
 	int telemetry_subs[TELEMETRY_STATUS_ORB_ID_NUM];
 	uint64_t telemetry_last_heartbeat[TELEMETRY_STATUS_ORB_ID_NUM];
-	uint64_t telemetry_last_dl_loss[TELEMETRY_STATUS_ORB_ID_NUM];
-	bool telemetry_lost[TELEMETRY_STATUS_ORB_ID_NUM];
 
 	for (int i = 0; i < TELEMETRY_STATUS_ORB_ID_NUM; i++) {
 		telemetry_subs[i] = orb_subscribe(telemetry_status_orb_id[i]);
 		telemetry_last_heartbeat[i] = 0;
-		telemetry_last_dl_loss[i] = 0;
-		telemetry_lost[i] = true;
 	}
 
+	/* start the telemetry link watchdog and subscribe to its state topic */
+	datalink_monitor_init();
+
+	int datalink_status_sub = orb_subscribe(ORB_ID(datalink_status));
+	struct datalink_status_s datalink_status;
+	memset(&datalink_status, 0, sizeof(datalink_status));
+	datalink_status.data_link_lost = true;
+
 	/* Subscribe to global position */
 	int global_position_sub = orb_subscribe(ORB_ID(vehicle_global_position));
 	struct vehicle_global_position_s global_position;
@@ -1108,6 +1124,11 @@ int commander_thread_main(int argc, char *argv[])
 	struct system_power_s system_power;
 	memset(&system_power, 0, sizeof(system_power));
 
+	/* Subscribe to the load governor */
+	int load_gov_sub = orb_subscribe(ORB_ID(load_governor));
+	struct load_governor_s load_gov;
+	memset(&load_gov, 0, sizeof(load_gov));
+
 	/* Subscribe to actuator controls (outputs) */
 	int actuator_controls_sub = orb_subscribe(ORB_ID_VEHICLE_ATTITUDE_CONTROLS);
 	struct actuator_controls_s actuator_controls;
@@ -1182,18 +1203,97 @@ int commander_thread_main(int argc, char *argv[])
 	pthread_create(&commander_low_prio_thread, &commander_low_prio_attr, commander_low_prio_loop, NULL);
 	pthread_attr_destroy(&commander_low_prio_attr);
 
+	/* index of each subscription in the batched update check below */
+	enum {
+		SUB_PARAM_CHANGED = 0,
+		SUB_SP_MAN,
+		SUB_OFFBOARD_CONTROL_MODE,
+		SUB_TELEMETRY_FIRST,
+		SUB_SENSOR = SUB_TELEMETRY_FIRST + TELEMETRY_STATUS_ORB_ID_NUM,
+		SUB_DIFF_PRES,
+		SUB_SYSTEM_POWER,
+		SUB_SAFETY,
+		SUB_VTOL_STATUS,
+		SUB_GLOBAL_POSITION,
+		SUB_LOCAL_POSITION,
+		SUB_LAND_DETECTOR,
+		SUB_BATTERY,
+		SUB_SUBSYS,
+		SUB_POS_SP_TRIPLET,
+		SUB_GPS,
+		SUB_MISSION_RESULT,
+		SUB_GEOFENCE_RESULT,
+		SUB_CMD,
+		SUB_DATALINK,
+		SUB_LOAD_GOV,
+		SUB_COUNT
+	};
+
+	int check_subs[SUB_COUNT];
+	check_subs[SUB_PARAM_CHANGED] = param_changed_sub;
+	check_subs[SUB_SP_MAN] = sp_man_sub;
+	check_subs[SUB_OFFBOARD_CONTROL_MODE] = offboard_control_mode_sub;
+
+	for (int i = 0; i < TELEMETRY_STATUS_ORB_ID_NUM; i++) {
+		check_subs[SUB_TELEMETRY_FIRST + i] = telemetry_subs[i];
+	}
+
+	check_subs[SUB_SENSOR] = sensor_sub;
+	check_subs[SUB_DIFF_PRES] = diff_pres_sub;
+	check_subs[SUB_SYSTEM_POWER] = system_power_sub;
+	check_subs[SUB_SAFETY] = safety_sub;
+	check_subs[SUB_VTOL_STATUS] = vtol_vehicle_status_sub;
+	check_subs[SUB_GLOBAL_POSITION] = global_position_sub;
+	check_subs[SUB_LOCAL_POSITION] = local_position_sub;
+	check_subs[SUB_LAND_DETECTOR] = land_detector_sub;
+	check_subs[SUB_BATTERY] = battery_sub;
+	check_subs[SUB_SUBSYS] = subsys_sub;
+	check_subs[SUB_POS_SP_TRIPLET] = pos_sp_triplet_sub;
+	check_subs[SUB_GPS] = gps_sub;
+	check_subs[SUB_MISSION_RESULT] = mission_result_sub;
+	check_subs[SUB_GEOFENCE_RESULT] = geofence_result_sub;
+	check_subs[SUB_CMD] = cmd_sub;
+	check_subs[SUB_DATALINK] = datalink_status_sub;
+	check_subs[SUB_LOAD_GOV] = load_gov_sub;
+
+	bool sub_updated[SUB_COUNT];
+
+	/* wakeup sources: react to manual control, command input and
+	 * link state changes immediately */
+	struct pollfd fds[3];
+	fds[0].fd = sp_man_sub;
+	fds[0].events = POLLIN;
+	fds[1].fd = cmd_sub;
+	fds[1].events = POLLIN;
+	fds[2].fd = datalink_status_sub;
+	fds[2].events = POLLIN;
+
+	/* timestamps for the periodic tasks, now that the loop is event paced */
+	hrt_abstime last_mavlink_open_time = 0;
+	hrt_abstime last_load_time = 0;
+	hrt_abstime last_publish_time = 0;
+
+	/* check in with the hardware watchdog once per cycle */
+	struct watchdog_client_s wdog;
+	watchdog_register(&wdog, "commander", 5000);
+
 	while (!thread_should_exit) {
 
-		if (mavlink_fd < 0 && counter % (1000000 / MAVLINK_OPEN_INTERVAL) == 0) {
+		watchdog_checkin(&wdog);
+
+		if (mavlink_fd < 0 && hrt_elapsed_time(&last_mavlink_open_time) > 1000000) {
 			/* try to open the mavlink log device every once in a while */
+			last_mavlink_open_time = hrt_absolute_time();
 			mavlink_fd = open(MAVLINK_LOG_DEVICE, 0);
 		}
 
 		arming_ret = TRANSITION_NOT_CHANGED;
 
+		/* check all subscriptions in one pass */
+		orb_check_multi(check_subs, sub_updated, SUB_COUNT);
 
 		/* update parameters */
-		orb_check(param_changed_sub, &updated);
+		updated = sub_updated[SUB_PARAM_CHANGED];
 
 		if (updated || param_init_forced) {
 			param_init_forced = false;
@@ -1202,6 +1302,9 @@ int commander_thread_main(int argc, char *argv[])
 			struct parameter_update_s param_changed;
 			orb_copy(ORB_ID(parameter_update), param_changed_sub, &param_changed);
 
+			/* calibration may have changed, drop the cached preflight verdict */
+			Commander::preflightCheckInvalidate();
+
 			/* update parameters */
 			if (!armed.armed) {
 				if (param_get(_param_sys_type, &(status.system_type)) != OK) {
@@ -1247,6 +1350,7 @@ int commander_thread_main(int argc, char *argv[])
 			param_get(_param_datalink_loss_timeout, &datalink_loss_timeout);
 			param_get(_param_rc_loss_timeout, &rc_loss_timeout);
 			param_get(_param_datalink_regain_timeout, &datalink_regain_timeout);
+			datalink_monitor_set_timeouts(datalink_loss_timeout, datalink_regain_timeout);
 			param_get(_param_ef_throttle_thres, &ef_throttle_thres);
 			param_get(_param_ef_current2throttle_thres, &ef_current2throttle_thres);
 			param_get(_param_ef_time_thres, &ef_time_thres);
@@ -1264,13 +1368,13 @@ int commander_thread_main(int argc, char *argv[])
 			need_param_autosave = true;
 		}
 
-		orb_check(sp_man_sub, &updated);
+		updated = sub_updated[SUB_SP_MAN];
 
 		if (updated) {
 			orb_copy(ORB_ID(manual_control_setpoint), sp_man_sub, &sp_man);
 		}
 
-		orb_check(offboard_control_mode_sub, &updated);
+		updated = sub_updated[SUB_OFFBOARD_CONTROL_MODE];
 
 		if (updated) {
 			orb_copy(ORB_ID(offboard_control_mode), offboard_control_mode_sub, &offboard_control_mode);
@@ -1291,7 +1395,7 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		for (int i = 0; i < TELEMETRY_STATUS_ORB_ID_NUM; i++) {
-			orb_check(telemetry_subs[i], &updated);
+			updated = sub_updated[SUB_TELEMETRY_FIRST + i];
 
 			if (updated) {
 				struct telemetry_status_s telemetry;
@@ -1317,10 +1421,13 @@ int commander_thread_main(int argc, char *argv[])
 				}
 
 				telemetry_last_heartbeat[i] = telemetry.heartbeat_time;
+
+				/* feed the link watchdog */
+				datalink_monitor_heartbeat(i, telemetry.heartbeat_time);
 			}
 		}
 
-		orb_check(sensor_sub, &updated);
+		updated = sub_updated[SUB_SENSOR];
 
 		if (updated) {
 			orb_copy(ORB_ID(sensor_combined), sensor_sub, &sensors);
@@ -1347,13 +1454,13 @@ int commander_thread_main(int argc, char *argv[])
 			}
 		}
 
-		orb_check(diff_pres_sub, &updated);
+		updated = sub_updated[SUB_DIFF_PRES];
 
 		if (updated) {
 			orb_copy(ORB_ID(differential_pressure), diff_pres_sub, &diff_pres);
 		}
 
-		orb_check(system_power_sub, &updated);
+		updated = sub_updated[SUB_SYSTEM_POWER];
 
 		if (updated) {
 			orb_copy(ORB_ID(system_power), system_power_sub, &system_power);
@@ -1375,10 +1482,17 @@ int commander_thread_main(int argc, char *argv[])
 			}
 		}
 
+		/* update load governor state */
+		updated = sub_updated[SUB_LOAD_GOV];
+
+		if (updated) {
+			orb_copy(ORB_ID(load_governor), load_gov_sub, &load_gov);
+		}
+
 		check_valid(diff_pres.timestamp, DIFFPRESS_TIMEOUT, true, &(status.condition_airspeed_valid), &status_changed);
 
 		/* update safety topic */
-		orb_check(safety_sub, &updated);
+		updated = sub_updated[SUB_SAFETY];
 
 		if (updated) {
 			bool previous_safety_off = safety.safety_off;
@@ -1411,7 +1525,7 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* update vtol vehicle status*/
-		orb_check(vtol_vehicle_status_sub, &updated);
+		updated = sub_updated[SUB_VTOL_STATUS];
 
 		if (updated) {
 			/* vtol status changed */
@@ -1425,7 +1539,7 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* update global position estimate */
-		orb_check(global_position_sub, &updated);
+		updated = sub_updated[SUB_GLOBAL_POSITION];
 
 		if (updated) {
 			/* position changed */
@@ -1433,7 +1547,7 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* update local position estimate */
-		orb_check(local_position_sub, &updated);
+		updated = sub_updated[SUB_LOCAL_POSITION];
 
 		if (updated) {
 			/* position changed */
@@ -1485,7 +1599,7 @@ int commander_thread_main(int argc, char *argv[])
 			    &(status.condition_local_altitude_valid), &status_changed);
 
 		/* Update land detector */
-		orb_check(land_detector_sub, &updated);
+		updated = sub_updated[SUB_LAND_DETECTOR];
 		if(updated) {
 			orb_copy(ORB_ID(vehicle_land_detected), land_detector_sub, &land_detector);
 		}
@@ -1505,7 +1619,7 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* update battery status */
-		orb_check(battery_sub, &updated);
+		updated = sub_updated[SUB_BATTERY];
 
 		if (updated) {
 			orb_copy(ORB_ID(battery_status), battery_sub, &battery);
@@ -1525,7 +1639,7 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* update subsystem */
-		orb_check(subsys_sub, &updated);
+		updated = sub_updated[SUB_SUBSYS];
 
 		if (updated) {
 			orb_copy(ORB_ID(subsystem_info), subsys_sub, &info);
@@ -1560,13 +1674,15 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* update position setpoint triplet */
-		orb_check(pos_sp_triplet_sub, &updated);
+		updated = sub_updated[SUB_POS_SP_TRIPLET];
 
 		if (updated) {
 			orb_copy(ORB_ID(position_setpoint_triplet), pos_sp_triplet_sub, &pos_sp_triplet);
 		}
 
-		if (counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
+		if (hrt_elapsed_time(&last_load_time) >= 1000000) {
+			last_load_time = hrt_absolute_time();
+
 			/* compute system load */
 			uint64_t interval_runtime = system_load.tasks[0].total_runtime - last_idle_time;
 
@@ -1634,7 +1750,7 @@ int commander_thread_main(int argc, char *argv[])
 		 * set of position measurements is available.
 		 */
 
-		orb_check(gps_sub, &updated);
+		updated = sub_updated[SUB_GPS];
 
 		if (updated) {
 			orb_copy(ORB_ID(vehicle_gps_position), gps_sub, &gps_position);
@@ -1670,14 +1786,14 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* start mission result check */
-		orb_check(mission_result_sub, &updated);
+		updated = sub_updated[SUB_MISSION_RESULT];
 
 		if (updated) {
 			orb_copy(ORB_ID(mission_result), mission_result_sub, &mission_result);
 		}
 
 		/* start geofence result check */
-		orb_check(geofence_result_sub, &updated);
+		updated = sub_updated[SUB_GEOFENCE_RESULT];
 
 		if (updated) {
 			orb_copy(ORB_ID(geofence_result), geofence_result_sub, &geofence_result);
@@ -1697,7 +1813,10 @@ int commander_thread_main(int argc, char *argv[])
 				flight_termination_printed = true;
 			}
 
-			if (counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
+			static hrt_abstime last_gf_msg_time = 0;
+
+			if (hrt_elapsed_time(&last_gf_msg_time) > 1000000) {
+				last_gf_msg_time = hrt_absolute_time();
 				mavlink_log_critical(mavlink_fd, "GF violation: flight termination");
 			}
 		} // no reset is done here on purpose, on geofence violation we want to stay in flighttermination
@@ -1728,7 +1847,10 @@ int commander_thread_main(int argc, char *argv[])
 			    (status.main_state == vehicle_status_s::MAIN_STATE_MANUAL || status.main_state == vehicle_status_s::MAIN_STATE_ACRO || status.condition_landed) &&
 			    sp_man.r < -STICK_ON_OFF_LIMIT && sp_man.z < 0.1f) {
 
-				if (stick_off_counter > STICK_ON_OFF_COUNTER_LIMIT) {
+				if (stick_off_time == 0) {
+					stick_off_time = hrt_absolute_time();
+
+				} else if (hrt_elapsed_time(&stick_off_time) > STICK_ON_OFF_HYSTERESIS_TIME_MS * 1000) {
 					/* disarm to STANDBY if ARMED or to STANDBY_ERROR if ARMED_ERROR */
 					arming_state_t new_arming_state = (status.arming_state == vehicle_status_s::ARMING_STATE_ARMED ? vehicle_status_s::ARMING_STATE_STANDBY :
 									   vehicle_status_s::ARMING_STATE_STANDBY_ERROR);
@@ -1739,20 +1861,20 @@ int commander_thread_main(int argc, char *argv[])
 						arming_state_changed = true;
 					}
 
-					stick_off_counter = 0;
-
-				} else {
-					stick_off_counter++;
+					stick_off_time = 0;
 				}
 
 			} else {
-				stick_off_counter = 0;
+				stick_off_time = 0;
 			}
 
 			/* check if left stick is in lower right position and we're in MANUAL mode -> arm */
 			if (status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY &&
 			    sp_man.r > STICK_ON_OFF_LIMIT && sp_man.z < 0.1f) {
-				if (stick_on_counter > STICK_ON_OFF_COUNTER_LIMIT) {
+				if (stick_on_time == 0) {
+					stick_on_time = hrt_absolute_time();
+
+				} else if (hrt_elapsed_time(&stick_on_time) > STICK_ON_OFF_HYSTERESIS_TIME_MS * 1000) {
 
 					/* we check outside of the transition function here because the requirement
 					 * for being in manual mode only applies to manual arming actions.
@@ -1770,14 +1892,11 @@ int commander_thread_main(int argc, char *argv[])
 						}
 					}
 
-					stick_on_counter = 0;
-
-				} else {
-					stick_on_counter++;
+					stick_on_time = 0;
 				}
 
 			} else {
-				stick_on_counter = 0;
+				stick_on_time = 0;
 			}
 
 			if (arming_ret == TRANSITION_CHANGED) {
@@ -1822,51 +1941,40 @@ int commander_thread_main(int argc, char *argv[])
 			}
 		}
 
-		/* data links check */
-		bool have_link = false;
+		/* data links check: the link watchdog publishes exactly on state changes */
+		updated = sub_updated[SUB_DATALINK];
 
-		for (int i = 0; i < TELEMETRY_STATUS_ORB_ID_NUM; i++) {
-			if (telemetry_last_heartbeat[i] != 0 &&
-			    hrt_elapsed_time(&telemetry_last_heartbeat[i]) < datalink_loss_timeout * 1e6) {
-				/* handle the case where data link was regained,
-				 * accept datalink as healthy only after datalink_regain_timeout seconds
-				 * */
-				if (telemetry_lost[i] &&
-				    hrt_elapsed_time(&telemetry_last_dl_loss[i]) > datalink_regain_timeout * 1e6) {
+		if (updated) {
+			uint8_t last_link_ok_mask = datalink_status.link_ok_mask;
 
-					mavlink_log_info(mavlink_fd, "data link %i regained", i);
-					telemetry_lost[i] = false;
-					have_link = true;
+			orb_copy(ORB_ID(datalink_status), datalink_status_sub, &datalink_status);
 
-				} else if (!telemetry_lost[i]) {
-					/* telemetry was healthy also in last iteration
-					 * we don't have to check a timeout */
-					have_link = true;
-				}
+			for (int i = 0; i < TELEMETRY_STATUS_ORB_ID_NUM; i++) {
+				bool was_ok = (last_link_ok_mask & (1 << i)) != 0;
+				bool is_ok = (datalink_status.link_ok_mask & (1 << i)) != 0;
 
-			} else {
-				telemetry_last_dl_loss[i]  = hrt_absolute_time();
+				if (is_ok && !was_ok) {
+					mavlink_log_info(mavlink_fd, "data link %i regained", i);
 
-				if (!telemetry_lost[i]) {
+				} else if (!is_ok && was_ok) {
 					mavlink_log_info(mavlink_fd, "data link %i lost", i);
-					telemetry_lost[i] = true;
 				}
 			}
-		}
 
-		if (have_link) {
-			/* handle the case where data link was regained */
-			if (status.data_link_lost) {
-				status.data_link_lost = false;
-				status_changed = true;
-			}
+			if (!datalink_status.data_link_lost) {
+				/* handle the case where data link was regained */
+				if (status.data_link_lost) {
+					status.data_link_lost = false;
+					status_changed = true;
+				}
 
-		} else {
-			if (!status.data_link_lost) {
-				mavlink_log_info(mavlink_fd, "ALL DATA LINKS LOST");
-				status.data_link_lost = true;
-				status.data_link_lost_counter++;
-				status_changed = true;
+			} else {
+				if (!status.data_link_lost) {
+					mavlink_log_info(mavlink_fd, "ALL DATA LINKS LOST");
+					status.data_link_lost = true;
+					status.data_link_lost_counter++;
+					status_changed = true;
+				}
 			}
 		}
 
@@ -1902,7 +2010,7 @@ int commander_thread_main(int argc, char *argv[])
 
 
 		/* handle commands last, as the system needs to be updated to handle them */
-		orb_check(cmd_sub, &updated);
+		updated = sub_updated[SUB_CMD];
 
 		if (updated) {
 			/* got command */
@@ -1935,7 +2043,10 @@ int commander_thread_main(int argc, char *argv[])
 					flight_termination_printed = true;
 				}
 
-				if (counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
+				static hrt_abstime last_dl_msg_time = 0;
+
+				if (hrt_elapsed_time(&last_dl_msg_time) > 1000000) {
+					last_dl_msg_time = hrt_absolute_time();
 					mavlink_log_critical(mavlink_fd, "DL and GPS lost: flight termination");
 				}
 			}
@@ -1958,7 +2069,10 @@ int commander_thread_main(int argc, char *argv[])
 					flight_termination_printed = true;
 				}
 
-				if (counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
+				static hrt_abstime last_rcgps_msg_time = 0;
+
+				if (hrt_elapsed_time(&last_rcgps_msg_time) > 1000000) {
+					last_rcgps_msg_time = hrt_absolute_time();
 					mavlink_log_critical(mavlink_fd, "RC and GPS lost: flight termination");
 				}
 			}
@@ -2019,7 +2133,8 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* publish states (armed, control mode, vehicle status) at least with 5 Hz */
-		if (counter % (200000 / COMMANDER_MONITORING_INTERVAL) == 0 || status_changed) {
+		if (hrt_elapsed_time(&last_publish_time) > 200000 || status_changed) {
+			last_publish_time = now;
 			set_control_mode();
 			control_mode.timestamp = now;
 			orb_publish(ORB_ID(vehicle_control_mode), control_mode_pub, &control_mode);
@@ -2062,7 +2177,6 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		fflush(stdout);
-		counter++;
 
 		int blink_state = blink_msg_state();
 
@@ -2073,16 +2187,20 @@ int commander_thread_main(int argc, char *argv[])
 				control_status_leds(&status, &armed, true);
 			}
 
-		} else {
-			/* normal state */
+		} else if (load_gov.shed_level < LOAD_SHED_UI || status_changed) {
+			/* normal state; when the load governor sheds UI work,
+			 * skip the periodic refresh but keep state changes */
 			control_status_leds(&status, &armed, status_changed);
 		}
 
 		status_changed = false;
 
-		usleep(COMMANDER_MONITORING_INTERVAL);
+		/* sleep until a manual control or command event arrives, at most one monitoring interval */
+		poll(&fds[0], (sizeof(fds) / sizeof(fds[0])), COMMANDER_MONITORING_INTERVAL / 1000);
 	}
 
+	watchdog_unregister(&wdog);
+
 	/* wait for threads to complete */
 	ret = pthread_join(commander_low_prio_thread, NULL);
 
@@ -2096,6 +2214,7 @@ int commander_thread_main(int argc, char *argv[])
 	led_deinit();
 	buzzer_deinit();
 	close(sp_man_sub);
+	close(load_gov_sub);
 	close(offboard_control_mode_sub);
 	close(local_position_sub);
 	close(global_position_sub);
@@ -2578,8 +2697,6 @@ void *commander_low_prio_loop(void *arg)
 	struct vehicle_command_s cmd;
 	memset(&cmd, 0, sizeof(cmd));
 
-	/* timeout for param autosave */
-	hrt_abstime need_param_autosave_timeout = 0;
 
 	/* wakeup source(s) */
 	struct pollfd fds[1];
@@ -2596,21 +2713,9 @@ void *commander_low_prio_loop(void *arg)
 		if (pret == 0) {
 			/* trigger a param autosave if required */
 			if (need_param_autosave) {
-				if (need_param_autosave_timeout > 0 && hrt_elapsed_time(&need_param_autosave_timeout) > 200000ULL) {
-					int ret = param_save_default();
-
-					if (ret == OK) {
-						mavlink_and_console_log_info(mavlink_fd, "settings autosaved");
-
-					} else {
-						mavlink_and_console_log_critical(mavlink_fd, "settings save error");
-					}
-
-					need_param_autosave = false;
-					need_param_autosave_timeout = 0;
-				} else {
-					need_param_autosave_timeout = hrt_absolute_time();
-				}
+				/* the export runs deferred on the work queue and coalesces bursts */
+				param_autosave();
+				need_param_autosave = false;
 			}
 		} else if (pret < 0) {
 		/* this is undesirable but not much we can do - might want to flag unhappy status */
@@ -2738,6 +2843,9 @@ void *commander_low_prio_loop(void *arg)
 						checkAirspeed = true;
 					}
 
+					/* re-run the full check with the new calibration, which also
+					 * warms the static-check cache on this low priority thread */
+					Commander::preflightCheckInvalidate();
 					status.condition_system_sensors_initialized = Commander::preflightCheck(mavlink_fd, true, true, true, true, checkAirspeed, true);
 
 					arming_state_transition(&status, &safety, vehicle_status_s::ARMING_STATE_STANDBY, &armed, true /* fRunPreArmChecks */, mavlink_fd);
@@ -2755,6 +2863,7 @@ void *commander_low_prio_loop(void *arg)
 				}
 
 				// Update preflight check status
+				Commander::preflightCheckInvalidate();
 				status.condition_system_sensors_initialized = Commander::preflightCheck(mavlink_fd, true, true, true, true, checkAirspeed, true);
 
 				arming_state_transition(&status, &safety, vehicle_status_s::ARMING_STATE_STANDBY, &armed, true /* fRunPreArmChecks */, mavlink_fd);
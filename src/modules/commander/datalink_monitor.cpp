@@ -0,0 +1,234 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file datalink_monitor.cpp
+ *
+ * Timer-armed telemetry link watchdog.
+ *
+ * Loss detection does not poll: an hrt call is kept armed at the earliest
+ * heartbeat deadline and marks expired links lost from the timer callback,
+ * publishing datalink_status right there (publishing from hrt context is
+ * the same pattern the sensor drivers use). Regains are evaluated when a
+ * fresh heartbeat is fed in, since a link can only be declared healthy
+ * while heartbeats are actually arriving.
+ */
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <nuttx/irq.h>
+
+#include <drivers/drv_hrt.h>
+#include <uORB/uORB.h>
+#include <uORB/topics/datalink_status.h>
+#include <uORB/topics/telemetry_status.h>
+
+#include "datalink_monitor.h"
+
+/* per-link supervision state, guarded by irqsave against the hrt callback */
+struct monitor_link_s {
+	uint64_t	heartbeat_time;	/**< last heartbeat timestamp fed in, 0 = never seen */
+	uint64_t	regain_start;	/**< first healthy heartbeat after a loss, 0 = none */
+	bool		lost;		/**< link currently considered lost */
+};
+
+static struct monitor_link_s	monitor_links[TELEMETRY_STATUS_ORB_ID_NUM];
+
+static uint64_t			monitor_loss_timeout_us = 10 * 1000000ULL;
+static uint64_t			monitor_regain_timeout_us = 0;
+
+static struct hrt_call		monitor_call;
+static orb_advert_t		monitor_pub = -1;
+
+static void	monitor_publish(uint64_t now);
+static void	monitor_rearm(void);
+static void	monitor_deadline(void *arg);
+
+/**
+ * Publish the current aggregate link state.
+ */
+static void
+monitor_publish(uint64_t now)
+{
+	struct datalink_status_s link_status;
+	memset(&link_status, 0, sizeof(link_status));
+
+	link_status.timestamp = now;
+	link_status.data_link_lost = true;
+
+	for (int i = 0; i < TELEMETRY_STATUS_ORB_ID_NUM; i++) {
+		if (monitor_links[i].heartbeat_time != 0 && !monitor_links[i].lost) {
+			link_status.link_ok_mask |= (1 << i);
+			link_status.data_link_lost = false;
+		}
+	}
+
+	if (monitor_pub > 0) {
+		orb_publish(ORB_ID(datalink_status), monitor_pub, &link_status);
+	}
+}
+
+/**
+ * Re-arm the hrt call at the earliest link deadline.
+ *
+ * Links that are already lost and not in a regain window have no
+ * deadline; if no link needs supervision the call stays cancelled
+ * until the next heartbeat arrives.
+ */
+static void
+monitor_rearm(void)
+{
+	uint64_t earliest = 0;
+
+	for (int i = 0; i < TELEMETRY_STATUS_ORB_ID_NUM; i++) {
+		if (monitor_links[i].heartbeat_time == 0) {
+			continue;
+		}
+
+		if (monitor_links[i].lost && monitor_links[i].regain_start == 0) {
+			continue;
+		}
+
+		uint64_t deadline = monitor_links[i].heartbeat_time + monitor_loss_timeout_us;
+
+		if (earliest == 0 || deadline < earliest) {
+			earliest = deadline;
+		}
+	}
+
+	if (earliest != 0) {
+		hrt_call_at(&monitor_call, earliest, &monitor_deadline, NULL);
+
+	} else {
+		hrt_cancel(&monitor_call);
+	}
+}
+
+/**
+ * hrt callback: declare all expired links lost, exactly at timeout expiry.
+ */
+static void
+monitor_deadline(void *arg)
+{
+	uint64_t now = hrt_absolute_time();
+	bool changed = false;
+
+	for (int i = 0; i < TELEMETRY_STATUS_ORB_ID_NUM; i++) {
+		if (monitor_links[i].heartbeat_time == 0) {
+			continue;
+		}
+
+		if (now - monitor_links[i].heartbeat_time >= monitor_loss_timeout_us) {
+			if (!monitor_links[i].lost) {
+				monitor_links[i].lost = true;
+				changed = true;
+			}
+
+			/* a regain in progress is void once the heartbeats stop again */
+			monitor_links[i].regain_start = 0;
+		}
+	}
+
+	monitor_rearm();
+
+	if (changed) {
+		monitor_publish(now);
+	}
+}
+
+void
+datalink_monitor_init(void)
+{
+	struct datalink_status_s link_status;
+	memset(&link_status, 0, sizeof(link_status));
+
+	memset(monitor_links, 0, sizeof(monitor_links));
+
+	for (int i = 0; i < TELEMETRY_STATUS_ORB_ID_NUM; i++) {
+		monitor_links[i].lost = true;
+	}
+
+	link_status.timestamp = hrt_absolute_time();
+	link_status.data_link_lost = true;
+
+	monitor_pub = orb_advertise(ORB_ID(datalink_status), &link_status);
+}
+
+void
+datalink_monitor_set_timeouts(int32_t loss_timeout_s, int32_t regain_timeout_s)
+{
+	irqstate_t flags = irqsave();
+	monitor_loss_timeout_us = (uint64_t)loss_timeout_s * 1000000ULL;
+	monitor_regain_timeout_us = (uint64_t)regain_timeout_s * 1000000ULL;
+	monitor_rearm();
+	irqrestore(flags);
+}
+
+void
+datalink_monitor_heartbeat(unsigned link, uint64_t heartbeat_time)
+{
+	if (link >= TELEMETRY_STATUS_ORB_ID_NUM) {
+		return;
+	}
+
+	uint64_t now = hrt_absolute_time();
+	bool changed = false;
+
+	irqstate_t flags = irqsave();
+
+	monitor_links[link].heartbeat_time = heartbeat_time;
+
+	if (heartbeat_time != 0 && now - heartbeat_time < monitor_loss_timeout_us) {
+		if (monitor_links[link].lost) {
+			/* accept the link as healthy again only after the
+			 * regain timeout of uninterrupted heartbeats */
+			if (monitor_links[link].regain_start == 0) {
+				monitor_links[link].regain_start = now;
+			}
+
+			if (now - monitor_links[link].regain_start >= monitor_regain_timeout_us) {
+				monitor_links[link].lost = false;
+				monitor_links[link].regain_start = 0;
+				changed = true;
+			}
+		}
+	}
+
+	monitor_rearm();
+	irqrestore(flags);
+
+	if (changed) {
+		monitor_publish(now);
+	}
+}
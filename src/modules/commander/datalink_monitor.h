@@ -0,0 +1,76 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file datalink_monitor.h
+ *
+ * Timer-armed telemetry link watchdog.
+ *
+ * The monitor is fed with heartbeat timestamps as telemetry_status updates
+ * arrive and keeps an hrt call armed at the earliest link deadline, so a
+ * link is declared lost exactly when its timeout expires instead of on the
+ * next iteration of a polling loop. State changes are published on the
+ * datalink_status topic.
+ */
+
+#ifndef DATALINK_MONITOR_H_
+#define DATALINK_MONITOR_H_
+
+#include <stdint.h>
+
+__BEGIN_DECLS
+
+/**
+ * Initialize the monitor and advertise the datalink_status topic.
+ *
+ * All links start out lost; must be called from task context before
+ * the first heartbeat is fed in.
+ */
+void	datalink_monitor_init(void);
+
+/**
+ * Update the loss/regain timeouts (in seconds, as the COM_DL_LOSS_T
+ * and COM_DL_REG_T parameters are stored).
+ */
+void	datalink_monitor_set_timeouts(int32_t loss_timeout_s, int32_t regain_timeout_s);
+
+/**
+ * Feed the heartbeat timestamp of one telemetry link.
+ *
+ * Call whenever the corresponding telemetry_status topic updates.
+ */
+void	datalink_monitor_heartbeat(unsigned link, uint64_t heartbeat_time);
+
+__END_DECLS
+
+#endif /* DATALINK_MONITOR_H_ */
@@ -55,6 +55,7 @@
 #include <systemlib/systemlib.h>
 #include <systemlib/param/param.h>
 #include <systemlib/err.h>
+#include <systemlib/perf_counter.h>
 #include <drivers/drv_hrt.h>
 #include <drivers/drv_accel.h>
 #include <drivers/drv_device.h>
@@ -86,6 +87,50 @@ static const bool arming_transitions[vehicle_status_s::ARMING_STATE_MAX][vehicle
 	{ /* vehicle_status_s::ARMING_STATE_IN_AIR_RESTORE */ false, false,   false, false,       false,         false,  false }, // NYI
 };
 
+// Condition bits used by the main state requirement table below. The current
+// vehicle conditions are gathered into one word and checked against the table.
+enum {
+	COND_LOCAL_ALTITUDE_VALID	= (1 << 0),
+	COND_LOCAL_POSITION_VALID	= (1 << 1),
+	COND_GLOBAL_POSITION_VALID	= (1 << 2),
+	COND_HOME_POSITION_VALID	= (1 << 3),
+	COND_OFFBOARD_SIGNAL		= (1 << 4),
+};
+
+// This array defines the conditions each main state requires, indexed by the
+// new state. A state is reachable when all bits of require_all are set and,
+// if require_any is non-zero, at least one of its bits is set. Requirement
+// sets marked rotary_wing_only always pass on other airframes.
+struct main_state_requirement_s {
+	uint8_t require_all;
+	uint8_t require_any;
+	bool rotary_wing_only;
+};
+
+static const struct main_state_requirement_s main_state_requirements[vehicle_status_s::MAIN_STATE_MAX] = {
+	{ /* vehicle_status_s::MAIN_STATE_MANUAL */       0, 0, false },
+	/* need at minimum altitude estimate */
+	/* TODO: add this for fixedwing as well */
+	{ /* vehicle_status_s::MAIN_STATE_ALTCTL */       0, COND_LOCAL_ALTITUDE_VALID | COND_GLOBAL_POSITION_VALID, true },
+	/* need at minimum local position estimate */
+	{ /* vehicle_status_s::MAIN_STATE_POSCTL */       0, COND_LOCAL_POSITION_VALID | COND_GLOBAL_POSITION_VALID, false },
+	/* need global position and home position */
+	{ /* vehicle_status_s::MAIN_STATE_AUTO_MISSION */ COND_GLOBAL_POSITION_VALID | COND_HOME_POSITION_VALID, 0, false },
+	/* need global position estimate */
+	{ /* vehicle_status_s::MAIN_STATE_AUTO_LOITER */  COND_GLOBAL_POSITION_VALID, 0, false },
+	/* need global position and home position */
+	{ /* vehicle_status_s::MAIN_STATE_AUTO_RTL */     COND_GLOBAL_POSITION_VALID | COND_HOME_POSITION_VALID, 0, false },
+	{ /* vehicle_status_s::MAIN_STATE_ACRO */         0, 0, false },
+	/* need offboard signal */
+	{ /* vehicle_status_s::MAIN_STATE_OFFBOARD */     COND_OFFBOARD_SIGNAL, 0, false },
+};
+
+/* transition counters, allocated on first use */
+static perf_counter_t arming_transition_perf = nullptr;	/**< latency of arming transition attempts, including pre-arm checks */
+static perf_counter_t arming_denied_perf = nullptr;	/**< denied arming transitions */
+static perf_counter_t main_transition_perf = nullptr;	/**< accepted main state transitions */
+static perf_counter_t nav_transition_perf = nullptr;	/**< navigation state changes, including failsafe entries */
+
 // You can index into the array with an arming_state_t in order to get it's textual representation
 static const char * const state_names[vehicle_status_s::ARMING_STATE_MAX] = {
 	"ARMING_STATE_INIT",
@@ -109,6 +154,11 @@ arming_state_transition(struct vehicle_status_s *status,		///< current vehicle s
 	ASSERT(vehicle_status_s::ARMING_STATE_INIT == 0);
 	ASSERT(vehicle_status_s::ARMING_STATE_IN_AIR_RESTORE == vehicle_status_s::ARMING_STATE_MAX - 1);
 
+	if (arming_transition_perf == nullptr) {
+		arming_transition_perf = perf_alloc(PC_ELAPSED, "arming transition");
+		arming_denied_perf = perf_alloc(PC_COUNT, "arming transition denied");
+	}
+
 	transition_result_t ret = TRANSITION_DENIED;
 	arming_state_t current_arming_state = status->arming_state;
 	bool feedback_provided = false;
@@ -118,6 +168,8 @@ arming_state_transition(struct vehicle_status_s *status,		///< current vehicle s
 		ret = TRANSITION_NOT_CHANGED;
 
 	} else {
+		/* time the full transition, including the pre-arm checks */
+		perf_begin(arming_transition_perf);
 
 		/*
 		 * Get sensing state if necessary
@@ -238,9 +290,12 @@ arming_state_transition(struct vehicle_status_s *status,		///< current vehicle s
 
 		/* end of atomic state update */
 		irqrestore(flags);
+
+		perf_end(arming_transition_perf);
 	}
 
 	if (ret == TRANSITION_DENIED) {
+		perf_count(arming_denied_perf);
 		const char * str = "INVAL: %s - %s";
 		/* only print to console here by default as this is too technical to be useful during operation */
 		warnx(str, state_names[status->arming_state], state_names[new_arming_state]);
@@ -274,60 +329,54 @@ main_state_transition(struct vehicle_status_s *status, main_state_t new_main_sta
 	transition_result_t ret = TRANSITION_DENIED;
 
 	/* transition may be denied even if the same state is requested because conditions may have changed */
-	switch (new_main_state) {
-	case vehicle_status_s::MAIN_STATE_MANUAL:
-	case vehicle_status_s::MAIN_STATE_ACRO:
-		ret = TRANSITION_CHANGED;
-		break;
+	if (new_main_state < vehicle_status_s::MAIN_STATE_MAX) {
 
-	case vehicle_status_s::MAIN_STATE_ALTCTL:
-		/* need at minimum altitude estimate */
-		/* TODO: add this for fixedwing as well */
-		if (!status->is_rotary_wing ||
-		    (status->condition_local_altitude_valid ||
-		     status->condition_global_position_valid)) {
-			ret = TRANSITION_CHANGED;
+		/* gather the current conditions into one word */
+		uint8_t conditions = 0;
+
+		if (status->condition_local_altitude_valid) {
+			conditions |= COND_LOCAL_ALTITUDE_VALID;
 		}
-		break;
 
-	case vehicle_status_s::MAIN_STATE_POSCTL:
-		/* need at minimum local position estimate */
-		if (status->condition_local_position_valid ||
-		    status->condition_global_position_valid) {
-			ret = TRANSITION_CHANGED;
+		if (status->condition_local_position_valid) {
+			conditions |= COND_LOCAL_POSITION_VALID;
 		}
-		break;
 
-	case vehicle_status_s::MAIN_STATE_AUTO_LOITER:
-		/* need global position estimate */
 		if (status->condition_global_position_valid) {
-			ret = TRANSITION_CHANGED;
+			conditions |= COND_GLOBAL_POSITION_VALID;
 		}
-		break;
 
-	case vehicle_status_s::MAIN_STATE_AUTO_MISSION:
-	case vehicle_status_s::MAIN_STATE_AUTO_RTL:
-		/* need global position and home position */
-		if (status->condition_global_position_valid && status->condition_home_position_valid) {
-			ret = TRANSITION_CHANGED;
+		if (status->condition_home_position_valid) {
+			conditions |= COND_HOME_POSITION_VALID;
 		}
-		break;
 
-	case vehicle_status_s::MAIN_STATE_OFFBOARD:
-
-		/* need offboard signal */
 		if (!status->offboard_control_signal_lost) {
-			ret = TRANSITION_CHANGED;
+			conditions |= COND_OFFBOARD_SIGNAL;
 		}
 
-		break;
+		/* look up what the requested state requires */
+		const struct main_state_requirement_s *req = &main_state_requirements[new_main_state];
 
-	case vehicle_status_s::MAIN_STATE_MAX:
-	default:
-		break;
+		bool satisfied = ((conditions & req->require_all) == req->require_all) &&
+				 ((req->require_any == 0) || ((conditions & req->require_any) != 0));
+
+		/* requirements applying to rotary wings only always pass on other airframes */
+		if (req->rotary_wing_only && !status->is_rotary_wing) {
+			satisfied = true;
+		}
+
+		if (satisfied) {
+			ret = TRANSITION_CHANGED;
+		}
 	}
+
 	if (ret == TRANSITION_CHANGED) {
 		if (status->main_state != new_main_state) {
+			if (main_transition_perf == nullptr) {
+				main_transition_perf = perf_alloc(PC_COUNT, "main state transitions");
+			}
+
+			perf_count(main_transition_perf);
 			status->main_state = new_main_state;
 		} else {
 			ret = TRANSITION_NOT_CHANGED;
@@ -451,6 +500,29 @@ transition_result_t hil_state_transition(hil_state_t new_state, int status_pub,
 	return ret;
 }
 
+/**
+ * Pick the best failsafe state the current position estimates support.
+ *
+ * Falls back from the given recovery state (which requires global and home
+ * position, pass NAVIGATION_STATE_MAX for none) to LAND, DESCEND and finally
+ * TERMINATION.
+ */
+static navigation_state_t failsafe_nav_state(const struct vehicle_status_s *status, navigation_state_t recovery_nav_state)
+{
+	if (recovery_nav_state != vehicle_status_s::NAVIGATION_STATE_MAX &&
+	    status->condition_global_position_valid && status->condition_home_position_valid) {
+		return recovery_nav_state;
+
+	} else if (status->condition_local_position_valid) {
+		return vehicle_status_s::NAVIGATION_STATE_LAND;
+
+	} else if (status->condition_local_altitude_valid) {
+		return vehicle_status_s::NAVIGATION_STATE_DESCEND;
+	}
+
+	return vehicle_status_s::NAVIGATION_STATE_TERMINATION;
+}
+
 /**
  * Check failsafe and main status and set navigation status for navigator accordingly
  */
@@ -472,15 +544,7 @@ bool set_nav_state(struct vehicle_status_s *status, const bool data_link_loss_en
 		if ((status->rc_signal_lost || status->rc_signal_lost_cmd) && armed) {
 			status->failsafe = true;
 
-			if (status->condition_global_position_valid && status->condition_home_position_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER;
-			} else if (status->condition_local_position_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_LAND;
-			} else if (status->condition_local_altitude_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_DESCEND;
-			} else {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_TERMINATION;
-			}
+			status->nav_state = failsafe_nav_state(status, vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
 
 		} else {
 			switch (status->main_state) {
@@ -535,15 +599,7 @@ bool set_nav_state(struct vehicle_status_s *status, const bool data_link_loss_en
 		} else if (data_link_loss_enabled && status->data_link_lost) {
 			status->failsafe = true;
 
-			if (status->condition_global_position_valid && status->condition_home_position_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS;
-			} else if (status->condition_local_position_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_LAND;
-			} else if (status->condition_local_altitude_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_DESCEND;
-			} else {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_TERMINATION;
-			}
+			status->nav_state = failsafe_nav_state(status, vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS);
 
 		/* datalink loss disabled:
 		 * check if both, RC and datalink are lost during the mission
@@ -552,15 +608,7 @@ bool set_nav_state(struct vehicle_status_s *status, const bool data_link_loss_en
 						       (status->rc_signal_lost && mission_finished))) {
 			status->failsafe = true;
 
-			if (status->condition_global_position_valid && status->condition_home_position_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER;
-			} else if (status->condition_local_position_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_LAND;
-			} else if (status->condition_local_altitude_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_DESCEND;
-			} else {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_TERMINATION;
-			}
+			status->nav_state = failsafe_nav_state(status, vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
 
 		/* stay where you are if you should stay in failsafe, otherwise everything is perfect */
 		} else if (!stay_in_failsafe){
@@ -576,29 +624,13 @@ bool set_nav_state(struct vehicle_status_s *status, const bool data_link_loss_en
 		} else if (status->data_link_lost && data_link_loss_enabled) {
 			status->failsafe = true;
 
-			if (status->condition_global_position_valid && status->condition_home_position_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS;
-			} else if (status->condition_local_position_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_LAND;
-			} else if (status->condition_local_altitude_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_DESCEND;
-			} else {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_TERMINATION;
-			}
+			status->nav_state = failsafe_nav_state(status, vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS);
 
 		/* go into failsafe if RC is lost and datalink loss is not set up */
 		} else if (status->rc_signal_lost && !data_link_loss_enabled) {
 			status->failsafe = true;
 
-			if (status->condition_global_position_valid && status->condition_home_position_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS;
-			} else if (status->condition_local_position_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_LAND;
-			} else if (status->condition_local_altitude_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_DESCEND;
-			} else {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_TERMINATION;
-			}
+			status->nav_state = failsafe_nav_state(status, vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS);
 
 		/* don't bother if RC is lost if datalink is connected */
 		} else if (status->rc_signal_lost) {
@@ -620,13 +652,7 @@ bool set_nav_state(struct vehicle_status_s *status, const bool data_link_loss_en
 					!status->condition_home_position_valid)) {
 			status->failsafe = true;
 
-			if (status->condition_local_position_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_LAND;
-			} else if (status->condition_local_altitude_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_DESCEND;
-			} else {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_TERMINATION;
-			}
+			status->nav_state = failsafe_nav_state(status, vehicle_status_s::NAVIGATION_STATE_MAX);
 		} else {
 			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_RTL;
 		}
@@ -641,13 +667,7 @@ bool set_nav_state(struct vehicle_status_s *status, const bool data_link_loss_en
 		} else if (status->offboard_control_signal_lost && status->rc_signal_lost) {
 			status->failsafe = true;
 
-			if (status->condition_local_position_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_LAND;
-			} else if (status->condition_local_altitude_valid) {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_DESCEND;
-			} else {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_TERMINATION;
-			}
+			status->nav_state = failsafe_nav_state(status, vehicle_status_s::NAVIGATION_STATE_MAX);
 		} else {
 			status->nav_state = vehicle_status_s::NAVIGATION_STATE_OFFBOARD;
 		}
@@ -655,7 +675,16 @@ bool set_nav_state(struct vehicle_status_s *status, const bool data_link_loss_en
 		break;
 	}
 
-	return status->nav_state != nav_state_old;
+	if (status->nav_state != nav_state_old) {
+		if (nav_transition_perf == nullptr) {
+			nav_transition_perf = perf_alloc(PC_COUNT, "nav state transitions");
+		}
+
+		perf_count(nav_transition_perf);
+		return true;
+	}
+
+	return false;
 }
 
 int prearm_check(const struct vehicle_status_s *status, const int mavlink_fd)
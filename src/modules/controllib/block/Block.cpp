@@ -40,6 +40,7 @@
 #include <math.h>
 #include <string.h>
 #include <stdio.h>
+#include <sched.h>
 
 #include <uORB/Subscription.hpp>
 #include <uORB/Publication.hpp>
@@ -122,6 +123,10 @@ void Block::updatePublications()
 	uORB::PublicationNode *pub = getPublications().getHead();
 	int count = 0;
 
+	/* commit the whole burst under one scheduler lock so subscribers
+	 * polling several of the topics are woken once, not per topic */
+	sched_lock();
+
 	while (pub != NULL) {
 		if (count++ > maxPublicationsPerBlock) {
 			char name[blockNameLengthMax];
@@ -133,6 +138,8 @@ void Block::updatePublications()
 		pub->update();
 		pub = pub->getSibling();
 	}
+
+	sched_unlock();
 }
 
 void SuperBlock::setDt(float dt)
@@ -0,0 +1,125 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file BlockArena.hpp
+ *
+ * Arena allocator for block graphs.
+ *
+ * A block graph that is constructed into an arena is contiguous in RAM
+ * and neither lives on the task stack nor fragments the heap of a
+ * long-running vehicle. The arena hands out storage with a simple bump
+ * pointer; individual objects are never freed, the whole arena is reset
+ * at once after the objects have been destroyed.
+ *
+ * Typical use with placement new:
+ *
+ *   static control::StaticBlockArena<sizeof(MyAutopilot)> arena;
+ *   void *mem = arena.alloc(sizeof(MyAutopilot));
+ *   MyAutopilot *autopilot = new (mem) MyAutopilot(NULL, "MYA");
+ *   ...
+ *   autopilot->~MyAutopilot();
+ *   arena.reset();
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace control
+{
+
+/**
+ * Bump allocator over caller supplied storage.
+ */
+class __EXPORT BlockArena
+{
+public:
+	BlockArena(void *base, size_t size) :
+		_base((uint8_t *)base),
+		_size(size),
+		_offset(0) {
+	}
+
+	/**
+	 * Allocate size bytes from the arena.
+	 *
+	 * Allocations are aligned for any block object. Returns NULL and
+	 * prints a message when the arena is exhausted - callers must
+	 * check the result before constructing into it.
+	 */
+	void *alloc(size_t size);
+
+	/**
+	 * Release all allocations at once.
+	 *
+	 * The caller is responsible for destroying any objects constructed
+	 * in the arena before resetting it.
+	 */
+	void reset() { _offset = 0; }
+
+// accessors
+	size_t getSize() { return _size; }
+	size_t getUsed() { return _offset; }
+
+private:
+	static const size_t _alignment = 8;
+
+// attributes
+	uint8_t *_base;
+	size_t _size;
+	size_t _offset;
+
+	/* this class has pointer data members and should not be copied (private constructor) */
+	BlockArena(const BlockArena &);
+	BlockArena operator=(const BlockArena &);
+};
+
+/**
+ * Arena with built-in storage, sized at compile time per module.
+ */
+template <size_t Size>
+class StaticBlockArena : public BlockArena
+{
+public:
+	StaticBlockArena() :
+		BlockArena(_storage, Size) {
+	}
+
+private:
+// attributes
+	uint8_t _storage[Size] __attribute__((aligned(8)));
+};
+
+} // namespace control
@@ -36,6 +36,7 @@
 #
 SRCS		 = test_params.c \
 		   block/Block.cpp \
+		   block/BlockArena.cpp \
 		   block/BlockParam.cpp \
 		   uorb/blocks.cpp \
 		   blocks.cpp
@@ -43,11 +43,13 @@
 #include <nuttx/config.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <fcntl.h>
 #include <systemlib/systemlib.h>
 #include <systemlib/err.h>
 #include <queue.h>
 #include <string.h>
+#include <time.h>
 
 #include "dataman.h"
 #include <systemlib/param/param.h>
@@ -65,6 +67,8 @@ __EXPORT int dm_clear(dm_item_t item);
 __EXPORT void dm_lock(dm_item_t item);
 __EXPORT void dm_unlock(dm_item_t item);
 __EXPORT int dm_restart(dm_reset_reason restart_type);
+__EXPORT int dm_transaction_begin(void);
+__EXPORT int dm_transaction_commit(void);
 
 /** Types of function calls supported by the worker task */
 typedef enum {
@@ -72,6 +76,8 @@ typedef enum {
 	dm_read_func,
 	dm_clear_func,
 	dm_restart_func,
+	dm_txn_begin_func,
+	dm_txn_commit_func,
 	dm_number_of_funcs
 } dm_function_t;
 
@@ -123,6 +129,13 @@ static const unsigned g_per_item_max_index[DM_KEY_NUM_KEYS] = {
 /* Table of offset for index 0 of each item type */
 static unsigned int g_key_offsets[DM_KEY_NUM_KEYS];
 
+/* Per-item change counters (see dm_generation), indexed by the item
+ * ordinal: type base + index. Allocated once at task start; wrap-around
+ * of the 16-bit counters is harmless as consumers only compare for
+ * equality. */
+static uint16_t *g_generations;
+static unsigned g_generation_bases[DM_KEY_NUM_KEYS];
+
 /* Item type lock mutexes */
 static sem_t *g_item_locks[DM_KEY_NUM_KEYS];
 static sem_t g_sys_state_mutex;
@@ -151,6 +164,40 @@ static bool g_task_should_exit;	/**< if true, dataman task should exit */
 #define DM_SECTOR_HDR_SIZE 4	/* data manager per item header overhead */
 static const unsigned k_sector_size = DM_MAX_DATA_SIZE + DM_SECTOR_HDR_SIZE; /* total item sorage space */
 
+/* In-RAM write-back cache over the item store. All accesses happen on the
+ * worker thread, so the work queue already serializes them and no extra
+ * locking is needed. Writes land in the cache and are flushed to the file
+ * once the worker has been idle for the grace period, so bulk mission
+ * uploads batch their physical writes and repeated navigator reads of the
+ * same items never touch the SD card. */
+#ifndef DM_CACHE_ENTRIES
+#define DM_CACHE_ENTRIES 16
+#endif
+
+/* Microseconds of idle time before dirty cache entries are written out */
+#define DM_CACHE_FLUSH_DELAY_US 500000
+
+typedef struct {
+	bool valid;
+	bool dirty;			/* newer than the copy in the file */
+	unsigned char item;
+	unsigned char index;
+	unsigned char persistence;
+	unsigned char len;
+	unsigned lastuse;		/* LRU stamp */
+	unsigned char data[DM_MAX_DATA_SIZE];
+} dm_cache_entry_t;
+
+static dm_cache_entry_t g_cache[DM_CACHE_ENTRIES];
+static unsigned g_cache_use_counter;
+static unsigned g_cache_dirty_count;
+static unsigned g_cache_hits, g_cache_misses, g_cache_flushes;
+
+/* Open transaction count; while positive the idle flush is suppressed and
+ * dirty entries only reach physical media at commit time. Only touched on
+ * the worker thread. */
+static int g_txn_count;
+
 static void init_q(work_q_t *q)
 {
 	sq_init(&(q->q));		/* Initialize the NuttX queue structure */
@@ -290,6 +337,14 @@ calculate_offset(dm_item_t item, unsigned char index)
 	return g_key_offsets[item] + (index * k_sector_size);
 }
 
+/* Note a modification of an item in its change counter */
+static void
+generation_bump(dm_item_t item, unsigned char index)
+{
+	if ((g_generations != NULL) && (item < DM_KEY_NUM_KEYS) && (index < g_per_item_max_index[item]))
+		g_generations[g_generation_bases[item] + index]++;
+}
+
 /* Each data item is stored as follows
  *
  * byte 0: Length of user data item
@@ -301,9 +356,9 @@ calculate_offset(dm_item_t item, unsigned char index)
  * The total size must not exceed k_sector_size
  */
 
-/* write to the data manager file */
+/* write one item to the data manager file, without forcing it to media */
 static ssize_t
-_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count)
+_write_disk(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count)
 {
 	unsigned char buffer[k_sector_size];
 	size_t len;
@@ -334,8 +389,7 @@ _write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const v
 
 	/* Seek to the right spot in the data manager file and write the data item */
 	if (lseek(g_task_fd, offset, SEEK_SET) == offset)
-		if ((len = write(g_task_fd, buffer, count)) == count)
-			fsync(g_task_fd); /* Make sure data is written to physical media */
+		len = write(g_task_fd, buffer, count);
 
 	/* Make sure the write succeeded */
 	if (len != count)
@@ -345,7 +399,152 @@ _write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const v
 	return count - DM_SECTOR_HDR_SIZE;
 }
 
-/* Retrieve from the data manager file */
+/* Locate the cache entry for an item, if present */
+static dm_cache_entry_t *
+cache_find(dm_item_t item, unsigned char index)
+{
+	for (unsigned i = 0; i < DM_CACHE_ENTRIES; i++) {
+		dm_cache_entry_t *entry = &g_cache[i];
+
+		if (entry->valid && entry->item == item && entry->index == index) {
+			entry->lastuse = ++g_cache_use_counter;
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Push a dirty cache entry out to the file */
+static int
+cache_write_out(dm_cache_entry_t *entry)
+{
+	if (_write_disk(entry->item, entry->index, entry->persistence, entry->data, entry->len) < 0)
+		return -1;
+
+	entry->dirty = false;
+	g_cache_dirty_count--;
+	return 0;
+}
+
+/* Write all dirty entries to the file and force it to physical media */
+static void
+cache_flush(void)
+{
+	bool wrote = false;
+
+	for (unsigned i = 0; i < DM_CACHE_ENTRIES; i++) {
+		dm_cache_entry_t *entry = &g_cache[i];
+
+		if (entry->valid && entry->dirty && cache_write_out(entry) == 0)
+			wrote = true;
+	}
+
+	if (wrote) {
+		fsync(g_task_fd);
+		g_cache_flushes++;
+	}
+}
+
+/* Obtain a cache slot for an item, evicting the least recently used
+ * entry if necessary. Returns NULL if a dirty eviction victim could
+ * not be written out. */
+static dm_cache_entry_t *
+cache_get_slot(dm_item_t item, unsigned char index)
+{
+	dm_cache_entry_t *entry = cache_find(item, index);
+
+	if (entry != NULL)
+		return entry;
+
+	/* pick a free slot, or failing that the least recently used one */
+	dm_cache_entry_t *victim = &g_cache[0];
+
+	for (unsigned i = 0; i < DM_CACHE_ENTRIES; i++) {
+		if (!g_cache[i].valid) {
+			victim = &g_cache[i];
+			break;
+		}
+
+		if (g_cache[i].lastuse < victim->lastuse)
+			victim = &g_cache[i];
+	}
+
+	if (victim->valid && victim->dirty && cache_write_out(victim) != 0)
+		return NULL;
+
+	victim->valid = false;
+	victim->dirty = false;
+	victim->lastuse = ++g_cache_use_counter;
+	return victim;
+}
+
+/* Drop all cache entries of one item type, or everything for DM_KEY_NUM_KEYS */
+static void
+cache_invalidate(dm_item_t item)
+{
+	for (unsigned i = 0; i < DM_CACHE_ENTRIES; i++) {
+		dm_cache_entry_t *entry = &g_cache[i];
+
+		if (entry->valid && (item == DM_KEY_NUM_KEYS || entry->item == item)) {
+			if (entry->dirty)
+				g_cache_dirty_count--;
+
+			entry->valid = false;
+			entry->dirty = false;
+		}
+	}
+}
+
+/* write to the data manager store */
+static ssize_t
+_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count)
+{
+	/* If item type or index out of range, return error */
+	if (calculate_offset(item, index) < 0)
+		return -1;
+
+	/* Make sure caller has not given us more data than we can handle */
+	if (count > DM_MAX_DATA_SIZE)
+		return -1;
+
+	dm_cache_entry_t *entry = cache_get_slot(item, index);
+
+	if (entry == NULL) {
+		/* could not make room in the cache, fall back to a direct write */
+		ssize_t ret = _write_disk(item, index, persistence, buf, count);
+
+		if (ret >= 0) {
+			fsync(g_task_fd);
+			generation_bump(item, index);
+		}
+
+		return ret;
+	}
+
+	/* the write lands in the cache and is flushed once the worker goes idle */
+	entry->valid = true;
+
+	if (!entry->dirty) {
+		entry->dirty = true;
+		g_cache_dirty_count++;
+	}
+
+	entry->item = item;
+	entry->index = index;
+	entry->persistence = persistence;
+	entry->len = count;
+
+	if (count > 0) {
+		memcpy(entry->data, buf, count);
+	}
+
+	generation_bump(item, index);
+
+	return count;
+}
+
+/* Retrieve from the data manager store */
 static ssize_t
 _read(dm_item_t item, unsigned char index, void *buf, size_t count)
 {
@@ -363,6 +562,25 @@ _read(dm_item_t item, unsigned char index, void *buf, size_t count)
 	if (count > DM_MAX_DATA_SIZE)
 		return -1;
 
+	/* Serve the read from the cache if the item is resident */
+	dm_cache_entry_t *entry = cache_find(item, index);
+
+	if (entry != NULL) {
+		g_cache_hits++;
+
+		/* We got more than requested!!! */
+		if (entry->len > count)
+			return -1;
+
+		if (entry->len > 0) {
+			memcpy(buf, entry->data, entry->len);
+		}
+
+		return entry->len;
+	}
+
+	g_cache_misses++;
+
 	/* Read the prefix and data */
 	len = -1;
 
@@ -387,6 +605,21 @@ _read(dm_item_t item, unsigned char index, void *buf, size_t count)
 		memcpy(buf, buffer + DM_SECTOR_HDR_SIZE, buffer[0]);
 	}
 
+	/* Keep a clean copy so the next read of this item is RAM-speed */
+	entry = cache_get_slot(item, index);
+
+	if (entry != NULL) {
+		entry->valid = true;
+		entry->item = item;
+		entry->index = index;
+		entry->persistence = buffer[1];
+		entry->len = buffer[0];
+
+		if (buffer[0] > 0) {
+			memcpy(entry->data, buffer + DM_SECTOR_HDR_SIZE, buffer[0]);
+		}
+	}
+
 	/* Return the number of bytes of caller data read */
 	return buffer[0];
 }
@@ -396,6 +629,12 @@ _clear(dm_item_t item)
 {
 	int i, result = 0;
 
+	/* cached copies of this item type are stale now, dirty or not */
+	cache_invalidate(item);
+
+	for (i = 0; (unsigned)i < g_per_item_max_index[item]; i++)
+		generation_bump(item, i);
+
 	/* Get the offset of 1st item of this type */
 	int offset = calculate_offset(item, 0);
 
@@ -446,6 +685,16 @@ _restart(dm_reset_reason reason)
 	unsigned char buffer[2];
 	int offset = 0, result = 0;
 
+	/* settle the cache first, the scan below works on the file alone */
+	cache_flush();
+	cache_invalidate(DM_KEY_NUM_KEYS);
+
+	/* any item may be erased below, invalidate all derived results */
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		for (unsigned k = 0; k < g_per_item_max_index[i]; k++)
+			generation_bump((dm_item_t)i, k);
+	}
+
 	/* We need to scan the entire file and invalidate and data that should not persist after the last reset */
 
 	/* Loop through all of the data segments and delete those that are not persistent */
@@ -603,6 +852,39 @@ dm_unlock(dm_item_t item)
 	}
 }
 
+/* Queue a transaction begin or commit marker for the worker thread */
+static int
+enqueue_txn_item(dm_function_t func)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if ((g_fd < 0) || g_task_should_exit)
+		return -1;
+
+	if ((work = create_work_item()) == NULL)
+		return -1;
+
+	work->func = func;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return enqueue_work_item_and_wait_for_result(work);
+}
+
+/** Open a write transaction */
+__EXPORT int
+dm_transaction_begin(void)
+{
+	return enqueue_txn_item(dm_txn_begin_func);
+}
+
+/** Commit the current write transaction */
+__EXPORT int
+dm_transaction_commit(void)
+{
+	return enqueue_txn_item(dm_txn_commit_func);
+}
+
 /* Tell the data manager about the type of the last reset */
 __EXPORT int
 dm_restart(dm_reset_reason reason)
@@ -624,6 +906,18 @@ dm_restart(dm_reset_reason reason)
 	return enqueue_work_item_and_wait_for_result(work);
 }
 
+/* Report the change counter of an item; reads the counter directly
+ * rather than passing through the work queue, an aligned 16-bit load
+ * is atomic on this architecture */
+__EXPORT unsigned
+dm_generation(dm_item_t item, unsigned char index)
+{
+	if ((g_generations == NULL) || (item >= DM_KEY_NUM_KEYS) || (index >= g_per_item_max_index[item]))
+		return 0;
+
+	return g_generations[g_generation_bases[item] + index];
+}
+
 static int
 task_main(int argc, char *argv[])
 {
@@ -637,6 +931,15 @@ task_main(int argc, char *argv[])
 
 	unsigned max_offset = g_key_offsets[DM_KEY_NUM_KEYS - 1] + (g_per_item_max_index[DM_KEY_NUM_KEYS - 1] * k_sector_size);
 
+	/* set up the per-item change counters */
+	g_generation_bases[0] = 0;
+
+	for (unsigned i = 0; i < (DM_KEY_NUM_KEYS - 1); i++)
+		g_generation_bases[i + 1] = g_generation_bases[i] + g_per_item_max_index[i];
+
+	unsigned total_items = g_generation_bases[DM_KEY_NUM_KEYS - 1] + g_per_item_max_index[DM_KEY_NUM_KEYS - 1];
+	g_generations = calloc(total_items, sizeof(uint16_t));
+
 	for (unsigned i = 0; i < dm_number_of_funcs; i++)
 		g_func_counts[i] = 0;
 
@@ -721,8 +1024,28 @@ task_main(int argc, char *argv[])
 		}
 
 		if (!g_task_should_exit) {
-			/* wait for work */
-			sem_wait(&g_work_queued_sema);
+			if (g_cache_dirty_count > 0 && g_txn_count == 0) {
+				/* wait for work, but wake up in time to flush the write-back cache */
+				struct timespec ts;
+				clock_gettime(CLOCK_REALTIME, &ts);
+				ts.tv_sec += DM_CACHE_FLUSH_DELAY_US / 1000000;
+				ts.tv_nsec += (DM_CACHE_FLUSH_DELAY_US % 1000000) * 1000;
+
+				if (ts.tv_nsec >= 1000000000) {
+					ts.tv_sec++;
+					ts.tv_nsec -= 1000000000;
+				}
+
+				if (sem_timedwait(&g_work_queued_sema, &ts) != 0) {
+					/* no new work arrived within the grace period */
+					cache_flush();
+					continue;
+				}
+
+			} else {
+				/* wait for work */
+				sem_wait(&g_work_queued_sema);
+			}
 		}
 
 		/* Empty the work queue */
@@ -752,6 +1075,23 @@ task_main(int argc, char *argv[])
 				work->result = _restart(work->restart_params.reason);
 				break;
 
+			case dm_txn_begin_func:
+				g_func_counts[dm_txn_begin_func]++;
+				g_txn_count++;
+				work->result = 0;
+				break;
+
+			case dm_txn_commit_func:
+				g_func_counts[dm_txn_commit_func]++;
+
+				if (g_txn_count > 0 && --g_txn_count == 0) {
+					/* outermost commit, force everything to media */
+					cache_flush();
+				}
+
+				work->result = 0;
+				break;
+
 			default: /* should never happen */
 				work->result = -1;
 				break;
@@ -766,6 +1106,9 @@ task_main(int argc, char *argv[])
 			break;
 	}
 
+	/* anything still dirty has to make it to media before we go away */
+	cache_flush();
+
 	close(g_task_fd);
 	g_task_fd = -1;
 
@@ -814,6 +1157,8 @@ status(void)
 	warnx("Clears   %d", g_func_counts[dm_clear_func]);
 	warnx("Restarts %d", g_func_counts[dm_restart_func]);
 	warnx("Max Q lengths work %d, free %d", g_work_q.max_size, g_free_q.max_size);
+	warnx("Cache hits %u, misses %u, flushes %u, dirty %u",
+	      g_cache_hits, g_cache_misses, g_cache_flushes, g_cache_dirty_count);
 }
 
 static void
@@ -129,6 +129,29 @@ extern "C" {
 		dm_reset_reason restart_type	/* The last reset type */
 	);
 
+	/** Open a write transaction; writes are held back from physical
+	 *  media until the matching dm_transaction_commit, so bulk updates
+	 *  like a mission upload cost a handful of SD operations instead
+	 *  of one synchronous write per item. Transactions nest. */
+	__EXPORT int
+	dm_transaction_begin(void);
+
+	/** Commit the current write transaction, forcing all held-back
+	 *  writes to physical media */
+	__EXPORT int
+	dm_transaction_commit(void);
+
+	/** Monotonic change counter of one item. Bumped on every write or
+	 *  clear of the item, so consumers can cache derived results and
+	 *  revalidate only items that actually changed. Returns 0 for
+	 *  invalid items or before the manager has started; counters are
+	 *  not persistent across reboots. */
+	__EXPORT unsigned
+	dm_generation(
+		dm_item_t item,			/* The item type */
+		unsigned char index		/* The index of the item */
+	);
+
 #ifdef __cplusplus
 }
 #endif
@@ -213,6 +213,10 @@ private:
     bool            _newDataMag;
     bool            _newRangeData;
 
+    bool            _baroFusionPending;     ///< baro fusion deferred by the stagger logic
+    bool            _magFusionPending;      ///< mag fusion deferred by the stagger logic
+    bool            _airspeedFusionPending; ///< airspeed fusion deferred by the stagger logic
+
     int             _mavlink_fd;
 
     struct {
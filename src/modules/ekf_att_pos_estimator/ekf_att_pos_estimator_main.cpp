@@ -59,6 +59,7 @@
 #include <systemlib/param/param.h>
 #include <systemlib/err.h>
 #include <systemlib/systemlib.h>
+#include <systemlib/trace.h>
 #include <mathlib/mathlib.h>
 #include <mathlib/math/filter/LowPassFilter2p.hpp>
 #include <mavlink/mavlink_log.h>
@@ -193,6 +194,10 @@ AttitudePositionEstimatorEKF::AttitudePositionEstimatorEKF() :
     _newDataMag(false),
     _newRangeData(false),
 
+    _baroFusionPending(false),
+    _magFusionPending(false),
+    _airspeedFusionPending(false),
+
     _mavlink_fd(-1),
     _parameters {},
     _parameter_handles {},
@@ -692,6 +697,7 @@ void AttitudePositionEstimatorEKF::task_main()
 		}
 
 		perf_end(_loop_perf);
+		TRACE(TRACE_EV_EST_CYCLE, 0);
 	}
 
 	_task_running = false;
@@ -976,7 +982,23 @@ void AttitudePositionEstimatorEKF::updateSensorFusion(const bool fuseGPS, const
 		_ekf->fusePosData = false;
 	}
 
-	if (fuseBaro) {
+	// Note which measurements arrived this cycle; their fusion may be
+	// deferred by the stagger logic below
+	_baroFusionPending = _baroFusionPending || fuseBaro;
+	_magFusionPending = _magFusionPending || fuseMag;
+	_airspeedFusionPending = _airspeedFusionPending || (fuseAirSpeed && _ekf->VtasMeas > 7.0f);
+
+	// Stagger the remaining measurement updates: GPS is fused above in its
+	// own cycle, and of the baro height, mag and airspeed updates at most
+	// one is fused per IMU cycle. Deferred updates run on the immediately
+	// following cycles, adding a few milliseconds to measurements that are
+	// already tens of milliseconds old, but the worst case cycle is now
+	// one FuseVelposNED() plus one further fusion instead of all of them
+	// stacking up and blowing the deadline.
+	bool auxFusionDone = false;
+
+	// Fuse Baro Measurements
+	if (_baroFusionPending && !auxFusionDone) {
 		// Could use a blend of GPS and baro alt data if desired
 		_ekf->hgtMea = _ekf->baroHgt;
 		_ekf->fuseHgtData = true;
@@ -987,12 +1009,15 @@ void AttitudePositionEstimatorEKF::updateSensorFusion(const bool fuseGPS, const
 		// run the fusion step
 		_ekf->FuseVelposNED();
 
+		_baroFusionPending = false;
+		auxFusionDone = true;
+
 	} else {
 		_ekf->fuseHgtData = false;
 	}
 
 	// Fuse Magnetometer Measurements
-	if (fuseMag) {
+	if (_magFusionPending && !auxFusionDone) {
 		_ekf->fuseMagData = true;
 		_ekf->RecallStates(_ekf->statesAtMagMeasTime,
 				   (IMUmsec - _parameters.mag_delay_ms)); // Assume 50 msec avg delay for magnetometer data
@@ -1002,17 +1027,23 @@ void AttitudePositionEstimatorEKF::updateSensorFusion(const bool fuseGPS, const
 		_ekf->FuseMagnetometer();
 		_ekf->FuseMagnetometer();
 
+		_magFusionPending = false;
+		auxFusionDone = true;
+
 	} else {
 		_ekf->fuseMagData = false;
 	}
 
 	// Fuse Airspeed Measurements
-	if (fuseAirSpeed && _ekf->VtasMeas > 7.0f) {
+	if (_airspeedFusionPending && !auxFusionDone) {
 		_ekf->fuseVtasData = true;
 		_ekf->RecallStates(_ekf->statesAtVtasMeasTime,
 				   (IMUmsec - _parameters.tas_delay_ms)); // assume 100 msec avg delay for airspeed data
 		_ekf->FuseAirspeed();
 
+		_airspeedFusionPending = false;
+		auxFusionDone = true;
+
 	} else {
 		_ekf->fuseVtasData = false;
 	}
@@ -1038,7 +1069,7 @@ int AttitudePositionEstimatorEKF::start()
 	_estimator_task = task_spawn_cmd("ekf_att_pos_estimator",
 					 SCHED_DEFAULT,
 					 SCHED_PRIORITY_MAX - 40,
-					 7500,
+					 6000,
 					 (main_t)&AttitudePositionEstimatorEKF::task_main_trampoline,
 					 nullptr);
 
@@ -116,6 +116,7 @@ public:
     // Global variables
     float KH[EKF_STATE_ESTIMATES][EKF_STATE_ESTIMATES]; //  intermediate result used for covariance updates
     float KHP[EKF_STATE_ESTIMATES][EKF_STATE_ESTIMATES]; // intermediate result used for covariance updates
+    float nextP[EKF_STATE_ESTIMATES][EKF_STATE_ESTIMATES]; // predicted covariance, scratch for CovariancePrediction (kept off the task stack)
     float P[EKF_STATE_ESTIMATES][EKF_STATE_ESTIMATES]; // covariance matrix
     float Kfusion[EKF_STATE_ESTIMATES]; // Kalman gains
     float states[EKF_STATE_ESTIMATES]; // state matrix
@@ -49,6 +49,9 @@
 #include <systemlib/err.h>
 #include <drivers/drv_hrt.h>
 #include <math.h>
+#include <new>
+
+#include <controllib/block/BlockArena.hpp>
 
 #include "fixedwing.hpp"
 
@@ -152,16 +155,31 @@ int control_demo_thread_main(int argc, char *argv[])
 
 	using namespace control;
 
-	fixedwing::BlockMultiModeBacksideAutopilot autopilot(NULL, "FWB");
+	/* construct the block graph into a static arena so it is contiguous
+	 * in RAM and neither burdens the task stack nor the heap */
+	static StaticBlockArena<sizeof(fixedwing::BlockMultiModeBacksideAutopilot)> autopilot_arena;
+
+	void *mem = autopilot_arena.alloc(sizeof(fixedwing::BlockMultiModeBacksideAutopilot));
+
+	if (mem == NULL) {
+		warnx("autopilot allocation failed");
+		return 1;
+	}
+
+	fixedwing::BlockMultiModeBacksideAutopilot *autopilot =
+		new (mem) fixedwing::BlockMultiModeBacksideAutopilot(NULL, "FWB");
 
 	thread_running = true;
 
 	while (!thread_should_exit) {
-		autopilot.update();
+		autopilot->update();
 	}
 
 	warnx("exiting.");
 
+	autopilot->~BlockMultiModeBacksideAutopilot();
+	autopilot_arena.reset();
+
 	thread_running = false;
 
 	return 0;
@@ -70,10 +70,13 @@
 #include <uORB/topics/vehicle_global_position.h>
 #include <uORB/topics/vehicle_status.h>
 #include <systemlib/param/param.h>
+#include <systemlib/param/param_cache.h>
 #include <systemlib/err.h>
 #include <systemlib/pid/pid.h>
 #include <geo/geo.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/rate_loop.h>
+#include <systemlib/watchdog.h>
 #include <systemlib/systemlib.h>
 #include <mathlib/mathlib.h>
 
@@ -153,7 +156,8 @@ private:
 	struct vehicle_global_position_s		_global_pos;		/**< global position */
 	struct vehicle_status_s				_vehicle_status;	/**< vehicle status */
 
-	perf_counter_t	_loop_perf;			/**< loop performance counter */
+	struct rate_loop_s	_rate_loop;		/**< loop timing and deadline accounting */
+	struct watchdog_client_s	_wdog;	/**< hardware watchdog supervision */
 	perf_counter_t	_nonfinite_input_perf;		/**< performance counter for non finite input */
 	perf_counter_t	_nonfinite_output_perf;		/**< performance counter for non finite output */
 
@@ -197,51 +201,14 @@ private:
 		float pitchsp_offset_deg;			/**< Pitch Setpoint Offset in deg */
 		float rollsp_offset_rad;			/**< Roll Setpoint Offset in rad */
 		float pitchsp_offset_rad;			/**< Pitch Setpoint Offset in rad */
-		float man_roll_max;						/**< Max Roll in rad */
-		float man_pitch_max;					/**< Max Pitch in rad */
+		float man_roll_max;						/**< Max Roll in deg */
+		float man_pitch_max;					/**< Max Pitch in deg */
+		float man_roll_max_rad;					/**< Max Roll in rad */
+		float man_pitch_max_rad;				/**< Max Pitch in rad */
 
 	}		_parameters;			/**< local copies of interesting parameters */
 
-	struct {
-
-		param_t tconst;
-		param_t p_p;
-		param_t p_d;
-		param_t p_i;
-		param_t p_ff;
-		param_t p_rmax_pos;
-		param_t p_rmax_neg;
-		param_t p_integrator_max;
-		param_t p_roll_feedforward;
-		param_t r_p;
-		param_t r_d;
-		param_t r_i;
-		param_t r_ff;
-		param_t r_integrator_max;
-		param_t r_rmax;
-		param_t y_p;
-		param_t y_i;
-		param_t y_d;
-		param_t y_ff;
-		param_t y_roll_feedforward;
-		param_t y_integrator_max;
-		param_t y_coordinated_min_speed;
-		param_t y_coordinated_method;
-		param_t y_rmax;
-
-		param_t airspeed_min;
-		param_t airspeed_trim;
-		param_t airspeed_max;
-
-		param_t trim_roll;
-		param_t trim_pitch;
-		param_t trim_yaw;
-		param_t rollsp_offset_deg;
-		param_t pitchsp_offset_deg;
-		param_t man_roll_max;
-		param_t man_pitch_max;
-
-	}		_parameter_handles;		/**< handles for interesting parameters */
+	struct param_cache_s	_param_cache;		/**< mapping of interesting parameters */
 
 
 	ECL_RollController				_roll_ctrl;
@@ -346,13 +313,15 @@ FixedwingAttitudeControl::FixedwingAttitudeControl() :
 	_actuators_id(0),
 
 /* performance counters */
-	_loop_perf(perf_alloc(PC_ELAPSED, "fw att control")),
 	_nonfinite_input_perf(perf_alloc(PC_COUNT, "fw att control nonfinite input")),
 	_nonfinite_output_perf(perf_alloc(PC_COUNT, "fw att control nonfinite output")),
 /* states */
 	_setpoint_valid(false),
 	_debug(false)
 {
+	/* attitude loop driven by the estimator at roughly 100 Hz */
+	rate_loop_init(&_rate_loop, "fw att control", 100, 0.0002f, 1.0f);
+
 	/* safely initialize structs */
 	_att = {};
 	_accel = {};
@@ -367,42 +336,44 @@ FixedwingAttitudeControl::FixedwingAttitudeControl() :
 	_vehicle_status = {};
 
 
-	_parameter_handles.tconst = param_find("FW_ATT_TC");
-	_parameter_handles.p_p = param_find("FW_PR_P");
-	_parameter_handles.p_i = param_find("FW_PR_I");
-	_parameter_handles.p_ff = param_find("FW_PR_FF");
-	_parameter_handles.p_rmax_pos = param_find("FW_P_RMAX_POS");
-	_parameter_handles.p_rmax_neg = param_find("FW_P_RMAX_NEG");
-	_parameter_handles.p_integrator_max = param_find("FW_PR_IMAX");
-	_parameter_handles.p_roll_feedforward = param_find("FW_P_ROLLFF");
+	param_cache_init(&_param_cache, 30);
+
+	param_cache_map(&_param_cache, "FW_ATT_TC", &_parameters.tconst);
+	param_cache_map(&_param_cache, "FW_PR_P", &_parameters.p_p);
+	param_cache_map(&_param_cache, "FW_PR_I", &_parameters.p_i);
+	param_cache_map(&_param_cache, "FW_PR_FF", &_parameters.p_ff);
+	param_cache_map(&_param_cache, "FW_P_RMAX_POS", &_parameters.p_rmax_pos);
+	param_cache_map(&_param_cache, "FW_P_RMAX_NEG", &_parameters.p_rmax_neg);
+	param_cache_map(&_param_cache, "FW_PR_IMAX", &_parameters.p_integrator_max);
+	param_cache_map(&_param_cache, "FW_P_ROLLFF", &_parameters.p_roll_feedforward);
 
-	_parameter_handles.r_p = param_find("FW_RR_P");
-	_parameter_handles.r_i = param_find("FW_RR_I");
-	_parameter_handles.r_ff = param_find("FW_RR_FF");
-	_parameter_handles.r_integrator_max = param_find("FW_RR_IMAX");
-	_parameter_handles.r_rmax = param_find("FW_R_RMAX");
+	param_cache_map(&_param_cache, "FW_RR_P", &_parameters.r_p);
+	param_cache_map(&_param_cache, "FW_RR_I", &_parameters.r_i);
+	param_cache_map(&_param_cache, "FW_RR_FF", &_parameters.r_ff);
+	param_cache_map(&_param_cache, "FW_RR_IMAX", &_parameters.r_integrator_max);
+	param_cache_map(&_param_cache, "FW_R_RMAX", &_parameters.r_rmax);
 
-	_parameter_handles.y_p = param_find("FW_YR_P");
-	_parameter_handles.y_i = param_find("FW_YR_I");
-	_parameter_handles.y_ff = param_find("FW_YR_FF");
-	_parameter_handles.y_integrator_max = param_find("FW_YR_IMAX");
-	_parameter_handles.y_rmax = param_find("FW_Y_RMAX");
+	param_cache_map(&_param_cache, "FW_YR_P", &_parameters.y_p);
+	param_cache_map(&_param_cache, "FW_YR_I", &_parameters.y_i);
+	param_cache_map(&_param_cache, "FW_YR_FF", &_parameters.y_ff);
+	param_cache_map(&_param_cache, "FW_YR_IMAX", &_parameters.y_integrator_max);
+	param_cache_map(&_param_cache, "FW_Y_RMAX", &_parameters.y_rmax);
 
-	_parameter_handles.airspeed_min = param_find("FW_AIRSPD_MIN");
-	_parameter_handles.airspeed_trim = param_find("FW_AIRSPD_TRIM");
-	_parameter_handles.airspeed_max = param_find("FW_AIRSPD_MAX");
+	param_cache_map(&_param_cache, "FW_AIRSPD_MIN", &_parameters.airspeed_min);
+	param_cache_map(&_param_cache, "FW_AIRSPD_TRIM", &_parameters.airspeed_trim);
+	param_cache_map(&_param_cache, "FW_AIRSPD_MAX", &_parameters.airspeed_max);
 
-	_parameter_handles.y_coordinated_min_speed = param_find("FW_YCO_VMIN");
-	_parameter_handles.y_coordinated_method = param_find("FW_YCO_METHOD");
+	param_cache_map(&_param_cache, "FW_YCO_VMIN", &_parameters.y_coordinated_min_speed);
+	param_cache_map(&_param_cache, "FW_YCO_METHOD", &_parameters.y_coordinated_method);
 
-	_parameter_handles.trim_roll = param_find("TRIM_ROLL");
-	_parameter_handles.trim_pitch = param_find("TRIM_PITCH");
-	_parameter_handles.trim_yaw = param_find("TRIM_YAW");
-	_parameter_handles.rollsp_offset_deg = param_find("FW_RSP_OFF");
-	_parameter_handles.pitchsp_offset_deg = param_find("FW_PSP_OFF");
+	param_cache_map(&_param_cache, "TRIM_ROLL", &_parameters.trim_roll);
+	param_cache_map(&_param_cache, "TRIM_PITCH", &_parameters.trim_pitch);
+	param_cache_map(&_param_cache, "TRIM_YAW", &_parameters.trim_yaw);
+	param_cache_map(&_param_cache, "FW_RSP_OFF", &_parameters.rollsp_offset_deg);
+	param_cache_map(&_param_cache, "FW_PSP_OFF", &_parameters.pitchsp_offset_deg);
 
-	_parameter_handles.man_roll_max = param_find("FW_MAN_R_MAX");
-	_parameter_handles.man_pitch_max = param_find("FW_MAN_P_MAX");
+	param_cache_map(&_param_cache, "FW_MAN_R_MAX", &_parameters.man_roll_max);
+	param_cache_map(&_param_cache, "FW_MAN_P_MAX", &_parameters.man_pitch_max);
 
 	/* fetch initial parameter values */
 	parameters_update();
@@ -430,7 +401,9 @@ FixedwingAttitudeControl::~FixedwingAttitudeControl()
 		} while (_control_task != -1);
 	}
 
-	perf_free(_loop_perf);
+	param_cache_free(&_param_cache);
+
+	rate_loop_free(&_rate_loop);
 	perf_free(_nonfinite_input_perf);
 	perf_free(_nonfinite_output_perf);
 
@@ -441,45 +414,15 @@ int
 FixedwingAttitudeControl::parameters_update()
 {
 
-	param_get(_parameter_handles.tconst, &(_parameters.tconst));
-	param_get(_parameter_handles.p_p, &(_parameters.p_p));
-	param_get(_parameter_handles.p_i, &(_parameters.p_i));
-	param_get(_parameter_handles.p_ff, &(_parameters.p_ff));
-	param_get(_parameter_handles.p_rmax_pos, &(_parameters.p_rmax_pos));
-	param_get(_parameter_handles.p_rmax_neg, &(_parameters.p_rmax_neg));
-	param_get(_parameter_handles.p_integrator_max, &(_parameters.p_integrator_max));
-	param_get(_parameter_handles.p_roll_feedforward, &(_parameters.p_roll_feedforward));
-
-	param_get(_parameter_handles.r_p, &(_parameters.r_p));
-	param_get(_parameter_handles.r_i, &(_parameters.r_i));
-	param_get(_parameter_handles.r_ff, &(_parameters.r_ff));
-
-	param_get(_parameter_handles.r_integrator_max, &(_parameters.r_integrator_max));
-	param_get(_parameter_handles.r_rmax, &(_parameters.r_rmax));
-
-	param_get(_parameter_handles.y_p, &(_parameters.y_p));
-	param_get(_parameter_handles.y_i, &(_parameters.y_i));
-	param_get(_parameter_handles.y_ff, &(_parameters.y_ff));
-	param_get(_parameter_handles.y_integrator_max, &(_parameters.y_integrator_max));
-	param_get(_parameter_handles.y_coordinated_min_speed, &(_parameters.y_coordinated_min_speed));
-	param_get(_parameter_handles.y_coordinated_method, &(_parameters.y_coordinated_method));
-	param_get(_parameter_handles.y_rmax, &(_parameters.y_rmax));
-
-	param_get(_parameter_handles.airspeed_min, &(_parameters.airspeed_min));
-	param_get(_parameter_handles.airspeed_trim, &(_parameters.airspeed_trim));
-	param_get(_parameter_handles.airspeed_max, &(_parameters.airspeed_max));
-
-	param_get(_parameter_handles.trim_roll, &(_parameters.trim_roll));
-	param_get(_parameter_handles.trim_pitch, &(_parameters.trim_pitch));
-	param_get(_parameter_handles.trim_yaw, &(_parameters.trim_yaw));
-	param_get(_parameter_handles.rollsp_offset_deg, &(_parameters.rollsp_offset_deg));
-	param_get(_parameter_handles.pitchsp_offset_deg, &(_parameters.pitchsp_offset_deg));
+	/* refresh only the values that changed; skip the controller setup if none did */
+	if (param_cache_update(&_param_cache) == 0) {
+		return OK;
+	}
+
 	_parameters.rollsp_offset_rad = math::radians(_parameters.rollsp_offset_deg);
 	_parameters.pitchsp_offset_rad = math::radians(_parameters.pitchsp_offset_deg);
-	param_get(_parameter_handles.man_roll_max, &(_parameters.man_roll_max));
-	param_get(_parameter_handles.man_pitch_max, &(_parameters.man_pitch_max));
-	_parameters.man_roll_max = math::radians(_parameters.man_roll_max);
-	_parameters.man_pitch_max = math::radians(_parameters.man_pitch_max);
+	_parameters.man_roll_max_rad = math::radians(_parameters.man_roll_max);
+	_parameters.man_pitch_max_rad = math::radians(_parameters.man_pitch_max);
 
 	/* pitch control parameters */
 	_pitch_ctrl.set_time_constant(_parameters.tconst);
@@ -661,14 +604,19 @@ FixedwingAttitudeControl::task_main()
 	fds[1].fd = _att_sub;
 	fds[1].events = POLLIN;
 
+	/* check in with the hardware watchdog once per cycle */
+	watchdog_register(&_wdog, "fw_att_control", 500);
+
 	_task_running = true;
 
 	while (!_task_should_exit) {
 
 		static int loop_counter = 0;
 
-		/* wait for up to 500ms for data */
-		int pret = poll(&fds[0], (sizeof(fds) / sizeof(fds[0])), 100);
+		/* wait for data or the next deadline */
+		int pret = rate_loop_poll(&_rate_loop, &fds[0], (sizeof(fds) / sizeof(fds[0])));
+
+		watchdog_checkin(&_wdog);
 
 		/* timed out - periodic check for _task_should_exit, etc. */
 		if (pret == 0)
@@ -680,8 +628,6 @@ FixedwingAttitudeControl::task_main()
 			continue;
 		}
 
-		perf_begin(_loop_perf);
-
 		/* only update parameters if they changed */
 		if (fds[0].revents & POLLIN) {
 			/* read from param to clear updated flag */
@@ -695,14 +641,7 @@ FixedwingAttitudeControl::task_main()
 		/* only run controller if attitude changed */
 		if (fds[1].revents & POLLIN) {
 
-
-			static uint64_t last_run = 0;
-			float deltaT = (hrt_absolute_time() - last_run) / 1000000.0f;
-			last_run = hrt_absolute_time();
-
-			/* guard against too large deltaT's */
-			if (deltaT > 1.0f)
-				deltaT = 0.01f;
+			float deltaT = rate_loop_begin(&_rate_loop);
 
 			/* load local copies */
 			orb_copy(ORB_ID(vehicle_attitude), _att_sub, &_att);
@@ -862,7 +801,7 @@ FixedwingAttitudeControl::task_main()
  					/*
 					 * Velocity should be controlled and manual is enabled.
 					*/
-					roll_sp = (_manual.y * _parameters.man_roll_max - _parameters.trim_roll)
+					roll_sp = (_manual.y * _parameters.man_roll_max_rad - _parameters.trim_roll)
 											+ _parameters.rollsp_offset_rad;
 					pitch_sp = _att_sp.pitch_body + _parameters.pitchsp_offset_rad;
 					throttle_sp = _att_sp.thrust;
@@ -890,9 +829,9 @@ FixedwingAttitudeControl::task_main()
 					 * the intended attitude setpoint. Later, after the rate control step the
 					 * trim is added again to the control signal.
 					 */
-					roll_sp = (_manual.y * _parameters.man_roll_max - _parameters.trim_roll)
+					roll_sp = (_manual.y * _parameters.man_roll_max_rad - _parameters.trim_roll)
 						+ _parameters.rollsp_offset_rad;
-					pitch_sp = -(_manual.x * _parameters.man_pitch_max - _parameters.trim_pitch)
+					pitch_sp = -(_manual.x * _parameters.man_pitch_max_rad - _parameters.trim_pitch)
 						+ _parameters.pitchsp_offset_rad;
 					/* allow manual control of rudder deflection */
 					yaw_manual = _manual.r;
@@ -963,6 +902,8 @@ FixedwingAttitudeControl::task_main()
 				control_input.airspeed_max = _parameters.airspeed_max;
 				control_input.airspeed = airspeed;
 				control_input.scaler = airspeed_scaling;
+				control_input.scaler2 = airspeed_scaling * airspeed_scaling;
+				control_input.inv_airspeed = 1.0f / airspeed;
 				control_input.lock_integrator = lock_integrator;
 
 				/* Run attitude controllers */
@@ -1098,14 +1039,17 @@ FixedwingAttitudeControl::task_main()
 					_actuators_2_pub = orb_advertise(ORB_ID(actuator_controls_2), &_actuators_airframe);
 				}
 			}
+
+			rate_loop_end(&_rate_loop);
 		}
 
 		loop_counter++;
-		perf_end(_loop_perf);
 	}
 
 	warnx("exiting.\n");
 
+	watchdog_unregister(&_wdog);
+
 	_control_task = -1;
 	_task_running = false;
 	_exit(0);
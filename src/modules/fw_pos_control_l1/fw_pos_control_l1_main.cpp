@@ -78,6 +78,7 @@
 #include <uORB/topics/sensor_combined.h>
 #include <uORB/topics/parameter_update.h>
 #include <uORB/topics/vehicle_status.h>
+#include <uORB/topics/terrain_estimate.h>
 #include <systemlib/param/param.h>
 #include <systemlib/err.h>
 #include <systemlib/pid/pid.h>
@@ -147,6 +148,7 @@ private:
 	int 		_params_sub;			/**< notification of parameter updates */
 	int 		_manual_control_sub;		/**< notification of manual control updates */
 	int		_sensor_combined_sub;		/**< for body frame accelerations */
+	int		_terrain_estimate_sub;		/**< terrain estimate subscription */
 
 	orb_advert_t	_attitude_sp_pub;		/**< attitude setpoint */
 	orb_advert_t	_tecs_status_pub;		/**< TECS status publication */
@@ -162,6 +164,10 @@ private:
 	struct vehicle_global_position_s		_global_pos;			/**< global vehicle position */
 	struct position_setpoint_triplet_s		_pos_sp_triplet;		/**< triplet of mission items */
 	struct sensor_combined_s			_sensor_combined;		/**< for body frame accelerations */
+	struct terrain_estimate_s			_terrain_estimate;		/**< shared terrain estimate */
+
+	float		_accel_batch[SENSOR_COMBINED_QUEUE_DEPTH];	/**< body x accelerations drained this cycle */
+	unsigned	_accel_batch_len;				/**< number of samples in _accel_batch */
 
 	perf_counter_t	_loop_perf;			/**< loop performance counter */
 
@@ -345,6 +351,11 @@ private:
 	 */
 	void		vehicle_sensor_combined_poll();
 
+	/**
+	 * Check for terrain estimate updates.
+	 */
+	void		terrain_estimate_poll();
+
 	/**
 	 * Check for set triplet updates.
 	 */
@@ -432,6 +443,7 @@ FixedwingPositionControl::FixedwingPositionControl() :
 	_params_sub(-1),
 	_manual_control_sub(-1),
 	_sensor_combined_sub(-1),
+	_terrain_estimate_sub(-1),
 
 /* publications */
 	_attitude_sp_pub(-1),
@@ -449,6 +461,9 @@ FixedwingPositionControl::FixedwingPositionControl() :
 	_global_pos(),
 	_pos_sp_triplet(),
 	_sensor_combined(),
+	_terrain_estimate(),
+	_accel_batch(),
+	_accel_batch_len(0),
 
 /* performance counters */
 	_loop_perf(perf_alloc(PC_ELAPSED, "fw l1 control")),
@@ -748,8 +763,32 @@ FixedwingPositionControl::vehicle_sensor_combined_poll()
 	bool sensors_updated;
 	orb_check(_sensor_combined_sub, &sensors_updated);
 
-	if (sensors_updated) {
+	/* drain all samples published since the last cycle so the launch detector
+	 * sees every accelerometer sample; _sensor_combined keeps the newest one.
+	 * The drain is done sample by sample as this task cannot afford a
+	 * queue-depth sample buffer on its stack. */
+	_accel_batch_len = 0;
+
+	while (sensors_updated) {
 		orb_copy(ORB_ID(sensor_combined), _sensor_combined_sub, &_sensor_combined);
+
+		if (_accel_batch_len < SENSOR_COMBINED_QUEUE_DEPTH) {
+			_accel_batch[_accel_batch_len++] = _sensor_combined.accelerometer_m_s2[0];
+		}
+
+		orb_check(_sensor_combined_sub, &sensors_updated);
+	}
+}
+
+void
+FixedwingPositionControl::terrain_estimate_poll()
+{
+	/* check if there is a new terrain estimate */
+	bool terrain_updated;
+	orb_check(_terrain_estimate_sub, &terrain_updated);
+
+	if (terrain_updated) {
+		orb_copy(ORB_ID(terrain_estimate), _terrain_estimate_sub, &_terrain_estimate);
 	}
 }
 
@@ -864,18 +903,23 @@ void FixedwingPositionControl::navigation_capabilities_publish()
 
 float FixedwingPositionControl::get_terrain_altitude_landing(float land_setpoint_alt, const struct vehicle_global_position_s &global_pos)
 {
-	if (!isfinite(global_pos.terrain_alt)) {
+	/* prefer the shared terrain provider over the estimator output */
+	bool provider_valid = _terrain_estimate.valid &&
+			      hrt_elapsed_time(&_terrain_estimate.timestamp) < 1000000 &&
+			      isfinite(_terrain_estimate.terrain_alt);
+
+	if (!provider_valid && !isfinite(global_pos.terrain_alt)) {
 		return land_setpoint_alt;
 	}
 
 	/* Decide if the terrain estimation can be used, once we switched to using the terrain we stick with it
 	 * for the whole landing */
-	if (_parameters.land_use_terrain_estimate && (global_pos.terrain_alt_valid || land_useterrain)) {
+	if (_parameters.land_use_terrain_estimate && (provider_valid || global_pos.terrain_alt_valid || land_useterrain)) {
 		if(!land_useterrain) {
 			mavlink_log_info(_mavlink_fd, "#audio: Landing, using terrain estimate");
 			land_useterrain = true;
 		}
-		return global_pos.terrain_alt;
+		return provider_valid ? _terrain_estimate.terrain_alt : global_pos.terrain_alt;
 	} else {
 		return land_setpoint_alt;
 	}
@@ -1152,8 +1196,8 @@ FixedwingPositionControl::control_position(const math::Vector<2> &current_positi
 					last_sent = hrt_absolute_time();
 				}
 
-				/* Detect launch */
-				launchDetector.update(_sensor_combined.accelerometer_m_s2[0]);
+				/* Detect launch using every accelerometer sample seen this cycle */
+				launchDetector.update(_accel_batch, _accel_batch_len);
 
 				/* update our copy of the laucn detection state */
 				launch_detection_state = launchDetector.getLaunchDetected();
@@ -1367,6 +1411,7 @@ FixedwingPositionControl::task_main()
 	_pos_sp_triplet_sub = orb_subscribe(ORB_ID(position_setpoint_triplet));
 	_att_sub = orb_subscribe(ORB_ID(vehicle_attitude));
 	_sensor_combined_sub = orb_subscribe(ORB_ID(sensor_combined));
+	_terrain_estimate_sub = orb_subscribe(ORB_ID(terrain_estimate));
 	_control_mode_sub = orb_subscribe(ORB_ID(vehicle_control_mode));
 	_vehicle_status_sub = orb_subscribe(ORB_ID(vehicle_status));
 	_airspeed_sub = orb_subscribe(ORB_ID(airspeed));
@@ -1448,6 +1493,7 @@ FixedwingPositionControl::task_main()
 			vehicle_attitude_poll();
 			vehicle_setpoint_poll();
 			vehicle_sensor_combined_poll();
+			terrain_estimate_poll();
 			vehicle_airspeed_poll();
 			vehicle_manual_control_setpoint_poll();
 			// vehicle_baro_poll();
@@ -40,7 +40,7 @@
  */
 
 #include "LandDetector.h"
-#include <unistd.h>                 //usleep
+#include <unistd.h>
 #include <drivers/drv_hrt.h>
 
 LandDetector::LandDetector() :
@@ -61,11 +61,12 @@ LandDetector::~LandDetector()
 void LandDetector::shutdown()
 {
 	_taskShouldExit = true;
+	_taskIsRunning = false;
 }
 
-void LandDetector::start()
+void LandDetector::init()
 {
-	// make sure this method has not already been called by another thread
+	// make sure this method has not already been called
 	if (isRunning()) {
 		return;
 	}
@@ -78,29 +79,27 @@ void LandDetector::start()
 	// initialize land detection algorithm
 	initialize();
 
-	// task is now running, keep doing so until shutdown() has been called
+	// detector is now running, keep doing so until shutdown() has been called
 	_taskIsRunning = true;
 	_taskShouldExit = false;
+}
 
-	while (isRunning()) {
-
-		bool landDetected = update();
+void LandDetector::cycle()
+{
+	if (!isRunning()) {
+		return;
+	}
 
-		// publish if land detection state has changed
-		if (_landDetected.landed != landDetected) {
-			_landDetected.timestamp = hrt_absolute_time();
-			_landDetected.landed = landDetected;
+	bool landDetected = update();
 
-			// publish the land detected broadcast
-			orb_publish(ORB_ID(vehicle_land_detected), _landDetectedPub, &_landDetected);
-		}
+	// publish if land detection state has changed
+	if (_landDetected.landed != landDetected) {
+		_landDetected.timestamp = hrt_absolute_time();
+		_landDetected.landed = landDetected;
 
-		// limit loop rate
-		usleep(1000000 / LAND_DETECTOR_UPDATE_RATE);
+		// publish the land detected broadcast
+		orb_publish(ORB_ID(vehicle_land_detected), _landDetectedPub, &_landDetected);
 	}
-
-	_taskIsRunning = false;
-	_exit(0);
 }
 
 bool LandDetector::orb_update(const struct orb_metadata *meta, int handle, void *buffer)
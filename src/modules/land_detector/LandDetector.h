@@ -52,20 +52,40 @@ public:
 	virtual ~LandDetector();
 
 	/**
-	* @return true if this task is currently running
+	* @return true if the detector is currently running
 	**/
 	inline bool isRunning() const {return _taskIsRunning;}
 
 	/**
-	* @brief  Tells the Land Detector task that it should exit
+	* @brief  Tells the Land Detector that it should stop running
 	**/
 	void shutdown();
 
 	/**
-	* @brief Blocking function that should be called from it's own task thread. This method will
-	*        run the underlying algorithm at the desired update rate and publish if the landing state changes.
+	* @brief Prepares the detector for cyclic execution: advertises the land detected
+	*        topic and initializes the underlying algorithm
 	**/
-	void start();
+	void init();
+
+	/**
+	* @brief Runs the underlying algorithm once and publishes if the landing state changes.
+	*        Called by the shared executor at the rate requested through updateRate(); must
+	*        not block.
+	**/
+	void cycle();
+
+	/**
+	* @brief Rate at which the algorithm wants to run right now, in Hz. Sub-classes can lower
+	*        this while a landing is not plausible to reclaim the CPU for the controllers.
+	**/
+	virtual uint32_t updateRate() const { return LAND_DETECTOR_UPDATE_RATE; }
+
+	/**
+	* @brief Subscription whose updates should trigger a run before the next periodic cycle,
+	*        or -1 for plain periodic operation. Lets a sub-class run at a low rate but still
+	*        react immediately to rare events such as arming.
+	**/
+	virtual int wakeupFd() const { return -1; }
 
 protected:
 
@@ -97,8 +117,8 @@ protected:
 	struct vehicle_land_detected_s          _landDetected;              /**< local vehicle position */
 
 private:
-	bool _taskShouldExit;                                               /**< true if it is requested that this task should exit */
-	bool _taskIsRunning;                                                /**< task has reached main loop and is currently running */
+	bool _taskShouldExit;                                               /**< true if it is requested that the detector should exit */
+	bool _taskIsRunning;                                                /**< detector is initialized and currently running */
 };
 
 #endif //__LAND_DETECTOR_H__
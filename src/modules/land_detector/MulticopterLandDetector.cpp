@@ -54,12 +54,15 @@ MulticopterLandDetector::MulticopterLandDetector() : LandDetector(),
 	_armingSub(-1),
 	_parameterSub(-1),
     _attitudeSub(-1),
+	_terrainEstimateSub(-1),
 	_vehicleGlobalPosition({}),
 	_vehicleStatus({}),
 	_actuators({}),
 	_arming({}),
     _vehicleAttitude({}),
-	_landTimer(0)
+	_terrainEstimate({}),
+	_landTimer(0),
+	_nearGround(true)
 {
 	_paramHandle.maxRotation = param_find("LNDMC_ROT_MAX");
 	_paramHandle.maxVelocity = param_find("LNDMC_XY_VEL_MAX");
@@ -76,6 +79,7 @@ void MulticopterLandDetector::initialize()
 	_actuatorsSub = orb_subscribe(ORB_ID_VEHICLE_ATTITUDE_CONTROLS);
 	_armingSub = orb_subscribe(ORB_ID(actuator_armed));
 	_parameterSub = orb_subscribe(ORB_ID(parameter_update));
+	_terrainEstimateSub = orb_subscribe(ORB_ID(terrain_estimate));
 
 	// download parameters
 	updateParameterCache(true);
@@ -88,6 +92,7 @@ void MulticopterLandDetector::updateSubscriptions()
 	orb_update(ORB_ID(vehicle_status), _vehicleStatusSub, &_vehicleStatus);
 	orb_update(ORB_ID_VEHICLE_ATTITUDE_CONTROLS, _actuatorsSub, &_actuators);
 	orb_update(ORB_ID(actuator_armed), _armingSub, &_arming);
+	orb_update(ORB_ID(terrain_estimate), _terrainEstimateSub, &_terrainEstimate);
 }
 
 bool MulticopterLandDetector::update()
@@ -118,7 +123,16 @@ bool MulticopterLandDetector::update()
 	// check if thrust output is minimal (about half of default)
 	bool minimalThrust = _actuators.control[3] <= _params.maxThrottle;
 
-	if (verticalMovement || rotating || !minimalThrust || horizontalMovement) {
+	bool moving = verticalMovement || rotating || !minimalThrust || horizontalMovement;
+
+	// a landing is plausible - and the full update rate needed - once the landing
+	// conditions start to hold or the terrain estimate puts us close to the ground
+	_nearGround = !moving ||
+		      (_terrainEstimate.valid && _terrainEstimate.dist_ground < MC_NEAR_GROUND_ALT) ||
+		      (_vehicleGlobalPosition.terrain_alt_valid &&
+		       ((_vehicleGlobalPosition.alt - _vehicleGlobalPosition.terrain_alt) < MC_NEAR_GROUND_ALT));
+
+	if (moving) {
 		// sensed movement, so reset the land detector
 		_landTimer = now;
 		return false;
@@ -127,6 +141,27 @@ bool MulticopterLandDetector::update()
 	return now - _landTimer > LAND_DETECTOR_TRIGGER_TIME;
 }
 
+uint32_t MulticopterLandDetector::updateRate() const
+{
+	// disarmed: nothing to do until the arming update wakes us
+	if (!_arming.armed) {
+		return MC_UPDATE_RATE_STANDBY;
+	}
+
+	// clearly airborne: only the start of a descent needs to be noticed, which is
+	// slow against the landing trigger time
+	if (!_nearGround) {
+		return MC_UPDATE_RATE_AIRBORNE;
+	}
+
+	return LAND_DETECTOR_UPDATE_RATE;
+}
+
+int MulticopterLandDetector::wakeupFd() const
+{
+	return _armingSub;
+}
+
 void MulticopterLandDetector::updateParameterCache(const bool force)
 {
 	bool updated;
@@ -45,6 +45,7 @@
 #include "LandDetector.h"
 #include <uORB/topics/vehicle_global_position.h>
 #include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/terrain_estimate.h>
 #include <uORB/topics/vehicle_status.h>
 #include <uORB/topics/actuator_controls.h>
 #include <uORB/topics/actuator_armed.h>
@@ -72,6 +73,18 @@ protected:
 	**/
 	void initialize() override;
 
+	/**
+	* @brief Runs at full rate only while disarmed-to-armed transitions or a landing are
+	*        plausible; clearly airborne the loop is decimated
+	**/
+	uint32_t updateRate() const override;
+
+	/**
+	* @brief Arming updates end the sleep early, so a low standby rate does not delay
+	*        the reaction to arming
+	**/
+	int wakeupFd() const override;
+
 
 private:
 	/**
@@ -96,6 +109,13 @@ private:
 		float maxThrottle;
 	} _params;
 
+	static constexpr uint32_t MC_UPDATE_RATE_STANDBY = 5;     /**< Hz while disarmed; arming wakes us early */
+
+	static constexpr uint32_t MC_UPDATE_RATE_AIRBORNE = 10;   /**< Hz while clearly airborne */
+
+	static constexpr float MC_NEAR_GROUND_ALT = 10.0f;        /**< altitude above terrain in meters below which
+                                                                       we always run at full rate */
+
 private:
 	int _vehicleGlobalPositionSub;                                      /**< notification of global position */
 	int _vehicleStatusSub;
@@ -103,14 +123,17 @@ private:
 	int _armingSub;
 	int _parameterSub;
 	int _attitudeSub;
+	int _terrainEstimateSub;
 
 	struct vehicle_global_position_s          _vehicleGlobalPosition;   /**< the result from global position subscription */
 	struct vehicle_status_s 			      _vehicleStatus;
 	struct actuator_controls_s                _actuators;
 	struct actuator_armed_s                   _arming;
 	struct vehicle_attitude_s                 _vehicleAttitude;
+	struct terrain_estimate_s                 _terrainEstimate;         /**< shared terrain estimate */
 
 	uint64_t _landTimer;                                                /**< timestamp in microseconds since a possible land was detected*/
+	bool _nearGround;                                                   /**< true while a landing is plausible and the full update rate is needed */
 };
 
 #endif //__MULTICOPTER_LAND_DETECTOR_H__
@@ -38,13 +38,13 @@
  * @author Johan Jansen <jnsn.johan@gmail.com>
  */
 
-#include <unistd.h>					//usleep
+#include <unistd.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <errno.h>
 #include <drivers/drv_hrt.h>
-#include <systemlib/systemlib.h>	//Scheduler
+#include <systemlib/px4_exec.h>		//Shared executor
 #include <systemlib/err.h>			//print to console
 
 #include "FixedwingLandDetector.h"
@@ -63,56 +63,47 @@ extern "C" __EXPORT int land_detector_main(int argc, char *argv[]);
 
 //Private variables
 static LandDetector *land_detector_task = nullptr;
-static int _landDetectorTaskID = -1;
+static struct px4_exec_item_s _execItem;
 static char _currentMode[12];
 
 /**
-* Deamon thread function
+* Executor cycle, runs the detector once on the shared dispatcher
 **/
-static void land_detector_deamon_thread(int argc, char *argv[])
+static void land_detector_cycle(void *arg)
 {
-	land_detector_task->start();
+	LandDetector *detector = (LandDetector *)arg;
+
+	detector->cycle();
+
+	//The algorithm may change its rate between cycles
+	px4_exec_set_interval(&_execItem, 1000000 / detector->updateRate());
 }
 
 /**
-* Stop the task, force killing it if it doesn't stop by itself
+* Stop the detector and pull it off the executor
 **/
 static void land_detector_stop()
 {
-	if (land_detector_task == nullptr || _landDetectorTaskID == -1) {
+	if (land_detector_task == nullptr) {
 		errx(1, "not running");
 		return;
 	}
 
+	//After unregister no cycle is running or pending, so the object can go away
+	px4_exec_unregister(&_execItem);
 	land_detector_task->shutdown();
 
-	//Wait for task to die
-	int i = 0;
-
-	do {
-		/* wait 20ms */
-		usleep(20000);
-
-		/* if we have given up, kill it */
-		if (++i > 50) {
-			task_delete(_landDetectorTaskID);
-			break;
-		}
-	} while (land_detector_task->isRunning());
-
-
 	delete land_detector_task;
 	land_detector_task = nullptr;
-	_landDetectorTaskID = -1;
 	errx(0, "land_detector has been stopped");
 }
 
 /**
-* Start new task, fails if it is already running. Returns OK if successful
+* Start the detector as an executor work item, fails if it is already running. Returns OK if successful
 **/
 static int land_detector_start(const char *mode)
 {
-	if (land_detector_task != nullptr || _landDetectorTaskID != -1) {
+	if (land_detector_task != nullptr) {
 		errx(1, "already running");
 		return -1;
 	}
@@ -135,36 +126,24 @@ static int land_detector_start(const char *mode)
 		return -1;
 	}
 
-	//Start new thread task
-	_landDetectorTaskID = task_spawn_cmd("land_detector",
-					     SCHED_DEFAULT,
-					     SCHED_PRIORITY_DEFAULT,
-					     1000,
-					     (main_t)&land_detector_deamon_thread,
-					     nullptr);
-
-	if (_landDetectorTaskID < 0) {
-		errx(1, "task start failed: %d", -errno);
+	//Advertise and initialize the algorithm, then hand it to the shared executor;
+	//instead of a task of its own the detector is now a work item that runs at its
+	//requested rate and early whenever the wakeup subscription updates
+	land_detector_task->init();
+
+	int ret = px4_exec_register(&_execItem, "land_detector",
+				    land_detector_cycle, land_detector_task,
+				    land_detector_task->wakeupFd(),
+				    1000000 / land_detector_task->updateRate());
+
+	if (ret != OK) {
+		land_detector_task->shutdown();
+		delete land_detector_task;
+		land_detector_task = nullptr;
+		errx(1, "executor registration failed: %d", ret);
 		return -1;
 	}
 
-	/* avoid memory fragmentation by not exiting start handler until the task has fully started */
-	const uint32_t timeout = hrt_absolute_time() + 5000000; //5 second timeout
-
-	while (!land_detector_task->isRunning()) {
-		usleep(50000);
-		printf(".");
-		fflush(stdout);
-
-		if (hrt_absolute_time() > timeout) {
-			err(1, "start failed - timeout");
-			land_detector_stop();
-			exit(1);
-		}
-	}
-
-	printf("\n");
-
 	//Remember current active mode
 	strncpy(_currentMode, mode, 12);
 
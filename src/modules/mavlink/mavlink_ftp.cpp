@@ -58,6 +58,7 @@ MavlinkFTP::MavlinkFTP() :
 	_request_bufs{},
 	_request_queue{},
 	_request_queue_sem{},
+	_session_streams{},
 	_utRcvMsgFunc{},
 	_ftp_test{}
 {
@@ -68,6 +69,8 @@ MavlinkFTP::MavlinkFTP() :
 	// initialize session list
 	for (size_t i=0; i<kMaxSession; i++) {
 		_session_fds[i] = -1;
+		_invalidate_cache(i);
+		_reset_compression(i);
 	}
 
 	// drop work entries onto the free list
@@ -226,6 +229,15 @@ MavlinkFTP::_process_request(Request *req)
 		errorCode = _workCalcFileCRC32(payload);
 		break;
 
+	case kCmdOpenFileCompressedRO:
+		errorCode = _workOpen(payload, O_RDONLY);
+
+		if (errorCode == kErrNone) {
+			_session_comp[payload->session].enabled = true;
+		}
+
+		break;
+
 	default:
 		errorCode = kErrUnknownCommand;
 		break;	
@@ -442,6 +454,14 @@ MavlinkFTP::_workOpen(PayloadHeader* payload, int oflag)
 	}
 	_session_fds[session_index] = fd;
 
+	if (file_stream_init(&_session_streams[session_index], fd, kReadAheadSize) != 0) {
+		::close(fd);
+		_session_fds[session_index] = -1;
+		return kErrFailErrno;
+	}
+
+	_reset_compression(session_index);
+
 	payload->session = session_index;
 	payload->size = sizeof(uint32_t);
 	*((uint32_t*)payload->data) = fileSize;
@@ -459,28 +479,190 @@ MavlinkFTP::_workRead(PayloadHeader* payload)
 		return kErrInvalidSession;
 	}
 
-	// Seek to the specified position
-#ifdef MAVLINK_FTP_DEBUG
-	warnx("seek %d", payload->offset);
-#endif
-	if (lseek(_session_fds[session_index], payload->offset, SEEK_SET) < 0) {
-		// Unable to see to the specified location
+	if (_session_comp[session_index].enabled) {
+		return _workReadCompressed(payload);
+	}
+
+	// Sequential downloads walk the file in kMaxDataLength steps; serve them
+	// out of the readahead stream, which only hits the SD card when the
+	// request falls outside the cached window.
+	const uint8_t *data;
+	ssize_t window_left = file_stream_peek(&_session_streams[session_index], payload->offset, &data);
+
+	if (window_left < 0) {
+		warnx("read fail");
+		return kErrFailErrno;
+	}
+
+	uint32_t copy_len = (window_left > kMaxDataLength) ? kMaxDataLength : window_left;
+
+	if (copy_len > 0) {
+		memcpy(&payload->data[0], data, copy_len);
+	}
+
+	payload->size = copy_len;
+
+	return kErrNone;
+}
+
+/// @brief Responds to a Read command on a session opened with kCmdOpenFileCompressedRO.
+/// The offset field addresses the compressed stream and must advance sequentially;
+/// the most recent block may be requested again to recover from a lost reply.
+MavlinkFTP::ErrorCode
+MavlinkFTP::_workReadCompressed(PayloadHeader* payload)
+{
+	int session_index = payload->session;
+	CompressSession *comp = &_session_comp[session_index];
+
+	// retransmit of the most recent block
+	if (comp->last_len > 0 && payload->offset == comp->last_offset) {
+		memcpy(&payload->data[0], comp->last_block, comp->last_len);
+		payload->size = comp->last_len;
+		return kErrNone;
+	}
+
+	// the compressed stream has no random access
+	if (payload->offset != comp->out_offset) {
+		warnx("FTP: compressed read out of sequence");
+		return kErrFail;
+	}
+
+	if (lseek(_session_fds[session_index], comp->in_offset, SEEK_SET) < 0) {
 		warnx("seek fail");
 		return kErrEOF;
 	}
 
-	int bytes_read = ::read(_session_fds[session_index], &payload->data[0], kMaxDataLength);
+	uint8_t inbuf[kCompressChunk];
+	int bytes_read = ::read(_session_fds[session_index], inbuf, sizeof(inbuf));
+
 	if (bytes_read < 0) {
-		// Negative return indicates error other than eof
 		warnx("read fail %d", bytes_read);
 		return kErrFailErrno;
 	}
 
-	payload->size = bytes_read;
+	if (bytes_read == 0) {
+		// end of the compressed stream
+		payload->size = 0;
+		return kErrNone;
+	}
+
+	unsigned out_len = 0;
+	unsigned consumed = _lzss_compress_block(comp, inbuf, bytes_read, &payload->data[0], kMaxDataLength, &out_len);
+
+	_history_append(comp, inbuf, consumed);
+	comp->in_offset += consumed;
+
+	memcpy(comp->last_block, &payload->data[0], out_len);
+	comp->last_len = out_len;
+	comp->last_offset = comp->out_offset;
+	comp->out_offset += out_len;
+
+	payload->size = out_len;
 
 	return kErrNone;
 }
 
+/// @brief Returns the stream byte dist positions behind in[pos], reaching back into the history window
+uint8_t
+MavlinkFTP::_stream_prev(CompressSession *comp, const uint8_t *in, unsigned pos, unsigned dist)
+{
+	if (dist <= pos) {
+		return in[pos - dist];
+	}
+
+	return comp->history[comp->history_len - (dist - pos)];
+}
+
+/// @brief Compresses as much of the input chunk as fits into one reply block.
+/// Token format: a flag byte announces eight items, LSB first; a clear bit is a
+/// literal byte, a set bit is a two-byte back-reference (distance 1-255, length
+/// 3-255). The decoder mirrors the 255-byte sliding window.
+///	@return Number of input bytes consumed
+unsigned
+MavlinkFTP::_lzss_compress_block(CompressSession *comp, const uint8_t *in, unsigned in_len, uint8_t *out, unsigned out_max, unsigned *out_len)
+{
+	unsigned ip = 0;
+	unsigned op = 0;
+
+	// one flag byte plus up to eight two-byte items per group
+	while (ip < in_len && (op + 1 + 2 * 8) <= out_max) {
+		unsigned flag_pos = op++;
+		uint8_t flags = 0;
+
+		for (unsigned bit = 0; bit < 8 && ip < in_len; bit++) {
+			unsigned best_len = 0;
+			unsigned best_dist = 0;
+
+			unsigned max_dist = ip + comp->history_len;
+
+			if (max_dist > kCompressMaxDist) {
+				max_dist = kCompressMaxDist;
+			}
+
+			unsigned max_len = in_len - ip;
+
+			if (max_len > 255) {
+				max_len = 255;
+			}
+
+			for (unsigned dist = 1; dist <= max_dist; dist++) {
+				unsigned l = 0;
+
+				// overlapping matches (dist < l) are legal and encode runs
+				while (l < max_len && in[ip + l] == _stream_prev(comp, in, ip + l, dist)) {
+					l++;
+				}
+
+				if (l > best_len) {
+					best_len = l;
+					best_dist = dist;
+
+					if (l == max_len) {
+						break;
+					}
+				}
+			}
+
+			if (best_len >= kCompressMinMatch) {
+				out[op++] = best_dist;
+				out[op++] = best_len;
+				flags |= (1 << bit);
+				ip += best_len;
+
+			} else {
+				out[op++] = in[ip++];
+			}
+		}
+
+		out[flag_pos] = flags;
+	}
+
+	*out_len = op;
+
+	return ip;
+}
+
+/// @brief Slides the compression history window forward over the consumed input
+void
+MavlinkFTP::_history_append(CompressSession *comp, const uint8_t *data, unsigned len)
+{
+	if (len >= kCompressMaxDist) {
+		memcpy(comp->history, data + len - kCompressMaxDist, kCompressMaxDist);
+		comp->history_len = kCompressMaxDist;
+
+	} else {
+		unsigned keep = comp->history_len;
+
+		if (keep + len > kCompressMaxDist) {
+			keep = kCompressMaxDist - len;
+		}
+
+		memmove(comp->history, comp->history + comp->history_len - keep, keep);
+		memcpy(comp->history + keep, data, len);
+		comp->history_len = keep + len;
+	}
+}
+
 /// @brief Responds to a Write command
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workWrite(PayloadHeader* payload)
@@ -501,6 +683,9 @@ MavlinkFTP::_workWrite(PayloadHeader* payload)
 		return kErrFailErrno;
 	}
 
+	// file contents are changing underneath any cached window
+	_invalidate_cache(session_index);
+
 	int bytes_written = ::write(_session_fds[session_index], &payload->data[0], payload->size);
 	if (bytes_written < 0) {
 		// Negative return indicates error other than eof
@@ -614,6 +799,8 @@ MavlinkFTP::_workTerminate(PayloadHeader* payload)
     
 	::close(_session_fds[payload->session]);
 	_session_fds[payload->session] = -1;
+	file_stream_free(&_session_streams[payload->session]);
+	_reset_compression(payload->session);
 	
 	payload->size = 0;
 
@@ -629,6 +816,8 @@ MavlinkFTP::_workReset(PayloadHeader* payload)
 			::close(_session_fds[i]);
 			_session_fds[i] = -1;
 		}
+		file_stream_free(&_session_streams[i]);
+		_reset_compression(i);
 	}
 
 	payload->size = 0;
@@ -726,6 +915,27 @@ MavlinkFTP::_workCalcFileCRC32(PayloadHeader* payload)
 	return kErrNone;
 }
 
+/// @brief Drops any readahead data held for the specified session
+void
+MavlinkFTP::_invalidate_cache(unsigned session)
+{
+	file_stream_invalidate(&_session_streams[session]);
+}
+
+/// @brief Clears the compression state for the specified session
+void
+MavlinkFTP::_reset_compression(unsigned session)
+{
+	CompressSession *comp = &_session_comp[session];
+
+	comp->enabled = false;
+	comp->in_offset = 0;
+	comp->out_offset = 0;
+	comp->last_offset = 0;
+	comp->last_len = 0;
+	comp->history_len = 0;
+}
+
 /// @brief Returns true if the specified session is a valid open session
 bool
 MavlinkFTP::_valid_session(unsigned index)
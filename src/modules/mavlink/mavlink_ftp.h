@@ -41,6 +41,7 @@
 
 #include <nuttx/wqueue.h>
 #include <systemlib/err.h>
+#include <systemlib/file_stream.h>
 
 #include "mavlink_messages.h"
 #include "mavlink_main.h"
@@ -100,6 +101,7 @@ public:
 		kCmdTruncateFile,	///< Truncate file at <path> to <offset> length
 		kCmdRename,		///< Rename <path1> to <path2>
 		kCmdCalcFileCRC32,	///< Calculate CRC32 for file at <path>
+		kCmdOpenFileCompressedRO,	///< Opens file at <path> for LZSS-compressed sequential reading, returns <session>
 		
 		kRspAck = 128,		///< Ack response
 		kRspNak			///< Nak response
@@ -147,6 +149,7 @@ private:
 	ErrorCode	_workList(PayloadHeader *payload);
 	ErrorCode	_workOpen(PayloadHeader *payload, int oflag);
 	ErrorCode	_workRead(PayloadHeader *payload);
+	ErrorCode	_workReadCompressed(PayloadHeader *payload);
 	ErrorCode	_workWrite(PayloadHeader *payload);
 	ErrorCode	_workTerminate(PayloadHeader *payload);
 	ErrorCode	_workReset(PayloadHeader* payload);
@@ -174,6 +177,43 @@ private:
 	
 	static const unsigned kMaxSession = 2;	///< Max number of active sessions
 	int	_session_fds[kMaxSession];	///< Session file descriptors, 0 for empty slot
+
+	/// @brief Number of bytes pulled from the SD card per physical read. Sized to span
+	/// several FAT clusters so sequential downloads run at media speed instead of
+	/// paying a seek+read per kMaxDataLength request.
+	static const uint16_t	kReadAheadSize = 2048;
+
+	struct file_stream_s	_session_streams[kMaxSession];	///< Per-session readahead stream, indexed like _session_fds
+
+	void		_invalidate_cache(unsigned session);
+
+	static const unsigned	kCompressMaxDist = 255;		///< Deepest back-reference the one-byte distance field can encode
+	static const unsigned	kCompressMinMatch = 3;		///< Shortest match worth a two-byte token
+	static const unsigned	kCompressChunk = 512;		///< Uncompressed bytes pulled from the file per block
+
+	/// @brief Streaming LZSS state for a session opened with kCmdOpenFileCompressedRO.
+	/// Reads on such a session return a compressed byte stream; the offset field
+	/// addresses the compressed stream and must advance sequentially, with a
+	/// retransmit of the most recent block allowed for lost replies.
+	struct CompressSession
+	{
+		bool		enabled;	///< Session serves compressed reads
+		uint32_t	in_offset;	///< Uncompressed bytes consumed from the file
+		uint32_t	out_offset;	///< Compressed bytes produced so far (expected next read offset)
+		uint32_t	last_offset;	///< Compressed offset of the most recent block
+		uint8_t		last_len;	///< Length of the most recent block, 0 if none
+		uint8_t		last_block[kMaxDataLength];	///< Retransmit copy of the most recent block
+		uint16_t	history_len;	///< Valid bytes in history
+		uint8_t		history[kCompressMaxDist];	///< Uncompressed stream tail preceding the current chunk
+	};
+
+	CompressSession	_session_comp[kMaxSession];	///< Compression state, indexed like _session_fds
+
+	void		_reset_compression(unsigned session);
+	uint8_t		_stream_prev(CompressSession *comp, const uint8_t *in, unsigned pos, unsigned dist);
+	unsigned	_lzss_compress_block(CompressSession *comp, const uint8_t *in, unsigned in_len,
+					     uint8_t *out, unsigned out_max, unsigned *out_len);
+	void		_history_append(CompressSession *comp, const uint8_t *data, unsigned len);
 	
 	ReceiveMessageFunc_t _utRcvMsgFunc;	///< Unit test override for mavlink message sending
 	MavlinkFtpTest *_ftp_test;		///< Additional parameter to _utRcvMsgFunc;
@@ -72,6 +72,7 @@
 #include <mavlink/mavlink_log.h>
 
 #include <uORB/topics/parameter_update.h>
+#include <uORB/topics/load_governor.h>
 
 #include "mavlink_bridge_header.h"
 #include "mavlink_main.h"
@@ -96,6 +97,10 @@ static const int ERROR = -1;
 
 static Mavlink *_mavlink_instances = nullptr;
 
+/* one process-wide uORB subscription pool shared by all Mavlink instances */
+static MavlinkOrbSubscription *_shared_subscriptions = nullptr;
+static pthread_mutex_t _shared_subscriptions_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 /* TODO: if this is a class member it crashes */
 static struct file_operations fops;
 
@@ -127,7 +132,6 @@ Mavlink::Mavlink() :
 	_wait_to_transmit(false),
 	_received_messages(false),
 	_main_loop_delay(1000),
-	_subscriptions(nullptr),
 	_streams(nullptr),
 	_mission_manager(nullptr),
 	_parameters_manager(nullptr),
@@ -145,6 +149,8 @@ Mavlink::Mavlink() :
 	_datarate(1000),
 	_datarate_events(500),
 	_rate_mult(1.0f),
+	_radio_rate_mult(1.0f),
+	_load_shed_mult(1.0f),
 	_mavlink_param_queue_index(0),
 	mavlink_link_termination_allowed(false),
 	_subscribe_to_stream(nullptr),
@@ -152,6 +158,9 @@ Mavlink::Mavlink() :
 	_flow_control_enabled(true),
 	_last_write_success_time(0),
 	_last_write_try_time(0),
+	_tx_ring_start(0),
+	_tx_ring_len(0),
+	_tx_partial_since(0),
 	_bytes_tx(0),
 	_bytes_txerr(0),
 	_bytes_rx(0),
@@ -363,6 +372,27 @@ Mavlink::get_status_all_instances()
 	return (iterations == 0);
 }
 
+int
+Mavlink::get_streams_all_instances()
+{
+	Mavlink *inst = ::_mavlink_instances;
+
+	unsigned iterations = 0;
+
+	while (inst != nullptr) {
+
+		printf("\ninstance #%u:\n", iterations);
+		inst->display_streams();
+
+		/* move on */
+		inst = inst->next;
+		iterations++;
+	}
+
+	/* return an error if there are no instances */
+	return (iterations == 0);
+}
+
 bool
 Mavlink::instance_exists(const char *device_name, Mavlink *self)
 {
@@ -443,6 +473,7 @@ Mavlink::mavlink_dev_ioctl(struct file *filep, int cmd, unsigned long arg)
 			const char *txt = (const char *)arg;
 			struct mavlink_logmessage msg;
 			strncpy(msg.text, txt, sizeof(msg.text));
+			msg.fmt = nullptr;
 
 			switch (cmd) {
 			case MAVLINK_IOC_SEND_TEXT_INFO:
@@ -473,6 +504,43 @@ Mavlink::mavlink_dev_ioctl(struct file *filep, int cmd, unsigned long arg)
 			return OK;
 		}
 
+	case (int)MAVLINK_IOC_SEND_TEXT_DEFERRED: {
+
+			const struct mavlink_deferred_logmessage *dmsg = (const struct mavlink_deferred_logmessage *)arg;
+			struct mavlink_logmessage msg;
+
+			/* only the format pointer and argument words are stored,
+			 * MavlinkStreamStatustext formats the text when draining */
+			msg.text[0] = '\0';
+			msg.fmt = dmsg->fmt;
+			memcpy(msg.args, dmsg->args, sizeof(msg.args));
+
+			switch (dmsg->severity) {
+			case MAVLINK_IOC_SEND_TEXT_CRITICAL:
+				msg.severity = MAV_SEVERITY_CRITICAL;
+				break;
+
+			case MAVLINK_IOC_SEND_TEXT_EMERGENCY:
+				msg.severity = MAV_SEVERITY_EMERGENCY;
+				break;
+
+			case MAVLINK_IOC_SEND_TEXT_INFO:
+			default:
+				msg.severity = MAV_SEVERITY_INFO;
+				break;
+			}
+
+			Mavlink *inst;
+			LL_FOREACH(_mavlink_instances, inst) {
+				if (!inst->_task_should_exit) {
+					mavlink_logbuffer_write(&inst->_logbuffer, &msg);
+					inst->_total_counter++;
+				}
+			}
+
+			return OK;
+		}
+
 	default:
 		return ENOTTY;
 	}
@@ -745,6 +813,96 @@ Mavlink::get_free_tx_buf()
 	return buf_free;
 }
 
+bool
+Mavlink::tx_ring_enqueue(const uint8_t *buf, unsigned len)
+{
+	if (TX_RING_SIZE - _tx_ring_len < len) {
+		return false;
+	}
+
+	unsigned end = (_tx_ring_start + _tx_ring_len) % TX_RING_SIZE;
+
+	/* copy, possibly wrapping around the end of the ring */
+	unsigned first = TX_RING_SIZE - end;
+
+	if (first > len) {
+		first = len;
+	}
+
+	memcpy(&_tx_ring[end], buf, first);
+
+	if (len > first) {
+		memcpy(&_tx_ring[0], buf + first, len - first);
+	}
+
+	_tx_ring_len += len;
+
+	return true;
+}
+
+void
+Mavlink::flush_tx_ring()
+{
+	/* get_free_tx_buf also runs the flow-control watchdog */
+	unsigned buf_free = get_free_tx_buf();
+
+	unsigned pending = _tx_ring_len;
+
+	if (_is_usb_uart) {
+		/* fill complete bulk packets; the partial tail is held back
+		 * until more data arrives or the hold-off expires */
+		unsigned partial = pending % USB_BULK_EP_SIZE;
+
+		if (partial > 0) {
+			if (_tx_partial_since == 0) {
+				_tx_partial_since = hrt_absolute_time();
+			}
+
+			if (hrt_elapsed_time(&_tx_partial_since) < USB_PARTIAL_HOLDOFF) {
+				pending -= partial;
+
+			} else {
+				/* held long enough, ship the short packet */
+				_tx_partial_since = 0;
+			}
+
+		} else {
+			_tx_partial_since = 0;
+		}
+	}
+
+	while ((pending > 0) && (buf_free > 0)) {
+		unsigned chunk = pending;
+
+		/* stop at the end of the ring, continue on the next pass */
+		if (chunk > TX_RING_SIZE - _tx_ring_start) {
+			chunk = TX_RING_SIZE - _tx_ring_start;
+		}
+
+		if (chunk > buf_free) {
+			chunk = buf_free;
+		}
+
+		ssize_t ret = write(_uart_fd, &_tx_ring[_tx_ring_start], chunk);
+
+		if (ret <= 0) {
+			break;
+		}
+
+		_tx_ring_start = (_tx_ring_start + ret) % TX_RING_SIZE;
+		_tx_ring_len -= ret;
+		pending -= ret;
+		buf_free -= ret;
+
+		_last_write_success_time = hrt_absolute_time();
+		count_txbytes(ret);
+
+		if ((unsigned)ret < chunk) {
+			break;
+		}
+	}
+}
+
 void
 Mavlink::send_message(const uint8_t msgid, const void *msg, uint8_t component_ID)
 {
@@ -756,22 +914,11 @@ Mavlink::send_message(const uint8_t msgid, const void *msg, uint8_t component_ID
 
 	pthread_mutex_lock(&_send_mutex);
 
-	unsigned buf_free = get_free_tx_buf();
-
 	uint8_t payload_len = mavlink_message_lengths[msgid];
 	unsigned packet_len = payload_len + MAVLINK_NUM_NON_PAYLOAD_BYTES;
 
 	_last_write_try_time = hrt_absolute_time();
 
-	/* check if there is space in the buffer, let it overflow else */
-	if (buf_free < packet_len) {
-		/* no enough space in buffer to send */
-		count_txerr();
-		count_txerrbytes(packet_len);
-		pthread_mutex_unlock(&_send_mutex);
-		return;
-	}
-
 	uint8_t buf[MAVLINK_MAX_PACKET_LEN];
 
 	/* header */
@@ -795,16 +942,72 @@ Mavlink::send_message(const uint8_t msgid, const void *msg, uint8_t component_ID
 	buf[MAVLINK_NUM_HEADER_BYTES + payload_len] = (uint8_t)(checksum & 0xFF);
 	buf[MAVLINK_NUM_HEADER_BYTES + payload_len + 1] = (uint8_t)(checksum >> 8);
 
-	/* send message to UART */
-	ssize_t ret = write(_uart_fd, buf, packet_len);
+	/* queue the packet; the whole cycle is coalesced into one UART write */
+	if (!tx_ring_enqueue(buf, packet_len)) {
+		/* ring full - push the backlog out now and retry once */
+		flush_tx_ring();
 
-	if (ret != (int) packet_len) {
-		count_txerr();
-		count_txerrbytes(packet_len);
+		if (!tx_ring_enqueue(buf, packet_len)) {
+			count_txerr();
+			count_txerrbytes(packet_len);
+		}
+	}
 
-	} else {
-		_last_write_success_time = _last_write_try_time;
-		count_txbytes(packet_len);
+	pthread_mutex_unlock(&_send_mutex);
+}
+
+void *
+Mavlink::begin_message()
+{
+	/* If the wait until transmit flag is on, only transmit after we've received messages.
+	   Otherwise, transmit all the time. */
+	if (!should_transmit()) {
+		return nullptr;
+	}
+
+	pthread_mutex_lock(&_send_mutex);
+
+	return &_tx_inplace_buf[MAVLINK_NUM_HEADER_BYTES];
+}
+
+void
+Mavlink::commit_message(const uint8_t msgid, uint8_t component_ID)
+{
+	/* the payload has already been assembled in place by the caller */
+	uint8_t payload_len = mavlink_message_lengths[msgid];
+	unsigned packet_len = payload_len + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+
+	_last_write_try_time = hrt_absolute_time();
+
+	uint8_t *buf = _tx_inplace_buf;
+
+	/* header */
+	buf[0] = MAVLINK_STX;
+	buf[1] = payload_len;
+	/* use mavlink's internal counter for the TX seq */
+	buf[2] = mavlink_get_channel_status(_channel)->current_tx_seq++;
+	buf[3] = mavlink_system.sysid;
+	buf[4] = (component_ID == 0) ? mavlink_system.compid : component_ID;
+	buf[5] = msgid;
+
+	/* checksum */
+	uint16_t checksum;
+	crc_init(&checksum);
+	crc_accumulate_buffer(&checksum, (const char *) &buf[1], MAVLINK_CORE_HEADER_LEN + payload_len);
+	crc_accumulate(mavlink_message_crcs[msgid], &checksum);
+
+	buf[MAVLINK_NUM_HEADER_BYTES + payload_len] = (uint8_t)(checksum & 0xFF);
+	buf[MAVLINK_NUM_HEADER_BYTES + payload_len + 1] = (uint8_t)(checksum >> 8);
+
+	/* queue the packet; the whole cycle is coalesced into one UART write */
+	if (!tx_ring_enqueue(buf, packet_len)) {
+		/* ring full - push the backlog out now and retry once */
+		flush_tx_ring();
+
+		if (!tx_ring_enqueue(buf, packet_len)) {
+			count_txerr();
+			count_txerrbytes(packet_len);
+		}
 	}
 
 	pthread_mutex_unlock(&_send_mutex);
@@ -821,21 +1024,10 @@ Mavlink::resend_message(mavlink_message_t *msg)
 
 	pthread_mutex_lock(&_send_mutex);
 
-	unsigned buf_free = get_free_tx_buf();
-
 	_last_write_try_time = hrt_absolute_time();
 
 	unsigned packet_len = msg->len + MAVLINK_NUM_NON_PAYLOAD_BYTES;
 
-	/* check if there is space in the buffer, let it overflow else */
-	if (buf_free < packet_len) {
-		/* no enough space in buffer to send */
-		count_txerr();
-		count_txerrbytes(packet_len);
-		pthread_mutex_unlock(&_send_mutex);
-		return;
-	}
-
 	uint8_t buf[MAVLINK_MAX_PACKET_LEN];
 
 	/* header and payload */
@@ -845,16 +1037,15 @@ Mavlink::resend_message(mavlink_message_t *msg)
 	buf[MAVLINK_NUM_HEADER_BYTES + msg->len] = (uint8_t)(msg->checksum & 0xFF);
 	buf[MAVLINK_NUM_HEADER_BYTES + msg->len + 1] = (uint8_t)(msg->checksum >> 8);
 
-	/* send message to UART */
-	ssize_t ret = write(_uart_fd, buf, packet_len);
-
-	if (ret != (int) packet_len) {
-		count_txerr();
-		count_txerrbytes(packet_len);
+	/* queue the packet; the whole cycle is coalesced into one UART write */
+	if (!tx_ring_enqueue(buf, packet_len)) {
+		/* ring full - push the backlog out now and retry once */
+		flush_tx_ring();
 
-	} else {
-		_last_write_success_time = _last_write_try_time;
-		count_txbytes(packet_len);
+		if (!tx_ring_enqueue(buf, packet_len)) {
+			count_txerr();
+			count_txerrbytes(packet_len);
+		}
 	}
 
 	pthread_mutex_unlock(&_send_mutex);
@@ -898,6 +1089,7 @@ Mavlink::send_statustext(unsigned char severity, const char *string)
 {
 	struct mavlink_logmessage logmsg;
 	strncpy(logmsg.text, string, sizeof(logmsg.text));
+	logmsg.fmt = nullptr;
 	logmsg.severity = severity;
 
 	mavlink_logbuffer_write(&_logbuffer, &logmsg);
@@ -905,12 +1097,18 @@ Mavlink::send_statustext(unsigned char severity, const char *string)
 
 MavlinkOrbSubscription *Mavlink::add_orb_subscription(const orb_id_t topic, int instance)
 {
+	/* the pool is shared by all links, so running three instances
+	 * costs one subscription and one orb_copy per topic, not three */
+	pthread_mutex_lock(&_shared_subscriptions_mutex);
+
 	/* check if already subscribed to this topic */
 	MavlinkOrbSubscription *sub;
 
-	LL_FOREACH(_subscriptions, sub) {
+	LL_FOREACH(_shared_subscriptions, sub) {
 		if (sub->get_topic() == topic && sub->get_instance() == instance) {
 			/* already subscribed */
+			sub->mark_used(_instance_id);
+			pthread_mutex_unlock(&_shared_subscriptions_mutex);
 			return sub;
 		}
 	}
@@ -918,7 +1116,10 @@ MavlinkOrbSubscription *Mavlink::add_orb_subscription(const orb_id_t topic, int
 	/* add new subscription */
 	MavlinkOrbSubscription *sub_new = new MavlinkOrbSubscription(topic, instance);
 
-	LL_APPEND(_subscriptions, sub_new);
+	sub_new->mark_used(_instance_id);
+	LL_APPEND(_shared_subscriptions, sub_new);
+
+	pthread_mutex_unlock(&_shared_subscriptions_mutex);
 
 	return sub_new;
 }
@@ -1184,7 +1385,7 @@ Mavlink::update_rate_mult()
 	}
 
 	/* don't scale up rates, only scale down if needed */
-	_rate_mult = fminf(1.0f, ((float)_datarate - const_rate) / rate);
+	_rate_mult = fminf(1.0f, ((float)_datarate - const_rate) / rate) * _radio_rate_mult * _load_shed_mult;
 }
 
 int
@@ -1344,6 +1545,8 @@ Mavlink::task_main(int argc, char *argv[])
 	uint64_t param_time = 0;
 	MavlinkOrbSubscription *status_sub = add_orb_subscription(ORB_ID(vehicle_status));
 	uint64_t status_time = 0;
+	MavlinkOrbSubscription *load_gov_sub = add_orb_subscription(ORB_ID(load_governor));
+	uint64_t load_gov_time = 0;
 
 	struct vehicle_status_s status;
 	status_sub->update(&status_time, &status);
@@ -1416,6 +1619,9 @@ Mavlink::task_main(int argc, char *argv[])
 	/* now the instance is fully initialized and we can bump the instance count */
 	LL_APPEND(_mavlink_instances, this);
 
+	/* reference time for the per-cycle stream byte budget */
+	hrt_abstime last_stream_t = hrt_absolute_time();
+
 	while (!_task_should_exit) {
 		/* main loop */
 		usleep(_main_loop_delay);
@@ -1436,6 +1642,13 @@ Mavlink::task_main(int argc, char *argv[])
 			set_hil_enabled(status.hil_state == vehicle_status_s::HIL_STATE_ON);
 		}
 
+		struct load_governor_s load_gov;
+
+		if (load_gov_sub->update(&load_gov_time, &load_gov)) {
+			/* halve the stream budget per shed level */
+			_load_shed_mult = 1.0f / (float)(1 << load_gov.shed_level);
+		}
+
 		/* check for requested subscriptions */
 		if (_subscribe_to_stream != nullptr) {
 			if (OK == configure_stream(_subscribe_to_stream, _subscribe_to_stream_rate)) {
@@ -1454,10 +1667,46 @@ Mavlink::task_main(int argc, char *argv[])
 			_subscribe_to_stream = nullptr;
 		}
 
-		/* update streams */
+		/*
+		 * Update streams by priority class against a per-cycle byte
+		 * budget derived from the configured datarate.  Critical
+		 * streams (heartbeat, command traffic) are always serviced;
+		 * normal and bulk streams are deferred to the next cycle once
+		 * the budget is spent, so a parameter or mission burst cannot
+		 * queue ahead of attitude data on a slow radio.
+		 */
+		int tx_budget = (int)(((uint64_t)_datarate * (t - last_stream_t)) / 1000000);
+
+		/* cap the budget so a long stall cannot accumulate into a burst */
+		int max_budget = (int)(((uint64_t)_datarate * 4 * _main_loop_delay) / 1000000);
+
+		if (tx_budget > max_budget) {
+			tx_budget = max_budget;
+		}
+
+		last_stream_t = t;
+
 		MavlinkStream *stream;
-		LL_FOREACH(_streams, stream) {
-			stream->update(t);
+
+		for (unsigned prio = 0; prio < MavlinkStream::PRIO_CLASS_COUNT; prio++) {
+			LL_FOREACH(_streams, stream) {
+				if (stream->get_priority() != prio) {
+					continue;
+				}
+
+				/* defer non-critical streams once the budget is exhausted */
+				if ((prio != MavlinkStream::PRIO_CRITICAL) && (tx_budget <= 0)) {
+					if (stream->interval_expired(t)) {
+						stream->count_skip();
+					}
+
+					continue;
+				}
+
+				if (stream->update(t) == 0) {
+					tx_budget -= stream->get_size();
+				}
+			}
 		}
 
 		/* pass messages from other UARTs or FTP worker */
@@ -1508,6 +1757,11 @@ Mavlink::task_main(int argc, char *argv[])
 			}
 		}
 
+		/* single coalesced UART write for everything queued this cycle */
+		pthread_mutex_lock(&_send_mutex);
+		flush_tx_ring();
+		pthread_mutex_unlock(&_send_mutex);
+
 		/* update TX/RX rates*/
 		if (t > _bytes_timestamp + 1000000) {
 			if (_bytes_timestamp != 0) {
@@ -1518,6 +1772,41 @@ Mavlink::task_main(int argc, char *argv[])
 				_bytes_tx = 0;
 				_bytes_txerr = 0;
 				_bytes_rx = 0;
+
+				/*
+				 * Closed-loop rate governor: back off quickly while
+				 * the link drops bytes, recover slowly once it is
+				 * clean again.  Critical streams are serviced
+				 * regardless of the multiplier, so command and ack
+				 * traffic keeps flowing during the backoff.
+				 */
+				bool link_congested = (_rate_txerr > 0.0f);
+
+				/* the 3DR radio reports its buffer fill level - treat
+				 * a nearly full radio buffer as congestion before
+				 * bytes are actually lost */
+				if (_rstatus.timestamp > 0 &&
+				    _rstatus.type == TELEMETRY_STATUS_RADIO_TYPE_3DR_RADIO &&
+				    _rstatus.txbuf < 20) {
+					link_congested = true;
+				}
+
+				if (link_congested) {
+					/* multiplicative decrease */
+					_radio_rate_mult *= 0.75f;
+
+					if (_radio_rate_mult < 0.05f) {
+						_radio_rate_mult = 0.05f;
+					}
+
+				} else {
+					/* additive recovery */
+					_radio_rate_mult += 0.05f;
+
+					if (_radio_rate_mult > 1.0f) {
+						_radio_rate_mult = 1.0f;
+					}
+				}
 			}
 
 			_bytes_timestamp = t;
@@ -1541,17 +1830,26 @@ Mavlink::task_main(int argc, char *argv[])
 
 	_streams = nullptr;
 
-	/* delete subscriptions */
+	/* drop this instance's references into the shared subscription pool
+	 * and free whatever no other link still uses */
+	pthread_mutex_lock(&_shared_subscriptions_mutex);
+
 	MavlinkOrbSubscription *sub_to_del = nullptr;
-	MavlinkOrbSubscription *sub_next = _subscriptions;
+	MavlinkOrbSubscription *sub_next = _shared_subscriptions;
 
 	while (sub_next != nullptr) {
 		sub_to_del = sub_next;
 		sub_next = sub_to_del->next;
-		delete sub_to_del;
+
+		sub_to_del->mark_unused(_instance_id);
+
+		if (!sub_to_del->in_use()) {
+			LL_DELETE(_shared_subscriptions, sub_to_del);
+			delete sub_to_del;
+		}
 	}
 
-	_subscriptions = nullptr;
+	pthread_mutex_unlock(&_shared_subscriptions_mutex);
 
 	/* wait for threads to complete */
 	pthread_join(_receive_thread, NULL);
@@ -1689,6 +1987,20 @@ Mavlink::display_status()
 	printf("\ttxerr: %.3f kB/s\n", (double)_rate_txerr);
 	printf("\trx: %.3f kB/s\n", (double)_rate_rx);
 	printf("\trate mult: %.3f\n", (double)_rate_mult);
+	printf("\tradio rate mult: %.3f\n", (double)_radio_rate_mult);
+	printf("\tload shed mult: %.3f\n", (double)_load_shed_mult);
+}
+
+void
+Mavlink::display_streams()
+{
+	printf("\tstream                        rate     kB/s  skipped  interval\n");
+	printf("\t                                Hz  nominal           usec\n");
+
+	MavlinkStream *stream;
+	LL_FOREACH(_streams, stream) {
+		stream->print_stats();
+	}
 }
 
 int
@@ -1755,7 +2067,7 @@ Mavlink::stream_command(int argc, char *argv[])
 
 static void usage()
 {
-	warnx("usage: mavlink {start|stop-all|stream} [-d device] [-b baudrate]\n\t[-r rate][-m mode] [-s stream] [-f] [-p] [-v] [-w] [-x]");
+	warnx("usage: mavlink {start|stop-all|status|streams|stream} [-d device] [-b baudrate]\n\t[-r rate][-m mode] [-s stream] [-f] [-p] [-v] [-w] [-x]");
 }
 
 int mavlink_main(int argc, char *argv[])
@@ -1779,6 +2091,9 @@ int mavlink_main(int argc, char *argv[])
 	} else if (!strcmp(argv[1], "status")) {
 		return Mavlink::get_status_all_instances();
 
+	} else if (!strcmp(argv[1], "streams")) {
+		return Mavlink::get_streams_all_instances();
+
 	} else if (!strcmp(argv[1], "stream")) {
 		return Mavlink::stream_command(argc, argv);
 
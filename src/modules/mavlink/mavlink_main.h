@@ -86,6 +86,11 @@ public:
 	 */
 	void			display_status();
 
+	/**
+	 * Display per-stream send rates and skip counts.
+	 */
+	void			display_streams();
+
 	static int		stream_command(int argc, char *argv[]);
 
 	static int		instance_count();
@@ -100,6 +105,8 @@ public:
 
 	static int		get_status_all_instances();
 
+	static int		get_streams_all_instances();
+
 	static bool		instance_exists(const char *device_name, Mavlink *self);
 
 	static void		forward_message(const mavlink_message_t *msg, Mavlink *self);
@@ -150,6 +157,22 @@ public:
 	 */
 	unsigned		get_free_tx_buf();
 
+	/**
+	 * Append a complete packet to the software TX ring.
+	 *
+	 * The caller must hold the send mutex.
+	 *
+	 * @return		true if the packet was queued, false if the
+	 *			ring was full and the packet was dropped.
+	 */
+	bool			tx_ring_enqueue(const uint8_t *buf, unsigned len);
+
+	/**
+	 * Push as many pending TX ring bytes into the serial driver as it
+	 * will currently accept.  The caller must hold the send mutex.
+	 */
+	void			flush_tx_ring();
+
 	static int		start_helper(int argc, char *argv[]);
 
 	/**
@@ -171,6 +194,27 @@ public:
 
 	void			send_message(const uint8_t msgid, const void *msg, uint8_t component_ID = 0);
 
+	/**
+	 * Begin assembling a message payload in place.
+	 *
+	 * Returns a pointer to the payload area of the TX packet buffer so
+	 * high-rate streams can write their mavlink_*_t fields directly
+	 * into the packet instead of filling a local struct that
+	 * send_message would copy again.  Must be paired with
+	 * commit_message; returns NULL (and takes no lock) if the link
+	 * should not transmit.
+	 */
+	void			*begin_message();
+
+	/**
+	 * Finalize and send a message assembled with begin_message.
+	 *
+	 * Writes the header and checksum around the payload the caller
+	 * assembled in place and puts the packet on the wire, with the
+	 * same buffer-space and txerr accounting as send_message.
+	 */
+	void			commit_message(const uint8_t msgid, uint8_t component_ID = 0);
+
 	/**
 	 * Resend message as is, don't change sequence number and CRC.
 	 */
@@ -293,7 +337,6 @@ private:
 
 	unsigned		_main_loop_delay;	/**< mainloop delay, depends on data rate */
 
-	MavlinkOrbSubscription	*_subscriptions;
 	MavlinkStream		*_streams;
 
 	MavlinkMissionManager	*_mission_manager;
@@ -317,6 +360,8 @@ private:
 	int			_datarate;		///< data rate for normal streams (attitude, position, etc.)
 	int			_datarate_events;	///< data rate for params, waypoints, text messages
 	float			_rate_mult;
+	float			_radio_rate_mult;	/**< txerr-driven backoff factor applied on top of the bandwidth limit */
+	float			_load_shed_mult;	/**< CPU load governor backoff factor, see load_governor.h */
 
 	/**
 	 * If the queue index is not at 0, the queue sending
@@ -334,6 +379,29 @@ private:
 	uint64_t		_last_write_success_time;
 	uint64_t		_last_write_try_time;
 
+	/** packet buffer for messages assembled in place via begin_message/commit_message */
+	uint8_t			_tx_inplace_buf[MAVLINK_MAX_PACKET_LEN];
+
+	/**
+	 * Software TX ring between message generation and the UART. Complete
+	 * packets are appended here and drained into the (DMA-backed) serial
+	 * driver as fast as it will accept them, so stream generation never
+	 * stalls when the radio backpressures.
+	 */
+	static const unsigned	TX_RING_SIZE = 2048;
+	uint8_t			_tx_ring[TX_RING_SIZE];
+	unsigned		_tx_ring_start;	/**< index of the oldest pending byte */
+	unsigned		_tx_ring_len;	/**< number of pending bytes */
+
+	/*
+	 * On USB the ring is drained in multiples of the CDC bulk endpoint
+	 * size: a short packet terminates a USB transfer, so a partial tail
+	 * is held back briefly in the hope of filling the packet.
+	 */
+	static const unsigned	USB_BULK_EP_SIZE = 64;
+	static const uint64_t	USB_PARTIAL_HOLDOFF = 10000;	/**< max time a partial packet is held, us */
+	hrt_abstime		_tx_partial_since;	/**< time a partial tail became pending, 0 = none */
+
 	unsigned		_bytes_tx;
 	unsigned		_bytes_txerr;
 	unsigned		_bytes_rx;
@@ -266,6 +266,10 @@ public:
 		return true;
 	}
 
+	unsigned get_priority() {
+		return PRIO_CRITICAL;
+	}
+
 private:
 	MavlinkOrbSubscription *_status_sub;
 	MavlinkOrbSubscription *_pos_sp_triplet_sub;
@@ -336,6 +340,10 @@ public:
 		return mavlink_logbuffer_is_empty(_mavlink->get_logbuffer()) ? 0 : (MAVLINK_MSG_ID_STATUSTEXT_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES);
 	}
 
+	unsigned get_priority() {
+		return PRIO_CRITICAL;
+	}
+
 private:
 	/* do not allow top copying this class */
 	MavlinkStreamStatustext(MavlinkStreamStatustext &);
@@ -364,7 +372,17 @@ protected:
 				mavlink_statustext_t msg;
 
 				msg.severity = logmsg.severity;
-				strncpy(msg.text, logmsg.text, sizeof(msg.text));
+
+				if (logmsg.fmt != nullptr) {
+					/* deferred entry: the call site only stored the format
+					 * pointer and argument words, render the text here;
+					 * passing unused argument slots is harmless */
+					snprintf(msg.text, sizeof(msg.text), logmsg.fmt,
+						 logmsg.args[0], logmsg.args[1], logmsg.args[2], logmsg.args[3]);
+
+				} else {
+					strncpy(msg.text, logmsg.text, sizeof(msg.text));
+				}
 
 				_mavlink->send_message(MAVLINK_MSG_ID_STATUSTEXT, &msg);
 
@@ -439,6 +457,10 @@ public:
 		return 0;	// commands stream is not regular and not predictable
 	}
 
+	unsigned get_priority() {
+		return PRIO_CRITICAL;
+	}
+
 private:
 	MavlinkOrbSubscription *_cmd_sub;
 	uint64_t _cmd_time;
@@ -629,25 +651,30 @@ protected:
 				_baro_timestamp = sensor.baro_timestamp;
 			}
 
-			mavlink_highres_imu_t msg;
-
-			msg.time_usec = sensor.timestamp;
-			msg.xacc = sensor.accelerometer_m_s2[0];
-			msg.yacc = sensor.accelerometer_m_s2[1];
-			msg.zacc = sensor.accelerometer_m_s2[2];
-			msg.xgyro = sensor.gyro_rad_s[0];
-			msg.ygyro = sensor.gyro_rad_s[1];
-			msg.zgyro = sensor.gyro_rad_s[2];
-			msg.xmag = sensor.magnetometer_ga[0];
-			msg.ymag = sensor.magnetometer_ga[1];
-			msg.zmag = sensor.magnetometer_ga[2];
-			msg.abs_pressure = sensor.baro_pres_mbar;
-			msg.diff_pressure = sensor.differential_pressure_pa;
-			msg.pressure_alt = sensor.baro_alt_meter;
-			msg.temperature = sensor.baro_temp_celcius;
-			msg.fields_updated = fields_updated;
-
-			_mavlink->send_message(MAVLINK_MSG_ID_HIGHRES_IMU, &msg);
+			/* assemble the payload directly in the TX packet buffer */
+			mavlink_highres_imu_t *msg = (mavlink_highres_imu_t *)_mavlink->begin_message();
+
+			if (msg == nullptr) {
+				return;
+			}
+
+			msg->time_usec = sensor.timestamp;
+			msg->xacc = sensor.accelerometer_m_s2[0];
+			msg->yacc = sensor.accelerometer_m_s2[1];
+			msg->zacc = sensor.accelerometer_m_s2[2];
+			msg->xgyro = sensor.gyro_rad_s[0];
+			msg->ygyro = sensor.gyro_rad_s[1];
+			msg->zgyro = sensor.gyro_rad_s[2];
+			msg->xmag = sensor.magnetometer_ga[0];
+			msg->ymag = sensor.magnetometer_ga[1];
+			msg->zmag = sensor.magnetometer_ga[2];
+			msg->abs_pressure = sensor.baro_pres_mbar;
+			msg->diff_pressure = sensor.differential_pressure_pa;
+			msg->pressure_alt = sensor.baro_alt_meter;
+			msg->temperature = sensor.baro_temp_celcius;
+			msg->fields_updated = fields_updated;
+
+			_mavlink->commit_message(MAVLINK_MSG_ID_HIGHRES_IMU);
 		}
 	}
 };
@@ -701,17 +728,22 @@ protected:
 		struct vehicle_attitude_s att;
 
 		if (_att_sub->update(&_att_time, &att)) {
-			mavlink_attitude_t msg;
+			/* assemble the payload directly in the TX packet buffer */
+			mavlink_attitude_t *msg = (mavlink_attitude_t *)_mavlink->begin_message();
 
-			msg.time_boot_ms = att.timestamp / 1000;
-			msg.roll = att.roll;
-			msg.pitch = att.pitch;
-			msg.yaw = att.yaw;
-			msg.rollspeed = att.rollspeed;
-			msg.pitchspeed = att.pitchspeed;
-			msg.yawspeed = att.yawspeed;
+			if (msg == nullptr) {
+				return;
+			}
+
+			msg->time_boot_ms = att.timestamp / 1000;
+			msg->roll = att.roll;
+			msg->pitch = att.pitch;
+			msg->yaw = att.yaw;
+			msg->rollspeed = att.rollspeed;
+			msg->pitchspeed = att.pitchspeed;
+			msg->yawspeed = att.yawspeed;
 
-			_mavlink->send_message(MAVLINK_MSG_ID_ATTITUDE, &msg);
+			_mavlink->commit_message(MAVLINK_MSG_ID_ATTITUDE);
 		}
 	}
 };
@@ -1082,19 +1114,24 @@ protected:
 		updated |= _home_sub->update(&_home_time, &home);
 
 		if (updated) {
-			mavlink_global_position_int_t msg;
+			/* assemble the payload directly in the TX packet buffer */
+			mavlink_global_position_int_t *msg = (mavlink_global_position_int_t *)_mavlink->begin_message();
 
-			msg.time_boot_ms = pos.timestamp / 1000;
-			msg.lat = pos.lat * 1e7;
-			msg.lon = pos.lon * 1e7;
-			msg.alt = pos.alt * 1000.0f;
-			msg.relative_alt = (pos.alt - home.alt) * 1000.0f;
-			msg.vx = pos.vel_n * 100.0f;
-			msg.vy = pos.vel_e * 100.0f;
-			msg.vz = pos.vel_d * 100.0f;
-			msg.hdg = _wrap_2pi(pos.yaw) * M_RAD_TO_DEG_F * 100.0f;
-
-			_mavlink->send_message(MAVLINK_MSG_ID_GLOBAL_POSITION_INT, &msg);
+			if (msg == nullptr) {
+				return;
+			}
+
+			msg->time_boot_ms = pos.timestamp / 1000;
+			msg->lat = pos.lat * 1e7;
+			msg->lon = pos.lon * 1e7;
+			msg->alt = pos.alt * 1000.0f;
+			msg->relative_alt = (pos.alt - home.alt) * 1000.0f;
+			msg->vx = pos.vel_n * 100.0f;
+			msg->vy = pos.vel_e * 100.0f;
+			msg->vz = pos.vel_d * 100.0f;
+			msg->hdg = _wrap_2pi(pos.yaw) * M_RAD_TO_DEG_F * 100.0f;
+
+			_mavlink->commit_message(MAVLINK_MSG_ID_GLOBAL_POSITION_INT);
 		}
 	}
 };
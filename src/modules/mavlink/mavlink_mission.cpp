@@ -79,6 +79,7 @@ MavlinkMissionManager::MavlinkMissionManager(Mavlink *mavlink) : MavlinkStream(m
 	_transfer_current_seq(0),
 	_transfer_partner_sysid(0),
 	_transfer_partner_compid(0),
+	_transfer_in_transaction(false),
 	_offboard_mission_sub(-1),
 	_mission_result_sub(-1),
 	_offboard_mission_pub(-1),
@@ -327,6 +328,12 @@ MavlinkMissionManager::send(const hrt_abstime now)
 
 		_state = MAVLINK_WPM_STATE_IDLE;
 
+		/* settle whatever the aborted transfer already wrote */
+		if (_transfer_in_transaction) {
+			dm_transaction_commit();
+			_transfer_in_transaction = false;
+		}
+
 	} else if (_state == MAVLINK_WPM_STATE_GETLIST && hrt_elapsed_time(&_time_last_sent) > _retry_timeout) {
 		/* try to request item again after timeout */
 		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
@@ -594,6 +601,11 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			_transfer_dataman_id = _dataman_id == 0 ? 1 : 0;	// use inactive storage for transmission
 			_transfer_current_seq = -1;
 
+			/* batch the item writes of this upload into one commit */
+			if (dm_transaction_begin() == OK) {
+				_transfer_in_transaction = true;
+			}
+
 		} else if (_state == MAVLINK_WPM_STATE_GETLIST) {
 			_time_last_recv = hrt_absolute_time();
 
@@ -662,6 +674,12 @@ MavlinkMissionManager::handle_mission_item(const mavlink_message_t *msg)
 
 			send_mission_ack(_transfer_partner_sysid, _transfer_partner_compid, ret);
 			_state = MAVLINK_WPM_STATE_IDLE;
+
+			if (_transfer_in_transaction) {
+				dm_transaction_commit();
+				_transfer_in_transaction = false;
+			}
+
 			return;
 		}
 
@@ -673,6 +691,12 @@ MavlinkMissionManager::handle_mission_item(const mavlink_message_t *msg)
 			send_mission_ack(_transfer_partner_sysid, _transfer_partner_compid, MAV_MISSION_ERROR);
 			_mavlink->send_statustext_critical("Unable to write on micro SD");
 			_state = MAVLINK_WPM_STATE_IDLE;
+
+			if (_transfer_in_transaction) {
+				dm_transaction_commit();
+				_transfer_in_transaction = false;
+			}
+
 			return;
 		}
 
@@ -693,6 +717,12 @@ MavlinkMissionManager::handle_mission_item(const mavlink_message_t *msg)
 
 			_state = MAVLINK_WPM_STATE_IDLE;
 
+			/* commit the uploaded items before activating the mission */
+			if (_transfer_in_transaction) {
+				dm_transaction_commit();
+				_transfer_in_transaction = false;
+			}
+
 			if (update_active_mission(_transfer_dataman_id, _transfer_count, _transfer_current_seq) == OK) {
 				send_mission_ack(_transfer_partner_sysid, _transfer_partner_compid, MAV_MISSION_ACCEPTED);
 
@@ -93,6 +93,8 @@ public:
 
 	unsigned get_size();
 
+	unsigned get_priority() { return PRIO_BULK; }
+
 	void handle_message(const mavlink_message_t *msg);
 
 	void set_verbose(bool v) { _verbose = v; }
@@ -117,6 +119,7 @@ private:
 	unsigned		_transfer_current_seq;			///< Current item ID for current transmission (-1 means not initialized)
 	unsigned		_transfer_partner_sysid;		///< Partner system ID for current transmission
 	unsigned		_transfer_partner_compid;		///< Partner component ID for current transmission
+	bool			_transfer_in_transaction;		///< A dataman write transaction is open for the current transmission
 
 	int			_offboard_mission_sub;
 	int			_mission_result_sub;
@@ -52,13 +52,19 @@ MavlinkOrbSubscription::MavlinkOrbSubscription(const orb_id_t topic, int instanc
 	_topic(topic),
 	_instance(instance),
 	_fd(orb_subscribe_multi(_topic, instance)),
-	_published(false)
+	_published(false),
+	_cache((uint8_t *)calloc(1, topic->o_size)),
+	_cache_time(0),
+	_users(0)
 {
+	pthread_mutex_init(&_cache_mutex, NULL);
 }
 
 MavlinkOrbSubscription::~MavlinkOrbSubscription()
 {
 	close(_fd);
+	free(_cache);
+	pthread_mutex_destroy(&_cache_mutex);
 }
 
 orb_id_t
@@ -85,21 +91,33 @@ MavlinkOrbSubscription::update(uint64_t *time, void* data)
 		time_topic = 0;
 	}
 
-	if (orb_copy(_topic, _fd, data)) {
-		/* error copying topic data */
-		memset(data, 0, _topic->o_size);
-		return false;
+	pthread_mutex_lock(&_cache_mutex);
+
+	/* refresh the shared cache only once per publication, no matter
+	 * how many links poll this subscription */
+	if (!_published || time_topic != _cache_time) {
+		if (orb_copy(_topic, _fd, _cache)) {
+			/* error copying topic data */
+			pthread_mutex_unlock(&_cache_mutex);
+			memset(data, 0, _topic->o_size);
+			return false;
+		}
 
-	} else {
 		/* data copied successfully */
 		_published = true;
-		if (time_topic != *time) {
-			*time = time_topic;
-			return true;
+		_cache_time = time_topic;
+	}
 
-		} else {
-			return false;
-		}
+	memcpy(data, _cache, _topic->o_size);
+
+	pthread_mutex_unlock(&_cache_mutex);
+
+	if (time_topic != *time) {
+		*time = time_topic;
+		return true;
+
+	} else {
+		return false;
 	}
 }
 
@@ -41,6 +41,8 @@
 #ifndef MAVLINK_ORB_SUBSCRIPTION_H_
 #define MAVLINK_ORB_SUBSCRIPTION_H_
 
+#include <pthread.h>
+
 #include <systemlib/uthash/utlist.h>
 #include <drivers/drv_hrt.h>
 
@@ -79,12 +81,33 @@ public:
 	orb_id_t get_topic() const;
 	int get_instance() const;
 
+	/**
+	 * Mark the subscription as referenced by the given Mavlink instance.
+	 * Subscriptions live in one pool shared by all links.
+	 */
+	void mark_used(int instance_id) { _users |= (1u << instance_id); }
+
+	/**
+	 * Drop the given Mavlink instance's reference.
+	 */
+	void mark_unused(int instance_id) { _users &= ~(1u << instance_id); }
+
+	/**
+	 * @return true while at least one Mavlink instance references this subscription.
+	 */
+	bool in_use() const { return _users != 0; }
+
 private:
 	const orb_id_t _topic;		///< topic metadata
 	const int _instance;		///< get topic instance
 	int _fd;			///< subscription handle
 	bool _published;		///< topic was ever published
 
+	uint8_t *_cache;		///< last copied topic data, shared by all links
+	uint64_t _cache_time;		///< publication time of the cached data
+	pthread_mutex_t _cache_mutex;	///< protects the cache against concurrent link threads
+	unsigned _users;		///< bit mask of Mavlink instance ids referencing this subscription
+
 	/* do not allow copying this class */
 	MavlinkOrbSubscription(const MavlinkOrbSubscription&);
 	MavlinkOrbSubscription operator=(const MavlinkOrbSubscription&);
@@ -72,6 +72,8 @@ public:
 
 	unsigned get_size();
 
+	unsigned get_priority() { return PRIO_BULK; }
+
 	void handle_message(const mavlink_message_t *msg);
 
 	/**
@@ -125,97 +125,113 @@ MavlinkReceiver::MavlinkReceiver(Mavlink *parent) :
 	_control_mode_sub(orb_subscribe(ORB_ID(vehicle_control_mode))),
 	_hil_frames(0),
 	_old_timestamp(0),
+	_hil_gyro{},
+	_hil_accel{},
+	_hil_mag{},
+	_hil_baro{},
+	_hil_airspeed{},
+	_hil_sensors{},
+	_hil_battery_status{},
 	_hil_local_proj_inited(0),
 	_hil_local_alt0(0.0f),
 	_hil_local_proj_ref{},
 	_offboard_control_mode{},
+	_offb_pos_mode_valid(false),
+	_offb_pos_type_mask(0),
+	_offb_pos_is_force_sp(false),
+	_offb_pos_mode{},
+	_offb_pos_mode_pub_time(0),
 	_rates_sp{},
 	_time_offset_avg_alpha(0.6),
-	_time_offset(0)
+	_time_offset(0),
+	_handler_count(0)
 {
 
+	/* fields of the HIL reports that a sensor frame never changes */
+	_hil_sensors.accelerometer_mode = 0; // TODO what is this?
+	_hil_sensors.accelerometer_range_m_s2 = 32.7f; // int16
+	_hil_sensors.magnetometer_range_ga = 32.7f; // int16
+	_hil_sensors.magnetometer_mode = 0; // TODO what is this
+	_hil_sensors.magnetometer_cuttoff_freq_hz = 50.0f;
+
+	_hil_battery_status.voltage_v = 11.1f;
+	_hil_battery_status.voltage_filtered_v = 11.1f;
+	_hil_battery_status.current_a = 10.0f;
+	_hil_battery_status.discharged_mah = -1.0f;
+
 	// make sure the FTP server is started
 	(void)MavlinkFTP::get_server();
+
+	/* build the msgid-indexed dispatch table */
+	memset(_handler_index, 0, sizeof(_handler_index));
+
+	register_handler(MAVLINK_MSG_ID_COMMAND_LONG, &MavlinkReceiver::handle_message_command_long, "rcv_command_long");
+	register_handler(MAVLINK_MSG_ID_COMMAND_INT, &MavlinkReceiver::handle_message_command_int, "rcv_command_int");
+	register_handler(MAVLINK_MSG_ID_OPTICAL_FLOW_RAD, &MavlinkReceiver::handle_message_optical_flow_rad, "rcv_optical_flow_rad");
+	register_handler(MAVLINK_MSG_ID_PING, &MavlinkReceiver::handle_message_ping, "rcv_ping");
+	register_handler(MAVLINK_MSG_ID_SET_MODE, &MavlinkReceiver::handle_message_set_mode, "rcv_set_mode");
+	register_handler(MAVLINK_MSG_ID_VICON_POSITION_ESTIMATE, &MavlinkReceiver::handle_message_vicon_position_estimate,
+			 "rcv_vicon_position");
+	register_handler(MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED,
+			 &MavlinkReceiver::handle_message_set_position_target_local_ned, "rcv_pos_target_local");
+	register_handler(MAVLINK_MSG_ID_SET_ATTITUDE_TARGET, &MavlinkReceiver::handle_message_set_attitude_target,
+			 "rcv_att_target");
+	register_handler(MAVLINK_MSG_ID_SET_ACTUATOR_CONTROL_TARGET,
+			 &MavlinkReceiver::handle_message_set_actuator_control_target, "rcv_act_target");
+	register_handler(MAVLINK_MSG_ID_VISION_POSITION_ESTIMATE, &MavlinkReceiver::handle_message_vision_position_estimate,
+			 "rcv_vision_position");
+	register_handler(MAVLINK_MSG_ID_RADIO_STATUS, &MavlinkReceiver::handle_message_radio_status, "rcv_radio_status");
+	register_handler(MAVLINK_MSG_ID_MANUAL_CONTROL, &MavlinkReceiver::handle_message_manual_control, "rcv_manual_control");
+	register_handler(MAVLINK_MSG_ID_HEARTBEAT, &MavlinkReceiver::handle_message_heartbeat, "rcv_heartbeat");
+	register_handler(MAVLINK_MSG_ID_REQUEST_DATA_STREAM, &MavlinkReceiver::handle_message_request_data_stream,
+			 "rcv_request_stream");
+	register_handler(MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL, &MavlinkReceiver::handle_message_ftp, "rcv_ftp");
+	register_handler(MAVLINK_MSG_ID_SYSTEM_TIME, &MavlinkReceiver::handle_message_system_time, "rcv_system_time");
+	register_handler(MAVLINK_MSG_ID_TIMESYNC, &MavlinkReceiver::handle_message_timesync, "rcv_timesync");
 }
 
 MavlinkReceiver::~MavlinkReceiver()
 {
+	for (unsigned i = 0; i < _handler_count; i++) {
+		perf_free(_handlers[i].perf);
+	}
 }
 
 void
-MavlinkReceiver::handle_message(mavlink_message_t *msg)
+MavlinkReceiver::register_handler(uint8_t msgid, MessageHandlerFunc handler, const char *perf_name)
 {
-	switch (msg->msgid) {
-	case MAVLINK_MSG_ID_COMMAND_LONG:
-		handle_message_command_long(msg);
-		break;
-
-	case MAVLINK_MSG_ID_COMMAND_INT:
-		handle_message_command_int(msg);
-		break;
-
-	case MAVLINK_MSG_ID_OPTICAL_FLOW_RAD:
-		handle_message_optical_flow_rad(msg);
-		break;
-
-	case MAVLINK_MSG_ID_PING:
-		handle_message_ping(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_MODE:
-		handle_message_set_mode(msg);
-		break;
-
-	case MAVLINK_MSG_ID_VICON_POSITION_ESTIMATE:
-		handle_message_vicon_position_estimate(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED:
-		handle_message_set_position_target_local_ned(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_ATTITUDE_TARGET:
-		handle_message_set_attitude_target(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_ACTUATOR_CONTROL_TARGET:
-		handle_message_set_actuator_control_target(msg);
-		break;
-
-	case MAVLINK_MSG_ID_VISION_POSITION_ESTIMATE:
-		handle_message_vision_position_estimate(msg);
-		break;
-
-	case MAVLINK_MSG_ID_RADIO_STATUS:
-		handle_message_radio_status(msg);
-		break;
-
-	case MAVLINK_MSG_ID_MANUAL_CONTROL:
-		handle_message_manual_control(msg);
-		break;
-
-	case MAVLINK_MSG_ID_HEARTBEAT:
-		handle_message_heartbeat(msg);
-		break;
+	if (_handler_count >= MAX_MESSAGE_HANDLERS) {
+		return;
+	}
 
-	case MAVLINK_MSG_ID_REQUEST_DATA_STREAM:
-		handle_message_request_data_stream(msg);
-		break;
+	_handlers[_handler_count].handler = handler;
+	_handlers[_handler_count].perf = perf_alloc(PC_ELAPSED, perf_name);
+	_handler_index[msgid] = _handler_count + 1;
+	_handler_count++;
+}
 
-	case MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL:
-		MavlinkFTP::get_server()->handle_message(_mavlink, msg);
-		break;
+void
+MavlinkReceiver::handle_message_ftp(mavlink_message_t *msg)
+{
+	MavlinkFTP::get_server()->handle_message(_mavlink, msg);
+}
 
-	case MAVLINK_MSG_ID_SYSTEM_TIME:
-		handle_message_system_time(msg);
-		break;
+void
+MavlinkReceiver::handle_message(mavlink_message_t *msg)
+{
+	/*
+	 * Constant-time dispatch through the msgid-indexed table; the
+	 * per-handler elapsed-time counters show up in 'perf' so the cost
+	 * of each message type can be measured in the field.
+	 */
+	unsigned ix = _handler_index[msg->msgid];
 
-	case MAVLINK_MSG_ID_TIMESYNC:
-		handle_message_timesync(msg);
-		break;
+	if (ix != 0) {
+		MessageHandler &entry = _handlers[ix - 1];
 
-	default:
-		break;
+		perf_begin(entry.perf);
+		(this->*entry.handler)(msg);
+		perf_end(entry.perf);
 	}
 
 	/*
@@ -529,36 +545,38 @@ MavlinkReceiver::handle_message_set_position_target_local_ned(mavlink_message_t
 	mavlink_set_position_target_local_ned_t set_position_target_local_ned;
 	mavlink_msg_set_position_target_local_ned_decode(msg, &set_position_target_local_ned);
 
-	struct offboard_control_mode_s offboard_control_mode;
-	memset(&offboard_control_mode, 0, sizeof(offboard_control_mode));//XXX breaks compatibility with multiple setpoints
-
 	/* Only accept messages which are intended for this system */
 	if ((mavlink_system.sysid == set_position_target_local_ned.target_system ||
 				set_position_target_local_ned.target_system == 0) &&
 			(mavlink_system.compid == set_position_target_local_ned.target_component ||
 			 set_position_target_local_ned.target_component == 0)) {
 
-		/* convert mavlink type (local, NED) to uORB offboard control struct */
-		offboard_control_mode.ignore_position = (bool)(set_position_target_local_ned.type_mask & 0x7);
-		offboard_control_mode.ignore_velocity = (bool)(set_position_target_local_ned.type_mask & 0x38);
-		offboard_control_mode.ignore_acceleration_force = (bool)(set_position_target_local_ned.type_mask & 0x1C0);
-		bool is_force_sp = (bool)(set_position_target_local_ned.type_mask & (1 << 9));
-		/* yaw ignore flag mapps to ignore_attitude */
-		offboard_control_mode.ignore_attitude = (bool)(set_position_target_local_ned.type_mask & 0x400);
-		/* yawrate ignore flag mapps to ignore_bodyrate */
-		offboard_control_mode.ignore_bodyrate = (bool)(set_position_target_local_ned.type_mask & 0x800);
-
-		offboard_control_mode.timestamp = hrt_absolute_time();
-
-		if (_offboard_control_mode_pub < 0) {
-			_offboard_control_mode_pub = orb_advertise(ORB_ID(offboard_control_mode), &offboard_control_mode);
-
-		} else {
-			orb_publish(ORB_ID(offboard_control_mode), _offboard_control_mode_pub, &offboard_control_mode);
+		/* decode the type mask only when it changes, companions
+		 * stream the same mode with every setpoint */
+		if (!_offb_pos_mode_valid ||
+		    set_position_target_local_ned.type_mask != _offb_pos_type_mask) {
+			/* convert mavlink type (local, NED) to uORB offboard control struct */
+			_offb_pos_mode.ignore_position = (bool)(set_position_target_local_ned.type_mask & 0x7);
+			_offb_pos_mode.ignore_velocity = (bool)(set_position_target_local_ned.type_mask & 0x38);
+			_offb_pos_mode.ignore_acceleration_force = (bool)(set_position_target_local_ned.type_mask & 0x1C0);
+			_offb_pos_is_force_sp = (bool)(set_position_target_local_ned.type_mask & (1 << 9));
+			/* yaw ignore flag mapps to ignore_attitude */
+			_offb_pos_mode.ignore_attitude = (bool)(set_position_target_local_ned.type_mask & 0x400);
+			/* yawrate ignore flag mapps to ignore_bodyrate */
+			_offb_pos_mode.ignore_bodyrate = (bool)(set_position_target_local_ned.type_mask & 0x800);
+
+			_offb_pos_type_mask = set_position_target_local_ned.type_mask;
+			_offb_pos_mode_valid = true;
+
+			/* force a mode publication below */
+			_offb_pos_mode_pub_time = 0;
 		}
 
+		_offb_pos_mode.timestamp = hrt_absolute_time();
+
 		/* If we are in offboard control mode and offboard control loop through is enabled
-		 * also publish the setpoint topic which is read by the controller */
+		 * publish the setpoint topic which is read by the controller first,
+		 * this is the latency critical path */
 		if (_mavlink->get_forward_externalsp()) {
 			bool updated;
 			orb_check(_control_mode_sub, &updated);
@@ -566,8 +584,8 @@ MavlinkReceiver::handle_message_set_position_target_local_ned(mavlink_message_t
 				orb_copy(ORB_ID(vehicle_control_mode), _control_mode_sub, &_control_mode);
 			}
 			if (_control_mode.flag_control_offboard_enabled) {
-				if (is_force_sp && offboard_control_mode.ignore_position &&
-						offboard_control_mode.ignore_velocity) {
+				if (_offb_pos_is_force_sp && _offb_pos_mode.ignore_position &&
+						_offb_pos_mode.ignore_velocity) {
 					/* The offboard setpoint is a force setpoint only, directly writing to the force
 					 * setpoint topic and not publishing the setpoint triplet topic */
 					struct vehicle_force_setpoint_s	force_sp;
@@ -589,7 +607,7 @@ MavlinkReceiver::handle_message_set_position_target_local_ned(mavlink_message_t
 					pos_sp_triplet.current.type = position_setpoint_s::SETPOINT_TYPE_POSITION; //XXX support others
 
 					/* set the local pos values */
-					if (!offboard_control_mode.ignore_position) {
+					if (!_offb_pos_mode.ignore_position) {
 						pos_sp_triplet.current.position_valid = true;
 						pos_sp_triplet.current.x = set_position_target_local_ned.x;
 						pos_sp_triplet.current.y = set_position_target_local_ned.y;
@@ -599,7 +617,7 @@ MavlinkReceiver::handle_message_set_position_target_local_ned(mavlink_message_t
 					}
 
 					/* set the local vel values */
-					if (!offboard_control_mode.ignore_velocity) {
+					if (!_offb_pos_mode.ignore_velocity) {
 						pos_sp_triplet.current.velocity_valid = true;
 						pos_sp_triplet.current.vx = set_position_target_local_ned.vx;
 						pos_sp_triplet.current.vy = set_position_target_local_ned.vy;
@@ -610,20 +628,20 @@ MavlinkReceiver::handle_message_set_position_target_local_ned(mavlink_message_t
 
 					/* set the local acceleration values if the setpoint type is 'local pos' and none
 					 * of the accelerations fields is set to 'ignore' */
-					if (!offboard_control_mode.ignore_acceleration_force) {
+					if (!_offb_pos_mode.ignore_acceleration_force) {
 						pos_sp_triplet.current.acceleration_valid = true;
 						pos_sp_triplet.current.a_x = set_position_target_local_ned.afx;
 						pos_sp_triplet.current.a_y = set_position_target_local_ned.afy;
 						pos_sp_triplet.current.a_z = set_position_target_local_ned.afz;
 						pos_sp_triplet.current.acceleration_is_force =
-						is_force_sp;
+						_offb_pos_is_force_sp;
 
 					} else {
 						pos_sp_triplet.current.acceleration_valid = false;
 					}
 
 					/* set the yaw sp value */
-					if (!offboard_control_mode.ignore_attitude) {
+					if (!_offb_pos_mode.ignore_attitude) {
 						pos_sp_triplet.current.yaw_valid = true;
 						pos_sp_triplet.current.yaw = set_position_target_local_ned.yaw;
 
@@ -632,7 +650,7 @@ MavlinkReceiver::handle_message_set_position_target_local_ned(mavlink_message_t
 					}
 
 					/* set the yawrate sp value */
-					if (!offboard_control_mode.ignore_bodyrate) {
+					if (!_offb_pos_mode.ignore_bodyrate) {
 						pos_sp_triplet.current.yawspeed_valid = true;
 						pos_sp_triplet.current.yawspeed = set_position_target_local_ned.yaw_rate;
 
@@ -655,6 +673,20 @@ MavlinkReceiver::handle_message_set_position_target_local_ned(mavlink_message_t
 			}
 
 		}
+
+		/* the commander only needs the mode flags and a liveness
+		 * timestamp (OFFBOARD_TIMEOUT is 500 ms), republish on mode
+		 * change and at 5 Hz instead of once per setpoint */
+		if (hrt_elapsed_time(&_offb_pos_mode_pub_time) > 200000) {
+			if (_offboard_control_mode_pub < 0) {
+				_offboard_control_mode_pub = orb_advertise(ORB_ID(offboard_control_mode), &_offb_pos_mode);
+
+			} else {
+				orb_publish(ORB_ID(offboard_control_mode), _offboard_control_mode_pub, &_offb_pos_mode);
+			}
+
+			_offb_pos_mode_pub_time = _offb_pos_mode.timestamp;
+		}
 	}
 }
 
@@ -1062,183 +1094,151 @@ MavlinkReceiver::handle_message_hil_sensor(mavlink_message_t *msg)
 
 	uint64_t timestamp = hrt_absolute_time();
 
+	/*
+	 * Decode each field once into the preallocated combined report and
+	 * derive the individual sensor topics from it; no per-message zeroing
+	 * and no repeated unit conversions on the receive path.
+	 */
+	_hil_sensors.timestamp = timestamp;
+
+	_hil_sensors.gyro_raw[0] = imu.xgyro * 1000.0f;
+	_hil_sensors.gyro_raw[1] = imu.ygyro * 1000.0f;
+	_hil_sensors.gyro_raw[2] = imu.zgyro * 1000.0f;
+	_hil_sensors.gyro_rad_s[0] = imu.xgyro;
+	_hil_sensors.gyro_rad_s[1] = imu.ygyro;
+	_hil_sensors.gyro_rad_s[2] = imu.zgyro;
+
+	_hil_sensors.accelerometer_raw[0] = imu.xacc / mg2ms2;
+	_hil_sensors.accelerometer_raw[1] = imu.yacc / mg2ms2;
+	_hil_sensors.accelerometer_raw[2] = imu.zacc / mg2ms2;
+	_hil_sensors.accelerometer_m_s2[0] = imu.xacc;
+	_hil_sensors.accelerometer_m_s2[1] = imu.yacc;
+	_hil_sensors.accelerometer_m_s2[2] = imu.zacc;
+	_hil_sensors.accelerometer_timestamp = timestamp;
+
+	_hil_sensors.magnetometer_raw[0] = imu.xmag * 1000.0f;
+	_hil_sensors.magnetometer_raw[1] = imu.ymag * 1000.0f;
+	_hil_sensors.magnetometer_raw[2] = imu.zmag * 1000.0f;
+	_hil_sensors.magnetometer_ga[0] = imu.xmag;
+	_hil_sensors.magnetometer_ga[1] = imu.ymag;
+	_hil_sensors.magnetometer_ga[2] = imu.zmag;
+	_hil_sensors.magnetometer_timestamp = timestamp;
+
+	_hil_sensors.baro_pres_mbar = imu.abs_pressure;
+	_hil_sensors.baro_alt_meter = imu.pressure_alt;
+	_hil_sensors.baro_temp_celcius = imu.temperature;
+	_hil_sensors.baro_timestamp = timestamp;
+
+	_hil_sensors.differential_pressure_pa = imu.diff_pressure * 1e2f; //from hPa to Pa
+	_hil_sensors.differential_pressure_timestamp = timestamp;
+
 	/* airspeed */
 	{
-		struct airspeed_s airspeed;
-		memset(&airspeed, 0, sizeof(airspeed));
-
-		float ias = calc_indicated_airspeed(imu.diff_pressure * 1e2f);
+		float ias = calc_indicated_airspeed(_hil_sensors.differential_pressure_pa);
 		// XXX need to fix this
 		float tas = ias;
 
-		airspeed.timestamp = timestamp;
-		airspeed.indicated_airspeed_m_s = ias;
-		airspeed.true_airspeed_m_s = tas;
+		_hil_airspeed.timestamp = timestamp;
+		_hil_airspeed.indicated_airspeed_m_s = ias;
+		_hil_airspeed.true_airspeed_m_s = tas;
 
 		if (_airspeed_pub < 0) {
-			_airspeed_pub = orb_advertise(ORB_ID(airspeed), &airspeed);
+			_airspeed_pub = orb_advertise(ORB_ID(airspeed), &_hil_airspeed);
 
 		} else {
-			orb_publish(ORB_ID(airspeed), _airspeed_pub, &airspeed);
+			orb_publish(ORB_ID(airspeed), _airspeed_pub, &_hil_airspeed);
 		}
 	}
 
 	/* gyro */
 	{
-		struct gyro_report gyro;
-		memset(&gyro, 0, sizeof(gyro));
-
-		gyro.timestamp = timestamp;
-		gyro.x_raw = imu.xgyro * 1000.0f;
-		gyro.y_raw = imu.ygyro * 1000.0f;
-		gyro.z_raw = imu.zgyro * 1000.0f;
-		gyro.x = imu.xgyro;
-		gyro.y = imu.ygyro;
-		gyro.z = imu.zgyro;
-		gyro.temperature = imu.temperature;
+		_hil_gyro.timestamp = timestamp;
+		_hil_gyro.x_raw = _hil_sensors.gyro_raw[0];
+		_hil_gyro.y_raw = _hil_sensors.gyro_raw[1];
+		_hil_gyro.z_raw = _hil_sensors.gyro_raw[2];
+		_hil_gyro.x = _hil_sensors.gyro_rad_s[0];
+		_hil_gyro.y = _hil_sensors.gyro_rad_s[1];
+		_hil_gyro.z = _hil_sensors.gyro_rad_s[2];
+		_hil_gyro.temperature = imu.temperature;
 
 		if (_gyro_pub < 0) {
-			_gyro_pub = orb_advertise(ORB_ID(sensor_gyro), &gyro);
+			_gyro_pub = orb_advertise(ORB_ID(sensor_gyro), &_hil_gyro);
 
 		} else {
-			orb_publish(ORB_ID(sensor_gyro), _gyro_pub, &gyro);
+			orb_publish(ORB_ID(sensor_gyro), _gyro_pub, &_hil_gyro);
 		}
 	}
 
 	/* accelerometer */
 	{
-		struct accel_report accel;
-		memset(&accel, 0, sizeof(accel));
-
-		accel.timestamp = timestamp;
-		accel.x_raw = imu.xacc / mg2ms2;
-		accel.y_raw = imu.yacc / mg2ms2;
-		accel.z_raw = imu.zacc / mg2ms2;
-		accel.x = imu.xacc;
-		accel.y = imu.yacc;
-		accel.z = imu.zacc;
-		accel.temperature = imu.temperature;
+		_hil_accel.timestamp = timestamp;
+		_hil_accel.x_raw = _hil_sensors.accelerometer_raw[0];
+		_hil_accel.y_raw = _hil_sensors.accelerometer_raw[1];
+		_hil_accel.z_raw = _hil_sensors.accelerometer_raw[2];
+		_hil_accel.x = _hil_sensors.accelerometer_m_s2[0];
+		_hil_accel.y = _hil_sensors.accelerometer_m_s2[1];
+		_hil_accel.z = _hil_sensors.accelerometer_m_s2[2];
+		_hil_accel.temperature = imu.temperature;
 
 		if (_accel_pub < 0) {
-			_accel_pub = orb_advertise(ORB_ID(sensor_accel), &accel);
+			_accel_pub = orb_advertise(ORB_ID(sensor_accel), &_hil_accel);
 
 		} else {
-			orb_publish(ORB_ID(sensor_accel), _accel_pub, &accel);
+			orb_publish(ORB_ID(sensor_accel), _accel_pub, &_hil_accel);
 		}
 	}
 
 	/* magnetometer */
 	{
-		struct mag_report mag;
-		memset(&mag, 0, sizeof(mag));
-
-		mag.timestamp = timestamp;
-		mag.x_raw = imu.xmag * 1000.0f;
-		mag.y_raw = imu.ymag * 1000.0f;
-		mag.z_raw = imu.zmag * 1000.0f;
-		mag.x = imu.xmag;
-		mag.y = imu.ymag;
-		mag.z = imu.zmag;
+		_hil_mag.timestamp = timestamp;
+		_hil_mag.x_raw = _hil_sensors.magnetometer_raw[0];
+		_hil_mag.y_raw = _hil_sensors.magnetometer_raw[1];
+		_hil_mag.z_raw = _hil_sensors.magnetometer_raw[2];
+		_hil_mag.x = _hil_sensors.magnetometer_ga[0];
+		_hil_mag.y = _hil_sensors.magnetometer_ga[1];
+		_hil_mag.z = _hil_sensors.magnetometer_ga[2];
 
 		if (_mag_pub < 0) {
 			/* publish to the first mag topic */
-			_mag_pub = orb_advertise(ORB_ID(sensor_mag), &mag);
+			_mag_pub = orb_advertise(ORB_ID(sensor_mag), &_hil_mag);
 
 		} else {
-			orb_publish(ORB_ID(sensor_mag), _mag_pub, &mag);
+			orb_publish(ORB_ID(sensor_mag), _mag_pub, &_hil_mag);
 		}
 	}
 
 	/* baro */
 	{
-		struct baro_report baro;
-		memset(&baro, 0, sizeof(baro));
-
-		baro.timestamp = timestamp;
-		baro.pressure = imu.abs_pressure;
-		baro.altitude = imu.pressure_alt;
-		baro.temperature = imu.temperature;
+		_hil_baro.timestamp = timestamp;
+		_hil_baro.pressure = _hil_sensors.baro_pres_mbar;
+		_hil_baro.altitude = _hil_sensors.baro_alt_meter;
+		_hil_baro.temperature = _hil_sensors.baro_temp_celcius;
 
 		if (_baro_pub < 0) {
-			_baro_pub = orb_advertise(ORB_ID(sensor_baro), &baro);
+			_baro_pub = orb_advertise(ORB_ID(sensor_baro), &_hil_baro);
 
 		} else {
-			orb_publish(ORB_ID(sensor_baro), _baro_pub, &baro);
+			orb_publish(ORB_ID(sensor_baro), _baro_pub, &_hil_baro);
 		}
 	}
 
-	/* sensor combined */
-	{
-		struct sensor_combined_s hil_sensors;
-		memset(&hil_sensors, 0, sizeof(hil_sensors));
-
-		hil_sensors.timestamp = timestamp;
-
-		hil_sensors.gyro_raw[0] = imu.xgyro * 1000.0f;
-		hil_sensors.gyro_raw[1] = imu.ygyro * 1000.0f;
-		hil_sensors.gyro_raw[2] = imu.zgyro * 1000.0f;
-		hil_sensors.gyro_rad_s[0] = imu.xgyro;
-		hil_sensors.gyro_rad_s[1] = imu.ygyro;
-		hil_sensors.gyro_rad_s[2] = imu.zgyro;
-
-		hil_sensors.accelerometer_raw[0] = imu.xacc / mg2ms2;
-		hil_sensors.accelerometer_raw[1] = imu.yacc / mg2ms2;
-		hil_sensors.accelerometer_raw[2] = imu.zacc / mg2ms2;
-		hil_sensors.accelerometer_m_s2[0] = imu.xacc;
-		hil_sensors.accelerometer_m_s2[1] = imu.yacc;
-		hil_sensors.accelerometer_m_s2[2] = imu.zacc;
-		hil_sensors.accelerometer_mode = 0; // TODO what is this?
-		hil_sensors.accelerometer_range_m_s2 = 32.7f; // int16
-		hil_sensors.accelerometer_timestamp = timestamp;
-
-		hil_sensors.adc_voltage_v[0] = 0.0f;
-		hil_sensors.adc_voltage_v[1] = 0.0f;
-		hil_sensors.adc_voltage_v[2] = 0.0f;
-
-		hil_sensors.magnetometer_raw[0] = imu.xmag * 1000.0f;
-		hil_sensors.magnetometer_raw[1] = imu.ymag * 1000.0f;
-		hil_sensors.magnetometer_raw[2] = imu.zmag * 1000.0f;
-		hil_sensors.magnetometer_ga[0] = imu.xmag;
-		hil_sensors.magnetometer_ga[1] = imu.ymag;
-		hil_sensors.magnetometer_ga[2] = imu.zmag;
-		hil_sensors.magnetometer_range_ga = 32.7f; // int16
-		hil_sensors.magnetometer_mode = 0; // TODO what is this
-		hil_sensors.magnetometer_cuttoff_freq_hz = 50.0f;
-		hil_sensors.magnetometer_timestamp = timestamp;
-
-		hil_sensors.baro_pres_mbar = imu.abs_pressure;
-		hil_sensors.baro_alt_meter = imu.pressure_alt;
-		hil_sensors.baro_temp_celcius = imu.temperature;
-		hil_sensors.baro_timestamp = timestamp;
-
-		hil_sensors.differential_pressure_pa = imu.diff_pressure * 1e2f; //from hPa to Pa
-		hil_sensors.differential_pressure_timestamp = timestamp;
-
-		/* publish combined sensor topic */
-		if (_sensors_pub < 0) {
-			_sensors_pub = orb_advertise(ORB_ID(sensor_combined), &hil_sensors);
+	/* publish combined sensor topic */
+	if (_sensors_pub < 0) {
+		_sensors_pub = orb_advertise(ORB_ID(sensor_combined), &_hil_sensors);
 
-		} else {
-			orb_publish(ORB_ID(sensor_combined), _sensors_pub, &hil_sensors);
-		}
+	} else {
+		orb_publish(ORB_ID(sensor_combined), _sensors_pub, &_hil_sensors);
 	}
 
-	/* battery status */
+	/* battery status; only the timestamp changes, the values are canned */
 	{
-		struct battery_status_s hil_battery_status;
-		memset(&hil_battery_status, 0, sizeof(hil_battery_status));
-
-		hil_battery_status.timestamp = timestamp;
-		hil_battery_status.voltage_v = 11.1f;
-		hil_battery_status.voltage_filtered_v = 11.1f;
-		hil_battery_status.current_a = 10.0f;
-		hil_battery_status.discharged_mah = -1.0f;
+		_hil_battery_status.timestamp = timestamp;
 
 		if (_battery_pub < 0) {
-			_battery_pub = orb_advertise(ORB_ID(battery_status), &hil_battery_status);
+			_battery_pub = orb_advertise(ORB_ID(battery_status), &_hil_battery_status);
 
 		} else {
-			orb_publish(ORB_ID(battery_status), _battery_pub, &hil_battery_status);
+			orb_publish(ORB_ID(battery_status), _battery_pub, &_hil_battery_status);
 		}
 	}
 
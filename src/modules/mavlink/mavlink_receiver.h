@@ -42,6 +42,10 @@
 #pragma once
 
 #include <systemlib/perf_counter.h>
+#include <drivers/drv_accel.h>
+#include <drivers/drv_gyro.h>
+#include <drivers/drv_mag.h>
+#include <drivers/drv_baro.h>
 #include <uORB/uORB.h>
 #include <uORB/topics/sensor_combined.h>
 #include <uORB/topics/rc_channels.h>
@@ -74,6 +78,7 @@
 #include <uORB/topics/battery_status.h>
 #include <uORB/topics/vehicle_force_setpoint.h>
 #include <uORB/topics/time_offset.h>
+#include <drivers/drv_hrt.h>
 
 #include "mavlink_ftp.h"
 
@@ -135,6 +140,28 @@ private:
 	void handle_message_hil_sensor(mavlink_message_t *msg);
 	void handle_message_hil_gps(mavlink_message_t *msg);
 	void handle_message_hil_state_quaternion(mavlink_message_t *msg);
+	void handle_message_ftp(mavlink_message_t *msg);
+
+	/** member function type of the per-msgid handlers above */
+	typedef void (MavlinkReceiver::*MessageHandlerFunc)(mavlink_message_t *msg);
+
+	/** dispatch table entry: handler plus its elapsed-time perf counter */
+	struct MessageHandler {
+		MessageHandlerFunc handler;
+		perf_counter_t perf;
+	};
+
+	static const unsigned MAX_MESSAGE_HANDLERS = 20;
+
+	/**
+	 * Register a handler for a message ID in the dispatch table;
+	 * called from the constructor only.
+	 */
+	void register_handler(uint8_t msgid, MessageHandlerFunc handler, const char *perf_name);
+
+	MessageHandler	_handlers[MAX_MESSAGE_HANDLERS];
+	unsigned	_handler_count;
+	uint8_t		_handler_index[256];	/**< msgid -> handler slot + 1, 0 = unhandled */
 
 	void *receive_thread(void *arg);
 
@@ -183,10 +210,32 @@ private:
 	int _control_mode_sub;
 	int _hil_frames;
 	uint64_t _old_timestamp;
+	/* preallocated HIL sensor reports; constant fields are filled in once
+	 * by the constructor, the receive path only updates what each frame
+	 * changes (see handle_message_hil_sensor) */
+	struct gyro_report _hil_gyro;
+	struct accel_report _hil_accel;
+	struct mag_report _hil_mag;
+	struct baro_report _hil_baro;
+	struct airspeed_s _hil_airspeed;
+	struct sensor_combined_s _hil_sensors;
+	struct battery_status_s _hil_battery_status;
 	bool _hil_local_proj_inited;
 	float _hil_local_alt0;
 	struct map_projection_reference_s _hil_local_proj_ref;
 	struct offboard_control_mode_s _offboard_control_mode;
+
+	/* precomputed gate for the offboard setpoint fast path: the type
+	 * mask is decoded only when it changes and the mode topic is
+	 * republished at reduced rate, so a high rate setpoint stream
+	 * goes straight to the controller topic
+	 * (see handle_message_set_position_target_local_ned) */
+	bool _offb_pos_mode_valid;		/**< _offb_pos_mode matches _offb_pos_type_mask */
+	uint16_t _offb_pos_type_mask;		/**< last decoded type mask */
+	bool _offb_pos_is_force_sp;		/**< force setpoint flag from the type mask */
+	struct offboard_control_mode_s _offb_pos_mode;	/**< mode decoded from the type mask */
+	hrt_abstime _offb_pos_mode_pub_time;	/**< last offboard_control_mode publication */
+
 	struct vehicle_rates_setpoint_s _rates_sp;
 	double _time_offset_avg_alpha;
 	uint64_t _time_offset;
@@ -39,6 +39,7 @@
  */
 
 #include <stdlib.h>
+#include <stdio.h>
 
 #include "mavlink_stream.h"
 #include "mavlink_main.h"
@@ -47,7 +48,11 @@ MavlinkStream::MavlinkStream(Mavlink *mavlink) :
 	next(nullptr),
 	_mavlink(mavlink),
 	_interval(1000000),
-	_last_sent(0)
+	_last_sent(0),
+	_sent_count(0),
+	_sent_bytes(0),
+	_skip_count(0),
+	_stats_reset_time(0)
 {
 }
 
@@ -70,17 +75,13 @@ MavlinkStream::set_interval(const unsigned int interval)
 int
 MavlinkStream::update(const hrt_abstime t)
 {
-	uint64_t dt = t - _last_sent;
-	unsigned int interval = _interval;
-
-	if (!const_rate()) {
-		interval /= _mavlink->get_rate_mult();
-	}
-
-	if (dt > 0 && dt >= interval) {
+	if (interval_expired(t)) {
 		/* interval expired, send message */
 		send(t);
 
+		_sent_count++;
+		_sent_bytes += get_size();
+
 		if (const_rate()) {
 			_last_sent = (t / _interval) * _interval;
 
@@ -93,3 +94,44 @@ MavlinkStream::update(const hrt_abstime t)
 
 	return -1;
 }
+
+/**
+ * Check if the (rate-adjusted) interval has expired
+ */
+bool
+MavlinkStream::interval_expired(const hrt_abstime t)
+{
+	uint64_t dt = t - _last_sent;
+	unsigned int interval = _interval;
+
+	if (!const_rate()) {
+		interval /= _mavlink->get_rate_mult();
+	}
+
+	return (dt > 0 && dt >= interval);
+}
+
+/**
+ * Print send statistics and restart the measurement window
+ */
+void
+MavlinkStream::print_stats()
+{
+	hrt_abstime now = hrt_absolute_time();
+	float dt = (now - _stats_reset_time) / 1e6f;
+
+	float rate = 0.0f;
+	float kbps = 0.0f;
+
+	if (_stats_reset_time > 0 && dt > 0.0f) {
+		rate = _sent_count / dt;
+		kbps = _sent_bytes / dt / 1000.0f;
+	}
+
+	printf("\t%-26s %7.1f %8.3f %8u %9u\n", get_name(), (double)rate, (double)kbps, _skip_count, _interval);
+
+	_sent_count = 0;
+	_sent_bytes = 0;
+	_skip_count = 0;
+	_stats_reset_time = now;
+}
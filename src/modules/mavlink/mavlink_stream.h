@@ -50,6 +50,19 @@ class MavlinkStream
 {
 
 public:
+	/**
+	 * Scheduling priority classes, evaluated high to low against the
+	 * per-cycle byte budget.  Critical streams (heartbeat, command
+	 * traffic) are never deferred; bulk streams (parameters, mission)
+	 * are the first to wait when the budget is exhausted.
+	 */
+	enum {
+		PRIO_CRITICAL = 0,
+		PRIO_NORMAL = 1,
+		PRIO_BULK = 2,
+		PRIO_CLASS_COUNT = 3
+	};
+
 	MavlinkStream *next;
 
 	MavlinkStream(Mavlink *mavlink);
@@ -73,6 +86,21 @@ public:
 	 * @return 0 if updated / sent, -1 if unchanged
 	 */
 	int update(const hrt_abstime t);
+
+	/**
+	 * @return true if the configured interval has expired at time t
+	 */
+	bool interval_expired(const hrt_abstime t);
+
+	/**
+	 * Count an expired interval the scheduler could not afford to service
+	 */
+	void count_skip() { _skip_count++; }
+
+	/**
+	 * Print one line of send statistics and restart the measurement window
+	 */
+	void print_stats();
 	static MavlinkStream *new_instance(const Mavlink *mavlink);
 	static const char *get_name_static();
 	virtual const char *get_name() const = 0;
@@ -83,6 +111,11 @@ public:
 	 */
 	virtual bool const_rate() { return false; }
 
+	/**
+	 * @return the scheduling priority class of the stream
+	 */
+	virtual unsigned get_priority() { return PRIO_NORMAL; }
+
 	/**
 	 * Get maximal total messages size on update
 	 */
@@ -97,6 +130,12 @@ protected:
 private:
 	hrt_abstime _last_sent;
 
+	/* send statistics, reset by print_stats() */
+	unsigned	_sent_count;	/**< messages sent since last report */
+	unsigned	_sent_bytes;	/**< nominal bytes sent since last report */
+	unsigned	_skip_count;	/**< expired intervals deferred by the scheduler */
+	hrt_abstime	_stats_reset_time;	/**< start of the current measurement window */
+
 	/* do not allow top copying this class */
 	MavlinkStream(const MavlinkStream &);
 	MavlinkStream &operator=(const MavlinkStream &);
@@ -79,9 +79,12 @@
 #include <uORB/topics/parameter_update.h>
 #include <uORB/topics/multirotor_motor_limits.h>
 #include <uORB/topics/mc_att_ctrl_status.h>
+#include <uORB/topics/sensor_combined.h>
 #include <systemlib/param/param.h>
 #include <systemlib/err.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/rate_loop.h>
+#include <systemlib/watchdog.h>
 #include <systemlib/systemlib.h>
 #include <systemlib/circuit_breaker.h>
 #include <lib/mathlib/mathlib.h>
@@ -132,6 +135,7 @@ private:
 	int		_armed_sub;				/**< arming status subscription */
 	int		_vehicle_status_sub;	/**< vehicle status subscription */
 	int 	_motor_limits_sub;		/**< motor limits subscription */
+	int		_sensor_combined_sub;	/**< sensor data subscription, rate loop wakeup source */
 
 	orb_advert_t	_att_sp_pub;			/**< attitude setpoint publication */
 	orb_advert_t	_v_rates_sp_pub;		/**< rate setpoint publication */
@@ -153,8 +157,10 @@ private:
 	struct vehicle_status_s				_vehicle_status;	/**< vehicle status */
 	struct multirotor_motor_limits_s	_motor_limits;		/**< motor limits */
 	struct mc_att_ctrl_status_s 		_controller_status; /**< controller status */
+	struct sensor_combined_s			_sensor_combined;	/**< sensor data */
 
-	perf_counter_t	_loop_perf;			/**< loop performance counter */
+	struct rate_loop_s	_rate_loop;		/**< loop timing and deadline accounting */
+	struct watchdog_client_s	_wdog;	/**< hardware watchdog supervision */
 	perf_counter_t	_controller_latency_perf;
 
 	math::Vector<3>		_rates_prev;	/**< angular rates on previous step */
@@ -308,6 +314,7 @@ MulticopterAttitudeControl::MulticopterAttitudeControl() :
 	_manual_control_sp_sub(-1),
 	_armed_sub(-1),
 	_vehicle_status_sub(-1),
+	_sensor_combined_sub(-1),
 
 /* publications */
 	_att_sp_pub(-1),
@@ -320,10 +327,12 @@ MulticopterAttitudeControl::MulticopterAttitudeControl() :
 	_actuators_0_circuit_breaker_enabled(false),
 
 /* performance counters */
-	_loop_perf(perf_alloc(PC_ELAPSED, "mc_att_control")),
 	_controller_latency_perf(perf_alloc_once(PC_ELAPSED, "ctrl_latency"))
 
 {
+	/* rate loop driven by gyro data at the full sensor rate */
+	rate_loop_init(&_rate_loop, "mc_att_control", 250, 0.0002f, 0.02f);
+
 	memset(&_v_att, 0, sizeof(_v_att));
 	memset(&_v_att_sp, 0, sizeof(_v_att_sp));
 	memset(&_v_rates_sp, 0, sizeof(_v_rates_sp));
@@ -334,6 +343,7 @@ MulticopterAttitudeControl::MulticopterAttitudeControl() :
 	memset(&_vehicle_status, 0, sizeof(_vehicle_status));
 	memset(&_motor_limits, 0, sizeof(_motor_limits));
 	memset(&_controller_status,0,sizeof(_controller_status));
+	memset(&_sensor_combined, 0, sizeof(_sensor_combined));
 	_vehicle_status.is_rotary_wing = true;
 
 	_params.att_p.zero();
@@ -359,31 +369,31 @@ MulticopterAttitudeControl::MulticopterAttitudeControl() :
 
 	_I.identity();
 
-	_params_handles.roll_p			= 	param_find("MC_ROLL_P");
-	_params_handles.roll_rate_p		= 	param_find("MC_ROLLRATE_P");
-	_params_handles.roll_rate_i		= 	param_find("MC_ROLLRATE_I");
-	_params_handles.roll_rate_d		= 	param_find("MC_ROLLRATE_D");
-	_params_handles.roll_rate_ff	= 	param_find("MC_ROLLRATE_FF");
-	_params_handles.pitch_p			= 	param_find("MC_PITCH_P");
-	_params_handles.pitch_rate_p	= 	param_find("MC_PITCHRATE_P");
-	_params_handles.pitch_rate_i	= 	param_find("MC_PITCHRATE_I");
-	_params_handles.pitch_rate_d	= 	param_find("MC_PITCHRATE_D");
-	_params_handles.pitch_rate_ff 	= 	param_find("MC_PITCHRATE_FF");
-	_params_handles.yaw_p			=	param_find("MC_YAW_P");
-	_params_handles.yaw_rate_p		= 	param_find("MC_YAWRATE_P");
-	_params_handles.yaw_rate_i		= 	param_find("MC_YAWRATE_I");
-	_params_handles.yaw_rate_d		= 	param_find("MC_YAWRATE_D");
-	_params_handles.yaw_rate_ff	 	= 	param_find("MC_YAWRATE_FF");
-	_params_handles.yaw_ff			= 	param_find("MC_YAW_FF");
-	_params_handles.roll_rate_max	= 	param_find("MC_ROLLRATE_MAX");
-	_params_handles.pitch_rate_max	= 	param_find("MC_PITCHRATE_MAX");
-	_params_handles.yaw_rate_max	= 	param_find("MC_YAWRATE_MAX");
-	_params_handles.man_roll_max	= 	param_find("MC_MAN_R_MAX");
-	_params_handles.man_pitch_max	= 	param_find("MC_MAN_P_MAX");
-	_params_handles.man_yaw_max		= 	param_find("MC_MAN_Y_MAX");
-	_params_handles.acro_roll_max	= 	param_find("MC_ACRO_R_MAX");
-	_params_handles.acro_pitch_max	= 	param_find("MC_ACRO_P_MAX");
-	_params_handles.acro_yaw_max		= 	param_find("MC_ACRO_Y_MAX");
+	_params_handles.roll_p			= 	PARAM_HANDLE(MC_ROLL_P);
+	_params_handles.roll_rate_p		= 	PARAM_HANDLE(MC_ROLLRATE_P);
+	_params_handles.roll_rate_i		= 	PARAM_HANDLE(MC_ROLLRATE_I);
+	_params_handles.roll_rate_d		= 	PARAM_HANDLE(MC_ROLLRATE_D);
+	_params_handles.roll_rate_ff	= 	PARAM_HANDLE(MC_ROLLRATE_FF);
+	_params_handles.pitch_p			= 	PARAM_HANDLE(MC_PITCH_P);
+	_params_handles.pitch_rate_p	= 	PARAM_HANDLE(MC_PITCHRATE_P);
+	_params_handles.pitch_rate_i	= 	PARAM_HANDLE(MC_PITCHRATE_I);
+	_params_handles.pitch_rate_d	= 	PARAM_HANDLE(MC_PITCHRATE_D);
+	_params_handles.pitch_rate_ff 	= 	PARAM_HANDLE(MC_PITCHRATE_FF);
+	_params_handles.yaw_p			=	PARAM_HANDLE(MC_YAW_P);
+	_params_handles.yaw_rate_p		= 	PARAM_HANDLE(MC_YAWRATE_P);
+	_params_handles.yaw_rate_i		= 	PARAM_HANDLE(MC_YAWRATE_I);
+	_params_handles.yaw_rate_d		= 	PARAM_HANDLE(MC_YAWRATE_D);
+	_params_handles.yaw_rate_ff	 	= 	PARAM_HANDLE(MC_YAWRATE_FF);
+	_params_handles.yaw_ff			= 	PARAM_HANDLE(MC_YAW_FF);
+	_params_handles.roll_rate_max	= 	PARAM_HANDLE(MC_ROLLRATE_MAX);
+	_params_handles.pitch_rate_max	= 	PARAM_HANDLE(MC_PITCHRATE_MAX);
+	_params_handles.yaw_rate_max	= 	PARAM_HANDLE(MC_YAWRATE_MAX);
+	_params_handles.man_roll_max	= 	PARAM_HANDLE(MC_MAN_R_MAX);
+	_params_handles.man_pitch_max	= 	PARAM_HANDLE(MC_MAN_P_MAX);
+	_params_handles.man_yaw_max		= 	PARAM_HANDLE(MC_MAN_Y_MAX);
+	_params_handles.acro_roll_max	= 	PARAM_HANDLE(MC_ACRO_R_MAX);
+	_params_handles.acro_pitch_max	= 	PARAM_HANDLE(MC_ACRO_P_MAX);
+	_params_handles.acro_yaw_max		= 	PARAM_HANDLE(MC_ACRO_Y_MAX);
 
 	/* fetch initial parameter values */
 	parameters_update();
@@ -623,7 +633,7 @@ MulticopterAttitudeControl::control_attitude(float dt)
 	math::Vector<3> R_sp_z(R_sp(0, 2), R_sp(1, 2), R_sp(2, 2));
 
 	/* axis and sin(angle) of desired rotation */
-	math::Vector<3> e_R = R.transposed() * (R_z % R_sp_z);
+	math::Vector<3> e_R = R.transposed_mult(R_z % R_sp_z);
 
 	/* calculate angle error */
 	float e_R_z_sin = e_R.length();
@@ -669,7 +679,7 @@ MulticopterAttitudeControl::control_attitude(float dt)
 		/* for large thrust vector rotations use another rotation method:
 		 * calculate angle and axis for R -> R_sp rotation directly */
 		math::Quaternion q;
-		q.from_dcm(R.transposed() * R_sp);
+		q.from_dcm(R.transposed_mult(R_sp));
 		math::Vector<3> e_R_d = q.imag();
 		e_R_d.normalize();
 		e_R_d *= 2.0f * atan2f(e_R_d.length(), q(0));
@@ -704,11 +714,12 @@ MulticopterAttitudeControl::control_attitude_rates(float dt)
 		_rates_int.zero();
 	}
 
-	/* current body angular rates */
+	/* current body angular rates, taken directly from the gyro so the rate
+	 * loop does not wait on the attitude estimator */
 	math::Vector<3> rates;
-	rates(0) = _v_att.rollspeed;
-	rates(1) = _v_att.pitchspeed;
-	rates(2) = _v_att.yawspeed;
+	rates(0) = _sensor_combined.gyro_rad_s[0];
+	rates(1) = _sensor_combined.gyro_rad_s[1];
+	rates(2) = _sensor_combined.gyro_rad_s[2];
 
 	/* angular rates error */
 	math::Vector<3> rates_err = _rates_sp - rates;
@@ -752,20 +763,27 @@ MulticopterAttitudeControl::task_main()
 	_armed_sub = orb_subscribe(ORB_ID(actuator_armed));
 	_vehicle_status_sub = orb_subscribe(ORB_ID(vehicle_status));
 	_motor_limits_sub = orb_subscribe(ORB_ID(multirotor_motor_limits));
+	_sensor_combined_sub = orb_subscribe(ORB_ID(sensor_combined));
 
 	/* initialize parameters cache */
 	parameters_update();
 
-	/* wakeup source: vehicle attitude */
+	/* check in with the hardware watchdog once per cycle */
+	watchdog_register(&_wdog, "mc_att_control", 500);
+
+	/* wakeup source: gyro data from sensor combined, so the rate loop runs
+	 * at the full sensor rate without waiting for the attitude estimator */
 	struct pollfd fds[1];
 
-	fds[0].fd = _v_att_sub;
+	fds[0].fd = _sensor_combined_sub;
 	fds[0].events = POLLIN;
 
 	while (!_task_should_exit) {
 
-		/* wait for up to 100ms for data */
-		int pret = poll(&fds[0], (sizeof(fds) / sizeof(fds[0])), 100);
+		/* wait for data or the next deadline */
+		int pret = rate_loop_poll(&_rate_loop, &fds[0], (sizeof(fds) / sizeof(fds[0])));
+
+		watchdog_checkin(&_wdog);
 
 		/* timed out - periodic check for _task_should_exit */
 		if (pret == 0)
@@ -779,24 +797,21 @@ MulticopterAttitudeControl::task_main()
 			continue;
 		}
 
-		perf_begin(_loop_perf);
-
-		/* run controller on attitude changes */
+		/* run the rate loop on gyro changes */
 		if (fds[0].revents & POLLIN) {
-			static uint64_t last_run = 0;
-			float dt = (hrt_absolute_time() - last_run) / 1000000.0f;
-			last_run = hrt_absolute_time();
+			/* dt is guarded against too small (< 0.2ms) and too large (> 20ms) values */
+			float dt = rate_loop_begin(&_rate_loop);
 
-			/* guard against too small (< 2ms) and too large (> 20ms) dt's */
-			if (dt < 0.002f) {
-				dt = 0.002f;
+			/* copy gyro data */
+			orb_copy(ORB_ID(sensor_combined), _sensor_combined_sub, &_sensor_combined);
 
-			} else if (dt > 0.02f) {
-				dt = 0.02f;
-			}
+			/* the attitude controller only needs to run on estimator updates */
+			bool att_updated;
+			orb_check(_v_att_sub, &att_updated);
 
-			/* copy attitude topic */
-			orb_copy(ORB_ID(vehicle_attitude), _v_att_sub, &_v_att);
+			if (att_updated) {
+				orb_copy(ORB_ID(vehicle_attitude), _v_att_sub, &_v_att);
+			}
 
 			/* check for updates in other topics */
 			parameter_update_poll();
@@ -807,20 +822,22 @@ MulticopterAttitudeControl::task_main()
 			vehicle_motor_limits_poll();
 
 			if (_v_control_mode.flag_control_attitude_enabled) {
-				control_attitude(dt);
+				if (att_updated) {
+					control_attitude(dt);
 
-				/* publish attitude rates setpoint */
-				_v_rates_sp.roll = _rates_sp(0);
-				_v_rates_sp.pitch = _rates_sp(1);
-				_v_rates_sp.yaw = _rates_sp(2);
-				_v_rates_sp.thrust = _thrust_sp;
-				_v_rates_sp.timestamp = hrt_absolute_time();
+					/* publish attitude rates setpoint */
+					_v_rates_sp.roll = _rates_sp(0);
+					_v_rates_sp.pitch = _rates_sp(1);
+					_v_rates_sp.yaw = _rates_sp(2);
+					_v_rates_sp.thrust = _thrust_sp;
+					_v_rates_sp.timestamp = hrt_absolute_time();
 
-				if (_v_rates_sp_pub > 0) {
-					orb_publish(_rates_sp_id, _v_rates_sp_pub, &_v_rates_sp);
+					if (_v_rates_sp_pub > 0) {
+						orb_publish(_rates_sp_id, _v_rates_sp_pub, &_v_rates_sp);
 
-				} else if (_rates_sp_id) {
-					_v_rates_sp_pub = orb_advertise(_rates_sp_id, &_v_rates_sp);
+					} else if (_rates_sp_id) {
+						_v_rates_sp_pub = orb_advertise(_rates_sp_id, &_v_rates_sp);
+					}
 				}
 
 			} else {
@@ -863,7 +880,7 @@ MulticopterAttitudeControl::task_main()
 				_actuators.control[2] = (isfinite(_att_control(2))) ? _att_control(2) : 0.0f;
 				_actuators.control[3] = (isfinite(_thrust_sp)) ? _thrust_sp : 0.0f;
 				_actuators.timestamp = hrt_absolute_time();
-				_actuators.timestamp_sample = _v_att.timestamp;
+				_actuators.timestamp_sample = _sensor_combined.timestamp;
 
 				_controller_status.roll_rate_integ = _rates_int(0);
 				_controller_status.pitch_rate_integ = _rates_int(1);
@@ -888,13 +905,15 @@ MulticopterAttitudeControl::task_main()
 					_controller_status_pub = orb_advertise(ORB_ID(mc_att_ctrl_status), &_controller_status);
 				}
 			}
-		}
 
-		perf_end(_loop_perf);
+			rate_loop_end(&_rate_loop);
+		}
 	}
 
 	warnx("exit");
 
+	watchdog_unregister(&_wdog);
+
 	_control_task = -1;
 	_exit(0);
 }
@@ -100,7 +100,7 @@ void MulticopterAttitudeControlBase::control_attitude(float dt)
 	math::Vector <3> R_sp_z(R_sp(0, 2), R_sp(1, 2), R_sp(2, 2));
 
 	/* axis and sin(angle) of desired rotation */
-	math::Vector <3> e_R = R.transposed() * (R_z % R_sp_z);
+	math::Vector <3> e_R = R.transposed_mult(R_z % R_sp_z);
 
 	/* calculate angle error */
 	float e_R_z_sin = e_R.length();
@@ -146,7 +146,7 @@ void MulticopterAttitudeControlBase::control_attitude(float dt)
 		/* for large thrust vector rotations use another rotation method:
 		 * calculate angle and axis for R -> R_sp rotation directly */
 		math::Quaternion q;
-		q.from_dcm(R.transposed() * R_sp);
+		q.from_dcm(R.transposed_mult(R_sp));
 		math::Vector <3> e_R_d = q.imag();
 		e_R_d.normalize();
 		e_R_d *= 2.0f * atan2f(e_R_d.length(), q(0));
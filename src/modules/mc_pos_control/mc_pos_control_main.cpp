@@ -75,6 +75,7 @@
 #include <uORB/topics/vehicle_local_position_setpoint.h>
 
 #include <systemlib/systemlib.h>
+#include <systemlib/watchdog.h>
 #include <mathlib/mathlib.h>
 #include <lib/geo/geo.h>
 #include <mavlink/mavlink_log.h>
@@ -192,10 +193,18 @@ private:
 	float _ref_alt;
 	hrt_abstime _ref_timestamp;
 
+	struct watchdog_client_s _wdog;		/**< hardware watchdog supervision */
+
 	bool _reset_pos_sp;
 	bool _reset_alt_sp;
 	bool _mode_auto;
 
+	bool _triplet_proj_valid;			/**< projected waypoint cache is up to date */
+	hrt_abstime _triplet_proj_ref_timestamp;	/**< projection reference the cache was built with */
+	math::Vector<3> _curr_sp;			/**< projected current waypoint */
+	math::Vector<3> _prev_sp;			/**< projected previous waypoint */
+	math::Vector<3> _next_sp;			/**< projected next waypoint */
+
 	math::Vector<3> _pos;
 	math::Vector<3> _pos_sp;
 	math::Vector<3> _vel;
@@ -313,7 +322,10 @@ MulticopterPositionControl::MulticopterPositionControl() :
 
 	_reset_pos_sp(true),
 	_reset_alt_sp(true),
-	_mode_auto(false)
+	_mode_auto(false),
+
+	_triplet_proj_valid(false),
+	_triplet_proj_ref_timestamp(0)
 {
 	memset(&_att, 0, sizeof(_att));
 	memset(&_att_sp, 0, sizeof(_att_sp));
@@ -766,6 +778,8 @@ void MulticopterPositionControl::control_auto(float dt)
 			!isfinite(_pos_sp_triplet.current.alt)) {
 			_pos_sp_triplet.current.valid = false;
 		}
+
+		_triplet_proj_valid = false;
 	}
 
 	if (_pos_sp_triplet.current.valid) {
@@ -773,12 +787,34 @@ void MulticopterPositionControl::control_auto(float dt)
 		_reset_pos_sp = true;
 		_reset_alt_sp = true;
 
-		/* project setpoint to local frame */
-		math::Vector<3> curr_sp;
-		map_projection_project(&_ref_pos,
-				       _pos_sp_triplet.current.lat, _pos_sp_triplet.current.lon,
-				       &curr_sp.data[0], &curr_sp.data[1]);
-		curr_sp(2) = -(_pos_sp_triplet.current.alt - _ref_alt);
+		/* project the triplet to the local frame only on waypoint or
+		 * reference changes, the projection needs double precision
+		 * trigonometry and the result is constant in between */
+		if (!_triplet_proj_valid || _ref_timestamp != _triplet_proj_ref_timestamp) {
+			map_projection_project(&_ref_pos,
+					       _pos_sp_triplet.current.lat, _pos_sp_triplet.current.lon,
+					       &_curr_sp.data[0], &_curr_sp.data[1]);
+			_curr_sp(2) = -(_pos_sp_triplet.current.alt - _ref_alt);
+
+			if (_pos_sp_triplet.previous.valid) {
+				map_projection_project(&_ref_pos,
+						       _pos_sp_triplet.previous.lat, _pos_sp_triplet.previous.lon,
+						       &_prev_sp.data[0], &_prev_sp.data[1]);
+				_prev_sp(2) = -(_pos_sp_triplet.previous.alt - _ref_alt);
+			}
+
+			if (_pos_sp_triplet.next.valid) {
+				map_projection_project(&_ref_pos,
+						       _pos_sp_triplet.next.lat, _pos_sp_triplet.next.lon,
+						       &_next_sp.data[0], &_next_sp.data[1]);
+				_next_sp(2) = -(_pos_sp_triplet.next.alt - _ref_alt);
+			}
+
+			_triplet_proj_valid = true;
+			_triplet_proj_ref_timestamp = _ref_timestamp;
+		}
+
+		math::Vector<3> curr_sp = _curr_sp;
 
 		/* scaled space: 1 == position error resulting max allowed speed, L1 = 1 in this space */
 		math::Vector<3> scale = _params.pos_p.edivide(_params.vel_max);	// TODO add mult param here
@@ -791,11 +827,7 @@ void MulticopterPositionControl::control_auto(float dt)
 
 		if (_pos_sp_triplet.current.type == position_setpoint_s::SETPOINT_TYPE_POSITION && _pos_sp_triplet.previous.valid) {
 			/* follow "previous - current" line */
-			math::Vector<3> prev_sp;
-			map_projection_project(&_ref_pos,
-						   _pos_sp_triplet.previous.lat, _pos_sp_triplet.previous.lon,
-						   &prev_sp.data[0], &prev_sp.data[1]);
-			prev_sp(2) = -(_pos_sp_triplet.previous.alt - _ref_alt);
+			math::Vector<3> prev_sp = _prev_sp;
 
 			if ((curr_sp - prev_sp).length() > MIN_DIST) {
 
@@ -809,11 +841,7 @@ void MulticopterPositionControl::control_auto(float dt)
 					/* copter is closer to waypoint than L1 radius */
 					/* check next waypoint and use it to avoid slowing down when passing via waypoint */
 					if (_pos_sp_triplet.next.valid) {
-						math::Vector<3> next_sp;
-						map_projection_project(&_ref_pos,
-									   _pos_sp_triplet.next.lat, _pos_sp_triplet.next.lon,
-									   &next_sp.data[0], &next_sp.data[1]);
-						next_sp(2) = -(_pos_sp_triplet.next.alt - _ref_alt);
+						math::Vector<3> next_sp = _next_sp;
 
 						if ((next_sp - curr_sp).length() > MIN_DIST) {
 							math::Vector<3> next_sp_s = next_sp.emult(scale);
@@ -919,6 +947,9 @@ MulticopterPositionControl::task_main()
 	/* get an initial update for all sensor and status data */
 	poll_subscriptions();
 
+	/* check in with the hardware watchdog once per cycle */
+	watchdog_register(&_wdog, "mc_pos_control", 2000);
+
 	bool reset_int_z = true;
 	bool reset_int_z_manual = false;
 	bool reset_int_xy = true;
@@ -942,6 +973,8 @@ MulticopterPositionControl::task_main()
 		/* wait for up to 500ms for data */
 		int pret = poll(&fds[0], (sizeof(fds) / sizeof(fds[0])), 500);
 
+		watchdog_checkin(&_wdog);
+
 		/* timed out - periodic check for _task_should_exit */
 		if (pret == 0) {
 			continue;
@@ -1413,6 +1446,8 @@ MulticopterPositionControl::task_main()
 	warnx("stopped");
 	mavlink_log_info(_mavlink_fd, "[mpc] stopped");
 
+	watchdog_unregister(&_wdog);
+
 	_control_task = -1;
 	_exit(0);
 }
@@ -49,6 +49,7 @@
 #include <ctype.h>
 #include <nuttx/config.h>
 #include <unistd.h>
+#include <crc32.h>
 #include <mavlink/mavlink_log.h>
 #include <geo/geo.h>
 #include <drivers/drv_hrt.h>
@@ -84,6 +85,12 @@ Geofence::Geofence() :
 	_param_max_hor_distance(this, "MAX_HOR_DIST"),
 	_param_max_ver_distance(this, "MAX_VER_DIST"),
 	_outside_counter(0),
+	_vertices_cache{},
+	_cache_valid(false),
+	_lat_min(0),
+	_lat_max(0),
+	_lon_min(0),
+	_lon_max(0),
 	_mavlinkFd(-1)
 {
 	/* Load initial params */
@@ -208,6 +215,43 @@ bool Geofence::inside_polygon(double lat, double lon, float altitude)
 				return false;
 			}
 
+			/* lazily pull the polygon into RAM, this runs at position update rate */
+			if (!_cache_valid) {
+				loadVertexCache();
+			}
+
+			if (_cache_valid) {
+				/* cheap bounding box rejection before the full crossing test */
+				if (lat < (double)_lat_min || lat > (double)_lat_max ||
+				    lon < (double)_lon_min || lon > (double)_lon_max) {
+					return false;
+				}
+
+				/*Horizontal check */
+				/* Adaptation of algorithm originally presented as
+				 * PNPOLY - Point Inclusion in Polygon Test
+				 * W. Randolph Franklin (WRF) */
+
+				bool c = false;
+
+				for (unsigned i = 0, j = _verticesCount - 1; i < _verticesCount; j = i++) {
+					const struct fence_vertex_s &vertex_i = _vertices_cache[i];
+					const struct fence_vertex_s &vertex_j = _vertices_cache[j];
+
+					// skip vertex 0 (return point)
+					if (((double)vertex_i.lon >= lon) != ((double)vertex_j.lon >= lon) &&
+					    (lat <= (double)(vertex_j.lat - vertex_i.lat) * (lon - (double)vertex_i.lon) /
+					     (double)(vertex_j.lon - vertex_i.lon) + (double)vertex_i.lat)) {
+						c = !c;
+					}
+
+				}
+
+				return c;
+			}
+
+			/* cache load failed, fall back to reading each vertex from the dataman */
+
 			/*Horizontal check */
 			/* Adaptation of algorithm originally presented as
 			 * PNPOLY - Point Inclusion in Polygon Test
@@ -250,6 +294,46 @@ bool Geofence::inside_polygon(double lat, double lon, float altitude)
 	}
 }
 
+bool
+Geofence::loadVertexCache()
+{
+	if (isEmpty() || _verticesCount > GEOFENCE_MAX_VERTICES) {
+		return false;
+	}
+
+	for (unsigned i = 0; i < _verticesCount; i++) {
+		if (dm_read(DM_KEY_FENCE_POINTS, i, &_vertices_cache[i],
+			    sizeof(struct fence_vertex_s)) != sizeof(struct fence_vertex_s)) {
+			return false;
+		}
+	}
+
+	updateBoundingBox();
+
+	_cache_valid = true;
+	return true;
+}
+
+void
+Geofence::updateBoundingBox()
+{
+	for (unsigned i = 0; i < _verticesCount; i++) {
+		if (i == 0) {
+			_lat_min = _lat_max = _vertices_cache[i].lat;
+			_lon_min = _lon_max = _vertices_cache[i].lon;
+
+		} else {
+			if (_vertices_cache[i].lat < _lat_min) { _lat_min = _vertices_cache[i].lat; }
+
+			if (_vertices_cache[i].lat > _lat_max) { _lat_max = _vertices_cache[i].lat; }
+
+			if (_vertices_cache[i].lon < _lon_min) { _lon_min = _vertices_cache[i].lon; }
+
+			if (_vertices_cache[i].lon > _lon_max) { _lon_max = _vertices_cache[i].lon; }
+		}
+	}
+}
+
 bool
 Geofence::valid()
 {
@@ -304,6 +388,8 @@ Geofence::addPoint(int argc, char *argv[])
 	vertex.lon = (float)lon;
 
 	if (dm_write(DM_KEY_FENCE_POINTS, ix, DM_PERSIST_POWER_ON_RESET, &vertex, sizeof(vertex)) == sizeof(vertex)) {
+		_cache_valid = false;
+
 		if (last) {
 			publishFence((unsigned)ix + 1);
 		}
@@ -338,13 +424,26 @@ Geofence::loadFromFile(const char *filename)
 	/* Make sure no data is left in the datamanager */
 	clearDm();
 
-	/* open the mixer definition file */
-	fp = fopen(GEOFENCE_FILENAME, "r");
+	/* open the fence definition file */
+	fp = fopen(filename, "r");
 
 	if (fp == NULL) {
 		return ERROR;
 	}
 
+	/* binary fences carry a magic in their header, sniff for it */
+	struct fence_header_s header;
+
+	if (fread(&header, 1, sizeof(header), fp) == sizeof(header) &&
+	    header.magic == GEOFENCE_BIN_MAGIC) {
+		rc = loadFromBinary(fp, header);
+		fclose(fp);
+		return rc;
+	}
+
+	/* not binary, parse as text from the start */
+	rewind(fp);
+
 	/* create geofence points from valid lines and store in DM */
 	for (;;) {
 		/* get a line, bail on error/EOF */
@@ -420,6 +519,11 @@ Geofence::loadFromFile(const char *filename)
 		mavlink_log_info(_mavlinkFd, "Geofence imported");
 		rc = OK;
 
+		/* convert once, so the next boot is a single read */
+		if (saveToFile(GEOFENCE_BIN_FILENAME) != OK) {
+			warnx("Geofence: binary conversion failed");
+		}
+
 	} else {
 		warnx("Geofence: import error");
 		mavlink_log_critical(_mavlinkFd, "Geofence import error");
@@ -430,8 +534,107 @@ error:
 	return rc;
 }
 
+int
+Geofence::loadFromBinary(FILE *fp, const struct fence_header_s &header)
+{
+	/* validate the header before touching any state */
+	if (header.version != GEOFENCE_BIN_VERSION) {
+		warnx("Geofence: unsupported binary version %d", header.version);
+		return ERROR;
+	}
+
+	if ((header.vertex_count < 4) || (header.vertex_count > GEOFENCE_MAX_VERTICES)) {
+		warnx("Geofence: bad binary vertex count %d", header.vertex_count);
+		return ERROR;
+	}
+
+	/* one read pulls the whole polygon straight into the RAM cache */
+	size_t len = header.vertex_count * sizeof(struct fence_vertex_s);
+
+	if (fread(_vertices_cache, 1, len, fp) != len) {
+		warnx("Geofence: binary fence truncated");
+		return ERROR;
+	}
+
+	if (crc32((const uint8_t *)_vertices_cache, len) != header.crc) {
+		warnx("Geofence: binary fence checksum mismatch");
+		return ERROR;
+	}
+
+	/* mirror the fence into the dataman for addPoint and the
+	 * cache-miss fallback, held back as one bulk commit */
+	bool dm_ok = (dm_transaction_begin() == OK);
+
+	for (unsigned i = 0; i < header.vertex_count; i++) {
+		if (dm_write(DM_KEY_FENCE_POINTS, i, DM_PERSIST_POWER_ON_RESET,
+			     &_vertices_cache[i], sizeof(struct fence_vertex_s)) !=
+		    sizeof(struct fence_vertex_s)) {
+			dm_ok = false;
+			break;
+		}
+	}
+
+	dm_transaction_commit();
+
+	if (!dm_ok) {
+		warnx("Geofence: can't store binary fence");
+		return ERROR;
+	}
+
+	_altitude_min = header.altitude_min;
+	_altitude_max = header.altitude_max;
+	_verticesCount = header.vertex_count;
+
+	updateBoundingBox();
+	_cache_valid = true;
+
+	warnx("Geofence: imported %d vertices (binary)", header.vertex_count);
+	mavlink_log_info(_mavlinkFd, "Geofence imported");
+	return OK;
+}
+
+int
+Geofence::saveToFile(const char *filename)
+{
+	if (!valid() || isEmpty()) {
+		return ERROR;
+	}
+
+	/* make sure the RAM copy is current */
+	if (!_cache_valid && !loadVertexCache()) {
+		return ERROR;
+	}
+
+	size_t len = _verticesCount * sizeof(struct fence_vertex_s);
+
+	struct fence_header_s header;
+	header.magic = GEOFENCE_BIN_MAGIC;
+	header.version = GEOFENCE_BIN_VERSION;
+	header.vertex_count = _verticesCount;
+	header.altitude_min = _altitude_min;
+	header.altitude_max = _altitude_max;
+	header.crc = crc32((const uint8_t *)_vertices_cache, len);
+
+	FILE *fp = fopen(filename, "w");
+
+	if (fp == NULL) {
+		return ERROR;
+	}
+
+	int rc = OK;
+
+	if (fwrite(&header, 1, sizeof(header), fp) != sizeof(header) ||
+	    fwrite(_vertices_cache, 1, len, fp) != len) {
+		rc = ERROR;
+	}
+
+	fclose(fp);
+	return rc;
+}
+
 int Geofence::clearDm()
 {
 	dm_clear(DM_KEY_FENCE_POINTS);
+	_cache_valid = false;
 	return OK;
 }
@@ -41,6 +41,7 @@
 #ifndef GEOFENCE_H_
 #define GEOFENCE_H_
 
+#include <stdio.h>
 #include <uORB/topics/fence.h>
 #include <uORB/topics/vehicle_global_position.h>
 #include <uORB/topics/vehicle_gps_position.h>
@@ -51,6 +52,26 @@
 #include <drivers/drv_hrt.h>
 
 #define GEOFENCE_FILENAME "/fs/microsd/etc/geofence.txt"
+#define GEOFENCE_BIN_FILENAME "/fs/microsd/etc/geofence.bin"
+
+#define GEOFENCE_BIN_MAGIC 0x474f4645	/* 'GOFE' */
+#define GEOFENCE_BIN_VERSION 1
+
+/**
+ * Header of the binary fence format (GEOFENCE_BIN_FILENAME).
+ *
+ * A packed fence_vertex_s array follows the header; the crc covers
+ * the vertex data only. The header is validated before any vertex is
+ * accepted, so a truncated or stale file is rejected as a whole.
+ */
+struct fence_header_s {
+	uint32_t magic;			/**< GEOFENCE_BIN_MAGIC */
+	uint16_t version;		/**< GEOFENCE_BIN_VERSION */
+	uint16_t vertex_count;		/**< number of vertices following the header */
+	float altitude_min;		/**< vertical fence limits, AMSL m */
+	float altitude_max;
+	uint32_t crc;			/**< crc32 over the vertex array */
+};
 
 class Geofence : public control::SuperBlock
 {
@@ -96,6 +117,14 @@ public:
 
 	int loadFromFile(const char *filename);
 
+	/**
+	 * Save the current fence in the binary format.
+	 *
+	 * A fence imported from text is converted once, so later boots
+	 * load it with a single read instead of reparsing the file.
+	 */
+	int saveToFile(const char *filename);
+
 	bool isEmpty() {return _verticesCount == 0;}
 
 	int getAltitudeMode() { return _param_altitude_mode.get(); }
@@ -128,8 +157,32 @@ private:
 
 	uint8_t			_outside_counter;
 
+	struct fence_vertex_s	_vertices_cache[GEOFENCE_MAX_VERTICES];	/**< RAM copy of the fence polygon */
+	bool			_cache_valid;	/**< vertex cache and bounding box are current */
+	float			_lat_min;	/**< polygon bounding box */
+	float			_lat_max;
+	float			_lon_min;
+	float			_lon_max;
+
 	int _mavlinkFd;
 
+	/**
+	 * Load the fence polygon from the dataman into RAM and compute its bounding box
+	 * @return true on success
+	 */
+	bool loadVertexCache();
+
+	/**
+	 * Recompute the polygon bounding box from the vertex cache
+	 */
+	void updateBoundingBox();
+
+	/**
+	 * Load a binary fence (header already read and checked for magic)
+	 * @return OK on success
+	 */
+	int loadFromBinary(FILE *fp, const struct fence_header_s &header);
+
 	bool inside(double lat, double lon, float altitude);
 	bool inside(const struct vehicle_global_position_s &global_position);
 	bool inside(const struct vehicle_global_position_s &global_position, float baro_altitude_amsl);
@@ -85,6 +85,8 @@ Mission::Mission(Navigator *navigator, const char *name) :
   	_on_arrival_yaw(NAN),
 	_distance_current_previous(0.0f)
 {
+	invalidate_prefetch();
+
 	/* load initial params */
 	updateParams();
 }
@@ -181,6 +183,9 @@ Mission::on_active()
 void
 Mission::update_onboard_mission()
 {
+	/* whatever was read ahead may belong to the previous mission */
+	invalidate_prefetch();
+
 	if (orb_copy(ORB_ID(onboard_mission), _navigator->get_onboard_mission_sub(), &_onboard_mission) == OK) {
 		/* accept the current index set by the onboard mission if it is within bounds */
 		if (_onboard_mission.current_seq >=0
@@ -207,6 +212,9 @@ Mission::update_onboard_mission()
 void
 Mission::update_offboard_mission()
 {
+	/* whatever was read ahead may belong to the previous mission */
+	invalidate_prefetch();
+
 	if (orb_copy(ORB_ID(offboard_mission), _navigator->get_offboard_mission_sub(), &_offboard_mission) == OK) {
 		warnx("offboard mission updated: dataman_id=%d, count=%d, current_seq=%d", _offboard_mission.dataman_id, _offboard_mission.count, _offboard_mission.current_seq);
 		/* determine current index */
@@ -514,6 +522,74 @@ Mission::set_mission_items()
 	}
 
 	_navigator->set_position_setpoint_triplet_updated();
+
+	/* the transition work is done, use the slack to read ahead */
+	prefetch_mission_items();
+}
+
+void
+Mission::prefetch_mission_items()
+{
+	invalidate_prefetch();
+
+	dm_item_t dm_item;
+	int index;
+	unsigned count;
+
+	if (_mission_type == MISSION_TYPE_ONBOARD) {
+		dm_item = DM_KEY_WAYPOINTS_ONBOARD;
+		index = _current_onboard_mission_index;
+		count = _onboard_mission.count;
+
+	} else if (_mission_type == MISSION_TYPE_OFFBOARD) {
+		dm_item = DM_KEY_WAYPOINTS_OFFBOARD(_offboard_mission.dataman_id);
+		index = _current_offboard_mission_index;
+		count = _offboard_mission.count;
+
+	} else {
+		return;
+	}
+
+	/* pull the current item and its successors; DO_JUMP targets are only
+	 * resolved at read time and simply miss the ring */
+	for (int i = 0; i < PREFETCH_DEPTH; i++) {
+		int next = index + i;
+
+		if (next < 0 || next >= (int)count) {
+			break;
+		}
+
+		prefetch_entry_s *entry = &_prefetch[i];
+
+		if (dm_read(dm_item, next, &entry->item, sizeof(entry->item)) != sizeof(entry->item)) {
+			break;
+		}
+
+		entry->valid = true;
+		entry->dm_item = dm_item;
+		entry->index = next;
+	}
+}
+
+void
+Mission::invalidate_prefetch()
+{
+	for (int i = 0; i < PREFETCH_DEPTH; i++) {
+		_prefetch[i].valid = false;
+	}
+}
+
+bool
+Mission::prefetch_lookup(dm_item_t dm_item, int index, struct mission_item_s *mission_item)
+{
+	for (int i = 0; i < PREFETCH_DEPTH; i++) {
+		if (_prefetch[i].valid && _prefetch[i].dm_item == dm_item && _prefetch[i].index == index) {
+			memcpy(mission_item, &_prefetch[i].item, sizeof(struct mission_item_s));
+			return true;
+		}
+	}
+
+	return false;
 }
 
 void
@@ -669,8 +745,9 @@ Mission::read_mission_item(bool onboard, bool is_current, struct mission_item_s
 		/* read mission item to temp storage first to not overwrite current mission item if data damaged */
 		struct mission_item_s mission_item_tmp;
 
-		/* read mission item from datamanager */
-		if (dm_read(dm_item, *mission_index_ptr, &mission_item_tmp, len) != len) {
+		/* read mission item from the prefetch ring, or failing that the datamanager */
+		if (!prefetch_lookup(dm_item, *mission_index_ptr, &mission_item_tmp) &&
+		    dm_read(dm_item, *mission_index_ptr, &mission_item_tmp, len) != len) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			mavlink_log_critical(_navigator->get_mavlink_fd(),
 			                     "ERROR waypoint could not be read");
@@ -698,6 +775,9 @@ Mission::read_mission_item(bool onboard, bool is_current, struct mission_item_s
 					}
 					report_do_jump_mission_changed(*mission_index_ptr,
 								       mission_item_tmp.do_jump_repeat_count);
+
+					/* a prefetched copy of this item is stale now */
+					invalidate_prefetch();
 				}
 				/* set new mission item index and repeat
 				* we don't have to validate here, if it's invalid, we should realize this later .*/
@@ -138,6 +138,23 @@ private:
 	 */
 	bool read_mission_item(bool onboard, bool is_current, struct mission_item_s *mission_item);
 
+	/**
+	 * Pull the upcoming mission items into the prefetch ring so waypoint
+	 * transitions are served from RAM instead of blocking on the dataman store
+	 */
+	void prefetch_mission_items();
+
+	/**
+	 * Drop all prefetched mission items
+	 */
+	void invalidate_prefetch();
+
+	/**
+	 * Serve a mission item read from the prefetch ring
+	 * @return true if the requested item was resident
+	 */
+	bool prefetch_lookup(dm_item_t dm_item, int index, struct mission_item_s *mission_item);
+
 	/**
 	 * Save current offboard mission state to dataman
 	 */
@@ -194,6 +211,17 @@ private:
 	float _on_arrival_yaw; /**< holds the yaw value that should be applied when the current waypoint is reached */
 	float _distance_current_previous; /**< distance from previous to current sp in pos_sp_triplet,
 					    only use if current and previous are valid */
+
+	static const int PREFETCH_DEPTH = 4;
+
+	struct prefetch_entry_s {
+		bool valid;
+		dm_item_t dm_item;
+		int index;
+		struct mission_item_s item;
+	};
+
+	prefetch_entry_s _prefetch[PREFETCH_DEPTH];	/**< ring of upcoming mission items read ahead of time */
 };
 
 #endif
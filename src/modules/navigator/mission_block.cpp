@@ -60,7 +60,11 @@ MissionBlock::MissionBlock(Navigator *navigator, const char *name) :
 	_mission_item({0}),
 	_waypoint_position_reached(false),
 	_waypoint_yaw_reached(false),
-	_time_first_inside_orbit(0)
+	_time_first_inside_orbit(0),
+	_dist_sample_timestamp(0),
+	_dist(-1.0f),
+	_dist_xy(-1.0f),
+	_dist_z(-1.0f)
 {
 }
 
@@ -88,19 +92,25 @@ MissionBlock::is_mission_item_reached()
 	hrt_abstime now = hrt_absolute_time();
 
 	if (!_waypoint_position_reached) {
-		float dist = -1.0f;
-		float dist_xy = -1.0f;
-		float dist_z = -1.0f;
 
 		float altitude_amsl = _mission_item.altitude_is_relative
 				      ? _mission_item.altitude + _navigator->get_home_position()->alt
 			              : _mission_item.altitude;
 
-		dist = get_distance_to_point_global_wgs84(_mission_item.lat, _mission_item.lon, altitude_amsl,
-				                          _navigator->get_global_position()->lat,
-							  _navigator->get_global_position()->lon,
-							  _navigator->get_global_position()->alt,
-				&dist_xy, &dist_z);
+		/* only recompute the distances when the position estimate has moved on;
+		 * the navigator iterates more often than new position samples arrive */
+		if (_navigator->get_global_position()->timestamp != _dist_sample_timestamp) {
+
+			_dist = get_distance_to_point_global_wgs84(_mission_item.lat, _mission_item.lon, altitude_amsl,
+					                          _navigator->get_global_position()->lat,
+								  _navigator->get_global_position()->lon,
+								  _navigator->get_global_position()->alt,
+					&_dist_xy, &_dist_z);
+
+			_dist_sample_timestamp = _navigator->get_global_position()->timestamp;
+		}
+
+		float dist = _dist;
 
 		if (_mission_item.nav_cmd == NAV_CMD_TAKEOFF && _navigator->get_vstatus()->is_rotary_wing) {
 			/* require only altitude for takeoff for multicopter */
@@ -178,6 +188,9 @@ MissionBlock::reset_mission_item_reached()
 	_waypoint_position_reached = false;
 	_waypoint_yaw_reached = false;
 	_time_first_inside_orbit = 0;
+
+	/* the cached distances refer to the previous mission item */
+	_dist_sample_timestamp = 0;
 }
 
 void
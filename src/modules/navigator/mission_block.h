@@ -97,6 +97,11 @@ protected:
 	bool _waypoint_position_reached;
 	bool _waypoint_yaw_reached;
 	hrt_abstime _time_first_inside_orbit;
+
+	hrt_abstime _dist_sample_timestamp;	/**< global position sample the cached distances were computed from */
+	float _dist;				/**< cached distance to the current mission item */
+	float _dist_xy;
+	float _dist_z;
 };
 
 #endif
@@ -47,6 +47,8 @@
 #include <fw_pos_control_l1/landingslope.h>
 #include <systemlib/err.h>
 #include <stdio.h>
+#include <string.h>
+#include <float.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <uORB/topics/fence.h>
@@ -60,6 +62,11 @@ static const int ERROR = -1;
 MissionFeasibilityChecker::MissionFeasibilityChecker() : _mavlink_fd(-1), _capabilities_sub(-1), _initDone(false)
 {
 	_nav_caps = {0};
+
+	memset(_item_cache, 0, sizeof(_item_cache));
+	_cache_dm_item = DM_KEY_NUM_KEYS;
+	_cache_home_alt = 0.0f;
+	_cache_geofence_valid = false;
 }
 
 
@@ -74,6 +81,19 @@ bool MissionFeasibilityChecker::checkMissionFeasible(bool isRotarywing, dm_item_
 		_mavlink_fd = open(MAVLINK_LOG_DEVICE, 0);
 	}
 
+	/* cached per-item results only hold under the context they were
+	 * computed with; drop them all when that context changes */
+	if (dm_current != _cache_dm_item
+	    || fabsf(home_alt - _cache_home_alt) > FLT_EPSILON
+	    || geofence.valid() != _cache_geofence_valid) {
+
+		memset(_item_cache, 0, sizeof(_item_cache));
+		_cache_dm_item = dm_current;
+		_cache_home_alt = home_alt;
+		_cache_geofence_valid = geofence.valid();
+	}
+
+	refreshItemCache(dm_current, nMissionItems, geofence, home_alt);
 
 	if (isRotarywing)
 		return checkMissionFeasibleRotarywing(dm_current, nMissionItems, geofence, home_alt);
@@ -107,20 +127,61 @@ bool MissionFeasibilityChecker::checkMissionFeasibleFixedwing(dm_item_t dm_curre
 	return (resLanding && resGeofence && resHomeAltitude);
 }
 
+void MissionFeasibilityChecker::refreshItemCache(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt)
+{
+	/* Re-read and re-validate only items whose dataman change counter
+	 * moved since the results were cached; after a partial upload this
+	 * touches the changed items and nothing else */
+	for (size_t i = 0; (i < nMissionItems) && (i < NUM_MISSIONS_SUPPORTED); i++) {
+		ItemCheckCache &cache = _item_cache[i];
+		uint16_t generation = (uint16_t)dm_generation(dm_current, i);
+
+		if ((cache.flags & CACHE_VALID) && (cache.generation == generation)) {
+			continue;
+		}
+
+		struct mission_item_s missionitem;
+		const ssize_t len = sizeof(missionitem);
+
+		if (dm_read(dm_current, i, &missionitem, len) != len) {
+			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+			cache.flags = 0;
+			continue;
+		}
+
+		uint8_t flags = CACHE_VALID;
+
+		if (!geofence.valid() || geofence.inside_polygon(missionitem.lat, missionitem.lon, missionitem.altitude)) {
+			flags |= CACHE_GEOFENCE_OK;
+		}
+
+		/* calculate the global waypoint altitude */
+		float wp_alt = (missionitem.altitude_is_relative) ? missionitem.altitude + home_alt : missionitem.altitude;
+
+		if (home_alt <= wp_alt) {
+			flags |= CACHE_ALT_OK;
+		}
+
+		if (missionitem.nav_cmd == NAV_CMD_LAND) {
+			flags |= CACHE_IS_LANDING;
+		}
+
+		cache.generation = generation;
+		cache.flags = flags;
+	}
+}
+
 bool MissionFeasibilityChecker::checkGeofence(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence)
 {
 	/* Check if all mission items are inside the geofence (if we have a valid geofence) */
 	if (geofence.valid()) {
-		for (size_t i = 0; i < nMissionItems; i++) {
-			struct mission_item_s missionitem;
-			const ssize_t len = sizeof(missionitem);
-
-			if (dm_read(dm_current, i, &missionitem, len) != len) {
+		for (size_t i = 0; (i < nMissionItems) && (i < NUM_MISSIONS_SUPPORTED); i++) {
+			if (!(_item_cache[i].flags & CACHE_VALID)) {
 				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 				return false;
 			}
 
-			if (!geofence.inside_polygon(missionitem.lat, missionitem.lon, missionitem.altitude)) {
+			if (!(_item_cache[i].flags & CACHE_GEOFENCE_OK)) {
 				mavlink_log_critical(_mavlink_fd, "Geofence violation waypoint %d", i);
 				return false;
 			}
@@ -133,11 +194,8 @@ bool MissionFeasibilityChecker::checkGeofence(dm_item_t dm_current, size_t nMiss
 bool MissionFeasibilityChecker::checkHomePositionAltitude(dm_item_t dm_current, size_t nMissionItems, float home_alt, bool throw_error)
 {
 	/* Check if all all waypoints are above the home altitude, only return false if bool throw_error = true */
-	for (size_t i = 0; i < nMissionItems; i++) {
-		static struct mission_item_s missionitem;
-		const ssize_t len = sizeof(struct mission_item_s);
-
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
+	for (size_t i = 0; (i < nMissionItems) && (i < NUM_MISSIONS_SUPPORTED); i++) {
+		if (!(_item_cache[i].flags & CACHE_VALID)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			if (throw_error) {
 				return false;
@@ -146,10 +204,7 @@ bool MissionFeasibilityChecker::checkHomePositionAltitude(dm_item_t dm_current,
 			}
 		}
 
-		/* calculate the global waypoint altitude */
-		float wp_alt = (missionitem.altitude_is_relative) ? missionitem.altitude + home_alt : missionitem.altitude;
-
-		if (home_alt > wp_alt) {
+		if (!(_item_cache[i].flags & CACHE_ALT_OK)) {
 			if (throw_error) {
 				mavlink_log_critical(_mavlink_fd, "Rejecting Mission: Waypoint %d below home", i);
 				return false;
@@ -170,6 +225,14 @@ bool MissionFeasibilityChecker::checkFixedWingLanding(dm_item_t dm_current, size
 
 
 	for (size_t i = 0; i < nMissionItems; i++) {
+		/* the item cache already knows whether this is a landing item,
+		 * only landing items need their full data read back here */
+		if ((i < NUM_MISSIONS_SUPPORTED)
+		    && (_item_cache[i].flags & CACHE_VALID)
+		    && !(_item_cache[i].flags & CACHE_IS_LANDING)) {
+			continue;
+		}
+
 		struct mission_item_s missionitem;
 		const ssize_t len = sizeof(missionitem);
 		if (dm_read(dm_current, i, &missionitem, len) != len) {
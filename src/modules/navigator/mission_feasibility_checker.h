@@ -42,6 +42,7 @@
 #define MISSION_FEASIBILITY_CHECKER_H_
 
 #include <unistd.h>
+#include <stdint.h>
 #include <uORB/topics/mission.h>
 #include <uORB/topics/navigation_capabilities.h>
 #include <dataman/dataman.h>
@@ -59,6 +60,29 @@ private:
 	bool _initDone;
 	void init();
 
+	/* Per-item cache of check results, keyed by the dataman change
+	 * counter of the item: after a partial upload only the items whose
+	 * counter moved are re-read and re-validated, so accepting a
+	 * single-waypoint edit of a long mission no longer re-reads the
+	 * whole mission from dataman. */
+	static const uint8_t CACHE_VALID	= (1 << 0);	/**< entry holds results */
+	static const uint8_t CACHE_GEOFENCE_OK	= (1 << 1);	/**< item inside the geofence */
+	static const uint8_t CACHE_ALT_OK	= (1 << 2);	/**< item not below home altitude */
+	static const uint8_t CACHE_IS_LANDING	= (1 << 3);	/**< item is a NAV_CMD_LAND item */
+
+	struct ItemCheckCache {
+		uint16_t generation;	/**< dm_generation() the results were computed at */
+		uint8_t flags;		/**< CACHE_* result bits */
+	};
+
+	ItemCheckCache _item_cache[NUM_MISSIONS_SUPPORTED];
+	dm_item_t _cache_dm_item;	/**< mission storage the cache refers to */
+	float _cache_home_alt;		/**< home altitude the results were computed with */
+	bool _cache_geofence_valid;	/**< geofence validity the results were computed with */
+
+	/* Recompute cached results for items that changed since the last check */
+	void refreshItemCache(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt);
+
 	/* Checks for all airframes */
 	bool checkGeofence(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence);
 	bool checkHomePositionAltitude(dm_item_t dm_current, size_t nMissionItems, float home_alt, bool throw_error = false);
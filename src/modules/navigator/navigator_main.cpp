@@ -258,11 +258,16 @@ Navigator::task_main()
 	_geofence.setMavlinkFd(_mavlink_fd);
 
 	/* Try to load the geofence:
-	 * if /fs/microsd/etc/geofence.txt load from this file
+	 * if /fs/microsd/etc/geofence.bin load the binary fence (one read)
+	 * else if /fs/microsd/etc/geofence.txt load and convert the text file
 	 * else clear geofence data in datamanager */
 	struct stat buffer;
 
-	if (stat(GEOFENCE_FILENAME, &buffer) == 0) {
+	if (stat(GEOFENCE_BIN_FILENAME, &buffer) == 0) {
+		warnx("Try to load geofence.bin");
+		_geofence.loadFromFile(GEOFENCE_BIN_FILENAME);
+
+	} else if (stat(GEOFENCE_FILENAME, &buffer) == 0) {
 		warnx("Try to load geofence.txt");
 		_geofence.loadFromFile(GEOFENCE_FILENAME);
 
@@ -49,6 +49,7 @@
 #include <uORB/uORB.h>
 #include <uORB/topics/mission.h>
 #include <uORB/topics/home_position.h>
+#include <uORB/topics/parameter_update.h>
 
 #include "navigator.h"
 #include "rtl.h"
@@ -58,12 +59,18 @@
 RTL::RTL(Navigator *navigator, const char *name) :
 	MissionBlock(navigator, name),
 	_rtl_state(RTL_STATE_NONE),
+	_profile_valid(false),
+	_profile_home_timestamp(0),
+	_param_update_sub(-1),
 	_param_return_alt(this, "RTL_RETURN_ALT", false),
 	_param_descend_alt(this, "RTL_DESCEND_ALT", false),
 	_param_land_delay(this, "RTL_LAND_DELAY", false)
 {
 	/* load initial params */
 	updateParams();
+
+	_param_update_sub = orb_subscribe(ORB_ID(parameter_update));
+
 	/* initial reset */
 	on_inactive();
 }
@@ -79,6 +86,81 @@ RTL::on_inactive()
 	if (!_navigator->get_can_loiter_at_sp()) {
 		_rtl_state = RTL_STATE_NONE;
 	}
+
+	/* keep the precomputed profile current while RTL is not engaged */
+	refresh_profile();
+}
+
+void
+RTL::refresh_profile()
+{
+	bool params_changed = false;
+	orb_check(_param_update_sub, &params_changed);
+
+	if (params_changed) {
+		struct parameter_update_s update;
+		orb_copy(ORB_ID(parameter_update), _param_update_sub, &update);
+		updateParams();
+	}
+
+	if (!_profile_valid
+	    || params_changed
+	    || _navigator->get_home_position()->timestamp != _profile_home_timestamp) {
+		update_profile();
+	}
+}
+
+void
+RTL::update_profile()
+{
+	const struct home_position_s *home = _navigator->get_home_position();
+	bool autoland = _param_land_delay.get() > -DELAY_SIGMA;
+
+	/* fields common to all legs */
+	for (int state = RTL_STATE_CLIMB; state <= RTL_STATE_LANDED; state++) {
+		struct mission_item_s *item = &_profile_items[state];
+
+		memset(item, 0, sizeof(*item));
+		item->lat = home->lat;
+		item->lon = home->lon;
+		item->altitude_is_relative = false;
+		item->yaw = NAN;
+		item->loiter_radius = _navigator->get_loiter_radius();
+		item->loiter_direction = 1;
+		item->nav_cmd = NAV_CMD_WAYPOINT;
+		item->acceptance_radius = _navigator->get_acceptance_radius();
+		item->time_inside = 0.0f;
+		item->pitch_min = 0.0f;
+		item->autocontinue = true;
+		item->origin = ORIGIN_ONBOARD;
+	}
+
+	/* climb leg: lat/lon are filled in from the current position on activation */
+	_profile_items[RTL_STATE_CLIMB].altitude = home->alt + _param_return_alt.get();
+
+	/* return leg: altitude is carried over from the previous leg, yaw is set on activation */
+
+	/* descend leg */
+	_profile_items[RTL_STATE_DESCEND].altitude = home->alt + _param_descend_alt.get();
+	_profile_items[RTL_STATE_DESCEND].nav_cmd = NAV_CMD_LOITER_TIME_LIMIT;
+	_profile_items[RTL_STATE_DESCEND].autocontinue = false;
+
+	/* loiter leg */
+	_profile_items[RTL_STATE_LOITER].altitude = home->alt + _param_descend_alt.get();
+	_profile_items[RTL_STATE_LOITER].nav_cmd = autoland ? NAV_CMD_LOITER_TIME_LIMIT : NAV_CMD_LOITER_UNLIMITED;
+	_profile_items[RTL_STATE_LOITER].time_inside = _param_land_delay.get() < 0.0f ? 0.0f : _param_land_delay.get();
+	_profile_items[RTL_STATE_LOITER].autocontinue = autoland;
+
+	/* land leg */
+	_profile_items[RTL_STATE_LAND].altitude = home->alt;
+	_profile_items[RTL_STATE_LAND].nav_cmd = NAV_CMD_LAND;
+
+	/* landed */
+	_profile_items[RTL_STATE_LANDED].altitude = home->alt;
+	_profile_items[RTL_STATE_LANDED].nav_cmd = NAV_CMD_IDLE;
+
+	_profile_home_timestamp = home->timestamp;
+	_profile_valid = true;
 }
 
 void
@@ -122,39 +204,34 @@ RTL::set_rtl_item()
 {
 	struct position_setpoint_triplet_s *pos_sp_triplet = _navigator->get_position_setpoint_triplet();
 
-	/* make sure we have the latest params */
-	updateParams();
+	/* the profile is normally precomputed while inactive; rebuild here
+	 * only if home or parameters changed since */
+	refresh_profile();
 
 	set_previous_pos_setpoint();
 	_navigator->set_can_loiter_at_sp(false);
 
 	switch (_rtl_state) {
 	case RTL_STATE_CLIMB: {
-		float climb_alt = _navigator->get_home_position()->alt + _param_return_alt.get();
+		_mission_item = _profile_items[RTL_STATE_CLIMB];
 
+		/* climb straight up from the current position */
 		_mission_item.lat = _navigator->get_global_position()->lat;
 		_mission_item.lon = _navigator->get_global_position()->lon;
-		_mission_item.altitude_is_relative = false;
-		_mission_item.altitude = climb_alt;
-		_mission_item.yaw = NAN;
-		_mission_item.loiter_radius = _navigator->get_loiter_radius();
-		_mission_item.loiter_direction = 1;
-		_mission_item.nav_cmd = NAV_CMD_WAYPOINT;
-		_mission_item.acceptance_radius = _navigator->get_acceptance_radius();
-		_mission_item.time_inside = 0.0f;
-		_mission_item.pitch_min = 0.0f;
-		_mission_item.autocontinue = true;
-		_mission_item.origin = ORIGIN_ONBOARD;
 
 		mavlink_log_critical(_navigator->get_mavlink_fd(), "RTL: climb to %d meters above home",
-			(int)(climb_alt - _navigator->get_home_position()->alt));
+			(int)(_mission_item.altitude - _navigator->get_home_position()->alt));
 		break;
 	}
 
 	case RTL_STATE_RETURN: {
-		_mission_item.lat = _navigator->get_home_position()->lat;
-		_mission_item.lon = _navigator->get_home_position()->lon;
-		 // don't change altitude
+		/* don't change altitude: carry it over from the previous leg */
+		float return_alt = _mission_item.altitude;
+		bool return_alt_is_relative = _mission_item.altitude_is_relative;
+
+		_mission_item = _profile_items[RTL_STATE_RETURN];
+		_mission_item.altitude = return_alt;
+		_mission_item.altitude_is_relative = return_alt_is_relative;
 
 		 if (pos_sp_triplet->previous.valid) {
 		 	/* if previous setpoint is valid then use it to calculate heading to home */
@@ -168,14 +245,6 @@ RTL::set_rtl_item()
 		 	        _navigator->get_global_position()->lat, _navigator->get_global_position()->lon,
 		 	        _mission_item.lat, _mission_item.lon);
 		 }
-		_mission_item.loiter_radius = _navigator->get_loiter_radius();
-		_mission_item.loiter_direction = 1;
-		_mission_item.nav_cmd = NAV_CMD_WAYPOINT;
-		_mission_item.acceptance_radius = _navigator->get_acceptance_radius();
-		_mission_item.time_inside = 0.0f;
-		_mission_item.pitch_min = 0.0f;
-		_mission_item.autocontinue = true;
-		_mission_item.origin = ORIGIN_ONBOARD;
 
 		mavlink_log_critical(_navigator->get_mavlink_fd(), "RTL: return at %d meters above home",
 			(int)(_mission_item.altitude - _navigator->get_home_position()->alt));
@@ -183,19 +252,7 @@ RTL::set_rtl_item()
 	}
 
 	case RTL_STATE_DESCEND: {
-		_mission_item.lat = _navigator->get_home_position()->lat;
-		_mission_item.lon = _navigator->get_home_position()->lon;
-		_mission_item.altitude_is_relative = false;
-		_mission_item.altitude = _navigator->get_home_position()->alt + _param_descend_alt.get();
-		_mission_item.yaw = NAN;
-		_mission_item.loiter_radius = _navigator->get_loiter_radius();
-		_mission_item.loiter_direction = 1;
-		_mission_item.nav_cmd = NAV_CMD_LOITER_TIME_LIMIT;
-		_mission_item.acceptance_radius = _navigator->get_acceptance_radius();
-		_mission_item.time_inside = 0.0f;
-		_mission_item.pitch_min = 0.0f;
-		_mission_item.autocontinue = false;
-		_mission_item.origin = ORIGIN_ONBOARD;
+		_mission_item = _profile_items[RTL_STATE_DESCEND];
 
 		mavlink_log_critical(_navigator->get_mavlink_fd(), "RTL: descend to %d meters above home",
 			(int)(_mission_item.altitude - _navigator->get_home_position()->alt));
@@ -203,25 +260,11 @@ RTL::set_rtl_item()
 	}
 
 	case RTL_STATE_LOITER: {
-		bool autoland = _param_land_delay.get() > -DELAY_SIGMA;
-
-		_mission_item.lat = _navigator->get_home_position()->lat;
-		_mission_item.lon = _navigator->get_home_position()->lon;
-		_mission_item.altitude_is_relative = false;
-		_mission_item.altitude = _navigator->get_home_position()->alt + _param_descend_alt.get();
-		_mission_item.yaw = NAN;
-		_mission_item.loiter_radius = _navigator->get_loiter_radius();
-		_mission_item.loiter_direction = 1;
-		_mission_item.nav_cmd = autoland ? NAV_CMD_LOITER_TIME_LIMIT : NAV_CMD_LOITER_UNLIMITED;
-		_mission_item.acceptance_radius = _navigator->get_acceptance_radius();
-		_mission_item.time_inside = _param_land_delay.get() < 0.0f ? 0.0f : _param_land_delay.get();
-		_mission_item.pitch_min = 0.0f;
-		_mission_item.autocontinue = autoland;
-		_mission_item.origin = ORIGIN_ONBOARD;
+		_mission_item = _profile_items[RTL_STATE_LOITER];
 
 		_navigator->set_can_loiter_at_sp(true);
 
-		if (autoland) {
+		if (_mission_item.autocontinue) {
 			mavlink_log_critical(_navigator->get_mavlink_fd(), "RTL: loiter %.1fs", (double)_mission_item.time_inside);
 
 		} else {
@@ -231,38 +274,14 @@ RTL::set_rtl_item()
 	}
 
 	case RTL_STATE_LAND: {
-		_mission_item.lat = _navigator->get_home_position()->lat;
-		_mission_item.lon = _navigator->get_home_position()->lon;
-		_mission_item.altitude_is_relative = false;
-		_mission_item.altitude = _navigator->get_home_position()->alt;
-		_mission_item.yaw = NAN;
-		_mission_item.loiter_radius = _navigator->get_loiter_radius();
-		_mission_item.loiter_direction = 1;
-		_mission_item.nav_cmd = NAV_CMD_LAND;
-		_mission_item.acceptance_radius = _navigator->get_acceptance_radius();
-		_mission_item.time_inside = 0.0f;
-		_mission_item.pitch_min = 0.0f;
-		_mission_item.autocontinue = true;
-		_mission_item.origin = ORIGIN_ONBOARD;
+		_mission_item = _profile_items[RTL_STATE_LAND];
 
 		mavlink_log_critical(_navigator->get_mavlink_fd(), "RTL: land at home");
 		break;
 	}
 
 	case RTL_STATE_LANDED: {
-		_mission_item.lat = _navigator->get_home_position()->lat;
-		_mission_item.lon = _navigator->get_home_position()->lon;
-		_mission_item.altitude_is_relative = false;
-		_mission_item.altitude = _navigator->get_home_position()->alt;
-		_mission_item.yaw = NAN;
-		_mission_item.loiter_radius = _navigator->get_loiter_radius();
-		_mission_item.loiter_direction = 1;
-		_mission_item.nav_cmd = NAV_CMD_IDLE;
-		_mission_item.acceptance_radius = _navigator->get_acceptance_radius();
-		_mission_item.time_inside = 0.0f;
-		_mission_item.pitch_min = 0.0f;
-		_mission_item.autocontinue = true;
-		_mission_item.origin = ORIGIN_ONBOARD;
+		_mission_item = _profile_items[RTL_STATE_LANDED];
 
 		mavlink_log_critical(_navigator->get_mavlink_fd(), "RTL: completed, landed");
 		break;
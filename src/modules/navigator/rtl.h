@@ -78,6 +78,16 @@ private:
 	 */
 	void		advance_rtl();
 
+	/**
+	 * Rebuild the precomputed profile if home moved or parameters changed
+	 */
+	void		refresh_profile();
+
+	/**
+	 * Precompute the per-state mission items of the RTL profile
+	 */
+	void		update_profile();
+
 	enum RTLState {
 		RTL_STATE_NONE = 0,
 		RTL_STATE_CLIMB,
@@ -88,6 +98,16 @@ private:
 		RTL_STATE_LANDED,
 	} _rtl_state;
 
+	/* The full RTL profile is precomputed whenever home or the RTL
+	 * parameters change, not on activation: engaging RTL then only
+	 * copies the item of the entry state and fills in the few
+	 * position-dependent fields, so the first setpoint goes out in
+	 * the same navigator cycle. */
+	struct mission_item_s	_profile_items[RTL_STATE_LANDED + 1];	/**< precomputed item per state */
+	bool			_profile_valid;		/**< profile has been computed */
+	uint64_t		_profile_home_timestamp;	/**< home position the profile is based on */
+	int			_param_update_sub;	/**< parameter update subscription */
+
 	control::BlockParamFloat _param_return_alt;
 	control::BlockParamFloat _param_descend_alt;
 	control::BlockParamFloat _param_land_delay;
@@ -488,7 +488,24 @@ int position_estimator_inav_thread_main(int argc, char *argv[])
 			orb_check(optical_flow_sub, &updated);
 
 			if (updated) {
-				orb_copy(ORB_ID(optical_flow), optical_flow_sub, &flow);
+				/* read the sample in place; the px4flow driver advertises
+				 * the topic double-buffered, so the reference stays valid
+				 * unless the publisher laps us, in which case orb_release()
+				 * fails and we re-read */
+				const struct optical_flow_s *flow_ref;
+				int acquired;
+
+				do {
+					acquired = orb_acquire(ORB_ID(optical_flow), optical_flow_sub, (const void **)&flow_ref);
+
+					if (acquired != OK) {
+						/* single-buffered publisher (e.g. flow over MAVLink) */
+						orb_copy(ORB_ID(optical_flow), optical_flow_sub, &flow);
+						break;
+					}
+
+					flow = *flow_ref;
+				} while (orb_release(optical_flow_sub) != OK);
 
 				/* calculate time from previous update */
 //				float flow_dt = flow_prev > 0 ? (flow.flow_timestamp - flow_prev) * 1e-6f : 0.1f;
@@ -896,6 +913,10 @@ int position_estimator_inav_thread_main(int argc, char *argv[])
 			corr_baro += offs_corr;
 		}
 
+		/* the bias is integrated in the body frame, so error terms sharing a
+		 * rotation matrix are accumulated in NED first and rotated once */
+		float w_acc_bias_dt = params.w_acc_bias * dt;
+
 		/* accelerometer bias correction for GPS (use buffered rotation matrix) */
 		float accel_bias_corr[3] = { 0.0f, 0.0f, 0.0f };
 
@@ -911,20 +932,23 @@ int position_estimator_inav_thread_main(int argc, char *argv[])
 			accel_bias_corr[2] -= corr_gps[2][1] * w_z_gps_v;
 		}
 
-		/* transform error vector from NED frame to body frame */
-		for (int i = 0; i < 3; i++) {
-			float c = 0.0f;
+		if (use_gps_xy || use_gps_z) {
+			/* transform error vector from NED frame to body frame */
+			for (int i = 0; i < 3; i++) {
+				float c = 0.0f;
 
-			for (int j = 0; j < 3; j++) {
-				c += R_gps[j][i] * accel_bias_corr[j];
-			}
+				for (int j = 0; j < 3; j++) {
+					c += R_gps[j][i] * accel_bias_corr[j];
+				}
 
-			if (isfinite(c)) {
-				acc_bias[i] += c * params.w_acc_bias * dt;
+				if (isfinite(c)) {
+					acc_bias[i] += c * w_acc_bias_dt;
+				}
 			}
 		}
 
-		/* accelerometer bias correction for VISION (use buffered rotation matrix) */
+		/* accelerometer bias correction for vision, flow and baro (no delay
+		 * assumed, all use the current rotation matrix) */
 		accel_bias_corr[0] = 0.0f;
 		accel_bias_corr[1] = 0.0f;
 		accel_bias_corr[2] = 0.0f;
@@ -940,24 +964,6 @@ int position_estimator_inav_thread_main(int argc, char *argv[])
 			accel_bias_corr[2] -= corr_vision[2][0] * w_z_vision_p * w_z_vision_p;
 		}
 
-		/* transform error vector from NED frame to body frame */
-		for (int i = 0; i < 3; i++) {
-			float c = 0.0f;
-
-			for (int j = 0; j < 3; j++) {
-				c += PX4_R(att.R, j, i) * accel_bias_corr[j];
-			}
-
-			if (isfinite(c)) {
-				acc_bias[i] += c * params.w_acc_bias * dt;
-			}
-		}
-
-		/* accelerometer bias correction for flow and baro (assume that there is no delay) */
-		accel_bias_corr[0] = 0.0f;
-		accel_bias_corr[1] = 0.0f;
-		accel_bias_corr[2] = 0.0f;
-
 		if (use_flow) {
 			accel_bias_corr[0] -= corr_flow[0] * params.w_xy_flow;
 			accel_bias_corr[1] -= corr_flow[1] * params.w_xy_flow;
@@ -974,7 +980,7 @@ int position_estimator_inav_thread_main(int argc, char *argv[])
 			}
 
 			if (isfinite(c)) {
-				acc_bias[i] += c * params.w_acc_bias * dt;
+				acc_bias[i] += c * w_acc_bias_dt;
 			}
 		}
 
@@ -64,6 +64,24 @@ static int _dsm_fd;
 
 static uint16_t rc_value_override = 0;
 
+/*
+ * Serial protocol detection on the DSM port.
+ *
+ * DSM, ST24 and SUMD share the same UART, so while no protocol has been
+ * identified every received byte is offered to all decoders in a single
+ * pass.  Once one of them delivers a complete frame the protocol is
+ * latched and only its decoder runs, cutting the per-byte cost on the
+ * RC path.  The latch is released on signal loss so that a receiver
+ * swap is picked up again.
+ */
+enum rc_serial_protocol {
+	RC_PROTO_NONE = 0,	/**< scanning - all decoders run */
+	RC_PROTO_DSM,
+	RC_PROTO_ST24,
+	RC_PROTO_SUMD
+};
+static enum rc_serial_protocol rc_proto = RC_PROTO_NONE;
+
 bool dsm_port_input(uint16_t *rssi, bool *dsm_updated, bool *st24_updated, bool *sumd_updated)
 {
 	perf_begin(c_gather_dsm);
@@ -81,20 +99,36 @@ bool dsm_port_input(uint16_t *rssi, bool *dsm_updated, bool *st24_updated, bool
 		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FRAME_DROP);
 		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FAILSAFE);
 
+		rc_proto = RC_PROTO_DSM;
 	}
 	perf_end(c_gather_dsm);
 
-	/* get data from FD and attempt to parse with DSM and ST24 libs */
+	/*
+	 * Offer the received bytes to the ST24 and SUMD decoders in one pass;
+	 * once a protocol is latched, only its decoder sees the stream.
+	 */
 	uint8_t st24_rssi, rx_count;
 	uint16_t st24_channel_count = 0;
+	uint8_t sumd_rssi, sumd_rx_count;
+	uint16_t sumd_channel_count = 0;
 
 	*st24_updated = false;
+	*sumd_updated = false;
 
 	for (unsigned i = 0; i < n_bytes; i++) {
+
 		/* set updated flag if one complete packet was parsed */
-		st24_rssi = RC_INPUT_RSSI_MAX;
-		*st24_updated |= (OK == st24_decode(bytes[i], &st24_rssi, &rx_count,
-					&st24_channel_count, r_raw_rc_values, PX4IO_RC_INPUT_CHANNELS));
+		if ((rc_proto == RC_PROTO_NONE) || (rc_proto == RC_PROTO_ST24)) {
+			st24_rssi = RC_INPUT_RSSI_MAX;
+			*st24_updated |= (OK == st24_decode(bytes[i], &st24_rssi, &rx_count,
+						&st24_channel_count, r_raw_rc_values, PX4IO_RC_INPUT_CHANNELS));
+		}
+
+		if ((rc_proto == RC_PROTO_NONE) || (rc_proto == RC_PROTO_SUMD)) {
+			sumd_rssi = RC_INPUT_RSSI_MAX;
+			*sumd_updated |= (OK == sumd_decode(bytes[i], &sumd_rssi, &sumd_rx_count,
+						&sumd_channel_count, r_raw_rc_values, PX4IO_RC_INPUT_CHANNELS));
+		}
 	}
 
 	if (*st24_updated) {
@@ -108,20 +142,8 @@ bool dsm_port_input(uint16_t *rssi, bool *dsm_updated, bool *st24_updated, bool
 		r_status_flags |= PX4IO_P_STATUS_FLAGS_RC_ST24;
 		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FRAME_DROP);
 		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FAILSAFE);
-	}
-
-
-	/* get data from FD and attempt to parse with SUMD libs */
-	uint8_t sumd_rssi, sumd_rx_count;
-	uint16_t sumd_channel_count = 0;
 
-	*sumd_updated = false;
-
-	for (unsigned i = 0; i < n_bytes; i++) {
-		/* set updated flag if one complete packet was parsed */
-		sumd_rssi = RC_INPUT_RSSI_MAX;
-		*sumd_updated |= (OK == sumd_decode(bytes[i], &sumd_rssi, &sumd_rx_count,
-					&sumd_channel_count, r_raw_rc_values, PX4IO_RC_INPUT_CHANNELS));
+		rc_proto = RC_PROTO_ST24;
 	}
 
 	if (*sumd_updated) {
@@ -132,6 +154,8 @@ bool dsm_port_input(uint16_t *rssi, bool *dsm_updated, bool *st24_updated, bool
 		r_status_flags |= PX4IO_P_STATUS_FLAGS_RC_SUMD;
 		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FRAME_DROP);
 		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FAILSAFE);
+
+		rc_proto = RC_PROTO_SUMD;
 	}
 
 	return (*dsm_updated | *st24_updated | *sumd_updated);
@@ -412,6 +436,9 @@ controls_tick() {
 			PX4IO_P_STATUS_FLAGS_RC_DSM |
 			PX4IO_P_STATUS_FLAGS_RC_SBUS);
 
+		/* re-scan all serial protocols so a receiver swap is detected */
+		rc_proto = RC_PROTO_NONE;
+
 	}
 
 	/*
@@ -86,6 +86,184 @@ static MixerGroup mixer_group(mixer_callback, 0);
 /* Set the failsafe values of all mixed channels (based on zero throttle, controls centered) */
 static void mixer_set_failsafe();
 
+/*
+ * Fixed-point fast mixing path.
+ *
+ * The IO processor has no FPU, so every SimpleMixer scale operation costs
+ * several softfloat library calls.  When all loaded mixers are simple
+ * mixers, their configuration is compiled into an integer table at load
+ * time and the per-tick mixing runs entirely in fixed point: control and
+ * output values in register units (10000 == 1.0, matching REG_TO_SIGNED)
+ * and scale factors in Q12.  Multirotor and other mixer types fall back
+ * to the float path.
+ */
+#define MIXER_FAST_MAX_CONTROLS	8
+
+struct mixer_fast_scaler {
+	int32_t		neg_scale;	/* Q12 */
+	int32_t		pos_scale;	/* Q12 */
+	int32_t		offset;		/* register units */
+	int32_t		min_output;	/* register units */
+	int32_t		max_output;	/* register units */
+};
+
+struct mixer_fast_output {
+	struct mixer_fast_scaler output_scaler;
+	uint8_t		control_count;
+	uint8_t		control_group[MIXER_FAST_MAX_CONTROLS];
+	uint8_t		control_index[MIXER_FAST_MAX_CONTROLS];
+	struct mixer_fast_scaler control_scaler[MIXER_FAST_MAX_CONTROLS];
+};
+
+static struct mixer_fast_output fast_outputs[PX4IO_SERVO_COUNT];
+static unsigned	fast_output_count = 0;	/* zero while the fast path is unavailable */
+
+static int32_t
+mixer_fast_round(float value, float scale)
+{
+	float scaled = value * scale;
+
+	return (int32_t)(scaled + ((scaled < 0.0f) ? -0.5f : 0.5f));
+}
+
+static void
+mixer_fast_compile_scaler(struct mixer_fast_scaler *fs, const struct mixer_scaler_s *s)
+{
+	fs->neg_scale	= mixer_fast_round(s->negative_scale, 4096.0f);
+	fs->pos_scale	= mixer_fast_round(s->positive_scale, 4096.0f);
+	fs->offset	= mixer_fast_round(s->offset, 10000.0f);
+	fs->min_output	= mixer_fast_round(s->min_output, 10000.0f);
+	fs->max_output	= mixer_fast_round(s->max_output, 10000.0f);
+}
+
+/*
+ * Compile the loaded mixer group into the fixed-point table.
+ *
+ * Called with mixing disabled after a successful load; leaves
+ * fast_output_count at zero if any mixer cannot be represented.
+ */
+static void
+mixer_fast_compile(void)
+{
+	unsigned count = 0;
+
+	fast_output_count = 0;
+
+	for (Mixer *m = mixer_group.first(); m != nullptr; m = m->_next) {
+		const mixer_simple_s *info = m->get_simple_info();
+
+		/* all mixers must be simple mixers with supported control counts */
+		if ((info == nullptr) ||
+		    (info->control_count > MIXER_FAST_MAX_CONTROLS) ||
+		    (count >= PX4IO_SERVO_COUNT)) {
+			return;
+		}
+
+		struct mixer_fast_output *fo = &fast_outputs[count];
+
+		mixer_fast_compile_scaler(&fo->output_scaler, &info->output_scaler);
+		fo->control_count = info->control_count;
+
+		for (unsigned i = 0; i < info->control_count; i++) {
+			fo->control_group[i] = info->controls[i].control_group;
+			fo->control_index[i] = info->controls[i].control_index;
+			mixer_fast_compile_scaler(&fo->control_scaler[i], &info->controls[i].scaler);
+		}
+
+		count++;
+	}
+
+	fast_output_count = count;
+
+	isr_debug(2, "fast mixer %u outputs", count);
+}
+
+/* integer mirror of mixer_callback, fetching controls in register units */
+static int
+mixer_fast_get_control(uint8_t control_group, uint8_t control_index, int32_t &control)
+{
+	if (control_group >= PX4IO_CONTROL_GROUPS)
+		return -1;
+
+	switch (source) {
+	case MIX_FMU:
+		if (control_index < PX4IO_CONTROL_CHANNELS) {
+			control = REG_TO_SIGNED(r_page_controls[CONTROL_PAGE_INDEX(control_group, control_index)]);
+			return 0;
+		}
+		return -1;
+
+	case MIX_OVERRIDE:
+		if (r_page_rc_input[PX4IO_P_RC_VALID] & (1 << CONTROL_PAGE_INDEX(control_group, control_index))) {
+			control = REG_TO_SIGNED(r_page_rc_input[PX4IO_P_RC_BASE + control_index]);
+			return 0;
+		}
+		return -1;
+
+	case MIX_OVERRIDE_FMU_OK:
+		/* direct rc control for the available rc channels, the others from the fmu */
+		if (r_page_rc_input[PX4IO_P_RC_VALID] & (1 << CONTROL_PAGE_INDEX(control_group, control_index))) {
+			control = REG_TO_SIGNED(r_page_rc_input[PX4IO_P_RC_BASE + control_index]);
+			return 0;
+		} else if (control_index < PX4IO_CONTROL_CHANNELS) {
+			control = REG_TO_SIGNED(r_page_controls[CONTROL_PAGE_INDEX(control_group, control_index)]);
+			return 0;
+		}
+		return -1;
+
+	case MIX_FAILSAFE:
+	case MIX_NONE:
+		break;
+	}
+
+	return -1;
+}
+
+static int32_t
+mixer_fast_scale(const struct mixer_fast_scaler *fs, int32_t input)
+{
+	/* the 32x32->64 multiply is a single instruction on the IO processor */
+	int32_t output = (int32_t)(((int64_t)input *
+				    ((input < 0) ? fs->neg_scale : fs->pos_scale)) >> 12) + fs->offset;
+
+	if (output < fs->min_output)
+		output = fs->min_output;
+	if (output > fs->max_output)
+		output = fs->max_output;
+
+	return output;
+}
+
+/*
+ * Mix using the fixed-point table.
+ *
+ * Returns zero when the fast path is unavailable and the float
+ * path should run instead.
+ */
+static unsigned
+mixer_fast_mix(float *outputs, unsigned space)
+{
+	if ((fast_output_count == 0) || (space < fast_output_count))
+		return 0;
+
+	for (unsigned i = 0; i < fast_output_count; i++) {
+		const struct mixer_fast_output *fo = &fast_outputs[i];
+		int32_t sum = 0;
+
+		for (unsigned j = 0; j < fo->control_count; j++) {
+			int32_t control = 0;
+
+			(void)mixer_fast_get_control(fo->control_group[j], fo->control_index[j], control);
+			sum += mixer_fast_scale(&fo->control_scaler[j], control);
+		}
+
+		/* single float operation per output, feeding the unchanged PWM limit code */
+		outputs[i] = mixer_fast_scale(&fo->output_scaler, sum) * (1.0f / 10000.0f);
+	}
+
+	return fast_output_count;
+}
+
 void
 mixer_tick(void)
 {
@@ -153,6 +331,18 @@ mixer_tick(void)
 		}
 	}
 
+	/*
+	 * Autonomous RC loss reaction: the FMU needs several task hops to
+	 * react to a signal loss; when enabled, apply the preloaded failsafe
+	 * profile here the moment the RC flag drops and let the FMU reconcile
+	 * afterwards by clearing the enable bit once it has taken over.
+	 */
+	if ((r_setup_arming & PX4IO_P_SETUP_ARMING_RC_LOSS_FAILSAFE) &&
+	    !(r_status_flags & PX4IO_P_STATUS_FLAGS_RC_OK) &&
+	    (source != MIX_NONE)) {
+		source = MIX_FAILSAFE;
+	}
+
 	/*
 	 * Decide whether the servos should be armed right now.
 	 *
@@ -230,7 +420,12 @@ mixer_tick(void)
 
 		/* poor mans mutex */
 		in_mixer = true;
-		mixed = mixer_group.mix(&outputs[0], PX4IO_SERVO_COUNT, &r_mixer_limits);
+		mixed = mixer_fast_mix(&outputs[0], PX4IO_SERVO_COUNT);
+
+		/* fall back to the float path when no fixed-point table is loaded */
+		if (mixed == 0)
+			mixed = mixer_group.mix(&outputs[0], PX4IO_SERVO_COUNT, &r_mixer_limits);
+
 		in_mixer = false;
 
 		/* the pwm limit call takes care of out of band errors */
@@ -369,6 +564,9 @@ mixer_handle_text(const void *buffer, size_t length)
 		return 1;
 	}
 
+	/* the fixed-point table no longer matches the loaded mixers */
+	fast_output_count = 0;
+
 	px4io_mixdata	*msg = (px4io_mixdata *)buffer;
 
 	isr_debug(2, "mix txt %u", length);
@@ -413,6 +611,9 @@ mixer_handle_text(const void *buffer, size_t length)
 			/* only set mixer ok if no residual is left over */
 			if (resid == 0) {
 				r_status_flags |= PX4IO_P_STATUS_FLAGS_MIXER_OK;
+
+				/* build the fixed-point table for the new configuration */
+				mixer_fast_compile();
 			} else {
 				/* not yet reached the end of the mixer, set as not ok */
 				r_status_flags &= ~PX4IO_P_STATUS_FLAGS_MIXER_OK;
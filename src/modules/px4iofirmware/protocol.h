@@ -172,6 +172,16 @@
 #define PX4IO_PAGE_PWM_INFO		7
 #define PX4IO_RATE_MAP_BASE			0	/* 0..CONFIG_ACTUATOR_COUNT bitmaps of PWM rate groups */
 
+/*
+ * One-transfer poll snapshot for the FMU driver: the status registers and
+ * the raw R/C input page side by side, so the periodic poll costs a single
+ * bus transaction instead of one per page.
+ */
+#define PX4IO_PAGE_POLL_SNAPSHOT	8
+#define PX4IO_P_SNAPSHOT_STATUS_BASE		0	/* STATUS_FLAGS..STATUS_VRSSI, 6 registers */
+#define PX4IO_P_SNAPSHOT_RC_BASE		6	/* RAW_RC_INPUT page, from RC_COUNT */
+#define PX4IO_SNAPSHOT_RC_CHANNELS		18	/* R/C channels carried in the snapshot */
+
 /* setup page */
 #define PX4IO_PAGE_SETUP		50
 #define PX4IO_P_SETUP_FEATURES			0
@@ -192,6 +202,7 @@
 #define PX4IO_P_SETUP_ARMING_FORCE_FAILSAFE	(1 << 8) /* If set, the system will always output the failsafe values */
 #define PX4IO_P_SETUP_ARMING_TERMINATION_FAILSAFE	(1 << 9) /* If set, the system will never return from a failsafe, but remain in failsafe once triggered. */
 #define PX4IO_P_SETUP_ARMING_OVERRIDE_IMMEDIATE	(1 << 10) /* If set then on FMU failure override is immediate. Othewise it waits for the mode switch to go past the override thrshold */
+#define PX4IO_P_SETUP_ARMING_RC_LOSS_FAILSAFE	(1 << 11) /* If set, the preloaded failsafe values are applied as soon as RC input is lost, without waiting for the FMU to react */
 
 #define PX4IO_P_SETUP_PWM_RATES			2	/* bitmask, 0 = low rate, 1 = high rate */
 #define PX4IO_P_SETUP_PWM_DEFAULTRATE		3	/* 'low' PWM frame output rate in Hz */
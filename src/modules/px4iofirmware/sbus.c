@@ -77,6 +77,13 @@
 #define SBUS_SCALE_FACTOR ((SBUS_TARGET_MAX - SBUS_TARGET_MIN) / (SBUS_RANGE_MAX - SBUS_RANGE_MIN))
 #define SBUS_SCALE_OFFSET (int)(SBUS_TARGET_MIN - (SBUS_SCALE_FACTOR * SBUS_RANGE_MIN + 0.5f))
 
+/*
+ * The scale factor is exactly 1000/1600 = 5/8, so the per-channel
+ * conversion runs in scaled integer math - this MCU has no FPU and a
+ * softfloat multiply per channel is the dominant cost of decoding a
+ * frame (same approach as the DSM decoder).
+ */
+
 static int sbus_fd = -1;
 
 static hrt_abstime last_rx_time;
@@ -139,13 +146,19 @@ sbus1_output(uint16_t *values, uint16_t num_values)
 		* currently ignoring single bit channels.  */
 
 		for (unsigned i = 0; (i < num_values) && (i < 16); ++i) {
-			value = (uint16_t)(((values[i] - SBUS_SCALE_OFFSET) / SBUS_SCALE_FACTOR) + .5f);
+			int scaled = (((int)values[i] - SBUS_SCALE_OFFSET) * 8 + 2) / 5;
 
 			/*protect from out of bounds values and limit to 11 bits*/
-			if (value > 0x07ff) {
-				value = 0x07ff;
+			if (scaled < 0) {
+				scaled = 0;
 			}
 
+			if (scaled > 0x07ff) {
+				scaled = 0x07ff;
+			}
+
+			value = (uint16_t)scaled;
+
 			while (offset >= 8) {
 				++byteindex;
 				offset -= 8;
@@ -327,7 +340,7 @@ sbus_decode(hrt_abstime frame_time, uint16_t *values, uint16_t *num_values, bool
 
 
 		/* convert 0-2048 values to 1000-2000 ppm encoding in a not too sloppy fashion */
-		values[channel] = (uint16_t)(value * SBUS_SCALE_FACTOR + .5f) + SBUS_SCALE_OFFSET;
+		values[channel] = (uint16_t)((value * 5 + 4) / 8) + SBUS_SCALE_OFFSET;
 	}
 
 	/* decode switch channels if data fields are wide enough */
@@ -41,9 +41,94 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "logbuffer.h"
 
+/*
+ * Crash-persistent tail ring. It lives in CCM SRAM, which the startup
+ * code neither zeroes nor loads data into, so its contents survive
+ * watchdog and software resets (not a full power cycle). A magic word
+ * guards against interpreting power-on garbage as log data.
+ */
+#define CRASHDUMP_RING_MAGIC	0x474f4c52	/* 'RLOG' */
+#define CRASHDUMP_RING_SIZE	8192
+
+struct crashdump_ring_s {
+	uint32_t magic;
+	uint32_t head;		// next write position in data
+	uint32_t wrapped;	// ring has wrapped at least once
+	uint8_t data[CRASHDUMP_RING_SIZE];
+};
+
+static struct crashdump_ring_s crashdump_ring __attribute__((section(".noinit")));
+
+static void crashdump_ring_write(const void *ptr, int size)
+{
+	if (crashdump_ring.magic != CRASHDUMP_RING_MAGIC) {
+		crashdump_ring.magic = CRASHDUMP_RING_MAGIC;
+		crashdump_ring.head = 0;
+		crashdump_ring.wrapped = 0;
+	}
+
+	const uint8_t *c = (const uint8_t *) ptr;
+
+	while (size > 0) {
+		int n = CRASHDUMP_RING_SIZE - crashdump_ring.head;
+
+		if (n > size) {
+			n = size;
+		}
+
+		memcpy(&(crashdump_ring.data[crashdump_ring.head]), c, n);
+		crashdump_ring.head += n;
+
+		if (crashdump_ring.head >= CRASHDUMP_RING_SIZE) {
+			crashdump_ring.head = 0;
+			crashdump_ring.wrapped = 1;
+		}
+
+		c += n;
+		size -= n;
+	}
+}
+
+int crashdump_ring_flush(const char *path)
+{
+	if (crashdump_ring.magic != CRASHDUMP_RING_MAGIC ||
+	    (crashdump_ring.head == 0 && !crashdump_ring.wrapped)) {
+		// nothing recorded since the last power cycle or flush
+		return 0;
+	}
+
+	int fd = open(path, O_CREAT | O_WRONLY | O_TRUNC);
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	int total = 0;
+
+	// dump oldest bytes first so the file reads as a contiguous stream
+	if (crashdump_ring.wrapped) {
+		total += write(fd, &(crashdump_ring.data[crashdump_ring.head]),
+			       CRASHDUMP_RING_SIZE - crashdump_ring.head);
+	}
+
+	total += write(fd, crashdump_ring.data, crashdump_ring.head);
+
+	fsync(fd);
+	close(fd);
+
+	// start clean so a healthy reboot does not re-dump the same data
+	crashdump_ring.head = 0;
+	crashdump_ring.wrapped = 0;
+
+	return total;
+}
+
 int logbuffer_init(struct logbuffer_s *lb, int size)
 {
 	lb->size  = size;
@@ -99,6 +184,9 @@ bool logbuffer_write(struct logbuffer_s *lb, void *ptr, int size)
 	int p = size - n;	// number of bytes to write
 	memcpy(&(lb->data[lb->write_ptr]), &(c[n]), p);
 	lb->write_ptr = (lb->write_ptr + p) % lb->size;
+
+	// shadow the record into the crash-persistent tail ring
+	crashdump_ring_write(ptr, size);
 	return true;
 }
 
@@ -65,4 +65,11 @@ int logbuffer_get_ptr(struct logbuffer_s *lb, void **ptr, bool *is_part);
 
 void logbuffer_mark_read(struct logbuffer_s *lb, int n);
 
+/*
+ * Crash-persistent tail ring: every byte written to the log buffer is
+ * shadowed into a small ring in CCM SRAM that survives warm resets, so
+ * the last records before a brownout can be recovered on the next boot.
+ */
+int crashdump_ring_flush(const char *path);
+
 #endif
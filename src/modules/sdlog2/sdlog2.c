@@ -56,6 +56,7 @@
 #include <string.h>
 #include <ctype.h>
 #include <systemlib/err.h>
+#include <systemlib/trace.h>
 #include <unistd.h>
 #include <drivers/drv_hrt.h>
 #include <math.h>
@@ -101,6 +102,8 @@
 #include <uORB/topics/vtol_vehicle_status.h>
 #include <uORB/topics/time_offset.h>
 #include <uORB/topics/mc_att_ctrl_status.h>
+#include <uORB/topics/load_governor.h>
+#include <uORB/topics/cpu_load.h>
 
 #include <systemlib/systemlib.h>
 #include <systemlib/param/param.h>
@@ -145,10 +148,13 @@ PARAM_DEFINE_INT32(SDLOG_RATE, -1);
  */
 PARAM_DEFINE_INT32(SDLOG_EXT, -1);
 
-#define LOGBUFFER_WRITE_AND_COUNT(_msg) if (logbuffer_write(&lb, &log_msg, LOG_PACKET_SIZE(_msg))) { \
+#define LOGBUFFER_WRITE_AND_COUNT(_msg) if (!log_rate_check(log_msg.msg_type)) { \
+		/* decimated by the per-message rate table */ \
+	} else if (sdlog2_write_record(&log_msg, LOG_PACKET_SIZE(_msg))) { \
 		log_msgs_written++; \
 	} else { \
 		log_msgs_skipped++; \
+		perf_count(perf_drop); \
 	}
 
 #define LOG_ORB_SUBSCRIBE(_var, _topic) subs.##_var##_sub = orb_subscribe(ORB_ID(##_topic##)); \
@@ -169,10 +175,45 @@ static const int MAX_WRITE_CHUNK = 512;
 static const int MIN_BYTES_TO_WRITE = 512;
 
 static bool _extended_logging = false;
+static bool _delta_logging = false;
 
 #define MOUNTPOINT "/fs/microsd"
 static const char *mountpoint = MOUNTPOINT;
 static const char *log_root = MOUNTPOINT "/log";
+
+/* per-message rate table, loaded from the microSD on every log start */
+#define LOG_RATES_FILE MOUNTPOINT "/etc/log_rates.txt"
+#define LOG_RATES_MAX 32
+
+struct log_rate_entry {
+	uint8_t		msg_type;	/**< LOG_*_MSG id */
+	uint32_t	interval;	/**< minimum interval between records, usec; 0 disables the message */
+	uint64_t	last_time;	/**< time the message was last written */
+};
+
+static struct log_rate_entry log_rates[LOG_RATES_MAX];
+static unsigned log_rates_num = 0;
+static uint8_t log_rate_slot[256];	/**< msg_type -> rate table slot + 1, 0 = no limit */
+static unsigned log_shed_shift = 0;	/**< load governor backoff, stretches the rate table intervals */
+
+/* delta encoding state for the designated high-rate messages (-d option) */
+#define DELTA_BODY_MAX 64		/**< largest body the encoder handles */
+#define DELTA_KEYFRAME_INTERVAL 64	/**< full record every N samples to bound error propagation */
+
+struct delta_state {
+	uint8_t		msg_type;		/**< wrapped LOG_*_MSG id */
+	uint8_t		body_len;		/**< body length of the wrapped message */
+	bool		valid;			/**< prev holds the last record written */
+	uint8_t		count;			/**< records since the last keyframe */
+	uint8_t		prev[DELTA_BODY_MAX];	/**< body of the last record written */
+};
+
+static struct delta_state delta_states[] = {
+	{ .msg_type = LOG_IMU_MSG },
+	{ .msg_type = LOG_IMU1_MSG },
+	{ .msg_type = LOG_IMU2_MSG },
+	{ .msg_type = LOG_ATT_MSG },
+};
 static int mavlink_fd = -1;
 struct logbuffer_s lb;
 
@@ -182,6 +223,40 @@ static pthread_cond_t logbuffer_cond;
 
 static char log_dir[32];
 
+/* full path of the current log file, set by open_log_file() */
+static char log_file_path[64];
+
+/* preallocated log file, recycled across sessions (and boots): the
+ * clusters are reserved while disarmed, so in-flight writes stay within
+ * already allocated clusters instead of stalling on FAT allocation */
+#define PREALLOC_FILE_PATH MOUNTPOINT "/log/prealloc.px4log"
+static unsigned log_prealloc_mb = 32;	/**< preallocation size, 0 disables (-p option) */
+
+/* time/offset index written next to the log file */
+#define LOG_INDEX_INTERVAL 5000000ULL	/* one index entry every 5 seconds */
+
+#pragma pack(push, 1)
+struct log_index_entry_s {
+	uint64_t time;		/**< hrt timestamp, same clock as TIME.StartTime */
+	uint32_t offset;	/**< byte offset into the log file */
+};
+#pragma pack(pop)
+
+/* 1 Hz perf counter snapshots written into the log (PERF message):
+ * the last seen totals per counter, so only deltas are logged */
+#define PERF_SNAPSHOT_INTERVAL 1000000ULL
+#define PERF_SNAPSHOT_MAX 48
+
+struct perf_snapshot_entry {
+	perf_counter_t	handle;		/**< counter this slot tracks */
+	uint64_t	count;		/**< event count at the last snapshot */
+	uint64_t	time_total;	/**< total time at the last snapshot */
+};
+
+static struct perf_snapshot_entry perf_snapshots[PERF_SNAPSHOT_MAX];
+static unsigned perf_snapshots_num = 0;
+static hrt_abstime last_perf_snapshot = 0;
+
 /* statistics counters */
 static uint64_t start_time = 0;
 static unsigned long log_bytes_written = 0;
@@ -207,6 +282,7 @@ static pthread_t logwriter_pthread = 0;
 static pthread_attr_t logwriter_attr;
 
 static perf_counter_t perf_write;
+static perf_counter_t perf_drop;
 
 /**
  * Log buffer writing thread. Open and close file here.
@@ -283,8 +359,194 @@ static int create_log_dir(void);
  */
 static int open_log_file(void);
 
+/**
+ * Make sure a preallocated log file is ready for the next session.
+ * Only called while not logging, the zero fill is slow.
+ */
+static int prealloc_log_file(void);
+
 static int open_perf_file(const char* str);
 
+/**
+ * Load the per-message rate table from the microSD, if present.
+ */
+static void load_log_rates(void);
+
+/**
+ * Check if the per-message rate table allows writing this message now.
+ */
+static bool log_rate_check(uint8_t msg_type);
+
+/**
+ * Write one log record, delta-encoding designated high-rate messages
+ * when delta logging is enabled.
+ */
+static bool sdlog2_write_record(void *msg, int len);
+
+void load_log_rates(void)
+{
+	log_rates_num = 0;
+	memset(log_rate_slot, 0, sizeof(log_rate_slot));
+
+	FILE *f = fopen(LOG_RATES_FILE, "r");
+
+	if (f == NULL) {
+		/* no table on the card, log everything at the poll rate */
+		return;
+	}
+
+	/* one entry per line: message name and maximum rate in Hz,
+	 * e.g. "IMU 200" or "BATT 1"; a rate of 0 disables the message */
+	char line[32];
+
+	while (fgets(line, sizeof(line), f) != NULL && log_rates_num < LOG_RATES_MAX) {
+		char name[8];
+		float rate;
+
+		if (line[0] == '#') {
+			continue;
+		}
+
+		if (sscanf(line, "%7s %f", name, &rate) != 2) {
+			continue;
+		}
+
+		/* resolve the message name against the format table */
+		for (unsigned i = 0; i < log_formats_num; i++) {
+			if (strncmp(name, log_formats[i].name, sizeof(log_formats[i].name)) == 0) {
+				struct log_rate_entry *e = &log_rates[log_rates_num];
+				e->msg_type = log_formats[i].type;
+				e->interval = (rate > 0.0f) ? (uint32_t)(1000000.0f / rate) : 0;
+				e->last_time = 0;
+				log_rates_num++;
+				log_rate_slot[e->msg_type] = log_rates_num;
+				break;
+			}
+		}
+	}
+
+	fclose(f);
+
+	if (log_rates_num > 0) {
+		mavlink_and_console_log_info(mavlink_fd, "[sdlog2] rate table: %u entries", log_rates_num);
+	}
+}
+
+bool log_rate_check(uint8_t msg_type)
+{
+	uint8_t slot = log_rate_slot[msg_type];
+
+	if (slot == 0) {
+		return true;
+	}
+
+	struct log_rate_entry *e = &log_rates[slot - 1];
+
+	if (e->interval == 0) {
+		/* rate 0 disables the message entirely */
+		return false;
+	}
+
+	uint64_t t = hrt_absolute_time();
+
+	if (t - e->last_time < ((uint64_t)e->interval << log_shed_shift)) {
+		return false;
+	}
+
+	e->last_time = t;
+	return true;
+}
+
+bool sdlog2_write_record(void *msg, int len)
+{
+	if (!_delta_logging) {
+		return logbuffer_write(&lb, msg, len);
+	}
+
+	/* look for a delta state matching this message */
+	uint8_t msg_type = ((uint8_t *)msg)[2];
+	struct delta_state *d = NULL;
+
+	for (unsigned i = 0; i < sizeof(delta_states) / sizeof(delta_states[0]); i++) {
+		if (delta_states[i].msg_type == msg_type) {
+			d = &delta_states[i];
+			break;
+		}
+	}
+
+	int body_len = len - LOG_PACKET_HEADER_LEN;
+
+	if (d == NULL || body_len > DELTA_BODY_MAX || (body_len % 4) != 0) {
+		return logbuffer_write(&lb, msg, len);
+	}
+
+	const uint8_t *body = (const uint8_t *)msg + LOG_PACKET_HEADER_LEN;
+
+	/* periodic keyframes bound error propagation after a dropped record */
+	if (!d->valid || d->count >= DELTA_KEYFRAME_INTERVAL) {
+		if (!logbuffer_write(&lb, msg, len)) {
+			return false;
+		}
+
+		memcpy(d->prev, body, body_len);
+		d->body_len = body_len;
+		d->valid = true;
+		d->count = 0;
+		return true;
+	}
+
+	/* XOR against the previous record and LEB128-encode word by word;
+	 * successive sensor samples differ in a few low bits, so the high
+	 * bytes cancel and most varints are one or two bytes long */
+	uint8_t packet[LOG_PACKET_HEADER_LEN + 2 + DELTA_BODY_MAX + DELTA_BODY_MAX / 4];
+	unsigned out = LOG_PACKET_HEADER_LEN + 2;
+
+	for (int w = 0; w < body_len; w += 4) {
+		uint32_t cur, prev;
+		memcpy(&cur, &body[w], 4);
+		memcpy(&prev, &d->prev[w], 4);
+
+		uint32_t v = cur ^ prev;
+
+		do {
+			uint8_t b = v & 0x7f;
+			v >>= 7;
+
+			if (v != 0) {
+				b |= 0x80;
+			}
+
+			packet[out++] = b;
+		} while (v != 0);
+	}
+
+	/* fall back to a keyframe if the encoding did not pay off */
+	if ((int)(out - LOG_PACKET_HEADER_LEN - 2) >= body_len) {
+		if (!logbuffer_write(&lb, msg, len)) {
+			return false;
+		}
+
+		memcpy(d->prev, body, body_len);
+		d->count = 0;
+		return true;
+	}
+
+	packet[0] = HEAD_BYTE1;
+	packet[1] = HEAD_BYTE2;
+	packet[2] = LOG_DELT_MSG;
+	packet[3] = msg_type;
+	packet[4] = out - LOG_PACKET_HEADER_LEN - 2;
+
+	if (!logbuffer_write(&lb, packet, out)) {
+		/* base stays at the last record actually in the stream */
+		return false;
+	}
+
+	memcpy(d->prev, body, body_len);
+	d->count++;
+	return true;
+}
+
 static void
 sdlog2_usage(const char *reason)
 {
@@ -292,13 +554,15 @@ sdlog2_usage(const char *reason)
 		fprintf(stderr, "%s\n", reason);
 	}
 
-	errx(1, "usage: sdlog2 {start|stop|status} [-r <log rate>] [-b <buffer size>] -e -a -t -x\n"
+	errx(1, "usage: sdlog2 {start|stop|status} [-r <log rate>] [-b <buffer size>] [-p <prealloc size>] -e -a -t -x -d\n"
 		 "\t-r\tLog rate in Hz, 0 means unlimited rate\n"
 		 "\t-b\tLog buffer size in KiB, default is 8\n"
+		 "\t-p\tLog file preallocation in MiB, default is 32, 0 disables\n"
 		 "\t-e\tEnable logging by default (if not, can be started by command)\n"
 		 "\t-a\tLog only when armed (can be still overriden by command)\n"
 		 "\t-t\tUse date/time for naming log directories and files\n"
-		 "\t-x\tExtended logging");
+		 "\t-x\tExtended logging\n"
+		 "\t-d\tDelta-encode high-rate messages (needs delta-aware log tools)");
 }
 
 /**
@@ -434,7 +698,8 @@ int open_log_file()
 {
 	/* string to hold the path to the log */
 	char log_file_name[32] = "";
-	char log_file_path[64] = "";
+
+	log_file_path[0] = '\0';
 
 	struct timespec ts;
 	clock_gettime(CLOCK_REALTIME, &ts);
@@ -471,7 +736,19 @@ int open_log_file()
 		}
 	}
 
-	int fd = open(log_file_path, O_CREAT | O_WRONLY | O_DSYNC);
+	/* recycle the preallocated file when there is one: rename is a pure
+	 * directory operation, the reserved clusters carry over and the log
+	 * writes stay within them */
+	int fd = -1;
+
+	if (file_exist(PREALLOC_FILE_PATH) &&
+	    rename(PREALLOC_FILE_PATH, log_file_path) == 0) {
+		fd = open(log_file_path, O_WRONLY | O_DSYNC);
+	}
+
+	if (fd < 0) {
+		fd = open(log_file_path, O_CREAT | O_WRONLY | O_DSYNC);
+	}
 
 	if (fd < 0) {
 		mavlink_and_console_log_critical(mavlink_fd, "[sdlog2] failed opening: %s", log_file_name);
@@ -483,6 +760,51 @@ int open_log_file()
 	return fd;
 }
 
+int prealloc_log_file()
+{
+	if (log_prealloc_mb == 0 || file_exist(PREALLOC_FILE_PATH)) {
+		return OK;
+	}
+
+	int fd = open(PREALLOC_FILE_PATH, O_CREAT | O_WRONLY);
+
+	if (fd < 0) {
+		warn("failed creating %s", PREALLOC_FILE_PATH);
+		return -1;
+	}
+
+	/* writing the fill sequentially makes FAT hand out contiguous
+	 * clusters on a non-fragmented card */
+	const unsigned chunk = 16 * 1024;
+	uint8_t *zeros = calloc(1, chunk);
+
+	if (zeros == NULL) {
+		close(fd);
+		unlink(PREALLOC_FILE_PATH);
+		return -1;
+	}
+
+	int ret = OK;
+
+	for (unsigned written = 0; written < log_prealloc_mb * 1024 * 1024; written += chunk) {
+		if (write(fd, zeros, chunk) != (int)chunk) {
+			warn("prealloc write failed");
+			ret = -1;
+			break;
+		}
+	}
+
+	free(zeros);
+	fsync(fd);
+	close(fd);
+
+	if (ret != OK) {
+		unlink(PREALLOC_FILE_PATH);
+	}
+
+	return ret;
+}
+
 int open_perf_file(const char* str)
 {
 	/* string to hold the path to the log */
@@ -544,6 +866,15 @@ static void *logwriter_thread(void *arg)
 		return NULL;
 	}
 
+	/* sidecar time/offset index so tools and partial downloads can seek
+	 * straight to a time range instead of scanning the whole log */
+	char index_file_path[68];
+	snprintf(index_file_path, sizeof(index_file_path), "%s.idx", log_file_path);
+
+	int index_fd = open(index_file_path, O_CREAT | O_WRONLY);
+
+	hrt_abstime last_index_time = 0;
+
 	struct logbuffer_s *logbuf = (struct logbuffer_s *)arg;
 
 	/* write log messages formats, version and parameters */
@@ -565,43 +896,61 @@ static void *logwriter_thread(void *arg)
 
 	bool is_part = false;
 
+	/* Double buffering: data is staged out of the ring under the mutex and
+	 * the ring space released immediately, so a 200+ ms card latency spike
+	 * stalls only this thread while the producer keeps filling the ring.
+	 * Full sectors are written whenever possible to keep the file offset
+	 * sector-aligned and spare the FAT layer read-modify-write cycles. */
+	static uint8_t write_buf[2][MAX_WRITE_CHUNK];
+	unsigned write_buf_sel = 0;
+
 	while (true) {
 		/* make sure threads are synchronized */
 		pthread_mutex_lock(&logbuffer_mutex);
 
-		/* update read pointer if needed */
-		if (n > 0) {
-			logbuffer_mark_read(&lb, n);
-		}
-
 		/* only wait if no data is available to process */
 		if (should_wait && !logwriter_should_exit) {
 			/* blocking wait for new data at this line */
 			pthread_cond_wait(&logbuffer_cond, &logbuffer_mutex);
 		}
 
-		/* only get pointer to thread-safe data, do heavy I/O a few lines down */
-		int available = logbuffer_get_ptr(logbuf, &read_ptr, &is_part);
+		bool flush = main_thread_should_exit || logwriter_should_exit;
 
-		/* continue */
-		pthread_mutex_unlock(&logbuffer_mutex);
+		int available = logbuffer_count(logbuf);
 
-		if (available > 0) {
+		/* stage one full sector, or whatever is left when shutting down */
+		uint8_t *stage = write_buf[write_buf_sel];
+		n = 0;
 
-			/* do heavy IO here */
-			if (available > MAX_WRITE_CHUNK) {
-				n = MAX_WRITE_CHUNK;
+		if (available >= MAX_WRITE_CHUNK || (flush && available > 0)) {
+			n = (available > MAX_WRITE_CHUNK) ? MAX_WRITE_CHUNK : available;
 
-			} else {
-				n = available;
+			int staged = 0;
+
+			while (staged < n) {
+				int chunk = logbuffer_get_ptr(logbuf, &read_ptr, &is_part);
+
+				if (chunk > n - staged) {
+					chunk = n - staged;
+				}
+
+				memcpy(&stage[staged], read_ptr, chunk);
+				logbuffer_mark_read(logbuf, chunk);
+				staged += chunk;
 			}
+		}
+
+		/* continue */
+		pthread_mutex_unlock(&logbuffer_mutex);
+
+		if (n > 0) {
+			/* flip buffers, then do the heavy IO from the staged copy */
+			write_buf_sel ^= 1;
 
 			perf_begin(perf_write);
-			n = write(log_fd, read_ptr, n);
+			n = write(log_fd, stage, n);
 			perf_end(perf_write);
 
-			should_wait = (n == available) && !is_part;
-
 			if (n < 0) {
 				main_thread_should_exit = true;
 				err(1, "error writing log file");
@@ -611,11 +960,27 @@ static void *logwriter_thread(void *arg)
 				log_bytes_written += n;
 			}
 
-		} else {
-			n = 0;
+			/* index the current write position every few seconds */
+			if (index_fd >= 0 && hrt_elapsed_time(&last_index_time) > LOG_INDEX_INTERVAL) {
+				struct log_index_entry_s idx;
+				idx.time = hrt_absolute_time();
+				idx.offset = log_bytes_written;
+
+				if (write(index_fd, &idx, sizeof(idx)) != sizeof(idx)) {
+					/* the index is best-effort, stop on error */
+					close(index_fd);
+					index_fd = -1;
+				}
+
+				last_index_time = idx.time;
+			}
+
+			/* keep draining while at least a sector is pending */
+			should_wait = false;
 
+		} else {
 			/* exit only with empty buffer */
-			if (main_thread_should_exit || logwriter_should_exit) {
+			if (flush && available == 0) {
 				break;
 			}
 
@@ -624,6 +989,11 @@ static void *logwriter_thread(void *arg)
 
 		if (++poll_count == 10) {
 			fsync(log_fd);
+
+			if (index_fd >= 0) {
+				fsync(index_fd);
+			}
+
 			poll_count = 0;
 
 		}
@@ -641,6 +1011,11 @@ static void *logwriter_thread(void *arg)
 	fsync(log_fd);
 	close(log_fd);
 
+	if (index_fd >= 0) {
+		fsync(index_fd);
+		close(index_fd);
+	}
+
 	return NULL;
 }
 
@@ -656,6 +1031,15 @@ void sdlog2_start_log()
 		exit(1);
 	}
 
+	/* pick up rate table edits without a reboot */
+	load_log_rates();
+
+	/* every log file starts with keyframes */
+	for (unsigned i = 0; i < sizeof(delta_states) / sizeof(delta_states[0]); i++) {
+		delta_states[i].valid = false;
+		delta_states[i].count = 0;
+	}
+
 	/* initialize statistics counter */
 	log_bytes_written = 0;
 	start_time = hrt_absolute_time();
@@ -674,8 +1058,9 @@ void sdlog2_start_log()
 
 	logwriter_should_exit = false;
 
-	/* allocate write performance counter */
+	/* allocate write performance counters */
 	perf_write = perf_alloc(PC_ELAPSED, "sd write");
+	perf_drop = perf_alloc(PC_COUNT, "sd drop");
 
 	/* start log buffer emptying thread */
 	if (0 != pthread_create(&logwriter_pthread, &logwriter_attr, logwriter_thread, &lb)) {
@@ -725,11 +1110,15 @@ void sdlog2_stop_log()
 	perf_print_all(perf_fd);
 	close(perf_fd);
 
-	/* free log writer performance counter */
+	/* free log writer performance counters */
 	perf_free(perf_write);
+	perf_free(perf_drop);
 
 	mavlink_and_console_log_info(mavlink_fd, "[sdlog2] logging stopped");
 
+	/* replenish the preallocated file for the next session */
+	prealloc_log_file();
+
 	sdlog2_status();
 }
 
@@ -853,7 +1242,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 	 * set error flag instead */
 	bool err_flag = false;
 
-	while ((ch = getopt(argc, argv, "r:b:eatx")) != EOF) {
+	while ((ch = getopt(argc, argv, "r:b:p:eatxd")) != EOF) {
 		switch (ch) {
 		case 'r': {
 				unsigned long r = strtoul(optarg, NULL, 10);
@@ -877,6 +1266,10 @@ int sdlog2_thread_main(int argc, char *argv[])
 			}
 			break;
 
+		case 'p':
+			log_prealloc_mb = strtoul(optarg, NULL, 10);
+			break;
+
 		case 'e':
 			log_on_start = true;
 			break;
@@ -893,6 +1286,10 @@ int sdlog2_thread_main(int argc, char *argv[])
 			_extended_logging = true;
 			break;
 
+		case 'd':
+			_delta_logging = true;
+			break;
+
 		case '?':
 			if (optopt == 'c') {
 				warnx("option -%c requires an argument", optopt);
@@ -970,6 +1367,13 @@ int sdlog2_thread_main(int argc, char *argv[])
 		err(1, "ERR: failed creating log dir: %s", log_root);
 	}
 
+	/* recover the crash-persistent log tail left by the previous session */
+	int dumped = crashdump_ring_flush(MOUNTPOINT "/crashdump.bin");
+
+	if (dumped > 0) {
+		warnx("saved %i bytes of pre-reset log data to crashdump.bin", dumped);
+	}
+
 	/* copy conversion scripts */
 	const char *converter_in = "/etc/logging/conv.zip";
 	char *converter_out = malloc(64);
@@ -979,6 +1383,11 @@ int sdlog2_thread_main(int argc, char *argv[])
 		warn("unable to copy conversion scripts");
 	}
 
+	/* reserve the clusters for the first log while still on the ground */
+	if (prealloc_log_file() != OK) {
+		warnx("log preallocation failed, logging will allocate in flight");
+	}
+
 	free(converter_out);
 
 	/* initialize log buffer with specified size */
@@ -991,11 +1400,14 @@ int sdlog2_thread_main(int argc, char *argv[])
 	struct vehicle_status_s buf_status;
 
 	struct vehicle_gps_position_s buf_gps_pos;
+	struct load_governor_s buf_gov;
 
 	memset(&buf_status, 0, sizeof(buf_status));
 
 	memset(&buf_gps_pos, 0, sizeof(buf_gps_pos));
 
+	memset(&buf_gov, 0, sizeof(buf_gov));
+
 	/* warning! using union here to save memory, elements should be used separately! */
 	union {
 		struct vehicle_command_s cmd;
@@ -1031,6 +1443,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		struct vtol_vehicle_status_s vtol_status;
 		struct time_offset_s time_offset;
 		struct mc_att_ctrl_status_s mc_att_ctrl_status;
+		struct cpu_load_s cpu_load;
 	} buf;
 
 	memset(&buf, 0, sizeof(buf));
@@ -1077,6 +1490,9 @@ int sdlog2_thread_main(int argc, char *argv[])
 			struct log_ENCD_s log_ENCD;
 			struct log_TSYN_s log_TSYN;
 			struct log_MACS_s log_MACS;
+			struct log_LOAD_s log_LOAD;
+			struct log_TRAC_s log_TRAC;
+			struct log_PERF_s log_PERF;
 		} body;
 	} log_msg = {
 		LOG_PACKET_HEADER_INIT(0)
@@ -1119,6 +1535,8 @@ int sdlog2_thread_main(int argc, char *argv[])
 		int encoders_sub;
 		int tsync_sub;
 		int mc_att_ctrl_status_sub;
+		int load_gov_sub;
+		int cpu_load_sub;
 	} subs;
 
 	subs.cmd_sub = orb_subscribe(ORB_ID(vehicle_command));
@@ -1152,6 +1570,8 @@ int sdlog2_thread_main(int argc, char *argv[])
 	subs.wind_sub = orb_subscribe(ORB_ID(wind_estimate));
 	subs.tsync_sub = orb_subscribe(ORB_ID(time_offset));
 	subs.mc_att_ctrl_status_sub = orb_subscribe(ORB_ID(mc_att_ctrl_status));
+	subs.load_gov_sub = orb_subscribe(ORB_ID(load_governor));
+	subs.cpu_load_sub = orb_subscribe(ORB_ID(cpu_load));
 
 	/* we need to rate-limit wind, as we do not need the full update rate */
 	orb_set_interval(subs.wind_sub, 90);
@@ -1170,6 +1590,105 @@ int sdlog2_thread_main(int argc, char *argv[])
 		subs.sat_info_sub = 0;
 	}
 
+	/* topics below are collected with one bulk orb_snapshot() pass per
+	 * iteration instead of individual orb_check/orb_copy round trips */
+	enum {
+		SNAP_VTOL_STATUS = 0,
+		SNAP_SAT_INFO,
+		SNAP_SENSOR,
+		SNAP_ATT,
+		SNAP_ATT_SP,
+		SNAP_RATES_SP,
+		SNAP_ACT_OUTPUTS,
+		SNAP_ACT_CONTROLS,
+		SNAP_ACT_CONTROLS_1,
+		SNAP_LOCAL_POS,
+		SNAP_LOCAL_POS_SP,
+		SNAP_GLOBAL_POS,
+		SNAP_TRIPLET,
+		SNAP_VICON_POS,
+		SNAP_VISION_POS,
+		SNAP_FLOW,
+		SNAP_RC,
+		SNAP_AIRSPEED,
+		SNAP_ESC,
+		SNAP_GLOBAL_VEL_SP,
+		SNAP_BATTERY,
+		SNAP_SYSTEM_POWER,
+		SNAP_TELEMETRY_FIRST,
+		SNAP_TELEMETRY_LAST = SNAP_TELEMETRY_FIRST + TELEMETRY_STATUS_ORB_ID_NUM - 1,
+		SNAP_RANGE_FINDER,
+		SNAP_ESTIMATOR_STATUS,
+		SNAP_TECS_STATUS,
+		SNAP_WIND,
+		SNAP_ENCODERS,
+		SNAP_TSYNC,
+		SNAP_CPU_LOAD,
+		SNAP_MC_ATT_CTRL_STATUS,
+		SNAP_COUNT
+	};
+
+	orb_id_t snap_metas[SNAP_COUNT];
+	int snap_handles[SNAP_COUNT];
+	bool snap_updated[SNAP_COUNT];
+	const uint8_t *snap_data[SNAP_COUNT];
+
+#define SNAP_INIT(_idx, _meta, _sub) \
+	do { snap_metas[_idx] = _meta; snap_handles[_idx] = _sub; } while (0)
+
+	SNAP_INIT(SNAP_VTOL_STATUS, ORB_ID(vtol_vehicle_status), subs.vtol_status_sub);
+	SNAP_INIT(SNAP_SAT_INFO, ORB_ID(satellite_info), _extended_logging ? subs.sat_info_sub : -1);
+	SNAP_INIT(SNAP_SENSOR, ORB_ID(sensor_combined), subs.sensor_sub);
+	SNAP_INIT(SNAP_ATT, ORB_ID(vehicle_attitude), subs.att_sub);
+	SNAP_INIT(SNAP_ATT_SP, ORB_ID(vehicle_attitude_setpoint), subs.att_sp_sub);
+	SNAP_INIT(SNAP_RATES_SP, ORB_ID(vehicle_rates_setpoint), subs.rates_sp_sub);
+	SNAP_INIT(SNAP_ACT_OUTPUTS, ORB_ID(actuator_outputs), subs.act_outputs_sub);
+	SNAP_INIT(SNAP_ACT_CONTROLS, ORB_ID_VEHICLE_ATTITUDE_CONTROLS, subs.act_controls_sub);
+	SNAP_INIT(SNAP_ACT_CONTROLS_1, ORB_ID(actuator_controls_1), subs.act_controls_1_sub);
+	SNAP_INIT(SNAP_LOCAL_POS, ORB_ID(vehicle_local_position), subs.local_pos_sub);
+	SNAP_INIT(SNAP_LOCAL_POS_SP, ORB_ID(vehicle_local_position_setpoint), subs.local_pos_sp_sub);
+	SNAP_INIT(SNAP_GLOBAL_POS, ORB_ID(vehicle_global_position), subs.global_pos_sub);
+	SNAP_INIT(SNAP_TRIPLET, ORB_ID(position_setpoint_triplet), subs.triplet_sub);
+	SNAP_INIT(SNAP_VICON_POS, ORB_ID(vehicle_vicon_position), subs.vicon_pos_sub);
+	SNAP_INIT(SNAP_VISION_POS, ORB_ID(vision_position_estimate), subs.vision_pos_sub);
+	SNAP_INIT(SNAP_FLOW, ORB_ID(optical_flow), subs.flow_sub);
+	SNAP_INIT(SNAP_RC, ORB_ID(rc_channels), subs.rc_sub);
+	SNAP_INIT(SNAP_AIRSPEED, ORB_ID(airspeed), subs.airspeed_sub);
+	SNAP_INIT(SNAP_ESC, ORB_ID(esc_status), subs.esc_sub);
+	SNAP_INIT(SNAP_GLOBAL_VEL_SP, ORB_ID(vehicle_global_velocity_setpoint), subs.global_vel_sp_sub);
+	SNAP_INIT(SNAP_BATTERY, ORB_ID(battery_status), subs.battery_sub);
+	SNAP_INIT(SNAP_SYSTEM_POWER, ORB_ID(system_power), subs.system_power_sub);
+
+	for (int i = 0; i < TELEMETRY_STATUS_ORB_ID_NUM; i++) {
+		SNAP_INIT(SNAP_TELEMETRY_FIRST + i, telemetry_status_orb_id[i], subs.telemetry_subs[i]);
+	}
+
+	SNAP_INIT(SNAP_RANGE_FINDER, ORB_ID(sensor_range_finder), subs.range_finder_sub);
+	SNAP_INIT(SNAP_ESTIMATOR_STATUS, ORB_ID(estimator_status), subs.estimator_status_sub);
+	SNAP_INIT(SNAP_TECS_STATUS, ORB_ID(tecs_status), subs.tecs_status_sub);
+	SNAP_INIT(SNAP_WIND, ORB_ID(wind_estimate), subs.wind_sub);
+	SNAP_INIT(SNAP_ENCODERS, ORB_ID(encoders), subs.encoders_sub);
+	SNAP_INIT(SNAP_TSYNC, ORB_ID(time_offset), subs.tsync_sub);
+	SNAP_INIT(SNAP_CPU_LOAD, ORB_ID(cpu_load), subs.cpu_load_sub);
+	SNAP_INIT(SNAP_MC_ATT_CTRL_STATUS, ORB_ID(mc_att_ctrl_status), subs.mc_att_ctrl_status_sub);
+
+	/* worst case all topics of the set update in the same iteration */
+	size_t snap_buffer_size = 0;
+
+	for (unsigned i = 0; i < SNAP_COUNT; i++) {
+		snap_buffer_size += snap_metas[i]->o_size;
+	}
+
+	uint8_t *snap_buffer = malloc(snap_buffer_size);
+
+	if (snap_buffer == NULL) {
+		errx(1, "can't allocate snapshot buffer");
+	}
+
+	/* copy one topic out of the last snapshot, replaces copy_if_updated() */
+#define SNAP_COPY(_idx, _buf) \
+	(snap_updated[_idx] && (memcpy(_buf, snap_data[_idx], snap_metas[_idx]->o_size), true))
+
 	/* close non-needed fd's */
 
 	/* close stdin */
@@ -1236,10 +1755,36 @@ int sdlog2_thread_main(int argc, char *argv[])
 			gps_time = buf_gps_pos.time_utc_usec;
 		}
 
+		/* --- LOAD GOVERNOR - LOG SHEDDING --- */
+		if (copy_if_updated(ORB_ID(load_governor), subs.load_gov_sub, &buf_gov)) {
+			/* each level above LOGGING doubles the rate table intervals */
+			log_shed_shift = (buf_gov.shed_level >= LOAD_SHED_LOGGING) ?
+					 (buf_gov.shed_level - LOAD_SHED_LOGGING + 1) : 0;
+		}
+
 		if (!logging_enabled) {
 			continue;
 		}
 
+		/* --- BULK TOPIC SNAPSHOT --- */
+		if (orb_snapshot(snap_metas, snap_handles, SNAP_COUNT,
+				 snap_buffer, snap_buffer_size, snap_updated) < 0) {
+			/* keep the previous data and try again next iteration */
+			memset(snap_updated, 0, sizeof(snap_updated));
+		}
+
+		{
+			const uint8_t *p = snap_buffer;
+
+			for (unsigned i = 0; i < SNAP_COUNT; i++) {
+				snap_data[i] = p;
+
+				if (snap_updated[i]) {
+					p += snap_metas[i]->o_size;
+				}
+			}
+		}
+
 		pthread_mutex_lock(&logbuffer_mutex);
 
 		/* write time stamp message */
@@ -1247,6 +1792,64 @@ int sdlog2_thread_main(int argc, char *argv[])
 		log_msg.body.log_TIME.t = hrt_absolute_time();
 		LOGBUFFER_WRITE_AND_COUNT(TIME);
 
+		/* --- TRACE RING --- */
+		{
+			struct trace_record_s trec;
+
+			/* drain the trace ring; empty unless tracing has been started */
+			while (trace_read(&trec) == 0) {
+				log_msg.msg_type = LOG_TRAC_MSG;
+				log_msg.body.log_TRAC.t = trec.timestamp;
+				log_msg.body.log_TRAC.event = trec.event;
+				log_msg.body.log_TRAC.arg = trec.arg;
+				LOGBUFFER_WRITE_AND_COUNT(TRAC);
+			}
+		}
+
+		/* --- PERF COUNTERS --- */
+		if (hrt_elapsed_time(&last_perf_snapshot) > PERF_SNAPSHOT_INTERVAL) {
+			for (perf_counter_t h = perf_next(NULL); h != NULL; h = perf_next(h)) {
+				uint64_t count = perf_event_count(h);
+				uint64_t time_total = perf_time_total(h);
+
+				/* find (or claim) the slot remembering the last totals */
+				unsigned s;
+
+				for (s = 0; s < perf_snapshots_num; s++) {
+					if (perf_snapshots[s].handle == h) {
+						break;
+					}
+				}
+
+				if (s == perf_snapshots_num) {
+					if (perf_snapshots_num >= PERF_SNAPSHOT_MAX) {
+						continue;
+					}
+
+					perf_snapshots[perf_snapshots_num++] = (struct perf_snapshot_entry) {
+						.handle = h
+					};
+				}
+
+				/* idle counters don't earn log bandwidth */
+				if (count == perf_snapshots[s].count &&
+				    time_total == perf_snapshots[s].time_total) {
+					continue;
+				}
+
+				log_msg.msg_type = LOG_PERF_MSG;
+				strncpy(log_msg.body.log_PERF.name, perf_name(h), sizeof(log_msg.body.log_PERF.name));
+				log_msg.body.log_PERF.count = count - perf_snapshots[s].count;
+				log_msg.body.log_PERF.time_us = time_total - perf_snapshots[s].time_total;
+				LOGBUFFER_WRITE_AND_COUNT(PERF);
+
+				perf_snapshots[s].count = count;
+				perf_snapshots[s].time_total = time_total;
+			}
+
+			last_perf_snapshot = hrt_absolute_time();
+		}
+
 		/* --- VEHICLE STATUS --- */
 		if (status_updated) {
 			log_msg.msg_type = LOG_STAT_MSG;
@@ -1261,7 +1864,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- VTOL VEHICLE STATUS --- */
-		if(copy_if_updated(ORB_ID(vtol_vehicle_status), subs.vtol_status_sub, &buf.vtol_status)) {
+		if (SNAP_COPY(SNAP_VTOL_STATUS, &buf.vtol_status)) {
 			log_msg.msg_type = LOG_VTOL_MSG;
 			log_msg.body.log_VTOL.airspeed_tot = buf.vtol_status.airspeed_tot;
 			LOGBUFFER_WRITE_AND_COUNT(VTOL);
@@ -1292,7 +1895,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		/* --- SATELLITE INFO - UNIT #1 --- */
 		if (_extended_logging) {
 
-			if (copy_if_updated(ORB_ID(satellite_info), subs.sat_info_sub, &buf.sat_info)) {
+			if (SNAP_COPY(SNAP_SAT_INFO, &buf.sat_info)) {
 
 				/* log the SNR of each satellite for a detailed view of signal quality */
 				unsigned sat_info_count = MIN(buf.sat_info.count, sizeof(buf.sat_info.snr) / sizeof(buf.sat_info.snr[0]));
@@ -1338,7 +1941,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- SENSOR COMBINED --- */
-		if (copy_if_updated(ORB_ID(sensor_combined), subs.sensor_sub, &buf.sensor)) {
+		if (SNAP_COPY(SNAP_SENSOR, &buf.sensor)) {
 			bool write_IMU = false;
 			bool write_IMU1 = false;
 			bool write_IMU2 = false;
@@ -1480,7 +2083,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- ATTITUDE --- */
-		if (copy_if_updated(ORB_ID(vehicle_attitude), subs.att_sub, &buf.att)) {
+		if (SNAP_COPY(SNAP_ATT, &buf.att)) {
 			log_msg.msg_type = LOG_ATT_MSG;
 			log_msg.body.log_ATT.q_w = buf.att.q[0];
 			log_msg.body.log_ATT.q_x = buf.att.q[1];
@@ -1499,7 +2102,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- ATTITUDE SETPOINT --- */
-		if (copy_if_updated(ORB_ID(vehicle_attitude_setpoint), subs.att_sp_sub, &buf.att_sp)) {
+		if (SNAP_COPY(SNAP_ATT_SP, &buf.att_sp)) {
 			log_msg.msg_type = LOG_ATSP_MSG;
 			log_msg.body.log_ATSP.roll_sp = buf.att_sp.roll_body;
 			log_msg.body.log_ATSP.pitch_sp = buf.att_sp.pitch_body;
@@ -1513,7 +2116,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- RATES SETPOINT --- */
-		if (copy_if_updated(ORB_ID(vehicle_rates_setpoint), subs.rates_sp_sub, &buf.rates_sp)) {
+		if (SNAP_COPY(SNAP_RATES_SP, &buf.rates_sp)) {
 			log_msg.msg_type = LOG_ARSP_MSG;
 			log_msg.body.log_ARSP.roll_rate_sp = buf.rates_sp.roll;
 			log_msg.body.log_ARSP.pitch_rate_sp = buf.rates_sp.pitch;
@@ -1522,14 +2125,14 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- ACTUATOR OUTPUTS --- */
-		if (copy_if_updated(ORB_ID(actuator_outputs), subs.act_outputs_sub, &buf.act_outputs)) {
+		if (SNAP_COPY(SNAP_ACT_OUTPUTS, &buf.act_outputs)) {
 			log_msg.msg_type = LOG_OUT0_MSG;
 			memcpy(log_msg.body.log_OUT0.output, buf.act_outputs.output, sizeof(log_msg.body.log_OUT0.output));
 			LOGBUFFER_WRITE_AND_COUNT(OUT0);
 		}
 
 		/* --- ACTUATOR CONTROL --- */
-		if (copy_if_updated(ORB_ID_VEHICLE_ATTITUDE_CONTROLS, subs.act_controls_sub, &buf.act_controls)) {
+		if (SNAP_COPY(SNAP_ACT_CONTROLS, &buf.act_controls)) {
 			log_msg.msg_type = LOG_ATTC_MSG;
 			log_msg.body.log_ATTC.roll = buf.act_controls.control[0];
 			log_msg.body.log_ATTC.pitch = buf.act_controls.control[1];
@@ -1539,7 +2142,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- ACTUATOR CONTROL FW VTOL --- */
-		if(copy_if_updated(ORB_ID(actuator_controls_1),subs.act_controls_1_sub,&buf.act_controls)) {
+		if (SNAP_COPY(SNAP_ACT_CONTROLS_1, &buf.act_controls)) {
 			log_msg.msg_type = LOG_ATC1_MSG;
 			log_msg.body.log_ATTC.roll = buf.act_controls.control[0];
 			log_msg.body.log_ATTC.pitch = buf.act_controls.control[1];
@@ -1549,7 +2152,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- LOCAL POSITION --- */
-		if (copy_if_updated(ORB_ID(vehicle_local_position), subs.local_pos_sub, &buf.local_pos)) {
+		if (SNAP_COPY(SNAP_LOCAL_POS, &buf.local_pos)) {
 			log_msg.msg_type = LOG_LPOS_MSG;
 			log_msg.body.log_LPOS.x = buf.local_pos.x;
 			log_msg.body.log_LPOS.y = buf.local_pos.y;
@@ -1575,7 +2178,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- LOCAL POSITION SETPOINT --- */
-		if (copy_if_updated(ORB_ID(vehicle_local_position_setpoint), subs.local_pos_sp_sub, &buf.local_pos_sp)) {
+		if (SNAP_COPY(SNAP_LOCAL_POS_SP, &buf.local_pos_sp)) {
 			log_msg.msg_type = LOG_LPSP_MSG;
 			log_msg.body.log_LPSP.x = buf.local_pos_sp.x;
 			log_msg.body.log_LPSP.y = buf.local_pos_sp.y;
@@ -1591,7 +2194,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- GLOBAL POSITION --- */
-		if (copy_if_updated(ORB_ID(vehicle_global_position), subs.global_pos_sub, &buf.global_pos)) {
+		if (SNAP_COPY(SNAP_GLOBAL_POS, &buf.global_pos)) {
 			log_msg.msg_type = LOG_GPOS_MSG;
 			log_msg.body.log_GPOS.lat = buf.global_pos.lat * 1e7;
 			log_msg.body.log_GPOS.lon = buf.global_pos.lon * 1e7;
@@ -1610,7 +2213,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- GLOBAL POSITION SETPOINT --- */
-		if (copy_if_updated(ORB_ID(position_setpoint_triplet), subs.triplet_sub, &buf.triplet)) {
+		if (SNAP_COPY(SNAP_TRIPLET, &buf.triplet)) {
 
 			if (buf.triplet.current.valid) {
 				log_msg.msg_type = LOG_GPSP_MSG;
@@ -1628,7 +2231,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- VICON POSITION --- */
-		if (copy_if_updated(ORB_ID(vehicle_vicon_position), subs.vicon_pos_sub, &buf.vicon_pos)) {
+		if (SNAP_COPY(SNAP_VICON_POS, &buf.vicon_pos)) {
 			log_msg.msg_type = LOG_VICN_MSG;
 			log_msg.body.log_VICN.x = buf.vicon_pos.x;
 			log_msg.body.log_VICN.y = buf.vicon_pos.y;
@@ -1640,7 +2243,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- VISION POSITION --- */
-		if (copy_if_updated(ORB_ID(vision_position_estimate), subs.vision_pos_sub, &buf.vision_pos)) {
+		if (SNAP_COPY(SNAP_VISION_POS, &buf.vision_pos)) {
 			log_msg.msg_type = LOG_VISN_MSG;
 			log_msg.body.log_VISN.x = buf.vision_pos.x;
 			log_msg.body.log_VISN.y = buf.vision_pos.y;
@@ -1656,7 +2259,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- FLOW --- */
-		if (copy_if_updated(ORB_ID(optical_flow), subs.flow_sub, &buf.flow)) {
+		if (SNAP_COPY(SNAP_FLOW, &buf.flow)) {
 			log_msg.msg_type = LOG_FLOW_MSG;
 			log_msg.body.log_FLOW.ground_distance_m = buf.flow.ground_distance_m;
 			log_msg.body.log_FLOW.gyro_temperature = buf.flow.gyro_temperature;
@@ -1672,7 +2275,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- RC CHANNELS --- */
-		if (copy_if_updated(ORB_ID(rc_channels), subs.rc_sub, &buf.rc)) {
+		if (SNAP_COPY(SNAP_RC, &buf.rc)) {
 			log_msg.msg_type = LOG_RC_MSG;
 			/* Copy only the first 8 channels of 14 */
 			memcpy(log_msg.body.log_RC.channel, buf.rc.channels, sizeof(log_msg.body.log_RC.channel));
@@ -1682,7 +2285,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- AIRSPEED --- */
-		if (copy_if_updated(ORB_ID(airspeed), subs.airspeed_sub, &buf.airspeed)) {
+		if (SNAP_COPY(SNAP_AIRSPEED, &buf.airspeed)) {
 			log_msg.msg_type = LOG_AIRS_MSG;
 			log_msg.body.log_AIRS.indicated_airspeed = buf.airspeed.indicated_airspeed_m_s;
 			log_msg.body.log_AIRS.true_airspeed = buf.airspeed.true_airspeed_m_s;
@@ -1691,7 +2294,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- ESCs --- */
-		if (copy_if_updated(ORB_ID(esc_status), subs.esc_sub, &buf.esc)) {
+		if (SNAP_COPY(SNAP_ESC, &buf.esc)) {
 			for (uint8_t i = 0; i < buf.esc.esc_count; i++) {
 				log_msg.msg_type = LOG_ESC_MSG;
 				log_msg.body.log_ESC.counter = buf.esc.counter;
@@ -1711,7 +2314,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- GLOBAL VELOCITY SETPOINT --- */
-		if (copy_if_updated(ORB_ID(vehicle_global_velocity_setpoint), subs.global_vel_sp_sub, &buf.global_vel_sp)) {
+		if (SNAP_COPY(SNAP_GLOBAL_VEL_SP, &buf.global_vel_sp)) {
 			log_msg.msg_type = LOG_GVSP_MSG;
 			log_msg.body.log_GVSP.vx = buf.global_vel_sp.vx;
 			log_msg.body.log_GVSP.vy = buf.global_vel_sp.vy;
@@ -1720,7 +2323,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- BATTERY --- */
-		if (copy_if_updated(ORB_ID(battery_status), subs.battery_sub, &buf.battery)) {
+		if (SNAP_COPY(SNAP_BATTERY, &buf.battery)) {
 			log_msg.msg_type = LOG_BATT_MSG;
 			log_msg.body.log_BATT.voltage = buf.battery.voltage_v;
 			log_msg.body.log_BATT.voltage_filtered = buf.battery.voltage_filtered_v;
@@ -1730,7 +2333,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- SYSTEM POWER RAILS --- */
-		if (copy_if_updated(ORB_ID(system_power), subs.system_power_sub, &buf.system_power)) {
+		if (SNAP_COPY(SNAP_SYSTEM_POWER, &buf.system_power)) {
 			log_msg.msg_type = LOG_PWR_MSG;
 			log_msg.body.log_PWR.peripherals_5v = buf.system_power.voltage5V_v;
 			log_msg.body.log_PWR.usb_ok = buf.system_power.usb_connected;
@@ -1749,7 +2352,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 
 		/* --- TELEMETRY --- */
 		for (int i = 0; i < TELEMETRY_STATUS_ORB_ID_NUM; i++) {
-			if (copy_if_updated(telemetry_status_orb_id[i], subs.telemetry_subs[i], &buf.telemetry)) {
+			if (SNAP_COPY(SNAP_TELEMETRY_FIRST + i, &buf.telemetry)) {
 				log_msg.msg_type = LOG_TEL0_MSG + i;
 				log_msg.body.log_TEL.rssi = buf.telemetry.rssi;
 				log_msg.body.log_TEL.remote_rssi = buf.telemetry.remote_rssi;
@@ -1764,7 +2367,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- BOTTOM DISTANCE --- */
-		if (copy_if_updated(ORB_ID(sensor_range_finder), subs.range_finder_sub, &buf.range_finder)) {
+		if (SNAP_COPY(SNAP_RANGE_FINDER, &buf.range_finder)) {
 			log_msg.msg_type = LOG_DIST_MSG;
 			log_msg.body.log_DIST.bottom = buf.range_finder.distance;
 			log_msg.body.log_DIST.bottom_rate = 0.0f;
@@ -1773,7 +2376,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- ESTIMATOR STATUS --- */
-		if (copy_if_updated(ORB_ID(estimator_status), subs.estimator_status_sub, &buf.estimator_status)) {
+		if (SNAP_COPY(SNAP_ESTIMATOR_STATUS, &buf.estimator_status)) {
 			log_msg.msg_type = LOG_EST0_MSG;
 			unsigned maxcopy0 = (sizeof(buf.estimator_status.states) < sizeof(log_msg.body.log_EST0.s)) ? sizeof(buf.estimator_status.states) : sizeof(log_msg.body.log_EST0.s);
 			memset(&(log_msg.body.log_EST0.s), 0, sizeof(log_msg.body.log_EST0.s));
@@ -1792,7 +2395,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- TECS STATUS --- */
-		if (copy_if_updated(ORB_ID(tecs_status), subs.tecs_status_sub, &buf.tecs_status)) {
+		if (SNAP_COPY(SNAP_TECS_STATUS, &buf.tecs_status)) {
 			log_msg.msg_type = LOG_TECS_MSG;
 			log_msg.body.log_TECS.altitudeSp = buf.tecs_status.altitudeSp;
 			log_msg.body.log_TECS.altitudeFiltered = buf.tecs_status.altitude_filtered;
@@ -1812,7 +2415,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- WIND ESTIMATE --- */
-		if (copy_if_updated(ORB_ID(wind_estimate), subs.wind_sub, &buf.wind_estimate)) {
+		if (SNAP_COPY(SNAP_WIND, &buf.wind_estimate)) {
 			log_msg.msg_type = LOG_WIND_MSG;
 			log_msg.body.log_WIND.x = buf.wind_estimate.windspeed_north;
 			log_msg.body.log_WIND.y = buf.wind_estimate.windspeed_east;
@@ -1822,7 +2425,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- ENCODERS --- */
-		if (copy_if_updated(ORB_ID(encoders), subs.encoders_sub, &buf.encoders)) {
+		if (SNAP_COPY(SNAP_ENCODERS, &buf.encoders)) {
 			log_msg.msg_type = LOG_ENCD_MSG;
 			log_msg.body.log_ENCD.cnt0 = buf.encoders.counts[0];
 			log_msg.body.log_ENCD.vel0 = buf.encoders.velocity[0];
@@ -1832,14 +2435,27 @@ int sdlog2_thread_main(int argc, char *argv[])
 		}
 
 		/* --- TIMESYNC OFFSET --- */
-		if (copy_if_updated(ORB_ID(time_offset), subs.tsync_sub, &buf.time_offset)) {
+		if (SNAP_COPY(SNAP_TSYNC, &buf.time_offset)) {
 			log_msg.msg_type = LOG_TSYN_MSG;
 			log_msg.body.log_TSYN.time_offset = buf.time_offset.offset_ns;
 			LOGBUFFER_WRITE_AND_COUNT(TSYN);
 		}
 
+		/* --- CPU LOAD - ONE RECORD PER TASK --- */
+		if (SNAP_COPY(SNAP_CPU_LOAD, &buf.cpu_load)) {
+			for (unsigned i = 0; i < buf.cpu_load.task_count; i++) {
+				log_msg.msg_type = LOG_LOAD_MSG;
+				memcpy(log_msg.body.log_LOAD.name, buf.cpu_load.tasks[i].name, sizeof(log_msg.body.log_LOAD.name));
+				log_msg.body.log_LOAD.pid = buf.cpu_load.tasks[i].pid;
+				log_msg.body.log_LOAD.load = buf.cpu_load.tasks[i].load;
+				log_msg.body.log_LOAD.stack_used = buf.cpu_load.tasks[i].stack_used;
+				log_msg.body.log_LOAD.stack_size = buf.cpu_load.tasks[i].stack_size;
+				LOGBUFFER_WRITE_AND_COUNT(LOAD);
+			}
+		}
+
 		/* --- MULTIROTOR ATTITUDE CONTROLLER STATUS --- */
-		if (copy_if_updated(ORB_ID(mc_att_ctrl_status), subs.mc_att_ctrl_status_sub, &buf.mc_att_ctrl_status)) {
+		if (SNAP_COPY(SNAP_MC_ATT_CTRL_STATUS, &buf.mc_att_ctrl_status)) {
 			log_msg.msg_type = LOG_MACS_MSG;
 			log_msg.body.log_MACS.roll_rate_integ = buf.mc_att_ctrl_status.roll_rate_integ;
 			log_msg.body.log_MACS.pitch_rate_integ = buf.mc_att_ctrl_status.pitch_rate_integ;
@@ -1864,6 +2480,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 	pthread_mutex_destroy(&logbuffer_mutex);
 	pthread_cond_destroy(&logbuffer_cond);
 
+	free(snap_buffer);
 	free(lb.data);
 
 	thread_running = false;
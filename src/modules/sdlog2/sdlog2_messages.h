@@ -463,6 +463,17 @@ struct log_MACS_s {
 	float yaw_rate_integ;
 };
 
+/* --- LOAD - PER-TASK CPU LOAD AND STACK WATERMARK --- */
+/* One record per task out of the 1 Hz cpu_load snapshot */
+#define LOG_LOAD_MSG 44
+struct log_LOAD_s {
+	char name[16];
+	int16_t pid;
+	uint16_t load;
+	uint16_t stack_used;
+	uint16_t stack_size;
+};
+
 /********** SYSTEM MESSAGES, ID > 0x80 **********/
 
 /* --- TIME - TIME STAMP --- */
@@ -485,6 +496,32 @@ struct log_PARM_s {
 	float value;
 };
 
+/* --- TRAC - TRACE RING RECORD --- */
+#define LOG_TRAC_MSG 133
+struct log_TRAC_s {
+	uint64_t t;
+	uint32_t event;
+	uint32_t arg;
+};
+
+/* --- PERF - PERF COUNTER SNAPSHOT --- */
+/* Per-second delta of one registered perf counter: events since the
+ * last snapshot and, for elapsed/interval counters, the time spent */
+#define LOG_PERF_MSG 134
+struct log_PERF_s {
+	char name[16];
+	uint32_t count;
+	uint32_t time_us;
+};
+
+/* --- DELT - DELTA-ENCODED RECORD CONTAINER --- */
+/* Variable-length wrapper written instead of a designated high-rate
+ * message when delta logging (-d) is enabled: the header is followed
+ * by the wrapped message id, the encoded length and one LEB128 varint
+ * per 32-bit word holding the XOR against the previous record of the
+ * same id. Only tools aware of the encoding can parse such logs. */
+#define LOG_DELT_MSG 132
+
 #pragma pack(pop)
 
 /* construct list of all message formats */
@@ -533,12 +570,15 @@ static const struct log_format_s log_formats[] = {
 	LOG_FORMAT(ENCD, "qfqf",	"cnt0,vel0,cnt1,vel1"),
 	LOG_FORMAT(TSYN, "Q", 		"TimeOffset"),
 	LOG_FORMAT(MACS, "fff", "RRint,PRint,YRint"),
+	LOG_FORMAT(LOAD, "NhHHH", "Name,PID,Load,StkUsed,StkSize"),
 
 	/* system-level messages, ID >= 0x80 */
 	/* FMT: don't write format of format message, it's useless */
 	LOG_FORMAT(TIME, "Q", "StartTime"),
 	LOG_FORMAT(VER, "NZ", "Arch,FwGit"),
-	LOG_FORMAT(PARM, "Nf", "Name,Value")
+	LOG_FORMAT(PARM, "Nf", "Name,Value"),
+	LOG_FORMAT(TRAC, "QII", "T,Ev,Arg"),
+	LOG_FORMAT(PERF, "NII", "Name,dCount,dTimeUS")
 };
 
 static const unsigned log_formats_num = sizeof(log_formats) / sizeof(log_formats[0]);
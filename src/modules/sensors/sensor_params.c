@@ -1237,6 +1237,21 @@ PARAM_DEFINE_INT32(RC_MAP_PARAM3, 0);
  */
 PARAM_DEFINE_INT32(RC_FAILS_THR, 0);
 
+/**
+ * Autonomous RC loss reaction on the IO board.
+ *
+ * If set to 1 on boards with an IO coprocessor, IO applies the preloaded
+ * failsafe PWM values in the same mixer tick RC input is lost while flying
+ * manually, instead of waiting for the FMU failsafe chain to react. The FMU
+ * clears the reaction again once its own RC loss handling has switched the
+ * vehicle to an autonomous mode.
+ *
+ * @min 0
+ * @max 1
+ * @group Radio Calibration
+ */
+PARAM_DEFINE_INT32(RC_FAILS_IO, 0);
+
 /**
  * Threshold for selecting assist mode
  *
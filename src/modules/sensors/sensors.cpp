@@ -130,6 +130,7 @@
 
 #define BATT_V_LOWPASS			0.001f
 #define BATT_V_IGNORE_THRESHOLD		4.8f
+#define BATT_STATUS_INTERVAL		100000		/**< publish battery status at 10 Hz; filtering and charge integration stay at the full ADC rate */
 
 /**
  * HACK - true temperature is much less than indicated temperature in baro,
@@ -230,6 +231,29 @@ private:
 	int		_rc_parameter_map_sub;			/**< rc parameter map subscription */
 	int 		_manual_control_sub;			/**< notification of manual control updates */
 
+	/**
+	 * Indices of the high-rate sensor sources in the combined update check.
+	 */
+	enum {
+		SENSOR_SOURCE_GYRO0 = 0,
+		SENSOR_SOURCE_GYRO1,
+		SENSOR_SOURCE_GYRO2,
+		SENSOR_SOURCE_ACCEL0,
+		SENSOR_SOURCE_ACCEL1,
+		SENSOR_SOURCE_ACCEL2,
+		SENSOR_SOURCE_MAG0,
+		SENSOR_SOURCE_MAG1,
+		SENSOR_SOURCE_MAG2,
+		SENSOR_SOURCE_BARO0,
+		SENSOR_SOURCE_BARO1,
+		SENSOR_SOURCE_DIFF_PRES,
+		SENSOR_SOURCE_COUNT
+	};
+
+	int		_source_subs[SENSOR_SOURCE_COUNT];	/**< subscription of each sensor source */
+	const volatile unsigned	*_source_generation[SENSOR_SOURCE_COUNT];	/**< generation counter of each source, nullptr if unavailable */
+	unsigned	_source_last_generation[SENSOR_SOURCE_COUNT];	/**< counter value at the last copy */
+
 	orb_advert_t	_sensor_pub;			/**< combined sensor data topic */
 	orb_advert_t	_manual_control_pub;		/**< manual control signal topic */
 	orb_advert_t	_actuator_group_3_pub;		/**< manual control as actuator topic */
@@ -245,13 +269,33 @@ private:
 	struct baro_report _barometer;			/**< barometer data */
 	struct differential_pressure_s _diff_pres;
 	struct airspeed_s _airspeed;
+
+	/* small FIFO of differential pressure samples so the airspeed fed to
+	 * the controllers can be queried at the IMU timestamp instead of
+	 * being up to one conversion interval stale */
+	static const unsigned DIFF_PRES_FIFO_LEN = 4;
+
+	struct diff_pres_sample_s {
+		uint64_t timestamp;
+		float differential_pressure_filtered_pa;
+	};
+
+	diff_pres_sample_s _diff_pres_fifo[DIFF_PRES_FIFO_LEN];
+	unsigned	_diff_pres_fifo_next;		/**< next FIFO slot to write */
+	unsigned	_diff_pres_fifo_count;		/**< number of valid FIFO entries */
 	struct rc_parameter_map_s _rc_parameter_map;
 
 	math::Matrix<3, 3>	_board_rotation;	/**< rotation matrix for the orientation that the board is mounted */
 	math::Matrix<3, 3>	_mag_rotation[3];		/**< rotation matrix for the orientation that the external mag0 is mounted */
 
+	enum Rotation		_board_rotation_id;	/**< board rotation enum, valid if _board_rotation_exact is set */
+	bool			_board_rotation_exact;	/**< board rotation is a pure sign/permutation, use rotate_3f() */
+	enum Rotation		_mag_rotation_id[3];	/**< per-mag rotation enums, valid if the exact flag is set */
+	bool			_mag_rotation_exact[3];	/**< mag rotation is a pure sign/permutation, use rotate_3f() */
+
 	uint64_t _battery_discharged;			/**< battery discharged current in mA*ms */
 	hrt_abstime _battery_current_timestamp;		/**< timestamp of last battery current reading */
+	hrt_abstime _battery_published;			/**< timestamp of last battery status publication */
 
 	struct {
 		float min[_rc_max_chan_count];
@@ -315,6 +359,15 @@ private:
 
 	}		_parameters;			/**< local copies of interesting parameters */
 
+	struct {
+		float min;				/**< lower clamp bound (raw units) */
+		float max;				/**< upper clamp bound (raw units) */
+		float dz_lo;				/**< lower deadzone edge: trim - dz */
+		float dz_hi;				/**< upper deadzone edge: trim + dz */
+		float slope_lo;				/**< rev / (trim - min - dz), applied below the deadzone */
+		float slope_hi;				/**< rev / (max - trim - dz), applied above the deadzone */
+	}		_rc_cal[_rc_max_chan_count];	/**< per-channel scaling coefficients, precomputed on calibration change */
+
 	struct {
 		param_t min[_rc_max_chan_count];
 		param_t trim[_rc_max_chan_count];
@@ -405,44 +458,96 @@ private:
 	int		adc_init();
 
 	/**
-	 * Poll the accelerometer for updated data.
+	 * Apply the board mounting rotation to a sensor sample, writing the
+	 * result straight into its destination in the combined report.
+	 *
+	 * Uses the cheap sign/permutation path when no fine offset
+	 * is configured.
+	 */
+	void		board_rotate(float x, float y, float z, float out[3]);
+
+	/**
+	 * Apply the mounting rotation of mag instance s to a sample.
+	 */
+	void		mag_rotate(unsigned s, float x, float y, float z, float out[3]);
+
+	/**
+	 * Set up the in-process update detection for the high-rate sensor
+	 * sources (gyro/accel/mag/baro/differential pressure).
+	 *
+	 * Caches the generation counter address of each source so the main
+	 * loop can detect new publications with a load and compare instead
+	 * of one ioctl round trip per source per cycle.
+	 */
+	void		sensor_sources_init();
+
+	/**
+	 * Check all high-rate sensor sources for new publications.
+	 *
+	 * @param updated		Per-source update flags, indexed by
+	 *				SENSOR_SOURCE_*.
+	 */
+	void		sensor_sources_check(bool updated[]);
+
+	/**
+	 * Collect updated accelerometer data.
 	 *
 	 * @param raw			Combined sensor data structure into which
 	 *				data should be returned.
+	 * @param updated		Per-instance update flags from
+	 *				sensor_sources_check().
 	 */
-	void		accel_poll(struct sensor_combined_s &raw);
+	void		accel_poll(struct sensor_combined_s &raw, const bool updated[3]);
 
 	/**
-	 * Poll the gyro for updated data.
+	 * Collect updated gyro data.
 	 *
 	 * @param raw			Combined sensor data structure into which
 	 *				data should be returned.
+	 * @param updated		Per-instance update flags from
+	 *				sensor_sources_check().
 	 */
-	void		gyro_poll(struct sensor_combined_s &raw);
+	void		gyro_poll(struct sensor_combined_s &raw, const bool updated[3]);
 
 	/**
-	 * Poll the magnetometer for updated data.
+	 * Collect updated magnetometer data.
 	 *
 	 * @param raw			Combined sensor data structure into which
 	 *				data should be returned.
+	 * @param updated		Per-instance update flags from
+	 *				sensor_sources_check().
 	 */
-	void		mag_poll(struct sensor_combined_s &raw);
+	void		mag_poll(struct sensor_combined_s &raw, const bool updated[3]);
 
 	/**
-	 * Poll the barometer for updated data.
+	 * Collect updated barometer data.
 	 *
 	 * @param raw			Combined sensor data structure into which
 	 *				data should be returned.
+	 * @param updated		Per-instance update flags from
+	 *				sensor_sources_check().
 	 */
-	void		baro_poll(struct sensor_combined_s &raw);
+	void		baro_poll(struct sensor_combined_s &raw, const bool updated[2]);
 
 	/**
-	 * Poll the differential pressure sensor for updated data.
+	 * Collect updated differential pressure data.
 	 *
 	 * @param raw			Combined sensor data structure into which
 	 *				data should be returned.
+	 * @param updated		Update flag from sensor_sources_check().
 	 */
-	void		diff_pres_poll(struct sensor_combined_s &raw);
+	void		diff_pres_poll(struct sensor_combined_s &raw, bool updated);
+
+	/**
+	 * Query the differential pressure FIFO at a given timestamp.
+	 *
+	 * Interpolates between the bracketing samples, or extrapolates by
+	 * at most one sample interval for timestamps newer than the FIFO.
+	 *
+	 * @param t			Timestamp to evaluate at.
+	 * @return			Filtered differential pressure in Pa.
+	 */
+	float		diff_pres_query(hrt_abstime t);
 
 	/**
 	 * Check for changes in vehicle control mode.
@@ -511,6 +616,10 @@ Sensors::Sensors() :
 	_rc_parameter_map_sub(-1),
 	_manual_control_sub(-1),
 
+	_source_subs{},
+	_source_generation{},
+	_source_last_generation{},
+
 	/* publications */
 	_sensor_pub(-1),
 	_manual_control_pub(-1),
@@ -525,12 +634,20 @@ Sensors::Sensors() :
 
 	_board_rotation{},
 	_mag_rotation{},
+	_board_rotation_id(ROTATION_NONE),
+	_board_rotation_exact(false),
+	_mag_rotation_id{},
+	_mag_rotation_exact{},
 
 	_battery_discharged(0),
-	_battery_current_timestamp(0)
+	_battery_current_timestamp(0),
+	_battery_published(0)
 {
 	memset(&_rc, 0, sizeof(_rc));
 	memset(&_diff_pres, 0, sizeof(_diff_pres));
+	memset(&_diff_pres_fifo, 0, sizeof(_diff_pres_fifo));
+	_diff_pres_fifo_next = 0;
+	_diff_pres_fifo_count = 0;
 	memset(&_rc_parameter_map, 0, sizeof(_rc_parameter_map));
 
 	/* basic r/c parameters */
@@ -680,6 +797,30 @@ Sensors::parameters_update()
 		} else {
 			_parameters.scaling_factor[i] = tmpScaleFactor;
 		}
+
+		/*
+		 * Precompute the piecewise scaling coefficients used by rc_poll(), so the
+		 * 50 Hz path is reduced to a clamp and one multiply per channel. The
+		 * denominators are validated here, which also guarantees the output of
+		 * the hot loop is always finite.
+		 */
+		_rc_cal[i].min = _parameters.min[i];
+		_rc_cal[i].max = _parameters.max[i];
+		_rc_cal[i].dz_lo = _parameters.trim[i] - _parameters.dz[i];
+		_rc_cal[i].dz_hi = _parameters.trim[i] + _parameters.dz[i];
+
+		float range_lo = _parameters.trim[i] - _parameters.min[i] - _parameters.dz[i];
+		float range_hi = _parameters.max[i] - _parameters.trim[i] - _parameters.dz[i];
+
+		/* a degenerate range means the whole half-span is deadzone: scale to zero */
+		_rc_cal[i].slope_lo = (range_lo > 0.0f) ? (_parameters.rev[i] / range_lo) : 0.0f;
+		_rc_cal[i].slope_hi = (range_hi > 0.0f) ? (_parameters.rev[i] / range_hi) : 0.0f;
+
+		/* handle any parameter-induced blowups (e.g. non-finite REV) up front */
+		if (!isfinite(_rc_cal[i].slope_lo) || !isfinite(_rc_cal[i].slope_hi)) {
+			_rc_cal[i].slope_lo = 0.0f;
+			_rc_cal[i].slope_hi = 0.0f;
+		}
 	}
 
 	/* handle wrong values */
@@ -830,6 +971,7 @@ Sensors::parameters_update()
 	}
 
 	get_rot_matrix((enum Rotation)_parameters.board_rotation, &_board_rotation);
+	_board_rotation_id = (enum Rotation)_parameters.board_rotation;
 
 	param_get(_parameter_handles.board_offset[0], &(_parameters.board_offset[0]));
 	param_get(_parameter_handles.board_offset[1], &(_parameters.board_offset[1]));
@@ -843,6 +985,12 @@ Sensors::parameters_update()
 
 	_board_rotation = _board_rotation * board_rotation_offset;
 
+	/* without fine tuning the board rotation stays a pure sign/permutation
+	 * and the per-sample matrix multiply can be skipped */
+	_board_rotation_exact = (_parameters.board_offset[0] == 0.0f) &&
+				(_parameters.board_offset[1] == 0.0f) &&
+				(_parameters.board_offset[2] == 0.0f);
+
 	/* update barometer qnh setting */
 	param_get(_parameter_handles.baro_qnh, &(_parameters.baro_qnh));
 	int	barofd;
@@ -992,22 +1140,109 @@ Sensors::adc_init()
 }
 
 void
-Sensors::accel_poll(struct sensor_combined_s &raw)
+Sensors::board_rotate(float x, float y, float z, float out[3])
 {
-	bool accel_updated;
-	orb_check(_accel_sub, &accel_updated);
+	if (_board_rotation_exact) {
+		/* pure sign/permutation rotation, cheaper than the matrix multiply */
+		rotate_3f(_board_rotation_id, x, y, z);
+
+		out[0] = x;
+		out[1] = y;
+		out[2] = z;
 
-	if (accel_updated) {
+	} else {
+		const math::Matrix<3, 3> &m = _board_rotation;
+
+		out[0] = m(0, 0) * x + m(0, 1) * y + m(0, 2) * z;
+		out[1] = m(1, 0) * x + m(1, 1) * y + m(1, 2) * z;
+		out[2] = m(2, 0) * x + m(2, 1) * y + m(2, 2) * z;
+	}
+}
+
+void
+Sensors::mag_rotate(unsigned s, float x, float y, float z, float out[3])
+{
+	if (_mag_rotation_exact[s]) {
+		rotate_3f(_mag_rotation_id[s], x, y, z);
+
+		out[0] = x;
+		out[1] = y;
+		out[2] = z;
+
+	} else {
+		const math::Matrix<3, 3> &m = _mag_rotation[s];
+
+		out[0] = m(0, 0) * x + m(0, 1) * y + m(0, 2) * z;
+		out[1] = m(1, 0) * x + m(1, 1) * y + m(1, 2) * z;
+		out[2] = m(2, 0) * x + m(2, 1) * y + m(2, 2) * z;
+	}
+}
+
+void
+Sensors::sensor_sources_init()
+{
+	const int subs[SENSOR_SOURCE_COUNT] = {
+		_gyro_sub, _gyro1_sub, _gyro2_sub,
+		_accel_sub, _accel1_sub, _accel2_sub,
+		_mag_sub, _mag1_sub, _mag2_sub,
+		_baro_sub, _baro1_sub,
+		_diff_pres_sub
+	};
+
+	for (unsigned i = 0; i < SENSOR_SOURCE_COUNT; i++) {
+		_source_subs[i] = subs[i];
+		_source_generation[i] = nullptr;
+		_source_last_generation[i] = 0;
+
+		if (subs[i] < 0) {
+			continue;
+		}
+
+		/*
+		 * All sensor drivers run in the same flat address space, so the
+		 * generation counter of each topic can be read directly.  Fall
+		 * back to orb_check() if a node does not support it.
+		 */
+		if (orb_generation_location(subs[i], &_source_generation[i]) != OK) {
+			_source_generation[i] = nullptr;
+		}
+	}
+}
+
+void
+Sensors::sensor_sources_check(bool updated[])
+{
+	for (unsigned i = 0; i < SENSOR_SOURCE_COUNT; i++) {
+
+		if (_source_generation[i] != nullptr) {
+			/*
+			 * New publications show up as a counter change; this
+			 * bypasses the subscription update interval, which is
+			 * fine here as the loop itself is paced by poll() on
+			 * the rate-limited primary gyro.
+			 */
+			unsigned generation = *_source_generation[i];
+			updated[i] = (generation != _source_last_generation[i]);
+			_source_last_generation[i] = generation;
+
+		} else if (_source_subs[i] >= 0) {
+			orb_check(_source_subs[i], &updated[i]);
+
+		} else {
+			updated[i] = false;
+		}
+	}
+}
+
+void
+Sensors::accel_poll(struct sensor_combined_s &raw, const bool updated[3])
+{
+	if (updated[0]) {
 		struct accel_report	accel_report;
 
 		orb_copy(ORB_ID(sensor_accel), _accel_sub, &accel_report);
 
-		math::Vector<3> vect(accel_report.x, accel_report.y, accel_report.z);
-		vect = _board_rotation * vect;
-
-		raw.accelerometer_m_s2[0] = vect(0);
-		raw.accelerometer_m_s2[1] = vect(1);
-		raw.accelerometer_m_s2[2] = vect(2);
+		board_rotate(accel_report.x, accel_report.y, accel_report.z, raw.accelerometer_m_s2);
 
 		raw.accelerometer_raw[0] = accel_report.x_raw;
 		raw.accelerometer_raw[1] = accel_report.y_raw;
@@ -1018,19 +1253,12 @@ Sensors::accel_poll(struct sensor_combined_s &raw)
 		raw.accelerometer_temp = accel_report.temperature;
 	}
 
-	orb_check(_accel1_sub, &accel_updated);
-
-	if (accel_updated) {
+	if (updated[1]) {
 		struct accel_report	accel_report;
 
 		orb_copy(ORB_ID(sensor_accel), _accel1_sub, &accel_report);
 
-		math::Vector<3> vect(accel_report.x, accel_report.y, accel_report.z);
-		vect = _board_rotation * vect;
-
-		raw.accelerometer1_m_s2[0] = vect(0);
-		raw.accelerometer1_m_s2[1] = vect(1);
-		raw.accelerometer1_m_s2[2] = vect(2);
+		board_rotate(accel_report.x, accel_report.y, accel_report.z, raw.accelerometer1_m_s2);
 
 		raw.accelerometer1_raw[0] = accel_report.x_raw;
 		raw.accelerometer1_raw[1] = accel_report.y_raw;
@@ -1041,19 +1269,12 @@ Sensors::accel_poll(struct sensor_combined_s &raw)
 		raw.accelerometer1_temp = accel_report.temperature;
 	}
 
-	orb_check(_accel2_sub, &accel_updated);
-
-	if (accel_updated) {
+	if (updated[2]) {
 		struct accel_report	accel_report;
 
 		orb_copy(ORB_ID(sensor_accel), _accel2_sub, &accel_report);
 
-		math::Vector<3> vect(accel_report.x, accel_report.y, accel_report.z);
-		vect = _board_rotation * vect;
-
-		raw.accelerometer2_m_s2[0] = vect(0);
-		raw.accelerometer2_m_s2[1] = vect(1);
-		raw.accelerometer2_m_s2[2] = vect(2);
+		board_rotate(accel_report.x, accel_report.y, accel_report.z, raw.accelerometer2_m_s2);
 
 		raw.accelerometer2_raw[0] = accel_report.x_raw;
 		raw.accelerometer2_raw[1] = accel_report.y_raw;
@@ -1066,22 +1287,14 @@ Sensors::accel_poll(struct sensor_combined_s &raw)
 }
 
 void
-Sensors::gyro_poll(struct sensor_combined_s &raw)
+Sensors::gyro_poll(struct sensor_combined_s &raw, const bool updated[3])
 {
-	bool gyro_updated;
-	orb_check(_gyro_sub, &gyro_updated);
-
-	if (gyro_updated) {
+	if (updated[0]) {
 		struct gyro_report	gyro_report;
 
 		orb_copy(ORB_ID(sensor_gyro), _gyro_sub, &gyro_report);
 
-		math::Vector<3> vect(gyro_report.x, gyro_report.y, gyro_report.z);
-		vect = _board_rotation * vect;
-
-		raw.gyro_rad_s[0] = vect(0);
-		raw.gyro_rad_s[1] = vect(1);
-		raw.gyro_rad_s[2] = vect(2);
+		board_rotate(gyro_report.x, gyro_report.y, gyro_report.z, raw.gyro_rad_s);
 
 		raw.gyro_raw[0] = gyro_report.x_raw;
 		raw.gyro_raw[1] = gyro_report.y_raw;
@@ -1092,19 +1305,12 @@ Sensors::gyro_poll(struct sensor_combined_s &raw)
 		raw.gyro_temp = gyro_report.temperature;
 	}
 
-	orb_check(_gyro1_sub, &gyro_updated);
-
-	if (gyro_updated) {
+	if (updated[1]) {
 		struct gyro_report	gyro_report;
 
 		orb_copy(ORB_ID(sensor_gyro), _gyro1_sub, &gyro_report);
 
-		math::Vector<3> vect(gyro_report.x, gyro_report.y, gyro_report.z);
-		vect = _board_rotation * vect;
-
-		raw.gyro1_rad_s[0] = vect(0);
-		raw.gyro1_rad_s[1] = vect(1);
-		raw.gyro1_rad_s[2] = vect(2);
+		board_rotate(gyro_report.x, gyro_report.y, gyro_report.z, raw.gyro1_rad_s);
 
 		raw.gyro1_raw[0] = gyro_report.x_raw;
 		raw.gyro1_raw[1] = gyro_report.y_raw;
@@ -1115,19 +1321,12 @@ Sensors::gyro_poll(struct sensor_combined_s &raw)
 		raw.gyro1_temp = gyro_report.temperature;
 	}
 
-	orb_check(_gyro2_sub, &gyro_updated);
-
-	if (gyro_updated) {
+	if (updated[2]) {
 		struct gyro_report	gyro_report;
 
 		orb_copy(ORB_ID(sensor_gyro), _gyro2_sub, &gyro_report);
 
-		math::Vector<3> vect(gyro_report.x, gyro_report.y, gyro_report.z);
-		vect = _board_rotation * vect;
-
-		raw.gyro2_rad_s[0] = vect(0);
-		raw.gyro2_rad_s[1] = vect(1);
-		raw.gyro2_rad_s[2] = vect(2);
+		board_rotate(gyro_report.x, gyro_report.y, gyro_report.z, raw.gyro2_rad_s);
 
 		raw.gyro2_raw[0] = gyro_report.x_raw;
 		raw.gyro2_raw[1] = gyro_report.y_raw;
@@ -1140,23 +1339,14 @@ Sensors::gyro_poll(struct sensor_combined_s &raw)
 }
 
 void
-Sensors::mag_poll(struct sensor_combined_s &raw)
+Sensors::mag_poll(struct sensor_combined_s &raw, const bool updated[3])
 {
-	bool mag_updated;
-	orb_check(_mag_sub, &mag_updated);
-
-	if (mag_updated) {
+	if (updated[0]) {
 		struct mag_report	mag_report;
 
 		orb_copy(ORB_ID(sensor_mag), _mag_sub, &mag_report);
 
-		math::Vector<3> vect(mag_report.x, mag_report.y, mag_report.z);
-
-		vect = _mag_rotation[0] * vect;
-
-		raw.magnetometer_ga[0] = vect(0);
-		raw.magnetometer_ga[1] = vect(1);
-		raw.magnetometer_ga[2] = vect(2);
+		mag_rotate(0, mag_report.x, mag_report.y, mag_report.z, raw.magnetometer_ga);
 
 		raw.magnetometer_raw[0] = mag_report.x_raw;
 		raw.magnetometer_raw[1] = mag_report.y_raw;
@@ -1167,20 +1357,12 @@ Sensors::mag_poll(struct sensor_combined_s &raw)
 		raw.magnetometer_temp = mag_report.temperature;
 	}
 
-	orb_check(_mag1_sub, &mag_updated);
-
-	if (mag_updated) {
+	if (updated[1]) {
 		struct mag_report	mag_report;
 
 		orb_copy(ORB_ID(sensor_mag), _mag1_sub, &mag_report);
 
-		math::Vector<3> vect(mag_report.x, mag_report.y, mag_report.z);
-
-		vect = _mag_rotation[1] * vect;
-
-		raw.magnetometer1_ga[0] = vect(0);
-		raw.magnetometer1_ga[1] = vect(1);
-		raw.magnetometer1_ga[2] = vect(2);
+		mag_rotate(1, mag_report.x, mag_report.y, mag_report.z, raw.magnetometer1_ga);
 
 		raw.magnetometer1_raw[0] = mag_report.x_raw;
 		raw.magnetometer1_raw[1] = mag_report.y_raw;
@@ -1191,20 +1373,12 @@ Sensors::mag_poll(struct sensor_combined_s &raw)
 		raw.magnetometer1_temp = mag_report.temperature;
 	}
 
-	orb_check(_mag2_sub, &mag_updated);
-
-	if (mag_updated) {
+	if (updated[2]) {
 		struct mag_report	mag_report;
 
 		orb_copy(ORB_ID(sensor_mag), _mag2_sub, &mag_report);
 
-		math::Vector<3> vect(mag_report.x, mag_report.y, mag_report.z);
-
-		vect = _mag_rotation[2] * vect;
-
-		raw.magnetometer2_ga[0] = vect(0);
-		raw.magnetometer2_ga[1] = vect(1);
-		raw.magnetometer2_ga[2] = vect(2);
+		mag_rotate(2, mag_report.x, mag_report.y, mag_report.z, raw.magnetometer2_ga);
 
 		raw.magnetometer2_raw[0] = mag_report.x_raw;
 		raw.magnetometer2_raw[1] = mag_report.y_raw;
@@ -1217,12 +1391,9 @@ Sensors::mag_poll(struct sensor_combined_s &raw)
 }
 
 void
-Sensors::baro_poll(struct sensor_combined_s &raw)
+Sensors::baro_poll(struct sensor_combined_s &raw, const bool updated[2])
 {
-	bool baro_updated;
-	orb_check(_baro_sub, &baro_updated);
-
-	if (baro_updated) {
+	if (updated[0]) {
 
 		orb_copy(ORB_ID(sensor_baro), _baro_sub, &_barometer);
 
@@ -1233,9 +1404,7 @@ Sensors::baro_poll(struct sensor_combined_s &raw)
 		raw.baro_timestamp = _barometer.timestamp;
 	}
 
-	orb_check(_baro1_sub, &baro_updated);
-
-	if (baro_updated) {
+	if (updated[1]) {
 
 		struct baro_report	baro_report;
 
@@ -1250,14 +1419,21 @@ Sensors::baro_poll(struct sensor_combined_s &raw)
 }
 
 void
-Sensors::diff_pres_poll(struct sensor_combined_s &raw)
+Sensors::diff_pres_poll(struct sensor_combined_s &raw, bool updated)
 {
-	bool updated;
-	orb_check(_diff_pres_sub, &updated);
-
 	if (updated) {
 		orb_copy(ORB_ID(differential_pressure), _diff_pres_sub, &_diff_pres);
 
+		/* push the sample into the FIFO for timestamp-aligned queries */
+		_diff_pres_fifo[_diff_pres_fifo_next].timestamp = _diff_pres.timestamp;
+		_diff_pres_fifo[_diff_pres_fifo_next].differential_pressure_filtered_pa =
+			_diff_pres.differential_pressure_filtered_pa;
+		_diff_pres_fifo_next = (_diff_pres_fifo_next + 1) % DIFF_PRES_FIFO_LEN;
+
+		if (_diff_pres_fifo_count < DIFF_PRES_FIFO_LEN) {
+			_diff_pres_fifo_count++;
+		}
+
 		raw.differential_pressure_pa = _diff_pres.differential_pressure_raw_pa;
 		raw.differential_pressure_timestamp = _diff_pres.timestamp;
 		raw.differential_pressure_filtered_pa = _diff_pres.differential_pressure_filtered_pa;
@@ -1267,12 +1443,18 @@ Sensors::diff_pres_poll(struct sensor_combined_s &raw)
 
 		_airspeed.timestamp = _diff_pres.timestamp;
 
+		/* evaluate the differential pressure at the IMU timestamp, so the
+		 * controllers see airspeed in phase with the attitude solution */
+		float diff_pres_aligned = diff_pres_query(raw.timestamp);
+
+		/* true airspeed is indicated airspeed times the cached density
+		 * correction, so the full rate path pays one multiplication */
+		float ias = calc_indicated_airspeed(diff_pres_aligned);
+		float tas_scale = calc_tas_scale(raw.baro_pres_mbar * 1e2f, air_temperature_celsius);
+
 		/* don't risk to feed negative airspeed into the system */
-		_airspeed.indicated_airspeed_m_s = math::max(0.0f,
-						   calc_indicated_airspeed(_diff_pres.differential_pressure_filtered_pa));
-		_airspeed.true_airspeed_m_s = math::max(0.0f,
-							calc_true_airspeed(_diff_pres.differential_pressure_filtered_pa + raw.baro_pres_mbar * 1e2f,
-									raw.baro_pres_mbar * 1e2f, air_temperature_celsius));
+		_airspeed.indicated_airspeed_m_s = math::max(0.0f, ias);
+		_airspeed.true_airspeed_m_s = math::max(0.0f, ias * tas_scale);
 		_airspeed.air_temperature_celsius = air_temperature_celsius;
 
 		/* announce the airspeed if needed, just publish else */
@@ -1285,6 +1467,58 @@ Sensors::diff_pres_poll(struct sensor_combined_s &raw)
 	}
 }
 
+float
+Sensors::diff_pres_query(hrt_abstime t)
+{
+	if (_diff_pres_fifo_count < 2) {
+		return _diff_pres.differential_pressure_filtered_pa;
+	}
+
+	unsigned newest = (_diff_pres_fifo_next + DIFF_PRES_FIFO_LEN - 1) % DIFF_PRES_FIFO_LEN;
+	unsigned prev = (newest + DIFF_PRES_FIFO_LEN - 1) % DIFF_PRES_FIFO_LEN;
+
+	const diff_pres_sample_s &s1 = _diff_pres_fifo[newest];
+	const diff_pres_sample_s &s0 = _diff_pres_fifo[prev];
+
+	if (t >= s1.timestamp) {
+		uint64_t dt = s1.timestamp - s0.timestamp;
+
+		if (dt == 0) {
+			return s1.differential_pressure_filtered_pa;
+		}
+
+		/* extrapolate ahead by at most one sample interval */
+		uint64_t ahead = t - s1.timestamp;
+
+		if (ahead > dt) {
+			ahead = dt;
+		}
+
+		float slope = (s1.differential_pressure_filtered_pa - s0.differential_pressure_filtered_pa) / (float)dt;
+		return s1.differential_pressure_filtered_pa + slope * (float)ahead;
+	}
+
+	/* walk backwards to the bracketing pair */
+	unsigned idx = newest;
+
+	for (unsigned i = 1; i < _diff_pres_fifo_count; i++) {
+		unsigned pidx = (idx + DIFF_PRES_FIFO_LEN - 1) % DIFF_PRES_FIFO_LEN;
+		const diff_pres_sample_s &a = _diff_pres_fifo[pidx];
+		const diff_pres_sample_s &b = _diff_pres_fifo[idx];
+
+		if (a.timestamp <= t && b.timestamp > a.timestamp) {
+			float frac = (float)(t - a.timestamp) / (float)(b.timestamp - a.timestamp);
+			return a.differential_pressure_filtered_pa +
+			       frac * (b.differential_pressure_filtered_pa - a.differential_pressure_filtered_pa);
+		}
+
+		idx = pidx;
+	}
+
+	/* older than everything we kept */
+	return _diff_pres_fifo[idx].differential_pressure_filtered_pa;
+}
+
 void
 Sensors::vehicle_control_mode_poll()
 {
@@ -1487,6 +1721,8 @@ Sensors::parameter_update_poll(bool forced)
 			 * in the section below.
 			 */
 			_mag_rotation[s] = _board_rotation;
+			_mag_rotation_id[s] = _board_rotation_id;
+			_mag_rotation_exact[s] = _board_rotation_exact;
 
 			bool config_ok = false;
 
@@ -1525,6 +1761,8 @@ Sensors::parameter_update_poll(bool forced)
 					if (ioctl(fd, MAGIOCGEXTERNAL, 0) <= 0) {
 						/* mag is internal */
 						_mag_rotation[s] = _board_rotation;
+						_mag_rotation_id[s] = _board_rotation_id;
+						_mag_rotation_exact[s] = _board_rotation_exact;
 						/* reset param to -1 to indicate internal mag */
 						int32_t minus_one = MAG_ROT_VAL_INTERNAL;
 						param_set_no_notification(param_find(str), &minus_one);
@@ -1568,6 +1806,8 @@ Sensors::parameter_update_poll(bool forced)
 						}
 
 						get_rot_matrix((enum Rotation)mag_rot, &_mag_rotation[s]);
+						_mag_rotation_id[s] = (enum Rotation)mag_rot;
+						_mag_rotation_exact[s] = true;
 					}
 
 					if (failed) {
@@ -1712,6 +1952,9 @@ Sensors::adc_poll(struct sensor_combined_s &raw)
 
 						/* check measured current value */
 						if (current >= 0.0f) {
+							/* previous sample, for trapezoidal integration */
+							float last_current = _battery_status.current_a;
+
 							_battery_status.timestamp = t;
 							_battery_status.current_a = current;
 
@@ -1721,7 +1964,12 @@ Sensors::adc_poll(struct sensor_combined_s &raw)
 									_battery_status.discharged_mah = 0.0f;
 								}
 
-								_battery_discharged += current * (t - _battery_current_timestamp);
+								if (last_current < 0.0f) {
+									last_current = current;
+								}
+
+								/* trapezoidal coulomb integration of the drawn charge */
+								_battery_discharged += 0.5f * (current + last_current) * (t - _battery_current_timestamp);
 								_battery_status.discharged_mah = ((float) _battery_discharged) / 3600000.0f;
 							}
 						}
@@ -1762,7 +2010,9 @@ Sensors::adc_poll(struct sensor_combined_s &raw)
 
 			_last_adc = t;
 
-			if (_battery_status.voltage_filtered_v > BATT_V_IGNORE_THRESHOLD) {
+			/* publish decimated; subscribers do not need the full integration rate */
+			if ((_battery_status.voltage_filtered_v > BATT_V_IGNORE_THRESHOLD) &&
+			    (t - _battery_published >= BATT_STATUS_INTERVAL)) {
 				/* announce the battery status if needed, just publish else */
 				if (_battery_pub > 0) {
 					orb_publish(ORB_ID(battery_status), _battery_pub, &_battery_status);
@@ -1770,6 +2020,8 @@ Sensors::adc_poll(struct sensor_combined_s &raw)
 				} else {
 					_battery_pub = orb_advertise(ORB_ID(battery_status), &_battery_status);
 				}
+
+				_battery_published = t;
 			}
 		}
 	}
@@ -1911,15 +2163,19 @@ Sensors::rc_poll()
 		/* read out and scale values from raw message even if signal is invalid */
 		for (unsigned int i = 0; i < channel_limit; i++) {
 
+			float value = rc_input.values[i];
+
 			/*
 			 * 1) Constrain to min/max values, as later processing depends on bounds.
 			 */
-			if (rc_input.values[i] < _parameters.min[i]) {
-				rc_input.values[i] = _parameters.min[i];
+			if (value < _rc_cal[i].min) {
+				value = _rc_cal[i].min;
+				rc_input.values[i] = _rc_cal[i].min;
 			}
 
-			if (rc_input.values[i] > _parameters.max[i]) {
-				rc_input.values[i] = _parameters.max[i];
+			if (value > _rc_cal[i].max) {
+				value = _rc_cal[i].max;
+				rc_input.values[i] = _rc_cal[i].max;
 			}
 
 			/*
@@ -1932,31 +2188,23 @@ Sensors::rc_poll()
 			 * If center (trim) == min, scale to 0..1, if center (trim) == max,
 			 * scale to -1..0.
 			 *
-			 * As the min and max bounds were enforced in step 1), division by zero
-			 * cannot occur, as for the case of center == min or center == max the if
-			 * statement is mutually exclusive with the arithmetic NaN case.
+			 * The reciprocal slopes (with the channel reversal folded in) are
+			 * precomputed and validated in parameters_update(), so this pass is
+			 * a compare and a multiply per channel and always yields finite
+			 * output. Step 1) keeps the result within -1..1.
 			 *
 			 * DO NOT REMOVE OR ALTER STEP 1!
 			 */
-			if (rc_input.values[i] > (_parameters.trim[i] + _parameters.dz[i])) {
-				_rc.channels[i] = (rc_input.values[i] - _parameters.trim[i] - _parameters.dz[i]) / (float)(
-							  _parameters.max[i] - _parameters.trim[i] - _parameters.dz[i]);
+			if (value > _rc_cal[i].dz_hi) {
+				_rc.channels[i] = (value - _rc_cal[i].dz_hi) * _rc_cal[i].slope_hi;
 
-			} else if (rc_input.values[i] < (_parameters.trim[i] - _parameters.dz[i])) {
-				_rc.channels[i] = (rc_input.values[i] - _parameters.trim[i] + _parameters.dz[i]) / (float)(
-							  _parameters.trim[i] - _parameters.min[i] - _parameters.dz[i]);
+			} else if (value < _rc_cal[i].dz_lo) {
+				_rc.channels[i] = (value - _rc_cal[i].dz_lo) * _rc_cal[i].slope_lo;
 
 			} else {
 				/* in the configured dead zone, output zero */
 				_rc.channels[i] = 0.0f;
 			}
-
-			_rc.channels[i] *= _parameters.rev[i];
-
-			/* handle any parameter-induced blowups */
-			if (!isfinite(_rc.channels[i])) {
-				_rc.channels[i] = 0.0f;
-			}
 		}
 
 		_rc.channel_count = rc_input.channel_count;
@@ -2142,18 +2390,25 @@ Sensors::task_main()
 	_battery_status.current_a = -1.0f;
 	_battery_status.discharged_mah = -1.0f;
 
+	/* cache the generation counters for the in-process update checks */
+	sensor_sources_init();
+
+	bool source_updated[SENSOR_SOURCE_COUNT];
+
 	/* get a set of initial values */
-	accel_poll(raw);
-	gyro_poll(raw);
-	mag_poll(raw);
-	baro_poll(raw);
-	diff_pres_poll(raw);
+	sensor_sources_check(source_updated);
+	accel_poll(raw, &source_updated[SENSOR_SOURCE_ACCEL0]);
+	gyro_poll(raw, &source_updated[SENSOR_SOURCE_GYRO0]);
+	mag_poll(raw, &source_updated[SENSOR_SOURCE_MAG0]);
+	baro_poll(raw, &source_updated[SENSOR_SOURCE_BARO0]);
+	diff_pres_poll(raw, source_updated[SENSOR_SOURCE_DIFF_PRES]);
 
 	parameter_update_poll(true /* forced */);
 	rc_parameter_map_poll(true /* forced */);
 
-	/* advertise the sensor_combined topic and make the initial publication */
-	_sensor_pub = orb_advertise(ORB_ID(sensor_combined), &raw);
+	/* advertise the sensor_combined topic with a short sample queue and make the
+	 * initial publication */
+	_sensor_pub = orb_advertise_queue(ORB_ID(sensor_combined), &raw, SENSOR_COMBINED_QUEUE_DEPTH);
 
 	/* wakeup source(s) */
 	struct pollfd fds[1];
@@ -2182,12 +2437,15 @@ Sensors::task_main()
 		/* check vehicle status for changes to publication state */
 		vehicle_control_mode_poll();
 
+		/* gather all pending publications in one pass */
+		sensor_sources_check(source_updated);
+
 		/* the timestamp of the raw struct is updated by the gyro_poll() method */
 		/* copy most recent sensor data */
-		gyro_poll(raw);
-		accel_poll(raw);
-		mag_poll(raw);
-		baro_poll(raw);
+		gyro_poll(raw, &source_updated[SENSOR_SOURCE_GYRO0]);
+		accel_poll(raw, &source_updated[SENSOR_SOURCE_ACCEL0]);
+		mag_poll(raw, &source_updated[SENSOR_SOURCE_MAG0]);
+		baro_poll(raw, &source_updated[SENSOR_SOURCE_BARO0]);
 
 		/* work out if main gyro timed out and fail over to alternate gyro */
 		if (hrt_elapsed_time(&raw.timestamp) > 20 * 1000) {
@@ -2203,7 +2461,7 @@ Sensors::task_main()
 		/* check battery voltage */
 		adc_poll(raw);
 
-		diff_pres_poll(raw);
+		diff_pres_poll(raw, source_updated[SENSOR_SOURCE_DIFF_PRES]);
 
 		/* Inform other processes that new data is available to copy */
 		if (_publishing) {
@@ -109,6 +109,45 @@ float calc_true_airspeed(float total_pressure, float static_pressure, float temp
 	}
 }
 
+/* recompute the cached density correction on these input deltas: 50 Pa is
+ * roughly 4 m of altitude, both bounds keep the speed error below 0.1% */
+#define TAS_SCALE_PRESSURE_DELTA	50.0f
+#define TAS_SCALE_TEMPERATURE_DELTA	0.5f
+
+/**
+ * Get the indicated-to-true airspeed scale factor.
+ *
+ * Caches sqrt(rho_0 / rho) and recomputes it only when static pressure
+ * or temperature moved by a meaningful delta, so the full-rate airspeed
+ * path does not pay for a division and square root on every sample.
+ *
+ * @param static_pressure pressure at the side of the tube/airplane
+ * @param temperature_celsius air temperature in degrees celcius
+ * @return scale factor from indicated to true airspeed
+ */
+float calc_tas_scale(float static_pressure, float temperature_celsius)
+{
+	static float cached_pressure = -1.0f;
+	static float cached_temperature = 0.0f;
+	static float cached_scale = 1.0f;
+
+	if (fabsf(static_pressure - cached_pressure) > TAS_SCALE_PRESSURE_DELTA ||
+	    fabsf(temperature_celsius - cached_temperature) > TAS_SCALE_TEMPERATURE_DELTA) {
+
+		float density = get_air_density(static_pressure, temperature_celsius);
+
+		if (density < 0.0001f || !isfinite(density)) {
+			density = CONSTANTS_AIR_DENSITY_SEA_LEVEL_15C;
+		}
+
+		cached_scale = sqrtf(CONSTANTS_AIR_DENSITY_SEA_LEVEL_15C / density);
+		cached_pressure = static_pressure;
+		cached_temperature = temperature_celsius;
+	}
+
+	return cached_scale;
+}
+
 float get_air_density(float static_pressure, float temperature_celsius)
 {
 	return static_pressure / (CONSTANTS_AIR_GAS_CONST * (temperature_celsius - CONSTANTS_ABSOLUTE_NULL_CELSIUS));
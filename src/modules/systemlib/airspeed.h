@@ -85,6 +85,20 @@
   */
  __EXPORT float calc_true_airspeed(float total_pressure, float static_pressure, float temperature_celsius);
 
+ /**
+  * Get the indicated-to-true airspeed scale factor.
+  *
+  * The density correction changes slowly with altitude and temperature,
+  * so the factor is cached and only recomputed when the inputs moved by
+  * a meaningful delta, keeping the per-sample cost of true airspeed to
+  * a single multiplication.
+  *
+  * @param static_pressure pressure at the side of the tube/airplane
+  * @param temperature_celsius air temperature in degrees celcius
+  * @return scale factor from indicated to true airspeed
+  */
+ __EXPORT float calc_tas_scale(float static_pressure, float temperature_celsius);
+
  /**
  * Calculates air density.
  *
@@ -58,8 +58,33 @@ read_x(bson_decoder_t decoder, void *p, size_t s)
 {
 	CODER_CHECK(decoder);
 
-	if (decoder->fd > -1)
-		return (read(decoder->fd, p, s) == (int)s) ? 0 : -1;
+	if (decoder->fd > -1) {
+		uint8_t *out = (uint8_t *)p;
+
+		/* file reads are served from a cache refilled in chunks, so
+		 * decoding does not cost one read call per element field */
+		while (s > 0) {
+			if (decoder->rcache_pos == decoder->rcache_len) {
+				int got = read(decoder->fd, decoder->rcache, sizeof(decoder->rcache));
+
+				if (got <= 0)
+					return -1;
+
+				decoder->rcache_len = got;
+				decoder->rcache_pos = 0;
+			}
+
+			size_t avail = decoder->rcache_len - decoder->rcache_pos;
+			size_t n = (s < avail) ? s : avail;
+
+			memcpy(out, &decoder->rcache[decoder->rcache_pos], n);
+			decoder->rcache_pos += n;
+			out += n;
+			s -= n;
+		}
+
+		return 0;
+	}
 
 	if (decoder->buf != NULL) {
 		/* staged operations to avoid integer overflow for corrupt data */
@@ -105,6 +130,8 @@ bson_decoder_init_file(bson_decoder_t decoder, int fd, bson_decoder_callback cal
 	int32_t	junk;
 
 	decoder->fd = fd;
+	decoder->rcache_len = 0;
+	decoder->rcache_pos = 0;
 	decoder->buf = NULL;
 	decoder->dead = false;
 	decoder->callback = callback;
@@ -172,6 +199,12 @@ bson_decoder_next(bson_decoder_t decoder)
 
 		/* if the nesting level is now zero, the top-level document is done */
 		if (decoder->nesting == 0) {
+			/* push back cached read-ahead so the file position ends
+			 * exactly at the document terminator; callers may decode
+			 * further documents from the same descriptor */
+			if ((decoder->fd > -1) && (decoder->rcache_pos < decoder->rcache_len))
+				lseek(decoder->fd, (off_t)decoder->rcache_pos - (off_t)decoder->rcache_len, SEEK_CUR);
+
 			/* like kill but not an error */
 			debug("nesting is zero, document is done");
 			decoder->fd = -1;
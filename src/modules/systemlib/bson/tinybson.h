@@ -101,9 +101,15 @@ typedef struct bson_decoder_s *bson_decoder_t;
  */
 typedef int	(* bson_decoder_callback)(bson_decoder_t decoder, void *private, bson_node_t node);
 
+/** file read chunk size; an element is typically 14-25 bytes */
+#define BSON_RCACHE_SIZE	64
+
 struct bson_decoder_s {
 	/* file reader state */
 	int			fd;
+	uint8_t			rcache[BSON_RCACHE_SIZE];
+	unsigned		rcache_len;
+	unsigned		rcache_pos;
 
 	/* buffer reader state */
 	uint8_t			*buf;
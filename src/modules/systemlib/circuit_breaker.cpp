@@ -43,13 +43,92 @@
  */
 
 #include <px4.h>
+#include <string.h>
 #include <systemlib/circuit_breaker.h>
 
+#if defined(__PX4_ROS)
+
+bool circuit_breaker_enabled(const char *breaker, int32_t magic)
+{
+	int32_t val;
+	(void)PX4_PARAM_GET_BYNAME(breaker, &val);
+
+	return (val == magic);
+}
+
+#else
+
+/* all known circuit breakers and their keys */
+static const struct {
+	const char	*name;
+	int32_t		magic;
+} breaker_info[] = {
+	{ "CBRK_SUPPLY_CHK",	CBRK_SUPPLY_CHK_KEY },
+	{ "CBRK_RATE_CTRL",	CBRK_RATE_CTRL_KEY },
+	{ "CBRK_IO_SAFETY",	CBRK_IO_SAFETY_KEY },
+	{ "CBRK_AIRSPD_CHK",	CBRK_AIRSPD_CHK_KEY },
+	{ "CBRK_FLIGHTTERM",	CBRK_FLIGHTTERM_KEY },
+	{ "CBRK_ENGINEFAIL",	CBRK_ENGINEFAIL_KEY },
+	{ "CBRK_GPSFAIL",	CBRK_GPSFAIL_KEY },
+};
+
+#define NUM_BREAKERS	(sizeof(breaker_info) / sizeof(breaker_info[0]))
+
+static param_t breaker_handles[NUM_BREAKERS];
+static uint8_t breaker_mask = 0;
+static unsigned breaker_generation = 0;
+static bool breaker_cache_valid = false;
+
+/**
+ * Re-evaluate all breakers into the cached bitmask.
+ */
+static void circuit_breaker_refresh(void)
+{
+	for (unsigned i = 0; i < NUM_BREAKERS; i++) {
+		if (!breaker_cache_valid) {
+			breaker_handles[i] = param_find(breaker_info[i].name);
+		}
+
+		int32_t val = 0;
+
+		if (breaker_handles[i] != PARAM_INVALID) {
+			(void)param_get(breaker_handles[i], &val);
+		}
+
+		if (val == breaker_info[i].magic) {
+			breaker_mask |= (1 << i);
+
+		} else {
+			breaker_mask &= ~(1 << i);
+		}
+	}
+
+	breaker_cache_valid = true;
+}
+
 bool circuit_breaker_enabled(const char *breaker, int32_t magic)
 {
+	/* refresh the cached states when a parameter has been modified */
+	unsigned generation = param_change_generation();
+
+	if (!breaker_cache_valid || (generation != breaker_generation)) {
+		circuit_breaker_refresh();
+		breaker_generation = generation;
+	}
+
+	/* known breakers with their canonical keys reduce to a bit test */
+	for (unsigned i = 0; i < NUM_BREAKERS; i++) {
+		if ((magic == breaker_info[i].magic) && !strcmp(breaker, breaker_info[i].name)) {
+			return breaker_mask & (1 << i);
+		}
+	}
+
+	/* unknown breaker, fall back to a direct lookup */
 	int32_t val;
 	(void)PX4_PARAM_GET_BYNAME(breaker, &val);
 
 	return (val == magic);
 }
 
+#endif
+
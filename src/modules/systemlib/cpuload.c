@@ -69,6 +69,18 @@ __EXPORT struct system_load_s system_load;
 
 extern FAR struct tcb_s *sched_gettcb(pid_t pid);
 
+static void cpuload_latency_reset(struct system_load_taskinfo_s *task)
+{
+	task->ready_since = 0;
+	task->latency_max = 0;
+	task->latency_total = 0;
+	task->latency_count = 0;
+
+	for (int b = 0; b < CPULOAD_LATENCY_BINS; b++) {
+		task->latency_hist[b] = 0;
+	}
+}
+
 void cpuload_initialize_once()
 {
 	system_load.start_time = hrt_absolute_time();
@@ -99,6 +111,7 @@ void cpuload_initialize_once()
 		system_load.tasks[system_load.total_count].curr_start_time = 0;
 		system_load.tasks[system_load.total_count].tcb = sched_gettcb(
 					system_load.total_count);	// it is assumed that these static threads have consecutive PIDs
+		cpuload_latency_reset(&system_load.tasks[system_load.total_count]);
 		system_load.tasks[system_load.total_count].valid = true;
 	}
 }
@@ -114,6 +127,7 @@ void sched_note_start(FAR struct tcb_s *tcb)
 			system_load.tasks[i].start_time = hrt_absolute_time();
 			system_load.tasks[i].total_runtime = 0;
 			system_load.tasks[i].curr_start_time = 0;
+			cpuload_latency_reset(&system_load.tasks[i]);
 			system_load.tasks[i].tcb = tcb;
 			system_load.tasks[i].valid = true;
 			system_load.total_count++;
@@ -153,10 +167,45 @@ void sched_note_switch(FAR struct tcb_s *pFromTcb, FAR struct tcb_s *pToTcb)
 			{
 				system_load.tasks[i].total_runtime += new_time - system_load.tasks[i].curr_start_time;
 			}
+
+			/* Still ready to run: the task was preempted and is now waiting
+			 * for the CPU. There is no wakeup hook in the scheduler
+			 * instrumentation, so this covers run-queue wait after
+			 * preemption, not the wakeup-to-ready transition itself. */
+			if (pFromTcb->task_state == TSTATE_TASK_READYTORUN) {
+				system_load.tasks[i].ready_since = new_time;
+
+			} else {
+				system_load.tasks[i].ready_since = 0;
+			}
+
 			both_found++;
 
 		} else if (system_load.tasks[i].tcb->pid == pToTcb->pid) {
 			system_load.tasks[i].curr_start_time = new_time;
+
+			if (system_load.tasks[i].ready_since != 0) {
+				uint64_t latency = new_time - system_load.tasks[i].ready_since;
+				system_load.tasks[i].ready_since = 0;
+
+				if (latency > system_load.tasks[i].latency_max) {
+					system_load.tasks[i].latency_max = latency;
+				}
+
+				system_load.tasks[i].latency_total += latency;
+				system_load.tasks[i].latency_count++;
+
+				unsigned bin = 0;
+				uint64_t bound = CPULOAD_LATENCY_BIN0_US;
+
+				while (bin < CPULOAD_LATENCY_BINS - 1 && latency >= bound) {
+					bound <<= 1;
+					bin++;
+				}
+
+				system_load.tasks[i].latency_hist[bin]++;
+			}
+
 			both_found++;
 		}
 
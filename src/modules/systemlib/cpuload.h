@@ -39,10 +39,23 @@ __BEGIN_DECLS
 
 #include <nuttx/sched.h>
 
+/**
+ * Number of scheduling latency histogram bins. Bin 0 counts latencies
+ * below CPULOAD_LATENCY_BIN0_US, each following bin doubles the bound,
+ * the last bin collects everything above.
+ */
+#define CPULOAD_LATENCY_BINS		8
+#define CPULOAD_LATENCY_BIN0_US		125
+
 struct system_load_taskinfo_s {
 	uint64_t total_runtime;			///< Runtime since start (start_time - total_runtime)/(start_time - current_time) = load
 	uint64_t curr_start_time;		///< Start time of the current scheduling slot
 	uint64_t start_time;			///< FIRST start time of task
+	uint64_t ready_since;			///< Time the task was last preempted while ready, 0 if not waiting
+	uint64_t latency_max;			///< Worst observed ready-to-running latency
+	uint64_t latency_total;			///< Sum of all observed latencies, for the mean
+	uint32_t latency_count;			///< Number of observed latencies
+	uint32_t latency_hist[CPULOAD_LATENCY_BINS];	///< Latency histogram, see CPULOAD_LATENCY_BIN0_US
 	FAR struct tcb_s *tcb;			///<
 	bool valid;						///< Task is currently active / valid
 };
@@ -0,0 +1,147 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file file_stream.c
+ *
+ * High-throughput file reader with a sector-aligned readahead buffer.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "file_stream.h"
+
+int
+file_stream_init(struct file_stream_s *stream, int fd, unsigned size)
+{
+	/* round the buffer up to whole sectors */
+	size = ((size + FILE_STREAM_SECTOR - 1) / FILE_STREAM_SECTOR) * FILE_STREAM_SECTOR;
+
+	stream->fd = fd;
+	stream->buf = memalign(FILE_STREAM_SECTOR, size);
+	stream->size = (stream->buf != NULL) ? size : 0;
+	stream->offset = 0;
+	stream->length = 0;
+
+	return (stream->buf != NULL) ? 0 : -1;
+}
+
+ssize_t
+file_stream_peek(struct file_stream_s *stream, off_t offset, const uint8_t **data)
+{
+	if (stream->buf == NULL) {
+		return -1;
+	}
+
+	if ((stream->length == 0) ||
+	    (offset < stream->offset) ||
+	    (offset >= stream->offset + (off_t)stream->length)) {
+
+		/*
+		 * Refill starting at the preceding sector boundary; aligned
+		 * multi-sector reads let the FAT layer transfer straight from
+		 * the media into the buffer.
+		 */
+		off_t aligned = offset & ~(off_t)(FILE_STREAM_SECTOR - 1);
+
+		stream->length = 0;
+
+		if (lseek(stream->fd, aligned, SEEK_SET) < 0) {
+			return -1;
+		}
+
+		ssize_t nread = read(stream->fd, stream->buf, stream->size);
+
+		if (nread < 0) {
+			return -1;
+		}
+
+		stream->offset = aligned;
+		stream->length = nread;
+
+		/* the requested offset may sit past the end of the file */
+		if (offset >= aligned + nread) {
+			return 0;
+		}
+	}
+
+	*data = &stream->buf[offset - stream->offset];
+
+	return (stream->offset + (off_t)stream->length) - offset;
+}
+
+ssize_t
+file_stream_read(struct file_stream_s *stream, off_t offset, void *data, size_t length)
+{
+	uint8_t *out = (uint8_t *)data;
+	size_t total = 0;
+
+	while (total < length) {
+		const uint8_t *p;
+		ssize_t avail = file_stream_peek(stream, offset + total, &p);
+
+		if (avail < 0) {
+			return (total > 0) ? (ssize_t)total : -1;
+		}
+
+		if (avail == 0) {
+			break;
+		}
+
+		size_t n = ((size_t)avail < (length - total)) ? (size_t)avail : (length - total);
+		memcpy(out + total, p, n);
+		total += n;
+	}
+
+	return total;
+}
+
+void
+file_stream_invalidate(struct file_stream_s *stream)
+{
+	stream->length = 0;
+}
+
+void
+file_stream_free(struct file_stream_s *stream)
+{
+	if (stream->buf != NULL) {
+		free(stream->buf);
+	}
+
+	stream->buf = NULL;
+	stream->size = 0;
+	stream->length = 0;
+}
@@ -0,0 +1,121 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file file_stream.h
+ *
+ * High-throughput file reader with a sector-aligned readahead buffer.
+ *
+ * Reads are performed in large sector-aligned chunks, so the FAT layer
+ * can transfer multiple sectors per media access instead of bouncing
+ * every small read through its single-sector cache.  Consumers either
+ * borrow a pointer into the readahead window (file_stream_peek) or copy
+ * out an arbitrary range (file_stream_read).
+ */
+
+#ifndef _SYSTEMLIB_FILE_STREAM_H
+#define _SYSTEMLIB_FILE_STREAM_H
+
+#include <sys/types.h>
+#include <stdint.h>
+
+/** media sector size the readahead buffer is aligned to */
+#define FILE_STREAM_SECTOR	512
+
+/**
+ * Stream state; initialise with file_stream_init.
+ */
+struct file_stream_s {
+	int		fd;		/**< file being streamed, owned by the caller */
+	uint8_t		*buf;		/**< sector-aligned readahead buffer */
+	unsigned	size;		/**< buffer size, a multiple of the sector size */
+	off_t		offset;		/**< file offset of buf[0] */
+	unsigned	length;		/**< valid bytes in the buffer, zero if empty */
+};
+
+__BEGIN_DECLS
+
+/**
+ * Initialise a file stream.
+ *
+ * @param stream	Stream state structure to be initialised.
+ * @param fd		File to read from; remains owned by the caller.
+ * @param size		Readahead buffer size, rounded up to a multiple of
+ *			the sector size.
+ * @return		Zero on success, nonzero on allocation failure.
+ */
+__EXPORT int		file_stream_init(struct file_stream_s *stream, int fd, unsigned size);
+
+/**
+ * Obtain a pointer into the readahead window.
+ *
+ * Refills the window with one large sector-aligned read if the offset
+ * falls outside of it.
+ *
+ * @param stream	Stream to read from.
+ * @param offset	File offset the returned pointer refers to.
+ * @param data		Set to point at the requested data on success.
+ * @return		The number of contiguous bytes available at the
+ *			returned pointer, zero at end of file, -1 on error.
+ */
+__EXPORT ssize_t	file_stream_peek(struct file_stream_s *stream, off_t offset, const uint8_t **data);
+
+/**
+ * Copy a range of the file through the readahead window.
+ *
+ * @param stream	Stream to read from.
+ * @param offset	File offset to read from.
+ * @param data		Where to copy the data.
+ * @param length	Number of bytes to copy.
+ * @return		The number of bytes copied; fewer than requested at
+ *			end of file, -1 on error.
+ */
+__EXPORT ssize_t	file_stream_read(struct file_stream_s *stream, off_t offset, void *data, size_t length);
+
+/**
+ * Discard the readahead window, e.g. after writing to the file.
+ *
+ * @param stream	Stream to invalidate.
+ */
+__EXPORT void		file_stream_invalidate(struct file_stream_s *stream);
+
+/**
+ * Release the readahead buffer. The file is not closed.
+ *
+ * @param stream	Stream to release.
+ */
+__EXPORT void		file_stream_free(struct file_stream_s *stream);
+
+__END_DECLS
+
+#endif
@@ -62,7 +62,6 @@ struct hx_stream {
 
 	/* TX state */
 	int			fd;
-	bool			tx_error;
 	const uint8_t		*tx_buf;
 	unsigned		tx_resid;
 	uint32_t		tx_crc;
@@ -85,15 +84,30 @@ struct hx_stream {
 #define FBO	0x7e	/**< Frame Boundary Octet */
 #define CEO	0x7c	/**< Control Escape Octet */
 
-static void	hx_tx_raw(hx_stream_t stream, uint8_t c);
-static void	hx_tx_raw(hx_stream_t stream, uint8_t c);
+static unsigned	hx_frame_bytes(uint8_t *p, const uint8_t *data, unsigned count);
 static int	hx_rx_frame(hx_stream_t stream);
 
-static void
-hx_tx_raw(hx_stream_t stream, uint8_t c)
+/**
+ * Append count bytes to p, escaping as needed; returns the number of
+ * bytes written.
+ */
+static unsigned
+hx_frame_bytes(uint8_t *p, const uint8_t *data, unsigned count)
 {
-	if (write(stream->fd, &c, 1) != 1)
-		stream->tx_error = true;
+	unsigned emitted = 0;
+
+	while (count--) {
+		uint8_t c = *data++;
+
+		if ((c == FBO) || (c == CEO)) {
+			p[emitted++] = CEO;
+			c ^= 0x20;
+		}
+
+		p[emitted++] = c;
+	}
+
+	return emitted;
 }
 
 static int
@@ -260,26 +274,47 @@ hx_stream_send_next(hx_stream_t stream)
 	return c;
 }
 
+int
+hx_stream_frame(hx_stream_t stream,
+	       const void *data,
+	       size_t count,
+	       void *frame,
+	       size_t frame_size)
+{
+	if (count > HX_STREAM_MAX_FRAME)
+		return -EINVAL;
+
+	/* worst case is every payload and CRC byte escaped, plus the boundary octets */
+	if (frame_size < (2 * (count + sizeof(uint32_t)) + 2))
+		return -EINVAL;
+
+	uint32_t crc = crc32(data, count);
+	uint8_t *p = frame;
+
+	*p++ = FBO;
+	p += hx_frame_bytes(p, data, count);
+	p += hx_frame_bytes(p, (const uint8_t *)&crc, sizeof(crc));
+	*p++ = FBO;
+
+	return p - (uint8_t *)frame;
+}
+
 int
 hx_stream_send(hx_stream_t stream,
 	       const void *data,
 	       size_t count)
 {
-	int result;
+	uint8_t frame[HX_STREAM_MAX_EMIT];
+	int length;
 
-	result = hx_stream_start(stream, data, count);
-	if (result != OK)
-		return result;
+	length = hx_stream_frame(stream, data, count, frame, sizeof(frame));
 
-	int c;
-	while ((c = hx_stream_send_next(stream)) >= 0)
-		hx_tx_raw(stream, c);
+	if (length < 0)
+		return length;
 
-	/* check for transmit error */
-	if (stream->tx_error) {
-		stream->tx_error = false;
+	/* emit the whole frame with a single write rather than per-byte calls */
+	if (write(stream->fd, frame, length) != length)
 		return -EIO;
-	}
 
 	perf_count(stream->pc_tx_frames);
 	return OK;
@@ -50,6 +50,9 @@ typedef struct hx_stream *hx_stream_t;
 
 #define HX_STREAM_MAX_FRAME	64
 
+/** worst-case encoded size of a maximum-length frame */
+#define HX_STREAM_MAX_EMIT	(2 * (HX_STREAM_MAX_FRAME + 4) + 2)
+
 typedef void (* hx_stream_rx_callback)(void *arg, const void *data, size_t length);
 
 __BEGIN_DECLS
@@ -130,14 +133,33 @@ __EXPORT extern int		hx_stream_start(hx_stream_t stream,
 __EXPORT extern int		hx_stream_send_next(hx_stream_t stream);
 
 /**
- * Send a frame.
+ * Encode a complete frame into a caller-supplied buffer.
+ *
+ * The buffer receives the boundary octets, the escaped payload and the
+ * escaped CRC, ready to be written to the wire in one piece.  A buffer
+ * of HX_STREAM_MAX_EMIT bytes is large enough for any frame.
  *
- * This function will block until all frame bytes are sent if
- * the descriptor passed to hx_stream_init is marked blocking,
- * otherwise it will return -1 (but may transmit a
- * runt frame at the same time).
+ * @param stream	A handle returned from hx_stream_init.
+ * @param data		Pointer to the data to encode.
+ * @param count		The number of payload bytes to encode.
+ * @param frame		Buffer receiving the encoded frame.
+ * @param frame_size	Size of the frame buffer.
+ * @return		The number of bytes placed in the frame buffer,
+ *			or -errno if the payload is too long or the
+ *			buffer too small.
+ */
+__EXPORT extern int		hx_stream_frame(hx_stream_t stream,
+		const void *data,
+		size_t count,
+		void *frame,
+		size_t frame_size);
+
+/**
+ * Send a frame.
  *
- * @todo Handling of non-blocking streams needs to be better.
+ * The frame is encoded once and written to the stream fd with a
+ * single write call; a short write on a non-blocking descriptor is
+ * reported as an error and may transmit a runt frame.
  *
  * @param stream	A handle returned from hx_stream_init.
  * @param data		Pointer to the data to send.
@@ -0,0 +1,196 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file load_governor.c
+ *
+ * CPU load governor; see load_governor.h for the model.
+ */
+
+#include <nuttx/config.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/clock.h>
+
+#include <stdio.h>
+#include <errno.h>
+
+#include <drivers/drv_hrt.h>
+#include <uORB/uORB.h>
+#include <uORB/topics/load_governor.h>
+
+#include "load_governor.h"
+#include "cpuload.h"
+#include "err.h"
+
+/**
+ * Evaluation period; the hysteresis counts below are in periods.
+ */
+#define GOVERNOR_INTERVAL	500000
+
+/** raise the shed level after this long below the idle floor */
+#define GOVERNOR_RAISE_COUNT	4	/* 2 seconds */
+/** lower the shed level after this long above the recovery share */
+#define GOVERNOR_LOWER_COUNT	10	/* 5 seconds */
+
+#define GOVERNOR_IDLE_FLOOR	0.05f
+#define GOVERNOR_IDLE_RECOVER	0.15f
+
+static struct work_s	governor_work;
+static bool		governor_running;
+static orb_advert_t	governor_pub = -1;
+static struct load_governor_s governor_status;
+
+static uint64_t		last_idle_runtime;
+static uint64_t		last_sample_time;
+static unsigned		raise_count;
+static unsigned		lower_count;
+
+static void	governor_cycle(void *arg);
+
+int
+load_governor_start(void)
+{
+#ifdef CONFIG_SCHED_INSTRUMENTATION
+	if (governor_running) {
+		return -EBUSY;
+	}
+
+	governor_running = true;
+	governor_status.shed_level = LOAD_SHED_NONE;
+	governor_status.idle_share = 1.0f;
+	raise_count = 0;
+	lower_count = 0;
+
+	/* the idle thread owns slot 0 of the instrumentation (see top) */
+	last_idle_runtime = system_load.tasks[0].total_runtime;
+	last_sample_time = hrt_absolute_time();
+
+	return work_queue(HPWORK, &governor_work, governor_cycle, NULL,
+			  USEC2TICK(GOVERNOR_INTERVAL));
+#else
+	return -ENOSYS;
+#endif
+}
+
+void
+load_governor_stop(void)
+{
+	if (!governor_running) {
+		return;
+	}
+
+	governor_running = false;
+	work_cancel(HPWORK, &governor_work);
+
+	/* let the subscribers resume normal operation */
+	if (governor_status.shed_level != LOAD_SHED_NONE) {
+		governor_status.timestamp = hrt_absolute_time();
+		governor_status.shed_level = LOAD_SHED_NONE;
+
+		if (governor_pub > 0) {
+			orb_publish(ORB_ID(load_governor), governor_pub, &governor_status);
+		}
+	}
+}
+
+bool
+load_governor_is_running(void)
+{
+	return governor_running;
+}
+
+void
+load_governor_print_status(void)
+{
+	printf("governor: %s, shed level %u, idle share %.1f%%\n",
+	       governor_running ? "running" : "stopped",
+	       (unsigned)governor_status.shed_level,
+	       (double)(governor_status.idle_share * 100.0f));
+}
+
+static void
+governor_cycle(void *arg)
+{
+#ifdef CONFIG_SCHED_INSTRUMENTATION
+	uint64_t now = hrt_absolute_time();
+	uint64_t idle_runtime = system_load.tasks[0].total_runtime;
+
+	float idle_share = (float)(idle_runtime - last_idle_runtime) /
+			   (float)(now - last_sample_time);
+
+	last_idle_runtime = idle_runtime;
+	last_sample_time = now;
+
+	unsigned level = governor_status.shed_level;
+
+	if (idle_share < GOVERNOR_IDLE_FLOOR) {
+		lower_count = 0;
+
+		if ((level < LOAD_SHED_UI) && (++raise_count >= GOVERNOR_RAISE_COUNT)) {
+			level++;
+			raise_count = 0;
+			warnx("governor: CPU saturated (idle %.1f%%), shed level %u",
+			      (double)(idle_share * 100.0f), level);
+		}
+
+	} else if (idle_share > GOVERNOR_IDLE_RECOVER) {
+		raise_count = 0;
+
+		if ((level > LOAD_SHED_NONE) && (++lower_count >= GOVERNOR_LOWER_COUNT)) {
+			level--;
+			lower_count = 0;
+		}
+
+	} else {
+		/* in the hysteresis band, hold the level */
+		raise_count = 0;
+		lower_count = 0;
+	}
+
+	governor_status.timestamp = now;
+	governor_status.idle_share = idle_share;
+	governor_status.shed_level = level;
+
+	if (governor_pub > 0) {
+		orb_publish(ORB_ID(load_governor), governor_pub, &governor_status);
+
+	} else {
+		governor_pub = orb_advertise(ORB_ID(load_governor), &governor_status);
+	}
+
+	if (governor_running) {
+		(void)work_queue(HPWORK, &governor_work, governor_cycle, NULL,
+				 USEC2TICK(GOVERNOR_INTERVAL));
+	}
+#endif
+}
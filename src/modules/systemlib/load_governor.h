@@ -0,0 +1,85 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file load_governor.h
+ *
+ * CPU load governor with QoS-based shedding.
+ *
+ * Watches the idle thread share of the scheduler instrumentation and
+ * raises or lowers a system-wide shed level in defined steps when the
+ * CPU is saturated or has recovered. Producers of pre-declared low-QoS
+ * work (mavlink stream rates, rate-limited log messages, LED pattern
+ * refreshes) subscribe to the load_governor topic and back off by the
+ * published level, so control loops keep their budget instead of
+ * degrading unpredictably.
+ *
+ * The evaluation runs from the high-priority work queue so it still
+ * gets CPU time at full saturation.
+ */
+
+#ifndef _SYSTEMLIB_LOAD_GOVERNOR_H
+#define _SYSTEMLIB_LOAD_GOVERNOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <platforms/px4_defines.h>
+
+__BEGIN_DECLS
+
+/**
+ * Start the governor evaluation on the work queue.
+ *
+ * @return		OK on success, -EBUSY if already running, -ENOSYS
+ *			without scheduler instrumentation.
+ */
+__EXPORT int	load_governor_start(void);
+
+/**
+ * Stop the governor; the shed level returns to zero.
+ */
+__EXPORT void	load_governor_stop(void);
+
+/**
+ * @return		true while the governor is running.
+ */
+__EXPORT bool	load_governor_is_running(void);
+
+/**
+ * Print the current shed level and idle share to stdout.
+ */
+__EXPORT void	load_governor_print_status(void);
+
+__END_DECLS
+
+#endif
@@ -0,0 +1,189 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file load_mon.c
+ *
+ * Low-rate system load monitor; see load_mon.h.
+ */
+
+#include <nuttx/config.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/clock.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include <drivers/drv_hrt.h>
+#include <uORB/uORB.h>
+#include <uORB/topics/cpu_load.h>
+
+#include "load_mon.h"
+#include "cpuload.h"
+
+/** snapshot period, the topic advertises this rate */
+#define LOAD_MON_INTERVAL	1000000
+
+static struct work_s	load_mon_work;
+static bool		load_mon_running;
+static orb_advert_t	load_mon_pub = -1;
+static struct cpu_load_s load_mon_status;
+
+static uint64_t		last_runtime[CONFIG_MAX_TASKS];
+static uint64_t		last_sample_time;
+
+static void	load_mon_cycle(void *arg);
+
+int
+load_mon_start(void)
+{
+#ifdef CONFIG_SCHED_INSTRUMENTATION
+	if (load_mon_running) {
+		return -EBUSY;
+	}
+
+	load_mon_running = true;
+	memset(last_runtime, 0, sizeof(last_runtime));
+	last_sample_time = hrt_absolute_time();
+
+	return work_queue(LPWORK, &load_mon_work, load_mon_cycle, NULL,
+			  USEC2TICK(LOAD_MON_INTERVAL));
+#else
+	return -ENOSYS;
+#endif
+}
+
+void
+load_mon_stop(void)
+{
+	if (!load_mon_running) {
+		return;
+	}
+
+	load_mon_running = false;
+	work_cancel(LPWORK, &load_mon_work);
+}
+
+bool
+load_mon_is_running(void)
+{
+	return load_mon_running;
+}
+
+void
+load_mon_print_status(void)
+{
+	printf("load_mon: %s, %u tasks in last snapshot\n",
+	       load_mon_running ? "running" : "stopped",
+	       (unsigned)load_mon_status.task_count);
+}
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION
+/**
+ * Sweep the fill pattern to find the stack watermark, as top does.
+ */
+static unsigned
+stack_free(FAR struct tcb_s *tcb, unsigned stack_size)
+{
+	uint8_t *sweeper = (uint8_t *)tcb->stack_alloc_ptr;
+	unsigned free_bytes = 0;
+
+	while (free_bytes < stack_size) {
+		if (*sweeper++ != 0xff) {
+			break;
+		}
+
+		free_bytes++;
+	}
+
+	return free_bytes;
+}
+#endif
+
+static void
+load_mon_cycle(void *arg)
+{
+#ifdef CONFIG_SCHED_INSTRUMENTATION
+	uint64_t now = hrt_absolute_time();
+	uint64_t interval = now - last_sample_time;
+	unsigned count = 0;
+
+	last_sample_time = now;
+
+	/* no locking, same read-only walk top performs interactively */
+	for (int i = 0; (i < CONFIG_MAX_TASKS) && (count < CPU_LOAD_MAX_TASKS); i++) {
+		if (!system_load.tasks[i].valid) {
+			last_runtime[i] = 0;
+			continue;
+		}
+
+		FAR struct tcb_s *tcb = system_load.tasks[i].tcb;
+		uint64_t runtime = system_load.tasks[i].total_runtime;
+		struct cpu_load_task_s *t = &load_mon_status.tasks[count];
+
+		/* a fresh task reuses the slot, skip its first interval */
+		uint64_t delta = ((last_runtime[i] > 0) && (runtime >= last_runtime[i])) ?
+				 (runtime - last_runtime[i]) : 0;
+		last_runtime[i] = runtime;
+
+		t->pid = tcb->pid;
+		t->load = (uint16_t)((delta * 1000) / interval);
+
+		unsigned stack_size = (uintptr_t)tcb->adj_stack_ptr -
+				      (uintptr_t)tcb->stack_alloc_ptr;
+		t->stack_size = stack_size;
+		t->stack_used = stack_size - stack_free(tcb, stack_size);
+
+		strncpy(t->name, tcb->name, sizeof(t->name) - 1);
+		t->name[sizeof(t->name) - 1] = '\0';
+
+		count++;
+	}
+
+	load_mon_status.timestamp = now;
+	load_mon_status.task_count = count;
+
+	if (load_mon_pub > 0) {
+		orb_publish(ORB_ID(cpu_load), load_mon_pub, &load_mon_status);
+
+	} else {
+		load_mon_pub = orb_advertise(ORB_ID(cpu_load), &load_mon_status);
+	}
+
+	if (load_mon_running) {
+		(void)work_queue(LPWORK, &load_mon_work, load_mon_cycle, NULL,
+				 USEC2TICK(LOAD_MON_INTERVAL));
+	}
+#endif
+}
@@ -0,0 +1,82 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file load_mon.h
+ *
+ * Low-rate system load monitor.
+ *
+ * Publishes the per-task CPU share and stack watermark from the
+ * scheduler instrumentation on the cpu_load topic once per second -
+ * the same data systemcmds/top shows interactively, but in a form
+ * sdlog2 records, so fleet-wide performance regressions show up in
+ * routine log review instead of requiring a shell session on a bench.
+ *
+ * Runs from the low-priority work queue; the stack sweep is slow work
+ * and must not delay drivers.
+ */
+
+#ifndef _SYSTEMLIB_LOAD_MON_H
+#define _SYSTEMLIB_LOAD_MON_H
+
+#include <stdbool.h>
+#include <platforms/px4_defines.h>
+
+__BEGIN_DECLS
+
+/**
+ * Start the load monitor on the work queue.
+ *
+ * @return		OK on success, -EBUSY if already running, -ENOSYS
+ *			without scheduler instrumentation.
+ */
+__EXPORT int	load_mon_start(void);
+
+/**
+ * Stop the load monitor.
+ */
+__EXPORT void	load_mon_stop(void);
+
+/**
+ * @return		true while the load monitor is running.
+ */
+__EXPORT bool	load_mon_is_running(void);
+
+/**
+ * Print the last snapshot to stdout.
+ */
+__EXPORT void	load_mon_print_status(void);
+
+__END_DECLS
+
+#endif
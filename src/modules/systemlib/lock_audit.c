@@ -0,0 +1,186 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file lock_audit.c
+ *
+ * Lock contention and priority-inversion auditing.
+ */
+
+#include <nuttx/config.h>
+#include <nuttx/irq.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+
+#include "lock_audit.h"
+#include "trace.h"
+
+/** registry of audit records for reporting, newest first */
+static struct lock_audit_s *lock_audit_list = NULL;
+
+/**
+ * Priority of the calling task, 0 if it cannot be determined.
+ */
+static uint8_t
+lock_audit_self_prio(void)
+{
+	struct sched_param sp;
+
+	if (sched_getparam(0, &sp) == 0) {
+		return sp.sched_priority;
+	}
+
+	return 0;
+}
+
+void
+lock_audit_init(struct lock_audit_s *la, const char *name)
+{
+	memset(la, 0, sizeof(*la));
+	la->name = name;
+}
+
+uint64_t
+lock_audit_prelock(struct lock_audit_s *la)
+{
+	uint64_t now = hrt_absolute_time();
+	uint32_t inversion_arg = 0;
+
+	irqstate_t flags = irqsave();
+
+	if (!la->registered) {
+		la->registered = true;
+		la->next = lock_audit_list;
+		lock_audit_list = la;
+	}
+
+	if (la->holder_pid != 0) {
+		la->contended++;
+
+		uint8_t prio = lock_audit_self_prio();
+
+		if (prio > la->holder_prio) {
+			la->inversions++;
+
+			/* waiter priority, holder priority and holder pid,
+			 * packed for the single trace argument */
+			inversion_arg = ((uint32_t)prio << 24)
+					| ((uint32_t)la->holder_prio << 16)
+					| ((uint32_t)la->holder_pid & 0xffff);
+		}
+	}
+
+	irqrestore(flags);
+
+	if (inversion_arg != 0) {
+		TRACE(TRACE_EV_LOCK_INVERSION, inversion_arg);
+	}
+
+	return now;
+}
+
+void
+lock_audit_locked(struct lock_audit_s *la, uint64_t t_start)
+{
+	uint64_t now = hrt_absolute_time();
+	uint64_t wait = now - t_start;
+	uint8_t prio = lock_audit_self_prio();
+	pid_t pid = getpid();
+
+	irqstate_t flags = irqsave();
+
+	la->acquisitions++;
+	la->holder_pid = pid;
+	la->holder_prio = prio;
+	la->acquire_time = now;
+
+	if (wait > la->wait_max) {
+		la->wait_max = wait;
+	}
+
+	irqrestore(flags);
+}
+
+void
+lock_audit_unlock(struct lock_audit_s *la)
+{
+	uint64_t now = hrt_absolute_time();
+
+	irqstate_t flags = irqsave();
+
+	uint64_t hold = now - la->acquire_time;
+
+	if (hold > la->hold_max) {
+		la->hold_max = hold;
+	}
+
+	la->holder_pid = 0;
+
+	irqrestore(flags);
+
+	if (hold > LOCK_AUDIT_HOLD_TRACE_US) {
+		TRACE(TRACE_EV_LOCK_HOLD, (uint32_t)hold);
+	}
+}
+
+void
+lock_audit_print_all(void)
+{
+	printf("%-16s %10s %10s %10s %12s %12s\n",
+	       "LOCK", "ACQUIRED", "CONTENDED", "INVERSIONS", "WAIT_MAX(us)", "HOLD_MAX(us)");
+
+	irqstate_t flags = irqsave();
+
+	for (struct lock_audit_s *la = lock_audit_list; la != NULL; la = la->next) {
+		/* counters are read without stopping writers; a report that
+		 * is one event stale is fine for a diagnosis listing */
+		irqrestore(flags);
+
+		printf("%-16s %10lu %10lu %10lu %12llu %12llu\n",
+		       la->name,
+		       (unsigned long)la->acquisitions,
+		       (unsigned long)la->contended,
+		       (unsigned long)la->inversions,
+		       la->wait_max,
+		       la->hold_max);
+
+		flags = irqsave();
+	}
+
+	irqrestore(flags);
+}
@@ -0,0 +1,120 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file lock_audit.h
+ *
+ * Lock contention and priority-inversion auditing.
+ *
+ * An audit record brackets an existing lock: lock_audit_prelock() is
+ * called before blocking on the lock, lock_audit_locked() once it is
+ * held and lock_audit_unlock() before releasing it. The record tracks
+ * hold and wait times, contended acquisitions and priority inversions
+ * (a waiter with higher priority than the current holder); inversions
+ * and long holds are additionally reported as trace events so they can
+ * be placed on the system timeline (see trace.h).
+ *
+ * The bracketing is cheap enough to stay compiled in; audited locks
+ * must only be taken from thread context. Instrumented records are
+ * listed with `trace locks` from the shell.
+ */
+
+#ifndef _SYSTEMLIB_LOCK_AUDIT_H
+#define _SYSTEMLIB_LOCK_AUDIT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#include <platforms/px4_defines.h>
+
+/**
+ * Hold times above this threshold (us) are reported as trace events.
+ */
+#define LOCK_AUDIT_HOLD_TRACE_US	1000
+
+/**
+ * One audited lock. Zero-initialise and set the name, or call
+ * lock_audit_init(); the record registers itself for reporting on
+ * first use.
+ */
+struct lock_audit_s {
+	const char *name;		/**< lock name for reports */
+	struct lock_audit_s *next;	/**< registry linkage, managed internally */
+	pid_t holder_pid;		/**< current holder, 0 while the lock is free */
+	uint8_t holder_prio;		/**< priority of the holder at acquisition */
+	bool registered;		/**< record is on the report list */
+	uint64_t acquire_time;		/**< time the current holder took the lock */
+	uint64_t hold_max;		/**< worst observed hold time (us) */
+	uint64_t wait_max;		/**< worst observed acquisition wait (us) */
+	uint32_t acquisitions;		/**< total acquisitions */
+	uint32_t contended;		/**< acquisitions that found the lock held */
+	uint32_t inversions;		/**< contended acquisitions with a lower-priority holder */
+};
+
+__BEGIN_DECLS
+
+/**
+ * Initialise an audit record; alternative to static zero-initialisation
+ * for records embedded in C++ objects.
+ */
+__EXPORT extern void		lock_audit_init(struct lock_audit_s *la, const char *name);
+
+/**
+ * Call before blocking on the audited lock.
+ *
+ * Checks the current holder for contention and priority inversion.
+ *
+ * @return			Timestamp to pass to lock_audit_locked().
+ */
+__EXPORT extern uint64_t	lock_audit_prelock(struct lock_audit_s *la);
+
+/**
+ * Call once the audited lock is held.
+ *
+ * @param t_start		Return value of the matching lock_audit_prelock().
+ */
+__EXPORT extern void		lock_audit_locked(struct lock_audit_s *la, uint64_t t_start);
+
+/**
+ * Call before releasing the audited lock.
+ */
+__EXPORT extern void		lock_audit_unlock(struct lock_audit_s *la);
+
+/**
+ * Print all registered audit records to stdout.
+ */
+__EXPORT extern void		lock_audit_print_all(void);
+
+__END_DECLS
+
+#endif
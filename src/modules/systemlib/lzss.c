@@ -0,0 +1,182 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file lzss.c
+ *
+ * Streaming LZSS decompression, counterpart of Tools/px_lzss_compress.py.
+ */
+
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "lzss.h"
+
+#ifndef OK
+#define OK 0
+#endif
+
+/**
+ * Fetch the next compressed byte, refilling the input buffer as needed.
+ *
+ * @return 0..255, -1 at end of file or -errno on error.
+ */
+static int
+next_in_byte(struct lzss_file_s *lf)
+{
+	if (lf->in_pos >= lf->in_len) {
+		ssize_t ret = read(lf->fd, lf->inbuf, sizeof(lf->inbuf));
+
+		if (ret < 0) {
+			return -errno;
+		}
+
+		if (ret == 0) {
+			return -1;
+		}
+
+		lf->in_len = ret;
+		lf->in_pos = 0;
+	}
+
+	return lf->inbuf[lf->in_pos++];
+}
+
+int
+lzss_fopen(struct lzss_file_s *lf, int fd)
+{
+	uint8_t header[8];
+
+	memset(lf, 0, sizeof(*lf));
+	lf->fd = fd;
+
+	if (lseek(fd, 0, SEEK_SET) < 0) {
+		return -errno;
+	}
+
+	if (read(fd, header, sizeof(header)) != sizeof(header)) {
+		lseek(fd, 0, SEEK_SET);
+		return -EINVAL;
+	}
+
+	uint32_t magic = header[0] | (header[1] << 8) | (header[2] << 16) | ((uint32_t)header[3] << 24);
+
+	if (magic != LZSS_MAGIC) {
+		/* not compressed - let the caller read the file raw */
+		lseek(fd, 0, SEEK_SET);
+		return -EINVAL;
+	}
+
+	lf->out_size = header[4] | (header[5] << 8) | (header[6] << 16) | ((uint32_t)header[7] << 24);
+
+	return OK;
+}
+
+ssize_t
+lzss_read(struct lzss_file_s *lf, uint8_t *buf, size_t n)
+{
+	size_t produced = 0;
+
+	while (produced < n && lf->out_pos < lf->out_size) {
+
+		/* drain a reference that spans output chunks first */
+		if (lf->match_len > 0) {
+			uint8_t b = lf->window[lf->match_pos];
+
+			lf->match_pos = (lf->match_pos + 1) % LZSS_WINDOW_SIZE;
+			lf->match_len--;
+
+			lf->window[lf->window_pos] = b;
+			lf->window_pos = (lf->window_pos + 1) % LZSS_WINDOW_SIZE;
+
+			buf[produced++] = b;
+			lf->out_pos++;
+			continue;
+		}
+
+		if (lf->flag_bits == 0) {
+			int c = next_in_byte(lf);
+
+			if (c < 0) {
+				return (c == -1) ? -EINVAL : c;
+			}
+
+			lf->flags = c;
+			lf->flag_bits = 8;
+		}
+
+		bool literal = (lf->flags & 1);
+		lf->flags >>= 1;
+		lf->flag_bits--;
+
+		if (literal) {
+			int c = next_in_byte(lf);
+
+			if (c < 0) {
+				return (c == -1) ? -EINVAL : c;
+			}
+
+			lf->window[lf->window_pos] = c;
+			lf->window_pos = (lf->window_pos + 1) % LZSS_WINDOW_SIZE;
+
+			buf[produced++] = c;
+			lf->out_pos++;
+
+		} else {
+			int hi = next_in_byte(lf);
+			int lo = next_in_byte(lf);
+
+			if (hi < 0 || lo < 0) {
+				return -EINVAL;
+			}
+
+			/* 11-bit distance back from the write position, 5-bit length */
+			unsigned token = (hi << 8) | lo;
+			unsigned distance = (token >> 5) + 1;
+			lf->match_len = (token & 0x1f) + LZSS_MIN_MATCH;
+			lf->match_pos = (lf->window_pos + LZSS_WINDOW_SIZE - distance) % LZSS_WINDOW_SIZE;
+		}
+	}
+
+	return produced;
+}
+
+int
+lzss_rewind(struct lzss_file_s *lf)
+{
+	int fd = lf->fd;
+
+	return lzss_fopen(lf, fd);
+}
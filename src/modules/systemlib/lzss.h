@@ -0,0 +1,103 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file lzss.h
+ *
+ * Streaming LZSS decompression for files compressed at build time with
+ * Tools/px_lzss_compress.py. The stream format is an 8-byte header
+ * ('PXLZ' magic plus the little-endian uncompressed size) followed by
+ * flag-byte groups: each flag bit selects a literal byte (1) or a
+ * 2-byte reference (0) with an 11-bit window offset and a 5-bit length
+ * (3..34 bytes). The decoder reads the compressed file sequentially
+ * and keeps a 2 KB window, so whole-file scratch buffers are not
+ * needed on the FMU.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+/** 'PXLZ' as found at the start of a compressed file */
+#define LZSS_MAGIC		0x5a4c5850
+
+#define LZSS_WINDOW_SIZE	2048
+#define LZSS_MIN_MATCH		3
+#define LZSS_INBUF_SIZE		64
+
+__BEGIN_DECLS
+
+struct lzss_file_s {
+	int		fd;		/**< underlying compressed file */
+	uint32_t	out_size;	/**< uncompressed size from the header */
+	uint32_t	out_pos;	/**< bytes produced so far */
+	unsigned	in_len;		/**< valid bytes in the input buffer */
+	unsigned	in_pos;		/**< consumed bytes in the input buffer */
+	uint8_t		flags;		/**< current flag byte */
+	uint8_t		flag_bits;	/**< flag bits left in the current group */
+	unsigned	match_pos;	/**< window position of the pending match */
+	unsigned	match_len;	/**< remaining bytes of the pending match */
+	unsigned	window_pos;	/**< write position in the window */
+	uint8_t		inbuf[LZSS_INBUF_SIZE];
+	uint8_t		window[LZSS_WINDOW_SIZE];
+};
+
+/**
+ * Attach the decoder to an open file and parse the header.
+ *
+ * The file offset is expected to be at the start of the file.
+ *
+ * @param lf		Decoder state to initialize.
+ * @param fd		Open file descriptor; stays owned by the caller.
+ * @return		OK if the file carries the LZSS magic,
+ *			-EINVAL otherwise (the offset is rewound so the
+ *			caller can fall back to reading the file raw).
+ */
+__EXPORT int		lzss_fopen(struct lzss_file_s *lf, int fd);
+
+/**
+ * Decompress the next bytes of the file.
+ *
+ * @return		Number of bytes produced, 0 at end of stream,
+ *			or -errno on a read error or corrupt stream.
+ */
+__EXPORT ssize_t	lzss_read(struct lzss_file_s *lf, uint8_t *buf, size_t n);
+
+/**
+ * Restart decompression from the beginning of the file.
+ */
+__EXPORT int		lzss_rewind(struct lzss_file_s *lf);
+
+__END_DECLS
@@ -39,11 +39,15 @@
  * @author Lorenz Meier <lm@inf.ethz.ch>
  */
 
+#include <nuttx/config.h>
+#include <nuttx/irq.h>
+
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
 
+#include <drivers/drv_hrt.h>
 #include <mavlink/mavlink_log.h>
 
 __EXPORT void mavlink_logbuffer_init(struct mavlink_logbuffer *lb, int size)
@@ -52,6 +56,10 @@ __EXPORT void mavlink_logbuffer_init(struct mavlink_logbuffer *lb, int size)
 	lb->start = 0;
 	lb->count = 0;
 	lb->elems = calloc(lb->size, sizeof(struct mavlink_logmessage));
+	lb->dropped = 0;
+	lb->last_repeats = 0;
+	lb->last_time = 0;
+	memset(&lb->last, 0, sizeof(lb->last));
 }
 
 __EXPORT void mavlink_logbuffer_destroy(struct mavlink_logbuffer *lb)
@@ -72,49 +80,136 @@ __EXPORT int mavlink_logbuffer_is_empty(struct mavlink_logbuffer *lb)
 	return lb->count == 0;
 }
 
-__EXPORT void mavlink_logbuffer_write(struct mavlink_logbuffer *lb, const struct mavlink_logmessage *elem)
+/**
+ * Append an entry, assuming the caller holds the critical section.
+ *
+ * A full buffer evicts by severity: critical and worse messages push
+ * out the least severe queued entry, while less severe arrivals are
+ * dropped and counted instead of silently overwriting older entries
+ * that may matter more.
+ */
+static void mavlink_logbuffer_insert(struct mavlink_logbuffer *lb, const struct mavlink_logmessage *elem)
 {
-	int end = (lb->start + lb->count) % lb->size;
-	memcpy(&(lb->elems[end]), elem, sizeof(struct mavlink_logmessage));
-
 	if (mavlink_logbuffer_is_full(lb)) {
-		lb->start = (lb->start + 1) % lb->size; /* full, overwrite */
+		if (elem->severity <= MAVLINK_LOG_SEVERITY_CRITICAL) {
+			/* find the least severe queued entry (higher value = less severe) */
+			int victim = 0;
+			unsigned char victim_severity = 0;
+
+			for (int i = 0; i < lb->count; i++) {
+				unsigned int idx = (lb->start + i) % lb->size;
+
+				if (lb->elems[idx].severity >= victim_severity) {
+					victim_severity = lb->elems[idx].severity;
+					victim = i;
+				}
+			}
+
+			/* close the gap, keeping the remaining entries in order */
+			for (int i = victim; i < lb->count - 1; i++) {
+				unsigned int dst = (lb->start + i) % lb->size;
+				unsigned int src = (lb->start + i + 1) % lb->size;
+				memcpy(&lb->elems[dst], &lb->elems[src], sizeof(struct mavlink_logmessage));
+			}
+
+			lb->count--;
+			lb->dropped++;
+
+		} else {
+			/* the new message is the least important one, drop it */
+			lb->dropped++;
+			return;
+		}
+	}
+
+	unsigned int end = (lb->start + lb->count) % lb->size;
+	memcpy(&lb->elems[end], elem, sizeof(struct mavlink_logmessage));
+	lb->count++;
+}
 
-	} else {
-		++lb->count;
+__EXPORT void mavlink_logbuffer_write(struct mavlink_logbuffer *lb, const struct mavlink_logmessage *elem)
+{
+	irqstate_t flags = irqsave();
+
+	uint64_t now = hrt_absolute_time();
+
+	/* fold duplicate bursts: an identical message within the window
+	 * only bumps the repeat counter and never occupies a slot;
+	 * deferred entries compare by format pointer and argument words,
+	 * preformatted entries by text */
+	if ((lb->last_time != 0)
+	    && (now - lb->last_time < MAVLINK_LOG_FOLD_INTERVAL)
+	    && (elem->severity == lb->last.severity)
+	    && (elem->fmt == lb->last.fmt)
+	    && ((elem->fmt != NULL) ?
+		(memcmp(elem->args, lb->last.args, sizeof(elem->args)) == 0) :
+		(strncmp(elem->text, lb->last.text, MAVLINK_LOG_MAXLEN) == 0))) {
+		lb->last_repeats++;
+		lb->last_time = now;
+		irqrestore(flags);
+		return;
 	}
+
+	/* surface the folded repeats before the new message */
+	if (lb->last_repeats > 0) {
+		struct mavlink_logmessage summary;
+		summary.severity = lb->last.severity;
+		summary.fmt = NULL;
+		snprintf(summary.text, sizeof(summary.text),
+			 "last message repeated %u times", lb->last_repeats);
+		mavlink_logbuffer_insert(lb, &summary);
+		lb->last_repeats = 0;
+	}
+
+	memcpy(&lb->last, elem, sizeof(lb->last));
+	lb->last_time = now;
+
+	mavlink_logbuffer_insert(lb, elem);
+
+	irqrestore(flags);
 }
 
 __EXPORT int mavlink_logbuffer_read(struct mavlink_logbuffer *lb, struct mavlink_logmessage *elem)
 {
+	int ret = 1;
+
+	irqstate_t flags = irqsave();
+
 	if (!mavlink_logbuffer_is_empty(lb)) {
 		memcpy(elem, &(lb->elems[lb->start]), sizeof(struct mavlink_logmessage));
 		lb->start = (lb->start + 1) % lb->size;
 		--lb->count;
 
-		return 0;
+		ret = 0;
 
-	} else {
-		return 1;
+	} else if (lb->dropped > 0) {
+		/* the buffer has drained, account for what was lost */
+		elem->severity = MAVLINK_LOG_SEVERITY_CRITICAL + 1;
+		elem->fmt = NULL;
+		snprintf(elem->text, sizeof(elem->text),
+			 "mavlink log: %u messages dropped", lb->dropped);
+		lb->dropped = 0;
+
+		ret = 0;
 	}
+
+	irqrestore(flags);
+
+	return ret;
 }
 
 __EXPORT void mavlink_logbuffer_vasprintf(struct mavlink_logbuffer *lb, int severity, const char *fmt, ...)
 {
+	struct mavlink_logmessage msg;
+
 	va_list ap;
 	va_start(ap, fmt);
-	int end = (lb->start + lb->count) % lb->size;
-	lb->elems[end].severity = severity;
-	vsnprintf(lb->elems[end].text, sizeof(lb->elems[0].text), fmt, ap);
+	msg.severity = severity;
+	msg.fmt = NULL;
+	vsnprintf(msg.text, sizeof(msg.text), fmt, ap);
 	va_end(ap);
 
-	/* increase count */
-	if (mavlink_logbuffer_is_full(lb)) {
-		lb->start = (lb->start + 1) % lb->size; /* full, overwrite */
-
-	} else {
-		++lb->count;
-	}
+	mavlink_logbuffer_write(lb, &msg);
 }
 
 __EXPORT void mavlink_vasprintf(int _fd, int severity, const char *fmt, ...)
@@ -126,3 +221,24 @@ __EXPORT void mavlink_vasprintf(int _fd, int severity, const char *fmt, ...)
 	va_end(ap);
 	ioctl(_fd, severity, (unsigned long)&text[0]);
 }
+
+__EXPORT void mavlink_log_deferred(int _fd, int severity, const char *fmt,
+				   const uintptr_t *args, unsigned argc)
+{
+	struct mavlink_deferred_logmessage msg;
+
+	msg.fmt = fmt;
+	msg.severity = severity;
+
+	if (argc > MAVLINK_LOG_MAX_DEFERRED_ARGS) {
+		argc = MAVLINK_LOG_MAX_DEFERRED_ARGS;
+	}
+
+	msg.argc = argc;
+
+	for (unsigned i = 0; i < MAVLINK_LOG_MAX_DEFERRED_ARGS; i++) {
+		msg.args[i] = (i < argc) ? args[i] : 0;
+	}
+
+	ioctl(_fd, MAVLINK_IOC_SEND_TEXT_DEFERRED, (unsigned long)&msg);
+}
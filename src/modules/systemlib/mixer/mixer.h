@@ -184,6 +184,17 @@ public:
 	 */
 	virtual void			groups_required(uint32_t &groups) = 0;
 
+	/**
+	 * Access the simple-mixer configuration.
+	 *
+	 * Lets callers export the loaded configuration into an alternative
+	 * execution form, e.g. a fixed-point table on an FPU-less processor.
+	 *
+	 * @return			The configuration, or nullptr if this
+	 *				mixer is not a simple mixer.
+	 */
+	virtual const mixer_simple_s	*get_simple_info() const { return nullptr; }
+
 protected:
 	/** client-supplied callback used when fetching control values */
 	ControlCallback			_control_cb;
@@ -312,6 +323,30 @@ public:
 	 */
 	int				load_from_buf(const char *buf, unsigned &buflen);
 
+	/**
+	 * Adds mixers to the group from a precompiled binary mixer image.
+	 *
+	 * Binary images are generated at build time from the mixer text
+	 * files by Tools/px_mixer_compile.py. They carry the same
+	 * information as the text form, but fields are fixed-layout
+	 * little-endian values that are copied out with memcpy, so no
+	 * parsing happens at load time.
+	 *
+	 * The image starts with the magic bytes "PXMB", a format version
+	 * byte and a mixer count byte, followed by one record per mixer;
+	 * see the compiler for the record layout.
+	 *
+	 * @param buf			The binary mixer image.
+	 * @param buflen		The length of the image in bytes.
+	 * @return			Zero on successful load, nonzero otherwise.
+	 */
+	int				load_from_binary(const uint8_t *buf, unsigned buflen);
+
+	/**
+	 * Access the first mixer in the group; iterate with _next.
+	 */
+	Mixer				*first() { return _first; }
+
 private:
 	Mixer				*_first;	/**< linked list of mixers */
 
@@ -414,6 +449,8 @@ public:
 	virtual unsigned		mix(float *outputs, unsigned space, uint16_t *status_reg);
 	virtual void			groups_required(uint32_t &groups);
 
+	virtual const mixer_simple_s	*get_simple_info() const { return _info; }
+
 	/**
 	 * Check that the mixer configuration as loaded is sensible.
 	 *
@@ -519,6 +556,9 @@ public:
 	virtual void			groups_required(uint32_t &groups);
 
 private:
+	/** largest rotor count of any supported geometry */
+	static const unsigned		_rotor_count_max = 8;
+
 	float				_roll_scale;
 	float				_pitch_scale;
 	float				_yaw_scale;
@@ -530,6 +570,9 @@ private:
 	unsigned			_rotor_count;
 	const Rotor			*_rotors;
 
+	/** per-rotor mix table with the output scale folded in, precomputed at construction */
+	Rotor				_rotor_mix[_rotor_count_max];
+
 	/* do not allow to copy due to ptr data members */
 	MultirotorMixer(const MultirotorMixer&);
 	MultirotorMixer operator=(const MultirotorMixer&);
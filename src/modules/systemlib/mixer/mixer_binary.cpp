@@ -0,0 +1,228 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mixer_binary.cpp
+ *
+ * Loader for precompiled binary mixer images.
+ *
+ * The image format is produced at build time by Tools/px_mixer_compile.py
+ * from the mixer text files; each record mirrors the corresponding text
+ * definition with fixed-layout little-endian fields:
+ *
+ *   header:     'P' 'X' 'M' 'B' <version:u8> <mixer count:u8>
+ *   null:       'Z'
+ *   multirotor: 'R' <geometry:u8> <roll:f32> <pitch:f32> <yaw:f32> <idle:f32>
+ *   simple:     'M' <control count:u8> <output scaler:5 x f32>
+ *               then per control: <group:u8> <index:u8> <scaler:5 x f32>
+ *
+ * This file is not built into the px4io firmware, which receives mixer
+ * definitions in text form over the serial protocol.
+ */
+
+#include <nuttx/config.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mixer.h"
+#include "mixer_load.h"
+
+// This file is generated by the multi_tables script which is invoked during the build process
+#include "mixer_multirotor.generated.h"
+
+#define debug(fmt, args...)	do { } while(0)
+//#define debug(fmt, args...)	do { printf("[mixer] " fmt "\n", ##args); } while(0)
+
+namespace
+{
+
+/**
+ * Cursor over a binary mixer image; get() fails once the
+ * image is exhausted rather than reading past the end.
+ */
+struct BinaryReader {
+	const uint8_t	*buf;
+	unsigned	remaining;
+
+	bool get(void *out, unsigned len)
+	{
+		if (len > remaining) {
+			return false;
+		}
+
+		memcpy(out, buf, len);
+		buf += len;
+		remaining -= len;
+		return true;
+	}
+
+	bool get_scaler(mixer_scaler_s &scaler)
+	{
+		float v[5];
+
+		if (!get(v, sizeof(v))) {
+			return false;
+		}
+
+		scaler.negative_scale	= v[0];
+		scaler.positive_scale	= v[1];
+		scaler.offset		= v[2];
+		scaler.min_output	= v[3];
+		scaler.max_output	= v[4];
+		return true;
+	}
+};
+
+Mixer *
+multirotor_from_binary(Mixer::ControlCallback control_cb, uintptr_t cb_handle, BinaryReader &reader)
+{
+	uint8_t geometry;
+	float v[4];
+
+	if (!reader.get(&geometry, sizeof(geometry)) || !reader.get(v, sizeof(v))) {
+		debug("binary multirotor record truncated");
+		return nullptr;
+	}
+
+	if (geometry >= (MultirotorGeometryUnderlyingType)MultirotorGeometry::MAX_GEOMETRY) {
+		debug("binary multirotor record has bad geometry %u", geometry);
+		return nullptr;
+	}
+
+	return new MultirotorMixer(control_cb, cb_handle,
+				   (MultirotorGeometry)geometry,
+				   v[0], v[1], v[2], v[3]);
+}
+
+Mixer *
+simple_from_binary(Mixer::ControlCallback control_cb, uintptr_t cb_handle, BinaryReader &reader)
+{
+	uint8_t inputs;
+
+	if (!reader.get(&inputs, sizeof(inputs))) {
+		debug("binary simple record truncated");
+		return nullptr;
+	}
+
+	mixer_simple_s *mixinfo = (mixer_simple_s *)malloc(MIXER_SIMPLE_SIZE(inputs));
+
+	if (mixinfo == nullptr) {
+		debug("could not allocate memory for mixer info");
+		return nullptr;
+	}
+
+	mixinfo->control_count = inputs;
+
+	if (!reader.get_scaler(mixinfo->output_scaler)) {
+		free(mixinfo);
+		return nullptr;
+	}
+
+	for (unsigned i = 0; i < inputs; i++) {
+		if (!reader.get(&mixinfo->controls[i].control_group, sizeof(uint8_t)) ||
+		    !reader.get(&mixinfo->controls[i].control_index, sizeof(uint8_t)) ||
+		    !reader.get_scaler(mixinfo->controls[i].scaler)) {
+			free(mixinfo);
+			return nullptr;
+		}
+	}
+
+	SimpleMixer *sm = new SimpleMixer(control_cb, cb_handle, mixinfo);
+
+	if (sm == nullptr) {
+		free(mixinfo);
+	}
+
+	return sm;
+}
+
+} // anonymous namespace
+
+int
+MixerGroup::load_from_binary(const uint8_t *buf, unsigned buflen)
+{
+	BinaryReader reader = { buf, buflen };
+
+	uint8_t header[MIXER_BINARY_HEADER_SIZE];
+
+	if (!reader.get(header, sizeof(header)) ||
+	    memcmp(header, MIXER_BINARY_MAGIC, MIXER_BINARY_MAGIC_SIZE) != 0) {
+		debug("bad binary mixer magic");
+		return -1;
+	}
+
+	if (header[MIXER_BINARY_MAGIC_SIZE] != MIXER_BINARY_VERSION) {
+		debug("unsupported binary mixer version %u", header[MIXER_BINARY_MAGIC_SIZE]);
+		return -1;
+	}
+
+	unsigned count = header[MIXER_BINARY_MAGIC_SIZE + 1];
+
+	for (unsigned i = 0; i < count; i++) {
+		Mixer *m = nullptr;
+		uint8_t type;
+
+		if (!reader.get(&type, sizeof(type))) {
+			debug("binary mixer image truncated");
+			return -1;
+		}
+
+		switch (type) {
+		case 'Z':
+			m = new NullMixer();
+			break;
+
+		case 'M':
+			m = simple_from_binary(_control_cb, _cb_handle, reader);
+			break;
+
+		case 'R':
+			m = multirotor_from_binary(_control_cb, _cb_handle, reader);
+			break;
+
+		default:
+			debug("unknown binary mixer record type 0x%02x", type);
+			return -1;
+		}
+
+		if (m == nullptr) {
+			return -1;
+		}
+
+		add_mixer(m);
+	}
+
+	return 0;
+}
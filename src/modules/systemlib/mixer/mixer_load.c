@@ -103,3 +103,33 @@ int load_mixer_file(const char *fname, char *buf, unsigned maxlen)
 	return 0;
 }
 
+
+int load_mixer_binary(const char *fname, uint8_t *buf, unsigned maxlen)
+{
+	char	bname[64];
+	FILE	*fp;
+	int	len;
+
+	/* the binary sibling carries the text file name with a 'b' appended */
+	if (snprintf(bname, sizeof(bname), "%sb", fname) >= (int)sizeof(bname)) {
+		return -1;
+	}
+
+	fp = fopen(bname, "r");
+	if (fp == NULL) {
+		return -1;
+	}
+
+	len = fread(buf, 1, maxlen, fp);
+	fclose(fp);
+
+	/* sanity-check the image header before handing it out */
+	if (len < MIXER_BINARY_HEADER_SIZE ||
+	    memcmp(buf, MIXER_BINARY_MAGIC, MIXER_BINARY_MAGIC_SIZE) != 0 ||
+	    buf[MIXER_BINARY_MAGIC_SIZE] != MIXER_BINARY_VERSION) {
+		warnx("bad binary mixer image: %s", bname);
+		return -1;
+	}
+
+	return len;
+}
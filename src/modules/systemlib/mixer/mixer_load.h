@@ -41,11 +41,34 @@
 #define _SYSTEMLIB_MIXER_LOAD_H value
 
 #include <nuttx/config.h>
+#include <stdint.h>
+
+/*
+ * Precompiled binary mixer images, generated at build time by
+ * Tools/px_mixer_compile.py from the mixer text files and stored
+ * next to them with a 'b' appended to the file name.
+ */
+#define MIXER_BINARY_MAGIC		"PXMB"
+#define MIXER_BINARY_MAGIC_SIZE		4
+#define MIXER_BINARY_VERSION		1
+#define MIXER_BINARY_HEADER_SIZE	6
 
 __BEGIN_DECLS
 
 __EXPORT int load_mixer_file(const char *fname, char *buf, unsigned maxlen);
 
+/**
+ * Load the precompiled binary image belonging to a mixer text file.
+ *
+ * @param fname		Name of the mixer text file; the binary sibling
+ *			is derived by appending 'b'.
+ * @param buf		Buffer receiving the image.
+ * @param maxlen	Size of the buffer in bytes.
+ * @return		Length of the image in bytes, or -1 if no valid
+ *			binary image is available.
+ */
+__EXPORT int load_mixer_binary(const char *fname, uint8_t *buf, unsigned maxlen);
+
 __END_DECLS
 
 #endif
@@ -93,6 +93,15 @@ MultirotorMixer::MultirotorMixer(ControlCallback control_cb,
 	_rotor_count(_config_rotor_count[(MultirotorGeometryUnderlyingType)geometry]),
 	_rotors(_config_index[(MultirotorGeometryUnderlyingType)geometry])
 {
+	/* precompute the mix table with the per-rotor output scale folded
+	 * into the roll/pitch/thrust columns, so the mix loop runs on plain
+	 * multiply-accumulates */
+	for (unsigned i = 0; i < _rotor_count && i < _rotor_count_max; i++) {
+		_rotor_mix[i].roll_scale  = _rotors[i].roll_scale * _rotors[i].out_scale;
+		_rotor_mix[i].pitch_scale = _rotors[i].pitch_scale * _rotors[i].out_scale;
+		_rotor_mix[i].yaw_scale   = _rotors[i].yaw_scale;
+		_rotor_mix[i].out_scale   = _rotors[i].out_scale;
+	}
 }
 
 MultirotorMixer::~MultirotorMixer()
@@ -213,21 +222,12 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 		(*status_reg) = 0;
 	}
 
-	/* perform initial mix pass yielding unbounded outputs, ignore yaw */
+	/* perform initial mix pass from the precomputed table yielding
+	 * unbounded outputs, ignore yaw */
 	for (unsigned i = 0; i < _rotor_count; i++) {
-		float out = roll * _rotors[i].roll_scale +
-			    pitch * _rotors[i].pitch_scale +
-			    thrust;
-
-		out *= _rotors[i].out_scale;
-
-		/* limit yaw if it causes outputs clipping */
-		if (out >= 0.0f && out < -yaw * _rotors[i].yaw_scale) {
-			yaw = -out / _rotors[i].yaw_scale;
-			if(status_reg != NULL) {
-				(*status_reg) |= PX4IO_P_STATUS_MIXER_YAW_LIMIT;
-			}
-		}
+		float out = roll * _rotor_mix[i].roll_scale +
+			    pitch * _rotor_mix[i].pitch_scale +
+			    thrust * _rotor_mix[i].out_scale;
 
 		/* calculate min and max output values */
 		if (out < min_out) {
@@ -240,51 +240,85 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 		outputs[i] = out;
 	}
 
-	/* scale down roll/pitch controls if some outputs are negative, don't add yaw, keep total thrust */
-	if (min_out < 0.0f) {
-		float scale_in = thrust / (thrust - min_out);
+	/*
+	 * Desaturate with prioritized axes: sacrifice thrust first by shifting
+	 * the whole output band inside the limits, scale roll/pitch only if
+	 * the band itself is wider than the output range, and clip yaw last.
+	 */
+	float boost = 0.0f;
+	float roll_pitch_scale = 1.0f;
+
+	if (max_out - min_out > 1.0f) {
+		/* roll/pitch demand exceeds the full output range: scale it down
+		 * around the thrust setpoint and center the band */
+		roll_pitch_scale = 1.0f / (max_out - min_out);
+		boost = -((min_out - thrust) * roll_pitch_scale + thrust);
+
+		if (status_reg != NULL) {
+			(*status_reg) |= PX4IO_P_STATUS_MIXER_LOWER_LIMIT | PX4IO_P_STATUS_MIXER_UPPER_LIMIT;
+		}
 
-		max_out = 0.0f;
+	} else if (min_out < 0.0f) {
+		/* increase thrust to preserve roll/pitch authority */
+		boost = -min_out;
 
-		/* mix again with adjusted controls */
-		for (unsigned i = 0; i < _rotor_count; i++) {
-			float out = scale_in * (roll * _rotors[i].roll_scale + pitch * _rotors[i].pitch_scale) + thrust;
+		if (status_reg != NULL) {
+			(*status_reg) |= PX4IO_P_STATUS_MIXER_LOWER_LIMIT;
+		}
 
-			/* update max output value */
-			if (out > max_out) {
-				max_out = out;
-			}
+	} else if (max_out > 1.0f) {
+		/* reduce thrust to preserve roll/pitch authority */
+		boost = 1.0f - max_out;
 
-			outputs[i] = out;
+		if (status_reg != NULL) {
+			(*status_reg) |= PX4IO_P_STATUS_MIXER_UPPER_LIMIT;
 		}
+	}
 
-		if(status_reg != NULL) {
-			(*status_reg) |= PX4IO_P_STATUS_MIXER_LOWER_LIMIT;
+	if (roll_pitch_scale < 1.0f) {
+		/* mix again with the scaled roll/pitch demand */
+		for (unsigned i = 0; i < _rotor_count; i++) {
+			outputs[i] = (roll * _rotor_mix[i].roll_scale +
+				      pitch * _rotor_mix[i].pitch_scale) * roll_pitch_scale +
+				     thrust * _rotor_mix[i].out_scale + boost;
 		}
 
-	} else {
-		/* roll/pitch mixed without lower side limiting, add yaw control */
+	} else if (fabsf(boost) > 0.0f) {
 		for (unsigned i = 0; i < _rotor_count; i++) {
-			outputs[i] += yaw * _rotors[i].yaw_scale;
+			outputs[i] += boost;
 		}
 	}
 
-	/* scale down all outputs if some outputs are too large, reduce total thrust */
-	float scale_out;
-	if (max_out > 1.0f) {
-		scale_out = 1.0f / max_out;
+	/* allow as much yaw as fits into the remaining headroom, with a single
+	 * gain so the relative yaw authority between rotors is preserved */
+	float yaw_gain = 1.0f;
 
-		if(status_reg != NULL) {
-			(*status_reg) |= PX4IO_P_STATUS_MIXER_UPPER_LIMIT;
+	for (unsigned i = 0; i < _rotor_count; i++) {
+		float out_yaw = yaw * _rotor_mix[i].yaw_scale;
+		float room = (out_yaw > 0.0f) ? (1.0f - outputs[i]) : outputs[i];
+
+		if (room < 0.0f) {
+			room = 0.0f;
 		}
 
-	} else {
-		scale_out = 1.0f;
+		if (fabsf(out_yaw) > room) {
+			float gain = room / fabsf(out_yaw);
+
+			if (gain < yaw_gain) {
+				yaw_gain = gain;
+			}
+
+			if (status_reg != NULL) {
+				(*status_reg) |= PX4IO_P_STATUS_MIXER_YAW_LIMIT;
+			}
+		}
 	}
 
-	/* scale outputs to range _idle_speed..1, and do final limiting */
+	/* add yaw, scale outputs to range _idle_speed..1, and do final limiting */
 	for (unsigned i = 0; i < _rotor_count; i++) {
-		outputs[i] = constrain(_idle_speed + (outputs[i] * (1.0f - _idle_speed) * scale_out), _idle_speed, 1.0f);
+		float out = outputs[i] + yaw * _rotor_mix[i].yaw_scale * yaw_gain;
+
+		outputs[i] = constrain(_idle_speed + (out * (1.0f - _idle_speed)), _idle_speed, 1.0f);
 	}
 
 	return _rotor_count;
@@ -41,6 +41,7 @@ SRCS		= mixer.cpp \
 		  mixer_group.cpp \
 		  mixer_multirotor.cpp \
 		  mixer_simple.cpp \
+		  mixer_binary.cpp \
 		  mixer_load.c
 
 SELF_DIR := $(dir $(lastword $(MAKEFILE_LIST)))
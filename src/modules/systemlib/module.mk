@@ -37,8 +37,20 @@
 
 SRCS		 = err.c \
 		   hx_stream.c \
+		   file_stream.c \
 		   perf_counter.c \
+		   rate_loop.c \
+		   obj_pool.c \
+		   lzss.c \
+		   trace.c \
+		   lock_audit.c \
+		   watchdog.c \
+		   load_governor.c \
+		   load_mon.c \
+		   px4_work.c \
+		   px4_exec.c \
 		   param/param.c \
+		   param/param_cache.c \
 		   bson/tinybson.c \
 		   conversions.c \
 		   cpuload.c \
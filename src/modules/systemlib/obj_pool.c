@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file obj_pool.c
+ *
+ * Fixed-block object pools for long-lived driver objects.
+ */
+
+#include <string.h>
+#include <nuttx/irq.h>
+
+#include "obj_pool.h"
+
+/**
+ * Registry of all pools, for 'heapinfo' reporting
+ */
+static struct obj_pool_s *pool_registry;
+
+void
+obj_pool_init(struct obj_pool_s *pool, const char *name,
+	      void *storage, size_t block_size, unsigned nblocks)
+{
+	pool->name = name;
+	pool->base = (uint8_t *)storage;
+	pool->block_size = block_size;
+	pool->nblocks = nblocks;
+	pool->used = 0;
+	pool->peak = 0;
+	pool->free_list = NULL;
+
+	/* thread the blocks onto the free list, first block on top */
+	for (unsigned i = nblocks; i > 0; i--) {
+		void *block = pool->base + (i - 1) * block_size;
+
+		*(void **)block = pool->free_list;
+		pool->free_list = block;
+	}
+
+	/* pools are created at boot but list walkers may already run */
+	irqstate_t flags = irqsave();
+	pool->next = pool_registry;
+	pool_registry = pool;
+	irqrestore(flags);
+}
+
+void *
+obj_pool_alloc(struct obj_pool_s *pool)
+{
+	irqstate_t flags = irqsave();
+	void *block = pool->free_list;
+
+	if (block != NULL) {
+		pool->free_list = *(void **)block;
+		pool->used++;
+
+		if (pool->used > pool->peak) {
+			pool->peak = pool->used;
+		}
+	}
+
+	irqrestore(flags);
+	return block;
+}
+
+void
+obj_pool_free(struct obj_pool_s *pool, void *ptr)
+{
+	if (ptr == NULL) {
+		return;
+	}
+
+	irqstate_t flags = irqsave();
+	*(void **)ptr = pool->free_list;
+	pool->free_list = ptr;
+	pool->used--;
+	irqrestore(flags);
+}
+
+struct obj_pool_s *
+obj_pool_next(struct obj_pool_s *pool)
+{
+	if (pool == NULL) {
+		return pool_registry;
+	}
+
+	return pool->next;
+}
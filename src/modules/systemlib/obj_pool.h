@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file obj_pool.h
+ *
+ * Fixed-block object pools for long-lived driver objects.
+ *
+ * Driver instances and their report buffers are allocated once at boot
+ * but freed and re-allocated on every driver restart, which fragments
+ * the NuttX heap over long missions. A pool carves its blocks out of
+ * storage the caller provides (typically a static array sized at boot),
+ * so repeated restarts recycle the same blocks and never touch the
+ * heap. Pools register themselves on creation, so 'heapinfo' can list
+ * per-pool usage and high watermarks next to the heap statistics.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+__BEGIN_DECLS
+
+struct obj_pool_s {
+	struct obj_pool_s	*next;		/**< registry linkage */
+	const char		*name;		/**< pool name for reporting */
+	uint8_t			*base;		/**< block storage, caller-provided */
+	uint16_t		block_size;	/**< size of one block in bytes */
+	uint16_t		nblocks;	/**< total number of blocks */
+	uint16_t		used;		/**< blocks currently allocated */
+	uint16_t		peak;		/**< most blocks ever allocated */
+	void			*free_list;	/**< head of the free block list */
+};
+
+/**
+ * Set up a pool over caller-provided storage.
+ *
+ * @param pool		The pool to initialize.
+ * @param name		Pool name, shown by 'heapinfo'; must persist.
+ * @param storage	Block storage, at least block_size * nblocks bytes,
+ *			aligned for the objects placed in it.
+ * @param block_size	Size of one block; must hold at least a pointer.
+ * @param nblocks	Number of blocks in the storage.
+ */
+__EXPORT void	obj_pool_init(struct obj_pool_s *pool, const char *name,
+			      void *storage, size_t block_size, unsigned nblocks);
+
+/**
+ * Take a block from the pool.
+ *
+ * @return		A block, or NULL if the pool is exhausted.
+ */
+__EXPORT void	*obj_pool_alloc(struct obj_pool_s *pool);
+
+/**
+ * Return a block to the pool. NULL is ignored.
+ */
+__EXPORT void	obj_pool_free(struct obj_pool_s *pool, void *ptr);
+
+/**
+ * Walk the pool registry.
+ *
+ * @param pool		NULL to return the first pool, or a previously
+ *			returned pool to get the next one.
+ * @return		The next pool, or NULL at the end of the list.
+ */
+__EXPORT struct obj_pool_s *obj_pool_next(struct obj_pool_s *pool);
+
+__END_DECLS
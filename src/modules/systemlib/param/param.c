@@ -42,8 +42,10 @@
  */
 
 #include <debug.h>
+#include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <systemlib/err.h>
@@ -51,6 +53,12 @@
 #include <semaphore.h>
 
 #include <sys/stat.h>
+#include <crc32.h>
+
+#ifndef _UNIT_TEST
+# include <nuttx/wqueue.h>
+# include "systemlib/lock_audit.h"
+#endif
 
 #include <drivers/drv_hrt.h>
 
@@ -89,11 +97,28 @@ struct param_wbuf_s {
 	param_t			param;
 	union param_value_u	val;
 	bool			unsaved;
+	unsigned		generation;	/**< param_generation value when last modified */
 };
 
+/** bumped on every modification; lets clients test for changes cheaply */
+static unsigned param_generation = 0;
+
+/** param_generation value at the most recent reset */
+static unsigned param_reset_generation = 0;
+
 // XXX this should be param_info_count, but need to work out linking
 uint8_t param_changed_storage[(600 / sizeof(uint8_t)) + 1] = {};
 
+/** number of bits set in param_changed_storage; kept in step by
+ * param_set_used_internal so callers need not rescan the bitmap */
+static unsigned param_used_count_cached = 0;
+
+/** per-parameter used-index ranks, rebuilt lazily after a parameter is
+ * marked used for the first time; NULL if allocation failed, in which
+ * case lookups fall back to scanning the bitmap */
+static uint16_t *param_used_ranks = NULL;
+static bool param_used_ranks_dirty = true;
+
 /** flexible array holding modified parameter values */
 UT_array	*param_values;
 
@@ -106,21 +131,56 @@ ORB_DEFINE(parameter_update, struct parameter_update_s);
 /** parameter update topic handle */
 static orb_advert_t param_topic = -1;
 
+/*
+ * Incremental saves append the dirty set as standalone BSON documents to a
+ * journal next to the parameter file; a full export compacts the journal
+ * away once it has accumulated enough records.
+ */
+#define PARAM_JOURNAL_SUFFIX		".jrnl"
+#define PARAM_JOURNAL_MAX_RECORDS	32
+
+/** journal records appended since the last full export */
+static unsigned param_journal_records = 0;
+
+/** set when the pending state cannot be expressed as journal appends
+ * (a reset or delete); the next save then compacts to a full export */
+static bool param_force_full_save = false;
+
 static void param_set_used_internal(param_t param);
 
 static param_t param_find_internal(const char *name, bool notification);
 
+static int param_import_internal(int fd, bool mark_saved);
+
+static int param_export_internal(bson_encoder_t encoder, bool only_unsaved);
+
+#ifndef _UNIT_TEST
+/** audit record for the parameter store lock; while the semaphore below
+ * stays disabled, a contended entry here means two tasks were inside
+ * the critical section at the same time */
+static struct lock_audit_s param_lock_audit = { .name = "param" };
+#endif
+
 /** lock the parameter store */
 static void
 param_lock(void)
 {
+#ifndef _UNIT_TEST
+	uint64_t t_start = lock_audit_prelock(&param_lock_audit);
+#endif
 	//do {} while (sem_wait(&param_sem) != 0);
+#ifndef _UNIT_TEST
+	lock_audit_locked(&param_lock_audit, t_start);
+#endif
 }
 
 /** unlock the parameter store */
 static void
 param_unlock(void)
 {
+#ifndef _UNIT_TEST
+	lock_audit_unlock(&param_lock_audit);
+#endif
 	//sem_post(&param_sem);
 }
 
@@ -211,11 +271,85 @@ param_notify_changes(void)
 	}
 }
 
+/** name-sorted index into the static parameter table, built on first lookup */
+static param_t *param_name_index = NULL;
+
+/**
+ * Compare two parameter table indices by parameter name.
+ *
+ * This function is suitable for passing to qsort.
+ */
+static int
+param_index_compare(const void *a, const void *b)
+{
+	return strcmp(param_info_base[*(const param_t *)a].name,
+		      param_info_base[*(const param_t *)b].name);
+}
+
+/**
+ * Build the name-sorted lookup index over the static parameter table.
+ *
+ * The table itself is assembled by the linker from the __param input
+ * sections and is ordered by link order, not by name, so the index is
+ * built once at runtime. On allocation failure lookups fall back to
+ * the linear scan.
+ */
+static void
+param_build_name_index(void)
+{
+	param_t *index = malloc(param_info_count * sizeof(param_t));
+
+	if (index == NULL) {
+		return;
+	}
+
+	for (param_t param = 0; handle_in_range(param); param++) {
+		index[param] = param;
+	}
+
+	qsort(index, param_info_count, sizeof(param_t), param_index_compare);
+	param_name_index = index;
+}
+
 param_t
 param_find_internal(const char *name, bool notification)
 {
 	param_t param;
 
+	if (param_name_index == NULL) {
+		param_build_name_index();
+	}
+
+	if (param_name_index != NULL) {
+		/* binary search over the name-sorted index */
+		unsigned low = 0;
+		unsigned high = param_info_count;
+
+		while (low < high) {
+			unsigned mid = low + (high - low) / 2;
+			int cmp = strcmp(param_info_base[param_name_index[mid]].name, name);
+
+			if (cmp == 0) {
+				param = param_name_index[mid];
+
+				if (notification) {
+					param_set_used_internal(param);
+				}
+
+				return param;
+			}
+
+			if (cmp < 0) {
+				low = mid + 1;
+
+			} else {
+				high = mid;
+			}
+		}
+
+		return PARAM_INVALID;
+	}
+
 	/* perform a linear search of the known parameters */
 	for (param = 0; handle_in_range(param); param++) {
 		if (!strcmp(param_info_base[param].name, name)) {
@@ -251,15 +385,7 @@ param_count(void)
 unsigned
 param_count_used(void)
 {
-	unsigned count = 0;
-	for (unsigned i = 0; i < sizeof(param_changed_storage) / sizeof(param_changed_storage[0]); i++) {
-		for (unsigned j = 0; j < 8; j++) {
-			if (param_changed_storage[i] & (1 << j)) {
-				count++;
-			}
-		}
-	}
-	return count;
+	return param_used_count_cached;
 }
 
 param_t
@@ -287,6 +413,33 @@ param_get_used_index(param_t param)
 		return -1;
 	}
 
+	if (param_used_ranks == NULL) {
+		param_used_ranks = malloc(param_info_count * sizeof(uint16_t));
+	}
+
+	if (param_used_ranks != NULL) {
+		/* rebuild the ranks in one pass if a parameter has been
+		 * marked used since the last query; a full parameter sync
+		 * then costs one scan instead of one per parameter */
+		if (param_used_ranks_dirty) {
+			unsigned count = 0;
+
+			for (unsigned i = 0; i < param_info_count; i++) {
+				for (unsigned j = 0; j < 8; j++) {
+					if (param_changed_storage[i] & (1 << j)) {
+						count++;
+					}
+				}
+
+				param_used_ranks[i] = count;
+			}
+
+			param_used_ranks_dirty = false;
+		}
+
+		return param_used_ranks[param];
+	}
+
 	/* walk all params and count */
 	int count = 0;
 
@@ -483,6 +636,7 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 		}
 
 		s->unsaved = !mark_saved;
+		s->generation = ++param_generation;
 		params_changed = true;
 		result = 0;
 	}
@@ -514,6 +668,39 @@ param_set_no_notification(param_t param, const void *val)
 	return param_set_internal(param, val, false, false);
 }
 
+unsigned
+param_change_generation(void)
+{
+	return param_generation;
+}
+
+bool
+param_changed_since(param_t param, unsigned generation)
+{
+	bool changed;
+
+	param_lock();
+
+	struct param_wbuf_s *s = param_find_changed(param);
+
+	/*
+	 * A parameter without a modified-value entry may have been returned
+	 * to its default by a reset since the caller last looked; resets do
+	 * not record which parameters they touched, so report all parameters
+	 * as changed in that case.
+	 */
+	if (s != NULL) {
+		changed = (s->generation > generation);
+
+	} else {
+		changed = (param_reset_generation > generation);
+	}
+
+	param_unlock();
+
+	return changed;
+}
+
 bool
 param_used(param_t param)
 {
@@ -534,7 +721,12 @@ void param_set_used_internal(param_t param)
 	}
 
 	unsigned bitindex = param_index - (param_index / sizeof(param_changed_storage[0]));
-	param_changed_storage[param_index / sizeof(param_changed_storage[0])] |= (1 << bitindex);
+
+	if (!(param_changed_storage[param_index / sizeof(param_changed_storage[0])] & (1 << bitindex))) {
+		param_changed_storage[param_index / sizeof(param_changed_storage[0])] |= (1 << bitindex);
+		param_used_count_cached++;
+		param_used_ranks_dirty = true;
+	}
 }
 
 int
@@ -554,6 +746,7 @@ param_reset(param_t param)
 		if (s != NULL) {
 			int pos = utarray_eltidx(param_values, s);
 			utarray_erase(param_values, pos, 1);
+			param_reset_generation = ++param_generation;
 		}
 
 		param_found = true;
@@ -561,8 +754,11 @@ param_reset(param_t param)
 
 	param_unlock();
 
-	if (s != NULL)
+	if (s != NULL) {
+		/* the journal cannot express a removal, force a compaction */
+		param_force_full_save = true;
 		param_notify_changes();
+	}
 
 	return (!param_found);
 }
@@ -579,6 +775,10 @@ param_reset_all(void)
 	/* mark as reset / deleted */
 	param_values = NULL;
 
+	param_force_full_save = true;
+
+	param_reset_generation = ++param_generation;
+
 	param_unlock();
 
 	param_notify_changes();
@@ -619,6 +819,37 @@ param_reset_excludes(const char* excludes[], int num_excludes)
 static const char *param_default_file = "/eeprom/parameters";
 static char *param_user_file = NULL;
 
+static void
+param_journal_filename(char *buf, size_t len)
+{
+	snprintf(buf, len, "%s%s", param_get_default_file(), PARAM_JOURNAL_SUFFIX);
+}
+
+/**
+ * Check whether any modified parameter has not yet been saved.
+ */
+static bool
+param_any_unsaved(void)
+{
+	struct param_wbuf_s *s = NULL;
+	bool unsaved = false;
+
+	param_lock();
+
+	if (param_values != NULL) {
+		while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != NULL) {
+			if (s->unsaved) {
+				unsaved = true;
+				break;
+			}
+		}
+	}
+
+	param_unlock();
+
+	return unsaved;
+}
+
 int
 param_set_default_file(const char* filename)
 {
@@ -637,15 +868,285 @@ param_get_default_file(void)
 	return (param_user_file != NULL) ? param_user_file : param_default_file;
 }
 
+/*
+ * Raw parameter bank: two alternating slots on an unformatted character
+ * device, typically the bch device covering a dedicated flash partition.
+ * Each slot carries a header identifying and checksumming its payload;
+ * saves always program the slot that does not hold the newest valid image,
+ * so a power cut mid-write leaves the previous image intact.
+ */
+#define PARAM_BANK_MAGIC	0x4b4e4250	/* 'PBNK' */
+#define PARAM_BANK_SLOTS	2
+
+struct param_bank_header_s {
+	uint32_t	magic;
+	uint32_t	seq;		/**< monotonic save counter; the highest valid slot wins */
+	uint32_t	length;		/**< payload length in bytes */
+	uint32_t	crc;		/**< CRC32 of the payload */
+};
+
+static char *param_bank_dev = NULL;
+static unsigned param_bank_slot_size = 0;
+
+static int
+param_bank_read_header(int fd, unsigned slot, struct param_bank_header_s *hdr)
+{
+	if (lseek(fd, slot * param_bank_slot_size, SEEK_SET) < 0)
+		return -1;
+
+	if (read(fd, hdr, sizeof(*hdr)) != sizeof(*hdr))
+		return -1;
+
+	return 0;
+}
+
+/**
+ * Check a slot header and the checksum of the payload it describes.
+ *
+ * @return		True if the slot holds a consistent image.
+ */
+static bool
+param_bank_slot_valid(int fd, unsigned slot, const struct param_bank_header_s *hdr)
+{
+	uint8_t buf[64];
+	uint32_t crc = 0;
+	unsigned remaining = hdr->length;
+
+	if (hdr->magic != PARAM_BANK_MAGIC)
+		return false;
+
+	if ((hdr->length == 0) || (hdr->length > (param_bank_slot_size - sizeof(*hdr))))
+		return false;
+
+	if (lseek(fd, slot * param_bank_slot_size + sizeof(*hdr), SEEK_SET) < 0)
+		return false;
+
+	while (remaining > 0) {
+		unsigned chunk = (remaining > sizeof(buf)) ? sizeof(buf) : remaining;
+
+		if (read(fd, buf, chunk) != (ssize_t)chunk)
+			return false;
+
+		crc = crc32part(buf, chunk, crc);
+		remaining -= chunk;
+	}
+
+	return crc == hdr->crc;
+}
+
+/**
+ * Find the slot holding the newest valid image.
+ *
+ * @param hdr_out	Set to the winning slot's header if non-NULL.
+ * @return		Slot index, or -1 if no slot is valid.
+ */
+static int
+param_bank_newest(int fd, struct param_bank_header_s *hdr_out)
+{
+	int newest = -1;
+	uint32_t newest_seq = 0;
+
+	for (unsigned slot = 0; slot < PARAM_BANK_SLOTS; slot++) {
+		struct param_bank_header_s hdr;
+
+		if (param_bank_read_header(fd, slot, &hdr) != 0)
+			continue;
+
+		if (!param_bank_slot_valid(fd, slot, &hdr))
+			continue;
+
+		if ((newest < 0) || (hdr.seq > newest_seq)) {
+			newest = slot;
+			newest_seq = hdr.seq;
+
+			if (hdr_out != NULL)
+				*hdr_out = hdr;
+		}
+	}
+
+	return newest;
+}
+
+int
+param_set_raw_bank(const char *devname)
+{
+	if (param_bank_dev != NULL) {
+		free(param_bank_dev);
+		param_bank_dev = NULL;
+		param_bank_slot_size = 0;
+	}
+
+	if (devname == NULL)
+		return 0;
+
+	int fd = open(devname, O_RDONLY);
+
+	if (fd < 0) {
+		warn("failed to open param bank device: %s", devname);
+		return ERROR;
+	}
+
+	off_t size = lseek(fd, 0, SEEK_END);
+	close(fd);
+
+	unsigned slot_size = (size / PARAM_BANK_SLOTS) & ~3u;
+
+	if (slot_size <= sizeof(struct param_bank_header_s)) {
+		warnx("param bank device too small: %s", devname);
+		return ERROR;
+	}
+
+	param_bank_dev = strdup(devname);
+
+	if (param_bank_dev == NULL)
+		return ERROR;
+
+	param_bank_slot_size = slot_size;
+
+	return 0;
+}
+
+static int
+param_save_bank(void)
+{
+	struct bson_encoder_s encoder;
+	struct param_bank_header_s hdr;
+	int result = ERROR;
+	int fd = -1;
+
+	/* export into memory; the device wants a single linear write */
+	unsigned maxsize = param_bank_slot_size - sizeof(hdr);
+	uint8_t *buf = malloc(maxsize);
+
+	if (buf == NULL)
+		return ERROR;
+
+	bson_encoder_init_buf(&encoder, buf, maxsize);
+
+	if (param_export_internal(&encoder, false) != 0) {
+		warnx("param bank export failed (image larger than a slot?)");
+		goto out;
+	}
+
+	fd = open(param_bank_dev, O_RDWR);
+
+	if (fd < 0) {
+		warn("failed to open param bank device: %s", param_bank_dev);
+		goto out;
+	}
+
+	/* program the slot that does not hold the newest valid image */
+	struct param_bank_header_s newest_hdr;
+	int newest = param_bank_newest(fd, &newest_hdr);
+	unsigned slot = (newest == 0) ? 1 : 0;
+
+	hdr.magic = PARAM_BANK_MAGIC;
+	hdr.seq = (newest < 0) ? 1 : newest_hdr.seq + 1;
+	hdr.length = bson_encoder_buf_size(&encoder);
+	hdr.crc = crc32(buf, hdr.length);
+
+	/* payload first, header last: an interrupted write leaves the slot
+	 * invalid rather than pointing at a torn image */
+	if (lseek(fd, slot * param_bank_slot_size + sizeof(hdr), SEEK_SET) < 0)
+		goto out;
+
+	if (write(fd, buf, hdr.length) != (ssize_t)hdr.length)
+		goto out;
+
+	if (lseek(fd, slot * param_bank_slot_size, SEEK_SET) < 0)
+		goto out;
+
+	if (write(fd, &hdr, sizeof(hdr)) != sizeof(hdr))
+		goto out;
+
+	fsync(fd);
+	result = OK;
+
+out:
+	if ((result != OK) && (fd >= 0))
+		warn("failed to write param bank: %s", param_bank_dev);
+
+	if (fd >= 0)
+		close(fd);
+
+	free(buf);
+
+	return result;
+}
+
+static int
+param_load_bank(void)
+{
+	int fd = open(param_bank_dev, O_RDONLY);
+
+	if (fd < 0) {
+		warn("failed to open param bank device: %s", param_bank_dev);
+		return -1;
+	}
+
+	struct param_bank_header_s hdr;
+	int slot = param_bank_newest(fd, &hdr);
+
+	if (slot < 0) {
+		/* an unprogrammed bank is OK, same as a missing file */
+		close(fd);
+		return 1;
+	}
+
+	lseek(fd, slot * param_bank_slot_size + sizeof(hdr), SEEK_SET);
+
+	int result = param_load(fd);
+	close(fd);
+
+	if (result != 0) {
+		warnx("error reading parameters from bank slot %d", slot);
+		return -2;
+	}
+
+	return 0;
+}
+
 int
 param_save_default(void)
 {
+	/* a raw bank bypasses the file and journal paths entirely */
+	if (param_bank_dev != NULL)
+		return param_save_bank();
+
 	int res;
 	int fd;
 
 	const char *filename = param_get_default_file();
+	char journal[64];
+	param_journal_filename(journal, sizeof(journal));
+
+	/* append only the dirty set while the journal is small enough */
+	if (!param_force_full_save && param_journal_records < PARAM_JOURNAL_MAX_RECORDS) {
+		struct stat st;
 
-	/* write parameters to temp file */
+		if (stat(filename, &st) == 0) {
+			if (!param_any_unsaved()) {
+				/* nothing changed since the last save */
+				return OK;
+			}
+
+			fd = open(journal, O_WRONLY | O_CREAT | O_APPEND);
+
+			if (fd >= 0) {
+				res = param_export(fd, true);
+				close(fd);
+
+				if (res == OK) {
+					param_journal_records++;
+					return OK;
+				}
+
+				/* journal trouble, fall through to a full save */
+			}
+		}
+	}
+
+	/* full export; afterwards the journal contents are redundant */
 	fd = open(filename, O_WRONLY | O_CREAT);
 
 	if (fd < 0) {
@@ -657,6 +1158,11 @@ param_save_default(void)
 
 	if (res != OK) {
 		warnx("failed to write parameters to file: %s", filename);
+
+	} else {
+		unlink(journal);
+		param_journal_records = 0;
+		param_force_full_save = false;
 	}
 
 	close(fd);
@@ -664,12 +1170,53 @@ param_save_default(void)
 	return res;
 }
 
+#ifndef _UNIT_TEST
+/* deferred autosave state: one low-priority work item, coalescing all
+ * requests that arrive while it is pending */
+static struct work_s param_autosave_work;
+static volatile bool param_autosave_scheduled = false;
+
+/** delay between the first request and the actual export, so a burst of
+ * parameter writes is captured by a single save */
+#define PARAM_AUTOSAVE_DELAY_US	2000000
+
+static void
+param_autosave_worker(void *arg)
+{
+	param_autosave_scheduled = false;
+
+	if (param_save_default() != OK) {
+		warnx("param autosave failed");
+	}
+}
+#endif
+
+void
+param_autosave(void)
+{
+#ifndef _UNIT_TEST
+	if (param_autosave_scheduled) {
+		/* the pending save will pick this change up as well */
+		return;
+	}
+
+	param_autosave_scheduled = true;
+	work_queue(LPWORK, &param_autosave_work, param_autosave_worker, NULL,
+		   USEC2TICK(PARAM_AUTOSAVE_DELAY_US));
+#else
+	param_save_default();
+#endif
+}
+
 /**
  * @return 0 on success, 1 if all params have not yet been stored, -1 if device open failed, -2 if writing parameters failed
  */
 int
 param_load_default(void)
 {
+	if (param_bank_dev != NULL)
+		return param_load_bank();
+
 	int fd_load = open(param_get_default_file(), O_RDONLY);
 
 	if (fd_load < 0) {
@@ -689,20 +1236,51 @@ param_load_default(void)
 		return -2;
 	}
 
+	/* replay incremental saves appended since the last full export */
+	char journal[64];
+	param_journal_filename(journal, sizeof(journal));
+
+	int fd_journal = open(journal, O_RDONLY);
+
+	if (fd_journal >= 0) {
+		char probe;
+
+		while (read(fd_journal, &probe, 1) == 1) {
+			lseek(fd_journal, -1, SEEK_CUR);
+
+			if (param_import_internal(fd_journal, true) != 0) {
+				warnx("error replaying param journal '%s'", journal);
+				break;
+			}
+		}
+
+		close(fd_journal);
+
+		/* compact at the next save so the journal does not grow unbounded */
+		param_force_full_save = true;
+	}
+
 	return 0;
 }
 
 int
 param_export(int fd, bool only_unsaved)
 {
-	struct param_wbuf_s *s = NULL;
 	struct bson_encoder_s encoder;
+
+	bson_encoder_init_file(&encoder, fd);
+
+	return param_export_internal(&encoder, only_unsaved);
+}
+
+static int
+param_export_internal(bson_encoder_t encoder, bool only_unsaved)
+{
+	struct param_wbuf_s *s = NULL;
 	int	result = -1;
 
 	param_lock();
 
-	bson_encoder_init_file(&encoder, fd);
-
 	/* no modified parameters -> we are done */
 	if (param_values == NULL) {
 		result = 0;
@@ -728,7 +1306,7 @@ param_export(int fd, bool only_unsaved)
 		case PARAM_TYPE_INT32:
 			param_get(s->param, &i);
 
-			if (bson_encoder_append_int(&encoder, param_name(s->param), i)) {
+			if (bson_encoder_append_int(encoder, param_name(s->param), i)) {
 				debug("BSON append failed for '%s'", param_name(s->param));
 				goto out;
 			}
@@ -738,7 +1316,7 @@ param_export(int fd, bool only_unsaved)
 		case PARAM_TYPE_FLOAT:
 			param_get(s->param, &f);
 
-			if (bson_encoder_append_double(&encoder, param_name(s->param), f)) {
+			if (bson_encoder_append_double(encoder, param_name(s->param), f)) {
 				debug("BSON append failed for '%s'", param_name(s->param));
 				goto out;
 			}
@@ -746,7 +1324,7 @@ param_export(int fd, bool only_unsaved)
 			break;
 
 		case PARAM_TYPE_STRUCT ... PARAM_TYPE_STRUCT_MAX:
-			if (bson_encoder_append_binary(&encoder,
+			if (bson_encoder_append_binary(encoder,
 						       param_name(s->param),
 						       BSON_BIN_BINARY,
 						       param_size(s->param),
@@ -769,13 +1347,14 @@ out:
 	param_unlock();
 
 	if (result == 0)
-		result = bson_encoder_fini(&encoder);
+		result = bson_encoder_fini(encoder);
 
 	return result;
 }
 
 struct param_import_state {
 	bool mark_saved;
+	bool changed;
 };
 
 static int
@@ -864,11 +1443,14 @@ param_import_callback(bson_decoder_t decoder, void *private, bson_node_t node)
 		goto out;
 	}
 
-	if (param_set_internal(param, v, state->mark_saved, true)) {
+	/* defer the update notification; one is sent when the import completes */
+	if (param_set_internal(param, v, state->mark_saved, false)) {
 		debug("error setting value for '%s'", node->name);
 		goto out;
 	}
 
+	state->changed = true;
+
 	if (tmp != NULL) {
 		free(tmp);
 		tmp = NULL;
@@ -898,12 +1480,17 @@ param_import_internal(int fd, bool mark_saved)
 	}
 
 	state.mark_saved = mark_saved;
+	state.changed = false;
 
 	do {
 		result = bson_decoder_next(&decoder);
 
 	} while (result > 0);
 
+	/* notify listeners once for the whole import rather than per parameter */
+	if ((result == 0) && state.changed)
+		param_notify_changes();
+
 out:
 
 	if (result < 0)
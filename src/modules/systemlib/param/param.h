@@ -213,6 +213,28 @@ __EXPORT int		param_set(param_t param, const void *val);
  */
 __EXPORT int		param_set_no_notification(param_t param, const void *val);
 
+/**
+ * Obtain the global parameter change generation.
+ *
+ * The generation is incremented on every parameter modification and can
+ * be compared against the value returned by an earlier call to detect
+ * whether anything changed in between.
+ *
+ * @return		The current change generation.
+ */
+__EXPORT unsigned	param_change_generation(void);
+
+/**
+ * Test whether a parameter has been modified since a given generation.
+ *
+ * @param param		A handle returned by param_find or passed by param_foreach.
+ * @param generation	A generation obtained from param_change_generation.
+ * @return		True if the parameter was modified after the generation
+ *			was obtained. After a reset all parameters report as
+ *			changed, since resets do not record what they touched.
+ */
+__EXPORT bool		param_changed_since(param_t param, unsigned generation);
+
 /**
  * Reset a parameter to its default value.
  *
@@ -309,6 +331,21 @@ __EXPORT int 		param_set_default_file(const char* filename);
  */
 __EXPORT const char*	param_get_default_file(void);
 
+/**
+ * Select a raw parameter bank device.
+ *
+ * While a bank is selected, parameter saves and loads bypass the filesystem
+ * and use two alternating, checksummed slots directly on the device
+ * (typically the character device covering a dedicated flash partition).
+ * Saves only ever program the slot not holding the newest valid image, so
+ * an interrupted write cannot corrupt the current parameters.
+ *
+ * @param devname	Device to store parameters on, or NULL to revert
+ *			to file storage.
+ * @return		Zero on success.
+ */
+__EXPORT int		param_set_raw_bank(const char *devname);
+
 /**
  * Save parameters to the default file.
  *
@@ -318,6 +355,15 @@ __EXPORT const char*	param_get_default_file(void);
  */
 __EXPORT int 		param_save_default(void);
 
+/**
+ * Schedule a deferred save of parameters to the default file.
+ *
+ * The export runs on the low-priority work queue; requests arriving
+ * while one is pending are coalesced into a single save, so burst
+ * parameter writes from a GCS cost one flash rewrite instead of many.
+ */
+__EXPORT void		param_autosave(void);
+
 /**
  * Load parameters from the default parameter file.
  *
@@ -367,6 +413,26 @@ __EXPORT int 		param_load_default(void);
 		.val.p = &_default			\
 	}
 
+/**
+ * Obtain the handle for a parameter, resolving the name at most once
+ * per call site.
+ *
+ * The parameter table is assembled by the linker from the __param
+ * input sections, so handles cannot be computed at compile time; this
+ * binds the result of the first lookup to a hidden static instead,
+ * which makes repeated resolution (module init after a restart,
+ * parameter_update handling) free. Not for use with names only known
+ * at runtime - use param_find() for those.
+ */
+#define PARAM_HANDLE(_name)						\
+	__extension__ ({						\
+		static param_t __param_handle = PARAM_INVALID;		\
+		if (__param_handle == PARAM_INVALID) {			\
+			__param_handle = param_find(#_name);		\
+		}							\
+		__param_handle;						\
+	})
+
 /**
  * Parameter value union.
  */
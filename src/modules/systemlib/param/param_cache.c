@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file param_cache.c
+ *
+ * Local parameter cache.
+ */
+
+#include <stdlib.h>
+
+#include "param_cache.h"
+
+int
+param_cache_init(struct param_cache_s *cache, unsigned size)
+{
+	cache->entries = malloc(size * sizeof(struct param_cache_entry_s));
+
+	if (cache->entries == NULL) {
+		return -1;
+	}
+
+	cache->size = size;
+	cache->count = 0;
+	cache->generation = 0;
+	cache->primed = false;
+
+	return 0;
+}
+
+int
+param_cache_map(struct param_cache_s *cache, const char *name, void *value)
+{
+	if (cache->count >= cache->size) {
+		return -1;
+	}
+
+	cache->entries[cache->count].param = param_find(name);
+	cache->entries[cache->count].value = value;
+	cache->count++;
+
+	return 0;
+}
+
+unsigned
+param_cache_update(struct param_cache_s *cache)
+{
+	unsigned updated = 0;
+
+	/*
+	 * Take the generation before fetching; a parameter changed while we
+	 * iterate carries a later generation and is picked up next time.
+	 */
+	unsigned generation = param_change_generation();
+
+	for (unsigned i = 0; i < cache->count; i++) {
+		struct param_cache_entry_s *entry = &cache->entries[i];
+
+		if (entry->param == PARAM_INVALID) {
+			continue;
+		}
+
+		if (cache->primed && !param_changed_since(entry->param, cache->generation)) {
+			continue;
+		}
+
+		if (param_get(entry->param, entry->value) == 0) {
+			updated++;
+		}
+	}
+
+	cache->generation = generation;
+	cache->primed = true;
+
+	return updated;
+}
+
+void
+param_cache_free(struct param_cache_s *cache)
+{
+	if (cache->entries != NULL) {
+		free(cache->entries);
+	}
+
+	cache->entries = NULL;
+	cache->size = 0;
+	cache->count = 0;
+}
@@ -0,0 +1,117 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file param_cache.h
+ *
+ * Local parameter cache.
+ *
+ * Modules map their local parameter variables once at startup and then
+ * refresh the cache when a parameter_update arrives.  Only parameters
+ * that actually changed since the last refresh are fetched again, so a
+ * single tweak during tuning no longer causes every module to re-fetch
+ * its entire parameter list.
+ */
+
+#ifndef _SYSTEMLIB_PARAM_PARAM_CACHE_H
+#define _SYSTEMLIB_PARAM_PARAM_CACHE_H
+
+#include "param.h"
+
+__BEGIN_DECLS
+
+/**
+ * One cached parameter; maps a handle to the local variable it fills.
+ */
+struct param_cache_entry_s {
+	param_t		param;
+	void		*value;
+};
+
+/**
+ * Cache state; initialise with param_cache_init.
+ */
+struct param_cache_s {
+	struct param_cache_entry_s	*entries;
+	unsigned	size;		/**< number of entries allocated */
+	unsigned	count;		/**< number of entries mapped */
+	unsigned	generation;	/**< change generation at the last update */
+	bool		primed;		/**< all values fetched at least once */
+};
+
+/**
+ * Initialise a parameter cache.
+ *
+ * @param cache		Cache state structure to be initialised.
+ * @param size		Maximum number of parameters that will be mapped.
+ * @return		Zero on success, nonzero on allocation failure.
+ */
+__EXPORT int		param_cache_init(struct param_cache_s *cache, unsigned size);
+
+/**
+ * Map a parameter to a local variable.
+ *
+ * Looks the parameter up by name and marks it as used, like param_find.
+ * Unknown parameters are recorded but never fetched, matching the
+ * behaviour of param_get on an invalid handle.
+ *
+ * @param cache		Cache the parameter is tracked in.
+ * @param name		The canonical name of the parameter.
+ * @param value		Variable to copy the parameter value to, assumed to
+ *			point to suitable storage for the parameter type.
+ * @return		Zero on success, nonzero if the cache is full.
+ */
+__EXPORT int		param_cache_map(struct param_cache_s *cache, const char *name, void *value);
+
+/**
+ * Refresh the mapped variables from the parameter store.
+ *
+ * The first call fetches every mapped parameter; subsequent calls fetch
+ * only those modified since the previous call.
+ *
+ * @param cache		Cache to refresh.
+ * @return		The number of values that were fetched; zero if
+ *			nothing changed.
+ */
+__EXPORT unsigned	param_cache_update(struct param_cache_s *cache);
+
+/**
+ * Release the storage held by a parameter cache.
+ *
+ * @param cache		Cache to release.
+ */
+__EXPORT void		param_cache_free(struct param_cache_s *cache);
+
+__END_DECLS
+
+#endif
@@ -37,14 +37,41 @@
  * @brief Performance measuring tools.
  */
 
+#include <nuttx/config.h>
+#include <nuttx/irq.h>
+
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdbool.h>
 #include <string.h>
 #include <sys/queue.h>
 #include <drivers/drv_hrt.h>
 #include <math.h>
 #include "perf_counter.h"
 
+#ifdef CONFIG_ARCH_CORTEXM4
+# include <arch/board/board.h>
+
+/*
+ * Cortex-M DWT cycle counter, optionally used as a cheap time source for
+ * short PC_ELAPSED sections (see perf_use_cycle_counter()).
+ */
+# define PERF_DEMCR		(*(volatile uint32_t *)0xe000edfc)
+# define PERF_DEMCR_TRCENA	(1 << 24)
+# define PERF_DWT_CTRL		(*(volatile uint32_t *)0xe0001000)
+# define PERF_DWT_CYCCNT_ENA	(1 << 0)
+# define PERF_DWT_CYCCNT	(*(volatile uint32_t *)0xe0001004)
+# define PERF_CYCLES_PER_USEC	(STM32_SYSCLK_FREQUENCY / 1000000)
+#endif
+
+/*
+ * Counter updates (perf_count/perf_begin/perf_end) take no locks: each
+ * counter has a single writer, so the update path stays cheap enough to
+ * leave enabled in interrupt context.  Readers (print/reset/event_count)
+ * briefly mask interrupts to snapshot the 64-bit fields, which a 32-bit
+ * core cannot load atomically.
+ */
+
 /**
  * Header common to all counters.
  */
@@ -70,6 +97,7 @@ struct perf_ctr_elapsed {
 	uint64_t		event_count;
 	uint64_t		event_overruns;
 	uint64_t		time_start;
+	bool			use_cycles;	/**< time with the CPU cycle counter instead of hrt */
 	uint64_t		time_total;
 	uint64_t		time_least;
 	uint64_t		time_most;
@@ -124,7 +152,10 @@ perf_alloc(enum perf_counter_type type, const char *name)
 	if (ctr != NULL) {
 		ctr->type = type;
 		ctr->name = name;
+
+		irqstate_t flags = irqsave();
 		sq_addfirst(&ctr->link, &perf_counters);
+		irqrestore(flags);
 	}
 
 	return ctr;
@@ -158,10 +189,28 @@ perf_free(perf_counter_t handle)
 	if (handle == NULL)
 		return;
 
+	irqstate_t flags = irqsave();
 	sq_rem(&handle->link, &perf_counters);
+	irqrestore(flags);
+
 	free(handle);
 }
 
+void
+perf_use_cycle_counter(perf_counter_t handle)
+{
+	if ((handle == NULL) || (handle->type != PC_ELAPSED))
+		return;
+
+#ifdef CONFIG_ARCH_CORTEXM4
+	/* make sure the cycle counter is running */
+	PERF_DEMCR |= PERF_DEMCR_TRCENA;
+	PERF_DWT_CTRL |= PERF_DWT_CYCCNT_ENA;
+
+	((struct perf_ctr_elapsed *)handle)->use_cycles = true;
+#endif
+}
+
 void
 perf_count(perf_counter_t handle)
 {
@@ -219,8 +268,20 @@ perf_begin(perf_counter_t handle)
 		return;
 
 	switch (handle->type) {
-	case PC_ELAPSED:
-		((struct perf_ctr_elapsed *)handle)->time_start = hrt_absolute_time();
+	case PC_ELAPSED: {
+			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
+
+#ifdef CONFIG_ARCH_CORTEXM4
+			if (pce->use_cycles) {
+				uint32_t cycles = PERF_DWT_CYCCNT;
+
+				/* zero means "not started", so nudge an exact wrap by one cycle */
+				pce->time_start = (cycles == 0) ? 1 : cycles;
+				break;
+			}
+#endif
+			pce->time_start = hrt_absolute_time();
+		}
 		break;
 
 	default:
@@ -239,7 +300,19 @@ perf_end(perf_counter_t handle)
 			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
 
 			if (pce->time_start != 0) {
-				int64_t elapsed = hrt_absolute_time() - pce->time_start;
+				int64_t elapsed;
+
+#ifdef CONFIG_ARCH_CORTEXM4
+				if (pce->use_cycles) {
+					/* modulo arithmetic covers a counter wrap for sections up to ~25s at 168MHz */
+					uint32_t cycles = PERF_DWT_CYCCNT - (uint32_t)pce->time_start;
+
+					elapsed = cycles / PERF_CYCLES_PER_USEC;
+				} else
+#endif
+				{
+					elapsed = hrt_absolute_time() - pce->time_start;
+				}
 
 				if (elapsed < 0) {
 					pce->event_overruns++;
@@ -342,6 +415,8 @@ perf_reset(perf_counter_t handle)
 	if (handle == NULL)
 		return;
 
+	irqstate_t flags = irqsave();
+
 	switch (handle->type) {
 	case PC_COUNT:
 		((struct perf_ctr_count *)handle)->event_count = 0;
@@ -368,6 +443,8 @@ perf_reset(perf_counter_t handle)
 		break;
 	}
 	}
+
+	irqrestore(flags);
 }
 
 void
@@ -383,38 +460,52 @@ perf_print_counter_fd(int fd, perf_counter_t handle)
 		return;
 
 	switch (handle->type) {
-	case PC_COUNT:
+	case PC_COUNT: {
+		irqstate_t flags = irqsave();
+		uint64_t event_count = ((struct perf_ctr_count *)handle)->event_count;
+		irqrestore(flags);
+
 		dprintf(fd, "%s: %llu events\n",
 		       handle->name,
-		       ((struct perf_ctr_count *)handle)->event_count);
+		       event_count);
 		break;
+	}
 
 	case PC_ELAPSED: {
-		struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
-		float rms = sqrtf(pce->M2 / (pce->event_count-1));
+		/* snapshot the counter so an interrupt-context update cannot tear the 64-bit fields */
+		struct perf_ctr_elapsed pce;
+		irqstate_t flags = irqsave();
+		memcpy(&pce, handle, sizeof(pce));
+		irqrestore(flags);
+
+		float rms = sqrtf(pce.M2 / (pce.event_count-1));
 
 		dprintf(fd, "%s: %llu events, %llu overruns, %lluus elapsed, %lluus avg, min %lluus max %lluus %5.3fus rms\n",
 			handle->name,
-			pce->event_count,
-			pce->event_overruns,
-			pce->time_total,
-			pce->time_total / pce->event_count,
-			pce->time_least,
-			pce->time_most,
+			pce.event_count,
+			pce.event_overruns,
+			pce.time_total,
+			pce.time_total / pce.event_count,
+			pce.time_least,
+			pce.time_most,
 			(double)(1e6f * rms));
 		break;
 	}
 
 	case PC_INTERVAL: {
-		struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
-		float rms = sqrtf(pci->M2 / (pci->event_count-1));
+		struct perf_ctr_interval pci;
+		irqstate_t flags = irqsave();
+		memcpy(&pci, handle, sizeof(pci));
+		irqrestore(flags);
+
+		float rms = sqrtf(pci.M2 / (pci.event_count-1));
 
 		dprintf(fd, "%s: %llu events, %lluus avg, min %lluus max %lluus %5.3fus rms\n",
 			handle->name,
-			pci->event_count,
-			(pci->time_last - pci->time_first) / pci->event_count,
-			pci->time_least,
-			pci->time_most,
+			pci.event_count,
+			(pci.time_last - pci.time_first) / pci.event_count,
+			pci.time_least,
+			pci.time_most,
 			(double)(1e6f * rms));
 		break;
 	}
@@ -430,24 +521,81 @@ perf_event_count(perf_counter_t handle)
 	if (handle == NULL)
 		return 0;
 
+	uint64_t event_count = 0;
+	irqstate_t flags = irqsave();
+
 	switch (handle->type) {
 	case PC_COUNT:
-		return ((struct perf_ctr_count *)handle)->event_count;
+		event_count = ((struct perf_ctr_count *)handle)->event_count;
+		break;
 
 	case PC_ELAPSED: {
 		struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
-		return pce->event_count;
+		event_count = pce->event_count;
+		break;
+	}
+
+	case PC_INTERVAL: {
+		struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
+		event_count = pci->event_count;
+		break;
+	}
+
+	default:
+		break;
+	}
+
+	irqrestore(flags);
+	return event_count;
+}
+
+perf_counter_t
+perf_next(perf_counter_t handle)
+{
+	if (handle == NULL) {
+		return (perf_counter_t)sq_peek(&perf_counters);
+	}
+
+	return (perf_counter_t)sq_next(&handle->link);
+}
+
+const char *
+perf_name(perf_counter_t handle)
+{
+	if (handle == NULL) {
+		return "";
+	}
+
+	return handle->name;
+}
+
+uint64_t
+perf_time_total(perf_counter_t handle)
+{
+	if (handle == NULL) {
+		return 0;
 	}
 
+	uint64_t time_total = 0;
+	irqstate_t flags = irqsave();
+
+	switch (handle->type) {
+	case PC_ELAPSED:
+		time_total = ((struct perf_ctr_elapsed *)handle)->time_total;
+		break;
+
 	case PC_INTERVAL: {
 		struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
-		return pci->event_count;
+		time_total = pci->time_last - pci->time_first;
+		break;
 	}
 
 	default:
 		break;
 	}
-	return 0;
+
+	irqrestore(flags);
+	return time_total;
 }
 
 void
@@ -83,6 +83,20 @@ __EXPORT extern perf_counter_t	perf_alloc_once(enum perf_counter_type type, cons
  */
 __EXPORT extern void		perf_free(perf_counter_t handle);
 
+/**
+ * Use the CPU cycle counter as the time source for an elapsed counter.
+ *
+ * Reading the DWT cycle counter is considerably cheaper than taking a full
+ * hrt timestamp, which makes it attractive for instrumentation that runs at
+ * high rates or in interrupt context.  The 32-bit counter limits a single
+ * measured section to roughly 25 seconds; longer sections wrap silently.
+ * On targets without a cycle counter this call has no effect and the
+ * counter keeps using hrt.
+ *
+ * @param handle		The handle returned from perf_alloc.
+ */
+__EXPORT extern void		perf_use_cycle_counter(perf_counter_t handle);
+
 /**
  * Count a performance event.
  *
@@ -185,6 +199,36 @@ __EXPORT extern void		perf_reset_all(void);
  */
 __EXPORT extern uint64_t	perf_event_count(perf_counter_t handle);
 
+/**
+ * Return the counter registered after the given one,
+ * or the first counter when NULL is passed.
+ *
+ * Intended for low-rate snapshotting (e.g. logging); counters freed
+ * while iterating invalidate the iteration.
+ *
+ * @param handle		A counter, or NULL to start iterating.
+ * @return			The next counter, NULL at the end of the list.
+ */
+__EXPORT extern perf_counter_t	perf_next(perf_counter_t handle);
+
+/**
+ * Return the name of the counter
+ *
+ * @param handle		The counter returned from perf_alloc.
+ * @return			The name the counter was registered with.
+ */
+__EXPORT extern const char	*perf_name(perf_counter_t handle);
+
+/**
+ * Return the accumulated time of a counter
+ *
+ * @param handle		The counter returned from perf_alloc.
+ * @return			Total elapsed time in microseconds for
+ *				PC_ELAPSED counters, first-to-last event
+ *				time for PC_INTERVAL, 0 for PC_COUNT.
+ */
+__EXPORT extern uint64_t	perf_time_total(perf_counter_t handle);
+
 __END_DECLS
 
 #endif
@@ -53,6 +53,18 @@
 
 #define SIGMA 0.000001f
 
+/**
+ * Bake the mode and derivative gain into the coefficients used by
+ * pid_calculate_fixed().
+ */
+static void pid_precompile(PID_t *pid)
+{
+	pid->d_sel_error = (pid->mode == PID_MODE_DERIVATIV_CALC) ? 1.0f : 0.0f;
+	pid->d_sel_val = (pid->mode == PID_MODE_DERIVATIV_CALC_NO_SP) ? 1.0f : 0.0f;
+	pid->kd_deriv = (pid->d_sel_error + pid->d_sel_val) * pid->kd;
+	pid->kd_dot = (pid->mode == PID_MODE_DERIVATIV_SET) ? pid->kd : 0.0f;
+}
+
 __EXPORT void pid_init(PID_t *pid, pid_mode_t mode, float dt_min)
 {
 	pid->mode = mode;
@@ -65,6 +77,7 @@ __EXPORT void pid_init(PID_t *pid, pid_mode_t mode, float dt_min)
 	pid->output_limit = 0.0f;
 	pid->error_previous = 0.0f;
 	pid->last_output = 0.0f;
+	pid_precompile(pid);
 }
 
 __EXPORT int pid_set_parameters(PID_t *pid, float kp, float ki, float kd, float integral_limit, float output_limit)
@@ -106,6 +119,8 @@ __EXPORT int pid_set_parameters(PID_t *pid, float kp, float ki, float kd, float
 		ret = 1;
 	}
 
+	pid_precompile(pid);
+
 	return ret;
 }
 
@@ -178,6 +193,50 @@ __EXPORT float pid_calculate(PID_t *pid, float sp, float val, float val_dot, flo
 }
 
 
+__EXPORT float pid_calculate_fixed(PID_t *pid, float sp, float val, float val_dot, float dt)
+{
+	/* batch validity check: a NaN or Inf in any input makes the sum
+	 * non-finite, so one test covers the whole input set */
+	if (!isfinite(sp + val + val_dot + dt)) {
+		return pid->last_output;
+	}
+
+	/* current error value */
+	float error = sp - val;
+
+	/* derivative input selected by the precompiled coefficients;
+	 * modes without an error history leave it pinned at zero */
+	float d_input = (pid->d_sel_error * error) - (pid->d_sel_val * val);
+	float d = (d_input - pid->error_previous) / fmaxf(dt, pid->dt_min);
+	pid->error_previous = d_input;
+
+	/* calculate PD output; terms inactive in this mode carry zero gains */
+	float output = (error * pid->kp) + (d * pid->kd_deriv) - (val_dot * pid->kd_dot);
+
+	if (pid->ki > SIGMA) {
+		/* calculate the error integral and check for saturation */
+		float i = pid->integral + (error * dt);
+
+		if ((pid->output_limit < SIGMA || (fabsf(output + (i * pid->ki)) <= pid->output_limit)) &&
+		    fabsf(i) <= pid->integral_limit) {
+			/* not saturated, use new integral value */
+			pid->integral = i;
+		}
+
+		/* add I component to output */
+		output += pid->integral * pid->ki;
+	}
+
+	/* limit output */
+	if (pid->output_limit > SIGMA) {
+		output = fminf(fmaxf(output, -pid->output_limit), pid->output_limit);
+	}
+
+	pid->last_output = output;
+
+	return output;
+}
+
 __EXPORT void pid_reset_integral(PID_t *pid)
 {
 	pid->integral = 0.0f;
@@ -79,11 +79,28 @@ typedef struct {
 	float output_limit;
 	float error_previous;
 	float last_output;
+	/* coefficients precompiled by pid_init()/pid_set_parameters() for
+	 * pid_calculate_fixed(); they select the derivative source and carry
+	 * the derivative gain, so the update needs no mode branches */
+	float d_sel_error;	/**< 1 if the derivative input is the error, else 0 */
+	float d_sel_val;	/**< 1 if the derivative input is the negated value, else 0 */
+	float kd_deriv;		/**< kd if the derivative is computed from history, else 0 */
+	float kd_dot;		/**< kd if the derivative is supplied by the caller, else 0 */
 } PID_t;
 
 __EXPORT void pid_init(PID_t *pid, pid_mode_t mode, float dt_min);
 __EXPORT int pid_set_parameters(PID_t *pid, float kp, float ki, float kd, float integral_limit, float output_limit);
 __EXPORT float pid_calculate(PID_t *pid, float sp, float val, float val_dot, float dt);
+
+/**
+ * Update the controller using the coefficients precompiled at
+ * pid_set_parameters() time.
+ *
+ * Equivalent to pid_calculate() for finite inputs, but the mode is baked
+ * into the coefficients instead of being branched on, and input validity
+ * is checked once for the whole input set instead of per term.
+ */
+__EXPORT float pid_calculate_fixed(PID_t *pid, float sp, float val, float val_dot, float dt);
 __EXPORT void pid_reset_integral(PID_t *pid);
 
 __END_DECLS
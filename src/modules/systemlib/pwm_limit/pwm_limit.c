@@ -46,8 +46,24 @@
 #include <drivers/drv_hrt.h>
 #include <stdio.h>
 
+/*
+ * precomputed ramp schedule, Q16 fraction of the ramp completed at each
+ * step; built once at init and shared by all instances, so the output
+ * path only indexes it
+ */
+static uint32_t ramp_schedule[PWM_LIMIT_RAMP_STEPS];
+static bool ramp_schedule_built = false;
+
 void pwm_limit_init(pwm_limit_t *limit)
 {
+	if (!ramp_schedule_built) {
+		for (unsigned s = 0; s < PWM_LIMIT_RAMP_STEPS; s++) {
+			ramp_schedule[s] = (((uint64_t)s * PWM_LIMIT_RAMP_STEP_US) << 16) / RAMP_TIME_US;
+		}
+
+		ramp_schedule_built = true;
+	}
+
 	limit->state = PWM_LIMIT_STATE_INIT;
 	limit->time_armed = 0;
 	return;
@@ -96,8 +112,6 @@ void pwm_limit_calc(const bool armed, const unsigned num_channels, const uint16_
 			break;
 	}
 
-	unsigned progress;
-
 	/* then set effective_pwm based on state */
 	switch (limit->state) {
 		case PWM_LIMIT_STATE_OFF:
@@ -108,14 +122,23 @@ void pwm_limit_calc(const bool armed, const unsigned num_channels, const uint16_
 			break;
 		case PWM_LIMIT_STATE_RAMP:
 			{
-				hrt_abstime diff = hrt_elapsed_time(&limit->time_armed);
+				/* the ramp lasts RAMP_TIME_US, so the elapsed time fits in 32 bits */
+				uint32_t diff = hrt_elapsed_time(&limit->time_armed);
 
-				progress = diff * 10000 / RAMP_TIME_US;
+				/* index the precomputed schedule; the step size is a
+				 * power of two, so this is a shift, not a division */
+				unsigned step = diff / PWM_LIMIT_RAMP_STEP_US;
+
+				if (step > PWM_LIMIT_RAMP_STEPS - 1) {
+					step = PWM_LIMIT_RAMP_STEPS - 1;
+				}
+
+				uint32_t progress = ramp_schedule[step];
 
 				for (unsigned i=0; i<num_channels; i++) {
-	                
+
 					uint16_t ramp_min_pwm;
-	                
+
 					/* if a disarmed pwm value was set, blend between disarmed and min */
 					if (disarmed_pwm[i] > 0) {
 
@@ -126,7 +149,7 @@ void pwm_limit_calc(const bool armed, const unsigned num_channels, const uint16_
 						}
 
 						unsigned disarmed_min_diff = min_pwm[i] - disarmed;
-						ramp_min_pwm = disarmed + (disarmed_min_diff * progress) / 10000;
+						ramp_min_pwm = disarmed + ((disarmed_min_diff * progress) >> 16);
 
 					} else {
 	                    
@@ -58,6 +58,14 @@ __BEGIN_DECLS
  */
 #define RAMP_TIME_US 2500000
 
+/*
+ * granularity of the precomputed ramp schedule; a power of two, so the
+ * output path turns the elapsed time into a table index with a shift
+ * instead of a division
+ */
+#define PWM_LIMIT_RAMP_STEP_US 16384
+#define PWM_LIMIT_RAMP_STEPS ((RAMP_TIME_US / PWM_LIMIT_RAMP_STEP_US) + 1)
+
 enum pwm_limit_state {
 	PWM_LIMIT_STATE_OFF = 0,
 	PWM_LIMIT_STATE_INIT,
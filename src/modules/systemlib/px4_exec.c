@@ -0,0 +1,181 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file px4_exec.c
+ *
+ * Cooperative executor for small periodic modules.
+ *
+ * Items run on the housekeeping queue of the PX4 work scheduler, so the
+ * executor adds no thread of its own. Between periodic runs of an item
+ * with a trigger subscription the executor re-queues at a short poll
+ * interval and only calls the cycle handler when the trigger updated -
+ * checking a subscription is a single flag read, far cheaper than
+ * running the module body or waking a dedicated task out of poll().
+ */
+
+#include <nuttx/config.h>
+#include <nuttx/clock.h>
+
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+#include <drivers/drv_hrt.h>
+#include <uORB/uORB.h>
+
+#include "perf_counter.h"
+#include "px4_work.h"
+#include "px4_exec.h"
+
+/** trigger poll interval for items whose periodic interval is longer */
+#define PX4_EXEC_TRIGGER_POLL	20000
+
+/**
+ * Delay until the next dispatch of an item, in microseconds.
+ */
+static uint32_t
+px4_exec_delay(const struct px4_exec_item_s *item)
+{
+	uint32_t delay = item->interval;
+
+	if ((item->trigger_sub >= 0) && (delay > PX4_EXEC_TRIGGER_POLL)) {
+		delay = PX4_EXEC_TRIGGER_POLL;
+	}
+
+	return delay;
+}
+
+/**
+ * Per-item dispatch; runs in the housekeeping dispatcher thread.
+ */
+static void
+px4_exec_cycle(void *arg)
+{
+	struct px4_exec_item_s *item = (struct px4_exec_item_s *)arg;
+
+	item->cycling = true;
+
+	if (!item->active) {
+		item->cycling = false;
+		return;
+	}
+
+	uint64_t now = hrt_absolute_time();
+	bool due = (now - item->last_run) >= item->interval;
+
+	if (!due && (item->trigger_sub >= 0)) {
+		bool updated = false;
+
+		if ((orb_check(item->trigger_sub, &updated) == OK) && updated) {
+			due = true;
+		}
+	}
+
+	if (due) {
+		item->last_run = now;
+		perf_begin(item->elapsed);
+		item->run(item->arg);
+		perf_end(item->elapsed);
+	}
+
+	item->cycling = false;
+
+	if (item->active) {
+		(void)px4_work_queue(PX4_WORK_HOUSEKEEPING, &item->work,
+				     px4_exec_cycle, item, USEC2TICK(px4_exec_delay(item)));
+	}
+}
+
+int
+px4_exec_register(struct px4_exec_item_s *item, const char *name,
+		  void (*run)(void *arg), void *arg, int trigger_sub, uint32_t interval)
+{
+	if ((item == NULL) || (run == NULL) || (interval == 0)) {
+		return -EINVAL;
+	}
+
+	if (item->active) {
+		return -EBUSY;
+	}
+
+	memset(item, 0, sizeof(*item));
+	item->name = name;
+	item->run = run;
+	item->arg = arg;
+	item->trigger_sub = trigger_sub;
+	item->interval = interval;
+	item->elapsed = perf_alloc(PC_ELAPSED, name);
+	item->last_run = hrt_absolute_time();
+	item->active = true;
+
+	int ret = px4_work_queue(PX4_WORK_HOUSEKEEPING, &item->work,
+				 px4_exec_cycle, item, USEC2TICK(px4_exec_delay(item)));
+
+	if (ret != OK) {
+		item->active = false;
+		perf_free(item->elapsed);
+		item->elapsed = NULL;
+	}
+
+	return ret;
+}
+
+void
+px4_exec_unregister(struct px4_exec_item_s *item)
+{
+	if ((item == NULL) || !item->active) {
+		return;
+	}
+
+	/* keep a pending entry from dispatching again */
+	item->active = false;
+	(void)px4_work_cancel(PX4_WORK_HOUSEKEEPING, &item->work);
+
+	/* a cycle already handed to the dispatcher runs to completion - wait it out
+	 * so the caller can safely tear down the item's state */
+	while (item->cycling) {
+		usleep(1000);
+	}
+
+	perf_free(item->elapsed);
+	item->elapsed = NULL;
+}
+
+void
+px4_exec_set_interval(struct px4_exec_item_s *item, uint32_t interval)
+{
+	if ((item != NULL) && (interval > 0)) {
+		item->interval = interval;
+	}
+}
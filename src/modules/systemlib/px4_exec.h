@@ -0,0 +1,121 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file px4_exec.h
+ *
+ * Cooperative executor for small periodic modules.
+ *
+ * Modules like the land detector own a full task just to run a short
+ * cycle a few dozen times a second; each one costs a 1-2 KB stack and a
+ * pair of context switches per cycle. The executor runs such modules as
+ * work items on the housekeeping queue of the PX4 work scheduler
+ * instead: an item is called at its requested interval, and optionally
+ * sooner whenever a uORB trigger subscription updates, so a low-rate
+ * item can still react promptly to rare events such as arming.
+ *
+ * The item cycle runs in the shared dispatcher thread and must not
+ * block. When a trigger subscription is set, the cycle handler is
+ * responsible for copying it - an un-copied update keeps forcing runs.
+ * Per-item run count and cycle time show up as a perf counter under the
+ * item name.
+ */
+
+#ifndef _SYSTEMLIB_PX4_EXEC_H
+#define _SYSTEMLIB_PX4_EXEC_H
+
+#include <nuttx/config.h>
+#include <nuttx/wqueue.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "perf_counter.h"
+
+/**
+ * Executor work item. Callers allocate this statically and treat it as
+ * opaque after px4_exec_register(); it must stay valid until
+ * px4_exec_unregister() has returned.
+ */
+struct px4_exec_item_s {
+	struct work_s	work;		/**< scheduler entry, owned by the executor */
+	const char	*name;		/**< item name, also the perf counter name */
+	void		(*run)(void *arg); /**< item cycle, dispatcher thread context */
+	void		*arg;		/**< argument passed to the cycle */
+	int		trigger_sub;	/**< uORB subscription forcing an early run, or -1 */
+	uint32_t	interval;	/**< periodic run interval in microseconds */
+	uint64_t	last_run;	/**< hrt time the cycle last ran */
+	perf_counter_t	elapsed;	/**< run count and time spent in the cycle */
+	volatile bool	active;		/**< item is registered and re-queues itself */
+	volatile bool	cycling;	/**< cycle handler is executing right now */
+};
+
+__BEGIN_DECLS
+
+/**
+ * Register a work item and schedule its first cycle.
+ *
+ * @param item		Caller-provided item storage.
+ * @param name		Item name, must outlive the item.
+ * @param run		Cycle handler, called in dispatcher thread context.
+ * @param arg		Argument passed to the handler.
+ * @param trigger_sub	uORB subscription whose updates force a run before
+ *			the interval elapses, or -1 for plain periodic
+ *			operation.
+ * @param interval	Interval between periodic runs, in microseconds.
+ * @return		OK on success, -errno otherwise.
+ */
+__EXPORT extern int	px4_exec_register(struct px4_exec_item_s *item, const char *name,
+					  void (*run)(void *arg), void *arg,
+					  int trigger_sub, uint32_t interval);
+
+/**
+ * Unregister a work item, waiting for a cycle in progress to finish.
+ * On return the handler is guaranteed not to run again.
+ *
+ * @param item		Item passed to px4_exec_register().
+ */
+__EXPORT extern void	px4_exec_unregister(struct px4_exec_item_s *item);
+
+/**
+ * Change the periodic interval of a registered item. Safe to call from
+ * the item's own cycle handler, letting an item adapt its rate.
+ *
+ * @param item		Item passed to px4_exec_register().
+ * @param interval	New interval in microseconds, ignored if zero.
+ */
+__EXPORT extern void	px4_exec_set_interval(struct px4_exec_item_s *item, uint32_t interval);
+
+__END_DECLS
+
+#endif
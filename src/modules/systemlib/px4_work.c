@@ -0,0 +1,273 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file px4_work.c
+ *
+ * PX4-level work scheduler with per-priority queues.
+ */
+
+#include <nuttx/config.h>
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+
+#include <sched.h>
+#include <semaphore.h>
+#include <queue.h>
+#include <errno.h>
+
+#include <drivers/drv_hrt.h>
+
+#include "systemlib.h"
+#include "perf_counter.h"
+#include "px4_work.h"
+
+struct px4_work_q {
+	const char	*name;		/**< dispatcher task name */
+	int		priority;	/**< dispatcher task priority */
+	dq_queue_t	pending;	/**< pending work, earliest deadline first */
+	sem_t		wakeup;		/**< posted when the dispatcher should run */
+	struct hrt_call	call;		/**< wakeup timer for the head deadline */
+	int		pid;		/**< dispatcher task, 0 while not started */
+	perf_counter_t	latency;	/**< dispatch lateness past the deadline */
+};
+
+/*
+ * Queue priorities bracket the NuttX work queues: sensor work dispatches
+ * above hpwork (192) so a slow conversion queued there cannot delay it,
+ * housekeeping runs at lpwork level (50).
+ */
+static struct px4_work_q px4_work_queues[PX4_WORK_QUEUE_COUNT] = {
+	{ .name = "wq:sensor", .priority = 245 },
+	{ .name = "wq:bg", .priority = 50 }
+};
+
+/*
+ * The NuttX work_s qtime/delay pair is reused to hold the 64-bit hrt
+ * deadline, so callers keep their existing work_s members.
+ */
+static inline hrt_abstime
+px4_work_deadline(const struct work_s *work)
+{
+	return ((hrt_abstime)work->delay << 32) | work->qtime;
+}
+
+static inline void
+px4_work_set_deadline(struct work_s *work, hrt_abstime deadline)
+{
+	work->qtime = (uint32_t)deadline;
+	work->delay = (uint32_t)(deadline >> 32);
+}
+
+/**
+ * Head-deadline timer callout; runs in the hrt timer interrupt.
+ */
+static void
+px4_work_wakeup(void *arg)
+{
+	struct px4_work_q *q = (struct px4_work_q *)arg;
+
+	sem_post(&q->wakeup);
+}
+
+/**
+ * Dispatcher loop shared by all queues.
+ */
+static int
+px4_work_dispatch(struct px4_work_q *q)
+{
+	for (;;) {
+		sem_wait(&q->wakeup);
+
+		for (;;) {
+			irqstate_t flags = irqsave();
+
+			struct work_s *work = (struct work_s *)dq_peek(&q->pending);
+
+			if (work == NULL) {
+				irqrestore(flags);
+				break;
+			}
+
+			hrt_abstime now = hrt_absolute_time();
+			hrt_abstime deadline = px4_work_deadline(work);
+
+			if (deadline > now) {
+				/* nothing due yet - wake again at the head deadline */
+				hrt_call_at(&q->call, deadline, px4_work_wakeup, q);
+				irqrestore(flags);
+				break;
+			}
+
+			dq_rem(&work->dq, &q->pending);
+
+			worker_t worker = work->worker;
+			void *arg = work->arg;
+
+			work->worker = NULL;
+
+			irqrestore(flags);
+
+			perf_set(q->latency, now - deadline);
+
+			if (worker != NULL) {
+				worker(arg);
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int
+px4_work_sensor_main(int argc, char *argv[])
+{
+	return px4_work_dispatch(&px4_work_queues[PX4_WORK_SENSOR]);
+}
+
+static int
+px4_work_housekeeping_main(int argc, char *argv[])
+{
+	return px4_work_dispatch(&px4_work_queues[PX4_WORK_HOUSEKEEPING]);
+}
+
+/**
+ * Start a dispatcher; must be called from task context.
+ */
+static int
+px4_work_start(unsigned qid)
+{
+	struct px4_work_q *q = &px4_work_queues[qid];
+
+	sem_init(&q->wakeup, 0, 0);
+
+	q->latency = perf_alloc(PC_ELAPSED,
+				(qid == PX4_WORK_SENSOR) ? "wq_sensor_latency" : "wq_bg_latency");
+
+	q->pid = task_spawn_cmd(q->name,
+				SCHED_DEFAULT,
+				q->priority,
+				2048,
+				(qid == PX4_WORK_SENSOR) ? px4_work_sensor_main : px4_work_housekeeping_main,
+				NULL);
+
+	return (q->pid > 0) ? OK : -ENOMEM;
+}
+
+int
+px4_work_queue(unsigned qid, struct work_s *work, worker_t worker, void *arg, uint32_t delay)
+{
+	if ((qid >= PX4_WORK_QUEUE_COUNT) || (work == NULL) || (worker == NULL)) {
+		return -EINVAL;
+	}
+
+	struct px4_work_q *q = &px4_work_queues[qid];
+
+	/* start the dispatcher on first use */
+	if (q->pid == 0) {
+		if (up_interrupt_context()) {
+			/* cannot spawn the dispatcher from here */
+			return -EAGAIN;
+		}
+
+		sched_lock();
+
+		int ret = (q->pid == 0) ? px4_work_start(qid) : OK;
+
+		sched_unlock();
+
+		if (ret != OK) {
+			return ret;
+		}
+	}
+
+	hrt_abstime deadline = hrt_absolute_time() + TICK2USEC((hrt_abstime)delay);
+
+	irqstate_t flags = irqsave();
+
+	/* re-queuing pending work just moves its due time */
+	if (work->worker != NULL) {
+		dq_rem(&work->dq, &q->pending);
+	}
+
+	work->worker = worker;
+	work->arg = arg;
+	px4_work_set_deadline(work, deadline);
+
+	/* sorted insert, earliest deadline first */
+	struct work_s *next = (struct work_s *)dq_peek(&q->pending);
+
+	while ((next != NULL) && (px4_work_deadline(next) <= deadline)) {
+		next = (struct work_s *)next->dq.flink;
+	}
+
+	if (next == NULL) {
+		dq_addlast(&work->dq, &q->pending);
+
+	} else {
+		dq_addbefore(&next->dq, &work->dq, &q->pending);
+	}
+
+	/* a new head deadline moves the wakeup timer */
+	if (dq_peek(&q->pending) == &work->dq) {
+		hrt_call_at(&q->call, deadline, px4_work_wakeup, q);
+	}
+
+	irqrestore(flags);
+
+	return OK;
+}
+
+int
+px4_work_cancel(unsigned qid, struct work_s *work)
+{
+	if ((qid >= PX4_WORK_QUEUE_COUNT) || (work == NULL)) {
+		return -EINVAL;
+	}
+
+	struct px4_work_q *q = &px4_work_queues[qid];
+	int ret = -ENOENT;
+
+	irqstate_t flags = irqsave();
+
+	if (work->worker != NULL) {
+		dq_rem(&work->dq, &q->pending);
+		work->worker = NULL;
+		ret = OK;
+	}
+
+	irqrestore(flags);
+
+	return ret;
+}
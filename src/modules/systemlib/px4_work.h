@@ -0,0 +1,96 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file px4_work.h
+ *
+ * PX4-level work scheduler with per-priority queues.
+ *
+ * The shared NuttX hpwork queue serializes every polled driver: one slow
+ * conversion cycle delays everything queued behind it. This scheduler
+ * runs one dispatcher thread per queue, keeps the pending work sorted by
+ * hrt deadline and wakes with hrt timer precision rather than on the
+ * system tick. The call signatures mirror work_queue()/work_cancel() so
+ * drivers opt in by swapping the queue identifier.
+ */
+
+#ifndef _SYSTEMLIB_PX4_WORK_H
+#define _SYSTEMLIB_PX4_WORK_H
+
+#include <nuttx/config.h>
+#include <nuttx/wqueue.h>
+
+#include <stdint.h>
+#include <platforms/px4_defines.h>
+
+/**
+ * Work queue identifiers, in descending dispatch priority.
+ */
+enum px4_work_queue_id {
+	PX4_WORK_SENSOR = 0,	/**< high-rate sensor conversion cycles */
+	PX4_WORK_HOUSEKEEPING,	/**< low-rate maintenance and UI work */
+	PX4_WORK_QUEUE_COUNT
+};
+
+__BEGIN_DECLS
+
+/**
+ * Queue work on one of the PX4 work queues.
+ *
+ * Semantics follow work_queue(): queuing an entry that is already
+ * pending moves its due time. The entry must stay valid until the
+ * worker has run or the entry is cancelled.
+ *
+ * @param qid		Queue to run the worker on.
+ * @param work		Caller-provided work entry.
+ * @param worker	Function to call, in dispatcher thread context.
+ * @param arg		Argument passed to the worker.
+ * @param delay		Delay before the call, in system ticks (as for
+ *			work_queue()).
+ * @return		OK if the work was queued, -errno otherwise.
+ */
+__EXPORT extern int	px4_work_queue(unsigned qid, struct work_s *work,
+				       worker_t worker, void *arg, uint32_t delay);
+
+/**
+ * Cancel previously queued work.
+ *
+ * @param qid		Queue the work was queued on.
+ * @param work		Work entry passed to px4_work_queue().
+ * @return		OK if the work was pending, -errno otherwise.
+ */
+__EXPORT extern int	px4_work_cancel(unsigned qid, struct work_s *work);
+
+__END_DECLS
+
+#endif
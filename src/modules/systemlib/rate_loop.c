@@ -0,0 +1,146 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file rate_loop.c
+ *
+ * Shared rate loop primitive for control tasks.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <drivers/drv_hrt.h>
+
+#include "rate_loop.h"
+
+void
+rate_loop_init(struct rate_loop_s *loop, const char *name,
+	       unsigned rate_hz, float dt_min, float dt_max)
+{
+	memset(loop, 0, sizeof(*loop));
+
+	if (rate_hz == 0) {
+		rate_hz = 1;
+	}
+
+	loop->interval = 1000000 / rate_hz;
+	loop->dt_min = dt_min;
+	loop->dt_max = dt_max;
+
+	/* perf_alloc keeps the name pointer, so the names must persist */
+	char *cycle_name = malloc(strlen(name) + 9);
+	char *overrun_name = malloc(strlen(name) + 9);
+
+	if (cycle_name != NULL) {
+		sprintf(cycle_name, "%s cycle", name);
+	}
+
+	if (overrun_name != NULL) {
+		sprintf(overrun_name, "%s overrun", name);
+	}
+
+	loop->cycle_perf = perf_alloc(PC_ELAPSED, (cycle_name != NULL) ? cycle_name : name);
+	loop->overrun_perf = perf_alloc(PC_COUNT, (overrun_name != NULL) ? overrun_name : name);
+}
+
+void
+rate_loop_free(struct rate_loop_s *loop)
+{
+	perf_free(loop->cycle_perf);
+	perf_free(loop->overrun_perf);
+}
+
+int
+rate_loop_poll(struct rate_loop_s *loop, struct pollfd *fds, unsigned nfds)
+{
+	uint64_t now = hrt_absolute_time();
+
+	/* anchor the phase on the first poll */
+	if (loop->deadline == 0) {
+		loop->deadline = now + loop->interval;
+	}
+
+	/* wake at the deadline even when no data arrives */
+	int timeout = 0;
+
+	if (loop->deadline > now) {
+		timeout = (int)((loop->deadline - now + 999) / 1000);
+	}
+
+	return poll(fds, nfds, timeout);
+}
+
+float
+rate_loop_begin(struct rate_loop_s *loop)
+{
+	uint64_t now = hrt_absolute_time();
+
+	perf_begin(loop->cycle_perf);
+
+	/* first cycle runs with the nominal dt */
+	float dt = loop->interval / 1000000.0f;
+
+	if (loop->last_run != 0) {
+		dt = (now - loop->last_run) / 1000000.0f;
+	}
+
+	loop->last_run = now;
+
+	if (dt < loop->dt_min) {
+		dt = loop->dt_min;
+
+	} else if (dt > loop->dt_max) {
+		dt = loop->dt_max;
+	}
+
+	/* deadline accounting: catch up in whole periods so the phase is
+	 * preserved, count cycles that missed a period entirely */
+	if (now >= loop->deadline) {
+		uint64_t late = now - loop->deadline;
+
+		if (late >= loop->interval) {
+			perf_count(loop->overrun_perf);
+		}
+
+		loop->deadline += loop->interval * (late / loop->interval + 1);
+	}
+
+	return dt;
+}
+
+void
+rate_loop_end(struct rate_loop_s *loop)
+{
+	perf_end(loop->cycle_perf);
+}
@@ -0,0 +1,116 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file rate_loop.h
+ *
+ * Shared rate loop primitive for control tasks.
+ *
+ * Wraps the poll() + dt computation every controller used to hand-roll:
+ * the poll timeout is derived from a fixed-phase deadline schedule on the
+ * hrt, the measured dt is clamped to sane bounds, and deadline overruns
+ * are counted in uniformly named perf counters, so loop jitter and
+ * overrun telemetry look the same across all control tasks.
+ *
+ * Usage:
+ *
+ *	rate_loop_init(&loop, "my_task", 250, 0.0002f, 0.02f);
+ *
+ *	while (...) {
+ *		int pret = rate_loop_poll(&loop, fds, 1);
+ *		...
+ *		float dt = rate_loop_begin(&loop);
+ *		<cycle body>
+ *		rate_loop_end(&loop);
+ *	}
+ */
+
+#pragma once
+
+#include <poll.h>
+#include <stdint.h>
+#include "perf_counter.h"
+
+__BEGIN_DECLS
+
+struct rate_loop_s {
+	uint64_t	interval;	/**< nominal period, us */
+	uint64_t	deadline;	/**< next fixed-phase deadline, 0 before the first poll */
+	uint64_t	last_run;	/**< start time of the previous cycle, 0 before the first */
+	float		dt_min;		/**< lower clamp for the measured dt, s */
+	float		dt_max;		/**< upper clamp for the measured dt, s */
+	perf_counter_t	cycle_perf;	/**< elapsed time of the cycle body */
+	perf_counter_t	overrun_perf;	/**< cycles that missed a whole period */
+};
+
+/**
+ * Initialize a rate loop.
+ *
+ * @param loop		The loop state to initialize.
+ * @param name		Task name, used to name the perf counters.
+ * @param rate_hz	Nominal loop rate.
+ * @param dt_min	Lower clamp for the measured dt, s.
+ * @param dt_max	Upper clamp for the measured dt, s.
+ */
+__EXPORT void	rate_loop_init(struct rate_loop_s *loop, const char *name,
+			       unsigned rate_hz, float dt_min, float dt_max);
+
+/**
+ * Free the perf counters of a rate loop.
+ */
+__EXPORT void	rate_loop_free(struct rate_loop_s *loop);
+
+/**
+ * Wait for data or the next fixed-phase deadline.
+ *
+ * Same semantics as poll(); a return of 0 is a deadline wakeup
+ * without new data.
+ */
+__EXPORT int	rate_loop_poll(struct rate_loop_s *loop,
+			       struct pollfd *fds, unsigned nfds);
+
+/**
+ * Start a cycle: measure the dt since the previous cycle, advance the
+ * deadline schedule in whole periods (keeping the phase) and count an
+ * overrun if at least one period was missed entirely.
+ *
+ * @return		Measured dt in seconds, clamped to [dt_min, dt_max].
+ */
+__EXPORT float	rate_loop_begin(struct rate_loop_s *loop);
+
+/**
+ * End the cycle started with rate_loop_begin().
+ */
+__EXPORT void	rate_loop_end(struct rate_loop_s *loop);
+
+__END_DECLS
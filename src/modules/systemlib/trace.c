@@ -0,0 +1,137 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file trace.c
+ *
+ * Lightweight system event tracing.
+ */
+
+#include <nuttx/config.h>
+#include <nuttx/irq.h>
+
+#include <string.h>
+#include <drivers/drv_hrt.h>
+
+#include "trace.h"
+
+/**
+ * Number of records in the trace ring; must be a power of two.
+ * 256 records cost 4KiB of static memory.
+ */
+#define TRACE_RING_SIZE		256
+
+static struct trace_record_s	trace_ring[TRACE_RING_SIZE];
+static volatile unsigned	trace_head;	/**< next record to write */
+static volatile unsigned	trace_tail;	/**< oldest unread record */
+static volatile bool		trace_running;
+static volatile uint32_t	trace_drops;	/**< records overwritten before being read */
+
+void
+trace_start(void)
+{
+	trace_running = true;
+}
+
+void
+trace_stop(void)
+{
+	trace_running = false;
+}
+
+bool
+trace_is_running(void)
+{
+	return trace_running;
+}
+
+void
+trace_clear(void)
+{
+	irqstate_t flags = irqsave();
+
+	trace_head = 0;
+	trace_tail = 0;
+	trace_drops = 0;
+
+	irqrestore(flags);
+}
+
+void
+trace_event(unsigned event, uint32_t arg)
+{
+	if (!trace_running)
+		return;
+
+	irqstate_t flags = irqsave();
+
+	struct trace_record_s *rec = &trace_ring[trace_head];
+
+	trace_head = (trace_head + 1) & (TRACE_RING_SIZE - 1);
+
+	if (trace_head == trace_tail) {
+		/* ring full - the oldest record is overwritten */
+		trace_tail = (trace_tail + 1) & (TRACE_RING_SIZE - 1);
+		trace_drops++;
+	}
+
+	rec->timestamp = hrt_absolute_time();
+	rec->event = event;
+	rec->arg = arg;
+
+	irqrestore(flags);
+}
+
+int
+trace_read(struct trace_record_s *rec)
+{
+	int ret = -1;
+
+	irqstate_t flags = irqsave();
+
+	if (trace_tail != trace_head) {
+		memcpy(rec, &trace_ring[trace_tail], sizeof(*rec));
+		trace_tail = (trace_tail + 1) & (TRACE_RING_SIZE - 1);
+		ret = 0;
+	}
+
+	irqrestore(flags);
+
+	return ret;
+}
+
+uint32_t
+trace_dropped(void)
+{
+	return trace_drops;
+}
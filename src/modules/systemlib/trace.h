@@ -0,0 +1,130 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file trace.h
+ *
+ * Lightweight system event tracing.
+ *
+ * Complements the perf counters with event ordering: trace points record
+ * an hrt timestamp, an event id and one argument into a fixed-size ring
+ * that can be dumped from the shell (see the `trace` command) or drained
+ * into the flight log by sdlog2 for offline timeline reconstruction.
+ *
+ * Recording is cheap enough to leave the trace points compiled in; the
+ * ring only fills while tracing has been started.
+ */
+
+#ifndef _SYSTEMLIB_TRACE_H
+#define _SYSTEMLIB_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <platforms/px4_defines.h>
+
+/**
+ * Well-known trace event ids.
+ */
+enum trace_event_id {
+	TRACE_EV_NONE = 0,
+	TRACE_EV_ORB_PUBLISH,	/**< uORB publication, arg is the topic metadata address (resolve via the ELF symbol table) */
+	TRACE_EV_MIXER_OUT,	/**< mixer outputs latched to the servos, arg is the first output channel in microseconds */
+	TRACE_EV_EST_CYCLE,	/**< estimator filter cycle completed */
+	TRACE_EV_LOCK_INVERSION,	/**< priority inversion on an audited lock, arg is (waiter_prio << 24) | (holder_prio << 16) | holder_pid */
+	TRACE_EV_LOCK_HOLD,	/**< audited lock held longer than LOCK_AUDIT_HOLD_TRACE_US, arg is the hold time in microseconds */
+	TRACE_EV_USER		/**< first id available for ad-hoc instrumentation */
+};
+
+/**
+ * One trace ring record.
+ */
+struct trace_record_s {
+	uint64_t	timestamp;	/**< hrt timestamp of the event */
+	uint32_t	event;		/**< trace_event_id */
+	uint32_t	arg;		/**< event-specific argument */
+};
+
+/**
+ * Record a trace event.
+ *
+ * Safe from interrupt context; expands to a function call that returns
+ * immediately while tracing is stopped.
+ */
+#define TRACE(_event, _arg)	trace_event((_event), (_arg))
+
+__BEGIN_DECLS
+
+/**
+ * Start filling the trace ring.
+ */
+__EXPORT extern void		trace_start(void);
+
+/**
+ * Stop filling the trace ring; recorded events are retained.
+ */
+__EXPORT extern void		trace_stop(void);
+
+/**
+ * @return			true while tracing has been started.
+ */
+__EXPORT extern bool		trace_is_running(void);
+
+/**
+ * Discard all recorded events and reset the drop counter.
+ */
+__EXPORT extern void		trace_clear(void);
+
+/**
+ * Record a trace event; prefer the TRACE() macro at trace points.
+ *
+ * @param event			Event id, one of trace_event_id or a user id.
+ * @param arg			Event-specific argument.
+ */
+__EXPORT extern void		trace_event(unsigned event, uint32_t arg);
+
+/**
+ * Remove the oldest record from the ring.
+ *
+ * @param rec			Receives the record on success.
+ * @return			0 on success, -1 if the ring is empty.
+ */
+__EXPORT extern int		trace_read(struct trace_record_s *rec);
+
+/**
+ * @return			Number of records overwritten before being read.
+ */
+__EXPORT extern uint32_t	trace_dropped(void);
+
+__END_DECLS
+
+#endif
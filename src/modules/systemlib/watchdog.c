@@ -0,0 +1,239 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file watchdog.c
+ *
+ * Hardware watchdog service; see watchdog.h for the model.
+ */
+
+#include <nuttx/config.h>
+#include <nuttx/irq.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/clock.h>
+
+#include <stdio.h>
+#include <errno.h>
+
+#include <drivers/drv_hrt.h>
+
+#include "watchdog.h"
+#include "trace.h"
+#include "err.h"
+
+/**
+ * Kicker period; also the granularity of deadline supervision.
+ */
+#define WATCHDOG_KICK_INTERVAL	100000
+
+/*
+ * Independent watchdog (IWDG) registers. The IWDG runs from the ~32kHz
+ * LSI oscillator and keeps counting through sleep modes and while the
+ * core is halted by a fault.
+ */
+#define IWDG_BASE		0x40003000
+#define REG(_r)			(*(volatile uint32_t *)(IWDG_BASE + (_r)))
+
+#define IWDG_KR			REG(0x00)
+#define IWDG_PR			REG(0x04)
+#define IWDG_RLR		REG(0x08)
+#define IWDG_SR			REG(0x0c)
+
+#define IWDG_KR_REFRESH		0xaaaa	/**< reload the counter from RLR */
+#define IWDG_KR_UNLOCK		0x5555	/**< enable PR/RLR write access */
+#define IWDG_KR_START		0xcccc	/**< start the watchdog */
+
+#define IWDG_PR_DIV32		3	/**< LSI/32: one count per millisecond */
+#define IWDG_RLR_MAX		0xfff
+
+static struct watchdog_client_s	*client_registry;
+static struct work_s		watchdog_work;
+static bool			watchdog_running;
+static bool			watchdog_tripped;
+
+static void	watchdog_kick(void *arg);
+
+void
+watchdog_register(struct watchdog_client_s *client, const char *name, uint32_t deadline_ms)
+{
+	client->name = name;
+	client->deadline_ms = deadline_ms;
+	client->cycles = 0;
+	client->cycles_seen = 0;
+	client->last_progress = hrt_absolute_time();
+
+	/* registrations happen at task start but the kicker may already run */
+	irqstate_t flags = irqsave();
+	client->next = client_registry;
+	client_registry = client;
+	irqrestore(flags);
+}
+
+void
+watchdog_unregister(struct watchdog_client_s *client)
+{
+	irqstate_t flags = irqsave();
+	struct watchdog_client_s **cpp = &client_registry;
+
+	while (*cpp != NULL) {
+		if (*cpp == client) {
+			*cpp = client->next;
+			break;
+		}
+
+		cpp = &(*cpp)->next;
+	}
+
+	irqrestore(flags);
+}
+
+int
+watchdog_start(unsigned timeout_ms)
+{
+#ifdef CONFIG_ARCH_CHIP_STM32
+	if (watchdog_running) {
+		return -EBUSY;
+	}
+
+	if (timeout_ms > IWDG_RLR_MAX) {
+		timeout_ms = IWDG_RLR_MAX;
+	}
+
+	/* the kicker must fit several times into the hardware timeout */
+	if (timeout_ms < 3 * (WATCHDOG_KICK_INTERVAL / 1000)) {
+		return -EINVAL;
+	}
+
+	watchdog_running = true;
+
+	/* at LSI/32 the reload value counts milliseconds */
+	IWDG_KR = IWDG_KR_UNLOCK;
+	IWDG_PR = IWDG_PR_DIV32;
+	IWDG_RLR = timeout_ms;
+	IWDG_KR = IWDG_KR_START;
+	IWDG_KR = IWDG_KR_REFRESH;
+
+	return work_queue(HPWORK, &watchdog_work, watchdog_kick, NULL,
+			  USEC2TICK(WATCHDOG_KICK_INTERVAL));
+#else
+	return -ENOSYS;
+#endif
+}
+
+bool
+watchdog_is_running(void)
+{
+	return watchdog_running;
+}
+
+struct watchdog_client_s *
+watchdog_next(struct watchdog_client_s *client)
+{
+	if (client == NULL) {
+		return client_registry;
+	}
+
+	return client->next;
+}
+
+void
+watchdog_print_status(void)
+{
+	printf("watchdog: %s%s\n",
+	       watchdog_running ? "armed" : "not armed",
+	       watchdog_tripped ? ", TRIPPED" : "");
+
+	uint64_t now = hrt_absolute_time();
+
+	for (struct watchdog_client_s *client = watchdog_next(NULL);
+	     client != NULL;
+	     client = watchdog_next(client)) {
+		printf("  %-16s deadline %4lu ms, %lu cycles, last progress %llu us ago\n",
+		       client->name,
+		       (unsigned long)client->deadline_ms,
+		       (unsigned long)client->cycles,
+		       now - client->last_progress);
+	}
+}
+
+/**
+ * Check all clients for progress and refresh the hardware watchdog.
+ *
+ * Not rescheduling after a missed deadline (or a stalled work queue)
+ * lets the IWDG time out and reset the system.
+ */
+static void
+watchdog_kick(void *arg)
+{
+	uint64_t now = hrt_absolute_time();
+
+	for (struct watchdog_client_s *client = watchdog_next(NULL);
+	     client != NULL;
+	     client = watchdog_next(client)) {
+
+		uint32_t cycles = client->cycles;
+
+		if (cycles != client->cycles_seen) {
+			client->cycles_seen = cycles;
+			client->last_progress = now;
+			continue;
+		}
+
+		if (now - client->last_progress > (uint64_t)client->deadline_ms * 1000) {
+			/* freeze the trace ring and dump it for the post-mortem */
+			watchdog_tripped = true;
+			trace_stop();
+
+			warnx("WATCHDOG: %s wedged for %lu ms, system will reset",
+			      client->name,
+			      (unsigned long)((now - client->last_progress) / 1000));
+
+			struct trace_record_s rec;
+
+			while (trace_read(&rec) == 0) {
+				printf("%llu\t%lu\t0x%08lx\n",
+				       rec.timestamp,
+				       (unsigned long)rec.event,
+				       (unsigned long)rec.arg);
+			}
+
+			fflush(stdout);
+			return;
+		}
+	}
+
+	IWDG_KR = IWDG_KR_REFRESH;
+
+	(void)work_queue(HPWORK, &watchdog_work, watchdog_kick, NULL,
+			 USEC2TICK(WATCHDOG_KICK_INTERVAL));
+}
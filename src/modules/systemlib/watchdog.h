@@ -0,0 +1,129 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file watchdog.h
+ *
+ * Hardware watchdog service with per-loop deadline supervision.
+ *
+ * Control loops register a client with a deadline and check in once per
+ * cycle; the check-in is a single volatile increment and safe from any
+ * context. A periodic kicker on the high-priority work queue refreshes
+ * the independent watchdog (IWDG) only while every registered client has
+ * made progress within its deadline. When a loop wedges, the kicker
+ * freezes and dumps the trace ring for the post-mortem and then stops
+ * refreshing, so the IWDG resets the system. A stalled work queue stops
+ * the kicker itself, which trips the watchdog the same way.
+ *
+ * Once armed via watchdog_start() the IWDG cannot be stopped again, so
+ * arming is left to the startup script or the operator (see the `wdog`
+ * command).
+ */
+
+#ifndef _SYSTEMLIB_WATCHDOG_H
+#define _SYSTEMLIB_WATCHDOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <platforms/px4_defines.h>
+
+__BEGIN_DECLS
+
+/**
+ * Per-client supervision state; allocate in the supervised task and
+ * treat as opaque outside of watchdog_checkin().
+ */
+struct watchdog_client_s {
+	struct watchdog_client_s *next;	/**< registry linkage (internal) */
+	const char	*name;		/**< client name for diagnostics */
+	uint32_t	deadline_ms;	/**< maximum time between check-ins */
+	volatile uint32_t cycles;	/**< incremented by watchdog_checkin() */
+	uint32_t	cycles_seen;	/**< cycle count at the last kicker pass (internal) */
+	uint64_t	last_progress;	/**< time progress was last observed (internal) */
+};
+
+/**
+ * Register a control loop with the watchdog service.
+ *
+ * Registration is independent of arming; clients may register before
+ * watchdog_start() has been called.
+ *
+ * @param client	Client state owned by the caller; must remain
+ *			valid until watchdog_unregister().
+ * @param name		Client name for diagnostics, not copied.
+ * @param deadline_ms	Maximum time between check-ins before the system
+ *			is considered wedged.
+ */
+__EXPORT void	watchdog_register(struct watchdog_client_s *client,
+				  const char *name, uint32_t deadline_ms);
+
+/**
+ * Remove a client from the registry, e.g. on orderly task shutdown.
+ */
+__EXPORT void	watchdog_unregister(struct watchdog_client_s *client);
+
+/**
+ * Record one cycle of progress; call once per loop iteration.
+ */
+static inline void watchdog_checkin(struct watchdog_client_s *client)
+{
+	client->cycles++;
+}
+
+/**
+ * Arm the hardware watchdog and start the periodic kicker.
+ *
+ * @param timeout_ms	Hardware reset timeout; clamped to the IWDG range.
+ * @return		OK on success, -errno otherwise. -ENOSYS if the
+ *			hardware watchdog is not supported on this board.
+ */
+__EXPORT int	watchdog_start(unsigned timeout_ms);
+
+/**
+ * @return		true once the watchdog has been armed.
+ */
+__EXPORT bool	watchdog_is_running(void);
+
+/**
+ * Print the client registry and arming state to stdout.
+ */
+__EXPORT void	watchdog_print_status(void);
+
+/**
+ * Walk the client registry; pass NULL to get the first client.
+ */
+__EXPORT struct watchdog_client_s *watchdog_next(struct watchdog_client_s *client);
+
+__END_DECLS
+
+#endif
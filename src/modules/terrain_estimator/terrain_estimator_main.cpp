@@ -0,0 +1,299 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file terrain_estimator_main.cpp
+ *
+ * Shared terrain estimation provider.
+ *
+ * Fuses the rangefinder with baro and GPS altitude once and publishes the
+ * result on the terrain_estimate topic, so the position controllers and
+ * the land detector all work from the same ground distance instead of
+ * each filtering the raw sensor on their own.
+ *
+ * The rangefinder return is tilt-compensated with the attitude rotation
+ * matrix and referenced to the GPS altitude; between GPS updates the
+ * reference is propagated with the baro. Measurement spikes are rejected
+ * against a low-passed innovation, a sustained offset is accepted as a
+ * new surface (same scheme position_estimator_inav uses for the sonar).
+ */
+
+#include <nuttx/config.h>
+
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <poll.h>
+#include <math.h>
+#include <float.h>
+
+#include <drivers/drv_hrt.h>
+#include <drivers/drv_range_finder.h>
+#include <systemlib/systemlib.h>
+#include <systemlib/param/param.h>
+#include <systemlib/err.h>
+
+#include <uORB/uORB.h>
+#include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/vehicle_global_position.h>
+#include <uORB/topics/sensor_combined.h>
+#include <uORB/topics/parameter_update.h>
+#include <uORB/topics/terrain_estimate.h>
+
+/* estimate stays valid this long after the last accepted return */
+static const hrt_abstime TERRAIN_VALID_TIMEOUT = 1000000;
+/* GPS altitude is used as reference when younger than this, baro-propagated otherwise */
+static const hrt_abstime TERRAIN_GPS_FRESH = 500000;
+/* reject returns at more than ~45 degrees of tilt */
+static const float TERRAIN_COS_TILT_MIN = 0.7f;
+
+static bool thread_should_exit = false;		/**< daemon exit flag */
+static bool thread_running = false;		/**< daemon status flag */
+static int daemon_task;				/**< handle of daemon task / thread */
+
+extern "C" __EXPORT int terrain_estimator_main(int argc, char *argv[]);
+
+static int terrain_estimator_thread_main(int argc, char *argv[]);
+
+static void usage(const char *reason);
+
+static void
+usage(const char *reason)
+{
+	if (reason) {
+		fprintf(stderr, "%s\n", reason);
+	}
+
+	fprintf(stderr, "usage: terrain_estimator {start|stop|status}\n");
+	exit(1);
+}
+
+int
+terrain_estimator_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		usage("missing command");
+	}
+
+	if (!strcmp(argv[1], "start")) {
+		if (thread_running) {
+			warnx("already running");
+			exit(0);
+		}
+
+		thread_should_exit = false;
+		daemon_task = task_spawn_cmd("terrain_estimator",
+					     SCHED_DEFAULT,
+					     SCHED_PRIORITY_DEFAULT,
+					     1200,
+					     terrain_estimator_thread_main,
+					     nullptr);
+		exit(0);
+	}
+
+	if (!strcmp(argv[1], "stop")) {
+		thread_should_exit = true;
+		exit(0);
+	}
+
+	if (!strcmp(argv[1], "status")) {
+		if (thread_running) {
+			warnx("running");
+
+		} else {
+			warnx("not started");
+		}
+
+		exit(0);
+	}
+
+	usage("unrecognized command");
+	exit(1);
+}
+
+static int
+terrain_estimator_thread_main(int argc, char *argv[])
+{
+	thread_running = true;
+
+	/* subscriptions */
+	int range_sub = orb_subscribe(ORB_ID(sensor_range_finder));
+	int att_sub = orb_subscribe(ORB_ID(vehicle_attitude));
+	int global_pos_sub = orb_subscribe(ORB_ID(vehicle_global_position));
+	int sensor_sub = orb_subscribe(ORB_ID(sensor_combined));
+	int param_sub = orb_subscribe(ORB_ID(parameter_update));
+
+	struct range_finder_report range;
+	struct vehicle_attitude_s att;
+	struct vehicle_global_position_s global_pos;
+	struct sensor_combined_s sensors;
+
+	memset(&range, 0, sizeof(range));
+	memset(&att, 0, sizeof(att));
+	memset(&global_pos, 0, sizeof(global_pos));
+	memset(&sensors, 0, sizeof(sensors));
+
+	/* parameters */
+	param_t param_filt = param_find("TE_FILT");
+	param_t param_err = param_find("TE_ERR");
+
+	float terr_filt = 0.05f;
+	float terr_err = 0.5f;
+
+	param_get(param_filt, &terr_filt);
+	param_get(param_err, &terr_err);
+
+	/* estimator state */
+	float terrain_alt = 0.0f;		/* terrain altitude AMSL */
+	float innov_filtered = 0.0f;		/* low-passed innovation for spike rejection */
+	bool have_estimate = false;
+	hrt_abstime last_accepted_time = 0;
+
+	/* altitude reference */
+	float ref_gps_alt = 0.0f;		/* last fresh GPS altitude */
+	float ref_baro_alt = 0.0f;		/* baro altitude at that moment */
+	hrt_abstime ref_time = 0;
+
+	struct terrain_estimate_s estimate;
+	memset(&estimate, 0, sizeof(estimate));
+
+	orb_advert_t estimate_pub = orb_advertise(ORB_ID(terrain_estimate), &estimate);
+
+	struct pollfd fds[1];
+	fds[0].fd = range_sub;
+	fds[0].events = POLLIN;
+
+	while (!thread_should_exit) {
+		/* wait for rangefinder data, keep publishing validity at 10 Hz without it */
+		int pret = poll(fds, 1, 100);
+
+		hrt_abstime now = hrt_absolute_time();
+
+		bool updated;
+
+		orb_check(param_sub, &updated);
+
+		if (updated) {
+			struct parameter_update_s update;
+			orb_copy(ORB_ID(parameter_update), param_sub, &update);
+			param_get(param_filt, &terr_filt);
+			param_get(param_err, &terr_err);
+		}
+
+		orb_check(att_sub, &updated);
+
+		if (updated) {
+			orb_copy(ORB_ID(vehicle_attitude), att_sub, &att);
+		}
+
+		orb_check(sensor_sub, &updated);
+
+		if (updated) {
+			orb_copy(ORB_ID(sensor_combined), sensor_sub, &sensors);
+		}
+
+		orb_check(global_pos_sub, &updated);
+
+		if (updated) {
+			orb_copy(ORB_ID(vehicle_global_position), global_pos_sub, &global_pos);
+
+			/* re-reference to GPS altitude and remember the baro offset */
+			ref_gps_alt = global_pos.alt;
+			ref_baro_alt = sensors.baro_alt_meter;
+			ref_time = now;
+		}
+
+		/* current vehicle altitude: GPS when fresh, baro-propagated otherwise */
+		float alt_ref = ref_gps_alt;
+
+		if (ref_time != 0 && now - ref_time > TERRAIN_GPS_FRESH) {
+			alt_ref = ref_gps_alt + (sensors.baro_alt_meter - ref_baro_alt);
+		}
+
+		if (pret > 0) {
+			orb_copy(ORB_ID(sensor_range_finder), range_sub, &range);
+
+			/* tilt-compensate the return and fuse it */
+			if (range.valid && ref_time != 0 &&
+			    att.R_valid && att.R[8] > TERRAIN_COS_TILT_MIN &&
+			    range.distance > range.minimum_distance &&
+			    range.distance < range.maximum_distance) {
+
+				float terrain_meas = alt_ref - range.distance * att.R[8];
+
+				if (!have_estimate) {
+					terrain_alt = terrain_meas;
+					innov_filtered = 0.0f;
+					have_estimate = true;
+					last_accepted_time = now;
+
+				} else {
+					float innov = terrain_meas - terrain_alt;
+					innov_filtered += (innov - innov_filtered) * terr_filt;
+
+					if (fabsf(innov) > terr_err) {
+						/* spike or new surface? only accept the jump
+						 * once the filtered innovation follows it */
+						if (fabsf(innov - innov_filtered) < terr_err) {
+							terrain_alt = terrain_meas;
+							innov_filtered = 0.0f;
+							last_accepted_time = now;
+						}
+
+					} else {
+						terrain_alt += innov * terr_filt;
+						last_accepted_time = now;
+					}
+				}
+			}
+		}
+
+		estimate.timestamp = now;
+		estimate.terrain_alt = terrain_alt;
+		estimate.dist_ground = alt_ref - terrain_alt;
+		estimate.valid = have_estimate && (now - last_accepted_time < TERRAIN_VALID_TIMEOUT);
+
+		orb_publish(ORB_ID(terrain_estimate), estimate_pub, &estimate);
+	}
+
+	close(range_sub);
+	close(att_sub);
+	close(global_pos_sub);
+	close(sensor_sub);
+	close(param_sub);
+
+	thread_running = false;
+	return 0;
+}
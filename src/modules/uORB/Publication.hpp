@@ -39,6 +39,7 @@
 #pragma once
 
 #include <assert.h>
+#include <sched.h>
 
 #include <uORB/uORB.h>
 #include <containers/List.hpp>
@@ -132,6 +133,51 @@ public:
 	virtual void update() = 0;
 };
 
+/**
+ * A group of publications committed together.
+ *
+ * Modules that publish several topics back-to-back each cycle (the
+ * attitude controllers push actuator controls, rate setpoints and
+ * status in one burst) can stage their updates in the embedded
+ * structs and commit them in one go: the commit runs with the
+ * scheduler locked, so a subscriber polling several of the topics is
+ * woken once after all of them have been updated, instead of being
+ * scheduled once per topic.
+ */
+class __EXPORT PublicationGroup
+{
+public:
+	PublicationGroup() : _list() {
+	}
+
+	/**
+	 * Add a publication to the group. The publication remains owned
+	 * by the caller and can still be updated individually.
+	 */
+	void add(PublicationNode *node) {
+		_list.add(node);
+	}
+
+	/**
+	 * Publish all members under a single scheduler lock.
+	 */
+	void commit() {
+		sched_lock();
+
+		PublicationNode *node = _list.getHead();
+
+		while (node != nullptr) {
+			node->update();
+			node = node->getSibling();
+		}
+
+		sched_unlock();
+	}
+
+private:
+	List<PublicationNode *> _list;
+};
+
 /**
  * Publication wrapper class
  */
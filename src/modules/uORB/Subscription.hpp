@@ -67,15 +67,28 @@ public:
 	SubscriptionBase(const struct orb_metadata *meta,
 		unsigned interval=0) :
 		_meta(meta),
-		_handle() {
+		_handle(),
+		_gen_counter(nullptr),
+		_last_generation(0) {
 		setHandle(orb_subscribe(getMeta()));
 		orb_set_interval(getHandle(), interval);
+		/* rate-unlimited subscriptions can compare the node's
+		 * generation counter in-process instead of paying an
+		 * ioctl round trip per check */
+		if (interval == 0 &&
+			orb_generation_location(getHandle(), &_gen_counter) == 0 &&
+			_gen_counter != nullptr) {
+			_last_generation = *_gen_counter;
+		}
 	}
 
 	/**
 	 * Check if there is a new update.
 	 * */
 	bool updated() {
+		if (_gen_counter != nullptr) {
+			return *_gen_counter != _last_generation;
+		}
 		bool isUpdated = false;
 		orb_check(_handle, &isUpdated);
 		return isUpdated;
@@ -86,6 +99,17 @@ public:
 	 * @param data The uORB message struct we are updating.
 	 */
 	void update(void * data) {
+		if (_gen_counter != nullptr) {
+			/* read the counter before the copy so an update
+			 * racing the copy is seen again next cycle */
+			unsigned generation = *_gen_counter;
+			if (generation == _last_generation) {
+				return;
+			}
+			orb_copy(_meta, _handle, data);
+			_last_generation = generation;
+			return;
+		}
 		if (updated()) {
 			orb_copy(_meta, _handle, data);
 		}
@@ -106,6 +130,8 @@ protected:
 // attributes
 	const struct orb_metadata *_meta;
 	int _handle;
+	const volatile unsigned *_gen_counter; /**< in-process view of the node's generation counter */
+	unsigned _last_generation; /**< generation seen at the last copy */
 };
 
 /**
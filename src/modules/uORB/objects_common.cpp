@@ -218,12 +218,27 @@ ORB_DEFINE(telemetry_status_1, struct telemetry_status_s);
 ORB_DEFINE(telemetry_status_2, struct telemetry_status_s);
 ORB_DEFINE(telemetry_status_3, struct telemetry_status_s);
 
+#include "topics/datalink_status.h"
+ORB_DEFINE(datalink_status, struct datalink_status_s);
+
+#include "topics/terrain_estimate.h"
+ORB_DEFINE(terrain_estimate, struct terrain_estimate_s);
+
 #include "topics/test_motor.h"
 ORB_DEFINE(test_motor, struct test_motor_s);
 
 #include "topics/debug_key_value.h"
 ORB_DEFINE(debug_key_value, struct debug_key_value_s);
 
+#include "topics/heap_status.h"
+ORB_DEFINE(heap_status, struct heap_status_s);
+
+#include "topics/load_governor.h"
+ORB_DEFINE(load_governor, struct load_governor_s);
+
+#include "topics/cpu_load.h"
+ORB_DEFINE(cpu_load, struct cpu_load_s);
+
 #include "topics/navigation_capabilities.h"
 ORB_DEFINE(navigation_capabilities, struct navigation_capabilities_s);
 
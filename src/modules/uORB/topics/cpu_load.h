@@ -0,0 +1,78 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file cpu_load.h
+ *
+ * Per-task CPU load and stack watermark snapshot, published at low rate
+ * by the load monitor (see systemlib/load_mon.h) so routine log review
+ * catches performance regressions without a shell session. The idle
+ * thread occupies the first entry.
+ */
+
+#ifndef TOPIC_CPU_LOAD_H
+#define TOPIC_CPU_LOAD_H
+
+#include <stdint.h>
+#include "../uORB.h"
+
+/** maximum tasks reported per snapshot */
+#define CPU_LOAD_MAX_TASKS	32
+
+/**
+ * @addtogroup topics
+ * @{
+ */
+
+struct cpu_load_task_s {
+	int16_t pid;				/**< process id */
+	uint16_t load;				/**< CPU share over the last interval, 0.1% units */
+	uint16_t stack_used;		/**< stack watermark in bytes */
+	uint16_t stack_size;		/**< allocated stack in bytes */
+	char name[16];				/**< task name, zero terminated */
+};
+
+struct cpu_load_s {
+	uint64_t timestamp;			/**< snapshot time in microseconds since system start */
+	uint8_t task_count;			/**< number of valid entries in tasks[] */
+	struct cpu_load_task_s tasks[CPU_LOAD_MAX_TASKS];
+};
+
+/**
+ * @}
+ */
+
+/* register this as object request broker structure */
+ORB_DECLARE(cpu_load);
+
+#endif
@@ -0,0 +1,80 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file load_governor.h
+ * Definition of the CPU load governor uORB topic. Published by the
+ * governor (see the 'governor' command) whenever the shed level is
+ * re-evaluated, so low-QoS producers can adapt and the decisions are
+ * visible in the log.
+ */
+
+#ifndef TOPIC_LOAD_GOVERNOR_H_
+#define TOPIC_LOAD_GOVERNOR_H_
+
+#include <stdint.h>
+#include "../uORB.h"
+
+/**
+ * @addtogroup topics
+ * @{
+ */
+
+/**
+ * Load shed levels; each level includes the measures of the lower ones.
+ */
+enum LOAD_SHED_LEVEL {
+	LOAD_SHED_NONE = 0,	/**< normal operation */
+	LOAD_SHED_TELEMETRY,	/**< mavlink stream rates halved */
+	LOAD_SHED_LOGGING,	/**< rates quartered, rate-limited log messages decimated */
+	LOAD_SHED_UI		/**< additionally shed LED pattern refreshes */
+};
+
+/**
+ * CPU load governor state
+ */
+struct load_governor_s {
+	uint64_t timestamp;	/**< time of the evaluation, microseconds */
+	float idle_share;	/**< idle thread share of the evaluation window, 0..1 */
+	uint8_t shed_level;	/**< current LOAD_SHED_LEVEL */
+};
+
+/**
+ * @}
+ */
+
+/* register this as object request broker structure */
+ORB_DECLARE(load_governor);
+
+#endif
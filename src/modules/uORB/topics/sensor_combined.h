@@ -53,6 +53,22 @@ enum MAGNETOMETER_MODE {
 	MAGNETOMETER_MODE_NEGATIVE_BIAS
 };
 
+/**
+ * Depth of the publisher-side sample queue.
+ *
+ * The topic is advertised with a short queue so that subscribers running
+ * slower than the sensor rate can drain every sample since their last read
+ * (e.g. for launch detection) instead of only seeing the newest one.
+ */
+#define SENSOR_COMBINED_QUEUE_DEPTH	4
+
+/**
+ * ABI identification of the struct layout below. Bump whenever fields
+ * are added, removed or reordered, so logs and bridges can detect
+ * which struct version produced a stream.
+ */
+#define SENSOR_COMBINED_ABI_VERSION	2
+
 /**
  * @addtogroup topics
  * @{
@@ -76,90 +92,95 @@ struct sensor_combined_s {
 	 * logged dataset.
 	 */
 
-	/* NOTE: Ordering of fields optimized to align to 32 bit / 4 bytes Change with consideration only   */
+	/* NOTE: Fields are ordered by descending alignment (8-byte timestamps,
+	 * then 4-byte values, then the 2-byte raw readings) so the struct
+	 * carries no internal padding holes; every orb_copy() and log write
+	 * moves only payload. Keep new fields in their alignment class and
+	 * bump SENSOR_COMBINED_ABI_VERSION when the layout changes. */
 
 	uint64_t timestamp;			/**< Timestamp in microseconds since boot, from gyro         */
+	uint64_t accelerometer_timestamp;	/**< Accelerometer timestamp        */
+	uint64_t magnetometer_timestamp;	/**< Magnetometer timestamp         */
+	uint64_t gyro1_timestamp;		/**< Gyro timestamp */
+	uint64_t accelerometer1_timestamp;	/**< Accelerometer timestamp        */
+	uint64_t magnetometer1_timestamp;	/**< Magnetometer timestamp         */
+	uint64_t gyro2_timestamp;		/**< Gyro timestamp */
+	uint64_t accelerometer2_timestamp;	/**< Accelerometer timestamp        */
+	uint64_t magnetometer2_timestamp;	/**< Magnetometer timestamp         */
+	uint64_t baro_timestamp;		/**< Barometer timestamp        */
+	uint64_t baro1_timestamp;		/**< Barometer timestamp        */
+	uint64_t differential_pressure_timestamp;	/**< Last measurement timestamp */
+	uint64_t differential_pressure1_timestamp;	/**< Last measurement timestamp */
 
-	int16_t	gyro_raw[3];			/**< Raw sensor values of angular velocity        */
 	float gyro_rad_s[3];			/**< Angular velocity in radian per seconds       */
 	unsigned gyro_errcount;			/**< Error counter for gyro 0 */
 	float gyro_temp;			/**< Temperature of gyro 0 */
 
-	int16_t accelerometer_raw[3];		/**< Raw acceleration in NED body frame           */
 	float accelerometer_m_s2[3];		/**< Acceleration in NED body frame, in m/s^2     */
 	int accelerometer_mode;			/**< Accelerometer measurement mode */
 	float accelerometer_range_m_s2;		/**< Accelerometer measurement range in m/s^2 */
-	uint64_t accelerometer_timestamp;	/**< Accelerometer timestamp        */
 	unsigned accelerometer_errcount;	/**< Error counter for accel 0 */
 	float accelerometer_temp;		/**< Temperature of accel 0 */
 
-	int16_t	magnetometer_raw[3];		/**< Raw magnetic field in NED body frame         */
 	float magnetometer_ga[3];		/**< Magnetic field in NED body frame, in Gauss   */
 	int magnetometer_mode;			/**< Magnetometer measurement mode */
 	float magnetometer_range_ga;		/**< ± measurement range in Gauss */
 	float magnetometer_cuttoff_freq_hz;	/**< Internal analog low pass frequency of sensor */
-	uint64_t magnetometer_timestamp;	/**< Magnetometer timestamp         */
 	unsigned magnetometer_errcount;		/**< Error counter for mag 0 */
 	float magnetometer_temp;		/**< Temperature of mag 0 */
 
-	int16_t	gyro1_raw[3];			/**< Raw sensor values of angular velocity        */
 	float gyro1_rad_s[3];			/**< Angular velocity in radian per seconds       */
-	uint64_t gyro1_timestamp;		/**< Gyro timestamp */
 	unsigned gyro1_errcount;		/**< Error counter for gyro 1 */
 	float gyro1_temp;			/**< Temperature of gyro 1 */
 
-	int16_t accelerometer1_raw[3];		/**< Raw acceleration in NED body frame           */
 	float accelerometer1_m_s2[3];		/**< Acceleration in NED body frame, in m/s^2     */
-	uint64_t accelerometer1_timestamp;	/**< Accelerometer timestamp        */
 	unsigned accelerometer1_errcount;	/**< Error counter for accel 1 */
 	float accelerometer1_temp;		/**< Temperature of accel 1 */
 
-	int16_t	magnetometer1_raw[3];		/**< Raw magnetic field in NED body frame         */
 	float magnetometer1_ga[3];		/**< Magnetic field in NED body frame, in Gauss   */
-	uint64_t magnetometer1_timestamp;	/**< Magnetometer timestamp         */
 	unsigned magnetometer1_errcount;	/**< Error counter for mag 1 */
 	float magnetometer1_temp;		/**< Temperature of mag 1 */
 
-	int16_t	gyro2_raw[3];			/**< Raw sensor values of angular velocity        */
 	float gyro2_rad_s[3];			/**< Angular velocity in radian per seconds       */
-	uint64_t gyro2_timestamp;		/**< Gyro timestamp */
 	unsigned gyro2_errcount;		/**< Error counter for gyro 1 */
 	float gyro2_temp;			/**< Temperature of gyro 1 */
 
-	int16_t accelerometer2_raw[3];		/**< Raw acceleration in NED body frame           */
 	float accelerometer2_m_s2[3];		/**< Acceleration in NED body frame, in m/s^2     */
-	uint64_t accelerometer2_timestamp;	/**< Accelerometer timestamp        */
 	unsigned accelerometer2_errcount;	/**< Error counter for accel 2 */
 	float accelerometer2_temp;		/**< Temperature of accel 2 */
 
-	int16_t	magnetometer2_raw[3];		/**< Raw magnetic field in NED body frame         */
 	float magnetometer2_ga[3];		/**< Magnetic field in NED body frame, in Gauss   */
-	uint64_t magnetometer2_timestamp;	/**< Magnetometer timestamp         */
 	unsigned magnetometer2_errcount;	/**< Error counter for mag 2 */
 	float magnetometer2_temp;		/**< Temperature of mag 2 */
 
 	float baro_pres_mbar;			/**< Barometric pressure, already temp. comp.     */
 	float baro_alt_meter;			/**< Altitude, already temp. comp.                */
 	float baro_temp_celcius;		/**< Temperature in degrees celsius               */
-	uint64_t baro_timestamp;		/**< Barometer timestamp        */
 
 	float baro1_pres_mbar;			/**< Barometric pressure, already temp. comp.     */
 	float baro1_alt_meter;			/**< Altitude, already temp. comp.                */
 	float baro1_temp_celcius;		/**< Temperature in degrees celsius               */
-	uint64_t baro1_timestamp;		/**< Barometer timestamp        */
 
 	float adc_voltage_v[10];		/**< ADC voltages of ADC Chan 10/11/12/13 or -1   */
 	unsigned adc_mapping[10];		/**< Channel indices of each of these values */
 	float mcu_temp_celcius;			/**< Internal temperature measurement of MCU */
 
 	float differential_pressure_pa;			/**< Airspeed sensor differential pressure */
-	uint64_t differential_pressure_timestamp;	/**< Last measurement timestamp */
 	float differential_pressure_filtered_pa;	/**< Low pass filtered airspeed sensor differential pressure reading */
 
 	float differential_pressure1_pa;			/**< Airspeed sensor differential pressure */
-	uint64_t differential_pressure1_timestamp;	/**< Last measurement timestamp */
 	float differential_pressure1_filtered_pa;	/**< Low pass filtered airspeed sensor differential pressure reading */
 
+	int16_t	gyro_raw[3];			/**< Raw sensor values of angular velocity        */
+	int16_t accelerometer_raw[3];		/**< Raw acceleration in NED body frame           */
+	int16_t	magnetometer_raw[3];		/**< Raw magnetic field in NED body frame         */
+	int16_t	gyro1_raw[3];			/**< Raw sensor values of angular velocity        */
+	int16_t accelerometer1_raw[3];		/**< Raw acceleration in NED body frame           */
+	int16_t	magnetometer1_raw[3];		/**< Raw magnetic field in NED body frame         */
+	int16_t	gyro2_raw[3];			/**< Raw sensor values of angular velocity        */
+	int16_t accelerometer2_raw[3];		/**< Raw acceleration in NED body frame           */
+	int16_t	magnetometer2_raw[3];		/**< Raw magnetic field in NED body frame         */
+
 };
 
 /**
@@ -52,6 +52,8 @@
 #include <math.h>
 #include <unistd.h>
 #include <systemlib/err.h>
+#include <systemlib/trace.h>
+#include <systemlib/lock_audit.h>
 
 #include <nuttx/arch.h>
 #include <nuttx/wqueue.h>
@@ -64,6 +66,8 @@
 
 #include "uORB.h"
 
+class ORBDevNode;
+
 /**
  * Utility functions.
  */
@@ -88,8 +92,76 @@ struct orb_advertdata {
 	const struct orb_metadata *meta;
 	int *instance;
 	int priority;
+	unsigned flags;
+	unsigned queue_size;
+};
+
+/* node flags passed through orb_advertdata */
+enum {
+	NODE_FLAG_LOCKFREE = (1 << 0),	/**< single-producer lock-free publication */
+	NODE_FLAG_QUEUED = (1 << 1)	/**< node retains a queue of samples per subscriber */
 };
 
+/**
+ * Compiler barrier; orders the buffer copies in the lock-free
+ * path against the (volatile) generation counter accesses.
+ * Sufficient on the single-core targets we run on.
+ */
+static inline void
+orb_compiler_barrier(void)
+{
+	__asm__ __volatile__ ("" ::: "memory");
+}
+
+/*
+ * Link-time topic table; ORB_DEFINE emits one entry per topic into the
+ * __orb_topic_table section and the linker provides the bounds.
+ */
+extern "C" const struct orb_metadata *__start___orb_topic_table[] __attribute__((weak));
+extern "C" const struct orb_metadata *__stop___orb_topic_table[] __attribute__((weak));
+
+/**
+ * Registry of created topic nodes, indexed by topic table index and
+ * instance.  Lets the library tell whether a node exists without a
+ * string-path lookup through the cdev namespace; lazily allocated on
+ * first use.
+ */
+ORBDevNode **g_node_registry = nullptr;
+
+ORBDevNode **
+node_registry_slot(const struct orb_metadata *meta, unsigned instance)
+{
+	int index = orb_topic_index(meta);
+
+	if ((index < 0) || (instance >= ORB_MULTI_MAX_INSTANCES))
+		return nullptr;
+
+	if (g_node_registry == nullptr) {
+		unsigned count = orb_topic_count() * ORB_MULTI_MAX_INSTANCES;
+		ORBDevNode **registry = new ORBDevNode *[count];
+
+		if (registry == nullptr)
+			return nullptr;
+
+		memset(registry, 0, count * sizeof(ORBDevNode *));
+
+		/* publish the registry; losing the race just leaks one table */
+		irqstate_t flags = irqsave();
+
+		if (g_node_registry == nullptr) {
+			g_node_registry = registry;
+			registry = nullptr;
+		}
+
+		irqrestore(flags);
+
+		if (registry != nullptr)
+			delete[] registry;
+	}
+
+	return &g_node_registry[index * ORB_MULTI_MAX_INSTANCES + instance];
+}
+
 int
 node_mkpath(char *buf, Flavor f, const struct orb_metadata *meta, int *instance = nullptr)
 {
@@ -120,7 +192,8 @@ node_mkpath(char *buf, Flavor f, const struct orb_metadata *meta, int *instance
 class ORBDevNode : public device::CDev
 {
 public:
-	ORBDevNode(const struct orb_metadata *meta, const char *name, const char *path, int priority);
+	ORBDevNode(const struct orb_metadata *meta, const char *name, const char *path, int priority,
+		   unsigned flags = 0, unsigned queue_size = 1);
 	~ORBDevNode();
 
 	virtual int		open(struct file *filp);
@@ -131,6 +204,24 @@ public:
 
 	static ssize_t		publish(const orb_metadata *meta, orb_advert_t handle, const void *data);
 
+	/*
+	 * Instrumentation accessors for the 'uorb top' listing.
+	 */
+	unsigned		generation() const { return _generation; }
+	unsigned		drop_count() const { return _drop_count; }
+	hrt_abstime		last_update() const { return _last_update; }
+	int			priority() const { return _priority; }
+	const struct orb_metadata *meta() const { return _meta; }
+
+	/** Return the worst subscriber lag seen since the last call and reset it. */
+	unsigned		fetch_max_lag() {
+		irqstate_t flags = irqsave();
+		unsigned lag = _max_lag;
+		_max_lag = 0;
+		irqrestore(flags);
+		return lag;
+	}
+
 protected:
 	virtual pollevent_t	poll_state(struct file *filp);
 	virtual void		poll_notify_one(struct pollfd *fds, pollevent_t events);
@@ -143,6 +234,7 @@ private:
 		void		*poll_priv;	/**< saved copy of fds->f_priv while poll is active */
 		bool		update_reported; /**< true if we have reported the update via poll/check */
 		int		priority;	/**< priority of publisher */
+		unsigned	acquired_generation; /**< generation an outstanding zero-copy reference was taken at */
 	};
 
 	const struct orb_metadata *_meta;	/**< object metadata information */
@@ -151,6 +243,52 @@ private:
 	volatile unsigned 	_generation;	/**< object generation count */
 	pid_t			_publisher;	/**< if nonzero, current publisher */
 	const int		_priority;	/**< priority of topic */
+	const unsigned		_flags;		/**< node behaviour flags (NODE_FLAG_*) */
+	const unsigned		_queue_size;	/**< number of buffered samples (1 = classic latest-only) */
+	unsigned		_drop_count;	/**< updates subscribers never saw (lag > queue) */
+	unsigned		_max_lag;	/**< worst generation lag observed at read since last fetch */
+
+	/**
+	 * Account for a subscriber reading with the given generation lag;
+	 * call with interrupts disabled (or from the lock-free read path,
+	 * where a rare lost update to the counters is acceptable).
+	 */
+	void			note_lag(unsigned lag) {
+		if (lag > _max_lag)
+			_max_lag = lag;
+
+		if (lag > _queue_size)
+			_drop_count += lag - _queue_size;
+	}
+
+	bool			is_lockfree() const { return _flags & NODE_FLAG_LOCKFREE; }
+	bool			is_queued() const { return _flags & NODE_FLAG_QUEUED; }
+
+	struct lock_audit_s	_lock_audit;	/**< contention/inversion audit of the node lock */
+
+	/**
+	 * Take the node lock with contention auditing; pairs with
+	 * unlock_audited().
+	 */
+	void			lock_audited() {
+		uint64_t t_start = lock_audit_prelock(&_lock_audit);
+		lock();
+		lock_audit_locked(&_lock_audit, t_start);
+	}
+
+	void			unlock_audited() {
+		lock_audit_unlock(&_lock_audit);
+		unlock();
+	}
+
+	/**
+	 * Buffer slot holding the sample with the given index; queued and
+	 * lock-free nodes cycle through _queue_size slots so the writer
+	 * never scribbles on the slot a reader is copying from.
+	 */
+	uint8_t			*slot(unsigned index) {
+		return _data + ((index % _queue_size) * _meta->o_size);
+	}
 
 	SubscriberData		*filp_to_sd(struct file *filp) {
 		SubscriberData *sd = (SubscriberData *)(filp->f_priv);
@@ -178,15 +316,22 @@ private:
 	bool			appears_updated(SubscriberData *sd);
 };
 
-ORBDevNode::ORBDevNode(const struct orb_metadata *meta, const char *name, const char *path, int priority) :
+ORBDevNode::ORBDevNode(const struct orb_metadata *meta, const char *name, const char *path, int priority,
+		       unsigned flags, unsigned queue_size) :
 	CDev(name, path),
 	_meta(meta),
 	_data(nullptr),
 	_last_update(0),
 	_generation(0),
 	_publisher(0),
-	_priority(priority)
+	_priority(priority),
+	_flags(flags),
+	_queue_size((flags & NODE_FLAG_LOCKFREE) ? 2 : ((queue_size > 0) ? queue_size : 1)),
+	_drop_count(0),
+	_max_lag(0)
 {
+	lock_audit_init(&_lock_audit, meta->o_name);
+
 	// enable debug() calls
 	_debug_enabled = true;
 }
@@ -207,7 +352,7 @@ ORBDevNode::open(struct file *filp)
 	if (filp->f_oflags == O_WRONLY) {
 
 		/* become the publisher if we can */
-		lock();
+		lock_audited();
 
 		if (_publisher == 0) {
 			_publisher = getpid();
@@ -217,7 +362,7 @@ ORBDevNode::open(struct file *filp)
 			ret = -EBUSY;
 		}
 
-		unlock();
+		unlock_audited();
 
 		/* now complete the open */
 		if (ret == OK) {
@@ -294,14 +439,69 @@ ORBDevNode::read(struct file *filp, char *buffer, size_t buflen)
 	if (buflen != _meta->o_size)
 		return -EIO;
 
+	/*
+	 * Lock-free nodes: copy from the slot the latest generation points
+	 * at and re-check the generation afterwards; retry if the single
+	 * producer lapped us in the meantime.  This never disables
+	 * interrupts and never blocks on the device lock.
+	 */
+	if (is_lockfree()) {
+		unsigned gen;
+
+		do {
+			gen = _generation;
+			orb_compiler_barrier();
+
+			if (nullptr != buffer)
+				memcpy(buffer, slot(gen - 1), _meta->o_size);
+
+			orb_compiler_barrier();
+		} while (gen != _generation);
+
+		note_lag(gen - sd->generation);
+		sd->generation = gen;
+		sd->priority = _priority;
+		sd->update_reported = false;
+
+		return _meta->o_size;
+	}
+
 	/*
 	 * Perform an atomic copy & state update
 	 */
 	irqstate_t flags = irqsave();
 
+	note_lag(_generation - sd->generation);
+
+	/*
+	 * Queued nodes hand out the oldest sample the subscriber has not
+	 * seen yet, so a briefly preempted consumer can drain the backlog
+	 * without losing data.
+	 */
+	if (is_queued() && (sd->generation != _generation)) {
+
+		/* if the subscriber fell behind the queue, drop to the oldest retained sample */
+		if (_generation - sd->generation > _queue_size)
+			sd->generation = _generation - _queue_size;
+
+		if (nullptr != buffer)
+			memcpy(buffer, slot(sd->generation), _meta->o_size);
+
+		sd->generation++;
+		sd->priority = _priority;
+
+		/* only clear the update flag once the backlog is drained */
+		if (sd->generation == _generation)
+			sd->update_reported = false;
+
+		irqrestore(flags);
+
+		return _meta->o_size;
+	}
+
 	/* if the caller doesn't want the data, don't give it to them */
 	if (nullptr != buffer)
-		memcpy(buffer, _data, _meta->o_size);
+		memcpy(buffer, slot(_generation - 1), _meta->o_size);
 
 	/* track the last generation that the file has seen */
 	sd->generation = _generation;
@@ -335,13 +535,13 @@ ORBDevNode::write(struct file *filp, const char *buffer, size_t buflen)
 	if (nullptr == _data) {
 		if (!up_interrupt_context()) {
 
-			lock();
+			lock_audited();
 
-			/* re-check size */
+			/* re-check size; queued and lock-free nodes multi-buffer */
 			if (nullptr == _data)
-				_data = new uint8_t[_meta->o_size];
+				_data = new uint8_t[_meta->o_size * _queue_size];
 
-			unlock();
+			unlock_audited();
 		}
 
 		/* failed or could not allocate */
@@ -353,10 +553,21 @@ ORBDevNode::write(struct file *filp, const char *buffer, size_t buflen)
 	if (_meta->o_size != buflen)
 		return -EIO;
 
-	/* Perform an atomic copy. */
-	irqstate_t flags = irqsave();
-	memcpy(_data, buffer, _meta->o_size);
-	irqrestore(flags);
+	if (is_lockfree()) {
+		/*
+		 * Single producer: fill the slot the next generation will
+		 * select, then publish it by bumping the generation.
+		 * Readers copying the previous slot are not disturbed.
+		 */
+		memcpy(slot(_generation), buffer, _meta->o_size);
+		orb_compiler_barrier();
+
+	} else {
+		/* Perform an atomic copy into the current slot. */
+		irqstate_t flags = irqsave();
+		memcpy(slot(_generation), buffer, _meta->o_size);
+		irqrestore(flags);
+	}
 
 	/* update the timestamp and generation count */
 	_last_update = hrt_absolute_time();
@@ -394,6 +605,52 @@ ORBDevNode::ioctl(struct file *filp, int cmd, unsigned long arg)
 		*(int *)arg = sd->priority;
 		return OK;
 
+	case ORBIOCACQUIRE: {
+			/*
+			 * Zero-copy reads only work on multi-buffered nodes, where
+			 * the publisher is guaranteed not to overwrite the slot the
+			 * reference points at before publishing at least
+			 * (_queue_size - 1) further samples.
+			 */
+			if (_queue_size < 2)
+				return -ENOTSUP;
+
+			if (_data == nullptr)
+				return -EAGAIN;
+
+			unsigned gen = _generation;
+			orb_compiler_barrier();
+
+			*(const void **)arg = slot(gen - 1);
+			sd->generation = gen;
+			sd->acquired_generation = gen;
+			sd->update_reported = false;
+			return OK;
+		}
+
+	case ORBIOCGGENCOUNTER:
+		/*
+		 * Hand out the address of the generation counter so in-process
+		 * subscribers can compare it against their own copy without an
+		 * ioctl round trip.  Safe on the flat-memory targets we run on.
+		 */
+		*(volatile unsigned **)arg = &_generation;
+		return OK;
+
+	case ORBIOCRELEASE:
+		/*
+		 * Report whether the referenced slot survived.  The writer
+		 * fills the slot of generation N while the counter still
+		 * reads N, so the slot referenced at acquire time (generation
+		 * - 1) may already be rewritten once the counter has advanced
+		 * by (_queue_size - 1); the caller must then discard what it
+		 * read and re-acquire.
+		 */
+		if (_generation - sd->acquired_generation >= _queue_size - 1)
+			return -EAGAIN;
+
+		return OK;
+
 	default:
 		/* give it to the superclass */
 		return CDev::ioctl(filp, cmd, arg);
@@ -423,6 +680,9 @@ ORBDevNode::publish(const orb_metadata *meta, orb_advert_t handle, const void *d
 		return ERROR;
 	}
 
+	/* the topic is identified by its metadata address, resolve via the ELF symbol table */
+	TRACE(TRACE_EV_ORB_PUBLISH, (uint32_t)(uintptr_t)meta);
+
 	return OK;
 }
 
@@ -563,6 +823,19 @@ public:
 	virtual int		ioctl(struct file *filp, int cmd, unsigned long arg);
 private:
 	Flavor			_flavor;
+
+	struct lock_audit_s	_lock_audit;	/**< contention/inversion audit of the master lock */
+
+	void			lock_audited() {
+		uint64_t t_start = lock_audit_prelock(&_lock_audit);
+		lock();
+		lock_audit_locked(&_lock_audit, t_start);
+	}
+
+	void			unlock_audited() {
+		lock_audit_unlock(&_lock_audit);
+		unlock();
+	}
 };
 
 ORBDevMaster::ORBDevMaster(Flavor f) :
@@ -570,6 +843,8 @@ ORBDevMaster::ORBDevMaster(Flavor f) :
 	     (f == PUBSUB) ? TOPIC_MASTER_DEVICE_PATH : PARAM_MASTER_DEVICE_PATH),
 	_flavor(f)
 {
+	lock_audit_init(&_lock_audit, (f == PUBSUB) ? "obj_master" : "param_master");
+
 	// enable debug() calls
 	_debug_enabled = true;
 
@@ -606,7 +881,7 @@ ORBDevMaster::ioctl(struct file *filp, int cmd, unsigned long arg)
 			}
 
 			/* ensure that only one advertiser runs through this critical section */
-			lock();
+			lock_audited();
 
 			ret = ERROR;
 
@@ -636,22 +911,30 @@ ORBDevMaster::ioctl(struct file *filp, int cmd, unsigned long arg)
 				}
 
 				/* construct the new node */
-				node = new ORBDevNode(meta, objname, devpath, adv->priority);
+				node = new ORBDevNode(meta, objname, devpath, adv->priority, adv->flags,
+						      adv->queue_size);
 
 				/* if we didn't get a device, that's bad */
 				if (node == nullptr) {
-					unlock();
+					unlock_audited();
 					return -ENOMEM;
 				}
 
 				/* initialise the node - this may fail if e.g. a node with this name already exists */
 				ret = node->init();
-				
+
 				/* if init failed, discard the node and its name */
 				if (ret != OK) {
 					delete node;
 					free((void *)objname);
 					free((void *)devpath);
+
+				} else {
+					/* record the node so later lookups skip the namespace walk */
+					ORBDevNode **slot = node_registry_slot(meta, group_tries);
+
+					if (slot != nullptr)
+						*slot = node;
 				}
 
 				group_tries++;
@@ -663,7 +946,7 @@ ORBDevMaster::ioctl(struct file *filp, int cmd, unsigned long arg)
 			}
 
 			/* the file handle for the driver has been created, unlock */
-			unlock();
+			unlock_audited();
 
 			return ret;
 		}
@@ -998,6 +1281,60 @@ info()
 	return OK;
 }
 
+/**
+ * List the live topics with publish rate, drop count and worst
+ * subscriber lag, in the style of the 'top' system command.
+ */
+int
+top()
+{
+	const unsigned topics = orb_topic_count();
+	const unsigned slots = topics * ORB_MULTI_MAX_INSTANCES;
+
+	if (g_node_registry == nullptr) {
+		warnx("no topics have been created");
+		return OK;
+	}
+
+	unsigned *gen_start = new unsigned[slots];
+
+	if (gen_start == nullptr)
+		return -ENOMEM;
+
+	/* sample all generation counters, wait, then sample again for rates */
+	for (unsigned i = 0; i < slots; i++)
+		gen_start[i] = (g_node_registry[i] != nullptr) ? g_node_registry[i]->generation() : 0;
+
+	hrt_abstime t_start = hrt_absolute_time();
+
+	usleep(500000);
+
+	hrt_abstime interval = hrt_elapsed_time(&t_start);
+
+	printf("%-24s %4s %6s %8s %8s %8s %8s\n",
+	       "TOPIC", "INST", "SIZE", "RATE", "PUBS", "DROPS", "MAXLAG");
+
+	for (unsigned i = 0; i < topics; i++) {
+		for (unsigned j = 0; j < ORB_MULTI_MAX_INSTANCES; j++) {
+			ORBDevNode *node = g_node_registry[i * ORB_MULTI_MAX_INSTANCES + j];
+
+			if (node == nullptr)
+				continue;
+
+			unsigned gen = node->generation();
+			float rate = (gen - gen_start[i * ORB_MULTI_MAX_INSTANCES + j]) * 1e6f / interval;
+
+			printf("%-24s %4u %6u %8.1f %8u %8u %8u\n",
+			       node->meta()->o_name, j, (unsigned)node->meta()->o_size,
+			       (double)rate, gen, node->drop_count(), node->fetch_max_lag());
+		}
+	}
+
+	delete[] gen_start;
+
+	return OK;
+}
+
 
 } // namespace
 
@@ -1066,7 +1403,13 @@ uorb_main(int argc, char *argv[])
 	if (!strcmp(argv[1], "status"))
 		return info();
 
-	errx(-EINVAL, "unrecognized command, try 'start', 'test', 'latency_test' or 'status'");
+	/*
+	 * Print per-topic rate / drop / lag statistics.
+	 */
+	if (!strcmp(argv[1], "top"))
+		return top();
+
+	errx(-EINVAL, "unrecognized command, try 'start', 'test', 'latency_test', 'top' or 'status'");
 }
 
 /*
@@ -1083,13 +1426,26 @@ namespace
  *       we tried to advertise.
  */
 int
-node_advertise(const struct orb_metadata *meta, int *instance = nullptr, int priority = ORB_PRIO_DEFAULT)
+node_advertise(const struct orb_metadata *meta, int *instance = nullptr, int priority = ORB_PRIO_DEFAULT,
+	       unsigned flags = 0, unsigned queue_size = 1)
 {
 	int fd = -1;
 	int ret = ERROR;
 
+	/*
+	 * If the node has already been created there is nothing to do; the
+	 * registry check avoids the master-device open and ioctl entirely.
+	 * Multi-advertisers still need the master to pick a free instance.
+	 */
+	if (instance == nullptr) {
+		ORBDevNode **slot = node_registry_slot(meta, 0);
+
+		if ((slot != nullptr) && (*slot != nullptr))
+			return OK;
+	}
+
 	/* fill advertiser data */
-	const struct orb_advertdata adv = { meta, instance, priority };
+	const struct orb_advertdata adv = { meta, instance, priority, flags, queue_size };
 
 	/* open the control device */
 	fd = open(TOPIC_MASTER_DEVICE_PATH, 0);
@@ -1120,7 +1476,7 @@ out:
  * advertisers.
  */
 int
-node_open(Flavor f, const struct orb_metadata *meta, const void *data, bool advertiser, int *instance = nullptr, int priority = ORB_PRIO_DEFAULT)
+node_open(Flavor f, const struct orb_metadata *meta, const void *data, bool advertiser, int *instance = nullptr, int priority = ORB_PRIO_DEFAULT, unsigned flags = 0, unsigned queue_size = 1)
 {
 	char path[orb_maxpath];
 	int fd, ret;
@@ -1152,8 +1508,21 @@ node_open(Flavor f, const struct orb_metadata *meta, const void *data, bool adve
 		return ERROR;
 	}
 
-	/* open the path as either the advertiser or the subscriber */
-	fd = open(path, (advertiser) ? O_WRONLY : O_RDONLY);
+	/*
+	 * If the registry tells us the node has not been created yet, skip
+	 * the doomed first open and go straight to advertising it.  On boot
+	 * most subscriptions run before the matching publisher and would
+	 * otherwise pay a failed namespace lookup each.
+	 */
+	ORBDevNode **reg = node_registry_slot(meta, (instance != nullptr) ? *instance : 0);
+
+	if (!advertiser && (reg != nullptr) && (*reg == nullptr)) {
+		fd = -1;
+
+	} else {
+		/* open the path as either the advertiser or the subscriber */
+		fd = open(path, (advertiser) ? O_WRONLY : O_RDONLY);
+	}
 
 	/* if we want to advertise and the node existed, we have to re-try again */
 	if ((fd >= 0) && (instance != nullptr) && (advertiser)) {
@@ -1167,7 +1536,7 @@ node_open(Flavor f, const struct orb_metadata *meta, const void *data, bool adve
 	if (fd < 0) {
 
 		/* try to create the node */
-		ret = node_advertise(meta, instance, priority);
+		ret = node_advertise(meta, instance, priority, flags, queue_size);
 
 		if (ret == OK) {
 			/* update the path, as it might have been updated during the node_advertise call */
@@ -1196,20 +1565,18 @@ node_open(Flavor f, const struct orb_metadata *meta, const void *data, bool adve
 
 } // namespace
 
-orb_advert_t
-orb_advertise(const struct orb_metadata *meta, const void *data)
+namespace
 {
-	return orb_advertise_multi(meta, data, nullptr, ORB_PRIO_DEFAULT);
-}
 
 orb_advert_t
-orb_advertise_multi(const struct orb_metadata *meta, const void *data, int *instance, int priority)
+advertise_flags(const struct orb_metadata *meta, const void *data, int *instance, int priority, unsigned flags,
+		unsigned queue_size = 1)
 {
 	int result, fd;
 	orb_advert_t advertiser;
 
 	/* open the node as an advertiser */
-	fd = node_open(PUBSUB, meta, data, true, instance, priority);
+	fd = node_open(PUBSUB, meta, data, true, instance, priority, flags, queue_size);
 	if (fd == ERROR)
 		return ERROR;
 
@@ -1227,6 +1594,32 @@ orb_advertise_multi(const struct orb_metadata *meta, const void *data, int *inst
 	return advertiser;
 }
 
+} // namespace
+
+orb_advert_t
+orb_advertise(const struct orb_metadata *meta, const void *data)
+{
+	return orb_advertise_multi(meta, data, nullptr, ORB_PRIO_DEFAULT);
+}
+
+orb_advert_t
+orb_advertise_multi(const struct orb_metadata *meta, const void *data, int *instance, int priority)
+{
+	return advertise_flags(meta, data, instance, priority, 0);
+}
+
+orb_advert_t
+orb_advertise_lockfree(const struct orb_metadata *meta, const void *data)
+{
+	return advertise_flags(meta, data, nullptr, ORB_PRIO_DEFAULT, NODE_FLAG_LOCKFREE);
+}
+
+orb_advert_t
+orb_advertise_queue(const struct orb_metadata *meta, const void *data, unsigned queue_size)
+{
+	return advertise_flags(meta, data, nullptr, ORB_PRIO_DEFAULT, NODE_FLAG_QUEUED, queue_size);
+}
+
 int
 orb_subscribe(const struct orb_metadata *meta)
 {
@@ -1246,6 +1639,84 @@ orb_unsubscribe(int handle)
 	return close(handle);
 }
 
+namespace
+{
+
+/** a publisher is considered live if it published within this window */
+const hrt_abstime ORB_LIVENESS_TIMEOUT = 500000;
+
+/**
+ * Pick the live instance with the highest publisher priority; falls back
+ * to the lowest existing instance if none published recently, and to
+ * instance 0 if the topic has not been created at all.
+ */
+int
+pick_best_instance(const struct orb_metadata *meta)
+{
+	int best = -1;
+	int best_priority = -1;
+	int first_existing = -1;
+
+	for (unsigned i = 0; i < ORB_MULTI_MAX_INSTANCES; i++) {
+		ORBDevNode **slot = node_registry_slot(meta, i);
+
+		if ((slot == nullptr) || (*slot == nullptr))
+			continue;
+
+		ORBDevNode *node = *slot;
+
+		if (first_existing < 0)
+			first_existing = i;
+
+		hrt_abstime last = node->last_update();
+
+		if ((node->generation() == 0) ||
+		    (hrt_elapsed_time(&last) > ORB_LIVENESS_TIMEOUT))
+			continue;
+
+		if (node->priority() > best_priority) {
+			best_priority = node->priority();
+			best = i;
+		}
+	}
+
+	if (best >= 0)
+		return best;
+
+	if (first_existing >= 0)
+		return first_existing;
+
+	return 0;
+}
+
+} // namespace
+
+int
+orb_subscribe_best(const struct orb_metadata *meta, int *instance)
+{
+	int inst = pick_best_instance(meta);
+
+	if (instance != nullptr)
+		*instance = inst;
+
+	return orb_subscribe_multi(meta, inst);
+}
+
+int
+orb_resubscribe_best(const struct orb_metadata *meta, int handle, int *instance)
+{
+	int best = pick_best_instance(meta);
+
+	if ((instance == nullptr) || (best == *instance))
+		return handle;
+
+	/* a better publisher came up (or the current one died); switch over */
+	close(handle);
+	*instance = best;
+
+	return orb_subscribe_multi(meta, best);
+}
+
 int
 orb_publish(const struct orb_metadata *meta, orb_advert_t handle, const void *data)
 {
@@ -1270,12 +1741,130 @@ orb_copy(const struct orb_metadata *meta, int handle, void *buffer)
 	return OK;
 }
 
+int
+orb_copy_multi(const struct orb_metadata *meta, int handle, void *buffer, unsigned max_samples)
+{
+	uint8_t *out = (uint8_t *)buffer;
+	unsigned count = 0;
+	bool updated;
+
+	/* always drain at least one sample, matching orb_copy semantics */
+	do {
+		int ret = read(handle, out, meta->o_size);
+
+		if (ret < 0)
+			return ERROR;
+
+		if (ret != (int)meta->o_size) {
+			errno = EIO;
+			return ERROR;
+		}
+
+		out += meta->o_size;
+		count++;
+
+		if (count >= max_samples)
+			break;
+
+		if (orb_check(handle, &updated) != OK)
+			return ERROR;
+
+	} while (updated);
+
+	return count;
+}
+
+int
+orb_acquire(const struct orb_metadata *meta, int handle, const void **data)
+{
+	(void)meta;
+	return ioctl(handle, ORBIOCACQUIRE, (unsigned long)(uintptr_t)data);
+}
+
+int
+orb_release(int handle)
+{
+	return ioctl(handle, ORBIOCRELEASE, 0);
+}
+
 int
 orb_check(int handle, bool *updated)
 {
 	return ioctl(handle, ORBIOCUPDATED, (unsigned long)(uintptr_t)updated);
 }
 
+int
+orb_generation_location(int handle, const volatile unsigned **generation)
+{
+	return ioctl(handle, ORBIOCGGENCOUNTER, (unsigned long)(uintptr_t)generation);
+}
+
+int
+orb_check_multi(const int *handles, bool *updated, unsigned count)
+{
+	for (unsigned i = 0; i < count; i++) {
+
+		/* tolerate failed subscriptions in the set */
+		if (handles[i] < 0) {
+			updated[i] = false;
+			continue;
+		}
+
+		if (orb_check(handles[i], &updated[i]) != OK)
+			return ERROR;
+	}
+
+	return OK;
+}
+
+int
+orb_snapshot(const struct orb_metadata *const *metas, const int *handles,
+	     unsigned count, void *buffer, size_t buffer_size, bool *updated)
+{
+	uint8_t *out = (uint8_t *)buffer;
+	size_t used = 0;
+	int copied = 0;
+	int ret = OK;
+
+	/* one pass with the scheduler locked: publishers cannot run
+	 * between the first and the last copy, the set is coherent */
+	sched_lock();
+
+	for (unsigned i = 0; i < count; i++) {
+		updated[i] = false;
+
+		/* tolerate failed subscriptions in the set */
+		if (handles[i] < 0)
+			continue;
+
+		if (orb_check(handles[i], &updated[i]) != OK) {
+			ret = ERROR;
+			break;
+		}
+
+		if (!updated[i])
+			continue;
+
+		if (used + metas[i]->o_size > buffer_size) {
+			errno = ENOSPC;
+			ret = ERROR;
+			break;
+		}
+
+		if (orb_copy(metas[i], handles[i], out + used) != OK) {
+			ret = ERROR;
+			break;
+		}
+
+		used += metas[i]->o_size;
+		copied++;
+	}
+
+	sched_unlock();
+
+	return (ret == OK) ? copied : ERROR;
+}
+
 int
 orb_stat(int handle, uint64_t *time)
 {
@@ -1294,3 +1883,32 @@ orb_set_interval(int handle, unsigned interval)
 	return ioctl(handle, ORBIOCSETINTERVAL, interval * 1000);
 }
 
+unsigned
+orb_topic_count(void)
+{
+	return __stop___orb_topic_table - __start___orb_topic_table;
+}
+
+const struct orb_metadata *
+orb_topic_get(unsigned index)
+{
+	if (index >= orb_topic_count())
+		return nullptr;
+
+	return __start___orb_topic_table[index];
+}
+
+int
+orb_topic_index(const struct orb_metadata *meta)
+{
+	const unsigned count = orb_topic_count();
+
+	/* plain pointer compare; the metadata objects are singletons */
+	for (unsigned i = 0; i < count; i++) {
+		if (__start___orb_topic_table[i] == meta)
+			return i;
+	}
+
+	return -1;
+}
+
@@ -121,7 +121,10 @@ enum ORB_PRIO {
 	const struct orb_metadata __orb_##_name = {	\
 		#_name,					\
 		sizeof(_struct)				\
-	}; struct hack
+	};						\
+	static const struct orb_metadata *__orb_##_name##_tab_entry \
+	__attribute__((used, section("__orb_topic_table"))) = &__orb_##_name; \
+	struct hack
 
 __BEGIN_DECLS
 
@@ -187,6 +190,47 @@ extern orb_advert_t orb_advertise(const struct orb_metadata *meta, const void *d
 extern orb_advert_t orb_advertise_multi(const struct orb_metadata *meta, const void *data, int *instance,
 					int priority) __EXPORT;
 
+/**
+ * Advertise as the single publisher of a topic with lock-free publication.
+ *
+ * The topic node is double-buffered and updates are published via a
+ * sequence counter; orb_publish never disables interrupts and orb_copy
+ * never blocks on the node lock.  Intended for high-rate hot paths such
+ * as the gyro-to-controller chain where lock contention between the
+ * publisher and subscribers is measurable.
+ *
+ * There must only ever be one publisher for a topic advertised this way;
+ * multi-instance publication is not supported and concurrent publishers
+ * will corrupt the topic.  Subscription is unchanged.
+ *
+ * @param meta		The uORB metadata (usually from the ORB_ID() macro)
+ *			for the topic.
+ * @param data		A pointer to the initial data to be published.
+ * @return		ERROR on error, otherwise returns a handle
+ *			that can be used to publish to the topic.
+ */
+extern orb_advert_t orb_advertise_lockfree(const struct orb_metadata *meta, const void *data) __EXPORT;
+
+/**
+ * Advertise as the publisher of a topic with a sample queue.
+ *
+ * The topic node retains the last queue_size published samples and each
+ * subscriber reads them in publication order, so a consumer that is
+ * briefly preempted does not silently lose updates.  orb_copy returns
+ * the oldest sample the subscriber has not yet seen; orb_check keeps
+ * reporting an update until the backlog is drained.  Use orb_copy_multi
+ * to drain several pending samples in one call.
+ *
+ * @param meta		The uORB metadata (usually from the ORB_ID() macro)
+ *			for the topic.
+ * @param data		A pointer to the initial data to be published.
+ * @param queue_size	Number of samples the topic retains (>= 1).
+ * @return		ERROR on error, otherwise returns a handle
+ *			that can be used to publish to the topic.
+ */
+extern orb_advert_t orb_advertise_queue(const struct orb_metadata *meta, const void *data,
+					unsigned queue_size) __EXPORT;
+
 
 /**
  * Publish new data to a topic.
@@ -270,6 +314,40 @@ extern int	orb_subscribe_multi(const struct orb_metadata *meta, unsigned instanc
  */
 extern int	orb_unsubscribe(int handle) __EXPORT;
 
+/**
+ * Subscribe to the best instance of a multi-instance topic.
+ *
+ * Selects the instance with the highest publisher priority that has
+ * published within the last half second, so consumers do not need
+ * per-sample priority comparison code across all instances.  Falls back
+ * to the lowest existing instance, or instance 0 if the topic has not
+ * been created yet.
+ *
+ * @param meta		The uORB metadata (usually from the ORB_ID() macro)
+ *			for the topic.
+ * @param instance	If non-NULL, set to the instance subscribed to;
+ *			pass the value to orb_resubscribe_best later.
+ * @return		ERROR on error, otherwise a subscription handle.
+ */
+extern int	orb_subscribe_best(const struct orb_metadata *meta, int *instance) __EXPORT;
+
+/**
+ * Re-evaluate the best instance for a subscription made with
+ * orb_subscribe_best and switch over if a higher-priority live
+ * publisher has appeared or the current one went silent.
+ *
+ * Intended to be called at a low rate (e.g. 1 Hz) from the consumer's
+ * main loop.
+ *
+ * @param meta		The uORB metadata (usually from the ORB_ID() macro)
+ *			for the topic.
+ * @param handle	The current subscription handle.
+ * @param instance	In/out: the currently subscribed instance.
+ * @return		The (possibly new) subscription handle; the old
+ *			handle is closed if a switch occurred.
+ */
+extern int	orb_resubscribe_best(const struct orb_metadata *meta, int handle, int *instance) __EXPORT;
+
 /**
  * Fetch data from a topic.
  *
@@ -288,6 +366,60 @@ extern int	orb_unsubscribe(int handle) __EXPORT;
  */
 extern int	orb_copy(const struct orb_metadata *meta, int handle, void *buffer) __EXPORT;
 
+/**
+ * Fetch up to max_samples pending samples from a topic in one call.
+ *
+ * For topics advertised with orb_advertise_queue this drains the
+ * subscriber's backlog in publication order; for classic topics it
+ * degenerates to a single orb_copy.  At least one sample is always
+ * copied, matching orb_copy semantics for a topic with no pending
+ * update.
+ *
+ * @param meta		The uORB metadata (usually from the ORB_ID() macro)
+ *			for the topic.
+ * @param handle	A handle returned from orb_subscribe.
+ * @param buffer	Pointer to a buffer large enough for max_samples
+ *			samples of the topic.
+ * @param max_samples	Maximum number of samples to copy.
+ * @return		The number of samples copied on success, ERROR
+ *			otherwise with errno set accordingly.
+ */
+extern int	orb_copy_multi(const struct orb_metadata *meta, int handle, void *buffer,
+			       unsigned max_samples) __EXPORT;
+
+/**
+ * Acquire a zero-copy read reference to the latest sample of a topic.
+ *
+ * Instead of copying the sample out of the topic node, this hands the
+ * subscriber a const pointer into the node's buffer, eliminating the
+ * second memcpy for large topics.  Only topics advertised with
+ * orb_advertise_lockfree or orb_advertise_queue (i.e. multi-buffered
+ * nodes) support this; classic single-buffer topics return -1 with
+ * errno set to ENOTSUP.
+ *
+ * The pointer stays valid until the publisher has published enough
+ * further samples to recycle the slot.  Call orb_release when done
+ * reading; it reports whether the data remained intact.
+ *
+ * @param meta		The uORB metadata (usually from the ORB_ID() macro)
+ *			for the topic.
+ * @param handle	A handle returned from orb_subscribe.
+ * @param data		Set to point at the latest sample.
+ * @return		OK on success, ERROR otherwise with errno set accordingly.
+ */
+extern int	orb_acquire(const struct orb_metadata *meta, int handle, const void **data) __EXPORT;
+
+/**
+ * Release a zero-copy read reference taken with orb_acquire.
+ *
+ * @param handle	A handle returned from orb_subscribe.
+ * @return		OK if the referenced data remained valid for the whole
+ *			read, ERROR with errno set to EAGAIN if the publisher
+ *			recycled the slot in the meantime and the caller must
+ *			discard what it read.
+ */
+extern int	orb_release(int handle) __EXPORT;
+
 /**
  * Check whether a topic has been published to since the last orb_copy.
  *
@@ -308,6 +440,65 @@ extern int	orb_copy(const struct orb_metadata *meta, int handle, void *buffer) _
  */
 extern int	orb_check(int handle, bool *updated) __EXPORT;
 
+/**
+ * Check a set of subscriptions for updates in one pass.
+ *
+ * Equivalent to calling orb_check on each handle, but saves the
+ * per-topic call overhead for loops that poll a dozen subscriptions per
+ * iteration.  Handles that are negative (failed subscriptions) are
+ * tolerated and report no update.
+ *
+ * @param handles	Array of handles returned from orb_subscribe.
+ * @param updated	Array receiving the per-handle update flag.
+ * @param count		Number of entries in both arrays.
+ * @return		OK if all checks were successful, ERROR otherwise
+ *			with errno set accordingly.
+ */
+extern int	orb_check_multi(const int *handles, bool *updated, unsigned count) __EXPORT;
+
+/**
+ * Copy all updated topics of a subscription set in one pass.
+ *
+ * Walks the handle array once with the scheduler locked, so the result
+ * is a coherent snapshot of the set: no publisher can slip a new sample
+ * into a topic between the first and the last copy.  The data of each
+ * updated topic is packed back-to-back into the caller's buffer in
+ * handle order; updated[] reports which entries were copied.  Handles
+ * that are negative (failed subscriptions) are tolerated and report no
+ * update.
+ *
+ * This exists for heavy subscribers like the logger, where checking and
+ * copying forty topics individually dominates the loop cost.
+ *
+ * @param metas		Array of topic metadata, one entry per handle.
+ * @param handles	Array of handles returned from orb_subscribe.
+ * @param count		Number of entries in the arrays.
+ * @param buffer	Buffer receiving the packed topic data.
+ * @param buffer_size	Size of the buffer in bytes.
+ * @param updated	Array receiving the per-handle update flag.
+ * @return		Number of topics copied on success, ERROR otherwise
+ *			with errno set accordingly; ENOSPC if the buffer
+ *			cannot hold all updated topics.
+ */
+extern int	orb_snapshot(const struct orb_metadata *const *metas, const int *handles,
+			unsigned count, void *buffer, size_t buffer_size, bool *updated) __EXPORT;
+
+/**
+ * Get the address of a topic's generation counter.
+ *
+ * The counter increments on every publication.  In-process subscribers
+ * can cache the address and compare the counter against the value they
+ * saw at their last copy, turning a no-change update check into a load
+ * and compare instead of an ioctl round trip.  Note that this bypasses
+ * the per-subscription update interval, so it should only be used on
+ * rate-unlimited subscriptions.
+ *
+ * @param handle	A handle returned from orb_subscribe.
+ * @param generation	Set to point at the node's generation counter.
+ * @return		OK on success, ERROR otherwise with errno set accordingly.
+ */
+extern int	orb_generation_location(int handle, const volatile unsigned **generation) __EXPORT;
+
 /**
  * Return the last time that the topic was updated.
  *
@@ -350,6 +541,32 @@ extern int	orb_priority(int handle, int *priority) __EXPORT;
  */
 extern int	orb_set_interval(int handle, unsigned interval) __EXPORT;
 
+/**
+ * Return the number of topics known to the system.
+ *
+ * Each ORB_DEFINE places an entry into a link-time topic table; this
+ * returns the number of entries.  Topic indices are stable for the
+ * lifetime of a firmware image and can be used to key per-topic state.
+ */
+extern unsigned	orb_topic_count(void) __EXPORT;
+
+/**
+ * Return the metadata for the topic with the given table index.
+ *
+ * @param index		Topic index, 0 .. orb_topic_count() - 1.
+ * @return		Topic metadata, or NULL if the index is out of range.
+ */
+extern const struct orb_metadata *orb_topic_get(unsigned index) __EXPORT;
+
+/**
+ * Return the table index for a topic.
+ *
+ * @param meta		The uORB metadata (usually from the ORB_ID() macro)
+ *			for the topic.
+ * @return		The topic index, or -1 if the topic is not in the table.
+ */
+extern int	orb_topic_index(const struct orb_metadata *meta) __EXPORT;
+
 __END_DECLS
 
 /* Diverse uORB header defines */ //XXX: move to better location
@@ -100,10 +100,11 @@ void UavcanEscController::update_outputs(float *outputs, unsigned num_outputs)
 	_prev_cmd_pub = timestamp;
 
 	/*
-	 * Fill the command message
+	 * Fill the command values
 	 * If unarmed, we publish an empty message anyway
 	 */
-	uavcan::equipment::esc::RawCommand msg;
+	int cmd[CONNECTED_ESC_MAX];
+	unsigned cmd_len = 0;
 
 	static const int cmd_max = uavcan::equipment::esc::RawCommand::FieldTypes::cmd::RawValueType::max();
 
@@ -124,22 +125,39 @@ void UavcanEscController::update_outputs(float *outputs, unsigned num_outputs)
 				scaled = cmd_max;
 				perf_count(_perfcnt_scaling_error);
 			}
-			
+
 			//fprintf(stderr, "[can] motor:%i\t\tval:%.8f\t\tscaled:%.8f\n", i, (double)outputs[i], (double)scaled);
 
-			msg.cmd.push_back(static_cast<int>(scaled));
+			cmd[i] = static_cast<int>(scaled);
 
-			_esc_status.esc[i].esc_setpoint_raw = abs(static_cast<int>(scaled));
+			_esc_status.esc[i].esc_setpoint_raw = abs(cmd[i]);
 		} else {
-			msg.cmd.push_back(static_cast<unsigned>(0));
+			cmd[i] = 0;
+		}
+
+		/*
+		 * An omitted trailing command is equivalent to a zero command,
+		 * so the message only carries values up to the last nonzero
+		 * one. This keeps the transfer at the minimum number of CAN
+		 * frames - a quad on an eight-channel mixer takes one frame
+		 * instead of two.
+		 */
+		if (cmd[i] != 0) {
+			cmd_len = i + 1;
 		}
 	}
 
 	/*
-	 * Publish the command message to the bus
-	 * Note that for a quadrotor it takes one CAN frame
+	 * Fill and publish the command message, reusing the preallocated
+	 * message storage
 	 */
-	(void)_uavcan_pub_raw_cmd.broadcast(msg);
+	_raw_cmd_msg.cmd.clear();
+
+	for (unsigned i = 0; i < cmd_len; i++) {
+		_raw_cmd_msg.cmd.push_back(cmd[i]);
+	}
+
+	(void)_uavcan_pub_raw_cmd.broadcast(_raw_cmd_msg);
 }
 
 void UavcanEscController::arm_all_escs(bool arm)
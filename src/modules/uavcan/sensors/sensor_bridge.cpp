@@ -37,16 +37,53 @@
 
 #include "sensor_bridge.hpp"
 #include <cassert>
+#include <cstring>
+#include <semaphore.h>
+
+#include <systemlib/err.h>
+#include <systemlib/systemlib.h>
+#include <systemlib/scheduling_priorities.h>
 
 #include "gnss.hpp"
 #include "mag.hpp"
 #include "baro.hpp"
 
+/*
+ * Measurement queue between the node thread and the publisher thread.
+ *
+ * The node thread decodes measurements inside spin(), which shares its
+ * deadline with actuator output; pushing the ORB publication work onto a
+ * lower-priority thread keeps bursts of bus traffic from stretching the
+ * actuator path. Single producer (node thread), single consumer
+ * (publisher thread): entries are filled before the head index moves, so
+ * no locking is needed.
+ */
+namespace
+{
+constexpr unsigned QUEUE_DEPTH		= 16;	// power of two
+constexpr size_t   QUEUE_REPORT_MAX	= 104;	// fits all bridged report structs
+
+struct QueueEntry {
+	UavcanCDevSensorBridgeBase *bridge;
+	int node_id;
+	uint8_t report[QUEUE_REPORT_MAX];
+};
+
+QueueEntry g_queue[QUEUE_DEPTH];
+volatile unsigned g_queue_head = 0;		///< written by the node thread only
+volatile unsigned g_queue_tail = 0;		///< written by the publisher thread only
+unsigned g_queue_overflows = 0;
+sem_t g_queue_sem;
+int g_publisher_task = -1;
+}
+
 /*
  * IUavcanSensorBridge
  */
 void IUavcanSensorBridge::make_all(uavcan::INode &node, List<IUavcanSensorBridge*> &list)
 {
+	UavcanCDevSensorBridgeBase::start_publisher();
+
 	list.add(new UavcanBarometerBridge(node));
 	list.add(new UavcanMagnetometerBridge(node));
 	list.add(new UavcanGnssBridge(node));
@@ -69,6 +106,70 @@ void UavcanCDevSensorBridgeBase::publish(const int node_id, const void *report)
 {
 	assert(report != nullptr);
 
+	const size_t size = _orb_topic->o_size;
+
+	// fall back to synchronous publication if the queue cannot take the report
+	if ((g_publisher_task < 0) || (size > QUEUE_REPORT_MAX)) {
+		publish_now(node_id, report);
+		return;
+	}
+
+	if ((g_queue_head - g_queue_tail) >= QUEUE_DEPTH) {
+		// the publisher thread is behind; the next measurement follows shortly
+		g_queue_overflows++;
+		return;
+	}
+
+	QueueEntry &entry = g_queue[g_queue_head % QUEUE_DEPTH];
+	entry.bridge = this;
+	entry.node_id = node_id;
+	std::memcpy(entry.report, report, size);
+
+	// the entry is complete before the consumer can see the new head
+	g_queue_head = g_queue_head + 1;
+
+	sem_post(&g_queue_sem);
+}
+
+int UavcanCDevSensorBridgeBase::publisher_task_main(int argc, char *argv[])
+{
+	for (;;) {
+		sem_wait(&g_queue_sem);
+
+		while (g_queue_tail != g_queue_head) {
+			QueueEntry &entry = g_queue[g_queue_tail % QUEUE_DEPTH];
+			entry.bridge->publish_now(entry.node_id, entry.report);
+			g_queue_tail = g_queue_tail + 1;
+		}
+	}
+
+	return 0;
+}
+
+void UavcanCDevSensorBridgeBase::start_publisher()
+{
+	if (g_publisher_task >= 0) {
+		return;
+	}
+
+	sem_init(&g_queue_sem, 0, 0);
+
+	g_publisher_task = task_spawn_cmd("uavcan_pub",
+					  SCHED_DEFAULT,
+					  SCHED_PRIORITY_SLOW_DRIVER,
+					  1500,
+					  static_cast<main_t>(&UavcanCDevSensorBridgeBase::publisher_task_main),
+					  nullptr);
+
+	if (g_publisher_task < 0) {
+		warnx("uavcan_pub start failed, publishing synchronously");
+	}
+}
+
+void UavcanCDevSensorBridgeBase::publish_now(const int node_id, const void *report)
+{
+	assert(report != nullptr);
+
 	Channel *channel = nullptr;
 
 	// Checking if such channel already exists
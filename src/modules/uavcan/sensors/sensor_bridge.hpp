@@ -117,13 +117,31 @@ protected:
 	}
 
 	/**
-	 * Sends one measurement into appropriate ORB topic.
+	 * Hands one measurement to the publisher thread.
+	 * The report is copied into a lock-free queue, so the caller - the
+	 * node thread inside spin() - never blocks on the ORB machinery.
 	 * New redundancy channels will be registered automatically.
 	 * @param node_id Sensor's Node ID
 	 * @param report  Pointer to ORB message object
 	 */
 	void publish(const int node_id, const void *report);
 
+	/**
+	 * Sends one measurement into the appropriate ORB topic immediately.
+	 * Runs on the publisher thread, or synchronously as a fallback.
+	 */
+	void publish_now(const int node_id, const void *report);
+
+	/**
+	 * Publisher thread entry point; drains the measurement queue.
+	 */
+	static int publisher_task_main(int argc, char *argv[]);
+
+	/**
+	 * Starts the shared publisher thread. Called once from make_all().
+	 */
+	static void start_publisher();
+
 public:
 	virtual ~UavcanCDevSensorBridgeBase();
 
@@ -296,6 +296,25 @@ void UavcanNode::node_spin_once()
 		warnx("node spin error %i", spin_res);
 	}
 	perf_end(_perfcnt_node_spin_elapsed);
+
+	/*
+	 * Pool pressure watermarks; exhaustion silently drops transfers
+	 * inside the library, so make it observable from the outside.
+	 */
+	const unsigned pool_used = _node.getAllocator().getNumUsedBlocks();
+
+	if (pool_used > _pool_peak_usage) {
+		_pool_peak_usage = pool_used;
+	}
+
+	if (_node.getAllocator().getNumFreeBlocks() == 0) {
+		perf_count(_perfcnt_pool_exhausted);
+
+		if (!_pool_warned) {
+			_pool_warned = true;
+			warnx("memory pool exhausted, increase UAVCAN_MEM_POOL_SIZE for this board");
+		}
+	}
 }
 
 /*
@@ -380,8 +399,6 @@ int UavcanNode::run()
 
 		(void)pthread_mutex_lock(&_node_mutex);
 
-		node_spin_once();  // Non-blocking
-
 		bool new_output = false;
 
 		// this would be bad...
@@ -467,6 +484,12 @@ int UavcanNode::run()
 			perf_end(_perfcnt_esc_mixer_output_elapsed);
 		}
 
+		/*
+		 * RX processing runs after actuator output: command frames go
+		 * straight to the CAN driver from broadcast(), so a burst of
+		 * sensor traffic cannot delay them here.
+		 */
+		node_spin_once();  // Non-blocking
 
 		// Check motor test state
 		bool updated = false;
@@ -655,6 +678,11 @@ UavcanNode::print_info()
 
 	(void)pthread_mutex_lock(&_node_mutex);
 
+	// Memory pool usage
+	printf("Pool blocks: used %u / peak %u / capacity %u\n",
+	       unsigned(_node.getAllocator().getNumUsedBlocks()), _pool_peak_usage,
+	       unsigned(MemPoolSize / uavcan::MemPoolBlockSize));
+
 	// ESC mixer status
 	printf("ESC actuators control groups: sub: %u / req: %u / fds: %u\n",
 	       (unsigned)_groups_subscribed, (unsigned)_groups_required, _poll_fds_num);
@@ -66,9 +66,18 @@
 /**
  * A UAVCAN node.
  */
+/*
+ * The libuavcan memory pool size can be overridden per board by defining
+ * UAVCAN_MEM_POOL_SIZE in the board configuration (EXTRADEFINES); vehicles
+ * with many nodes on the bus need more blocks in flight than the default.
+ */
+#ifndef UAVCAN_MEM_POOL_SIZE
+# define UAVCAN_MEM_POOL_SIZE	10752
+#endif
+
 class UavcanNode : public device::CDev
 {
-	static constexpr unsigned MemPoolSize        = 10752; ///< Refer to the libuavcan manual to learn why
+	static constexpr unsigned MemPoolSize        = UAVCAN_MEM_POOL_SIZE; ///< Refer to the libuavcan manual to learn why
 	static constexpr unsigned RxQueueLenPerIface = 64;
 	static constexpr unsigned StackSize          = 3000;
 
@@ -149,6 +158,10 @@ private:
 	// index into _poll_fds for each _control_subs handle
 	uint8_t			_poll_ids[NUM_ACTUATOR_CONTROL_GROUPS_UAVCAN];
 
+	unsigned		_pool_peak_usage = 0;		///< high watermark of used pool blocks
+	bool			_pool_warned = false;		///< pool pressure has been logged once
+
+	perf_counter_t _perfcnt_pool_exhausted           = perf_alloc(PC_COUNT, "uavcan_pool_exhausted");
 	perf_counter_t _perfcnt_node_spin_elapsed        = perf_alloc(PC_ELAPSED, "uavcan_node_spin_elapsed");
 	perf_counter_t _perfcnt_esc_mixer_output_elapsed = perf_alloc(PC_ELAPSED, "uavcan_esc_mixer_output_elapsed");
 	perf_counter_t _perfcnt_esc_mixer_total_elapsed  = perf_alloc(PC_ELAPSED, "uavcan_esc_mixer_total_elapsed");
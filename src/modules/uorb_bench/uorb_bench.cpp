@@ -0,0 +1,488 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file uorb_bench.cpp
+ *
+ * Load benchmark for the uORB messaging layer.
+ *
+ * Spawns a configurable set of publisher and subscriber tasks on a
+ * dedicated benchmark topic. Publishers advertise separate instances
+ * with a spread of ORB priorities and publish stamped samples at a
+ * fixed rate, or flat out when no rate is given. Subscribers poll,
+ * measure publish-to-copy latency and report the distribution along
+ * with received and dropped sample counts.
+ *
+ * Run this before and after any change to the uORB locking or node
+ * code; the 'uorb latency_test' command covers only the single
+ * publisher / single subscriber case.  The -l flag drives the
+ * lock-free publication mode with zero-copy subscriber reads, so the
+ * seqlock retry and lap detection paths are exercised under load.
+ */
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/err.h>
+#include <systemlib/systemlib.h>
+#include <uORB/uORB.h>
+
+extern "C" __EXPORT int uorb_bench_main(int argc, char *argv[]);
+
+namespace
+{
+
+/* all benchmark payloads start with the same stamped header */
+struct bench_small {
+	unsigned seq;
+	hrt_abstime time;
+};
+
+struct bench_medium {
+	unsigned seq;
+	hrt_abstime time;
+	char junk[64];
+};
+
+struct bench_large {
+	unsigned seq;
+	hrt_abstime time;
+	char junk[512];
+};
+
+ORB_DEFINE(uorb_bench_small, struct bench_small);
+ORB_DEFINE(uorb_bench_medium, struct bench_medium);
+ORB_DEFINE(uorb_bench_large, struct bench_large);
+
+/* latency histogram: 25 us buckets plus one overflow bucket */
+const unsigned bucket_width = 25;
+const unsigned bucket_count = 16;
+
+struct bench_config {
+	orb_id_t	topic;
+	unsigned	publishers;
+	unsigned	subscribers;
+	unsigned	rate;		/**< publish rate in Hz, 0 = unthrottled */
+	unsigned	samples;	/**< publishes per publisher */
+	const char	*logfile;	/**< raw latency log prefix, nullptr = off */
+	bool		lockfree;	/**< single lock-free publisher, zero-copy reads */
+};
+
+bench_config _config;
+
+/* index handover between the spawning shell task and the worker */
+volatile unsigned _task_index;
+volatile bool _task_index_taken;
+
+volatile unsigned _pubs_done;
+volatile unsigned _subs_done;
+
+/* publishers use a priority spread so arbitration is part of the load */
+const int _pub_priorities[ORB_MULTI_MAX_INSTANCES] = {
+	ORB_PRIO_MAX,
+	ORB_PRIO_DEFAULT,
+	ORB_PRIO_MIN
+};
+
+int
+publisher_main(void)
+{
+	unsigned index = _task_index;
+	_task_index_taken = true;
+
+	struct bench_large t;
+	memset(&t, 0, sizeof(t));
+
+	int instance = 0;
+	orb_advert_t handle;
+
+	if (_config.lockfree) {
+		handle = orb_advertise_lockfree(_config.topic, &t);
+
+	} else {
+		handle = orb_advertise_multi(_config.topic, &t, &instance, _pub_priorities[index]);
+	}
+
+	if (handle < 0) {
+		warnx("pub %u: advertise failed", index);
+		_pubs_done++;
+		return ERROR;
+	}
+
+	hrt_abstime start = hrt_absolute_time();
+
+	for (unsigned i = 0; i < _config.samples; i++) {
+		t.seq = i;
+		t.time = hrt_absolute_time();
+
+		if (OK != orb_publish(_config.topic, handle, &t)) {
+			warnx("pub %u: publish failed at %u", index, i);
+			break;
+		}
+
+		if (_config.rate > 0) {
+			usleep(1000000 / _config.rate);
+		}
+	}
+
+	hrt_abstime elapsed = hrt_elapsed_time(&start);
+
+	warnx("pub %u (inst %d, prio %3d): %u samples in %u us (%.1f Hz)",
+	      index, instance, _pub_priorities[index], _config.samples,
+	      (unsigned)elapsed, (double)(_config.samples * 1e6f / elapsed));
+
+	close(handle);
+
+	_pubs_done++;
+
+	return OK;
+}
+
+int
+subscriber_main(void)
+{
+	unsigned index = _task_index;
+	_task_index_taken = true;
+
+	/* spread subscribers across the advertised instances */
+	unsigned instance = index % _config.publishers;
+
+	int sub = orb_subscribe_multi(_config.topic, instance);
+
+	if (sub < 0) {
+		warnx("sub %u: subscribe failed", index);
+		_subs_done++;
+		return ERROR;
+	}
+
+	struct bench_large t;
+
+	/* clear the initial advertisement */
+	orb_copy(_config.topic, sub, &t);
+
+	unsigned received = 0;
+	unsigned dropped = 0;
+	unsigned lapped = 0;
+	unsigned last_seq = 0;
+	unsigned lat_min = 0;
+	unsigned lat_max = 0;
+	uint64_t lat_sum = 0;
+	unsigned histogram[bucket_count + 1];
+	memset(histogram, 0, sizeof(histogram));
+
+	unsigned *timings = nullptr;
+
+	if (_config.logfile != nullptr) {
+		timings = new unsigned[_config.samples];
+	}
+
+	struct pollfd fds[1];
+	fds[0].fd = sub;
+	fds[0].events = POLLIN;
+
+	while (true) {
+		int pret = poll(&fds[0], 1, 500);
+
+		if (pret < 0) {
+			warn("sub %u: poll error", index);
+			continue;
+		}
+
+		if (pret == 0) {
+			/* no data for 500 ms; stop once all publishers are done */
+			if (_pubs_done >= _config.publishers) {
+				break;
+			}
+
+			continue;
+		}
+
+		if (_config.lockfree) {
+			/* zero-copy read of the stamped header; a failed release
+			 * means the publisher lapped us mid-read and we must
+			 * re-acquire */
+			const struct bench_small *ref;
+			bool valid = false;
+
+			while (orb_acquire(_config.topic, sub, (const void **)&ref) == OK) {
+				t.seq = ref->seq;
+				t.time = ref->time;
+
+				if (orb_release(sub) == OK) {
+					valid = true;
+					break;
+				}
+
+				lapped++;
+			}
+
+			if (!valid) {
+				orb_copy(_config.topic, sub, &t);
+			}
+
+		} else {
+			orb_copy(_config.topic, sub, &t);
+		}
+
+		unsigned lat = (unsigned)hrt_elapsed_time(&t.time);
+
+		if ((received == 0) || (lat < lat_min)) {
+			lat_min = lat;
+		}
+
+		if (lat > lat_max) {
+			lat_max = lat;
+		}
+
+		lat_sum += lat;
+
+		unsigned bucket = lat / bucket_width;
+
+		if (bucket > bucket_count) {
+			bucket = bucket_count;
+		}
+
+		histogram[bucket]++;
+
+		if ((received > 0) && (t.seq > last_seq + 1)) {
+			dropped += t.seq - last_seq - 1;
+		}
+
+		last_seq = t.seq;
+
+		if ((timings != nullptr) && (received < _config.samples)) {
+			timings[received] = lat;
+		}
+
+		received++;
+	}
+
+	orb_unsubscribe(sub);
+
+	if (received > 0) {
+		warnx("sub %u (inst %u): %u received, %u dropped, latency %u/%u/%u us (min/mean/max)",
+		      index, instance, received, dropped,
+		      lat_min, (unsigned)(lat_sum / received), lat_max);
+
+		if (_config.lockfree) {
+			warnx("sub %u:   %u reads lapped by the publisher", index, lapped);
+		}
+
+		for (unsigned i = 0; i <= bucket_count; i++) {
+			if (histogram[i] == 0) {
+				continue;
+			}
+
+			if (i < bucket_count) {
+				warnx("sub %u:   %3u-%3u us: %u", index,
+				      i * bucket_width, (i + 1) * bucket_width, histogram[i]);
+
+			} else {
+				warnx("sub %u:   >%u us: %u", index,
+				      bucket_count * bucket_width, histogram[i]);
+			}
+		}
+
+	} else {
+		warnx("sub %u (inst %u): no samples received", index, instance);
+	}
+
+	if (timings != nullptr) {
+		char fname[48];
+		snprintf(fname, sizeof(fname), "%s_sub%u.txt", _config.logfile, index);
+		FILE *f = fopen(fname, "w");
+
+		if (f != nullptr) {
+			unsigned stored = (received < _config.samples) ? received : _config.samples;
+
+			for (unsigned i = 0; i < stored; i++) {
+				fprintf(f, "%u\n", timings[i]);
+			}
+
+			fclose(f);
+
+		} else {
+			warnx("sub %u: failed opening %s", index, fname);
+		}
+
+		delete[] timings;
+	}
+
+	_subs_done++;
+
+	return OK;
+}
+
+int
+spawn(const char *name, main_t entry, unsigned index)
+{
+	_task_index = index;
+	_task_index_taken = false;
+
+	int task = task_spawn_cmd(name,
+				  SCHED_DEFAULT,
+				  SCHED_PRIORITY_MAX - 5,
+				  1800,
+				  entry,
+				  nullptr);
+
+	if (task < 0) {
+		return ERROR;
+	}
+
+	/* wait for the worker to latch its index before reusing the slot */
+	while (!_task_index_taken) {
+		usleep(1000);
+	}
+
+	return OK;
+}
+
+void
+usage(void)
+{
+	errx(1, "usage: uorb_bench [-p publishers] [-s subscribers] [-r rate_hz (0 = unthrottled)]\n"
+	     "                  [-n samples] [-t small|medium|large] [-f logfile_prefix]\n"
+	     "                  [-l (lock-free: one publisher, zero-copy subscriber reads)]");
+}
+
+} // namespace
+
+int
+uorb_bench_main(int argc, char *argv[])
+{
+	_config.topic = ORB_ID(uorb_bench_small);
+	_config.publishers = 1;
+	_config.subscribers = 1;
+	_config.rate = 1000;
+	_config.samples = 1000;
+	_config.logfile = nullptr;
+	_config.lockfree = false;
+
+	unsigned topic_size = sizeof(struct bench_small);
+
+	int ch;
+
+	while ((ch = getopt(argc, argv, "p:s:r:n:t:f:l")) != EOF) {
+		switch (ch) {
+		case 'p':
+			_config.publishers = strtoul(optarg, NULL, 0);
+			break;
+
+		case 's':
+			_config.subscribers = strtoul(optarg, NULL, 0);
+			break;
+
+		case 'r':
+			_config.rate = strtoul(optarg, NULL, 0);
+			break;
+
+		case 'n':
+			_config.samples = strtoul(optarg, NULL, 0);
+			break;
+
+		case 't':
+			if (!strcmp(optarg, "small")) {
+				_config.topic = ORB_ID(uorb_bench_small);
+				topic_size = sizeof(struct bench_small);
+
+			} else if (!strcmp(optarg, "medium")) {
+				_config.topic = ORB_ID(uorb_bench_medium);
+				topic_size = sizeof(struct bench_medium);
+
+			} else if (!strcmp(optarg, "large")) {
+				_config.topic = ORB_ID(uorb_bench_large);
+				topic_size = sizeof(struct bench_large);
+
+			} else {
+				usage();
+			}
+
+			break;
+
+		case 'f':
+			_config.logfile = optarg;
+			break;
+
+		case 'l':
+			_config.lockfree = true;
+			break;
+
+		default:
+			usage();
+		}
+	}
+
+	if ((_config.publishers < 1) || (_config.publishers > ORB_MULTI_MAX_INSTANCES) ||
+	    (_config.subscribers < 1) || (_config.samples < 1)) {
+		usage();
+	}
+
+	/* lock-free publication is strictly single producer */
+	if (_config.lockfree && (_config.publishers > 1)) {
+		usage();
+	}
+
+	warnx("%u publisher(s), %u subscriber(s), %u byte topic, %u samples each, %u Hz",
+	      _config.publishers, _config.subscribers, topic_size, _config.samples, _config.rate);
+
+	_pubs_done = 0;
+	_subs_done = 0;
+
+	/* subscribers first so no samples are missed at the start */
+	for (unsigned i = 0; i < _config.subscribers; i++) {
+		if (OK != spawn("uorb_bench_sub", (main_t)&subscriber_main, i)) {
+			errx(1, "failed spawning subscriber %u", i);
+		}
+	}
+
+	for (unsigned i = 0; i < _config.publishers; i++) {
+		if (OK != spawn("uorb_bench_pub", (main_t)&publisher_main, i)) {
+			errx(1, "failed spawning publisher %u", i);
+		}
+	}
+
+	while (_subs_done < _config.subscribers) {
+		usleep(100000);
+	}
+
+	warnx("done");
+
+	return OK;
+}
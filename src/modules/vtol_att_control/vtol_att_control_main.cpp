@@ -177,6 +177,13 @@ private:
 	unsigned _motor_count;	// number of motors
 	float _airspeed_tot;
 	float _tilt_control;
+
+	float _airspeed_scaling;		// cached mc pitch scaling factor, refreshed at the slow poll rate
+	hrt_abstime _slow_poll_time;	// time the slowly changing inputs were last refreshed
+
+	/* interval for refreshing the slowly changing inputs while the vehicle stays in one mode (20Hz);
+	 * a flip of the mode switch refreshes them immediately */
+	static const hrt_abstime SLOW_POLL_INTERVAL = 50000;
 //*****************Member functions***********************************************************************
 
 	void 		task_main();	//main task
@@ -200,7 +207,7 @@ private:
 	void 		fill_fw_att_rates_sp();
 	void 		set_idle_fw();
 	void 		set_idle_mc();
-	void 		scale_mc_output();
+	void 		update_mc_output_scaling();		// refresh cached mc pitch scaling from airspeed and power draw
 	void 		calc_tot_airspeed();			// estimated airspeed seen by elevons
 };
 
@@ -242,6 +249,8 @@ VtolAttitudeControl::VtolAttitudeControl() :
 	flag_idle_mc = true;
 	_airspeed_tot = 0.0f;
 	_tilt_control = 0.0f;
+	_airspeed_scaling = 1.0f;
+	_slow_poll_time = 0;
 
 	memset(& _vtol_vehicle_status, 0, sizeof(_vtol_vehicle_status));
 	_vtol_vehicle_status.vtol_in_rw_mode = true;	/* start vtol in rotary wing mode*/
@@ -623,7 +632,7 @@ void VtolAttitudeControl::set_idle_mc()
 }
 
 void
-VtolAttitudeControl::scale_mc_output() {
+VtolAttitudeControl::update_mc_output_scaling() {
 	// scale around tuning airspeed
 	float airspeed;
 	calc_tot_airspeed();	// estimate air velocity seen by elevons
@@ -647,8 +656,7 @@ VtolAttitudeControl::scale_mc_output() {
 	 *
 	 * Forcing the scaling to this value allows reasonable handheld tests.
 	 */
-	float airspeed_scaling = _params.mc_airspeed_trim / ((airspeed < _params.mc_airspeed_min) ? _params.mc_airspeed_min : airspeed);
-	_actuators_mc_in.control[1] = math::constrain(_actuators_mc_in.control[1]*airspeed_scaling*airspeed_scaling,-1.0f,1.0f);
+	_airspeed_scaling = _params.mc_airspeed_trim / ((airspeed < _params.mc_airspeed_min) ? _params.mc_airspeed_min : airspeed);
 }
 
 void VtolAttitudeControl::calc_tot_airspeed() {
@@ -750,19 +758,34 @@ void VtolAttitudeControl::task_main()
 			parameters_update();
 		}
 
-		_vtol_vehicle_status.fw_permanent_stab = _params.vtol_fw_permanent_stab == 1 ? true : false;
-
-		vehicle_control_mode_poll();	//Check for changes in vehicle control mode.
 		vehicle_manual_poll();			//Check for changes in manual inputs.
-		arming_status_poll();			//Check for arming status updates.
 		actuator_controls_mc_poll();	//Check for changes in mc_attitude_control output
 		actuator_controls_fw_poll();	//Check for changes in fw_attitude_control output
 		vehicle_rates_sp_mc_poll();
 		vehicle_rates_sp_fw_poll();
-		parameters_update_poll();
-		vehicle_local_pos_poll();			// Check for new sensor values
-		vehicle_airspeed_poll();
-		vehicle_battery_poll();
+
+		/* steady-state fast path: while the vehicle stays in one mode only the actuator
+		 * forwarding above runs every cycle; the slowly changing inputs and the airspeed
+		 * scaling are refreshed at SLOW_POLL_INTERVAL, or immediately on a mode change */
+		bool in_mc_mode = _manual_control_sp.aux1 < 0.0f;
+
+		if ((in_mc_mode != _vtol_vehicle_status.vtol_in_rw_mode) ||
+		    (hrt_elapsed_time(&_slow_poll_time) > SLOW_POLL_INTERVAL)) {
+			_slow_poll_time = hrt_absolute_time();
+
+			_vtol_vehicle_status.fw_permanent_stab = _params.vtol_fw_permanent_stab == 1 ? true : false;
+
+			vehicle_control_mode_poll();	//Check for changes in vehicle control mode.
+			arming_status_poll();			//Check for arming status updates.
+			parameters_update_poll();
+			vehicle_local_pos_poll();			// Check for new sensor values
+			vehicle_airspeed_poll();
+			vehicle_battery_poll();
+
+			if (in_mc_mode) {
+				update_mc_output_scaling();	// estimate air velocity seen by elevons
+			}
+		}
 
 
 		if (_manual_control_sp.aux1 < 0.0f) {		/* vehicle is in mc mode */
@@ -778,8 +801,9 @@ void VtolAttitudeControl::task_main()
 				vehicle_manual_poll();	/* update remote input */
 				orb_copy(ORB_ID(actuator_controls_virtual_mc), _actuator_inputs_mc, &_actuators_mc_in);
 
-				// scale pitch control with total airspeed
-				scale_mc_output();
+				// scale pitch control with the cached airspeed scaling
+				_actuators_mc_in.control[1] = math::constrain(_actuators_mc_in.control[1] * _airspeed_scaling * _airspeed_scaling,
+							      -1.0f, 1.0f);
 
 				fill_mc_att_control_output();
 				fill_mc_att_rates_sp();
@@ -133,19 +133,17 @@ public:
 	PublisherUORB() :
 		Publisher<T>(),
 		PublisherNode(),
-		_uorb_pub(new uORB::PublicationBase(T::handle()))
+		_uorb_pub(T::handle())
 	{}
 
-	~PublisherUORB() {
-		delete _uorb_pub;
-	};
+	~PublisherUORB() {};
 
 	/** Publishes msg
 	 * @param msg	    the message which is published to the topic
 	 */
 	int publish(const T &msg)
 	{
-		_uorb_pub->update((void *)&(msg.data()));
+		_uorb_pub.update((void *)&(msg.data()));
 		return 0;
 	}
 
@@ -154,7 +152,8 @@ public:
 	 */
 	void update() {} ;
 private:
-	uORB::PublicationBase * _uorb_pub;	/**< Handle to the publisher */
+	/* held by value: one heap object and one pointer chase less per publish */
+	uORB::PublicationBase _uorb_pub;	/**< The publication */
 
 };
 #endif
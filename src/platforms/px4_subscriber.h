@@ -83,13 +83,16 @@ public:
 	/* Accessors*/
 	/**
 	 * Get the last message value
+	 *
+	 * Non-virtual: the backends all store the current message here, so
+	 * the per-field accesses in the control loops dispatch statically.
 	 */
-	virtual T& get() {return _msg_current;}
+	T& get() {return _msg_current;}
 
 	/**
 	 * Get the last native message value
 	 */
-	virtual decltype(((T*)nullptr)->data()) data()
+	decltype(((T*)nullptr)->data()) data()
 	{
 		return _msg_current.data();
 	}
@@ -192,12 +195,10 @@ public:
 	 */
 	SubscriberUORB(unsigned interval) :
 		SubscriberNode(interval),
-		_uorb_sub(new uORB::SubscriptionBase(T::handle(), interval))
+		_uorb_sub(T::handle(), interval)
 	{}
 
-	virtual ~SubscriberUORB() {
-		delete _uorb_sub;
-	};
+	virtual ~SubscriberUORB() {};
 
 	/**
 	 * Update Subscription
@@ -205,23 +206,24 @@ public:
 	 */
 	virtual void update()
 	{
-		if (!_uorb_sub->updated()) {
+		if (!_uorb_sub.updated()) {
 			/* Topic not updated, do not call callback */
 			return;
 		}
 
-		_uorb_sub->update(get_void_ptr());
+		_uorb_sub.update(get_void_ptr());
 	};
 
 	/* Accessors*/
-	int getUORBHandle() { return _uorb_sub->getHandle(); }
+	int getUORBHandle() { return _uorb_sub.getHandle(); }
 
 protected:
-	uORB::SubscriptionBase * _uorb_sub;	/**< Handle to the subscription */
+	/* held by value: one heap object and one pointer chase less per access */
+	uORB::SubscriptionBase _uorb_sub;	/**< The subscription */
 
 	typename std::remove_reference<decltype(((T*)nullptr)->data())>::type getUORBData()
 	{
-		return (typename std::remove_reference<decltype(((T*)nullptr)->data())>::type)*_uorb_sub;
+		return (typename std::remove_reference<decltype(((T*)nullptr)->data())>::type)_uorb_sub;
 	}
 
 	/**
@@ -257,13 +259,13 @@ public:
 	 */
 	virtual void update()
 	{
-		if (!this->_uorb_sub->updated()) {
+		if (!this->_uorb_sub.updated()) {
 			/* Topic not updated, do not call callback */
 			return;
 		}
 
 		/* get latest data */
-		this->_uorb_sub->update(this->get_void_ptr());
+		this->_uorb_sub.update(this->get_void_ptr());
 
 
 		/* Check if there is a callback */
@@ -60,6 +60,16 @@ void perf_free(perf_counter_t handle)
 
 }
 
+/**
+ * Use the CPU cycle counter as the time source for an elapsed counter.
+ *
+ * @param handle		The handle returned from perf_alloc.
+ */
+void		perf_use_cycle_counter(perf_counter_t handle)
+{
+
+}
+
 /**
  * Count a performance event.
  *
@@ -0,0 +1,303 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file bench.cpp
+ *
+ * Microbenchmarks for the hot math and estimator kernels.
+ *
+ * Each kernel is timed with a cycle-counter backed PC_ELAPSED counter and
+ * reported with the usual perf statistics: event count, total, min, max
+ * and mean per operation. On targets with a DWT cycle counter the numbers
+ * are CPU cycles; elsewhere they fall back to hrt microseconds, so the
+ * command is also usable off-target.
+ *
+ * Run this before and after touching any of the benchmarked code paths.
+ */
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/err.h>
+#include <systemlib/perf_counter.h>
+#include <systemlib/mixer/mixer.h>
+#include <mathlib/mathlib.h>
+#include <mathlib/math/filter/LowPassFilter2p.hpp>
+#include <ekf_att_pos_estimator/estimator_22states.h>
+
+extern "C" __EXPORT int bench_main(int argc, char *argv[]);
+
+namespace
+{
+
+/* iterations per kernel; enough for stable statistics while keeping the
+ * command quick on target */
+const unsigned bench_iterations = 256;
+
+/* sink for results so the compiler cannot discard the benchmarked work */
+volatile float bench_sink;
+
+perf_counter_t
+bench_alloc(const char *name)
+{
+	perf_counter_t p = perf_alloc(PC_ELAPSED, name);
+
+	/* cycle-accurate where a DWT cycle counter exists, hrt microseconds elsewhere */
+	perf_use_cycle_counter(p);
+
+	return p;
+}
+
+void
+bench_report(perf_counter_t p)
+{
+	perf_print_counter(p);
+	perf_free(p);
+}
+
+void
+bench_vector(void)
+{
+	math::Vector<3> a(1.0f, 2.0f, 3.0f);
+	math::Vector<3> b(4.0f, 5.0f, 6.0f);
+
+	perf_counter_t p = bench_alloc("bench_vector3_dot");
+
+	for (unsigned i = 0; i < bench_iterations; i++) {
+		perf_begin(p);
+		float d = a * b;
+		perf_end(p);
+
+		/* keep the inputs changing so nothing is hoisted out of the loop */
+		bench_sink = d;
+		a(0) += 0.001f;
+	}
+
+	bench_report(p);
+
+	p = bench_alloc("bench_vector3_cross");
+
+	for (unsigned i = 0; i < bench_iterations; i++) {
+		perf_begin(p);
+		math::Vector<3> c = a % b;
+		perf_end(p);
+
+		bench_sink = c(0);
+		b(1) += 0.001f;
+	}
+
+	bench_report(p);
+}
+
+void
+bench_matrix(void)
+{
+	math::Matrix<3, 3> m;
+	m.identity();
+	math::Matrix<3, 3> n;
+	n.identity();
+	math::Vector<3> v(1.0f, 2.0f, 3.0f);
+
+	perf_counter_t p = bench_alloc("bench_matrix3_mul");
+
+	for (unsigned i = 0; i < bench_iterations; i++) {
+		perf_begin(p);
+		math::Matrix<3, 3> r = m * n;
+		perf_end(p);
+
+		bench_sink = r(0, 0);
+		m(0, 1) += 0.001f;
+	}
+
+	bench_report(p);
+
+	p = bench_alloc("bench_matrix3_vector3");
+
+	for (unsigned i = 0; i < bench_iterations; i++) {
+		perf_begin(p);
+		math::Vector<3> r = m * v;
+		perf_end(p);
+
+		bench_sink = r(0);
+		v(2) += 0.001f;
+	}
+
+	bench_report(p);
+}
+
+void
+bench_quaternion(void)
+{
+	math::Quaternion q;
+	q.from_euler(0.1f, 0.2f, 0.3f);
+	math::Quaternion r;
+	r.from_euler(0.2f, 0.1f, 0.0f);
+
+	perf_counter_t p = bench_alloc("bench_quat_mul");
+
+	for (unsigned i = 0; i < bench_iterations; i++) {
+		perf_begin(p);
+		math::Quaternion s = q * r;
+		perf_end(p);
+
+		bench_sink = s(0);
+		q(1) += 0.001f;
+	}
+
+	bench_report(p);
+
+	p = bench_alloc("bench_quat_to_dcm");
+
+	for (unsigned i = 0; i < bench_iterations; i++) {
+		perf_begin(p);
+		math::Matrix<3, 3> d = q.to_dcm();
+		perf_end(p);
+
+		bench_sink = d(2, 2);
+		q(2) += 0.001f;
+	}
+
+	bench_report(p);
+}
+
+void
+bench_filter(void)
+{
+	math::LowPassFilter2p filter(250.0f, 30.0f);
+	float in = 0.0f;
+
+	perf_counter_t p = bench_alloc("bench_lowpass2p");
+
+	for (unsigned i = 0; i < bench_iterations; i++) {
+		perf_begin(p);
+		float out = filter.apply(in);
+		perf_end(p);
+
+		bench_sink = out;
+		in += 0.1f;
+	}
+
+	bench_report(p);
+}
+
+int
+bench_mixer_callback(uintptr_t handle, uint8_t control_group, uint8_t control_index, float &control)
+{
+	control = 0.1f * control_index;
+	return 0;
+}
+
+void
+bench_mixer(void)
+{
+	const char *def = "R: 4x 10000 10000 10000 0\n";
+	unsigned buflen = strlen(def);
+
+	MultirotorMixer *mixer = MultirotorMixer::from_text(bench_mixer_callback, 0, def, buflen);
+
+	if (mixer == nullptr) {
+		warnx("mixer create failed");
+		return;
+	}
+
+	float outputs[8];
+	perf_counter_t p = bench_alloc("bench_mixer_quad_x");
+
+	for (unsigned i = 0; i < bench_iterations; i++) {
+		perf_begin(p);
+		unsigned mixed = mixer->mix(outputs, 8, nullptr);
+		perf_end(p);
+
+		bench_sink = outputs[0] + mixed;
+	}
+
+	bench_report(p);
+
+	delete mixer;
+}
+
+void
+bench_ekf(void)
+{
+	/* the filter state is far too large for the command stack */
+	AttPosEKF *ekf = new AttPosEKF();
+
+	if (ekf == nullptr) {
+		warnx("ekf alloc failed");
+		return;
+	}
+
+	/* representative inertial deltas at a 100 Hz covariance rate */
+	ekf->dtIMU = 0.01f;
+	ekf->dAngIMU.x = 0.001f;
+	ekf->dAngIMU.y = 0.002f;
+	ekf->dAngIMU.z = 0.001f;
+	ekf->dVelIMU.x = 0.01f;
+	ekf->dVelIMU.y = 0.01f;
+	ekf->dVelIMU.z = -0.098f;
+
+	perf_counter_t p = bench_alloc("bench_ekf_cov_predict");
+
+	/* by far the heaviest kernel, fewer iterations suffice */
+	for (unsigned i = 0; i < bench_iterations / 4; i++) {
+		perf_begin(p);
+		ekf->CovariancePrediction(0.01f);
+		perf_end(p);
+	}
+
+	bench_report(p);
+
+	delete ekf;
+}
+
+} // namespace
+
+int
+bench_main(int argc, char *argv[])
+{
+	warnx("%u iterations per kernel", bench_iterations);
+	warnx("times are CPU cycles where a DWT cycle counter is available, microseconds otherwise");
+
+	bench_vector();
+	bench_matrix();
+	bench_quaternion();
+	bench_filter();
+	bench_mixer();
+	bench_ekf();
+
+	return 0;
+}
@@ -46,8 +46,14 @@
 #include <stdlib.h>
 #include <fcntl.h>
 #include <termios.h>
+#include <sys/stat.h>
 
 #include <systemlib/err.h>
+#include <systemlib/file_stream.h>
+
+/* streaming in large sector-aligned chunks keeps the SD card reads off
+ * the dump loop's critical path */
+#define DUMP_BUFFER_SIZE	4096
 
 __EXPORT int dumpfile_main(int argc, char *argv[]);
 
@@ -59,18 +65,25 @@ dumpfile_main(int argc, char *argv[])
 	}
 
 	/* open input file */
-	FILE *f;
-	f = fopen(argv[1], "r");
+	int fd = open(argv[1], O_RDONLY);
 
-	if (f == NULL) {
+	if (fd < 0) {
 		printf("ERROR\n");
 		exit(1);
 	}
 
 	/* get file size */
-	fseek(f, 0L, SEEK_END);
-	int size = ftell(f);
-	fseek(f, 0L, SEEK_SET);
+	struct stat st;
+
+	struct file_stream_s stream;
+
+	if ((fstat(fd, &st) != 0) || (file_stream_init(&stream, fd, DUMP_BUFFER_SIZE) != 0)) {
+		close(fd);
+		printf("ERROR\n");
+		exit(1);
+	}
+
+	int size = st.st_size;
 
 	printf("OK %d\n", size);
 
@@ -92,19 +105,23 @@ dumpfile_main(int argc, char *argv[])
 		exit(1);
 	}
 
-	char buf[512];
-	int nread;
+	const uint8_t *data;
+	ssize_t nread;
+	off_t offset = 0;
 
-	/* dump file */
-	while ((nread = fread(buf, 1, sizeof(buf), f)) > 0) {
-		if (write(out, buf, nread) <= 0) {
+	/* dump file, writing straight from the readahead buffer */
+	while ((nread = file_stream_peek(&stream, offset, &data)) > 0) {
+		if (write(out, data, nread) <= 0) {
 			warnx("error dumping file");
 			break;
 		}
+
+		offset += nread;
 	}
 
 	fsync(out);
-	fclose(f);
+	file_stream_free(&stream);
+	close(fd);
 
 	/* restore old terminal attributes */
 	if (tcsetattr(out, TCSANOW, &tc_old) < 0) {
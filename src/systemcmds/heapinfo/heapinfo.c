@@ -0,0 +1,187 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file heapinfo.c
+ *
+ * Heap fragmentation and high-watermark monitor. Prints a snapshot of
+ * the NuttX heap and the registered driver object pools; 'heapinfo
+ * start' runs a low-rate background monitor that publishes the
+ * heap_status topic so long-mission RAM behavior ends up in the log.
+ */
+
+#include <nuttx/config.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <malloc.h>
+
+#include <systemlib/systemlib.h>
+#include <systemlib/err.h>
+#include <systemlib/obj_pool.h>
+#include <drivers/drv_hrt.h>
+
+#include <uORB/uORB.h>
+#include <uORB/topics/heap_status.h>
+
+/** monitor interval in microseconds */
+#define HEAPINFO_INTERVAL	10000000ULL
+
+static volatile bool thread_should_exit = false;
+static volatile bool thread_running = false;
+static int monitor_task = -1;
+
+/** smallest free heap seen since the monitor started */
+static uint32_t min_free;
+
+__EXPORT int heapinfo_main(int argc, char *argv[]);
+
+static void
+heap_snapshot(struct heap_status_s *status)
+{
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	struct mallinfo info = mallinfo();
+#else
+	struct mallinfo info;
+	(void)mallinfo(&info);
+#endif
+
+	status->timestamp = hrt_absolute_time();
+	status->total_size = info.arena;
+	status->used_size = info.uordblks;
+	status->free_size = info.fordblks;
+	status->largest_free_block = info.mxordblk;
+	status->free_block_count = info.ordblks;
+
+	if (min_free == 0 || status->free_size < min_free) {
+		min_free = status->free_size;
+	}
+
+	status->min_free = min_free;
+}
+
+static void
+print_status(void)
+{
+	struct heap_status_s status;
+
+	heap_snapshot(&status);
+
+	printf("heap:  %u total, %u used, %u free (min %u)\n",
+	       status.total_size, status.used_size, status.free_size, status.min_free);
+	printf("frag:  largest free block %u, %u free blocks\n",
+	       status.largest_free_block, status.free_block_count);
+
+	struct obj_pool_s *pool = obj_pool_next(NULL);
+
+	while (pool != NULL) {
+		printf("pool:  %-16s %u/%u blocks of %u bytes used (peak %u)\n",
+		       pool->name, pool->used, pool->nblocks,
+		       pool->block_size, pool->peak);
+		pool = obj_pool_next(pool);
+	}
+}
+
+static int
+heapinfo_thread_main(int argc, char *argv[])
+{
+	struct heap_status_s status;
+	orb_advert_t status_pub = -1;
+
+	thread_running = true;
+
+	while (!thread_should_exit) {
+		heap_snapshot(&status);
+
+		if (status_pub > 0) {
+			orb_publish(ORB_ID(heap_status), status_pub, &status);
+
+		} else {
+			status_pub = orb_advertise(ORB_ID(heap_status), &status);
+		}
+
+		usleep(HEAPINFO_INTERVAL);
+	}
+
+	thread_running = false;
+	return 0;
+}
+
+static void
+usage(void)
+{
+	errx(1, "usage: heapinfo [start|stop]");
+}
+
+int
+heapinfo_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		print_status();
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "start")) {
+		if (thread_running) {
+			errx(1, "already running");
+		}
+
+		thread_should_exit = false;
+		monitor_task = task_spawn_cmd("heapinfo",
+					      SCHED_DEFAULT,
+					      SCHED_PRIORITY_DEFAULT - 10,
+					      1100,
+					      heapinfo_thread_main,
+					      NULL);
+
+		if (monitor_task < 0) {
+			err(1, "task start failed");
+		}
+
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "stop")) {
+		if (!thread_running) {
+			errx(1, "not running");
+		}
+
+		thread_should_exit = true;
+		return 0;
+	}
+
+	usage();
+	return 1;
+}
@@ -102,6 +102,19 @@ load(const char *devname, const char *fname)
 	if (ioctl(dev, MIXERIOCRESET, 0))
 		err(1, "can't reset mixers on %s", devname);
 
+	/* prefer the precompiled binary image if the build generated one -
+	 * it is loaded without any parsing; devices that forward mixer text
+	 * to a coprocessor reject it and we fall back to the text file */
+	int blen = load_mixer_binary(fname, (uint8_t *)&buf[0], sizeof(buf));
+
+	if (blen > 0) {
+		struct mixer_binary_buf_s bbuf = { (const uint8_t *)&buf[0], (unsigned)blen };
+
+		if (ioctl(dev, MIXERIOCLOADBUFBIN, (unsigned long)&bbuf) == 0) {
+			exit(0);
+		}
+	}
+
 	if (load_mixer_file(fname, &buf[0], sizeof(buf)) < 0)
 		err(1, "can't load mixer: %s", fname);
 
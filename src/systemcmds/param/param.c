@@ -117,6 +117,22 @@ param_main(int argc, char *argv[])
 			exit(0);
 		}
 
+		if (!strcmp(argv[1], "bank")) {
+			if (argc >= 3) {
+				if (param_set_raw_bank(argv[2]) != 0) {
+					errx(1, "selecting parameter bank %s failed", argv[2]);
+				}
+
+				warnx("selected raw parameter bank %s", argv[2]);
+
+			} else {
+				param_set_raw_bank(NULL);
+				warnx("reverted to file parameter storage");
+			}
+
+			exit(0);
+		}
+
 		if (!strcmp(argv[1], "show")) {
 			if (argc >= 3) {
 				do_show(argv[2]);
@@ -170,7 +186,7 @@ param_main(int argc, char *argv[])
 		}
 	}
 
-	errx(1, "expected a command, try 'load', 'import', 'show', 'set', 'compare', 'select' or 'save'");
+	errx(1, "expected a command, try 'load', 'import', 'show', 'set', 'compare', 'select', 'bank' or 'save'");
 }
 
 static void
@@ -85,6 +85,8 @@ usage(const char *reason)
 	     "\t[-a]\t\t\tConfigure all outputs\n"
 	     "\t-r <alt_rate>\t\tPWM rate (50 to 400 Hz)\n"
 	     "\n"
+	     "oneshot [off]\t\t\tOneShot125 pulse per control update (or back to PWM)\n"
+	     "\n"
 	     "failsafe ...\t\t\tFailsafe PWM\n"
 	     "disarmed ...\t\t\tDisarmed PWM\n"
 	     "min ...\t\t\t\tMinimum PWM\n"
@@ -319,6 +321,20 @@ pwm_main(int argc, char *argv[])
 
 		exit(0);
 
+	} else if (!strcmp(argv[1], "oneshot")) {
+
+		/* an extra "off" argument returns to periodic PWM */
+		unsigned enable = !(argc > 2 && !strcmp(argv[2], "off"));
+
+		ret = ioctl(fd, PWM_SERVO_SET_ONESHOT, enable);
+
+		if (ret != OK) {
+			err(1, "PWM_SERVO_SET_ONESHOT");
+		}
+
+		warnx("OneShot %s", enable ? "on" : "off");
+		exit(0);
+
 	} else if (!strcmp(argv[1], "min")) {
 
 		if (set_mask == 0) {
@@ -725,6 +741,15 @@ pwm_main(int argc, char *argv[])
 			err(1, "PWM_SERVO_GET_SELECT_UPDATE_RATE");
 		}
 
+		uint32_t info_oneshot = 0;
+
+		/* not all outputs support OneShot, ignore failures */
+		(void)ioctl(fd, PWM_SERVO_GET_ONESHOT, (unsigned long)&info_oneshot);
+
+		if (info_oneshot) {
+			printf("OneShot mode active\n");
+		}
+
 		struct pwm_output_values failsafe_pwm;
 
 		struct pwm_output_values disarmed_pwm;
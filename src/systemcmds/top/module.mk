@@ -36,7 +36,8 @@
 #
 
 MODULE_COMMAND	 = top
-SRCS		 = top.c
+SRCS		 = top.c \
+		   profile.c
 
 MODULE_STACKSIZE = 1700
 
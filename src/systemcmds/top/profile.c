@@ -0,0 +1,235 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file profile.c
+ *
+ * Timer-interrupt PC sampling profiler.
+ *
+ * A periodic hrt callout samples the program counter of the interrupted
+ * context and aggregates the hits per address into a fixed-size hash
+ * table.  Dumping the table gives a statistical flat profile of where
+ * CPU time goes, without JTAG and while the vehicle is flying; addresses
+ * are resolved offline against the firmware ELF with nm or addr2line.
+ *
+ * The table is updated in place from interrupt context, so it uses a
+ * static open-addressed hash rather than a heap-backed one - malloc is
+ * not available in an ISR.  Samples that cannot be placed within the
+ * probe limit are counted as lost.
+ */
+
+#include <nuttx/config.h>
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+
+#include "profile.h"
+
+/* interrupted-context register save area, set on interrupt entry (NuttX armv7-m internals) */
+extern volatile uint32_t *current_regs;
+
+#define PROFILE_HASH_LOG2	9
+#define PROFILE_HASH_SIZE	(1 << PROFILE_HASH_LOG2)	/* 512 entries, 4KiB */
+#define PROFILE_PROBE_LIMIT	8
+
+/*
+ * Default sample rate; deliberately not a divisor of the 1kHz periods
+ * most hrt-scheduled drivers run at, so sampling does not phase-lock
+ * with the very code it is trying to measure.
+ */
+#define PROFILE_DEFAULT_RATE	997
+
+struct profile_entry {
+	uint32_t	pc;	/**< sampled program counter, 0 marks a free slot */
+	uint32_t	count;	/**< hits on this address */
+};
+
+static struct profile_entry	profile_hash[PROFILE_HASH_SIZE];
+static struct hrt_call		profile_call;
+static volatile uint32_t	profile_samples;
+static volatile uint32_t	profile_lost;	/**< samples dropped at the probe limit */
+static bool			profile_running;
+
+/**
+ * Sample callout; runs in the hrt timer interrupt.
+ */
+static void
+profile_sample(void *arg)
+{
+	if (current_regs == NULL) {
+		/* no saved context to sample */
+		return;
+	}
+
+	uint32_t pc = current_regs[REG_PC];
+
+	/* multiplicative hash of the halfword-aligned Thumb address */
+	unsigned slot = ((pc >> 1) * 2654435769u) >> (32 - PROFILE_HASH_LOG2);
+
+	for (unsigned probe = 0; probe < PROFILE_PROBE_LIMIT; probe++) {
+		struct profile_entry *e = &profile_hash[(slot + probe) & (PROFILE_HASH_SIZE - 1)];
+
+		if (e->pc == pc) {
+			e->count++;
+			profile_samples++;
+			return;
+		}
+
+		if (e->pc == 0) {
+			e->pc = pc;
+			e->count = 1;
+			profile_samples++;
+			return;
+		}
+	}
+
+	profile_lost++;
+}
+
+static int
+profile_start(unsigned rate_hz)
+{
+	if ((rate_hz == 0) || (rate_hz > 10000)) {
+		return -1;
+	}
+
+	hrt_abstime interval = 1000000 / rate_hz;
+
+	hrt_call_every(&profile_call, interval, interval, profile_sample, NULL);
+	profile_running = true;
+
+	return 0;
+}
+
+static void
+profile_stop(void)
+{
+	hrt_cancel(&profile_call);
+	profile_running = false;
+}
+
+static void
+profile_clear(void)
+{
+	irqstate_t flags = irqsave();
+
+	memset(profile_hash, 0, sizeof(profile_hash));
+	profile_samples = 0;
+	profile_lost = 0;
+
+	irqrestore(flags);
+}
+
+static void
+profile_dump(int fd)
+{
+	unsigned used = 0;
+
+	for (unsigned i = 0; i < PROFILE_HASH_SIZE; i++) {
+		if (profile_hash[i].pc != 0) {
+			dprintf(fd, "0x%08lx %lu\n",
+				(unsigned long)profile_hash[i].pc,
+				(unsigned long)profile_hash[i].count);
+			used++;
+		}
+	}
+
+	dprintf(fd, "# %lu samples, %lu lost, %u/%u slots, %s\n",
+		(unsigned long)profile_samples,
+		(unsigned long)profile_lost,
+		used, PROFILE_HASH_SIZE,
+		profile_running ? "running" : "stopped");
+}
+
+int
+profile_main(int argc, char *argv[])
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "start") == 0) {
+			unsigned rate_hz = PROFILE_DEFAULT_RATE;
+
+			if (argc > 2) {
+				rate_hz = strtoul(argv[2], NULL, 0);
+			}
+
+			if (profile_start(rate_hz) != 0) {
+				printf("invalid sample rate: %u Hz\n", rate_hz);
+				return -1;
+			}
+
+			return 0;
+
+		} else if (strcmp(argv[1], "stop") == 0) {
+			profile_stop();
+			return 0;
+
+		} else if (strcmp(argv[1], "clear") == 0) {
+			profile_clear();
+			return 0;
+
+		} else if (strcmp(argv[1], "dump") == 0) {
+			int fd = 0;
+
+			if (argc > 2) {
+				/* dump to a file, e.g. on microSD for retrieval via MAVLink FTP */
+				fd = open(argv[2], O_CREAT | O_WRONLY | O_TRUNC, 0666);
+
+				if (fd < 0) {
+					printf("could not open %s\n", argv[2]);
+					return -1;
+				}
+			}
+
+			profile_dump(fd);
+
+			if (fd != 0) {
+				close(fd);
+
+			} else {
+				fflush(stdout);
+			}
+
+			return 0;
+		}
+	}
+
+	printf("Usage: top prof <start [rate_hz] | stop | dump [file] | clear>\n");
+	return -1;
+}
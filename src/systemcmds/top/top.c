@@ -51,12 +51,14 @@
 #include <systemlib/cpuload.h>
 #include <drivers/drv_hrt.h>
 
+#include "profile.h"
+
 #define CL "\033[K" // clear line
 
 /**
  * Start the top application.
  */
-__EXPORT int top_main(void);
+__EXPORT int top_main(int argc, char *argv[]);
 
 extern struct system_load_s system_load;
 
@@ -89,8 +91,18 @@ tstate_name(const tstate_t s)
 }
 
 int
-top_main(void)
+top_main(int argc, char *argv[])
 {
+	/* "top prof ..." drives the sampling profiler instead of the task monitor */
+	if (argc > 1 && strcmp(argv[1], "prof") == 0) {
+		return profile_main(argc - 1, argv + 1);
+	}
+
+	/* "top -l" shows per-task scheduling latency instead of the stack
+	 * and priority columns: worst case, mean and a histogram of the
+	 * time tasks spent ready-to-run but preempted before switch-in */
+	bool latency_mode = (argc > 1 && strcmp(argv[1], "-l") == 0);
+
 	uint64_t total_user_time = 0;
 
 	int running_count = 0;
@@ -202,19 +214,50 @@ top_main(void)
 						   (double)idle_time_us / 1000000.d);
 
 					/* header for task list */
-					printf(CL "%4s %*-s %8s %6s %11s %10s %-6s\n",
-						   "PID",
-						   CONFIG_TASK_NAME_SIZE, "COMMAND",
-						   "CPU(ms)",
-						   "CPU(%)",
-						   "USED/STACK",
-						   "PRIO(BASE)",
+					if (latency_mode) {
+						printf(CL "%4s %*-s %8s %8s %8s %s\n",
+							   "PID",
+							   CONFIG_TASK_NAME_SIZE, "COMMAND",
+							   "MAX(us)",
+							   "MEAN(us)",
+							   "COUNT",
+							   "<125us <250  <500  <1ms  <2ms  <4ms  <8ms >=8ms");
+
+					} else {
+						printf(CL "%4s %*-s %8s %6s %11s %10s %-6s\n",
+							   "PID",
+							   CONFIG_TASK_NAME_SIZE, "COMMAND",
+							   "CPU(ms)",
+							   "CPU(%)",
+							   "USED/STACK",
+							   "PRIO(BASE)",
 #if CONFIG_RR_INTERVAL > 0
-						   "TSLICE"
+							   "TSLICE"
 #else
-						   "STATE"
+							   "STATE"
 #endif
-						   );
+							   );
+					}
+				}
+
+				if (latency_mode) {
+					uint64_t latency_mean = (system_load.tasks[i].latency_count > 0)
+						? system_load.tasks[i].latency_total / system_load.tasks[i].latency_count
+						: 0;
+
+					printf(CL "%4d %*-s %8llu %8llu %8u",
+						   system_load.tasks[i].tcb->pid,
+						   CONFIG_TASK_NAME_SIZE, system_load.tasks[i].tcb->name,
+						   system_load.tasks[i].latency_max,
+						   latency_mean,
+						   (unsigned)system_load.tasks[i].latency_count);
+
+					for (int b = 0; b < CPULOAD_LATENCY_BINS; b++) {
+						printf(" %5u", (unsigned)system_load.tasks[i].latency_hist[b]);
+					}
+
+					printf("\n");
+					continue;
 				}
 
 				unsigned stack_size = (uintptr_t)system_load.tasks[i].tcb->adj_stack_ptr -
@@ -0,0 +1,117 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "systemlib/trace.h"
+#include "systemlib/lock_audit.h"
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char *event_names[] = {
+	"none",
+	"orb_publish",
+	"mixer_out",
+	"est_cycle",
+	"lock_inversion",
+	"lock_hold"
+};
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+__EXPORT int trace_main(int argc, char *argv[]);
+
+int trace_main(int argc, char *argv[])
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "start") == 0) {
+			trace_start();
+			return 0;
+
+		} else if (strcmp(argv[1], "stop") == 0) {
+			trace_stop();
+			return 0;
+
+		} else if (strcmp(argv[1], "clear") == 0) {
+			trace_clear();
+			return 0;
+
+		} else if (strcmp(argv[1], "dump") == 0) {
+			struct trace_record_s rec;
+
+			/* records leave the ring oldest first */
+			while (trace_read(&rec) == 0) {
+				const char *name = "user";
+
+				if (rec.event < sizeof(event_names) / sizeof(event_names[0])) {
+					name = event_names[rec.event];
+				}
+
+				printf("%llu\t%s\t0x%08lx\n",
+				       rec.timestamp,
+				       name,
+				       (unsigned long)rec.arg);
+			}
+
+			if (trace_dropped() > 0) {
+				printf("(%lu records dropped)\n", (unsigned long)trace_dropped());
+			}
+
+			fflush(stdout);
+			return 0;
+
+		} else if (strcmp(argv[1], "locks") == 0) {
+			lock_audit_print_all();
+			return 0;
+		}
+
+		printf("Usage: trace [start | stop | dump | clear | locks]\n");
+		return -1;
+	}
+
+	printf("tracing %s, %lu records dropped\n",
+	       trace_is_running() ? "running" : "stopped",
+	       (unsigned long)trace_dropped());
+	return 0;
+}
@@ -0,0 +1,98 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file waitfordev.c
+ *
+ * Barrier for startup scripts: waits until the listed device nodes have
+ * been registered. Used to synchronise with driver starts that were
+ * backgrounded with '&' in order to overlap their probe delays.
+ */
+
+#include <nuttx/config.h>
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <systemlib/err.h>
+#include <drivers/drv_hrt.h>
+
+__EXPORT int waitfordev_main(int argc, char *argv[]);
+
+static void
+usage(void)
+{
+	errx(1, "usage: waitfordev [-t timeout_ms] <devpath> [<devpath>...]");
+}
+
+int
+waitfordev_main(int argc, char *argv[])
+{
+	unsigned timeout_ms = 2000;
+	int first_path = 1;
+
+	if (argc < 2) {
+		usage();
+	}
+
+	if (!strcmp(argv[1], "-t")) {
+		if (argc < 4) {
+			usage();
+		}
+
+		timeout_ms = strtoul(argv[2], NULL, 0);
+		first_path = 3;
+	}
+
+	hrt_abstime deadline = hrt_absolute_time() + (hrt_abstime)timeout_ms * 1000;
+	int ret = 0;
+
+	for (int i = first_path; i < argc; i++) {
+		struct stat st;
+
+		while (stat(argv[i], &st) != 0) {
+			if (hrt_absolute_time() >= deadline) {
+				warnx("timeout waiting for %s", argv[i]);
+				ret = 1;
+				break;
+			}
+
+			usleep(10000);
+		}
+	}
+
+	return ret;
+}
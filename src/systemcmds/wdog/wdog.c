@@ -0,0 +1,90 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file wdog.c
+ *
+ * Shell access to the hardware watchdog service.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "systemlib/watchdog.h"
+#include "systemlib/err.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+__EXPORT int wdog_main(int argc, char *argv[]);
+
+int wdog_main(int argc, char *argv[])
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "start") == 0) {
+			/* default leaves the kicker margin of several passes */
+			unsigned timeout_ms = 1000;
+
+			if (argc > 2) {
+				timeout_ms = strtoul(argv[2], NULL, 0);
+			}
+
+			int ret = watchdog_start(timeout_ms);
+
+			if (ret != OK) {
+				errx(1, "arming failed (%d); note the watchdog cannot be re-armed", ret);
+			}
+
+			warnx("armed, %u ms hardware timeout", timeout_ms);
+			return 0;
+
+		} else if (strcmp(argv[1], "status") == 0) {
+			watchdog_print_status();
+			return 0;
+		}
+
+		printf("Usage: wdog [start [timeout_ms] | status]\n");
+		return -1;
+	}
+
+	watchdog_print_status();
+	return 0;
+}
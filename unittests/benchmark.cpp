@@ -0,0 +1,301 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file benchmark.cpp
+ *
+ * Host-side performance benchmarks for the per-release CI run.
+ *
+ * Times the estimator fusion kernels, the estimator vector/matrix
+ * utilities and the multirotor mixer, built with the flight
+ * optimization flags minus the ISA selection, and writes a
+ * machine-readable CSV report (kernel,iterations,min_us,mean_us,max_us)
+ * so successive releases can be diffed for regressions.
+ *
+ * The mathlib Matrix/Vector classes build on the CMSIS DSP library and
+ * are only available in the ARM build; their on-target numbers come
+ * from the 'bench' system command instead.
+ *
+ * usage: benchmark [report.csv]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include <drivers/drv_hrt.h>
+#include <ekf_att_pos_estimator/estimator_22states.h>
+#include <systemlib/mixer/mixer.h>
+
+/* the estimator's clock hooks, normally provided by the flight module */
+static uint64_t _bench_usec = 0;
+
+uint32_t millis() { return _bench_usec / 1000; }
+uint64_t getMicros() { return _bench_usec; }
+
+namespace
+{
+
+/* sink so the compiler cannot discard benchmarked work */
+volatile float bench_sink;
+
+struct bench_stats {
+	const char	*name;
+	unsigned	calls;
+	uint64_t	total;
+	unsigned	t_min;
+	unsigned	t_max;
+};
+
+void
+stats_init(struct bench_stats &s, const char *name)
+{
+	s.name = name;
+	s.calls = 0;
+	s.total = 0;
+	s.t_min = 0;
+	s.t_max = 0;
+}
+
+void
+stats_record(struct bench_stats &s, hrt_abstime start)
+{
+	unsigned t = (unsigned)hrt_elapsed_time(&start);
+
+	if ((s.calls == 0) || (t < s.t_min)) {
+		s.t_min = t;
+	}
+
+	if (t > s.t_max) {
+		s.t_max = t;
+	}
+
+	s.total += t;
+	s.calls++;
+}
+
+void
+stats_report(FILE *out, const struct bench_stats &s)
+{
+	fprintf(out, "%s,%u,%u,%.3f,%u\n",
+		s.name, s.calls, s.t_min,
+		(double)((float)s.total / s.calls), s.t_max);
+}
+
+int
+mixer_callback(uintptr_t handle, uint8_t control_group, uint8_t control_index, float &control)
+{
+	control = 0.1f * control_index;
+	return 0;
+}
+
+void
+bench_mixer(FILE *out)
+{
+	const char *def = "R: 4x 10000 10000 10000 0\n";
+	unsigned buflen = strlen(def);
+
+	MultirotorMixer *mixer = MultirotorMixer::from_text(mixer_callback, 0, def, buflen);
+
+	if (mixer == nullptr) {
+		fprintf(stderr, "mixer create failed\n");
+		return;
+	}
+
+	float outputs[8];
+	struct bench_stats s;
+	stats_init(s, "mixer_multirotor_quad");
+
+	for (unsigned i = 0; i < 10000; i++) {
+		hrt_abstime t0 = hrt_absolute_time();
+		unsigned mixed = mixer->mix(outputs, 8, nullptr);
+		stats_record(s, t0);
+		bench_sink = outputs[0] + mixed;
+	}
+
+	stats_report(out, s);
+
+	delete mixer;
+}
+
+void
+bench_estimator_math(FILE *out)
+{
+	Mat3f m;
+	m.x = Vector3f(0.9f, 0.1f, 0.0f);
+	m.y = Vector3f(-0.1f, 0.9f, 0.1f);
+	m.z = Vector3f(0.0f, -0.1f, 1.0f);
+	Vector3f v(1.0f, 2.0f, 3.0f);
+
+	struct bench_stats s;
+	stats_init(s, "estimator_mat3f_mul");
+
+	for (unsigned i = 0; i < 10000; i++) {
+		hrt_abstime t0 = hrt_absolute_time();
+		Mat3f r = m * m;
+		stats_record(s, t0);
+		bench_sink = r.x.x;
+		m.x.y += 0.0001f;
+	}
+
+	stats_report(out, s);
+
+	stats_init(s, "estimator_mat3f_vec3f");
+
+	for (unsigned i = 0; i < 10000; i++) {
+		hrt_abstime t0 = hrt_absolute_time();
+		Vector3f r = m * v;
+		stats_record(s, t0);
+		bench_sink = r.x;
+		v.y += 0.0001f;
+	}
+
+	stats_report(out, s);
+}
+
+void
+bench_estimator(FILE *out)
+{
+	AttPosEKF *ekf = new AttPosEKF();
+
+	/* representative inertial data at a 100 Hz filter rate */
+	ekf->dtIMU = 0.01f;
+	ekf->angRate = Vector3f(0.01f, -0.02f, 0.005f);
+	ekf->accel = Vector3f(0.1f, -0.1f, -9.81f);
+	ekf->dAngIMU = ekf->angRate * ekf->dtIMU;
+	ekf->dVelIMU = ekf->accel * ekf->dtIMU;
+	ekf->magData = Vector3f(0.22f, 0.05f, -0.43f);
+
+	float init_vel_ned[3] = { 0.5f, -0.3f, 0.0f };
+	ekf->InitialiseFilter(init_vel_ned, 0.8272, 0.1490, 488.0f, 0.05f);
+	ekf->setOnGround(false);
+
+	struct bench_stats s;
+	stats_init(s, "estimator_strapdown");
+
+	for (unsigned i = 0; i < 10000; i++) {
+		_bench_usec += 10000;
+		hrt_abstime t0 = hrt_absolute_time();
+		ekf->UpdateStrapdownEquationsNED();
+		stats_record(s, t0);
+		ekf->StoreStates(_bench_usec / 1000);
+	}
+
+	stats_report(out, s);
+
+	stats_init(s, "estimator_covariance_prediction");
+
+	for (unsigned i = 0; i < 2000; i++) {
+		hrt_abstime t0 = hrt_absolute_time();
+		ekf->CovariancePrediction(0.02f);
+		stats_record(s, t0);
+		ekf->summedDelAng.zero();
+		ekf->summedDelVel.zero();
+	}
+
+	stats_report(out, s);
+
+	ekf->velNED[0] = 0.5f;
+	ekf->velNED[1] = -0.3f;
+	ekf->velNED[2] = 0.0f;
+	ekf->posNE[0] = 1.0f;
+	ekf->posNE[1] = -1.0f;
+	ekf->hgtMea = 488.0f;
+
+	stats_init(s, "estimator_fuse_velpos");
+
+	for (unsigned i = 0; i < 2000; i++) {
+		ekf->fuseVelData = true;
+		ekf->fusePosData = true;
+		ekf->fuseHgtData = true;
+		ekf->RecallStates(ekf->statesAtVelTime, millis() - 230);
+		ekf->RecallStates(ekf->statesAtPosTime, millis() - 210);
+		ekf->RecallStates(ekf->statesAtHgtTime, millis() - 350);
+
+		hrt_abstime t0 = hrt_absolute_time();
+		ekf->FuseVelposNED();
+		stats_record(s, t0);
+	}
+
+	stats_report(out, s);
+
+	stats_init(s, "estimator_fuse_mag");
+
+	for (unsigned i = 0; i < 2000; i++) {
+		ekf->fuseMagData = true;
+		ekf->RecallStates(ekf->statesAtMagMeasTime, millis() - 30);
+		ekf->magstate.obsIndex = 0;
+
+		hrt_abstime t0 = hrt_absolute_time();
+		ekf->FuseMagnetometer();
+		ekf->FuseMagnetometer();
+		ekf->FuseMagnetometer();
+		stats_record(s, t0);
+	}
+
+	stats_report(out, s);
+
+	delete ekf;
+}
+
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+	FILE *out = stdout;
+
+	if (argc > 1) {
+		out = fopen(argv[1], "w");
+
+		if (out == nullptr) {
+			fprintf(stderr, "failed opening %s\n", argv[1]);
+			return 1;
+		}
+	}
+
+	fprintf(out, "kernel,iterations,min_us,mean_us,max_us\n");
+
+	bench_mixer(out);
+	bench_estimator_math(out);
+	bench_estimator(out);
+
+	if (out != stdout) {
+		fclose(out);
+		printf("report written to %s\n", argv[1]);
+	}
+
+	return 0;
+}
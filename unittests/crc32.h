@@ -0,0 +1,32 @@
+/*
+ * Host stand-in for the NuttX <crc32.h> used by param.c.
+ *
+ * Same polynomial and seed as the NuttX implementation, so parameter
+ * images written by the host tests match what the target produces.
+ */
+
+#ifndef __UNITTESTS_CRC32_H
+#define __UNITTESTS_CRC32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+static inline uint32_t crc32part(const uint8_t *src, size_t len, uint32_t crc32val)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc32val ^= src[i];
+
+		for (unsigned j = 0; j < 8; j++) {
+			crc32val = (crc32val >> 1) ^ ((crc32val & 1) ? 0xedb88320u : 0);
+		}
+	}
+
+	return crc32val;
+}
+
+static inline uint32_t crc32(const uint8_t *src, size_t len)
+{
+	return crc32part(src, len, 0);
+}
+
+#endif /* __UNITTESTS_CRC32_H */
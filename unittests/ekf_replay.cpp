@@ -0,0 +1,557 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ekf_replay.cpp
+ *
+ * Offline replay of sdlog2 flight logs through AttPosEKF.
+ *
+ * Feeds the recorded IMU, baro and GPS streams of an sdlog2 binary log
+ * through the 22-state estimator at full host speed, mirroring the
+ * fusion scheduling of ekf_att_pos_estimator_main.cpp, and accounts the
+ * host time spent in each fusion step. A full flight replays in
+ * seconds, so filter tuning changes can be A/B compared on real data
+ * without a flight.
+ *
+ * The airspeed, rangefinder and filter health reset paths of the
+ * onboard module are not replayed.
+ *
+ * usage: ekf_replay <logfile> [max_flight_seconds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include <drivers/drv_hrt.h>
+#include <ekf_att_pos_estimator/estimator_22states.h>
+#include <geo_lookup/geo_mag_declination.h>
+
+/* the estimator pulls its notion of time from these hooks; feed it the
+ * log clock so its timeout logic behaves identically at replay speed */
+static uint64_t _imu_usec = 0;
+
+uint32_t millis() { return _imu_usec / 1000; }
+uint64_t getMicros() { return _imu_usec; }
+
+namespace
+{
+
+/* sdlog2 framing, see src/modules/sdlog2/sdlog2_format.h */
+const uint8_t head_byte1 = 0xA3;
+const uint8_t head_byte2 = 0x95;
+const uint8_t msg_format = 0x80;
+
+/* message ids and payloads of the replayed streams,
+ * layouts from src/modules/sdlog2/sdlog2_messages.h */
+const uint8_t msg_imu = 4;
+const uint8_t msg_sens = 5;
+const uint8_t msg_gps = 8;
+const uint8_t msg_time = 129;
+
+#pragma pack(push, 1)
+
+struct replay_format_s {
+	uint8_t type;
+	uint8_t length;
+	char name[4];
+	char format[16];
+	char labels[64];
+};
+
+struct replay_IMU_s {
+	float acc_x;
+	float acc_y;
+	float acc_z;
+	float gyro_x;
+	float gyro_y;
+	float gyro_z;
+	float mag_x;
+	float mag_y;
+	float mag_z;
+	float temp_acc;
+	float temp_gyro;
+	float temp_mag;
+};
+
+struct replay_SENS_s {
+	float baro_pres;
+	float baro_alt;
+	float baro_temp;
+	float diff_pres;
+	float diff_pres_filtered;
+};
+
+struct replay_GPS_s {
+	uint64_t gps_time;
+	uint8_t fix_type;
+	float eph;
+	float epv;
+	int32_t lat;
+	int32_t lon;
+	float alt;
+	float vel_n;
+	float vel_e;
+	float vel_d;
+	float cog;
+	uint8_t sats;
+	uint16_t snr_mean;
+	uint16_t noise_per_ms;
+	uint16_t jamming_indicator;
+};
+
+struct replay_TIME_s {
+	uint64_t t;
+};
+
+#pragma pack(pop)
+
+/* host time accounting per fusion step */
+struct op_stats {
+	const char	*name;
+	unsigned	calls;
+	uint64_t	total;
+	unsigned	t_min;
+	unsigned	t_max;
+};
+
+void
+stats_record(struct op_stats &s, hrt_abstime start)
+{
+	unsigned t = (unsigned)hrt_elapsed_time(&start);
+
+	if ((s.calls == 0) || (t < s.t_min)) {
+		s.t_min = t;
+	}
+
+	if (t > s.t_max) {
+		s.t_max = t;
+	}
+
+	s.total += t;
+	s.calls++;
+}
+
+void
+stats_print(const struct op_stats &s)
+{
+	if (s.calls == 0) {
+		printf("%-22s not run\n", s.name);
+		return;
+	}
+
+	printf("%-22s %8u calls, %3u/%5.1f/%5u us min/mean/max, %8.1f ms total\n",
+	       s.name, s.calls, s.t_min, (double)((float)s.total / s.calls),
+	       s.t_max, (double)(s.total / 1e3f));
+}
+
+/* flat-earth projection of GPS fixes onto the local NE plane; good
+ * enough over the extent of a flight log */
+void
+project_ne(double lat, double lon, double ref_lat, double ref_lon, float *north, float *east)
+{
+	*north = (float)((lat - ref_lat) * earthRadius);
+	*east = (float)((lon - ref_lon) * earthRadius * cos(ref_lat));
+}
+
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		fprintf(stderr, "usage: ekf_replay <logfile> [max_flight_seconds]\n");
+		return 1;
+	}
+
+	FILE *log = fopen(argv[1], "rb");
+
+	if (log == nullptr) {
+		fprintf(stderr, "failed opening %s\n", argv[1]);
+		return 1;
+	}
+
+	float max_flight_seconds = 0.0f;
+
+	if (argc > 2) {
+		max_flight_seconds = atof(argv[2]);
+	}
+
+	AttPosEKF *ekf = new AttPosEKF();
+
+	/* message lengths learned from the FMT stream, full packet incl. header */
+	uint8_t lengths[256];
+	memset(lengths, 0, sizeof(lengths));
+	lengths[msg_format] = sizeof(struct replay_format_s) + 3;
+
+	/* replay clock and IMU deltas */
+	uint64_t log_time = 0;
+	uint64_t first_time = 0;
+	uint64_t last_imu_time = 0;
+	uint64_t imu_msec = 0;
+
+	Vector3f last_ang_rate;
+	Vector3f last_accel;
+	Vector3f last_mag;
+	bool have_imu = false;
+	bool have_mag = false;
+	bool baro_init = false;
+	bool gps_good = false;
+	bool gps_initialized = false;
+	double ref_lat = 0.0;
+	double ref_lon = 0.0;
+
+	/* measurement staggering, as in updateSensorFusion() */
+	bool baro_pending = false;
+	bool mag_pending = false;
+	float covariance_dt = 0.0f;
+
+	struct replay_GPS_s gps;
+	memset(&gps, 0, sizeof(gps));
+
+	unsigned imu_samples = 0;
+	unsigned gps_samples = 0;
+	unsigned baro_samples = 0;
+	unsigned sync_errors = 0;
+
+	struct op_stats stat_strapdown = { "UpdateStrapdownNED", 0, 0, 0, 0 };
+	struct op_stats stat_covariance = { "CovariancePrediction", 0, 0, 0, 0 };
+	struct op_stats stat_velpos = { "FuseVelposNED", 0, 0, 0, 0 };
+	struct op_stats stat_mag = { "FuseMagnetometer", 0, 0, 0, 0 };
+
+	hrt_abstime wall_start = hrt_absolute_time();
+
+	while (true) {
+		uint8_t header[3];
+
+		if (fread(header, 1, sizeof(header), log) != sizeof(header)) {
+			break;
+		}
+
+		if ((header[0] != head_byte1) || (header[1] != head_byte2)) {
+			/* lost sync, advance one byte and retry */
+			fseek(log, -2, SEEK_CUR);
+			sync_errors++;
+			continue;
+		}
+
+		uint8_t type = header[2];
+
+		union {
+			struct replay_format_s fmt;
+			struct replay_IMU_s imu;
+			struct replay_SENS_s sens;
+			struct replay_GPS_s gps;
+			struct replay_TIME_s time;
+			uint8_t raw[256];
+		} payload;
+
+		if (lengths[type] == 0) {
+			/* unknown message before its FMT entry, resync */
+			fseek(log, -2, SEEK_CUR);
+			sync_errors++;
+			continue;
+		}
+
+		unsigned payload_len = lengths[type] - 3;
+
+		if (fread(payload.raw, 1, payload_len, log) != payload_len) {
+			break;
+		}
+
+		switch (type) {
+		case msg_format:
+			if (payload.fmt.length > 3) {
+				lengths[payload.fmt.type] = payload.fmt.length;
+			}
+
+			break;
+
+		case msg_time:
+			log_time = payload.time.t;
+
+			if (first_time == 0) {
+				first_time = log_time;
+			}
+
+			break;
+
+		case msg_sens:
+			ekf->baroHgt = payload.sens.baro_alt;
+			baro_init = true;
+			baro_pending = true;
+			baro_samples++;
+			break;
+
+		case msg_gps:
+			gps = payload.gps;
+			gps_good = (gps.fix_type >= 3) && (gps.eph < 10.0f) && (gps.epv < 10.0f);
+			gps_samples++;
+
+			if (gps_good && gps_initialized) {
+				ekf->GPSstatus = gps.fix_type;
+				ekf->velNED[0] = gps.vel_n;
+				ekf->velNED[1] = gps.vel_e;
+				ekf->velNED[2] = gps.vel_d;
+				ekf->gpsLat = gps.lat / 1.0e7 * M_PI / 180.0;
+				ekf->gpsLon = gps.lon / 1.0e7 * M_PI / 180.0 - M_PI;
+				ekf->gpsHgt = gps.alt / 1e3f;
+
+				project_ne(gps.lat / 1.0e7 * M_PI / 180.0, gps.lon / 1.0e7 * M_PI / 180.0,
+					   ref_lat, ref_lon, &ekf->posNE[0], &ekf->posNE[1]);
+			}
+
+			break;
+
+		case msg_imu: {
+				if (log_time == 0) {
+					break;
+				}
+
+				if (!have_imu) {
+					last_imu_time = log_time;
+					last_ang_rate = Vector3f(payload.imu.gyro_x, payload.imu.gyro_y, payload.imu.gyro_z);
+					last_accel = Vector3f(payload.imu.acc_x, payload.imu.acc_y, payload.imu.acc_z);
+					have_imu = true;
+					break;
+				}
+
+				float dt = (log_time - last_imu_time) / 1e6f;
+
+				if (dt < 0.0001f || dt > 0.2f) {
+					/* log gap or duplicate timestamp, skip the delta */
+					last_imu_time = log_time;
+					break;
+				}
+
+				last_imu_time = log_time;
+				_imu_usec = log_time;
+				imu_msec = log_time / 1000;
+				imu_samples++;
+
+				/* trapezoidal delta angle / velocity integration as onboard */
+				ekf->dtIMU = dt;
+				ekf->angRate = Vector3f(payload.imu.gyro_x, payload.imu.gyro_y, payload.imu.gyro_z);
+				ekf->accel = Vector3f(payload.imu.acc_x, payload.imu.acc_y, payload.imu.acc_z);
+				ekf->dAngIMU = (ekf->angRate + last_ang_rate) * (0.5f * dt);
+				ekf->dVelIMU = (ekf->accel + last_accel) * (0.5f * dt);
+				last_ang_rate = ekf->angRate;
+				last_accel = ekf->accel;
+
+				Vector3f mag(payload.imu.mag_x, payload.imu.mag_y, payload.imu.mag_z);
+
+				if (!have_mag ||
+				    (fabsf(mag.x - last_mag.x) > 1e-6f) ||
+				    (fabsf(mag.y - last_mag.y) > 1e-6f) ||
+				    (fabsf(mag.z - last_mag.z) > 1e-6f)) {
+					ekf->magData = mag;
+					last_mag = mag;
+					have_mag = true;
+					mag_pending = true;
+				}
+
+				if (!baro_init || !have_mag) {
+					break;
+				}
+
+				/* initialization sequence as onboard: static first, GPS later */
+				if (!ekf->statesInitialised) {
+					float init_vel_ned[3] = { 0.0f, 0.0f, 0.0f };
+					ekf->posNE[0] = 0.0f;
+					ekf->posNE[1] = 0.0f;
+					ekf->InitialiseFilter(init_vel_ned, 0.0, 0.0, 0.0f, 0.0f);
+					break;
+				}
+
+				if (!gps_initialized && gps_good) {
+					double lat = gps.lat / 1.0e7;
+					double lon = gps.lon / 1.0e7;
+
+					ekf->GPSstatus = gps.fix_type;
+					ekf->gpsLat = lat * M_PI / 180.0;
+					ekf->gpsLon = lon * M_PI / 180.0 - M_PI;
+					ekf->gpsHgt = gps.alt / 1e3f;
+					ekf->hgtMea = ekf->baroHgt;
+
+					ref_lat = lat * M_PI / 180.0;
+					ref_lon = lon * M_PI / 180.0;
+
+					float declination = (float)(get_mag_declination(lat, lon) * M_PI / 180.0);
+
+					float init_vel_ned[3] = { gps.vel_n, gps.vel_e, gps.vel_d };
+					ekf->InitialiseFilter(init_vel_ned, ekf->gpsLat, ekf->gpsLon, ekf->gpsHgt, declination);
+
+					ekf->setOnGround(false);
+					gps_initialized = true;
+
+					printf("GPS init at %.7f %.7f alt %.1f m, t+%.1f s\n",
+					       lat, lon, (double)ekf->gpsHgt,
+					       (double)((log_time - first_time) / 1e6f));
+					break;
+				}
+
+				/* fusion scheduling as in updateSensorFusion() */
+				hrt_abstime t0 = hrt_absolute_time();
+				ekf->UpdateStrapdownEquationsNED();
+				stats_record(stat_strapdown, t0);
+
+				ekf->StoreStates(imu_msec);
+
+				ekf->summedDelAng = ekf->summedDelAng + ekf->correctedDelAng;
+				ekf->summedDelVel = ekf->summedDelVel + ekf->dVelIMU;
+				covariance_dt += ekf->dtIMU;
+
+				if ((covariance_dt >= (ekf->covTimeStepMax - ekf->dtIMU))
+				    || (ekf->summedDelAng.length() > ekf->covDelAngMax)) {
+					t0 = hrt_absolute_time();
+					ekf->CovariancePrediction(covariance_dt);
+					stats_record(stat_covariance, t0);
+					ekf->summedDelAng.zero();
+					ekf->summedDelVel.zero();
+					covariance_dt = 0.0f;
+				}
+
+				if (gps_good && gps_initialized) {
+					ekf->fuseVelData = true;
+					ekf->fusePosData = true;
+					ekf->RecallStates(ekf->statesAtVelTime, imu_msec - 230);
+					ekf->RecallStates(ekf->statesAtPosTime, imu_msec - 210);
+
+					t0 = hrt_absolute_time();
+					ekf->FuseVelposNED();
+					stats_record(stat_velpos, t0);
+
+				} else if (!gps_initialized) {
+					ekf->staticMode = true;
+					ekf->velNED[0] = 0.0f;
+					ekf->velNED[1] = 0.0f;
+					ekf->velNED[2] = 0.0f;
+					ekf->posNE[0] = 0.0f;
+					ekf->posNE[1] = 0.0f;
+					ekf->fuseVelData = true;
+					ekf->fusePosData = true;
+					ekf->RecallStates(ekf->statesAtVelTime, imu_msec - 230);
+					ekf->RecallStates(ekf->statesAtPosTime, imu_msec - 210);
+
+					t0 = hrt_absolute_time();
+					ekf->FuseVelposNED();
+					stats_record(stat_velpos, t0);
+
+				} else {
+					ekf->fuseVelData = false;
+					ekf->fusePosData = false;
+				}
+
+				/* at most one further fusion per IMU cycle, as onboard */
+				if (baro_pending) {
+					ekf->hgtMea = ekf->baroHgt;
+					ekf->fuseHgtData = true;
+					ekf->RecallStates(ekf->statesAtHgtTime, imu_msec - 350);
+
+					t0 = hrt_absolute_time();
+					ekf->FuseVelposNED();
+					stats_record(stat_velpos, t0);
+					baro_pending = false;
+
+				} else {
+					ekf->fuseHgtData = false;
+
+					if (mag_pending) {
+						ekf->fuseMagData = true;
+						ekf->RecallStates(ekf->statesAtMagMeasTime, imu_msec - 30);
+						ekf->magstate.obsIndex = 0;
+
+						t0 = hrt_absolute_time();
+						ekf->FuseMagnetometer();
+						ekf->FuseMagnetometer();
+						ekf->FuseMagnetometer();
+						stats_record(stat_mag, t0);
+						mag_pending = false;
+
+					} else {
+						ekf->fuseMagData = false;
+					}
+				}
+
+				break;
+			}
+
+		default:
+			break;
+		}
+
+		if ((max_flight_seconds > 0.0f) && (first_time != 0)
+		    && ((log_time - first_time) / 1e6f > max_flight_seconds)) {
+			break;
+		}
+	}
+
+	hrt_abstime wall_elapsed = hrt_elapsed_time(&wall_start);
+
+	fclose(log);
+
+	float flight_seconds = (first_time != 0) ? ((log_time - first_time) / 1e6f) : 0.0f;
+
+	/* final state: attitude from the quaternion, NED position and velocity */
+	float q0 = ekf->states[0];
+	float q1 = ekf->states[1];
+	float q2 = ekf->states[2];
+	float q3 = ekf->states[3];
+
+	printf("\n");
+	printf("replayed %.1f s of flight in %.2f s wall time (%.0fx real time)\n",
+	       (double)flight_seconds, (double)(wall_elapsed / 1e6f),
+	       (double)(flight_seconds * 1e6f / wall_elapsed));
+	printf("%u IMU, %u baro, %u GPS samples, %u sync errors\n",
+	       imu_samples, baro_samples, gps_samples, sync_errors);
+	printf("final attitude r/p/y: %.3f %.3f %.3f rad\n",
+	       (double)atan2f(2.0f * (q0 * q1 + q2 * q3), 1.0f - 2.0f * (q1 * q1 + q2 * q2)),
+	       (double)asinf(2.0f * (q0 * q2 - q3 * q1)),
+	       (double)atan2f(2.0f * (q0 * q3 + q1 * q2), 1.0f - 2.0f * (q2 * q2 + q3 * q3)));
+	printf("final velocity NED: %.2f %.2f %.2f m/s\n",
+	       (double)ekf->states[4], (double)ekf->states[5], (double)ekf->states[6]);
+	printf("final position NED: %.2f %.2f %.2f m\n",
+	       (double)ekf->states[7], (double)ekf->states[8], (double)ekf->states[9]);
+	printf("\n");
+
+	stats_print(stat_strapdown);
+	stats_print(stat_covariance);
+	stats_print(stat_velpos);
+	stats_print(stat_mag);
+
+	delete ekf;
+
+	return 0;
+}